@@ -0,0 +1,174 @@
+/**
+ * @file GeneratedConfig.h
+ * @brief Configuration tables generated from ARXML
+ * @details Generated by arxml_codegen.py from Os.arxml, Com.arxml, CanIf.arxml.
+ *          Do not edit; change the ARXML and regenerate.
+ */
+
+#ifndef GENERATED_CONFIG_H
+#define GENERATED_CONFIG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CFG_INVALID_INDEX                0xFFu
+
+//=============================================================================
+// Operating System Tasks
+//=============================================================================
+
+/**
+ * @brief Task IDs in configuration order
+ */
+typedef enum {
+    CFG_OS_TASK_STARTUP_TASK = 0,
+    CFG_OS_TASK_MAIN_TASK_10MS = 1,
+    CFG_OS_TASK_MAIN_TASK_100MS = 2,
+    CFG_OS_TASK_BACKGROUND_TASK = 3,
+    CFG_OS_TASK_COUNT
+} CfgOsTaskId_t;
+
+/**
+ * @brief OS task configuration (priority: higher value = higher priority)
+ */
+typedef struct {
+    const char* name;
+    uint8_t priority;
+    uint8_t activation;          // Maximum queued activations
+    uint32_t stackSize;          // Stack size in bytes
+    uint32_t period_ms;          // Cyclic alarm period, 0 = not alarm-driven
+    bool autostart;
+    bool preemptive;
+    bool suspendable;            // Can be suspended for power saving
+} CfgOsTask_t;
+
+static const CfgOsTask_t CFG_OS_TASKS[] = {
+    {"StartupTask", 15, 1, 2048, 0, true, true, false},
+    {"MainTask_10ms", 10, 1, 4096, 10, false, true, false},
+    {"MainTask_100ms", 5, 1, 3072, 100, false, true, false},
+    {"BackgroundTask", 1, 1, 2048, 0, false, true, false}
+};
+
+//=============================================================================
+// CAN PDUs (sorted by CAN ID)
+//=============================================================================
+
+#define CFG_CANID_ENGINE_SPEED                 0x100u
+#define CFG_CANID_ENGINE_TEMP                  0x101u
+#define CFG_CANID_THROTTLE_POS                 0x200u
+#define CFG_CANID_BRAKE_STATUS                 0x201u
+
+typedef enum {
+    CFG_PDU_ENGINE_SPEED = 0,
+    CFG_PDU_ENGINE_TEMP = 1,
+    CFG_PDU_THROTTLE_POS = 2,
+    CFG_PDU_BRAKE_STATUS = 3,
+    CFG_PDU_COUNT
+} CfgPduIndex_t;
+
+/**
+ * @brief CAN PDU: CanIf routing joined with the Com I-PDU timing
+ */
+typedef struct {
+    uint32_t canId;
+    uint8_t dlc;
+    bool extendedId;
+    bool tx;                     // true = transmitted by this ECU
+    uint8_t comPduId;            // Com I-PDU ID, CFG_INVALID_INDEX if CanIf only
+    uint32_t cycle_ms;           // Tx period, 0 = event-driven
+    uint32_t timeout_ms;         // Rx deadline, 0 = not supervised
+    uint8_t firstSignal;         // Signals of this PDU are contiguous in CFG_SIGNALS
+    uint8_t signalCount;
+    const char* name;
+} CfgPdu_t;
+
+static const CfgPdu_t CFG_PDUS[] = {
+    {0x100u, 8, false, true, 0, 100, 0, 0, 1, "EngineSpeed"},
+    {0x101u, 8, false, true, CFG_INVALID_INDEX, 0, 0, 0, 0, "EngineTemp"},
+    {0x200u, 8, false, false, 1, 0, 1000, 1, 1, "ThrottlePos"},
+    {0x201u, 8, false, false, CFG_INVALID_INDEX, 0, 0, 0, 0, "BrakeStatus"}
+};
+
+static const uint8_t CFG_CAN_ID_SLOTS[4] = {3, 0, 1, 2};
+
+static inline uint32_t Cfg_CanIdSlot(uint32_t key) {
+    return (key * 0x2F7C8119u) >> 30;
+}
+
+/**
+ * @brief Index into CFG_PDUS for a canId, CFG_INVALID_INDEX if unknown (O(1))
+ */
+static inline uint8_t Cfg_PduByCanId(uint32_t canId) {
+    return (CFG_PDUS[CFG_CAN_ID_SLOTS[Cfg_CanIdSlot(canId)]].canId == canId) ?
+        CFG_CAN_ID_SLOTS[Cfg_CanIdSlot(canId)] : CFG_INVALID_INDEX;
+}
+
+//=============================================================================
+// Com Signals (grouped by PDU)
+//=============================================================================
+
+typedef enum {
+    CFG_SIGNAL_ENGINE_SPEED = 0,
+    CFG_SIGNAL_THROTTLE_POSITION = 1,
+    CFG_SIGNAL_COUNT
+} CfgSignalIndex_t;
+
+/**
+ * @brief Signal placement within its PDU
+ */
+typedef struct {
+    uint8_t pdu;                 // Index into CFG_PDUS
+    uint8_t startBit;
+    uint8_t length;              // Bits
+    bool littleEndian;
+    uint32_t initValue;
+    const char* name;
+} CfgSignal_t;
+
+static const CfgSignal_t CFG_SIGNALS[] = {
+    {0, 0, 16, false, 0, "EngineSpeed"},
+    {2, 0, 16, false, 0, "ThrottlePosition"}
+};
+
+//=============================================================================
+// Diagnostic Data Identifiers (sorted by DID)
+//=============================================================================
+
+/**
+ * @brief DID table indices; handlers are dispatched through an array of this size
+ */
+typedef enum {
+    CFG_DID_IDX_COUNT
+} CfgDidIndex_t;
+
+typedef struct {
+    uint16_t did;
+    uint16_t size;               // Data length in bytes
+    bool readable;
+    bool writable;
+    const char* name;
+} CfgDid_t;
+
+static inline uint8_t Cfg_DidIndex(uint32_t did) {
+    return ((void)did, CFG_INVALID_INDEX);
+}
+
+//=============================================================================
+// Diagnostic Trouble Codes (sorted by DTC)
+//=============================================================================
+
+typedef enum {
+    CFG_DTC_IDX_COUNT
+} CfgDtcIndex_t;
+
+typedef struct {
+    uint32_t dtc;                // 3-byte UDS DTC
+    uint8_t priority;            // 1 = most important
+    const char* name;
+} CfgDtc_t;
+
+static inline uint8_t Cfg_DtcIndex(uint32_t dtc) {
+    return ((void)dtc, CFG_INVALID_INDEX);
+}
+
+#endif // GENERATED_CONFIG_H
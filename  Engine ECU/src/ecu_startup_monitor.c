@@ -5,9 +5,14 @@
  * @date 2024-11-07
  */
 
+#define _POSIX_C_SOURCE 199309L     /* clock_gettime */
+
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
+#include <time.h>
 #include "ecu_startup_monitor.h"
+#include "Crc.h"
 
 /* AUTOSAR includes would be here in real implementation */
 /* #include "Std_Types.h" */
@@ -16,49 +21,215 @@
 /* #include "EcuM.h" */
 
 static StartupMonitor_t startup_monitor = {0};
+static StartupJournal_t startup_journal;
+static const JournalFlash_t* journal_flash = NULL;     /* No driver: events are not journaled */
+static uint32_t init_time_us = 0;
+
+/* Regions checked by the RAM test and flash CRC; unset regions pass */
+static const uint8_t* flash_region = NULL;
+static uint32_t flash_size = 0;
+static uint32_t flash_expected_crc = 0;
+static uint32_t flash_offset = 0;
+static uint32_t flash_crc = 0;
+static uint32_t* ram_region = NULL;
+static uint32_t ram_words = 0;
+static uint32_t ram_offset = 0;
+static uint32_t ram_backup[STARTUP_RAM_TEST_SLICE_WORDS];
+
+/**
+ * @brief Free-running microsecond counter (GetCounterValue(SystemTimer) in real implementation)
+ */
+static uint32_t get_time_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_nsec / 1000u);
+}
+
+static uint32_t elapsed_us(void) {
+    return get_time_us() - init_time_us;
+}
+
+static void journal_event(JournalEvent_t type, uint8_t code, uint16_t detail) {
+    StartupJournal_Append(&startup_journal, type, (uint16_t)startup_monitor.boot_count,
+                          code, detail, elapsed_us());
+}
+
+/**
+ * @brief Switch phase and close the timing of the previous one
+ */
+static void enter_phase(StartupPhase_t phase) {
+    uint32_t now = elapsed_us();
+    StartupPhase_t previous = startup_monitor.current_phase;
+    
+    startup_monitor.phase_duration_us[previous] += now - startup_monitor.phase_entry_us[previous];
+    startup_monitor.phase_entry_us[phase] = now;
+    startup_monitor.current_phase = phase;
+}
+
+/**
+ * @brief March C- on one block, contents saved and restored
+ */
+static bool march_test_block(uint32_t* block, uint32_t words) {
+    volatile uint32_t* cell = block;
+    bool ok = true;
+    uint32_t i;
+    
+    memcpy(ram_backup, block, words * sizeof(uint32_t));
+    
+    for (i = 0; i < words; i++) {                           /* up (w0) */
+        cell[i] = 0x00000000u;
+    }
+    for (i = 0; i < words && ok; i++) {                     /* up (r0, w1) */
+        ok = (cell[i] == 0x00000000u);
+        cell[i] = 0xFFFFFFFFu;
+    }
+    for (i = 0; i < words && ok; i++) {                     /* up (r1, w0) */
+        ok = (cell[i] == 0xFFFFFFFFu);
+        cell[i] = 0x00000000u;
+    }
+    for (i = words; i > 0 && ok; i--) {                     /* down (r0, w1) */
+        ok = (cell[i - 1] == 0x00000000u);
+        cell[i - 1] = 0xFFFFFFFFu;
+    }
+    for (i = words; i > 0 && ok; i--) {                     /* down (r1, w0) */
+        ok = (cell[i - 1] == 0xFFFFFFFFu);
+        cell[i - 1] = 0x00000000u;
+    }
+    for (i = 0; i < words && ok; i++) {                     /* (r0) */
+        ok = (cell[i] == 0x00000000u);
+    }
+    
+    memcpy(block, ram_backup, words * sizeof(uint32_t));
+    return ok;
+}
+
+/**
+ * @brief Record the result of a check; failures are reported as startup errors
+ */
+static bool finish_check(StartupCheck_t check, bool ok, StartupError_t error) {
+    StartupCheckTiming_t* timing = &startup_monitor.checks[check];
+    
+    timing->end_us = elapsed_us();
+    timing->state = ok ? CHECK_STATE_PASSED : CHECK_STATE_FAILED;
+    if (!ok) {
+        StartupMonitor_ReportError(error);
+    }
+    return ok;
+}
+
+/**
+ * @brief Run one slice of the RAM test or flash CRC
+ * @return true once the check has finished
+ */
+static bool run_check_slice(StartupCheck_t check) {
+    StartupCheckTiming_t* timing = &startup_monitor.checks[check];
+    uint32_t start = elapsed_us();
+    bool done;
+    bool ok = true;
+    
+    if (timing->state == CHECK_STATE_PENDING) {
+        timing->state = CHECK_STATE_RUNNING;
+        timing->start_us = start;
+    }
+    
+    if (check == STARTUP_CHECK_RAM) {
+        uint32_t words = ram_words - ram_offset;
+        if (words > STARTUP_RAM_TEST_SLICE_WORDS) {
+            words = STARTUP_RAM_TEST_SLICE_WORDS;
+        }
+        if (words > 0) {
+            ok = march_test_block(ram_region + ram_offset, words);
+            ram_offset += words;
+        }
+        done = !ok || ram_offset >= ram_words;
+    } else {
+        uint32_t bytes = flash_size - flash_offset;
+        if (bytes > STARTUP_FLASH_CRC_SLICE_BYTES) {
+            bytes = STARTUP_FLASH_CRC_SLICE_BYTES;
+        }
+        if (bytes > 0) {
+            flash_crc = Crc32_Update(flash_crc, flash_region + flash_offset, bytes);
+            flash_offset += bytes;
+        }
+        done = flash_offset >= flash_size;
+        ok = !done || Crc32_Final(flash_crc) == flash_expected_crc;
+    }
+    
+    timing->duration_us += elapsed_us() - start;
+    timing->slices++;
+    if (done) {
+        finish_check(check, ok, check == STARTUP_CHECK_RAM ? STARTUP_ERROR_RAM_TEST_FAIL
+                                                            : STARTUP_ERROR_FLASH_CRC_FAIL);
+    }
+    return done;
+}
 
 /**
  * @brief Initialize startup monitoring
  */
 void StartupMonitor_Init(void) {
+    JournalRecord_t last;
+    
+    init_time_us = get_time_us();
     startup_monitor.current_phase = STARTUP_PHASE_INIT;
     startup_monitor.last_error = STARTUP_ERROR_NONE;
-    startup_monitor.boot_count++;
-    startup_monitor.startup_timestamp = 0; /* GetCounterValue(SystemTimer) in real implementation */
+    startup_monitor.startup_timestamp = init_time_us;
+    
+    /* Boot profile starts now */
+    memset(startup_monitor.phase_entry_us, 0, sizeof(startup_monitor.phase_entry_us));
+    memset(startup_monitor.phase_duration_us, 0, sizeof(startup_monitor.phase_duration_us));
+    memset(startup_monitor.checks, 0, sizeof(startup_monitor.checks));
+    ram_offset = 0;
+    flash_offset = 0;
+    flash_crc = Crc32_Init();
     
     /* Check reset reason */
     startup_monitor.last_reset_reason = 0x00; /* Read reset status register in real implementation */
     
+    /* Find the journal head; the boot counter continues from the last record */
+    StartupJournal_Init(&startup_journal, journal_flash);
+    if (StartupJournal_GetLast(&startup_journal, &last)) {
+        startup_monitor.boot_count = last.boot_count;
+    }
+    startup_monitor.boot_count++;
+    
     /* Log startup attempt */
-    /* TODO: Implement logging to non-volatile memory */
+    journal_event(JOURNAL_EVENT_BOOT, (uint8_t)startup_monitor.last_reset_reason, 0);
 }
 
 /**
  * @brief Update current startup phase
  */
 void StartupMonitor_SetPhase(StartupPhase_t phase) {
-    startup_monitor.current_phase = phase;
+    StartupPhase_t previous = startup_monitor.current_phase;
+    enter_phase(phase);
     
     /* Watchdog service - would be implemented in real system */
     /* ServiceWatchdog(); */
     
     /* Log phase transition */
-    /* TODO: Add diagnostic event logging */
+    journal_event(JOURNAL_EVENT_PHASE, (uint8_t)phase, (uint16_t)previous);
+    
+    /* Boot is over: prepare the next journal sector off the startup path */
+    if (phase == STARTUP_PHASE_RUNNING) {
+        StartupJournal_Maintain(&startup_journal);
+    }
 }
 
 /**
  * @brief Report startup error
  */
 void StartupMonitor_ReportError(StartupError_t error) {
+    StartupPhase_t phase = startup_monitor.current_phase;
     startup_monitor.last_error = error;
     startup_monitor.error_count++;
-    startup_monitor.current_phase = STARTUP_PHASE_ERROR;
+    enter_phase(STARTUP_PHASE_ERROR);
     
     /* Report to DET (Development Error Tracer) - would be implemented in real system */
     /* Det_ReportError(MODULE_ID_STARTUP_MONITOR, 0, 0, error); */
     
     /* Store error in non-volatile memory for debugging */
-    /* TODO: Implement NVM write */
+    journal_event(JOURNAL_EVENT_ERROR, (uint8_t)error, (uint16_t)phase);
 }
 
 /**
@@ -68,43 +239,103 @@ StartupMonitor_t* StartupMonitor_GetStatus(void) {
     return &startup_monitor;
 }
 
+/**
+ * @brief Get the persistent startup journal
+ */
+const StartupJournal_t* StartupMonitor_GetJournal(void) {
+    return &startup_journal;
+}
+
 /**
  * @brief Diagnostic function to check critical systems
  */
 bool StartupMonitor_CheckCriticalSystems(void) {
     bool status = true;
+    StartupCheckTiming_t* checks = startup_monitor.checks;
     
     /* Check clock system - would implement actual clock validation */
+    checks[STARTUP_CHECK_CLOCK].start_us = elapsed_us();
     bool clock_ok = true; /* Placeholder for actual clock check */
-    if (!clock_ok) {
-        StartupMonitor_ReportError(STARTUP_ERROR_CLOCK_FAIL);
-        status = false;
-    }
-    
-    /* Check RAM integrity - would implement actual RAM test */
-    bool ram_ok = true; /* Placeholder for actual RAM test */
-    if (!ram_ok) {
-        StartupMonitor_ReportError(STARTUP_ERROR_RAM_TEST_FAIL);
-        status = false;
-    }
+    checks[STARTUP_CHECK_CLOCK].duration_us = elapsed_us() - checks[STARTUP_CHECK_CLOCK].start_us;
+    checks[STARTUP_CHECK_CLOCK].slices = 1;
+    status = finish_check(STARTUP_CHECK_CLOCK, clock_ok, STARTUP_ERROR_CLOCK_FAIL) && status;
     
-    /* Check Flash CRC - would implement actual CRC check */
-    bool flash_crc_ok = true; /* Placeholder for actual Flash CRC check */
-    if (!flash_crc_ok) {
-        StartupMonitor_ReportError(STARTUP_ERROR_FLASH_CRC_FAIL);
-        status = false;
+    /* RAM march test and flash CRC: blocking in full mode, background slices in staged mode */
+    if (startup_monitor.mode == STARTUP_MODE_FULL) {
+        while (!run_check_slice(STARTUP_CHECK_RAM)) {
+        }
+        status = (checks[STARTUP_CHECK_RAM].state == CHECK_STATE_PASSED) && status;
+        
+        while (!run_check_slice(STARTUP_CHECK_FLASH_CRC)) {
+        }
+        status = (checks[STARTUP_CHECK_FLASH_CRC].state == CHECK_STATE_PASSED) && status;
     }
     
     /* Check stack usage - would implement actual stack monitoring */
+    checks[STARTUP_CHECK_STACK].start_us = elapsed_us();
     bool stack_ok = true; /* Placeholder for actual stack check */
-    if (!stack_ok) {
-        StartupMonitor_ReportError(STARTUP_ERROR_STACK_OVERFLOW);
-        status = false;
-    }
+    checks[STARTUP_CHECK_STACK].duration_us = elapsed_us() - checks[STARTUP_CHECK_STACK].start_us;
+    checks[STARTUP_CHECK_STACK].slices = 1;
+    status = finish_check(STARTUP_CHECK_STACK, stack_ok, STARTUP_ERROR_STACK_OVERFLOW) && status;
     
     return status;
 }
 
+/**
+ * @brief Select full or staged startup (before StartupMonitor_CheckCriticalSystems)
+ */
+void StartupMonitor_SetMode(StartupMode_t mode) {
+    startup_monitor.mode = mode;
+}
+
+/**
+ * @brief Set the flash driver of the startup journal (before StartupMonitor_Init)
+ */
+void StartupMonitor_SetJournalFlash(const JournalFlash_t* flash) {
+    journal_flash = flash;
+}
+
+/**
+ * @brief Configure the flash image (with its reference CRC-32) and the RAM area to test
+ */
+void StartupMonitor_SetCheckRegions(const uint8_t* flash, uint32_t flash_bytes, uint32_t flash_reference_crc,
+                                    uint32_t* ram, uint32_t ram_word_count) {
+    flash_region = flash;
+    flash_size = flash ? flash_bytes : 0;
+    flash_expected_crc = flash ? flash_reference_crc : StartupMonitor_Crc32(NULL, 0);
+    ram_region = ram;
+    ram_words = ram ? ram_word_count : 0;
+}
+
+/**
+ * @brief Run one background slice of the deferred checks (staged mode, after RUNNING)
+ * @return true while deferred checks remain
+ */
+bool StartupMonitor_RunBackgroundChecks(void) {
+    StartupCheckTiming_t* checks = startup_monitor.checks;
+    
+    if (startup_monitor.mode != STARTUP_MODE_STAGED ||
+        startup_monitor.current_phase != STARTUP_PHASE_RUNNING) {
+        return false;
+    }
+    
+    if (checks[STARTUP_CHECK_RAM].state <= CHECK_STATE_RUNNING) {
+        run_check_slice(STARTUP_CHECK_RAM);
+    } else if (checks[STARTUP_CHECK_FLASH_CRC].state <= CHECK_STATE_RUNNING) {
+        run_check_slice(STARTUP_CHECK_FLASH_CRC);
+    }
+    
+    return startup_monitor.current_phase == STARTUP_PHASE_RUNNING &&
+           checks[STARTUP_CHECK_FLASH_CRC].state <= CHECK_STATE_RUNNING;
+}
+
+/**
+ * @brief CRC-32 (IEEE 802.3) as used for the flash image reference
+ */
+uint32_t StartupMonitor_Crc32(const uint8_t* data, uint32_t length) {
+    return Crc32_Calc(data, length);
+}
+
 /**
  * @brief Emergency recovery procedure
  */
@@ -116,12 +347,12 @@ void StartupMonitor_EmergencyRecovery(void) {
     /* TODO: Implement safe state configuration */
     
     /* Log emergency recovery event */
-    /* TODO: Store recovery event in NVM */
+    journal_event(JOURNAL_EVENT_RECOVERY, 0, (uint16_t)startup_monitor.current_phase);
     
     /* Attempt system restart - would use EcuM in real implementation */
     /* EcuM_RequestRUN(ECUM_USER_Emergency); */
     
     /* For simulation, just set error state */
-    startup_monitor.current_phase = STARTUP_PHASE_ERROR;
+    enter_phase(STARTUP_PHASE_ERROR);
     startup_monitor.last_error = STARTUP_ERROR_NONE; /* Recovery attempted */
 }
\ No newline at end of file
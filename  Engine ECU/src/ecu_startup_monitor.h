@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "startup_journal.h"
 
 /* Module ID for DET reporting */
 #define MODULE_ID_STARTUP_MONITOR   0x100
@@ -19,7 +20,8 @@ typedef enum {
     STARTUP_PHASE_RTE_START,
     STARTUP_PHASE_APP_INIT,
     STARTUP_PHASE_RUNNING,
-    STARTUP_PHASE_ERROR
+    STARTUP_PHASE_ERROR,
+    STARTUP_PHASE_COUNT
 } StartupPhase_t;
 
 /* Error codes for startup failures */
@@ -35,6 +37,41 @@ typedef enum {
     STARTUP_ERROR_STACK_OVERFLOW
 } StartupError_t;
 
+/* Critical system checks */
+typedef enum {
+    STARTUP_CHECK_CLOCK = 0,
+    STARTUP_CHECK_RAM,
+    STARTUP_CHECK_FLASH_CRC,
+    STARTUP_CHECK_STACK,
+    STARTUP_CHECK_COUNT
+} StartupCheck_t;
+
+typedef enum {
+    CHECK_STATE_PENDING = 0,            /* Not started (staged: waiting for RUNNING) */
+    CHECK_STATE_RUNNING,                /* Background slices in progress */
+    CHECK_STATE_PASSED,
+    CHECK_STATE_FAILED
+} StartupCheckState_t;
+
+/* Startup modes */
+typedef enum {
+    STARTUP_MODE_FULL = 0,              /* All checks block startup */
+    STARTUP_MODE_STAGED                 /* RAM test and flash CRC run in slices after RUNNING */
+} StartupMode_t;
+
+/* Background slice sizes in staged mode */
+#define STARTUP_RAM_TEST_SLICE_WORDS    256u
+#define STARTUP_FLASH_CRC_SLICE_BYTES   16384u
+
+/* Timing of one check (microseconds since StartupMonitor_Init) */
+typedef struct {
+    StartupCheckState_t state;
+    uint32_t start_us;
+    uint32_t end_us;
+    uint32_t duration_us;               /* Time spent checking, excluding gaps between slices */
+    uint32_t slices;
+} StartupCheckTiming_t;
+
 /* Startup monitoring structure */
 typedef struct {
     StartupPhase_t current_phase;
@@ -43,6 +80,12 @@ typedef struct {
     uint32_t error_count;
     uint32_t last_reset_reason;
     uint32_t startup_timestamp;
+    
+    /* Boot profile (microseconds since StartupMonitor_Init) */
+    StartupMode_t mode;
+    uint32_t phase_entry_us[STARTUP_PHASE_COUNT];
+    uint32_t phase_duration_us[STARTUP_PHASE_COUNT];    /* Completed phases only */
+    StartupCheckTiming_t checks[STARTUP_CHECK_COUNT];
 } StartupMonitor_t;
 
 /* Function prototypes */
@@ -50,7 +93,14 @@ void StartupMonitor_Init(void);
 void StartupMonitor_SetPhase(StartupPhase_t phase);
 void StartupMonitor_ReportError(StartupError_t error);
 StartupMonitor_t* StartupMonitor_GetStatus(void);
+const StartupJournal_t* StartupMonitor_GetJournal(void);
 bool StartupMonitor_CheckCriticalSystems(void);
+void StartupMonitor_SetMode(StartupMode_t mode);
+void StartupMonitor_SetJournalFlash(const JournalFlash_t* flash);
+void StartupMonitor_SetCheckRegions(const uint8_t* flash, uint32_t flash_size, uint32_t flash_crc,
+                                    uint32_t* ram, uint32_t ram_words);
+bool StartupMonitor_RunBackgroundChecks(void);
+uint32_t StartupMonitor_Crc32(const uint8_t* data, uint32_t length);
 void StartupMonitor_EmergencyRecovery(void);
 
 #endif /* ECU_STARTUP_MONITOR_H */
\ No newline at end of file
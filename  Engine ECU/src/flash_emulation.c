@@ -0,0 +1,102 @@
+/**
+ * @file flash_emulation.c
+ * @brief Host emulation of the journal flash region
+ * @version 1.0
+ * @date 2024-11-07
+ *
+ * NOR semantics on a RAM image: programming can only clear bits, erase
+ * sets a whole sector to 0xFF. Every program and erase is written through
+ * to a backing file so the journal survives between runs. Without a file
+ * the region lives in RAM only.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "flash_emulation.h"
+
+static uint8_t flash_image[JOURNAL_REGION_SIZE];
+static FILE* flash_file = NULL;
+
+static bool write_through(uint32_t offset, uint32_t length) {
+    if (flash_file == NULL) {
+        return true;
+    }
+    if (fseek(flash_file, (long)offset, SEEK_SET) != 0 ||
+        fwrite(flash_image + offset, 1, length, flash_file) != length) {
+        return false;
+    }
+    return fflush(flash_file) == 0;
+}
+
+static bool flash_read(uint32_t offset, uint8_t* data, uint32_t length) {
+    if (offset > JOURNAL_REGION_SIZE || length > JOURNAL_REGION_SIZE - offset) {
+        return false;
+    }
+    memcpy(data, flash_image + offset, length);
+    return true;
+}
+
+static bool flash_program(uint32_t offset, const uint8_t* data, uint32_t length) {
+    uint32_t i;
+
+    if (offset > JOURNAL_REGION_SIZE || length > JOURNAL_REGION_SIZE - offset) {
+        return false;
+    }
+    for (i = 0; i < length; i++) {
+        flash_image[offset + i] &= data[i];
+    }
+    return write_through(offset, length);
+}
+
+static bool flash_erase(uint32_t sector) {
+    if (sector >= JOURNAL_SECTOR_COUNT) {
+        return false;
+    }
+    memset(flash_image + sector * JOURNAL_SECTOR_SIZE, 0xFF, JOURNAL_SECTOR_SIZE);
+    return write_through(sector * JOURNAL_SECTOR_SIZE, JOURNAL_SECTOR_SIZE);
+}
+
+static const JournalFlash_t flash_driver = {
+    flash_read,
+    flash_program,
+    flash_erase
+};
+
+/**
+ * @brief Load the region from path (created erased if missing)
+ */
+const JournalFlash_t* FlashEmulation_Init(const char* path) {
+    size_t loaded = 0;
+
+    FlashEmulation_Close();
+    memset(flash_image, 0xFF, sizeof(flash_image));
+
+    if (path != NULL) {
+        flash_file = fopen(path, "r+b");
+        if (flash_file != NULL) {
+            loaded = fread(flash_image, 1, sizeof(flash_image), flash_file);
+        } else {
+            flash_file = fopen(path, "w+b");
+        }
+        /* Short or new file: pad to the full region */
+        if (flash_file != NULL && loaded < sizeof(flash_image) &&
+            !write_through((uint32_t)loaded, (uint32_t)(sizeof(flash_image) - loaded))) {
+            FlashEmulation_Close();
+        }
+    }
+    return &flash_driver;
+}
+
+/**
+ * @brief True if the region is backed by a file
+ */
+bool FlashEmulation_IsPersistent(void) {
+    return flash_file != NULL;
+}
+
+void FlashEmulation_Close(void) {
+    if (flash_file != NULL) {
+        fclose(flash_file);
+        flash_file = NULL;
+    }
+}
@@ -0,0 +1,20 @@
+/**
+ * @file flash_emulation.h
+ * @brief Host emulation of the journal flash region
+ */
+
+#ifndef FLASH_EMULATION_H
+#define FLASH_EMULATION_H
+
+#include <stdbool.h>
+#include "startup_journal.h"
+
+/* Default backing file, relative to the working directory */
+#define FLASH_EMULATION_DEFAULT_FILE    "logs/startup_journal.bin"
+
+/* Function prototypes */
+const JournalFlash_t* FlashEmulation_Init(const char* path);
+bool FlashEmulation_IsPersistent(void);
+void FlashEmulation_Close(void);
+
+#endif /* FLASH_EMULATION_H */
@@ -8,10 +8,135 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "ecu_startup_monitor.h"
+#include "flash_emulation.h"
+
+static const char* const phase_names[] = {
+    "INIT", "BSW_INIT", "RTE_START", "APP_INIT", "RUNNING", "ERROR"
+};
+
+static const char* const error_names[] = {
+    "NONE", "CLOCK_FAIL", "RAM_TEST_FAIL", "FLASH_CRC_FAIL", "BSW_INIT_FAIL",
+    "RTE_START_FAIL", "APP_INIT_FAIL", "WATCHDOG_RESET", "STACK_OVERFLOW"
+};
+
+static const char* const check_names[STARTUP_CHECK_COUNT] = {
+    "Clock", "RAM march", "Flash CRC", "Stack"
+};
+
+static const char* const check_state_names[] = {
+    "PENDING", "RUNNING", "PASSED", "FAILED"
+};
+
+/* Simulated application flash image and RAM area for the startup checks */
+#define SIM_FLASH_SIZE      (512u * 1024u)
+#define SIM_RAM_WORDS       (16u * 1024u)
+
+static uint8_t sim_flash[SIM_FLASH_SIZE];
+static uint32_t sim_ram[SIM_RAM_WORDS];
+
+static const char* phase_name(uint32_t phase) {
+    return phase < sizeof(phase_names) / sizeof(phase_names[0]) ? phase_names[phase] : "?";
+}
+
+static const char* error_name(uint32_t error) {
+    return error < sizeof(error_names) / sizeof(error_names[0]) ? error_names[error] : "?";
+}
+
+/* Print one journal record per line, oldest first */
+static void print_journal_record(const JournalRecord_t* record, void* context) {
+    (void)context;
+    printf("%8u  boot %-5u %10u us  ", record->sequence, record->boot_count, record->timestamp_us);
+    switch (record->type) {
+        case JOURNAL_EVENT_BOOT:
+            printf("BOOT      reset reason 0x%02X\n", record->code);
+            break;
+        case JOURNAL_EVENT_PHASE:
+            printf("PHASE     %s -> %s\n", phase_name(record->detail), phase_name(record->code));
+            break;
+        case JOURNAL_EVENT_ERROR:
+            printf("ERROR     %s in %s\n", error_name(record->code), phase_name(record->detail));
+            break;
+        case JOURNAL_EVENT_RECOVERY:
+            printf("RECOVERY  from %s\n", phase_name(record->detail));
+            break;
+        default:
+            printf("UNKNOWN   type %u\n", record->type);
+            break;
+    }
+}
+
+/* Per-phase and per-check startup timing */
+static void print_boot_profile(const StartupMonitor_t* status) {
+    uint32_t i;
+    
+    printf("\nBoot Profile (%s startup):\n", status->mode == STARTUP_MODE_STAGED ? "staged" : "full");
+    printf("  %-10s %10s %12s\n", "Phase", "Entry us", "Duration us");
+    for (i = STARTUP_PHASE_INIT; i < STARTUP_PHASE_RUNNING; i++) {
+        printf("  %-10s %10u %12u\n", phase_name(i), status->phase_entry_us[i], status->phase_duration_us[i]);
+    }
+    printf("  Time to RUNNING: %u us\n", status->phase_entry_us[STARTUP_PHASE_RUNNING]);
+    
+    printf("  %-10s %-8s %10s %12s %7s\n", "Check", "State", "Start us", "Duration us", "Slices");
+    for (i = 0; i < STARTUP_CHECK_COUNT; i++) {
+        const StartupCheckTiming_t* check = &status->checks[i];
+        printf("  %-10s %-8s %10u %12u %7u\n", check_names[i], check_state_names[check->state],
+               check->start_us, check->duration_us, check->slices);
+    }
+}
+
+/* Emulated journal flash, backed by ENGINE_ECU_JOURNAL or the default file */
+static const JournalFlash_t* open_journal_flash(void) {
+    const char* journal_file = getenv("ENGINE_ECU_JOURNAL");
+    return FlashEmulation_Init(journal_file ? journal_file : FLASH_EMULATION_DEFAULT_FILE);
+}
+
+/* Dump the startup journal without booting (used by troubleshoot_startup.sh) */
+static int dump_journal(void) {
+    StartupJournal_t journal;
+    uint32_t count;
+    
+    if (!StartupJournal_Init(&journal, open_journal_flash())) {
+        printf("Startup journal unavailable\n");
+        return -1;
+    }
+    printf("Startup Journal (%s)\n", FlashEmulation_IsPersistent() ? "persistent" : "RAM only");
+    printf("%8s  %-10s %13s  %s\n", "Seq", "Boot", "Time", "Event");
+    count = StartupJournal_ForEach(&journal, print_journal_record, NULL);
+    printf("%u records, head sector %u slot %u, boot scan read %u records\n",
+           count, journal.head_sector, journal.head_slot, journal.scan_reads);
+    FlashEmulation_Close();
+    return 0;
+}
 
 /* Production ECU Main Function */
-int main(void) {
+int main(int argc, char* argv[]) {
+    bool staged = false;
+    uint32_t seed = 0x2024u;
+    uint32_t i;
+    int arg;
+    
+    for (arg = 1; arg < argc; arg++) {
+        if (strcmp(argv[arg], "--journal") == 0) {
+            return dump_journal();
+        }
+        if (strcmp(argv[arg], "--staged") == 0) {
+            staged = true;
+        }
+    }
+    
+    /* Application image and the reference CRC stored with it by the flash tool */
+    for (i = 0; i < SIM_FLASH_SIZE; i++) {
+        seed = seed * 1103515245u + 12345u;
+        sim_flash[i] = (uint8_t)(seed >> 16);
+    }
+    StartupMonitor_SetCheckRegions(sim_flash, SIM_FLASH_SIZE, StartupMonitor_Crc32(sim_flash, SIM_FLASH_SIZE),
+                                   sim_ram, SIM_RAM_WORDS);
+    StartupMonitor_SetMode(staged ? STARTUP_MODE_STAGED : STARTUP_MODE_FULL);
+    StartupMonitor_SetJournalFlash(open_journal_flash());
+    
     printf("Engine ECU Startup Sequence Initiated\n");
     printf("=====================================\n");
     
@@ -41,11 +166,15 @@ int main(void) {
         
         /* Get startup status */
         StartupMonitor_t* status = StartupMonitor_GetStatus();
+        const StartupJournal_t* journal = StartupMonitor_GetJournal();
         printf("\nStartup Summary:\n");
         printf("- Current Phase: %d\n", status->current_phase);
         printf("- Boot Count: %u\n", status->boot_count);
         printf("- Error Count: %u\n", status->error_count);
         printf("- Last Error: %d\n", status->last_error);
+        printf("- Journal: head sector %u slot %u (boot scan read %u records)\n",
+               journal->head_sector, journal->head_slot, journal->scan_reads);
+        print_boot_profile(status);
         
         printf("\n🎉 ENGINE ECU STARTUP SUCCESSFUL! 🎉\n");
         printf("ECU is now ready for vehicle operation.\n");
@@ -68,5 +197,21 @@ int main(void) {
     printf("\nEngine ECU Main Loop Running...\n");
     printf("(In production, this would be the main control loop)\n");
     
+    /* Staged startup: deferred checks run one slice per background task cycle */
+    if (staged) {
+        uint32_t cycles = 0;
+        while (StartupMonitor_RunBackgroundChecks()) {
+            cycles++;
+        }
+        StartupMonitor_t* status = StartupMonitor_GetStatus();
+        printf("Background checks finished after %u cycles: RAM %s, Flash CRC %s\n", cycles + 1,
+               check_state_names[status->checks[STARTUP_CHECK_RAM].state],
+               check_state_names[status->checks[STARTUP_CHECK_FLASH_CRC].state]);
+        print_boot_profile(status);
+        if (status->current_phase == STARTUP_PHASE_ERROR) {
+            return -1;
+        }
+    }
+    
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,292 @@
+/**
+ * @file startup_journal.c
+ * @brief Append-only startup event journal in a flash region
+ * @version 1.0
+ * @date 2024-11-07
+ *
+ * The region is a ring of JOURNAL_SECTOR_COUNT erase sectors filled with
+ * 16-byte records in order. Each record carries a sequence number and a
+ * CRC-16 (the shared BSW Crc module), so a record torn by a power failure
+ * is simply skipped. Sectors
+ * are reused in ring order, which spreads erase cycles evenly.
+ *
+ * Sequence numbers are consecutive: slot k of a sector holds the sequence
+ * of slot 0 plus k. The boot scan therefore reads slot 0 of every sector to
+ * find the newest sector, then binary-searches it for the first erased
+ * slot - JOURNAL_SECTOR_COUNT + log2(JOURNAL_RECORDS_PER_SECTOR) reads in
+ * the usual case. Appending programs one record; the next sector is erased
+ * ahead of time by StartupJournal_Maintain so that boot never waits for an
+ * erase.
+ */
+
+#include <string.h>
+#include "startup_journal.h"
+#include "Crc.h"
+
+#if JOURNAL_SECTOR_COUNT < 2
+#error "The startup journal needs at least two sectors"
+#endif
+
+/* Record layout (little-endian) */
+#define REC_SEQUENCE    0u
+#define REC_TIMESTAMP   4u
+#define REC_BOOT_COUNT  8u
+#define REC_TYPE        10u
+#define REC_CODE        11u
+#define REC_DETAIL      12u
+#define REC_CRC         14u
+
+static void put_u16(uint8_t* p, uint16_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(uint8_t* p, uint32_t value) {
+    put_u16(p, (uint16_t)value);
+    put_u16(p + 2, (uint16_t)(value >> 16));
+}
+
+static uint16_t get_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    return (uint32_t)get_u16(p) | ((uint32_t)get_u16(p + 2) << 16);
+}
+
+static uint32_t slot_offset(uint32_t sector, uint32_t slot) {
+    return sector * JOURNAL_SECTOR_SIZE + slot * JOURNAL_RECORD_SIZE;
+}
+
+static bool read_slot(const StartupJournal_t* journal, uint32_t sector, uint32_t slot,
+                      uint8_t raw[JOURNAL_RECORD_SIZE]) {
+    return journal->flash->read(slot_offset(sector, slot), raw, JOURNAL_RECORD_SIZE);
+}
+
+static bool is_erased(const uint8_t raw[JOURNAL_RECORD_SIZE]) {
+    uint32_t i;
+    for (i = 0; i < JOURNAL_RECORD_SIZE; i++) {
+        if (raw[i] != 0xFFu) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Decode a record, false if erased, torn or corrupted
+ */
+static bool decode_record(const uint8_t raw[JOURNAL_RECORD_SIZE], JournalRecord_t* record) {
+    if (get_u16(raw + REC_CRC) != Crc16_Calc(raw, REC_CRC) || is_erased(raw)) {
+        return false;
+    }
+    record->sequence = get_u32(raw + REC_SEQUENCE);
+    record->timestamp_us = get_u32(raw + REC_TIMESTAMP);
+    record->boot_count = get_u16(raw + REC_BOOT_COUNT);
+    record->type = raw[REC_TYPE];
+    record->code = raw[REC_CODE];
+    record->detail = get_u16(raw + REC_DETAIL);
+    return true;
+}
+
+/**
+ * @brief First erased slot of a sector at or after low (slots are written in order after an erase)
+ */
+static uint32_t find_free_slot(StartupJournal_t* journal, uint32_t sector, uint32_t low) {
+    uint8_t raw[JOURNAL_RECORD_SIZE];
+    uint32_t high = JOURNAL_RECORDS_PER_SECTOR;
+
+    while (low < high) {
+        uint32_t mid = (low + high) / 2;
+        journal->scan_reads++;
+        if (read_slot(journal, sector, mid, raw) && is_erased(raw)) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Locate the journal head
+ */
+bool StartupJournal_Init(StartupJournal_t* journal, const JournalFlash_t* flash) {
+    uint8_t raw[JOURNAL_RECORD_SIZE];
+    JournalRecord_t record;
+    bool found = false;
+    uint32_t newest_sequence = 0;
+    uint32_t sector;
+    uint32_t slot;
+
+    memset(journal, 0, sizeof(*journal));
+    journal->flash = flash;
+    if (flash == NULL) {
+        return false;
+    }
+
+    /* Newest sector: highest sequence in slot 0 */
+    for (sector = 0; sector < JOURNAL_SECTOR_COUNT; sector++) {
+        journal->scan_reads++;
+        if (read_slot(journal, sector, 0, raw) && decode_record(raw, &record) &&
+            (!found || (int32_t)(record.sequence - newest_sequence) > 0)) {
+            found = true;
+            newest_sequence = record.sequence;
+            journal->head_sector = sector;
+        }
+    }
+
+    if (!found) {
+        /* Blank or unreadable region: start over in sector 0 */
+        journal->head_sector = 0;
+        journal->head_slot = 0;
+        journal->next_sequence = 0;
+        return flash->erase(0);
+    }
+
+    journal->head_slot = find_free_slot(journal, journal->head_sector, 1);
+
+    /*
+     * A full head whose successor starts with a torn slot 0: the successor
+     * is the real head if its first valid record continues the sequence.
+     */
+    if (journal->head_slot == JOURNAL_RECORDS_PER_SECTOR) {
+        sector = (journal->head_sector + 1u) % JOURNAL_SECTOR_COUNT;
+        for (slot = 1; slot < JOURNAL_RECORDS_PER_SECTOR; slot++) {
+            journal->scan_reads++;
+            if (!read_slot(journal, sector, slot, raw) || is_erased(raw)) {
+                break;
+            }
+            if (decode_record(raw, &record)) {
+                if (record.sequence == newest_sequence + JOURNAL_RECORDS_PER_SECTOR + slot) {
+                    newest_sequence += JOURNAL_RECORDS_PER_SECTOR;
+                    journal->head_sector = sector;
+                    journal->head_slot = find_free_slot(journal, sector, slot + 1u);
+                }
+                break;
+            }
+        }
+    }
+
+    journal->next_sequence = newest_sequence + journal->head_slot;
+    return true;
+}
+
+/**
+ * @brief Append one record (one flash program, plus an erase only if not pre-erased)
+ */
+bool StartupJournal_Append(StartupJournal_t* journal, JournalEvent_t type, uint16_t boot_count,
+                           uint8_t code, uint16_t detail, uint32_t timestamp_us) {
+    uint8_t raw[JOURNAL_RECORD_SIZE];
+    bool ok;
+
+    if (journal->flash == NULL) {
+        return false;
+    }
+
+    if (journal->head_slot >= JOURNAL_RECORDS_PER_SECTOR) {
+        uint32_t next = (journal->head_sector + 1u) % JOURNAL_SECTOR_COUNT;
+        if (!journal->next_sector_erased && !journal->flash->erase(next)) {
+            journal->append_failures++;
+            return false;
+        }
+        journal->head_sector = next;
+        journal->head_slot = 0;
+        journal->next_sector_erased = false;
+    }
+
+    put_u32(raw + REC_SEQUENCE, journal->next_sequence);
+    put_u32(raw + REC_TIMESTAMP, timestamp_us);
+    put_u16(raw + REC_BOOT_COUNT, boot_count);
+    raw[REC_TYPE] = (uint8_t)type;
+    raw[REC_CODE] = code;
+    put_u16(raw + REC_DETAIL, detail);
+    put_u16(raw + REC_CRC, Crc16_Calc(raw, REC_CRC));
+
+    ok = journal->flash->program(slot_offset(journal->head_sector, journal->head_slot),
+                                 raw, JOURNAL_RECORD_SIZE);
+
+    /* A failed program still consumes its slot to keep sequences consecutive */
+    journal->head_slot++;
+    journal->next_sequence++;
+    if (!ok) {
+        journal->append_failures++;
+    }
+    return ok;
+}
+
+/**
+ * @brief Erase the next sector once the head sector is half full (call outside boot)
+ */
+void StartupJournal_Maintain(StartupJournal_t* journal) {
+    if (journal->flash == NULL || journal->next_sector_erased ||
+        journal->head_slot < JOURNAL_RECORDS_PER_SECTOR / 2u) {
+        return;
+    }
+    journal->next_sector_erased =
+        journal->flash->erase((journal->head_sector + 1u) % JOURNAL_SECTOR_COUNT);
+}
+
+/**
+ * @brief Newest valid record
+ */
+bool StartupJournal_GetLast(const StartupJournal_t* journal, JournalRecord_t* record) {
+    uint8_t raw[JOURNAL_RECORD_SIZE];
+    uint32_t sector = journal->head_sector;
+    uint32_t slot = journal->head_slot;
+    uint32_t remaining = JOURNAL_SECTOR_COUNT * JOURNAL_RECORDS_PER_SECTOR;
+
+    if (journal->flash == NULL) {
+        return false;
+    }
+
+    /* Usually the slot just before the head; walk back past torn records */
+    while (remaining-- > 0) {
+        if (slot == 0) {
+            sector = (sector + JOURNAL_SECTOR_COUNT - 1u) % JOURNAL_SECTOR_COUNT;
+            slot = JOURNAL_RECORDS_PER_SECTOR;
+        }
+        slot--;
+        if (!read_slot(journal, sector, slot, raw)) {
+            return false;
+        }
+        if (decode_record(raw, record)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Visit all valid records, oldest first
+ * @return Number of records visited
+ */
+uint32_t StartupJournal_ForEach(const StartupJournal_t* journal, JournalVisitor_t visitor, void* context) {
+    uint8_t raw[JOURNAL_RECORD_SIZE];
+    JournalRecord_t record;
+    uint32_t count = 0;
+    uint32_t i;
+    uint32_t slot;
+
+    if (journal->flash == NULL) {
+        return 0;
+    }
+
+    for (i = 1; i <= JOURNAL_SECTOR_COUNT; i++) {
+        uint32_t sector = (journal->head_sector + i) % JOURNAL_SECTOR_COUNT;
+        uint32_t end = (i == JOURNAL_SECTOR_COUNT) ? journal->head_slot : JOURNAL_RECORDS_PER_SECTOR;
+
+        for (slot = 0; slot < end; slot++) {
+            if (!read_slot(journal, sector, slot, raw) || is_erased(raw)) {
+                break;
+            }
+            if (decode_record(raw, &record)) {
+                if (visitor != NULL) {
+                    visitor(&record, context);
+                }
+                count++;
+            }
+        }
+    }
+    return count;
+}
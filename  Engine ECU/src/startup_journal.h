@@ -0,0 +1,65 @@
+/**
+ * @file startup_journal.h
+ * @brief Append-only startup event journal in a flash region
+ */
+
+#ifndef STARTUP_JOURNAL_H
+#define STARTUP_JOURNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Journal geometry: a ring of erase sectors holding fixed-size records */
+#define JOURNAL_RECORD_SIZE         16u
+#define JOURNAL_SECTOR_SIZE         512u
+#define JOURNAL_SECTOR_COUNT        4u
+#define JOURNAL_RECORDS_PER_SECTOR  (JOURNAL_SECTOR_SIZE / JOURNAL_RECORD_SIZE)
+#define JOURNAL_REGION_SIZE         (JOURNAL_SECTOR_SIZE * JOURNAL_SECTOR_COUNT)
+
+/* Journal event types */
+typedef enum {
+    JOURNAL_EVENT_BOOT = 1,             /* code = reset reason */
+    JOURNAL_EVENT_PHASE = 2,            /* code = new phase, detail = previous phase */
+    JOURNAL_EVENT_ERROR = 3,            /* code = StartupError_t, detail = phase */
+    JOURNAL_EVENT_RECOVERY = 4          /* detail = phase */
+} JournalEvent_t;
+
+/* Decoded journal record */
+typedef struct {
+    uint32_t sequence;                  /* Consecutive across the whole journal */
+    uint32_t timestamp_us;              /* Time since StartupMonitor_Init */
+    uint16_t boot_count;
+    uint8_t type;                       /* JournalEvent_t */
+    uint8_t code;
+    uint16_t detail;
+} JournalRecord_t;
+
+/* Flash driver: programming may only clear bits, erase sets a sector to 0xFF */
+typedef struct {
+    bool (*read)(uint32_t offset, uint8_t* data, uint32_t length);
+    bool (*program)(uint32_t offset, const uint8_t* data, uint32_t length);
+    bool (*erase)(uint32_t sector);
+} JournalFlash_t;
+
+/* Journal state; only the head position is kept in RAM */
+typedef struct {
+    const JournalFlash_t* flash;
+    uint32_t head_sector;               /* Sector being appended to */
+    uint32_t head_slot;                 /* Next free record slot in head_sector */
+    uint32_t next_sequence;
+    bool next_sector_erased;            /* Successor pre-erased by StartupJournal_Maintain */
+    uint32_t scan_reads;                /* Records read by the last boot scan */
+    uint32_t append_failures;
+} StartupJournal_t;
+
+typedef void (*JournalVisitor_t)(const JournalRecord_t* record, void* context);
+
+/* Function prototypes */
+bool StartupJournal_Init(StartupJournal_t* journal, const JournalFlash_t* flash);
+bool StartupJournal_Append(StartupJournal_t* journal, JournalEvent_t type, uint16_t boot_count,
+                           uint8_t code, uint16_t detail, uint32_t timestamp_us);
+void StartupJournal_Maintain(StartupJournal_t* journal);
+bool StartupJournal_GetLast(const StartupJournal_t* journal, JournalRecord_t* record);
+uint32_t StartupJournal_ForEach(const StartupJournal_t* journal, JournalVisitor_t visitor, void* context);
+
+#endif /* STARTUP_JOURNAL_H */
@@ -0,0 +1,260 @@
+/**
+ * @file startup_journal_test.c
+ * @brief Host test of the startup journal boot scan
+ * @version 1.0
+ * @date 2024-11-07
+ *
+ * Runs startup_journal.c on a RAM flash that, like the real part, can only
+ * clear bits when programming. Each case writes a journal, damages it the
+ * way a power failure would, then checks what a fresh boot scan finds:
+ * head position, next sequence, last record and the records visited.
+ * Exits with status 1 on any failed check.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "startup_journal.h"
+
+#define RECORDS_PER_REGION  (JOURNAL_SECTOR_COUNT * JOURNAL_RECORDS_PER_SECTOR)
+
+static uint8_t flash_memory[JOURNAL_REGION_SIZE];
+static uint32_t failures = 0;
+
+static bool ram_read(uint32_t offset, uint8_t* data, uint32_t length) {
+    if (offset + length > JOURNAL_REGION_SIZE) {
+        return false;
+    }
+    memcpy(data, &flash_memory[offset], length);
+    return true;
+}
+
+static bool ram_program(uint32_t offset, const uint8_t* data, uint32_t length) {
+    uint32_t i;
+    if (offset + length > JOURNAL_REGION_SIZE) {
+        return false;
+    }
+    for (i = 0; i < length; i++) {
+        flash_memory[offset + i] &= data[i];
+    }
+    return true;
+}
+
+static bool ram_erase(uint32_t sector) {
+    if (sector >= JOURNAL_SECTOR_COUNT) {
+        return false;
+    }
+    memset(&flash_memory[sector * JOURNAL_SECTOR_SIZE], 0xFF, JOURNAL_SECTOR_SIZE);
+    return true;
+}
+
+static const JournalFlash_t ram_flash = { ram_read, ram_program, ram_erase };
+
+/* Records seen by StartupJournal_ForEach */
+typedef struct {
+    uint32_t count;
+    uint32_t first_sequence;
+    uint32_t last_sequence;
+    bool in_order;
+} VisitSummary_t;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        printf("    FAILED: %s\n", what);
+        failures++;
+    }
+}
+
+static void visit(const JournalRecord_t* record, void* context) {
+    VisitSummary_t* summary = (VisitSummary_t*)context;
+    if (summary->count == 0) {
+        summary->first_sequence = record->sequence;
+    } else if (record->sequence <= summary->last_sequence) {
+        summary->in_order = false;
+    }
+    summary->last_sequence = record->sequence;
+    summary->count++;
+}
+
+static VisitSummary_t visit_all(const StartupJournal_t* journal) {
+    VisitSummary_t summary = { 0, 0, 0, true };
+    StartupJournal_ForEach(journal, visit, &summary);
+    return summary;
+}
+
+/* Append count records, the sequence number doubles as the detail */
+static void write_records(StartupJournal_t* journal, uint32_t count) {
+    uint32_t i;
+    for (i = 0; i < count; i++) {
+        StartupJournal_Append(journal, JOURNAL_EVENT_PHASE, (uint16_t)(journal->next_sequence / 8u),
+                              (uint8_t)i, (uint16_t)journal->next_sequence, i * 100u);
+    }
+}
+
+static void reset_flash(StartupJournal_t* journal) {
+    memset(flash_memory, 0x5A, sizeof(flash_memory));    /* Never erased */
+    check(StartupJournal_Init(journal, &ram_flash), "blank region initializes");
+}
+
+/* Power failure while programming: only the first bytes made it */
+static void truncate_slot(uint32_t sector, uint32_t slot) {
+    uint32_t offset = sector * JOURNAL_SECTOR_SIZE + slot * JOURNAL_RECORD_SIZE;
+    memset(&flash_memory[offset + JOURNAL_RECORD_SIZE / 2u], 0xFF, JOURNAL_RECORD_SIZE / 2u);
+}
+
+/* Bit error in a programmed record */
+static void corrupt_slot(uint32_t sector, uint32_t slot) {
+    flash_memory[sector * JOURNAL_SECTOR_SIZE + slot * JOURNAL_RECORD_SIZE + 4u] ^= 0x01u;
+}
+
+static void check_blank_and_reboot(void) {
+    StartupJournal_t journal;
+    StartupJournal_t rebooted;
+    JournalRecord_t last;
+    VisitSummary_t summary;
+
+    printf("  Blank region and reboot\n");
+    reset_flash(&journal);
+    check(journal.head_sector == 0 && journal.head_slot == 0 && journal.next_sequence == 0,
+          "blank region starts at sector 0 slot 0");
+    check(!StartupJournal_GetLast(&journal, &last), "blank region has no last record");
+
+    write_records(&journal, 10);
+    check(StartupJournal_Init(&rebooted, &ram_flash), "reboot finds the journal");
+    check(rebooted.head_sector == 0 && rebooted.head_slot == 10, "head after 10 records");
+    check(rebooted.next_sequence == 10, "sequence continues after 10 records");
+    check(StartupJournal_GetLast(&rebooted, &last) && last.sequence == 9 && last.code == 9,
+          "last record is the tenth");
+    check(rebooted.scan_reads <= JOURNAL_SECTOR_COUNT + 6u, "boot scan reads slot 0s plus a binary search");
+
+    summary = visit_all(&rebooted);
+    check(summary.count == 10 && summary.first_sequence == 0 && summary.in_order,
+          "all 10 records visited in order");
+}
+
+static void check_torn_record(void) {
+    StartupJournal_t journal;
+    StartupJournal_t rebooted;
+    JournalRecord_t last;
+    VisitSummary_t summary;
+
+    printf("  Torn last record in the head sector\n");
+    reset_flash(&journal);
+    write_records(&journal, 12);
+    truncate_slot(0, 11);
+
+    check(StartupJournal_Init(&rebooted, &ram_flash), "reboot after a torn record");
+    check(rebooted.head_sector == 0 && rebooted.head_slot == 12, "torn slot is not reused");
+    check(rebooted.next_sequence == 12, "sequence skips the torn record");
+    check(StartupJournal_GetLast(&rebooted, &last) && last.sequence == 10,
+          "last record is the one before the torn record");
+    summary = visit_all(&rebooted);
+    check(summary.count == 11 && summary.in_order, "torn record is skipped when visiting");
+
+    /* Appending after the torn record keeps the sequence consecutive */
+    write_records(&rebooted, 1);
+    check(StartupJournal_Init(&journal, &ram_flash) && journal.next_sequence == 13 && journal.head_slot == 13,
+          "append after the torn record continues the sequence");
+}
+
+static void check_wrap(void) {
+    StartupJournal_t journal;
+    StartupJournal_t rebooted;
+    JournalRecord_t last;
+    VisitSummary_t summary;
+    uint32_t written = RECORDS_PER_REGION + JOURNAL_RECORDS_PER_SECTOR + 5u;
+
+    printf("  Wrap around the ring\n");
+    reset_flash(&journal);
+    write_records(&journal, written);
+
+    check(StartupJournal_Init(&rebooted, &ram_flash), "reboot after wrapping");
+    check(rebooted.head_sector == 1 && rebooted.head_slot == 5, "head in the reused sector");
+    check(rebooted.next_sequence == written, "sequence continues after wrapping");
+    check(StartupJournal_GetLast(&rebooted, &last) && last.sequence == written - 1u,
+          "last record is the newest");
+
+    /* The oldest sector was erased for the head; the others are intact */
+    summary = visit_all(&rebooted);
+    check(summary.count == (JOURNAL_SECTOR_COUNT - 1u) * JOURNAL_RECORDS_PER_SECTOR + 5u,
+          "records of the overwritten sector are gone");
+    check(summary.last_sequence == written - 1u && summary.in_order, "visited oldest first");
+    check(summary.first_sequence == written - summary.count, "visited records are consecutive");
+}
+
+/*
+ * The head sector fills, the successor is erased and its slot 0 is torn.
+ * full_sectors > JOURNAL_SECTOR_COUNT makes the new head a reused sector.
+ */
+static void check_torn_slot0(uint32_t full_sectors, bool truncate, uint32_t after) {
+    StartupJournal_t journal;
+    StartupJournal_t rebooted;
+    JournalRecord_t last;
+    VisitSummary_t summary;
+    uint32_t full = full_sectors * JOURNAL_RECORDS_PER_SECTOR;
+    uint32_t head = full_sectors % JOURNAL_SECTOR_COUNT;
+    uint32_t newest;
+    uint32_t next;
+
+    printf("  %s slot 0 of new head sector %u after %u full sectors, %u records after it\n",
+           truncate ? "Truncated" : "Corrupted", head, full_sectors, after);
+    reset_flash(&journal);
+    write_records(&journal, full + 1u + after);
+    if (truncate) {
+        truncate_slot(head, 0);
+    } else {
+        corrupt_slot(head, 0);
+    }
+
+    check(StartupJournal_Init(&rebooted, &ram_flash), "reboot after a torn slot 0");
+    if (after > 0) {
+        /* The records behind the torn slot 0 make the new sector the head */
+        check(rebooted.head_sector == head && rebooted.head_slot == 1u + after,
+              "head is behind the records after the torn slot 0");
+        newest = full + after;
+        next = full + 1u + after;
+    } else {
+        /* Nothing valid in the new sector: the full sector stays the head */
+        check(rebooted.head_sector == (head + JOURNAL_SECTOR_COUNT - 1u) % JOURNAL_SECTOR_COUNT &&
+              rebooted.head_slot == JOURNAL_RECORDS_PER_SECTOR,
+              "full sector stays the head");
+        /* The torn record's sequence is reused once its sector is erased */
+        newest = full - 1u;
+        next = full;
+    }
+    check(StartupJournal_GetLast(&rebooted, &last) && last.sequence == newest, "last valid record is found");
+    check(rebooted.next_sequence == next, "sequence continues from the last valid record");
+
+    summary = visit_all(&rebooted);
+    check(summary.in_order && summary.last_sequence == newest, "visited records end at the newest");
+
+    /* The next boot must still agree after another append */
+    write_records(&rebooted, 1);
+    check(StartupJournal_Init(&journal, &ram_flash) && journal.next_sequence == next + 1u,
+          "append after the torn slot 0 continues the sequence");
+    check(StartupJournal_GetLast(&journal, &last) && last.sequence == next,
+          "appended record is found as the last one");
+}
+
+int main(void) {
+    uint32_t full_sectors[] = { 1u, JOURNAL_SECTOR_COUNT + 1u };
+    uint32_t after[] = { 0u, 1u, 4u };
+    uint32_t s;
+    uint32_t a;
+
+    printf("Startup journal test\n");
+
+    check_blank_and_reboot();
+    check_torn_record();
+    check_wrap();
+    for (s = 0; s < sizeof(full_sectors) / sizeof(full_sectors[0]); s++) {
+        for (a = 0; a < sizeof(after) / sizeof(after[0]); a++) {
+            check_torn_slot0(full_sectors[s], true, after[a]);
+            check_torn_slot0(full_sectors[s], false, after[a]);
+        }
+    }
+
+    printf("%s (%u failed checks)\n", failures == 0 ? "PASSED" : "FAILED", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,540 @@
+# AUTOSAR Configuration Code Generator
+# Turns ARXML configuration into constant C/C++ tables with perfect-hash lookups
+
+import argparse
+import re
+import sys
+import xml.etree.ElementTree as ET
+from pathlib import Path
+
+HASH_SEED = 0x9E3779B1          # Golden-ratio multiplier, first candidate
+HASH_ATTEMPTS = 20000           # Multipliers tried per table size
+INVALID_INDEX = 0xFF            # Returned by lookups for unknown keys
+
+
+def local_name(element):
+    """Tag without the AUTOSAR namespace"""
+    return element.tag.rsplit('}', 1)[-1]
+
+
+def children(element, name):
+    """All descendants with the given local tag name"""
+    return [e for e in element.iter() if local_name(e) == name]
+
+
+def text(element, name, default=None):
+    """Text of the first descendant with the given local tag name"""
+    for e in element.iter():
+        if local_name(e) == name and e.text is not None:
+            return e.text.strip()
+    return default
+
+
+def ref_name(element, name):
+    """Last path segment of a reference, e.g. /Os/MainTask_10ms -> MainTask_10ms"""
+    value = text(element, name)
+    return value.rsplit('/', 1)[-1] if value else None
+
+
+def as_int(value, default=0):
+    return int(value, 0) if value is not None else default
+
+
+def as_bool(value, default=False):
+    return value.lower() == 'true' if value is not None else default
+
+
+def seconds_to_ms(value):
+    return int(round(float(value) * 1000)) if value is not None else 0
+
+
+def macro_name(short_name):
+    """ComIPdu_EngineSpeed -> ENGINE_SPEED, MainTask_10ms -> MAIN_TASK_10MS"""
+    name = re.sub(r'(?<=[a-z0-9])(?=[A-Z])', '_', short_name)
+    return re.sub(r'_+', '_', name).upper()
+
+
+def strip_prefix(short_name):
+    """Drop the module prefix of a short name: CanIfTxPdu_EngineSpeed -> EngineSpeed"""
+    return short_name.split('_', 1)[1] if '_' in short_name else short_name
+
+
+class PerfectHash:
+    """Collision-free multiplicative hash: slot = (key * multiplier) >> shift"""
+
+    def __init__(self, keys):
+        self.keys = keys
+        self.bits = max(1, (len(keys) - 1).bit_length())
+        while True:
+            multiplier = HASH_SEED
+            for _ in range(HASH_ATTEMPTS):
+                if self.try_multiplier(multiplier):
+                    return
+                multiplier = (multiplier * 1664525 + 1013904223) & 0xFFFFFFFF | 1
+            self.bits += 1
+
+    def slot(self, key, multiplier=None):
+        multiplier = self.multiplier if multiplier is None else multiplier
+        return ((key * multiplier) & 0xFFFFFFFF) >> (32 - self.bits)
+
+    def try_multiplier(self, multiplier):
+        slots = [self.slot(key, multiplier) for key in self.keys]
+        if len(set(slots)) != len(slots):
+            return False
+        self.multiplier = multiplier
+        self.shift = 32 - self.bits
+        # Empty slots point at entry 0; the key comparison rejects them
+        self.table = [0] * (1 << self.bits)
+        for index, slot in enumerate(slots):
+            self.table[slot] = index
+        return True
+
+
+class ArxmlConfig:
+    """Configuration collected from one or more ARXML files"""
+
+    def __init__(self):
+        self.sources = []
+        self.tasks = []
+        self.pdus = []
+        self.signals = []
+        self.dids = []
+        self.dtcs = []
+        self.com_pdus = {}
+        self.errors = []
+
+    def load(self, path):
+        """Parse one file; text before the XML declaration is ignored"""
+        data = Path(path).read_text(encoding='utf-8')
+        start = data.find('<?xml')
+        if start > 0:
+            data = data[start:]
+        try:
+            root = ET.fromstring(data.encode('utf-8'))
+        except ET.ParseError as e:
+            self.errors.append(f"XML parse error in {path}: {e}")
+            return
+        self.sources.append(Path(path).name)
+        self.collect_os(root)
+        self.collect_com(root)
+        self.collect_dcm(root)
+        self.collect_dem(root)
+
+    def collect_os(self, root):
+        seconds_per_tick = {}
+        for counter in children(root, 'OS-COUNTER'):
+            seconds_per_tick[text(counter, 'SHORT-NAME')] = float(text(counter, 'SECONDS-PER-TICK', '0.001'))
+
+        # Cyclic alarms give the task periods
+        periods = {}
+        for alarm in children(root, 'OS-ALARM'):
+            task = ref_name(alarm, 'ACTIVATE-TASK-REF')
+            cycle = text(alarm, 'CYCLE-TIME')
+            if task and cycle:
+                tick = seconds_per_tick.get(ref_name(alarm, 'COUNTER-REF'), 0.001)
+                periods[task] = int(round(int(cycle, 0) * tick * 1000))
+
+        for task in children(root, 'OS-TASK'):
+            name = text(task, 'SHORT-NAME')
+            self.tasks.append({
+                'name': name,
+                'priority': as_int(text(task, 'PRIORITY')),
+                'activation': as_int(text(task, 'ACTIVATION'), 1),
+                'stack': as_int(text(task, 'STACK-SIZE')),
+                'period_ms': periods.get(name, 0),
+                'autostart': as_bool(text(task, 'AUTOSTART')),
+                'preemptive': text(task, 'SCHEDULE', 'FULL') == 'FULL',
+                'suspendable': as_bool(text(task, 'SUSPENDABLE')),
+            })
+
+    def collect_com(self, root):
+        # Configuration-wide transmission mode, used by I-PDUs that reference it
+        default_period = 0
+        for config in children(root, 'COM-CONFIG'):
+            for mode in config.findall('{*}COM-TX-MODE-TRUE'):
+                if text(mode, 'COM-TX-MODE-MODE') == 'PERIODIC':
+                    default_period = seconds_to_ms(text(mode, 'COM-TX-MODE-TIME-PERIOD'))
+
+        for pdu in children(root, 'COM-I-PDU'):
+            period = 0
+            timeout = 0
+            for tx in pdu.findall('{*}COM-TX-I-PDU'):
+                own = tx.find('{*}COM-TX-MODE-TRUE')
+                if own is not None:
+                    if text(own, 'COM-TX-MODE-MODE') == 'PERIODIC':
+                        period = seconds_to_ms(text(own, 'COM-TX-MODE-TIME-PERIOD'))
+                elif text(tx, 'COM-TX-MODE-TRUE-REF'):
+                    period = default_period
+            for rx in pdu.findall('{*}COM-RX-I-PDU'):
+                timeout = seconds_to_ms(text(rx, 'COM-RX-I-PDU-TIMEOUT-TIMEOUT'))
+            name = text(pdu, 'SHORT-NAME')
+            self.com_pdus[strip_prefix(name)] = {
+                'comName': name,
+                'comId': as_int(text(pdu, 'COM-I-PDU-ID')),
+                'period_ms': period,
+                'timeout_ms': timeout,
+            }
+
+        # CanIf owns the CAN identifiers; Com timing is joined in resolve()
+        for tag, direction in (('CAN-IF-TX-PDU-CONFIG', 'TX'), ('CAN-IF-RX-PDU-CONFIG', 'RX')):
+            for pdu in children(root, tag):
+                self.pdus.append({
+                    'name': strip_prefix(text(pdu, 'SHORT-NAME')),
+                    'canId': as_int(text(pdu, f'CAN-IF-{direction}-PDU-CAN-ID')),
+                    'extended': text(pdu, f'CAN-IF-{direction}-PDU-CAN-ID-TYPE') == 'EXTENDED',
+                    'dlc': as_int(text(pdu, f'CAN-IF-{direction}-PDU-DLC'), 8),
+                    'tx': direction == 'TX',
+                })
+
+        signals = {}
+        for signal in children(root, 'COM-SIGNAL'):
+            signals[text(signal, 'SHORT-NAME')] = signal
+        for mapping in children(root, 'COM-I-SIGNAL-I-PDU'):
+            signal = signals.get(ref_name(mapping, 'COM-I-SIGNAL-REF'))
+            if signal is None:
+                self.errors.append(f"{text(mapping, 'SHORT-NAME')}: unknown signal reference")
+                continue
+            self.signals.append({
+                'name': strip_prefix(text(signal, 'SHORT-NAME')),
+                'comPdu': ref_name(mapping, 'COM-I-PDU-REF'),
+                'startBit': as_int(text(mapping, 'COM-START-POSITION')),
+                'length': as_int(text(signal, 'COM-SIGNAL-LENGTH')),
+                'littleEndian': text(signal, 'COM-SIGNAL-ENDIANNESS') == 'LEAST-SIGNIFICANT-BYTE-FIRST',
+                'init': as_int(text(signal, 'VALUE')),
+            })
+
+    def collect_dcm(self, root):
+        for did in children(root, 'DCM-DSP-DID'):
+            self.dids.append({
+                'name': strip_prefix(text(did, 'SHORT-NAME')),
+                'id': as_int(text(did, 'DCM-DSP-DID-IDENTIFIER')),
+                'size': as_int(text(did, 'DCM-DSP-DID-SIZE')),
+                'read': as_bool(text(did, 'DCM-DSP-DID-READ'), True),
+                'write': as_bool(text(did, 'DCM-DSP-DID-WRITE')),
+            })
+
+    def collect_dem(self, root):
+        for dtc in children(root, 'DEM-DTC'):
+            self.dtcs.append({
+                'name': strip_prefix(text(dtc, 'SHORT-NAME')),
+                'code': as_int(text(dtc, 'DEM-DTC-VALUE')),
+                'priority': as_int(text(dtc, 'DEM-DTC-PRIORITY'), 1),
+            })
+
+    def resolve(self):
+        """Join Com into CanIf PDUs, sort the keyed tables, link signals and check for conflicts"""
+        for pdu in self.pdus:
+            # Com and CanIf PDUs share the short-name suffix: ComIPdu_X <-> CanIfTxPdu_X
+            com = self.com_pdus.get(pdu['name'], {})
+            pdu['comName'] = com.get('comName')
+            pdu['comId'] = com.get('comId')
+            pdu['period_ms'] = com.get('period_ms', 0)
+            pdu['timeout_ms'] = com.get('timeout_ms', 0)
+
+        self.pdus.sort(key=lambda p: p['canId'])
+        self.dids.sort(key=lambda d: d['id'])
+        self.dtcs.sort(key=lambda d: d['code'])
+
+        self.check_unique(self.pdus, 'canId', 'CAN ID')
+        self.check_unique(self.dids, 'id', 'DID')
+        self.check_unique(self.dtcs, 'code', 'DTC')
+        for table, label in ((self.tasks, 'task'), (self.pdus, 'PDU'), (self.signals, 'signal'),
+                             (self.dids, 'DID'), (self.dtcs, 'DTC')):
+            self.check_unique(table, 'name', f'{label} name')
+            if len(table) >= INVALID_INDEX:
+                self.errors.append(f"Too many {label} entries for 8-bit indices: {len(table)}")
+
+        pdu_index = {p['comName']: i for i, p in enumerate(self.pdus) if p['comName']}
+        for signal in self.signals:
+            if signal['comPdu'] not in pdu_index:
+                self.errors.append(f"Signal {signal['name']}: I-PDU {signal['comPdu']} has no CAN ID")
+                signal['pdu'] = INVALID_INDEX
+            else:
+                signal['pdu'] = pdu_index[signal['comPdu']]
+            if signal['startBit'] + signal['length'] > 64:
+                self.errors.append(f"Signal {signal['name']} does not fit a 64-bit frame")
+        self.signals.sort(key=lambda s: (s['pdu'], s['startBit']))
+
+        for i, pdu in enumerate(self.pdus):
+            own = [j for j, s in enumerate(self.signals) if s['pdu'] == i]
+            pdu['firstSignal'] = own[0] if own else 0
+            pdu['signalCount'] = len(own)
+            if own and own[-1] - own[0] + 1 != len(own):
+                self.errors.append(f"PDU {pdu['name']}: signals are not contiguous")
+
+    def check_unique(self, table, field, label):
+        seen = set()
+        for entry in table:
+            if entry[field] in seen:
+                value = entry[field]
+                shown = f"0x{value:X}" if isinstance(value, int) else value
+                self.errors.append(f"Duplicate {label}: {shown}")
+            seen.add(entry[field])
+
+
+class HeaderWriter:
+    """Emits the tables as a C99 or C++11 header"""
+
+    def __init__(self, config, output, language):
+        self.config = config
+        self.output = output
+        self.cpp = language == 'cpp'
+        self.data = 'static constexpr' if self.cpp else 'static const'
+        self.function = 'static constexpr' if self.cpp else 'static inline'
+        self.lines = []
+
+    def emit(self, line=''):
+        self.lines.append(line)
+
+    def section(self, title):
+        self.emit('//=============================================================================')
+        self.emit(f'// {title}')
+        self.emit('//=============================================================================')
+        self.emit()
+
+    def render(self):
+        guard = macro_name(Path(self.output).stem) + '_H'
+        self.emit('/**')
+        self.emit(f' * @file {Path(self.output).name}')
+        self.emit(' * @brief Configuration tables generated from ARXML')
+        self.emit(f' * @details Generated by arxml_codegen.py from {", ".join(self.config.sources)}.')
+        self.emit(' *          Do not edit; change the ARXML and regenerate.')
+        self.emit(' */')
+        self.emit()
+        self.emit(f'#ifndef {guard}')
+        self.emit(f'#define {guard}')
+        self.emit()
+        self.emit('#include <stdint.h>')
+        self.emit('#include <stdbool.h>')
+        self.emit()
+        self.emit(f'#define CFG_INVALID_INDEX                0x{INVALID_INDEX:X}u')
+        self.emit()
+        self.render_tasks()
+        self.render_pdus()
+        self.render_signals()
+        self.render_dids()
+        self.render_dtcs()
+        self.emit(f'#endif // {guard}')
+        return '\n'.join(self.lines) + '\n'
+
+    def render_enum(self, type_name, prefix, names):
+        self.emit('typedef enum {')
+        for i, name in enumerate(names):
+            self.emit(f'    {prefix}{macro_name(name)} = {i},')
+        self.emit(f'    {prefix}COUNT')
+        self.emit(f'}} {type_name};')
+        self.emit()
+
+    def render_table(self, type_name, array, rows):
+        if not rows:
+            return
+        self.emit(f'{self.data} {type_name} {array}[] = {{')
+        for i, row in enumerate(rows):
+            self.emit(f'    {{{row}}}{"," if i + 1 < len(rows) else ""}')
+        self.emit('};')
+        self.emit()
+
+    def render_lookup(self, function, slots_name, key, array, count, keys):
+        """Perfect-hash lookup from key value to table index"""
+        slot_function = f'Cfg_{slots_name.title().replace("_", "")}Slot'
+        slots_array = f'CFG_{slots_name}_SLOTS'
+        if not keys:
+            self.emit(f'{self.function} uint8_t {function}(uint32_t {key}) {{')
+            self.emit(f'    return ((void){key}, CFG_INVALID_INDEX);')
+            self.emit('}')
+            self.emit()
+            return
+        h = PerfectHash(keys)
+        slots = ', '.join(str(s) for s in h.table)
+        self.emit(f'{self.data} uint8_t {slots_array}[{len(h.table)}] = {{{slots}}};')
+        self.emit()
+        self.emit(f'{self.function} uint32_t {slot_function}(uint32_t key) {{')
+        self.emit(f'    return (key * 0x{h.multiplier:08X}u) >> {h.shift};')
+        self.emit('}')
+        self.emit()
+        self.emit('/**')
+        self.emit(f' * @brief Index into {array} for a {key}, CFG_INVALID_INDEX if unknown (O(1))')
+        self.emit(' */')
+        self.emit(f'{self.function} uint8_t {function}(uint32_t {key}) {{')
+        self.emit(f'    return ({array}[{slots_array}[{slot_function}({key})]].{key} == {key}) ?')
+        self.emit(f'        {slots_array}[{slot_function}({key})] : CFG_INVALID_INDEX;')
+        self.emit('}')
+        self.emit()
+        if self.cpp:
+            for i in range(len(keys)):
+                self.emit(f'static_assert({function}({array}[{i}].{key}) == {i}, "{function}: hash collision");')
+            self.emit(f'static_assert({count} == sizeof({array}) / sizeof({array}[0]), "{array} size");')
+            self.emit()
+
+    @staticmethod
+    def flag(value):
+        return 'true' if value else 'false'
+
+    def render_tasks(self):
+        tasks = self.config.tasks
+        self.section('Operating System Tasks')
+        self.emit('/**')
+        self.emit(' * @brief Task IDs in configuration order')
+        self.emit(' */')
+        self.render_enum('CfgOsTaskId_t', 'CFG_OS_TASK_', [t['name'] for t in tasks])
+        self.emit('/**')
+        self.emit(' * @brief OS task configuration (priority: higher value = higher priority)')
+        self.emit(' */')
+        self.emit('typedef struct {')
+        self.emit('    const char* name;')
+        self.emit('    uint8_t priority;')
+        self.emit('    uint8_t activation;          // Maximum queued activations')
+        self.emit('    uint32_t stackSize;          // Stack size in bytes')
+        self.emit('    uint32_t period_ms;          // Cyclic alarm period, 0 = not alarm-driven')
+        self.emit('    bool autostart;')
+        self.emit('    bool preemptive;')
+        self.emit('    bool suspendable;            // Can be suspended for power saving')
+        self.emit('} CfgOsTask_t;')
+        self.emit()
+        rows = []
+        for t in tasks:
+            rows.append(f'"{t["name"]}", {t["priority"]}, {t["activation"]}, {t["stack"]}, {t["period_ms"]}, '
+                        f'{self.flag(t["autostart"])}, {self.flag(t["preemptive"])}, '
+                        f'{self.flag(t["suspendable"])}')
+        self.render_table('CfgOsTask_t', 'CFG_OS_TASKS', rows)
+
+    def render_pdus(self):
+        pdus = self.config.pdus
+        self.section('CAN PDUs (sorted by CAN ID)')
+        for p in pdus:
+            self.emit(f'#define CFG_CANID_{macro_name(p["name"]):<28} 0x{p["canId"]:03X}u')
+        if pdus:
+            self.emit()
+        self.render_enum('CfgPduIndex_t', 'CFG_PDU_', [p['name'] for p in pdus])
+        self.emit('/**')
+        self.emit(' * @brief CAN PDU: CanIf routing joined with the Com I-PDU timing')
+        self.emit(' */')
+        self.emit('typedef struct {')
+        self.emit('    uint32_t canId;')
+        self.emit('    uint8_t dlc;')
+        self.emit('    bool extendedId;')
+        self.emit('    bool tx;                     // true = transmitted by this ECU')
+        self.emit('    uint8_t comPduId;            // Com I-PDU ID, CFG_INVALID_INDEX if CanIf only')
+        self.emit('    uint32_t cycle_ms;           // Tx period, 0 = event-driven')
+        self.emit('    uint32_t timeout_ms;         // Rx deadline, 0 = not supervised')
+        self.emit('    uint8_t firstSignal;         // Signals of this PDU are contiguous in CFG_SIGNALS')
+        self.emit('    uint8_t signalCount;')
+        self.emit('    const char* name;')
+        self.emit('} CfgPdu_t;')
+        self.emit()
+        rows = []
+        for p in pdus:
+            com_id = p['comId'] if p['comId'] is not None else 'CFG_INVALID_INDEX'
+            rows.append(f'0x{p["canId"]:03X}u, {p["dlc"]}, {self.flag(p["extended"])}, {self.flag(p["tx"])}, '
+                        f'{com_id}, {p["period_ms"]}, {p["timeout_ms"]}, {p["firstSignal"]}, '
+                        f'{p["signalCount"]}, "{p["name"]}"')
+        self.render_table('CfgPdu_t', 'CFG_PDUS', rows)
+        self.render_lookup('Cfg_PduByCanId', 'CAN_ID', 'canId', 'CFG_PDUS', 'CFG_PDU_COUNT',
+                           [p['canId'] for p in pdus])
+
+    def render_signals(self):
+        signals = self.config.signals
+        self.section('Com Signals (grouped by PDU)')
+        self.render_enum('CfgSignalIndex_t', 'CFG_SIGNAL_', [s['name'] for s in signals])
+        self.emit('/**')
+        self.emit(' * @brief Signal placement within its PDU')
+        self.emit(' */')
+        self.emit('typedef struct {')
+        self.emit('    uint8_t pdu;                 // Index into CFG_PDUS')
+        self.emit('    uint8_t startBit;')
+        self.emit('    uint8_t length;              // Bits')
+        self.emit('    bool littleEndian;')
+        self.emit('    uint32_t initValue;')
+        self.emit('    const char* name;')
+        self.emit('} CfgSignal_t;')
+        self.emit()
+        rows = []
+        for s in signals:
+            rows.append(f'{s["pdu"]}, {s["startBit"]}, {s["length"]}, {self.flag(s["littleEndian"])}, '
+                        f'{s["init"]}, "{s["name"]}"')
+        self.render_table('CfgSignal_t', 'CFG_SIGNALS', rows)
+
+    def render_dids(self):
+        dids = self.config.dids
+        self.section('Diagnostic Data Identifiers (sorted by DID)')
+        for d in dids:
+            self.emit(f'#define CFG_DID_{macro_name(d["name"]):<30} 0x{d["id"]:04X}u')
+        if dids:
+            self.emit()
+        self.emit('/**')
+        self.emit(' * @brief DID table indices; handlers are dispatched through an array of this size')
+        self.emit(' */')
+        self.render_enum('CfgDidIndex_t', 'CFG_DID_IDX_', [d['name'] for d in dids])
+        self.emit('typedef struct {')
+        self.emit('    uint16_t did;')
+        self.emit('    uint16_t size;               // Data length in bytes')
+        self.emit('    bool readable;')
+        self.emit('    bool writable;')
+        self.emit('    const char* name;')
+        self.emit('} CfgDid_t;')
+        self.emit()
+        rows = [f'0x{d["id"]:04X}u, {d["size"]}, {self.flag(d["read"])}, {self.flag(d["write"])}, "{d["name"]}"'
+                for d in dids]
+        self.render_table('CfgDid_t', 'CFG_DIDS', rows)
+        self.render_lookup('Cfg_DidIndex', 'DID', 'did', 'CFG_DIDS', 'CFG_DID_IDX_COUNT',
+                           [d['id'] for d in dids])
+
+    def render_dtcs(self):
+        dtcs = self.config.dtcs
+        self.section('Diagnostic Trouble Codes (sorted by DTC)')
+        for d in dtcs:
+            self.emit(f'#define CFG_DTC_{macro_name(d["name"]):<30} 0x{d["code"]:06X}u')
+        if dtcs:
+            self.emit()
+        self.render_enum('CfgDtcIndex_t', 'CFG_DTC_IDX_', [d['name'] for d in dtcs])
+        self.emit('typedef struct {')
+        self.emit('    uint32_t dtc;                // 3-byte UDS DTC')
+        self.emit('    uint8_t priority;            // 1 = most important')
+        self.emit('    const char* name;')
+        self.emit('} CfgDtc_t;')
+        self.emit()
+        rows = [f'0x{d["code"]:06X}u, {d["priority"]}, "{d["name"]}"' for d in dtcs]
+        self.render_table('CfgDtc_t', 'CFG_DTCS', rows)
+        self.render_lookup('Cfg_DtcIndex', 'DTC', 'dtc', 'CFG_DTCS', 'CFG_DTC_IDX_COUNT',
+                           [d['code'] for d in dtcs])
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate constant configuration tables from ARXML')
+    parser.add_argument('inputs', nargs='+', help='ARXML files')
+    parser.add_argument('-o', '--output', required=True, help='Header to write')
+    parser.add_argument('--lang', choices=('c', 'cpp'), default='c',
+                        help='c = C99 static const tables, cpp = C++11 constexpr tables')
+    parser.add_argument('--check', action='store_true',
+                        help='Fail if the output is not up to date instead of writing it')
+    args = parser.parse_args()
+
+    config = ArxmlConfig()
+    for path in args.inputs:
+        config.load(path)
+    config.resolve()
+
+    if config.errors:
+        print(f"❌ Found {len(config.errors)} configuration errors:")
+        for i, error in enumerate(config.errors, 1):
+            print(f"{i}. {error}")
+        return 1
+
+    header = HeaderWriter(config, args.output, args.lang).render()
+    output = Path(args.output)
+
+    if args.check:
+        if not output.exists() or output.read_text(encoding='utf-8') != header:
+            print(f"❌ {output} is out of date; run arxml_codegen.py without --check")
+            return 1
+        print(f"✅ {output} is up to date")
+        return 0
+
+    output.write_text(header, encoding='utf-8')
+    print(f"✅ Generated {output}: {len(config.tasks)} tasks, {len(config.pdus)} PDUs, "
+          f"{len(config.signals)} signals, {len(config.dids)} DIDs, {len(config.dtcs)} DTCs")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -46,7 +46,22 @@ else
 fi
 
 echo ""
-echo "3. Hardware connection checklist:"
+echo "3. Reading startup journal..."
+
+# Boots, phase transitions and errors recorded by the StartupMonitor
+if [ -x "./engine_ecu" ]; then
+    ./engine_ecu --journal | tail -n 40
+    if ./engine_ecu --journal | grep -q "ERROR"; then
+        print_warning "Startup errors recorded - check the phase they occurred in"
+    else
+        print_status 0 "No startup errors recorded"
+    fi
+else
+    print_warning "engine_ecu not built. Run 'make' to read the startup journal."
+fi
+
+echo ""
+echo "4. Hardware connection checklist:"
 echo "   □ Verify 12V power supply (±10% tolerance)"
 echo "   □ Check ground connections"
 echo "   □ Confirm CAN high/low wiring"
@@ -54,7 +69,7 @@ echo "   □ Validate termination resistors (120Ω each end)"
 echo "   □ Test crystal oscillator (typically 8-16 MHz)"
 
 echo ""
-echo "4. Software verification steps:"
+echo "5. Software verification steps:"
 echo "   □ Confirm bootloader version compatibility"
 echo "   □ Verify application signature/checksum"
 echo "   □ Check memory layout (Flash/RAM sections)"
@@ -62,14 +77,14 @@ echo "   □ Validate stack size configuration"
 echo "   □ Review interrupt vector table"
 
 echo ""
-echo "5. Communication interface tests:"
+echo "6. Communication interface tests:"
 echo "   □ Monitor CAN bus activity with oscilloscope"
 echo "   □ Check for CAN error frames"
 echo "   □ Verify network management (NM) messages"
 echo "   □ Test diagnostic communication (UDS)"
 
 echo ""
-echo "6. AUTOSAR stack validation:"
+echo "7. AUTOSAR stack validation:"
 echo "   □ BSW (Basic Software) initialization sequence"
 echo "   □ RTE (Runtime Environment) startup"
 echo "   □ OS task creation and scheduling"
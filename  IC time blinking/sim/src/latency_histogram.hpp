@@ -0,0 +1,75 @@
+// HDR-style histogram with log-bucketed atomic counters.
+//
+// Each power of two is divided into kSubBuckets / 2 linear buckets, so a
+// recorded value is known to within 2 / kSubBuckets (about 6 %) across the
+// whole range while the table stays small. record() is wait-free and may be
+// called from any thread. Percentiles return the upper edge of the bucket that
+// holds them, capped at the largest value recorded.
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+class LogHistogram {
+public:
+    static constexpr unsigned kSubBits = 5;
+    static constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBits;
+    static constexpr unsigned kValueBits = 40;      // values up to 2^40 - 1 (12.7 days in us)
+
+    void record(uint64_t value) {
+        if (value >= kMaxValue) value = kMaxValue - 1;
+        buckets_[indexOf(value)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+
+        uint64_t max = max_.load(std::memory_order_relaxed);
+        while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    // Value at quantile q in [0, 1]; 0 when nothing was recorded
+    uint64_t percentile(double q) const {
+        const uint64_t total = count();
+        if (total == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(total)));
+        if (rank == 0) rank = 1;
+
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                const uint64_t upper = upperEdge(i);
+                return upper < max() ? upper : max();
+            }
+        }
+        return max();
+    }
+
+private:
+    static constexpr uint64_t kMaxValue = uint64_t{1} << kValueBits;
+    static constexpr std::size_t kBuckets = (kValueBits - kSubBits + 2) * (kSubBuckets / 2);
+
+    // Values below kSubBuckets map 1:1; above, `shift` low bits are dropped
+    // and the remaining top kSubBits bits select the bucket.
+    static std::size_t indexOf(uint64_t value) {
+        unsigned shift = 0;
+        while ((value >> shift) >= kSubBuckets) ++shift;
+        return shift * (kSubBuckets / 2) + static_cast<std::size_t>(value >> shift);
+    }
+
+    // Largest value mapping to bucket `index`
+    static uint64_t upperEdge(std::size_t index) {
+        if (index < kSubBuckets) return index;
+        const std::size_t shift = index / (kSubBuckets / 2) - 1;
+        const uint64_t mantissa = index - shift * (kSubBuckets / 2);
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+    std::atomic<uint64_t> buckets_[kBuckets]{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> max_{0};
+};
@@ -0,0 +1,47 @@
+// Lock-free single-producer/single-consumer ring of fixed-size records.
+//
+// push() never blocks and never allocates: when the ring is full the record is
+// dropped and counted, so a timed producer is not held up by a slow reader.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+template <typename T, std::size_t N>
+class LogRing {
+    static_assert(std::is_trivially_copyable<T>::value, "LogRing needs a trivially copyable record");
+    static_assert(N != 0 && (N & (N - 1)) == 0, "LogRing capacity must be a power of two");
+
+public:
+    // Producer side; false if the ring was full and the record was dropped
+    bool push(const T& record) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == N) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        slots_[head & (N - 1)] = record;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; false if the ring is empty
+    bool pop(T& record) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) return false;
+        record = slots_[tail & (N - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<std::size_t> head_{0};     // producer
+    alignas(64) std::atomic<std::size_t> tail_{0};     // consumer
+    alignas(64) std::atomic<uint64_t> dropped_{0};
+    std::array<T, N> slots_{};
+};
@@ -1,16 +1,28 @@
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <mutex>
+#include <optional>
 #include <random>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include "latency_histogram.hpp"
+#include "log_ring.hpp"
+#include "signal_cache.hpp"
+#include "sweep.hpp"
+#include "virtual_scheduler.hpp"
+
 using Clock = std::chrono::steady_clock;
 using namespace std::chrono_literals;
 
@@ -29,25 +41,26 @@ struct ExclusiveArea {
     void exit() { mtx.unlock(); }
 };
 
-// Double-buffered time cache for robust pattern
-class TimeCache {
+// Double-buffered cache of the first robust pattern: write into the inactive slot, then
+// flip the index. A reader still copying the old slot is torn if the producer writes
+// twice meanwhile, so both sides also had to enter ExclusiveArea. The robust path now
+// uses TripleBufferCache; this one is kept for the cache benchmark.
+template <typename T>
+class DoubleBufferCache {
 public:
-    TimeCache() { buffers_[0].valid = false; buffers_[1].valid = false; }
-
-    void write(const TimeValue& tv) {
-        // swap-write: write into the non-active buffer then flip index
+    void write(const T& tv) {
         int next = 1 - active_.load(std::memory_order_relaxed);
         buffers_[next] = tv;
         active_.store(next, std::memory_order_release);
     }
 
-    TimeValue readSnapshot() const {
+    T readSnapshot() const {
         int idx = active_.load(std::memory_order_acquire);
         return buffers_[idx]; // copy snapshot
     }
 
 private:
-    TimeValue buffers_[2];
+    T buffers_[2]{};
     std::atomic<int> active_{0};
 };
 
@@ -56,6 +69,24 @@ struct Stats {
     std::atomic<uint64_t> consumed{0};
     std::atomic<uint64_t> blanks{0};
     std::atomic<uint64_t> invalidTransitions{0};
+    std::atomic<uint64_t> logDropped{0};    // display trace records lost to a full log ring
+
+    LogHistogram ageUs;                     // lastUpdate stamp to render of the displayed value
+    LogHistogram producerJitterUs;          // |time between two productions - prodPeriod|
+
+    // Producer side: jitter against the previous production
+    void recordProduction(Clock::time_point now, Clock::time_point& previous, Clock::duration period) {
+        if (previous != Clock::time_point{}) {
+            auto interval = now - previous;
+            producerJitterUs.record(toUs(interval > period ? interval - period : period - interval));
+        }
+        previous = now;
+        produced++;
+    }
+
+    static uint64_t toUs(Clock::duration d) {
+        return d.count() <= 0 ? 0 : static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+    }
 };
 
 struct StressConfig {
@@ -78,25 +109,97 @@ struct SimContext {
     std::atomic<bool> stop{false};
     Stats statsNaive;   // for naive path
     Stats statsRobust;  // for robust path
+
+    bool virtualTime{false};            // discrete-event scheduler instead of threads + sleep_for
+    uint32_t seed{0};                   // 0: seed the random sources from std::random_device
+    Clock::duration runTime{12s};       // per scenario
+    bool quiet{false};                  // no display trace (sweeps)
+};
+
+// Display trace record, pushed by a consumer and formatted by the DisplayLog drainer
+struct DisplayLogRecord {
+    int64_t timeUs;         // since scenario start
+    uint32_t hhmmss;        // hour << 16 | minute << 8 | second
+    bool blank;
+};
+
+// Every n-th display frame goes to the trace
+constexpr uint64_t kDisplayLogEvery = 40;
+
+// Display trace off the timed path: consumers push fixed-size records into a
+// lock-free ring, a background thread formats and writes them
+class DisplayLog {
+public:
+    DisplayLog(const char* tag, Clock::time_point start) : tag_(tag), start_(start), drainer_([this] { drain(); }) {}
+    ~DisplayLog() { stop(); }
+
+    // Consumer side: no allocation, no I/O, never blocks
+    void log(Clock::time_point now, const TimeValue& tv, bool blank) {
+        DisplayLogRecord r;
+        r.timeUs = std::chrono::duration_cast<std::chrono::microseconds>(now - start_).count();
+        r.hhmmss = (static_cast<uint32_t>(tv.hour) << 16) | (static_cast<uint32_t>(tv.minute) << 8) |
+                   static_cast<uint32_t>(tv.second);
+        r.blank = blank;
+        ring_.push(r);
+    }
+
+    // Write what is left and stop the drainer
+    void stop() {
+        if (drainer_.joinable()) {
+            stop_.store(true);
+            drainer_.join();
+        }
+    }
+
+    uint64_t dropped() const { return ring_.dropped(); }
+
+private:
+    void drain() {
+        for (;;) {
+            bool stopping = stop_.load();   // read before the last pass so nothing pushed earlier is missed
+            DisplayLogRecord r;
+            while (ring_.pop(r)) write(r);
+            if (stopping) break;
+            std::this_thread::sleep_for(10ms);
+        }
+        std::cout.flush();
+    }
+
+    void write(const DisplayLogRecord& r) {
+        char line[64];
+        if (r.blank) {
+            std::snprintf(line, sizeof(line), "[%s] BLANK --:--:-- @ %.3f s\n", tag_, r.timeUs / 1e6);
+        } else {
+            std::snprintf(line, sizeof(line), "[%s] %02u:%02u:%02u @ %.3f s\n", tag_, (r.hhmmss >> 16) & 0xFFU,
+                          (r.hhmmss >> 8) & 0xFFU, r.hhmmss & 0xFFU, r.timeUs / 1e6);
+        }
+        std::cout << line;
+    }
+
+    const char* tag_;
+    Clock::time_point start_;
+    LogRing<DisplayLogRecord, 256> ring_;
+    std::atomic<bool> stop_{false};
+    std::thread drainer_;   // last: started once the ring is constructed
 };
 
-// Utility: format time as HH:MM:SS
-static std::string fmt(const TimeValue& tv) {
-    std::ostringstream oss;
-    oss << std::setfill('0') << std::setw(2) << tv.hour << ":"
-        << std::setw(2) << tv.minute << ":" << std::setw(2) << tv.second;
-    return oss.str();
+// Seed of one random stream of a scenario, reproducible when ctx.seed is set
+static uint32_t streamSeed(uint32_t seed, uint32_t stream) {
+    if (seed == 0) return std::random_device{}();
+    std::seed_seq seq{seed, stream};
+    uint32_t out;
+    seq.generate(&out, &out + 1);
+    return out;
 }
 
 // Simulated time source with occasional bus time sync delays (e.g., CAN signal)
 class TimeSource {
 public:
-    explicit TimeSource(const StressConfig& c) : cfg(c), rng(rd()) {}
+    TimeSource(const StressConfig& c, Clock::time_point start, uint32_t seed)
+        : cfg(c), lastTick_(start), lastSync_(start), rng(seed) {}
 
     // update logical time; sometimes mark invalid if last sync too old
-    TimeValue next() {
-        auto now = Clock::now();
-
+    TimeValue next(Clock::time_point now) {
         // advance logical seconds every producer tick
         auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - lastTick_);
         if (elapsed.count() >= 1) {
@@ -108,11 +211,12 @@ public:
             }
         }
 
-        // emulate bus sync arrival being late sometimes
+        // emulate bus sync arrival being late sometimes; a newer late frame replaces a pending one
+        deliverSync(now);
         std::uniform_real_distribution<double> dist(0.0, 1.0);
         if (dist(rng) < cfg.busDropProbability) {
-            // skip sync or make it late
-            lastSync_ = now + std::chrono::milliseconds(randRange(0, cfg.busLateMax.count()));
+            pendingSync_ = now + std::chrono::milliseconds(randRange(0, cfg.busLateMax.count()));
+            deliverSync(now);
         } else {
             lastSync_ = now; // on-time sync
         }
@@ -125,13 +229,25 @@ public:
         return tv;
     }
 
+    // Late sync still in flight, if any
+    bool syncPending() const { return pendingSync_ != Clock::time_point{}; }
+    Clock::time_point pendingSync() const { return pendingSync_; }
+
+    // Take the late sync into account once it has arrived
+    void deliverSync(Clock::time_point now) {
+        if (syncPending() && pendingSync_ <= now) {
+            lastSync_ = std::max(lastSync_, pendingSync_);
+            pendingSync_ = {};
+        }
+    }
+
 private:
     StressConfig cfg;
-    Clock::time_point lastTick_ = Clock::now();
-    Clock::time_point lastSync_ = Clock::now();
+    Clock::time_point lastTick_;
+    Clock::time_point lastSync_;
+    Clock::time_point pendingSync_{};
     int hour_{12}, minute_{0}, second_{0};
 
-    std::random_device rd;
     std::mt19937 rng;
 
     int randRange(int a, int b) { // inclusive [a, b]
@@ -140,28 +256,131 @@ private:
     }
 };
 
+// ISR-like bursts delaying the producer activation
+class IsrBurst {
+public:
+    IsrBurst(const StressConfig& c, uint32_t seed) : cfg(c), rng(seed) {}
+
+    std::chrono::milliseconds next() {
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        if (dist(rng) >= cfg.isrBusyProbability) return 0ms;
+        std::uniform_int_distribution<int> extra(0, static_cast<int>(cfg.isrBusyMax.count()));
+        return std::chrono::milliseconds(extra(rng));
+    }
+
+private:
+    StressConfig cfg;
+    std::mt19937 rng;
+};
+
 // Naive pipeline: single buffer and immediate blanking on timeout
-void runNaive(SimContext& ctx) {
+struct NaivePipeline {
+    static constexpr const char* kName = "Naive";
+
+    NaivePipeline(SimContext& c, Clock::time_point start)
+        : ctx(c), stats(c.statsNaive), src(c.cfg, start, streamSeed(c.seed, 0)), isr(c.cfg, streamSeed(c.seed, 1)) {}
+
+    void produce(Clock::time_point now) {
+        TimeValue tv = src.next(now);
+        std::lock_guard<std::mutex> lk(bufMtx); // no exclusive area boundaries beyond plain mutex
+        shared = tv;
+        stats.recordProduction(now, lastProduced, ctx.cfg.prodPeriod);
+    }
+
+    void display(Clock::time_point now) {
+        TimeValue snapshot;
+        {
+            std::lock_guard<std::mutex> lk(bufMtx);
+            snapshot = shared; // could be partially updated in real systems without protection
+        }
+
+        // naive validity check: blank immediately if timed out
+        bool blank = !snapshot.valid || ((now - snapshot.lastUpdate) > ctx.cfg.timeout);
+        if (blank) stats.blanks++;
+        else stats.ageUs.record(Stats::toUs(now - snapshot.lastUpdate));
+        stats.consumed++;
+
+        // Trace occasionally to visualize blinking
+        if (log != nullptr && stats.consumed % kDisplayLogEvery == 0) log->log(now, snapshot, blank);
+    }
+
+    SimContext& ctx;
+    Stats& stats;
+    DisplayLog* log{nullptr};
+    TimeSource src;
+    IsrBurst isr;
     std::mutex bufMtx;
     TimeValue shared{}; // single buffer shared between producer and consumer
-    TimeSource src(ctx.cfg);
+    Clock::time_point lastProduced{};
+};
+
+// Robust pipeline: lock-free triple buffer + grace before blanking
+struct RobustPipeline {
+    static constexpr const char* kName = "Robust";
+
+    RobustPipeline(SimContext& c, Clock::time_point start)
+        : ctx(c), stats(c.statsRobust), src(c.cfg, start, streamSeed(c.seed, 2)), isr(c.cfg, streamSeed(c.seed, 3)) {}
+
+    void produce(Clock::time_point now) {
+        TimeValue tv = src.next(now);
+        cache.write(tv);
+        stats.recordProduction(now, lastProduced, ctx.cfg.prodPeriod);
+    }
+
+    void display(Clock::time_point now) {
+        TimeValue snap = cache.read();
+        bool validNow = snap.valid && ((now - snap.lastUpdate) <= ctx.cfg.timeout);
+
+        if (validNow) {
+            lastGood = snap;
+            haveLastGood = true;
+            invalidSince = {};
+        } else {
+            if (invalidSince.time_since_epoch().count() == 0) {
+                invalidSince = now;
+                stats.invalidTransitions++;
+            }
+        }
+
+        bool withinGrace = invalidSince.time_since_epoch().count() != 0 &&
+                           ((now - invalidSince) <= ctx.cfg.grace);
+
+        bool blank = !haveLastGood && !validNow && !withinGrace;
+        const TimeValue& shown = haveLastGood ? lastGood : snap;
+        if (blank) stats.blanks++;
+        else stats.ageUs.record(Stats::toUs(now - shown.lastUpdate));
+        stats.consumed++;
 
+        // Occasionally trace
+        if (log != nullptr && stats.consumed % kDisplayLogEvery == 0) log->log(now, shown, blank);
+    }
+
+    SimContext& ctx;
+    Stats& stats;
+    DisplayLog* log{nullptr};
+    TimeSource src;
+    IsrBurst isr;
+    TripleBufferCache<TimeValue> cache;   // coherent snapshots without an exclusive area
+    Clock::time_point lastProduced{};
+
+    // consumer state
+    TimeValue lastGood{};
+    bool haveLastGood = false;
+    Clock::time_point invalidSince{};
+};
+
+// Wall-clock mode: producer and consumer threads pacing themselves with sleep_for
+template <typename Pipeline>
+static void runWallClock(SimContext& ctx, Pipeline& p) {
     std::thread producer([&] {
         auto period = ctx.cfg.prodPeriod;
-        std::mt19937 rng(std::random_device{}());
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
         while (!ctx.stop.load()) {
             auto start = Clock::now();
             // simulate ISR burst delaying producer
-            if (dist(rng) < ctx.cfg.isrBusyProbability) {
-                auto extra = std::chrono::milliseconds(rand() % (ctx.cfg.isrBusyMax.count()+1));
-                std::this_thread::sleep_for(extra);
-            }
+            auto extra = p.isr.next();
+            if (extra > 0ms) std::this_thread::sleep_for(extra);
 
-            TimeValue tv = src.next();
-            std::lock_guard<std::mutex> lk(bufMtx); // no exclusive area boundaries beyond plain mutex
-            shared = tv;
-            ctx.statsNaive.produced++;
+            p.produce(Clock::now());
 
             // sleep until next period boundary
             auto elapsed = Clock::now() - start;
@@ -173,133 +392,407 @@ void runNaive(SimContext& ctx) {
         auto period = ctx.cfg.dispPeriod;
         while (!ctx.stop.load()) {
             auto start = Clock::now();
-            TimeValue snapshot;
-            {
-                std::lock_guard<std::mutex> lk(bufMtx);
-                snapshot = shared; // could be partially updated in real systems without protection
-            }
-
-            // naive validity check: blank immediately if timed out
-            bool blank = !snapshot.valid || ((Clock::now() - snapshot.lastUpdate) > ctx.cfg.timeout);
-            if (blank) ctx.statsNaive.blanks++;
-            ctx.statsNaive.consumed++;
-
-            // Print occasionally to visualize blinking
-            if (ctx.statsNaive.consumed % 40 == 0) {
-                std::cout << "[Naive] " << (blank ? "BLANK --:--:--" : fmt(snapshot)) << "\n";
-            }
+            p.display(Clock::now());
 
             auto elapsed = Clock::now() - start;
             if (elapsed < period) std::this_thread::sleep_for(period - elapsed);
         }
     });
 
-    std::this_thread::sleep_for(12s);
+    std::this_thread::sleep_for(ctx.runTime);
     ctx.stop.store(true);
     producer.join();
     consumer.join();
 }
 
-// Robust pipeline: double-buffer + exclusive area + grace before blanking
-void runRobust(SimContext& ctx) {
+enum class SimEvent { ProducerRelease, IsrBurstEnd, DisplayRelease, BusSync };
+
+// Virtual-time mode: the same activations as runWallClock, ordered by VirtualScheduler.
+// Returns the number of events executed.
+template <typename Pipeline>
+static uint64_t runVirtualTime(SimContext& ctx, Pipeline& p, Clock::time_point start) {
+    VirtualScheduler<Clock, SimEvent> sched;
+    Clock::time_point release = start;   // current producer activation
+
+    auto produce = [&](Clock::time_point now) {
+        p.produce(now);
+        if (p.src.syncPending()) sched.at(p.src.pendingSync(), SimEvent::BusSync);
+        // a producer delayed past its period starts the next activation right away
+        sched.at(std::max(release + ctx.cfg.prodPeriod, now), SimEvent::ProducerRelease);
+    };
+
+    sched.at(start, SimEvent::ProducerRelease);
+    sched.at(start, SimEvent::DisplayRelease);
+
+    return sched.runUntil(start + ctx.runTime, [&](Clock::time_point now, SimEvent e) {
+        switch (e) {
+        case SimEvent::ProducerRelease: {
+            release = now;
+            auto extra = p.isr.next();
+            if (extra > 0ms) sched.at(now + extra, SimEvent::IsrBurstEnd);
+            else produce(now);
+            break;
+        }
+        case SimEvent::IsrBurstEnd:
+            produce(now);
+            break;
+        case SimEvent::DisplayRelease:
+            p.display(now);
+            sched.at(now + ctx.cfg.dispPeriod, SimEvent::DisplayRelease);
+            break;
+        case SimEvent::BusSync:
+            p.src.deliverSync(now);
+            break;
+        }
+    });
+}
+
+template <typename Pipeline>
+static void runScenario(SimContext& ctx) {
     ctx.stop.store(false);
+    // The virtual time line starts at the current time so that a zero time_point still means "unset"
+    auto start = Clock::now();
+    Pipeline p(ctx, start);
+    std::optional<DisplayLog> log;
+    if (!ctx.quiet) p.log = &log.emplace(Pipeline::kName, start);
+
+    uint64_t events = 0;
+    if (ctx.virtualTime) events = runVirtualTime(ctx, p, start);
+    else runWallClock(ctx, p);
+    auto end = Clock::now();
+
+    if (!log) return;
+    log->stop();
+    p.stats.logDropped = log->dropped();
+    if (!ctx.virtualTime) return;
+
+    auto wall = std::chrono::duration<double, std::milli>(end - start).count();
+    auto precision = std::cout.precision();
+    std::cout << "Simulated " << std::chrono::duration<double>(ctx.runTime).count() << " s in "
+              << std::fixed << std::setprecision(2) << wall << " ms (" << events << " events)"
+              << std::defaultfloat << std::setprecision(precision) << "\n";
+}
 
-    TimeCache cache;               // double-buffered cache
-    ExclusiveArea ex;              // exclusive area to protect multi-field coherency (simulated here)
-    TimeSource src(ctx.cfg);
+void runNaive(SimContext& ctx) { runScenario<NaivePipeline>(ctx); }
 
-    std::thread producer([&] {
-        auto period = ctx.cfg.prodPeriod;
-        std::mt19937 rng(std::random_device{}());
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
-        while (!ctx.stop.load()) {
-            auto start = Clock::now();
-            if (dist(rng) < ctx.cfg.isrBusyProbability) {
-                auto extra = std::chrono::milliseconds(rand() % (ctx.cfg.isrBusyMax.count()+1));
-                std::this_thread::sleep_for(extra);
-            }
+void runRobust(SimContext& ctx) { runScenario<RobustPipeline>(ctx); }
 
-            TimeValue tv = src.next();
-            ex.enter();
-            cache.write(tv);
-            ex.exit();
-            ctx.statsRobust.produced++;
+static void printLatency(const char* title, const LogHistogram& h) {
+    auto ms = [](uint64_t us) { return us / 1000.0; };
+    auto precision = std::cout.precision();
+    std::cout << title << " [ms]: " << std::fixed << std::setprecision(1)
+              << "p50 " << ms(h.percentile(0.50)) << "  p99 " << ms(h.percentile(0.99))
+              << "  p99.9 " << ms(h.percentile(0.999)) << "  max " << ms(h.max())
+              << std::defaultfloat << std::setprecision(precision) << "  (" << h.count() << " samples)\n";
+}
 
-            auto elapsed = Clock::now() - start;
-            if (elapsed < period) std::this_thread::sleep_for(period - elapsed);
-        }
-    });
+static void printStats(const char* title, const Stats& s) {
+    std::cout << "\n=== " << title << " ===\n";
+    std::cout << "Produced: " << s.produced.load() << "\n";
+    std::cout << "Consumed: " << s.consumed.load() << "\n";
+    std::cout << "Blank events: " << s.blanks.load() << "\n";
+    std::cout << "Invalid transitions: " << s.invalidTransitions.load() << "\n";
+    if (s.logDropped.load() != 0) std::cout << "Log records dropped: " << s.logDropped.load() << "\n";
+    printLatency("Age of data", s.ageUs);
+    printLatency("Producer jitter", s.producerJitterUs);
+}
 
-    std::thread consumer([&] {
-        auto period = ctx.cfg.dispPeriod;
-        TimeValue lastGood{};
-        bool haveLastGood = false;
-        Clock::time_point invalidSince{};
-        while (!ctx.stop.load()) {
-            auto start = Clock::now();
+// Cache benchmark signal: a reader sees a torn copy if the words disagree
+struct BenchSignal {
+    uint64_t words[8];
+};
+
+struct CacheBenchResult {
+    uint64_t writes{0};
+    uint64_t reads{0};
+    uint64_t torn{0};
+    uint64_t retries{0};
+};
 
-            TimeValue snap = cache.readSnapshot();
-            bool validNow = snap.valid && ((Clock::now() - snap.lastUpdate) <= ctx.cfg.timeout);
-
-            if (validNow) {
-                lastGood = snap;
-                haveLastGood = true;
-                invalidSince = {};
-            } else {
-                if (invalidSince.time_since_epoch().count() == 0) {
-                    invalidSince = Clock::now();
-                    ctx.statsRobust.invalidTransitions++;
+// One writer updating as fast as it can against `readers` readers for `duration`
+template <typename WriteFn, typename ReadFn>
+static CacheBenchResult benchCache(int readers, std::chrono::milliseconds duration, WriteFn write, ReadFn read) {
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> reads{0}, torn{0}, retries{0};
+    CacheBenchResult result;
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&] {
+            uint64_t localReads = 0, localTorn = 0;
+            uint32_t localRetries = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                BenchSignal v = read(localRetries);
+                for (uint64_t w : v.words) {
+                    if (w != v.words[0]) { ++localTorn; break; }
                 }
+                ++localReads;
             }
+            reads += localReads;
+            torn += localTorn;
+            retries += localRetries;
+        });
+    }
+
+    std::thread writer([&] {
+        BenchSignal v{};
+        uint64_t n = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            ++n;
+            for (uint64_t& w : v.words) w = n;
+            write(v);
+        }
+        result.writes = n;
+    });
 
-            bool withinGrace = invalidSince.time_since_epoch().count() != 0 &&
-                               ((Clock::now() - invalidSince) <= ctx.cfg.grace);
+    std::this_thread::sleep_for(duration);
+    stop.store(true);
+    writer.join();
+    for (auto& t : threads) t.join();
 
-            bool blank = !haveLastGood && !validNow && !withinGrace;
-            if (blank) ctx.statsRobust.blanks++;
-            ctx.statsRobust.consumed++;
+    result.reads = reads.load();
+    result.torn = torn.load();
+    result.retries = retries.load();
+    return result;
+}
 
-            // Occasionally print
-            if (ctx.statsRobust.consumed % 40 == 0) {
-                const TimeValue& toShow = (haveLastGood ? lastGood : snap);
-                std::cout << "[Robust] "
-                          << (blank ? "BLANK --:--:--" : fmt(toShow)) << "\n";
-            }
+static void printCacheBench(const char* name, int readers, std::chrono::milliseconds duration,
+                            const CacheBenchResult& r) {
+    double seconds = std::chrono::duration<double>(duration).count();
+    std::cout << std::left << std::setw(30) << name << std::right
+              << " readers " << readers
+              << "  writes/s " << std::setw(11) << static_cast<uint64_t>(r.writes / seconds)
+              << "  reads/s " << std::setw(11) << static_cast<uint64_t>(r.reads / seconds)
+              << "  torn " << r.torn
+              << "  retries " << r.retries << "\n";
+}
 
-            auto elapsed = Clock::now() - start;
-            if (elapsed < period) std::this_thread::sleep_for(period - elapsed);
+// Writer vs. readers throughput of the cache designs (64-byte signal)
+static void runCacheBenchmark(std::chrono::milliseconds duration) {
+    unsigned hw = std::thread::hardware_concurrency();
+    int manyReaders = static_cast<int>(hw > 2 ? std::min(hw - 1, 3u) : 1u);
+
+    std::cout << "Cache contention benchmark, " << duration.count() << " ms per case\n";
+    std::vector<int> readerCounts{manyReaders};
+    if (manyReaders > 1) readerCounts.push_back(1);
+
+    for (int readers : readerCounts) {
+        {
+            // Unprotected, racy on purpose: the torn reads that made the exclusive area necessary
+            DoubleBufferCache<BenchSignal> cache;
+            auto write = [&](const BenchSignal& v) { cache.write(v); };
+            auto read = [&](uint32_t&) { return cache.readSnapshot(); };
+            printCacheBench("DoubleBufferCache, no lock", readers, duration, benchCache(readers, duration, write, read));
         }
-    });
+        {
+            DoubleBufferCache<BenchSignal> cache;
+            ExclusiveArea ex;
+            auto write = [&](const BenchSignal& v) { ex.enter(); cache.write(v); ex.exit(); };
+            auto read = [&](uint32_t&) { ex.enter(); BenchSignal v = cache.readSnapshot(); ex.exit(); return v; };
+            printCacheBench("DoubleBuffer + ExclusiveArea", readers, duration, benchCache(readers, duration, write, read));
+        }
+        {
+            SeqLockCache<BenchSignal> cache;
+            auto write = [&](const BenchSignal& v) { cache.write(v); };
+            auto read = [&](uint32_t& retries) { return cache.read(retries); };
+            printCacheBench("SeqLockCache", readers, duration, benchCache(readers, duration, write, read));
+        }
+    }
 
-    std::this_thread::sleep_for(12s);
-    ctx.stop.store(true);
-    producer.join();
-    consumer.join();
+    // Single reader only
+    TripleBufferCache<BenchSignal> cache;
+    auto write = [&](const BenchSignal& v) { cache.write(v); };
+    auto read = [&](uint32_t&) { return cache.read(); };
+    printCacheBench("TripleBufferCache", 1, duration, benchCache(1, duration, write, read));
 }
 
-static void printStats(const char* title, const Stats& s) {
-    std::cout << "\n=== " << title << " ===\n";
-    std::cout << "Produced: " << s.produced.load() << "\n";
-    std::cout << "Consumed: " << s.consumed.load() << "\n";
-    std::cout << "Blank events: " << s.blanks.load() << "\n";
-    std::cout << "Invalid transitions: " << s.invalidTransitions.load() << "\n";
+// Sweep axes and the StressConfig field each one sets (durations in ms)
+static bool applySweepValue(StressConfig& cfg, const std::string& name, double value) {
+    auto ms = std::chrono::milliseconds(std::llround(value));
+    if (name == "timeout")       cfg.timeout = ms;
+    else if (name == "grace")    cfg.grace = ms;
+    else if (name == "prod")     cfg.prodPeriod = ms;
+    else if (name == "disp")     cfg.dispPeriod = ms;
+    else if (name == "isr_prob") cfg.isrBusyProbability = value;
+    else if (name == "isr_max")  cfg.isrBusyMax = ms;
+    else if (name == "bus_prob") cfg.busDropProbability = value;
+    else if (name == "bus_late") cfg.busLateMax = ms;
+    else return false;
+    return true;
+}
+
+struct SweepResult {
+    StressConfig cfg;
+    uint32_t seed{0};
+    uint64_t consumed{0};
+    uint64_t naiveBlanks{0};
+    uint64_t naiveInvalid{0};
+    uint64_t robustBlanks{0};
+    uint64_t robustInvalid{0};
+    uint64_t robustAgeP99Us{0};
+    uint64_t robustAgeMaxUs{0};
+};
+
+struct SweepOptions {
+    std::vector<SweepAxis> axes;
+    std::size_t samples{0};             // 0: full grid
+    unsigned jobs{0};                   // 0: one per hardware thread
+    bool json{false};
+    std::string outPath;                // empty: stdout
+};
+
+static void writeSweepTable(std::ostream& out, const std::vector<SweepResult>& results, bool json) {
+    const char* columns[] = {"config", "seed", "prod_ms", "disp_ms", "timeout_ms", "grace_ms", "isr_prob",
+                             "isr_max_ms", "bus_prob", "bus_late_ms", "consumed", "naive_blanks",
+                             "naive_invalid", "robust_blanks", "robust_invalid", "robust_age_p99_ms",
+                             "robust_age_max_ms"};
+    if (json) out << "[\n";
+    else {
+        for (std::size_t c = 0; c < std::size(columns); ++c) out << (c ? "," : "") << columns[c];
+        out << "\n";
+    }
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const SweepResult& r = results[i];
+        const double values[] = {static_cast<double>(i), static_cast<double>(r.seed),
+                                 static_cast<double>(r.cfg.prodPeriod.count()),
+                                 static_cast<double>(r.cfg.dispPeriod.count()),
+                                 static_cast<double>(r.cfg.timeout.count()),
+                                 static_cast<double>(r.cfg.grace.count()), r.cfg.isrBusyProbability,
+                                 static_cast<double>(r.cfg.isrBusyMax.count()), r.cfg.busDropProbability,
+                                 static_cast<double>(r.cfg.busLateMax.count()), static_cast<double>(r.consumed),
+                                 static_cast<double>(r.naiveBlanks), static_cast<double>(r.naiveInvalid),
+                                 static_cast<double>(r.robustBlanks), static_cast<double>(r.robustInvalid),
+                                 r.robustAgeP99Us / 1000.0, r.robustAgeMaxUs / 1000.0};
+        if (json) out << "  {";
+        for (std::size_t c = 0; c < std::size(columns); ++c) {
+            if (c) out << ",";
+            if (json) out << "\"" << columns[c] << "\":";
+            out << std::setprecision(12) << values[c];
+        }
+        out << (json ? (i + 1 < results.size() ? "},\n" : "}\n") : "\n");
+    }
+    if (json) out << "]\n";
+}
+
+// Run both pipelines in virtual time for every sweep point, in parallel.
+// Each configuration gets a seed derived from the base seed and its index,
+// so the table does not depend on the number of threads.
+static int runSweep(const SimContext& base, const SweepOptions& opt) {
+    uint32_t baseSeed = base.seed != 0 ? base.seed : std::random_device{}();
+    auto points = opt.samples != 0 ? sweepSample(opt.axes, opt.samples, baseSeed) : sweepGrid(opt.axes);
+    unsigned jobs = opt.jobs != 0 ? opt.jobs : std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<SweepResult> results(points.size());
+    auto start = Clock::now();
+
+    parallelFor(points.size(), jobs, [&](std::size_t i) {
+        SimContext ctx;
+        ctx.cfg = base.cfg;
+        for (std::size_t a = 0; a < opt.axes.size(); ++a) applySweepValue(ctx.cfg, opt.axes[a].name, points[i][a]);
+        ctx.virtualTime = true;
+        ctx.quiet = true;
+        ctx.runTime = base.runTime;
+        ctx.seed = streamSeed(baseSeed, static_cast<uint32_t>(i) + 1U);
+        if (ctx.seed == 0) ctx.seed = 1;   // 0 would mean "seed from std::random_device"
+
+        runNaive(ctx);
+        runRobust(ctx);
+
+        SweepResult& r = results[i];
+        r.cfg = ctx.cfg;
+        r.seed = ctx.seed;
+        r.consumed = ctx.statsRobust.consumed.load();
+        r.naiveBlanks = ctx.statsNaive.blanks.load();
+        r.naiveInvalid = ctx.statsNaive.invalidTransitions.load();
+        r.robustBlanks = ctx.statsRobust.blanks.load();
+        r.robustInvalid = ctx.statsRobust.invalidTransitions.load();
+        r.robustAgeP99Us = ctx.statsRobust.ageUs.percentile(0.99);
+        r.robustAgeMaxUs = ctx.statsRobust.ageUs.max();
+    });
+
+    auto wall = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cerr << "Swept " << points.size() << " configurations (" << (opt.samples != 0 ? "sampled" : "grid")
+              << ", base seed " << baseSeed << ") on " << jobs << " threads in " << std::fixed
+              << std::setprecision(3) << wall << " s" << std::defaultfloat << "\n";
+
+    if (opt.outPath.empty()) {
+        writeSweepTable(std::cout, results, opt.json);
+        return 0;
+    }
+    std::ofstream out(opt.outPath);
+    if (!out) {
+        std::cerr << "Cannot create " << opt.outPath << "\n";
+        return 2;
+    }
+    writeSweepTable(out, results, opt.json);
+    return 0;
 }
 
 int main(int argc, char** argv) {
     SimContext ctx;
-    (void)argc; (void)argv; // suppress unused warnings
+
+    // --bench-cache [ms]: compare the signal caches instead of running the scenarios
+    if (argc >= 2 && std::string(argv[1]) == "--bench-cache") {
+        runCacheBenchmark(std::chrono::milliseconds(argc >= 3 ? std::atoi(argv[2]) : 1000));
+        return 0;
+    }
+
+    // --virtual: discrete-event virtual time, --seed N: reproducible random sources
+    // --sweep name=spec ...: run a parameter sweep (virtual time) instead of the two scenarios
+    SweepOptions sweep;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--virtual") {
+            ctx.virtualTime = true;
+        } else if (arg == "--seed" && hasValue) {
+            ctx.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        } else if (arg == "--sweep" && hasValue) {
+            SweepAxis axis;
+            std::string error;
+            StressConfig probe;
+            if (!parseSweepAxis(argv[++i], axis, error)) {
+                std::cerr << error << "\n";
+                return 2;
+            }
+            if (!applySweepValue(probe, axis.name, 0.0)) {
+                std::cerr << "Unknown sweep axis '" << axis.name
+                          << "' (timeout, grace, prod, disp, isr_prob, isr_max, bus_prob, bus_late)\n";
+                return 2;
+            }
+            sweep.axes.push_back(axis);
+        } else if (arg == "--samples" && hasValue) {
+            sweep.samples = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 0));
+        } else if (arg == "--jobs" && hasValue) {
+            sweep.jobs = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 0));
+        } else if (arg == "--json") {
+            sweep.json = true;
+        } else if (arg == "--out" && hasValue) {
+            sweep.outPath = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--virtual] [--seed N] | --bench-cache [ms]\n"
+                      << "       " << argv[0] << " --sweep name=start:stop:step|a,b,c ... [--samples N] [--jobs N]"
+                      << " [--seed N] [--json] [--out file]\n";
+            return 2;
+        }
+    }
 
     // Allow overriding knobs via env (quick tuning)
     if (const char* e = std::getenv("SIM_TIMEOUT_MS")) ctx.cfg.timeout = std::chrono::milliseconds(std::atoi(e));
     if (const char* e = std::getenv("SIM_GRACE_MS"))   ctx.cfg.grace = std::chrono::milliseconds(std::atoi(e));
+    if (const char* e = std::getenv("SIM_DURATION_MS")) ctx.runTime = std::chrono::milliseconds(std::atoi(e));
+
+    if (!sweep.axes.empty()) return runSweep(ctx, sweep);
 
-    std::cout << "Running NAIVE simulation (12s)..." << std::endl;
+    const char* mode = ctx.virtualTime ? " virtual" : "";
+    auto seconds = std::chrono::duration<double>(ctx.runTime).count();
+
+    std::cout << "Running NAIVE simulation (" << seconds << "s" << mode << ")..." << std::endl;
     runNaive(ctx);
     printStats("Naive", ctx.statsNaive);
 
-    // Reset stop flag and run robust
-    ctx.stop.store(false);
-    std::cout << "\nRunning ROBUST simulation (12s)..." << std::endl;
+    std::cout << "\nRunning ROBUST simulation (" << seconds << "s" << mode << ")..." << std::endl;
     runRobust(ctx);
     printStats("Robust", ctx.statsRobust);
 
@@ -0,0 +1,99 @@
+// Lock-free single-writer signal caches for trivially-copyable signal types.
+//
+// SeqLockCache: one writer, any number of readers. The writer never waits; a
+// reader retries while a write is in progress or if one completed during its
+// copy, so it always returns a coherent snapshot. The payload is kept in
+// relaxed atomic words, which keeps the concurrent copy free of data races.
+//
+// TripleBufferCache: one writer, one reader, both wait-free. The writer fills a
+// private slot and swaps it with the shared middle slot; the reader swaps its
+// slot with the middle one only when a newer value is there. No copy is ever
+// shared, so large signals cost one copy per side and nothing is retried.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+template <typename T>
+class SeqLockCache {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLockCache needs a trivially copyable signal");
+    static_assert(std::is_default_constructible<T>::value, "SeqLockCache needs a default constructible signal");
+
+public:
+    SeqLockCache() { write(T{}); }
+
+    void write(const T& value) {
+        std::array<std::uint64_t, kWords> words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        const std::uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);          // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kWords; ++i) words_[i].store(words[i], std::memory_order_relaxed);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    T read() const {
+        std::uint32_t retries = 0;
+        return read(retries);
+    }
+
+    // Same as read(), and counts the attempts that had to be repeated
+    T read(std::uint32_t& retries) const {
+        std::array<std::uint64_t, kWords> words;
+        for (;;) {
+            const std::uint32_t before = seq_.load(std::memory_order_acquire);
+            if ((before & 1U) == 0U) {
+                for (std::size_t i = 0; i < kWords; ++i) words[i] = words_[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (seq_.load(std::memory_order_relaxed) == before) break;
+            }
+            ++retries;
+        }
+
+        T value;
+        std::memcpy(&value, words.data(), sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr std::size_t kWords = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    alignas(64) std::atomic<std::uint32_t> seq_{0};
+    std::array<std::atomic<std::uint64_t>, kWords> words_{};
+};
+
+template <typename T>
+class TripleBufferCache {
+    static_assert(std::is_trivially_copyable<T>::value, "TripleBufferCache needs a trivially copyable signal");
+
+public:
+    void write(const T& value) {
+        slots_[back_].value = value;
+        const std::uint8_t old = middle_.exchange(static_cast<std::uint8_t>(back_ | kFresh), std::memory_order_acq_rel);
+        back_ = old & kIndexMask;
+    }
+
+    // Latest value written, or the previous one again if nothing new arrived
+    T read() {
+        if ((middle_.load(std::memory_order_relaxed) & kFresh) != 0U) {
+            const std::uint8_t old = middle_.exchange(front_, std::memory_order_acq_rel);
+            front_ = old & kIndexMask;
+        }
+        return slots_[front_].value;
+    }
+
+private:
+    static constexpr std::uint8_t kFresh = 0x4;
+    static constexpr std::uint8_t kIndexMask = 0x3;
+
+    struct alignas(64) Slot { T value{}; };
+
+    Slot slots_[3];
+    alignas(64) std::atomic<std::uint8_t> middle_{1};
+    alignas(64) std::uint8_t back_{0};      // writer side
+    alignas(64) std::uint8_t front_{2};     // reader side
+};
@@ -0,0 +1,120 @@
+// Parameter sweeps: axes given on the command line, expanded to a grid or
+// sampled at random, and a small pool of threads working through the points.
+//
+// Axis syntax: name=start:stop:step (inclusive range), name=a,b,c (list) or
+// name=value. A random sample draws ranges uniformly between start and stop
+// and lists by picking one of their values.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct SweepAxis {
+    std::string name;
+    std::vector<double> values;     // grid points
+    bool range{false};              // start:stop:step, sampled continuously
+};
+
+// Parse "name=spec"; returns false with a message on malformed input
+inline bool parseSweepAxis(const std::string& arg, SweepAxis& axis, std::string& error) {
+    auto eq = arg.find('=');
+    if (eq == std::string::npos || eq == 0 || eq + 1 == arg.size()) {
+        error = "expected name=spec in '" + arg + "'";
+        return false;
+    }
+    axis.name = arg.substr(0, eq);
+    axis.values.clear();
+    std::string spec = arg.substr(eq + 1);
+
+    try {
+        if (spec.find(':') != std::string::npos) {
+            std::size_t c1 = spec.find(':');
+            std::size_t c2 = spec.find(':', c1 + 1);
+            if (c2 == std::string::npos) {
+                error = "range of '" + axis.name + "' needs start:stop:step";
+                return false;
+            }
+            double start = std::stod(spec.substr(0, c1));
+            double stop = std::stod(spec.substr(c1 + 1, c2 - c1 - 1));
+            double step = std::stod(spec.substr(c2 + 1));
+            if (step <= 0.0 || stop < start) {
+                error = "range of '" + axis.name + "' needs start <= stop and step > 0";
+                return false;
+            }
+            // index-based so that rounding does not drop the last point
+            for (std::size_t i = 0; start + i * step <= stop + step * 1e-9; ++i) axis.values.push_back(start + i * step);
+            axis.range = true;
+        } else {
+            std::size_t pos = 0;
+            while (pos <= spec.size()) {
+                std::size_t comma = spec.find(',', pos);
+                if (comma == std::string::npos) comma = spec.size();
+                axis.values.push_back(std::stod(spec.substr(pos, comma - pos)));
+                pos = comma + 1;
+            }
+            axis.range = false;
+        }
+    } catch (const std::exception&) {
+        error = "malformed number in '" + arg + "'";
+        return false;
+    }
+    return true;
+}
+
+// All combinations, first axis varying slowest; one value per axis in each point
+inline std::vector<std::vector<double>> sweepGrid(const std::vector<SweepAxis>& axes) {
+    std::vector<std::vector<double>> points{{}};
+    for (const SweepAxis& axis : axes) {
+        std::vector<std::vector<double>> next;
+        next.reserve(points.size() * axis.values.size());
+        for (const auto& p : points) {
+            for (double v : axis.values) {
+                next.push_back(p);
+                next.back().push_back(v);
+            }
+        }
+        points.swap(next);
+    }
+    return points;
+}
+
+// `count` random points drawn with a generator seeded by `seed`
+inline std::vector<std::vector<double>> sweepSample(const std::vector<SweepAxis>& axes, std::size_t count,
+                                                     uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<std::vector<double>> points(count);
+    for (auto& p : points) {
+        for (const SweepAxis& axis : axes) {
+            if (axis.range) {
+                std::uniform_real_distribution<double> d(axis.values.front(), axis.values.back());
+                p.push_back(d(rng));
+            } else {
+                std::uniform_int_distribution<std::size_t> d(0, axis.values.size() - 1);
+                p.push_back(axis.values[d(rng)]);
+            }
+        }
+    }
+    return points;
+}
+
+// Run job(i) for i in [0, count) on `threads` threads, each taking the next index when done
+template <typename Job>
+void parallelFor(std::size_t count, unsigned threads, Job job) {
+    std::atomic<std::size_t> nextIndex{0};
+    auto worker = [&] {
+        for (std::size_t i = nextIndex++; i < count; i = nextIndex++) job(i);
+    };
+
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(std::max<std::size_t>(count, 1))));
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+}
@@ -0,0 +1,49 @@
+// Discrete-event scheduler on a virtual time line.
+//
+// Events are (time, kind) pairs kept in a priority queue and executed in time
+// order, first scheduled first at equal times. Time jumps straight to the next
+// event instead of sleeping, so a scenario of seconds runs in microseconds of
+// wall clock and, with seeded random sources, always plays out the same way.
+#pragma once
+
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+template <typename Clock, typename Kind>
+class VirtualScheduler {
+public:
+    using TimePoint = typename Clock::time_point;
+
+    void at(TimePoint time, Kind kind) { queue_.push(Event{time, seq_++, kind}); }
+
+    // Execute events due before `end`; handler(time, kind) may schedule more.
+    // Returns the number of events executed.
+    template <typename Handler>
+    uint64_t runUntil(TimePoint end, Handler&& handler) {
+        uint64_t executed = 0;
+        while (!queue_.empty() && queue_.top().time < end) {
+            const Event e = queue_.top();
+            queue_.pop();
+            handler(e.time, e.kind);
+            ++executed;
+        }
+        return executed;
+    }
+
+private:
+    struct Event {
+        TimePoint time;
+        uint64_t seq;
+        Kind kind;
+    };
+
+    struct Later {
+        bool operator()(const Event& a, const Event& b) const {
+            return a.time != b.time ? a.time > b.time : a.seq > b.seq;
+        }
+    };
+
+    std::priority_queue<Event, std::vector<Event>, Later> queue_;
+    uint64_t seq_{0};
+};
@@ -75,6 +75,67 @@ typedef struct {
     ABS_SystemState_t systemState;
 } ABS_VehicleData_t;
 
+/* Maximum number of vehicles evaluated per batch context.
+ * Target builds run a batch of one; host fleet replay builds override this
+ * (e.g. -DABS_BATCH_MAX_VEHICLES=256U). */
+#ifndef ABS_BATCH_MAX_VEHICLES
+#define ABS_BATCH_MAX_VEHICLES          1U
+#endif
+
+/* Maximum length of the optional sliding-window reference speed median
+ * (in detection cycles). A window of 1 uses the current cycle only. */
+#ifndef ABS_REFERENCE_WINDOW_MAX
+#define ABS_REFERENCE_WINDOW_MAX        5U
+#endif
+
+/* Four-wheel check kernel selection: SSE2 or AArch64 NEON is used when the compiler
+ * targets it; define ABS_KERNEL_SCALAR to force the portable scalar kernel. */
+
+/* ABS Batch Detection Context
+ * Structure-of-arrays storage: every per-wheel quantity is kept in its own
+ * array indexed [vehicle][wheel], so the checks run over contiguous memory
+ * and the four wheels of one vehicle are adjacent. */
+typedef struct {
+    /* Detection inputs */
+    float32 wheelSpeed[ABS_BATCH_MAX_VEHICLES][WHEEL_MAX];
+    float32 accelerationX[ABS_BATCH_MAX_VEHICLES][WHEEL_MAX];
+    float32 correctionFactor[ABS_BATCH_MAX_VEHICLES][WHEEL_MAX];
+    boolean speedValid[ABS_BATCH_MAX_VEHICLES][WHEEL_MAX];
+    boolean brakePedalPressed[ABS_BATCH_MAX_VEHICLES];
+
+    /* Reference speed (median of valid wheels), cached until the next data update */
+    float32 referenceSpeed[ABS_BATCH_MAX_VEHICLES];
+    boolean referenceValid[ABS_BATCH_MAX_VEHICLES];
+
+    /* Sliding-window history of per-cycle medians */
+    float32 referenceHistory[ABS_BATCH_MAX_VEHICLES][ABS_REFERENCE_WINDOW_MAX];
+    uint8 referenceHistoryIdx[ABS_BATCH_MAX_VEHICLES];
+    uint8 referenceHistoryCount[ABS_BATCH_MAX_VEHICLES];
+    uint8 referenceWindowSize;
+
+    /* Debounce state */
+    uint16 debounceCounter[ABS_BATCH_MAX_VEHICLES][WHEEL_MAX];
+    uint8 consecutiveErrorCount[ABS_BATCH_MAX_VEHICLES][WHEEL_MAX];
+
+    /* Detection results */
+    ABS_MalfunctionStatus_t malfunctionStatus[ABS_BATCH_MAX_VEHICLES][WHEEL_MAX];
+
+    /* Status change sequence, incremented (wrapping) whenever the confirmed state or
+     * confirmed malfunction type of a wheel changes; written by the ABS task only */
+    volatile uint8 statusChangeCounter[ABS_BATCH_MAX_VEHICLES][WHEEL_MAX];
+
+    /* Clear request sequence, incremented (wrapping) by ABS_Batch_ClearMalfunctionStatus()
+     * from the diagnostic task; the ABS task applies the clear in its next cycle and keeps
+     * the last applied sequence in clearApplied. One writer per array. */
+    volatile uint8 clearRequest[ABS_BATCH_MAX_VEHICLES][WHEEL_MAX];
+    uint8 clearApplied[ABS_BATCH_MAX_VEHICLES][WHEEL_MAX];
+    ABS_SystemState_t systemState[ABS_BATCH_MAX_VEHICLES];
+
+    ABS_DetectionParameters_t params;
+    uint16 vehicleCount;
+    boolean initialized;
+} ABS_BatchContext_t;
+
 /* Function prototypes */
 
 /**
@@ -118,10 +179,18 @@ Std_ReturnType ABS_ValidateSpeedPlausibility(WheelPosition_t wheelPos, boolean*
 Std_ReturnType ABS_GetMalfunctionStatus(WheelPosition_t wheelPos, ABS_MalfunctionStatus_t* status);
 
 /**
- * @brief Clear malfunction status
+ * @brief Request a clear of the malfunction status, applied by the next detection cycle
  */
 Std_ReturnType ABS_ClearMalfunctionStatus(WheelPosition_t wheelPos);
 
+/**
+ * @brief Get wheels whose confirmed malfunction status changed since lastSeen
+ *
+ * lastSeen is owned by the caller and updated in place; bit n of changedMask
+ * is set for wheel n. Consumers initialize lastSeen to zero.
+ */
+Std_ReturnType ABS_GetMalfunctionStatusChanges(uint8 lastSeen[WHEEL_MAX], uint8* changedMask);
+
 /**
  * @brief Set detection parameters
  */
@@ -137,6 +206,66 @@ Std_ReturnType ABS_GetDetectionParameters(ABS_DetectionParameters_t* params);
  */
 Std_ReturnType ABS_CheckSystemHealth(boolean* systemHealthy, ABS_SystemState_t* systemState);
 
+/* Batch (multi-vehicle) detection interface */
+
+/**
+ * @brief Initialize a batch context for vehicleCount vehicles
+ */
+Std_ReturnType ABS_Batch_Init(ABS_BatchContext_t* ctx, uint16 vehicleCount);
+
+/**
+ * @brief Run one detection cycle for all vehicles in the batch
+ */
+Std_ReturnType ABS_Batch_MainFunction(ABS_BatchContext_t* ctx);
+
+/**
+ * @brief Load vehicle data for one vehicle of the batch
+ */
+Std_ReturnType ABS_Batch_UpdateVehicleData(ABS_BatchContext_t* ctx, uint16 vehicleIdx,
+                                           const ABS_VehicleData_t* vehicleData);
+
+/**
+ * @brief Load the active speed sensor calibration for one wheel of one vehicle
+ */
+Std_ReturnType ABS_Batch_UpdateCalibration(ABS_BatchContext_t* ctx, uint16 vehicleIdx,
+                                           WheelPosition_t wheelPos,
+                                           const SpeedSensorCalibration_t* calibration);
+
+/**
+ * @brief Get malfunction status for one wheel of one vehicle
+ */
+Std_ReturnType ABS_Batch_GetMalfunctionStatus(const ABS_BatchContext_t* ctx, uint16 vehicleIdx,
+                                              WheelPosition_t wheelPos, ABS_MalfunctionStatus_t* status);
+
+/**
+ * @brief Request a clear of the malfunction status of one wheel of one vehicle
+ * @details The status is cleared, and a change published, by the next ABS_Batch_MainFunction()
+ */
+Std_ReturnType ABS_Batch_ClearMalfunctionStatus(ABS_BatchContext_t* ctx, uint16 vehicleIdx,
+                                                WheelPosition_t wheelPos);
+
+/**
+ * @brief Get wheels of one vehicle whose confirmed malfunction status changed since lastSeen
+ */
+Std_ReturnType ABS_Batch_GetMalfunctionStatusChanges(const ABS_BatchContext_t* ctx, uint16 vehicleIdx,
+                                                     uint8 lastSeen[WHEEL_MAX], uint8* changedMask);
+
+/**
+ * @brief Get system state of one vehicle
+ */
+Std_ReturnType ABS_Batch_GetSystemState(const ABS_BatchContext_t* ctx, uint16 vehicleIdx,
+                                        ABS_SystemState_t* systemState);
+
+/**
+ * @brief Set detection parameters shared by all vehicles of the batch
+ */
+Std_ReturnType ABS_Batch_SetDetectionParameters(ABS_BatchContext_t* ctx, const ABS_DetectionParameters_t* params);
+
+/**
+ * @brief Set the reference speed median window (1..ABS_REFERENCE_WINDOW_MAX cycles)
+ */
+Std_ReturnType ABS_Batch_SetReferenceWindow(ABS_BatchContext_t* ctx, uint8 windowSize);
+
 /* RTE Interface Functions */
 void RE_ABS_MalfunctionDetection_MainCyclic(void);
 void RE_ABS_MalfunctionDetection_SpeedPlausibility(void);
@@ -74,6 +74,13 @@ typedef struct {
     float32 accuracy;
 } CalibrationHistoryEntry_t;
 
+/* Calibration history cursor (oldest entry first; restart after new entries are added) */
+typedef struct {
+    WheelPosition_t wheelPosition;
+    uint8 position;                  /* Entries already returned */
+    uint32 timestampTicks;           /* Timestamp of the last returned entry */
+} CalibrationHistoryCursor_t;
+
 /* Calibration manager configuration */
 typedef struct {
     uint16 maxCalibrationSamples;
@@ -84,8 +91,12 @@ typedef struct {
     uint16 calibrationTimeoutMs;
     boolean enableAutoCalibration;
     uint16 autoCalibrationIntervalHours;
+    uint16 nvmWriteBudgetBytes;      /* NVM bytes written per NvmManager cycle */
 } CalibrationConfig_t;
 
+/* NVM write completion callback */
+typedef void (*CalibrationManager_NvmWriteCallback_t)(WheelPosition_t wheelPos, Std_ReturnType result);
+
 /* Function prototypes */
 
 /**
@@ -108,6 +119,16 @@ Std_ReturnType CalibrationManager_MainFunction(void);
  */
 Std_ReturnType CalibrationManager_StartCalibration(const CalibrationRequest_t* request);
 
+/**
+ * @brief Start calibration of all wheels against one shared reference (wheelPosition is ignored)
+ */
+Std_ReturnType CalibrationManager_StartCalibrationAll(const CalibrationRequest_t* request);
+
+/**
+ * @brief Update the shared reference speed (GPS or dyno) used by calibrate-all sessions
+ */
+Std_ReturnType CalibrationManager_SetReferenceSpeed(float32 referenceSpeed);
+
 /**
  * @brief Cancel ongoing calibration
  */
@@ -139,17 +160,44 @@ Std_ReturnType CalibrationManager_ResetToFactory(WheelPosition_t wheelPos);
 Std_ReturnType CalibrationManager_LoadFromNvm(WheelPosition_t wheelPos);
 
 /**
- * @brief Save calibration to NVM
+ * @brief Queue current calibration for writing to NVM (written by RE_CalibrationManager_NvmManager)
  */
 Std_ReturnType CalibrationManager_SaveToNvm(WheelPosition_t wheelPos);
 
 /**
- * @brief Get calibration history
+ * @brief Write all queued calibration blocks to NVM immediately (e.g. before shutdown)
+ */
+Std_ReturnType CalibrationManager_FlushNvm(void);
+
+/**
+ * @brief Check whether a calibration block write is still queued
  */
-Std_ReturnType CalibrationManager_GetHistory(WheelPosition_t wheelPos, CalibrationHistoryEntry_t* history, uint8* count);
+boolean CalibrationManager_IsNvmWritePending(WheelPosition_t wheelPos);
 
 /**
- * @brief Clear calibration history
+ * @brief Set callback invoked when a queued NVM write completes
+ */
+Std_ReturnType CalibrationManager_SetNvmWriteCallback(CalibrationManager_NvmWriteCallback_t callback);
+
+/**
+ * @brief Get calibration history, oldest first
+ * @details Copies at most maxEntries entries; the oldest ones if more are stored
+ */
+Std_ReturnType CalibrationManager_GetHistory(WheelPosition_t wheelPos, CalibrationHistoryEntry_t* history,
+                                             uint8 maxEntries, uint8* count);
+
+/**
+ * @brief Start iterating calibration history of a wheel
+ */
+Std_ReturnType CalibrationManager_HistoryBegin(WheelPosition_t wheelPos, CalibrationHistoryCursor_t* cursor);
+
+/**
+ * @brief Get next calibration history entry (E_NOT_OK when no entries are left)
+ */
+Std_ReturnType CalibrationManager_HistoryNext(CalibrationHistoryCursor_t* cursor, CalibrationHistoryEntry_t* entry);
+
+/**
+ * @brief Clear calibration history (the cleared history block is queued for NVM)
  */
 Std_ReturnType CalibrationManager_ClearHistory(WheelPosition_t wheelPos);
 
@@ -176,14 +224,19 @@ void RE_CalibrationManager_NvmManager(void);
 /* Client-Server Interface Functions */
 extern Std_ReturnType Rte_Call_NvmService_ReadBlock(uint16 blockId, void* dataPtr);
 extern Std_ReturnType Rte_Call_NvmService_WriteBlock(uint16 blockId, const void* dataPtr);
-extern Std_ReturnType Rte_Call_DiagnosticService_SetDTC(uint16 dtcId, boolean active);
+extern Std_ReturnType Rte_Call_DiagnosticService_SetDTC(uint32 dtcId, boolean active);
 
 /* Constants */
 #define CALIBRATION_MAX_SAMPLES         1000U
 #define CALIBRATION_MIN_SAMPLES         50U
 #define CALIBRATION_TIMEOUT_MS          30000U    /* 30 seconds */
-#define CALIBRATION_HISTORY_SIZE        10U
+#define CALIBRATION_HISTORY_SIZE        100U      /* Entries per wheel, kept in the history NVM block */
+#define CALIBRATION_HISTORY_TICK_MS     1000U     /* History timestamp resolution */
+#define CALIBRATION_FIT_MIN_SPREAD_KMH  2.0f      /* Speed spread needed to fit an offset */
 #define CALIBRATION_NVM_BLOCK_SIZE      64U
+/* History block: 8-byte packed records, then two uint32 timestamps and one uint32-sized head/count word */
+#define CALIBRATION_HISTORY_NVM_BLOCK_SIZE ((CALIBRATION_HISTORY_SIZE * 8U) + (3U * sizeof(uint32)))
+#define CALIBRATION_NVM_WRITE_BUDGET    64U       /* Bytes per NvmManager cycle (one block) */
 #define CALIBRATION_AUTO_INTERVAL_MS    3600000U  /* 1 hour */
 
 /* NVM Block IDs for calibration data */
@@ -192,6 +245,12 @@ extern Std_ReturnType Rte_Call_DiagnosticService_SetDTC(uint16 dtcId, boolean ac
 #define NVM_BLOCK_CALIBRATION_RL        0x1003U
 #define NVM_BLOCK_CALIBRATION_RR        0x1004U
 
+/* NVM Block IDs for calibration history (CALIBRATION_HISTORY_NVM_BLOCK_SIZE bytes each) */
+#define NVM_BLOCK_CALIBRATION_HISTORY_FL 0x1011U
+#define NVM_BLOCK_CALIBRATION_HISTORY_FR 0x1012U
+#define NVM_BLOCK_CALIBRATION_HISTORY_RL 0x1013U
+#define NVM_BLOCK_CALIBRATION_HISTORY_RR 0x1014U
+
 /* DTC codes for calibration issues */
 #define DTC_CALIBRATION_FAILED          0xC14187U
 #define DTC_CALIBRATION_OUT_OF_RANGE    0xC14287U
@@ -11,6 +11,7 @@
 #include "SpeedSensor_Types.h"
 #include "ABS_MalfunctionDetection.h"
 #include "CalibrationManager.h"
+#include "IsoTp.h"
 
 /* UDS Service IDs */
 #define UDS_SID_DIAGNOSTIC_SESSION_CONTROL      0x10U
@@ -21,6 +22,7 @@
 #define UDS_SID_WRITE_DATA_BY_IDENTIFIER        0x2EU
 #define UDS_SID_IO_CONTROL_BY_IDENTIFIER        0x2FU
 #define UDS_SID_ROUTINE_CONTROL                 0x31U
+#define UDS_SID_TESTER_PRESENT                  0x3EU
 
 /* UDS Response Codes */
 #define UDS_NRC_POSITIVE_RESPONSE               0x00U
@@ -28,10 +30,12 @@
 #define UDS_NRC_SERVICE_NOT_SUPPORTED           0x11U
 #define UDS_NRC_SUBFUNCTION_NOT_SUPPORTED       0x12U
 #define UDS_NRC_INCORRECT_MESSAGE_LENGTH        0x13U
+#define UDS_NRC_RESPONSE_TOO_LONG               0x14U
 #define UDS_NRC_CONDITIONS_NOT_CORRECT          0x22U
 #define UDS_NRC_REQUEST_OUT_OF_RANGE            0x31U
 #define UDS_NRC_SECURITY_ACCESS_DENIED          0x33U
 #define UDS_NRC_REQUEST_SEQUENCE_ERROR          0x24U
+#define UDS_NRC_SERVICE_NOT_SUPPORTED_IN_SESSION 0x7FU
 
 /* Diagnostic Session Types */
 typedef enum {
@@ -41,6 +45,18 @@ typedef enum {
     DIAG_SESSION_SAFETY_SYSTEM = 0x04
 } DiagSession_t;
 
+/* Session mask bit for a diagnostic session (service table access masks) */
+#define DIAG_SESSION_MASK(session)              ((uint8)(1U << (uint8)(session)))
+#define DIAG_SESSION_MASK_ALL                   (DIAG_SESSION_MASK(DIAG_SESSION_DEFAULT) | \
+                                                 DIAG_SESSION_MASK(DIAG_SESSION_PROGRAMMING) | \
+                                                 DIAG_SESSION_MASK(DIAG_SESSION_EXTENDED) | \
+                                                 DIAG_SESSION_MASK(DIAG_SESSION_SAFETY_SYSTEM))
+
+/* Security levels (service table access masks), at least one must be unlocked */
+#define DIAG_SECURITY_NONE                      0x00U
+#define DIAG_SECURITY_LEVEL_1                   0x01U
+#define DIAG_SECURITY_LEVEL_2                   0x02U
+
 /* DTC Status Byte */
 typedef struct {
     uint8 testFailed : 1;
@@ -77,13 +93,22 @@ typedef struct {
 #define DID_CALIBRATION_RR_PARAMS               0xF113U
 #define DID_ABS_SYSTEM_STATUS                   0xF120U
 #define DID_MALFUNCTION_COUNTER                 0xF121U
+/* 0xF130-0xF133: runnable timing (RunnableTiming.h, with -DRUNNABLE_TIMING) */
 #define DID_DIAGNOSTIC_SESSION_INFO             0xF1F0U
 
+/* DID payload sizes (fixed, big-endian encoding) */
+#define DID_SPEED_SENSOR_DATA_LENGTH            8U   /* speed, raw speed [0.01 km/h], accel [0.01 m/s2], valid, quality */
+#define DID_CALIBRATION_PARAMS_LENGTH           9U   /* factor [1e-4], offset [0.01 km/h], pulses/rev, circumference [mm], valid */
+#define DID_ABS_SYSTEM_STATUS_LENGTH            4U   /* system state, healthy, active wheel mask, confirmed wheel mask */
+#define DID_MALFUNCTION_COUNTER_LENGTH          8U   /* occurrence count per wheel (FL, FR, RL, RR) */
+#define DID_DIAGNOSTIC_SESSION_INFO_LENGTH      1U   /* active session */
+
 /* Routine Control Identifiers */
 #define RID_START_CALIBRATION_FL                0x0201U
 #define RID_START_CALIBRATION_FR                0x0202U
 #define RID_START_CALIBRATION_RL                0x0203U
 #define RID_START_CALIBRATION_RR                0x0204U
+#define RID_START_CALIBRATION_ALL               0x0205U
 #define RID_VALIDATE_CALIBRATION                0x0210U
 #define RID_RESET_CALIBRATION_ALL               0x0220U
 #define RID_ABS_SELF_TEST                       0x0230U
@@ -135,6 +160,15 @@ Std_ReturnType DiagnosticService_MainFunction(void);
  */
 Std_ReturnType DiagnosticService_ProcessUDSRequest(const UDSMessage_t* request, UDSMessage_t* response);
 
+/**
+ * @brief Process UDS request received by the transport and prepare a streaming response
+ *
+ * Large DTC reports (0x19 0x02 / 0x0A) are serialized on demand while the
+ * transport sends consecutive frames; other services are handled through
+ * DiagnosticService_ProcessUDSRequest into a small response buffer.
+ */
+Std_ReturnType DiagnosticService_ProcessUDSStream(const UDSMessage_t* request, IsoTp_TxStream_t* stream);
+
 /**
  * @brief Set DTC status
  */
@@ -169,13 +203,16 @@ Std_ReturnType UDS_ReadDataByIdentifier(const UDSMessage_t* request, UDSMessage_
 Std_ReturnType UDS_WriteDataByIdentifier(const UDSMessage_t* request, UDSMessage_t* response);
 Std_ReturnType UDS_InputOutputControlByIdentifier(const UDSMessage_t* request, UDSMessage_t* response);
 Std_ReturnType UDS_RoutineControl(const UDSMessage_t* request, UDSMessage_t* response);
+Std_ReturnType UDS_TesterPresent(const UDSMessage_t* request, UDSMessage_t* response);
 
 /* DID Read/Write Functions */
 Std_ReturnType DID_ReadSpeedSensorData(uint16 did, uint8* data, uint16* length);
 Std_ReturnType DID_ReadCalibrationParams(uint16 did, uint8* data, uint16* length);
 Std_ReturnType DID_WriteCalibrationParams(uint16 did, const uint8* data, uint16 length);
-Std_ReturnType DID_ReadABSSystemStatus(uint8* data, uint16* length);
-Std_ReturnType DID_ReadMalfunctionCounter(uint8* data, uint16* length);
+Std_ReturnType DID_ReadABSSystemStatus(uint16 did, uint8* data, uint16* length);
+Std_ReturnType DID_ReadMalfunctionCounter(uint16 did, uint8* data, uint16* length);
+Std_ReturnType DID_ReadDiagnosticSessionInfo(uint16 did, uint8* data, uint16* length);
+Std_ReturnType DID_ReadRunnableTiming(uint16 did, uint8* data, uint16* length);
 
 /* Routine Control Functions */
 Std_ReturnType RID_StartCalibration(uint16 rid, const uint8* data, uint16 length, uint8* response, uint16* responseLength);
@@ -195,9 +232,29 @@ extern Std_ReturnType Rte_Read_DiagnosticSession_session(DiagSession_t* session)
 extern Std_ReturnType Rte_Write_DiagnosticSession_session(const DiagSession_t* session);
 
 /* Constants */
-#define DIAG_MAX_DTC_COUNT                      32U
 #define DIAG_MAX_REQUEST_LENGTH                 4095U
 #define DIAG_MAX_RESPONSE_LENGTH                4095U
 #define DIAG_SESSION_TIMEOUT_MS                 5000U
 
+/* Maximum number of identifiers accepted in one 0x22 request */
+#ifndef DIAG_MAX_DIDS_PER_REQUEST
+#define DIAG_MAX_DIDS_PER_REQUEST               16U
+#endif
+
+/* Response buffer for services answered through the transport in one piece */
+#ifndef DIAG_STREAM_FLAT_LENGTH
+#define DIAG_STREAM_FLAT_LENGTH                 256U
+#endif
+
+/* DTC store sizing, fixed at build time. Lookup uses an open-addressing hash
+ * of 2^DIAG_DTC_HASH_BITS entries, which must be at least twice
+ * DIAG_MAX_DTC_COUNT to keep probe sequences short. */
+#ifndef DIAG_MAX_DTC_COUNT
+#define DIAG_MAX_DTC_COUNT                      32U
+#endif
+#ifndef DIAG_DTC_HASH_BITS
+#define DIAG_DTC_HASH_BITS                      6U
+#endif
+#define DIAG_DTC_HASH_SIZE                      (1U << DIAG_DTC_HASH_BITS)
+
 #endif /* DIAGNOSTICSERVICE_H */
\ No newline at end of file
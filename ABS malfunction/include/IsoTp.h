@@ -0,0 +1,107 @@
+/**
+ * @file IsoTp.h
+ * @brief ISO-TP (ISO 15765-2) Transport Layer for UDS Diagnostics
+ * @author Generated for ABS Malfunction Detection System
+ */
+
+#ifndef ISOTP_H
+#define ISOTP_H
+
+#include "Std_Types.h"
+
+/* CAN frame layout */
+#define ISOTP_FRAME_LENGTH                      8U
+#define ISOTP_SF_MAX_PAYLOAD                    7U
+#define ISOTP_FF_PAYLOAD                        6U
+#define ISOTP_CF_PAYLOAD                        7U
+#define ISOTP_MAX_MESSAGE_LENGTH                4095U
+#define ISOTP_PADDING_BYTE                      0xCCU
+
+/* Protocol Control Information (high nibble of byte 0) */
+#define ISOTP_PCI_SINGLE_FRAME                  0x00U
+#define ISOTP_PCI_FIRST_FRAME                   0x10U
+#define ISOTP_PCI_CONSECUTIVE_FRAME             0x20U
+#define ISOTP_PCI_FLOW_CONTROL                  0x30U
+
+/* Flow control status */
+#define ISOTP_FC_CONTINUE_TO_SEND               0x00U
+#define ISOTP_FC_WAIT                           0x01U
+#define ISOTP_FC_OVERFLOW                       0x02U
+
+/* Configuration */
+#ifndef ISOTP_RX_RING_FRAMES
+#define ISOTP_RX_RING_FRAMES                    16U      /* Power of two */
+#endif
+#ifndef ISOTP_RX_BUFFER_LENGTH
+#define ISOTP_RX_BUFFER_LENGTH                  ISOTP_MAX_MESSAGE_LENGTH
+#endif
+#define ISOTP_MAIN_CYCLE_MS                     1U
+#ifndef ISOTP_RX_BLOCK_SIZE
+#define ISOTP_RX_BLOCK_SIZE                     0U       /* BS sent in our flow control */
+#endif
+#define ISOTP_RX_ST_MIN                         0U       /* STmin sent in our flow control */
+#define ISOTP_MAX_FRAMES_PER_CYCLE              8U
+#define ISOTP_N_BS_TIMEOUT_MS                   1000U    /* Wait for flow control */
+#define ISOTP_N_CR_TIMEOUT_MS                   1000U    /* Wait for consecutive frame */
+
+typedef struct IsoTp_TxStream_s IsoTp_TxStream_t;
+
+/**
+ * @brief Response source callback
+ *
+ * Writes the next bytes of the response (at most maxLength) directly into
+ * dest, which is the payload area of the CAN frame being transmitted, and
+ * returns the number of bytes written.
+ */
+typedef uint16 (*IsoTp_StreamFill_t)(IsoTp_TxStream_t* stream, uint8* dest, uint16 maxLength);
+
+/* Streaming response: the transport pulls data from the source as frames are sent */
+struct IsoTp_TxStream_s {
+    IsoTp_StreamFill_t fill;
+    uint16 totalLength;         /* Announced in SF/FF, fixed when the response starts */
+    uint16 position;            /* Bytes handed to the transport so far */
+    const uint8* flatData;      /* Source data for pre-serialized responses */
+};
+
+/* Transport statistics */
+typedef struct {
+    uint32 rxFramesDropped;     /* Rx ring overflow */
+    uint32 rxAborted;           /* Sequence error or N_Cr timeout */
+    uint32 txAborted;           /* Overflow FC or N_Bs timeout */
+    uint32 responsesSent;
+} IsoTp_Statistics_t;
+
+/**
+ * @brief Initialize ISO-TP transport
+ */
+Std_ReturnType IsoTp_Init(void);
+
+/**
+ * @brief CAN receive indication (called from CAN driver, may run in ISR context)
+ */
+void IsoTp_RxIndication(const uint8* data, uint8 length);
+
+/**
+ * @brief Cyclic processing: reassemble requests, dispatch them and stream responses
+ */
+void IsoTp_MainFunction(void);
+
+/**
+ * @brief Check whether a reception or transmission is in progress
+ */
+boolean IsoTp_IsBusy(void);
+
+/**
+ * @brief Get transport statistics
+ */
+Std_ReturnType IsoTp_GetStatistics(IsoTp_Statistics_t* statistics);
+
+/**
+ * @brief Stream source for a pre-serialized response held in stream->flatData
+ */
+uint16 IsoTp_FlatStreamFill(IsoTp_TxStream_t* stream, uint8* dest, uint16 maxLength);
+
+/* CAN driver interface: returns E_NOT_OK if no transmit buffer is free */
+extern Std_ReturnType IsoTp_CanTransmit(const uint8 data[ISOTP_FRAME_LENGTH]);
+
+#endif /* ISOTP_H */
@@ -0,0 +1,104 @@
+/**
+ * @file RunnableTiming.h
+ * @brief Execution time and activation jitter measurement for the RTE runnables
+ * @author Generated for ABS Malfunction Detection System
+ *
+ * Compiled in with -DRUNNABLE_TIMING. Without it the RUNNABLE_TIMING_START /
+ * RUNNABLE_TIMING_STOP hooks in the runnables expand to nothing and the timing
+ * DIDs are not served.
+ */
+
+#ifndef RUNNABLETIMING_H
+#define RUNNABLETIMING_H
+
+#include "Std_Types.h"
+
+/* Instrumented runnables */
+typedef enum {
+    RUNNABLE_SPEED_SENSOR_MAIN = 0,         /* RE_SpeedSensor_MainCyclic */
+    RUNNABLE_ABS_DETECTION_MAIN = 1,        /* RE_ABS_MalfunctionDetection_MainCyclic */
+    RUNNABLE_CALIBRATION_MAIN = 2,          /* RE_CalibrationManager_MainCyclic */
+    RUNNABLE_DIAG_UDS_PROCESSING = 3,       /* RE_DiagnosticService_UDSProcessing */
+    RUNNABLE_MAX = 4
+} RunnableId_t;
+
+/* Nominal activation periods (the budgets) of the OS task table */
+#define RUNNABLE_SPEED_SENSOR_MAIN_PERIOD_MS    10U      /* SPEED_SENSOR_SAMPLE_RATE_MS */
+#define RUNNABLE_ABS_DETECTION_MAIN_PERIOD_MS   20U      /* ABS_DETECTION_CYCLE_MS */
+#ifndef RUNNABLE_CALIBRATION_MAIN_PERIOD_MS
+#define RUNNABLE_CALIBRATION_MAIN_PERIOD_MS     100U
+#endif
+#ifndef RUNNABLE_DIAG_UDS_PROCESSING_PERIOD_MS
+#define RUNNABLE_DIAG_UDS_PROCESSING_PERIOD_MS  10U
+#endif
+
+/* Time base: DWT cycle counter on Cortex-M targets, CLOCK_MONOTONIC (1 ns ticks) on the host */
+#ifndef RUNNABLE_TIMING_CYCLE_COUNTER
+#if defined(__arm__) && !defined(__linux__)
+#define RUNNABLE_TIMING_CYCLE_COUNTER           1
+#else
+#define RUNNABLE_TIMING_CYCLE_COUNTER           0
+#endif
+#endif
+
+#if RUNNABLE_TIMING_CYCLE_COUNTER
+#ifndef RUNNABLE_TIMING_CPU_MHZ
+#define RUNNABLE_TIMING_CPU_MHZ                 160U
+#endif
+#define RUNNABLE_TIMING_TICKS_PER_US            RUNNABLE_TIMING_CPU_MHZ
+#else
+#define RUNNABLE_TIMING_TICKS_PER_US            1000U
+#endif
+
+/* Histogram bins, upper edges in per mille of the runnable period; the last bin is an overrun */
+#define RUNNABLE_TIMING_HISTOGRAM_BINS          8U
+#define RUNNABLE_TIMING_BIN_EDGES_PERMILLE      {10U, 20U, 50U, 100U, 250U, 500U, 1000U}
+
+/* Timing DIDs, one per runnable (served by DiagnosticService) */
+#define DID_RUNNABLE_TIMING_FIRST               0xF130U
+#define DID_RUNNABLE_TIMING_LAST                (DID_RUNNABLE_TIMING_FIRST + RUNNABLE_MAX - 1U)
+#define DID_RUNNABLE_TIMING_LENGTH              48U  /* activations, exec and jitter min/avg/max [us], 2 x 8 bins */
+
+/* Statistics of one runnable since RunnableTiming_Init, in ticks */
+typedef struct {
+    uint32 activations;
+    uint32 execMinTicks;
+    uint32 execAvgTicks;
+    uint32 execMaxTicks;
+    uint32 jitterSamples;               /* Activations with a previous activation to compare to */
+    uint32 jitterMinTicks;              /* |start-to-start time - period| */
+    uint32 jitterAvgTicks;
+    uint32 jitterMaxTicks;
+    uint32 execHistogram[RUNNABLE_TIMING_HISTOGRAM_BINS];
+    uint32 jitterHistogram[RUNNABLE_TIMING_HISTOGRAM_BINS];
+} RunnableTiming_Summary_t;
+
+#if defined(RUNNABLE_TIMING)
+#define RUNNABLE_TIMING_START(id)               RunnableTiming_Start(id)
+#define RUNNABLE_TIMING_STOP(id)                RunnableTiming_Stop(id)
+#else
+#define RUNNABLE_TIMING_START(id)               ((void)0)
+#define RUNNABLE_TIMING_STOP(id)                ((void)0)
+#endif
+
+/**
+ * @brief Start the time base and clear all statistics
+ */
+void RunnableTiming_Init(void);
+
+/**
+ * @brief Mark the start of a runnable activation
+ */
+void RunnableTiming_Start(RunnableId_t runnable);
+
+/**
+ * @brief Mark the end of the activation started last for this runnable
+ */
+void RunnableTiming_Stop(RunnableId_t runnable);
+
+/**
+ * @brief Copy the statistics of a runnable
+ */
+Std_ReturnType RunnableTiming_GetSummary(RunnableId_t runnable, RunnableTiming_Summary_t* summary);
+
+#endif /* RUNNABLETIMING_H */
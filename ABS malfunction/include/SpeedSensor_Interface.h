@@ -70,6 +70,14 @@ Std_ReturnType SpeedSensor_GetCalibration(WheelPosition_t wheelPos, SpeedSensorC
  */
 Std_ReturnType SpeedSensor_ValidateCalibration(WheelPosition_t wheelPos, boolean* isValid);
 
+/**
+ * @brief Select the acceleration derivative filter for a wheel (restarts the filter)
+ * @param wheelPos Wheel position
+ * @param filter Filter type
+ * @return E_OK if successful, E_NOT_OK otherwise
+ */
+Std_ReturnType SpeedSensor_SetAccelerationFilter(WheelPosition_t wheelPos, SpeedAccelFilter_t filter);
+
 /**
  * @brief Get sensor diagnostic information
  * @param wheelPos Wheel position
@@ -55,6 +55,23 @@ typedef struct {
     uint32 calibrationTimestamp; /* Last calibration timestamp */
 } SpeedSensorCalibration_t;
 
+/* Wheel acceleration derivative filters */
+typedef enum {
+    SPEED_ACCEL_FILTER_DIFFERENCE = 0,      /* One-sample difference, no smoothing */
+    SPEED_ACCEL_FILTER_IIR = 1,             /* Difference through a first-order low-pass */
+    SPEED_ACCEL_FILTER_SAVITZKY_GOLAY = 2   /* 5-point Savitzky-Golay derivative, 2 samples delay */
+} SpeedAccelFilter_t;
+
+#define SPEED_ACCEL_FILTER_TAPS         5U
+
+/* Acceleration filter state (one instance per wheel) */
+typedef struct {
+    float32 speedHistory[SPEED_ACCEL_FILTER_TAPS];  /* Newest first */
+    float32 filteredAcceleration;                   /* IIR output */
+    uint8 type;                                     /* SpeedAccelFilter_t */
+    uint8 sampleCount;                              /* Valid history entries */
+} SpeedAccelFilterState_t;
+
 /* Speed sensor diagnostic data */
 typedef struct {
     uint32 totalPulseCount;     /* Total lifetime pulse count */
@@ -64,14 +81,39 @@ typedef struct {
     uint32 lastErrorTimestamp;  /* Timestamp of last error */
 } SpeedSensorDiagnostics_t;
 
-/* Complete speed sensor data structure */
+/* Speed conversion of one wheel, derived from its calibration */
+typedef struct {
+#if defined(SPEED_SENSOR_FIXED_POINT)
+    uint32 pulseScaleQ;         /* km/h per (pulse/ms), Q12 */
+    uint32 correctionFactorQ;   /* Q16 */
+    sint32 offsetQ;             /* km/h, Q8 */
+#else
+    float32 pulseScale;         /* km/h per (pulse/ms) */
+    float32 correctionFactor;
+    float32 offsetValue;        /* km/h */
+#endif
+} SpeedSensorScale_t;
+
+/* Per-sample state of one wheel: everything a speed sensor cycle reads and
+ * writes, packed into one cache line (SpeedSensorRawData_t is stored unpacked) */
 typedef struct {
-    WheelPosition_t wheelPosition;
-    SpeedSensorRawData_t rawData;
     SpeedData_t speedData;
-    SpeedSensorCalibration_t calibration;
-    SpeedSensorDiagnostics_t diagnostics;
-} SpeedSensorData_t;
+    SpeedAccelFilterState_t accelFilter;
+    SpeedSensorScale_t scale;
+    uint16 pulseCount;
+    uint16 timeInterval;
+    uint8 status;               /* SensorStatus_t */
+    boolean dataValid;
+    boolean calibrationValid;
+} SpeedSensorHotData_t;
+
+/* Cache line alignment of the per-wheel hot data */
+#define SPEED_SENSOR_CACHE_LINE_SIZE    64U
+#if defined(__GNUC__)
+#define SPEED_SENSOR_CACHE_ALIGNED      __attribute__((aligned(64)))
+#else
+#define SPEED_SENSOR_CACHE_ALIGNED
+#endif
 
 /* ABS system constants */
 #define SPEED_SENSOR_SAMPLE_RATE_MS     10U    /* 100 Hz sampling */
@@ -80,4 +122,20 @@ typedef struct {
 #define CALIBRATION_TOLERANCE          5.0f    /* Calibration tolerance in % */
 #define SPEED_DIFFERENCE_THRESHOLD     20.0f   /* Speed difference threshold for ABS trigger */
 
+/* Acceleration filter defaults */
+#ifndef SPEED_ACCEL_FILTER_DEFAULT
+#define SPEED_ACCEL_FILTER_DEFAULT      SPEED_ACCEL_FILTER_SAVITZKY_GOLAY
+#endif
+#define SPEED_ACCEL_IIR_ALPHA           0.25f   /* Weight of the newest difference */
+
+/* Speed computation: 1/timeInterval lookup for intervals up to this many ms */
+#ifndef SPEED_SENSOR_RECIPROCAL_TABLE_SIZE
+#define SPEED_SENSOR_RECIPROCAL_TABLE_SIZE  64U
+#endif
+/* Fixed-point speed path (define SPEED_SENSOR_FIXED_POINT for FPU-less targets) */
+#define SPEED_SENSOR_SPEED_Q_BITS       8U      /* Speeds in 1/256 km/h */
+#define SPEED_SENSOR_SCALE_Q_BITS       12U     /* Pulse scale in 1/4096 km/h per (pulse/ms) */
+#define SPEED_SENSOR_FACTOR_Q_BITS      16U     /* Correction factor Q16 */
+#define SPEED_SENSOR_RECIPROCAL_Q_BITS  24U     /* 1/timeInterval Q24 */
+
 #endif /* SPEEDSENSOR_TYPES_H */
\ No newline at end of file
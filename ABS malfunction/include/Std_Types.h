@@ -11,6 +11,7 @@
 typedef unsigned char       uint8;
 typedef unsigned short      uint16;
 typedef unsigned long       uint32;
+typedef unsigned long long  uint64;
 typedef signed char         sint8;
 typedef signed short        sint16;
 typedef signed long         sint32;
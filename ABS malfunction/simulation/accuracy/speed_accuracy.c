@@ -0,0 +1,174 @@
+/**
+ * @file speed_accuracy.c
+ * @brief Host accuracy check of the speed sensor speed computation
+ * @author Generated for ABS Malfunction Detection System
+ *
+ * Feeds a sweep of pulse counts, time intervals and calibrations within the
+ * valid speed range through SpeedSensor_MainFunction and compares
+ * wheelSpeedRaw/wheelSpeed with the exact (double) result and with the
+ * original float formula (three divisions per sample). The float build must
+ * stay within SPEED_CHECK_MAX_ULP units in the last place of the exact
+ * result, which is the worst case of the original formula; the fixed-point
+ * build (-DSPEED_SENSOR_FIXED_POINT) within SPEED_CHECK_MAX_FIXED_ERROR_KMH.
+ * Exits with status 1 on any violation.
+ */
+
+#include "Std_Types.h"
+#include "SpeedSensor_Interface.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SPEED_CHECK_MAX_ULP             4U     /* Raw speed vs exact result */
+#define SPEED_CHECK_MAX_FIXED_ERROR_KMH 0.01f  /* Q8 output and Q12 scale rounding */
+#define SPEED_CHECK_MAX_INTERVAL_MS     100U   /* Covers table and division fallback */
+#define SPEED_CHECK_CALIBRATIONS        64U
+
+static SpeedSensorRawData_t g_RawData[WHEEL_MAX];
+
+static Std_ReturnType Check_ReadRawData(WheelPosition_t wheelPos, SpeedSensorRawData_t* data)
+{
+    *data = g_RawData[wheelPos];
+    return E_OK;
+}
+
+Std_ReturnType Rte_Read_RawSensorData_FL_rawData(SpeedSensorRawData_t* data) { return Check_ReadRawData(WHEEL_FRONT_LEFT, data); }
+Std_ReturnType Rte_Read_RawSensorData_FR_rawData(SpeedSensorRawData_t* data) { return Check_ReadRawData(WHEEL_FRONT_RIGHT, data); }
+Std_ReturnType Rte_Read_RawSensorData_RL_rawData(SpeedSensorRawData_t* data) { return Check_ReadRawData(WHEEL_REAR_LEFT, data); }
+Std_ReturnType Rte_Read_RawSensorData_RR_rawData(SpeedSensorRawData_t* data) { return Check_ReadRawData(WHEEL_REAR_RIGHT, data); }
+
+Std_ReturnType Rte_Write_SpeedData_FL_speedData(const SpeedData_t* data) { (void)data; return E_OK; }
+Std_ReturnType Rte_Write_SpeedData_FR_speedData(const SpeedData_t* data) { (void)data; return E_OK; }
+Std_ReturnType Rte_Write_SpeedData_RL_speedData(const SpeedData_t* data) { (void)data; return E_OK; }
+Std_ReturnType Rte_Write_SpeedData_RR_speedData(const SpeedData_t* data) { (void)data; return E_OK; }
+
+/* Original per-sample computation, kept verbatim as the reference */
+static float32 Check_ReferenceRawSpeed(uint16 pulseCount, uint16 timeInterval, const SpeedSensorCalibration_t* cal)
+{
+    float32 timeInSeconds = (float32)timeInterval / 1000.0f;
+    float32 rpm = ((float32)pulseCount / (float32)cal->pulsesPerRevolution) / timeInSeconds * 60.0f;
+    
+    return rpm * cal->wheelCircumference * 60.0f / 1000.0f;
+}
+
+/* Distance in units in the last place between two positive floats */
+static uint32 Check_UlpDistance(float32 a, float32 b)
+{
+    int32_t ia;
+    int32_t ib;
+    
+    memcpy(&ia, &a, sizeof(ia));
+    memcpy(&ib, &b, sizeof(ib));
+    
+    return (uint32)((ia > ib) ? (ia - ib) : (ib - ia));
+}
+
+int main(void)
+{
+    SpeedSensorCalibration_t cal[WHEEL_MAX];
+    SpeedData_t speedData;
+    uint32 samples = 0;
+    uint32 failures = 0;
+    uint32 maxUlp = 0;
+    uint32 maxReferenceUlp = 0;
+    float32 maxError = 0.0f;
+    uint32 calIdx;
+    uint16 interval;
+    uint16 pulses;
+    uint16 maxPulses;
+    uint8 wheelIdx;
+    
+    srand(0x5EED);
+    SpeedSensor_Init();
+    
+    for (calIdx = 0; calIdx < SPEED_CHECK_CALIBRATIONS; calIdx++)
+    {
+        for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+        {
+            memset(&cal[wheelIdx], 0, sizeof(SpeedSensorCalibration_t));
+            cal[wheelIdx].pulsesPerRevolution = (uint16)(30 + (rand() % 91));
+            cal[wheelIdx].wheelCircumference = 1.5f + (1.5f * (float32)rand() / (float32)RAND_MAX);
+            cal[wheelIdx].correctionFactor = 0.8f + (0.4f * (float32)rand() / (float32)RAND_MAX);
+            cal[wheelIdx].offsetValue = (calIdx == 0U) ? 0.0f : (-1.0f + (2.0f * (float32)rand() / (float32)RAND_MAX));
+            cal[wheelIdx].calibrationValid = TRUE;
+            if (SpeedSensor_SetCalibration((WheelPosition_t)wheelIdx, &cal[wheelIdx]) != E_OK)
+            {
+                printf("calibration %lu rejected\n", (unsigned long)calIdx);
+                return 1;
+            }
+        }
+        
+        for (interval = 1; interval <= SPEED_CHECK_MAX_INTERVAL_MS; interval++)
+        {
+            /* Pulse counts up to MAX_WHEEL_SPEED_KMH for the smallest wheel of this set */
+            maxPulses = (uint16)((MAX_WHEEL_SPEED_KMH * (float32)interval * 120.0f) / (1.5f * 3600.0f)) + 1U;
+            
+            for (pulses = 0; pulses <= maxPulses; pulses++)
+            {
+                for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+                {
+                    g_RawData[wheelIdx].pulseCount = pulses;
+                    g_RawData[wheelIdx].timeInterval = interval;
+                    g_RawData[wheelIdx].status = SENSOR_STATUS_OK;
+                    g_RawData[wheelIdx].dataValid = TRUE;
+                }
+                
+                SpeedSensor_MainFunction();
+                
+                for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+                {
+                    float32 refRaw = Check_ReferenceRawSpeed(pulses, interval, &cal[wheelIdx]);
+                    float32 refSpeed = refRaw * cal[wheelIdx].correctionFactor + cal[wheelIdx].offsetValue;
+                    float32 exactRaw = (float32)((float64)pulses / (float64)interval *
+                                                 (float64)cal[wheelIdx].wheelCircumference * 3600.0 /
+                                                 (float64)cal[wheelIdx].pulsesPerRevolution);
+                    float32 error;
+                    uint32 ulp;
+                    uint32 referenceUlp;
+                    boolean ok;
+                    
+                    if (refRaw > MAX_WHEEL_SPEED_KMH)
+                    {
+                        /* Beyond the validated speed range of this wheel */
+                        continue;
+                    }
+                    
+                    SpeedSensor_GetSpeedData((WheelPosition_t)wheelIdx, &speedData);
+                    error = fmaxf(fabsf(speedData.wheelSpeedRaw - refRaw), fabsf(speedData.wheelSpeed - refSpeed));
+                    ulp = Check_UlpDistance(speedData.wheelSpeedRaw, exactRaw);
+                    referenceUlp = Check_UlpDistance(speedData.wheelSpeedRaw, refRaw);
+#if defined(SPEED_SENSOR_FIXED_POINT)
+                    ok = (error <= SPEED_CHECK_MAX_FIXED_ERROR_KMH) ? TRUE : FALSE;
+#else
+                    ok = (ulp <= SPEED_CHECK_MAX_ULP) ? TRUE : FALSE;
+#endif
+                    if (ulp > maxUlp) maxUlp = ulp;
+                    if (referenceUlp > maxReferenceUlp) maxReferenceUlp = referenceUlp;
+                    if (error > maxError) maxError = error;
+                    if ((ok == FALSE) && (failures++ < 10U))
+                    {
+                        printf("mismatch: pulses=%u interval=%u ppr=%u circ=%.4f raw=%.7f exact=%.7f (%lu ulp) speed=%.7f ref=%.7f\n",
+                               pulses, interval, cal[wheelIdx].pulsesPerRevolution, cal[wheelIdx].wheelCircumference,
+                               speedData.wheelSpeedRaw, exactRaw, (unsigned long)ulp, speedData.wheelSpeed, refSpeed);
+                    }
+                    samples++;
+                }
+            }
+        }
+    }
+    
+#if defined(SPEED_SENSOR_FIXED_POINT)
+    printf("speed accuracy (fixed point): %lu samples, max error %.5f km/h, %lu failures\n",
+           (unsigned long)samples, maxError, (unsigned long)failures);
+#else
+    printf("speed accuracy (float): %lu samples, max %lu ulp from exact, %lu ulp from original formula, "
+           "max error %.6f km/h, %lu failures\n",
+           (unsigned long)samples, (unsigned long)maxUlp, (unsigned long)maxReferenceUlp, maxError,
+           (unsigned long)failures);
+#endif
+    
+    return (failures == 0U) ? 0 : 1;
+}
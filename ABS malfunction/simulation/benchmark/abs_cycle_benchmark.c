@@ -0,0 +1,302 @@
+/**
+ * @file abs_cycle_benchmark.c
+ * @brief Main-function cycle and calibration session cost of the ABS ECU software on a PC host
+ * @author Generated for ABS Malfunction Detection System
+ *
+ * Drives the production SWCs through the host RTE stubs with a synthetic
+ * drive generated from a fixed seed, so every run processes the same input:
+ *   - ABS cycle: the detection cycle of the trace replay (two speed sensor samples,
+ *     ABS_UpdateVehicleData, RE_ABS_MalfunctionDetection_MainCyclic and
+ *     RE_DiagnosticService_DTCManager), reported as cycles per second.
+ *   - Calibration: calibrate-all sessions against a shared reference speed
+ *     run to completion, including the NVM write-back, reported as time and
+ *     main-function cycles per session.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "Std_Types.h"
+#include "SpeedSensor_Interface.h"
+#include "ABS_MalfunctionDetection.h"
+#include "CalibrationManager.h"
+#include "DiagnosticService.h"
+#include "rte_host_stubs.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_DEFAULT_CYCLES          2000000UL
+#define BENCH_DEFAULT_SESSIONS        5000UL
+#define BENCH_DEFAULT_SEED            0x5EEDU
+#define BENCH_PULSE_WINDOW_MS         16384U   /* Measurement window of the emulated pulse counter */
+#define BENCH_SENSOR_TICKS_PER_CYCLE  (ABS_DETECTION_CYCLE_MS / SPEED_SENSOR_SAMPLE_RATE_MS)
+#define BENCH_DROPOUT_PER_MILLE       2U       /* Invalid sensor samples in the drive */
+#define BENCH_MIN_SPEED_KMH           30.0f
+#define BENCH_MAX_SPEED_KMH           90.0f
+#define BENCH_SPEED_STEP_KMH          0.05f    /* Speed change per sensor sample */
+#define BENCH_REFERENCE_FACTOR        1.02f    /* Reference speed against the wheel speed */
+#define BENCH_SESSION_CYCLE_LIMIT     (CALIBRATION_MAX_SAMPLES * 4U)
+
+static uint32 g_PrngState = BENCH_DEFAULT_SEED;
+static float32 g_PulseScale[WHEEL_MAX];         /* km/h per (pulse/ms) of the emulated sensor */
+static float32 g_DriveSpeed = BENCH_MIN_SPEED_KMH;
+static float32 g_DriveStep = BENCH_SPEED_STEP_KMH;
+
+/* xorshift32 */
+static uint32 Bench_Random(void)
+{
+    uint32 x = g_PrngState;
+
+    x ^= (x << 13) & 0xFFFFFFFFUL;
+    x ^= x >> 17;
+    x ^= (x << 5) & 0xFFFFFFFFUL;
+    g_PrngState = x & 0xFFFFFFFFUL;
+
+    return g_PrngState;
+}
+
+static uint32 Bench_RandomBelow(uint32 limit)
+{
+    return Bench_Random() % limit;
+}
+
+static uint64_t Bench_NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Bring up the ECU software and derive the emulated sensor pulse scale
+ */
+static void Bench_InitEcu(void)
+{
+    SpeedSensorCalibration_t calibration;
+    uint8 wheelIdx;
+
+    SpeedSensor_Init();
+    CalibrationManager_Init();
+    ABS_MalfunctionDetection_Init();
+    DiagnosticService_Init();
+
+    for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+    {
+        (void)SpeedSensor_GetCalibration((WheelPosition_t)wheelIdx, &calibration);
+        g_PulseScale[wheelIdx] = calibration.wheelCircumference * 3600.0f / (float32)calibration.pulsesPerRevolution;
+    }
+}
+
+/**
+ * @brief Advance the synthetic drive by one sensor sample and present it as pulse counts
+ *
+ * The vehicle speed ramps between BENCH_MIN_SPEED_KMH and BENCH_MAX_SPEED_KMH;
+ * each wheel adds a small random slip and a few samples are dropped.
+ */
+static void Bench_FeedSensors(void)
+{
+    SpeedSensorRawData_t rawData;
+    float32 speed;
+    float32 pulses;
+    uint8 wheelIdx;
+
+    g_DriveSpeed += g_DriveStep;
+    if ((g_DriveSpeed >= BENCH_MAX_SPEED_KMH) || (g_DriveSpeed <= BENCH_MIN_SPEED_KMH))
+    {
+        g_DriveStep = -g_DriveStep;
+    }
+
+    for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+    {
+        if (Bench_RandomBelow(1000U) >= BENCH_DROPOUT_PER_MILLE)
+        {
+            speed = g_DriveSpeed * (1.0f + ((float32)Bench_RandomBelow(41U) - 20.0f) * 0.0005f);
+            pulses = (speed * (float32)BENCH_PULSE_WINDOW_MS / g_PulseScale[wheelIdx]) + 0.5f;
+            rawData.pulseCount = (pulses < 65535.0f) ? (uint16)pulses : 65535U;
+            rawData.timeInterval = BENCH_PULSE_WINDOW_MS;
+            rawData.status = SENSOR_STATUS_OK;
+            rawData.dataValid = TRUE;
+        }
+        else
+        {
+            rawData.pulseCount = 0;
+            rawData.timeInterval = 0;
+            rawData.status = SENSOR_STATUS_INVALID;
+            rawData.dataValid = FALSE;
+        }
+        HostStub_SetRawData((WheelPosition_t)wheelIdx, &rawData);
+    }
+}
+
+/**
+ * @brief One ABS main-function cycle: its speed sensor samples, detection and DTC manager
+ */
+static void Bench_RunAbsCycle(void)
+{
+    ABS_VehicleData_t vehicleData;
+    uint8 tick;
+    uint8 wheelIdx;
+
+    for (tick = 0; tick < BENCH_SENSOR_TICKS_PER_CYCLE; tick++)
+    {
+        Bench_FeedSensors();
+        RE_SpeedSensor_MainCyclic();
+    }
+
+    memset(&vehicleData, 0, sizeof(vehicleData));
+    for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+    {
+        (void)SpeedSensor_GetSpeedData((WheelPosition_t)wheelIdx, &vehicleData.wheelSpeeds[wheelIdx]);
+    }
+
+    (void)ABS_UpdateVehicleData(&vehicleData);
+    RE_ABS_MalfunctionDetection_MainCyclic();
+    RE_DiagnosticService_DTCManager();
+}
+
+static boolean Bench_AnySessionActive(void)
+{
+    CalibrationSession_t session;
+    boolean active = FALSE;
+    uint8 wheelIdx;
+
+    for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+    {
+        if ((CalibrationManager_GetSessionStatus((WheelPosition_t)wheelIdx, &session) == E_OK) &&
+            (session.sessionActive == TRUE))
+        {
+            active = TRUE;
+        }
+    }
+
+    return active;
+}
+
+/**
+ * @brief Run one calibrate-all session to completion
+ * @return Calibration main-function cycles used, 0 if the session did not finish
+ */
+static uint32 Bench_RunCalibrationSession(uint32* wheelsCalibrated)
+{
+    CalibrationRequest_t request;
+    CalibrationSession_t session;
+    uint32 cycles = 0;
+    uint8 wheelIdx;
+
+    memset(&request, 0, sizeof(request));
+    request.method = CALIBRATION_METHOD_REFERENCE_BASED;
+    request.referenceSpeed = g_DriveSpeed * BENCH_REFERENCE_FACTOR;
+    request.tolerancePercentage = 5.0f;
+    request.calibrationTimeMs = 0;
+    request.forceCalibration = TRUE;
+
+    if (CalibrationManager_StartCalibrationAll(&request) != E_OK)
+    {
+        return 0;
+    }
+
+    while ((Bench_AnySessionActive() == TRUE) && (cycles < BENCH_SESSION_CYCLE_LIMIT))
+    {
+        Bench_FeedSensors();
+        RE_SpeedSensor_MainCyclic();
+        (void)CalibrationManager_SetReferenceSpeed(g_DriveSpeed * BENCH_REFERENCE_FACTOR);
+        RE_CalibrationManager_MainCyclic();
+        RE_CalibrationManager_NvmManager();
+        cycles++;
+    }
+
+    for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+    {
+        if ((CalibrationManager_GetSessionStatus((WheelPosition_t)wheelIdx, &session) == E_OK) &&
+            (session.result == CALIBRATION_RESULT_OK))
+        {
+            (*wheelsCalibrated)++;
+        }
+    }
+
+    return (cycles < BENCH_SESSION_CYCLE_LIMIT) ? cycles : 0U;
+}
+
+static void Bench_Usage(const char* program)
+{
+    printf("Usage: %s [-n cycles] [-c sessions] [-s seed]\n", program);
+    printf("  -n  ABS main-function cycles (default %lu)\n", BENCH_DEFAULT_CYCLES);
+    printf("  -c  calibrate-all sessions (default %lu)\n", BENCH_DEFAULT_SESSIONS);
+    printf("  -s  random seed of the synthetic drive (default 0x%X)\n", BENCH_DEFAULT_SEED);
+}
+
+int main(int argc, char** argv)
+{
+    unsigned long cycles = BENCH_DEFAULT_CYCLES;
+    unsigned long sessions = BENCH_DEFAULT_SESSIONS;
+    unsigned long i;
+    uint64_t t0;
+    uint64_t t1;
+    uint64_t sessionCycles = 0;
+    uint32 used;
+    uint32 unfinished = 0;
+    uint32 wheelsCalibrated = 0;
+    double seconds;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:c:s:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n': cycles = strtoul(optarg, NULL, 0); break;
+            case 'c': sessions = strtoul(optarg, NULL, 0); break;
+            case 's': g_PrngState = (uint32)strtoul(optarg, NULL, 0); break;
+            default: Bench_Usage(argv[0]); return (opt == 'h') ? 0 : 2;
+        }
+    }
+
+    if ((cycles == 0UL) || (sessions == 0UL) || (g_PrngState == 0U))
+    {
+        Bench_Usage(argv[0]);
+        return 2;
+    }
+
+    Bench_InitEcu();
+
+    printf("ABS main-function benchmark\n");
+    printf("  %lu detection cycles (%u speed sensor samples each), %lu calibrate-all sessions\n",
+           cycles, (unsigned)BENCH_SENSOR_TICKS_PER_CYCLE, sessions);
+
+    t0 = Bench_NowNs();
+    for (i = 0; i < cycles; i++)
+    {
+        Bench_RunAbsCycle();
+    }
+    t1 = Bench_NowNs();
+    seconds = (double)(t1 - t0) / 1.0e9;
+
+    printf("\nABS detection cycle\n");
+    printf("  throughput: %.0f cycles/s\n", (seconds > 0.0) ? (double)cycles / seconds : 0.0);
+    printf("  mean: %.0f ns/cycle\n", (double)(t1 - t0) / (double)cycles);
+
+    t0 = Bench_NowNs();
+    for (i = 0; i < sessions; i++)
+    {
+        used = Bench_RunCalibrationSession(&wheelsCalibrated);
+        if (used == 0U)
+        {
+            unfinished++;
+        }
+        sessionCycles += used;
+    }
+    t1 = Bench_NowNs();
+
+    printf("\nCalibrate-all session\n");
+    printf("  cost: %.0f ns/session\n", (double)(t1 - t0) / (double)sessions);
+    printf("  cycles: %.1f per session\n", (double)sessionCycles / (double)sessions);
+    printf("  wheels calibrated: %lu/%lu\n", (unsigned long)wheelsCalibrated,
+           sessions * (unsigned long)WHEEL_MAX);
+    printf("\nUnfinished sessions: %lu\n", (unsigned long)unfinished);
+
+    return (unfinished == 0U) ? 0 : 1;
+}
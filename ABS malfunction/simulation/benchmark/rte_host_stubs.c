@@ -0,0 +1,125 @@
+/**
+ * @file rte_host_stubs.c
+ * @brief Host RTE, NvM and CAN driver stubs for running the ECU software on a PC
+ * @author Generated for ABS Malfunction Detection System
+ */
+
+#include "Std_Types.h"
+#include "SpeedSensor_Interface.h"
+#include "ABS_MalfunctionDetection.h"
+#include "CalibrationManager.h"
+#include "DiagnosticService.h"
+#include "IsoTp.h"
+#include "rte_host_stubs.h"
+#include <string.h>
+
+/* NvM emulation: one calibration and one history block per wheel, empty until first written */
+static uint8 g_NvmBlocks[WHEEL_MAX * 2U][CALIBRATION_HISTORY_NVM_BLOCK_SIZE];
+static boolean g_NvmBlockWritten[WHEEL_MAX * 2U];
+
+static sint32 HostStub_NvmBlockIndex(uint16 blockId, uint32* size)
+{
+    sint32 index = -1;
+    
+    if ((blockId >= NVM_BLOCK_CALIBRATION_FL) && (blockId <= NVM_BLOCK_CALIBRATION_RR))
+    {
+        index = (sint32)(blockId - NVM_BLOCK_CALIBRATION_FL);
+        *size = sizeof(SpeedSensorCalibration_t);
+    }
+    else if ((blockId >= NVM_BLOCK_CALIBRATION_HISTORY_FL) && (blockId <= NVM_BLOCK_CALIBRATION_HISTORY_RR))
+    {
+        index = (sint32)(WHEEL_MAX + (blockId - NVM_BLOCK_CALIBRATION_HISTORY_FL));
+        *size = CALIBRATION_HISTORY_NVM_BLOCK_SIZE;
+    }
+    
+    return index;
+}
+
+Std_ReturnType Rte_Call_NvmService_ReadBlock(uint16 blockId, void* dataPtr)
+{
+    Std_ReturnType retVal = NVM_REQ_NOT_OK;
+    uint32 size = 0;
+    sint32 index = HostStub_NvmBlockIndex(blockId, &size);
+    
+    if ((index >= 0) && (dataPtr != NULL_PTR) && (g_NvmBlockWritten[index] == TRUE))
+    {
+        memcpy(dataPtr, g_NvmBlocks[index], size);
+        retVal = NVM_REQ_OK;
+    }
+    
+    return retVal;
+}
+
+Std_ReturnType Rte_Call_NvmService_WriteBlock(uint16 blockId, const void* dataPtr)
+{
+    Std_ReturnType retVal = NVM_REQ_NOT_OK;
+    uint32 size = 0;
+    sint32 index = HostStub_NvmBlockIndex(blockId, &size);
+    
+    if ((index >= 0) && (dataPtr != NULL_PTR))
+    {
+        memcpy(g_NvmBlocks[index], dataPtr, size);
+        g_NvmBlockWritten[index] = TRUE;
+        retVal = NVM_REQ_OK;
+    }
+    
+    return retVal;
+}
+
+Std_ReturnType Rte_Call_DiagnosticService_SetDTC(uint32 dtcId, boolean active)
+{
+    (void)dtcId;
+    (void)active;
+    return E_OK;
+}
+
+/* Speed sensor ports: constant 100 pulses per sample on every wheel unless a host tool
+ * (e.g. the trace replay) supplies the raw data */
+static SpeedSensorRawData_t g_HostRawData[WHEEL_MAX] = {
+    { 100U, SPEED_SENSOR_SAMPLE_RATE_MS, SENSOR_STATUS_OK, TRUE },
+    { 100U, SPEED_SENSOR_SAMPLE_RATE_MS, SENSOR_STATUS_OK, TRUE },
+    { 100U, SPEED_SENSOR_SAMPLE_RATE_MS, SENSOR_STATUS_OK, TRUE },
+    { 100U, SPEED_SENSOR_SAMPLE_RATE_MS, SENSOR_STATUS_OK, TRUE }
+};
+
+void HostStub_SetRawData(WheelPosition_t wheelPos, const SpeedSensorRawData_t* data)
+{
+    if ((wheelPos < WHEEL_MAX) && (data != NULL_PTR))
+    {
+        g_HostRawData[wheelPos] = *data;
+    }
+}
+
+static Std_ReturnType HostStub_ReadRawData(WheelPosition_t wheelPos, SpeedSensorRawData_t* data)
+{
+    *data = g_HostRawData[wheelPos];
+    return E_OK;
+}
+
+Std_ReturnType Rte_Read_RawSensorData_FL_rawData(SpeedSensorRawData_t* data) { return HostStub_ReadRawData(WHEEL_FRONT_LEFT, data); }
+Std_ReturnType Rte_Read_RawSensorData_FR_rawData(SpeedSensorRawData_t* data) { return HostStub_ReadRawData(WHEEL_FRONT_RIGHT, data); }
+Std_ReturnType Rte_Read_RawSensorData_RL_rawData(SpeedSensorRawData_t* data) { return HostStub_ReadRawData(WHEEL_REAR_LEFT, data); }
+Std_ReturnType Rte_Read_RawSensorData_RR_rawData(SpeedSensorRawData_t* data) { return HostStub_ReadRawData(WHEEL_REAR_RIGHT, data); }
+
+Std_ReturnType Rte_Write_SpeedData_FL_speedData(const SpeedData_t* data) { (void)data; return E_OK; }
+Std_ReturnType Rte_Write_SpeedData_FR_speedData(const SpeedData_t* data) { (void)data; return E_OK; }
+Std_ReturnType Rte_Write_SpeedData_RL_speedData(const SpeedData_t* data) { (void)data; return E_OK; }
+Std_ReturnType Rte_Write_SpeedData_RR_speedData(const SpeedData_t* data) { (void)data; return E_OK; }
+
+/* ABS ports */
+Std_ReturnType Rte_Write_MalfunctionStatus_FL_status(const ABS_MalfunctionStatus_t* status) { (void)status; return E_OK; }
+Std_ReturnType Rte_Write_MalfunctionStatus_FR_status(const ABS_MalfunctionStatus_t* status) { (void)status; return E_OK; }
+Std_ReturnType Rte_Write_MalfunctionStatus_RL_status(const ABS_MalfunctionStatus_t* status) { (void)status; return E_OK; }
+Std_ReturnType Rte_Write_MalfunctionStatus_RR_status(const ABS_MalfunctionStatus_t* status) { (void)status; return E_OK; }
+Std_ReturnType Rte_Write_SystemState_state(const ABS_SystemState_t* state) { (void)state; return E_OK; }
+
+/* Diagnostic ports: requests are injected directly by the host tools */
+Std_ReturnType Rte_Read_UDSRequest_message(UDSMessage_t* message) { (void)message; return E_NOT_OK; }
+Std_ReturnType Rte_Write_UDSResponse_message(const UDSMessage_t* message) { (void)message; return E_OK; }
+
+/* CAN driver: frames are accepted and dropped */
+Std_ReturnType IsoTp_CanTransmit(const uint8 data[ISOTP_FRAME_LENGTH])
+{
+    (void)data;
+    return E_OK;
+}
@@ -0,0 +1,18 @@
+/**
+ * @file rte_host_stubs.h
+ * @brief Controls of the host RTE stubs used by the PC tools
+ * @author Generated for ABS Malfunction Detection System
+ */
+
+#ifndef RTE_HOST_STUBS_H
+#define RTE_HOST_STUBS_H
+
+#include "Std_Types.h"
+#include "SpeedSensor_Types.h"
+
+/**
+ * @brief Set the raw sensor data returned by the next Rte_Read_RawSensorData_<wheel>_rawData calls
+ */
+void HostStub_SetRawData(WheelPosition_t wheelPos, const SpeedSensorRawData_t* data);
+
+#endif /* RTE_HOST_STUBS_H */
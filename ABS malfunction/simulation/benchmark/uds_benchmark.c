@@ -0,0 +1,738 @@
+/**
+ * @file uds_benchmark.c
+ * @brief Load benchmark for the UDS diagnostic service on a PC host
+ * @author Generated for ABS Malfunction Detection System
+ *
+ * Replays recorded tester traffic and randomized valid/invalid requests
+ * across all supported service IDs through DiagnosticService_ProcessUDSRequest
+ * (or the streaming path with -S), and reports throughput and p50/p99/max
+ * latency per service. Every response must be a positive or negative
+ * response to its request. Heap use inside the ECU code is trapped with
+ * --wrap=malloc/calloc/realloc/free; any allocation or malformed response
+ * makes the benchmark exit with status 1.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "Std_Types.h"
+#include "SpeedSensor_Interface.h"
+#include "ABS_MalfunctionDetection.h"
+#include "CalibrationManager.h"
+#include "DiagnosticService.h"
+#include "IsoTp.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_MAX_REQUEST_LENGTH      64U
+#define BENCH_POOL_SIZE               4096U
+#define BENCH_MAX_TRACE_REQUESTS      1024U
+#define BENCH_MAX_SAMPLES             2000000UL
+#define BENCH_DEFAULT_ITERATIONS      1000000UL
+#define BENCH_DEFAULT_SEED            0x5EEDU
+#define BENCH_DTC_BASE                0xD00000UL
+#define BENCH_VALID_PERCENT           75U      /* Share of well-formed random requests */
+#define BENCH_FOREIGN_SID_PERCENT     5U       /* Share of SIDs outside the service table */
+#define BENCH_NO_RESPONSE             0xFFFFFFFFUL
+
+/* Pre-built request */
+typedef struct {
+    uint8 serviceId;
+    uint8 data[BENCH_MAX_REQUEST_LENGTH];
+    uint16 length;                      /* Request data length, excluding the SID */
+} BenchRequest_t;
+
+/* Per-service results */
+typedef struct {
+    uint32 count;
+    uint32 positive;
+    uint32 negative;
+    uint32 suppressed;
+} BenchServiceStats_t;
+
+/* Service IDs exercised by the random generator (the service table entries) */
+static const uint8 g_BenchServiceIds[] = {
+    UDS_SID_DIAGNOSTIC_SESSION_CONTROL,
+    UDS_SID_ECU_RESET,
+    UDS_SID_CLEAR_DIAGNOSTIC_INFORMATION,
+    UDS_SID_READ_DTC_INFORMATION,
+    UDS_SID_READ_DATA_BY_IDENTIFIER,
+    UDS_SID_WRITE_DATA_BY_IDENTIFIER,
+    UDS_SID_IO_CONTROL_BY_IDENTIFIER,
+    UDS_SID_ROUTINE_CONTROL,
+    UDS_SID_TESTER_PRESENT
+};
+
+#define BENCH_SERVICE_ID_COUNT (sizeof(g_BenchServiceIds) / sizeof(g_BenchServiceIds[0]))
+
+static const uint16 g_BenchDataIds[] = {
+    DID_SPEED_SENSOR_FL_DATA, DID_SPEED_SENSOR_FR_DATA, DID_SPEED_SENSOR_RL_DATA, DID_SPEED_SENSOR_RR_DATA,
+    DID_CALIBRATION_FL_PARAMS, DID_CALIBRATION_FR_PARAMS, DID_CALIBRATION_RL_PARAMS, DID_CALIBRATION_RR_PARAMS,
+    DID_ABS_SYSTEM_STATUS, DID_MALFUNCTION_COUNTER, DID_DIAGNOSTIC_SESSION_INFO
+};
+
+#define BENCH_DATA_ID_COUNT (sizeof(g_BenchDataIds) / sizeof(g_BenchDataIds[0]))
+
+static BenchRequest_t g_RequestPool[BENCH_POOL_SIZE];
+static BenchRequest_t g_TraceRequests[BENCH_MAX_TRACE_REQUESTS];
+static uint16 g_TraceRequestCount = 0;
+
+static uint32 g_LatencyNs[BENCH_MAX_SAMPLES];
+static uint8 g_LatencySid[BENCH_MAX_SAMPLES];
+static uint32 g_SortScratch[BENCH_MAX_SAMPLES];
+static BenchServiceStats_t g_ServiceStats[256];
+
+static uint8 g_ResponseBuffer[DIAG_MAX_RESPONSE_LENGTH];
+static uint32 g_PrngState = BENCH_DEFAULT_SEED;
+static uint32 g_MalformedResponses = 0;
+static boolean g_StreamMode = FALSE;
+
+/* Heap trap (GNU ld --wrap): counts allocations made by the ECU code while armed */
+static volatile boolean g_HeapTrapArmed = FALSE;
+static volatile uint32 g_HeapCalls = 0;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+void* __wrap_malloc(size_t size)
+{
+    if (g_HeapTrapArmed == TRUE) { g_HeapCalls++; }
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size)
+{
+    if (g_HeapTrapArmed == TRUE) { g_HeapCalls++; }
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size)
+{
+    if (g_HeapTrapArmed == TRUE) { g_HeapCalls++; }
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void* ptr)
+{
+    if (g_HeapTrapArmed == TRUE) { g_HeapCalls++; }
+    __real_free(ptr);
+}
+
+/* xorshift32 */
+static uint32 Bench_Random(void)
+{
+    uint32 x = g_PrngState;
+
+    x ^= (x << 13) & 0xFFFFFFFFUL;
+    x ^= x >> 17;
+    x ^= (x << 5) & 0xFFFFFFFFUL;
+    g_PrngState = x & 0xFFFFFFFFUL;
+
+    return g_PrngState;
+}
+
+static uint32 Bench_RandomBelow(uint32 limit)
+{
+    return Bench_Random() % limit;
+}
+
+static uint64_t Bench_NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void Bench_PutUint16(uint8* data, uint16 value)
+{
+    data[0] = (uint8)(value >> 8);
+    data[1] = (uint8)value;
+}
+
+/**
+ * @brief Build a well-formed request for a service
+ */
+static void Bench_BuildValidRequest(BenchRequest_t* req, uint8 serviceId)
+{
+    uint16 didCount;
+    uint16 i;
+
+    req->serviceId = serviceId;
+    req->length = 0;
+
+    switch (serviceId)
+    {
+        case UDS_SID_DIAGNOSTIC_SESSION_CONTROL:
+            /* Mostly extended so that the session-restricted services get exercised */
+            req->data[0] = (Bench_RandomBelow(4U) != 0U) ? (uint8)DIAG_SESSION_EXTENDED : (uint8)(1U + Bench_RandomBelow(4U));
+            req->length = 1;
+            break;
+
+        case UDS_SID_ECU_RESET:
+            req->data[0] = (uint8)(1U + Bench_RandomBelow(3U));
+            req->length = 1;
+            break;
+
+        case UDS_SID_CLEAR_DIAGNOSTIC_INFORMATION:
+            if (Bench_RandomBelow(16U) == 0U)
+            {
+                req->data[0] = 0xFF;
+                req->data[1] = 0xFF;
+                req->data[2] = 0xFF;
+            }
+            else
+            {
+                uint32 dtc = BENCH_DTC_BASE + Bench_RandomBelow(DIAG_MAX_DTC_COUNT);
+                req->data[0] = (uint8)(dtc >> 16);
+                req->data[1] = (uint8)(dtc >> 8);
+                req->data[2] = (uint8)dtc;
+            }
+            req->length = 3;
+            break;
+
+        case UDS_SID_READ_DTC_INFORMATION:
+            if (Bench_RandomBelow(2U) == 0U)
+            {
+                req->data[0] = 0x02;
+                req->data[1] = (uint8)Bench_Random();
+                req->length = 2;
+            }
+            else
+            {
+                req->data[0] = 0x0A;
+                req->length = 1;
+            }
+            break;
+
+        case UDS_SID_READ_DATA_BY_IDENTIFIER:
+            didCount = (uint16)(1U + Bench_RandomBelow(BENCH_DATA_ID_COUNT));
+            for (i = 0; i < didCount; i++)
+            {
+                Bench_PutUint16(&req->data[2U * i], g_BenchDataIds[Bench_RandomBelow(BENCH_DATA_ID_COUNT)]);
+            }
+            req->length = (uint16)(2U * didCount);
+            break;
+
+        case UDS_SID_WRITE_DATA_BY_IDENTIFIER:
+            Bench_PutUint16(&req->data[0], (uint16)(DID_CALIBRATION_FL_PARAMS + Bench_RandomBelow(WHEEL_MAX)));
+            Bench_PutUint16(&req->data[2], (uint16)(9000U + Bench_RandomBelow(2000U)));  /* Factor 0.9-1.1 */
+            Bench_PutUint16(&req->data[4], 0U);
+            Bench_PutUint16(&req->data[6], 60U);
+            Bench_PutUint16(&req->data[8], 2100U);
+            req->data[10] = 1;
+            req->length = 2U + DID_CALIBRATION_PARAMS_LENGTH;
+            break;
+
+        case UDS_SID_ROUTINE_CONTROL:
+            {
+                static const uint16 routines[] = {
+                    RID_START_CALIBRATION_FL, RID_START_CALIBRATION_RR, RID_VALIDATE_CALIBRATION,
+                    RID_RESET_CALIBRATION_ALL, RID_ABS_SELF_TEST
+                };
+                req->data[0] = 0x01;
+                Bench_PutUint16(&req->data[1], routines[Bench_RandomBelow(sizeof(routines) / sizeof(routines[0]))]);
+                req->data[3] = (uint8)CALIBRATION_METHOD_REFERENCE_BASED;
+                Bench_PutUint16(&req->data[4], 6000U);
+                req->length = 6;
+            }
+            break;
+
+        case UDS_SID_TESTER_PRESENT:
+            req->data[0] = (Bench_RandomBelow(2U) == 0U) ? 0x00U : 0x80U;
+            req->length = 1;
+            break;
+
+        default:
+            req->data[0] = (uint8)Bench_Random();
+            req->length = 1;
+            break;
+    }
+}
+
+/**
+ * @brief Build a random request pool mixing valid, malformed and unsupported requests
+ */
+static void Bench_BuildRequestPool(void)
+{
+    BenchRequest_t* req;
+    uint16 i;
+    uint16 j;
+
+    for (i = 0; i < BENCH_POOL_SIZE; i++)
+    {
+        req = &g_RequestPool[i];
+
+        if (Bench_RandomBelow(100U) < BENCH_FOREIGN_SID_PERCENT)
+        {
+            req->serviceId = (uint8)Bench_Random();
+            req->length = (uint16)Bench_RandomBelow(8U);
+            for (j = 0; j < req->length; j++)
+            {
+                req->data[j] = (uint8)Bench_Random();
+            }
+        }
+        else if (Bench_RandomBelow(100U) < BENCH_VALID_PERCENT)
+        {
+            Bench_BuildValidRequest(req, g_BenchServiceIds[Bench_RandomBelow(BENCH_SERVICE_ID_COUNT)]);
+        }
+        else
+        {
+            /* Known service, valid prefix truncated or padded with garbage */
+            Bench_BuildValidRequest(req, g_BenchServiceIds[Bench_RandomBelow(BENCH_SERVICE_ID_COUNT)]);
+            if ((req->length > 0U) && (Bench_RandomBelow(2U) == 0U))
+            {
+                req->length = (uint16)Bench_RandomBelow(req->length);
+            }
+            else
+            {
+                for (j = 0; j < req->length; j++)
+                {
+                    if (Bench_RandomBelow(4U) == 0U)
+                    {
+                        req->data[j] = (uint8)Bench_Random();
+                    }
+                }
+                if (req->length < BENCH_MAX_REQUEST_LENGTH)
+                {
+                    req->data[req->length] = (uint8)Bench_Random();
+                    req->length++;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Load a tester trace: one request per line as hex bytes (SID first), '#' starts a comment
+ */
+static int Bench_LoadTrace(const char* path)
+{
+    FILE* file = fopen(path, "r");
+    char line[512];
+    char* cursor;
+    char* end;
+    unsigned long value;
+    BenchRequest_t* req;
+    boolean haveSid;
+    int result = 0;
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "Cannot open trace %s\n", path);
+        result = -1;
+    }
+
+    while ((result == 0) && (fgets(line, (int)sizeof(line), file) != NULL))
+    {
+        if (g_TraceRequestCount >= BENCH_MAX_TRACE_REQUESTS)
+        {
+            fprintf(stderr, "Trace truncated to %u requests\n", (unsigned)BENCH_MAX_TRACE_REQUESTS);
+            break;
+        }
+
+        cursor = strchr(line, '#');
+        if (cursor != NULL)
+        {
+            *cursor = '\0';
+        }
+
+        req = &g_TraceRequests[g_TraceRequestCount];
+        req->length = 0;
+        haveSid = FALSE;
+        cursor = line;
+
+        for (;;)
+        {
+            value = strtoul(cursor, &end, 16);
+            if (end == cursor)
+            {
+                break;
+            }
+            if ((value > 0xFFUL) || ((haveSid == TRUE) && (req->length >= BENCH_MAX_REQUEST_LENGTH)))
+            {
+                fprintf(stderr, "Bad trace request in %s: %s\n", path, line);
+                result = -1;
+                break;
+            }
+
+            if (haveSid == FALSE)
+            {
+                req->serviceId = (uint8)value;
+                haveSid = TRUE;
+            }
+            else
+            {
+                req->data[req->length++] = (uint8)value;
+            }
+            cursor = end;
+        }
+
+        if ((result == 0) && (haveSid == TRUE))
+        {
+            g_TraceRequestCount++;
+        }
+    }
+
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Check that a response is a positive or negative response to the request
+ */
+static void Bench_CheckResponse(const BenchRequest_t* req, const uint8* data, uint32 length)
+{
+    BenchServiceStats_t* stats = &g_ServiceStats[req->serviceId];
+
+    if (length == BENCH_NO_RESPONSE)
+    {
+        g_MalformedResponses++;
+    }
+    else if (length == 0U)
+    {
+        if ((req->serviceId == UDS_SID_TESTER_PRESENT) && (req->length == 1U) && (req->data[0] == 0x80U))
+        {
+            stats->suppressed++;
+        }
+        else
+        {
+            g_MalformedResponses++;
+        }
+    }
+    else if ((length == 3U) && (data[0] == 0x7FU) && (data[1] == req->serviceId))
+    {
+        stats->negative++;
+    }
+    else if (data[0] == (uint8)(req->serviceId + 0x40U))
+    {
+        stats->positive++;
+    }
+    else
+    {
+        g_MalformedResponses++;
+    }
+}
+
+/**
+ * @brief Send one request through the service under test
+ * @return Response length (start of the response in g_ResponseBuffer), BENCH_NO_RESPONSE on error
+ */
+static uint32 Bench_Execute(const BenchRequest_t* req)
+{
+    UDSMessage_t request;
+    UDSMessage_t response;
+    IsoTp_TxStream_t stream;
+    uint16 chunk;
+    uint32 result = BENCH_NO_RESPONSE;
+    uint16 drained = 0;
+
+    memset(&request, 0, sizeof(request));
+    request.serviceId = req->serviceId;
+    request.subFunction = (req->length > 0U) ? req->data[0] : 0U;
+    request.requestData = (uint8*)req->data;
+    request.requestDataLength = req->length;
+
+    if (g_StreamMode == TRUE)
+    {
+        memset(&stream, 0, sizeof(stream));
+        if (DiagnosticService_ProcessUDSStream(&request, &stream) == E_OK)
+        {
+            /* Drain the stream the way the transport does, one frame payload at a time */
+            while (drained < stream.totalLength)
+            {
+                chunk = stream.fill(&stream, &g_ResponseBuffer[(drained == 0U) ? 0U : ISOTP_CF_PAYLOAD], ISOTP_CF_PAYLOAD);
+                if (chunk == 0U)
+                {
+                    break;
+                }
+                drained = (uint16)(drained + chunk);
+                stream.position = drained;
+            }
+
+            if (drained == stream.totalLength)
+            {
+                result = drained;
+            }
+        }
+    }
+    else
+    {
+        memset(&response, 0, sizeof(response));
+        response.responseData = g_ResponseBuffer;
+        response.maxResponseLength = DIAG_MAX_RESPONSE_LENGTH;
+
+        if ((DiagnosticService_ProcessUDSRequest(&request, &response) == E_OK) &&
+            (response.responseDataLength <= response.maxResponseLength))
+        {
+            result = response.responseDataLength;
+        }
+    }
+
+    return result;
+}
+
+static int Bench_CompareUint32(const void* a, const void* b)
+{
+    uint32 va = *(const uint32*)a;
+    uint32 vb = *(const uint32*)b;
+
+    return (va > vb) - (va < vb);
+}
+
+/**
+ * @brief Timed pass: latency of every request, recorded per service, and response check
+ */
+static uint32 Bench_RunLatencyPass(const BenchRequest_t* requests, uint32 requestCount, uint32 iterations)
+{
+    uint64_t t0;
+    uint64_t t1;
+    uint32 responseLength;
+    uint32 i;
+
+    if (iterations > BENCH_MAX_SAMPLES)
+    {
+        iterations = BENCH_MAX_SAMPLES;
+    }
+
+    memset(g_ServiceStats, 0, sizeof(g_ServiceStats));
+
+    for (i = 0; i < iterations; i++)
+    {
+        const BenchRequest_t* req = &requests[i % requestCount];
+
+        t0 = Bench_NowNs();
+        responseLength = Bench_Execute(req);
+        t1 = Bench_NowNs();
+
+        g_LatencyNs[i] = (uint32)(((t1 - t0) > 0xFFFFFFFFULL) ? 0xFFFFFFFFULL : (t1 - t0));
+        g_LatencySid[i] = req->serviceId;
+        g_ServiceStats[req->serviceId].count++;
+        Bench_CheckResponse(req, g_ResponseBuffer, responseLength);
+    }
+
+    return iterations;
+}
+
+/**
+ * @brief Throughput pass: back-to-back requests, timed as a whole
+ */
+static double Bench_RunThroughputPass(const BenchRequest_t* requests, uint32 requestCount, uint32 iterations)
+{
+    uint64_t t0;
+    uint64_t t1;
+    uint32 i;
+
+    t0 = Bench_NowNs();
+    for (i = 0; i < iterations; i++)
+    {
+        (void)Bench_Execute(&requests[i % requestCount]);
+    }
+    t1 = Bench_NowNs();
+
+    return (t1 > t0) ? ((double)iterations * 1.0e9) / (double)(t1 - t0) : 0.0;
+}
+
+static uint32 Bench_Percentile(const uint32* sorted, uint32 count, uint32 percent)
+{
+    uint32 rank = (uint32)(((uint64_t)count * percent + 99U) / 100U);
+
+    return sorted[(rank > 0U) ? (rank - 1U) : 0U];
+}
+
+static boolean Bench_IsTableService(uint32 sid)
+{
+    boolean found = FALSE;
+    uint32 i;
+
+    for (i = 0; i < BENCH_SERVICE_ID_COUNT; i++)
+    {
+        if (g_BenchServiceIds[i] == sid)
+        {
+            found = TRUE;
+        }
+    }
+
+    return found;
+}
+
+/**
+ * @brief Print per-service latency; SIDs outside the service table share one row
+ */
+static void Bench_Report(const char* title, uint32 samples, double throughput)
+{
+    BenchServiceStats_t other;
+    const BenchServiceStats_t* stats;
+    uint32 row;
+    uint32 sid;
+    uint32 i;
+    uint32 n;
+    boolean isOther;
+
+    memset(&other, 0, sizeof(other));
+    for (sid = 0; sid < 256U; sid++)
+    {
+        if (Bench_IsTableService(sid) == FALSE)
+        {
+            other.count += g_ServiceStats[sid].count;
+            other.positive += g_ServiceStats[sid].positive;
+            other.negative += g_ServiceStats[sid].negative;
+            other.suppressed += g_ServiceStats[sid].suppressed;
+        }
+    }
+
+    printf("\n%s\n", title);
+    printf("  throughput: %.0f requests/s\n", throughput);
+    printf("  SID    count      p50 ns   p99 ns   max ns   pos/neg/supp\n");
+
+    for (row = 0; row <= BENCH_SERVICE_ID_COUNT; row++)
+    {
+        isOther = (row == BENCH_SERVICE_ID_COUNT) ? TRUE : FALSE;
+        sid = (isOther == TRUE) ? 0U : g_BenchServiceIds[row];
+        stats = (isOther == TRUE) ? &other : &g_ServiceStats[sid];
+
+        if (stats->count == 0U)
+        {
+            continue;
+        }
+
+        n = 0;
+        for (i = 0; i < samples; i++)
+        {
+            if (((isOther == TRUE) && (Bench_IsTableService(g_LatencySid[i]) == FALSE)) ||
+                ((isOther == FALSE) && (g_LatencySid[i] == sid)))
+            {
+                g_SortScratch[n++] = g_LatencyNs[i];
+            }
+        }
+        qsort(g_SortScratch, n, sizeof(uint32), Bench_CompareUint32);
+
+        if (isOther == TRUE)
+        {
+            printf("  other");
+        }
+        else
+        {
+            printf("  0x%02X ", (unsigned)sid);
+        }
+        printf("  %-9lu  %7lu  %7lu  %7lu   %lu/%lu/%lu\n",
+               (unsigned long)n,
+               (unsigned long)Bench_Percentile(g_SortScratch, n, 50U),
+               (unsigned long)Bench_Percentile(g_SortScratch, n, 99U),
+               (unsigned long)g_SortScratch[n - 1U],
+               (unsigned long)stats->positive,
+               (unsigned long)stats->negative,
+               (unsigned long)stats->suppressed);
+    }
+}
+
+/**
+ * @brief Bring up the ECU software and populate the DTC store
+ */
+static void Bench_InitEcu(uint16 dtcCount)
+{
+    uint16 i;
+    uint8 repeat;
+
+    SpeedSensor_Init();
+    CalibrationManager_Init();
+    ABS_MalfunctionDetection_Init();
+    DiagnosticService_Init();
+
+    for (i = 0; i < dtcCount; i++)
+    {
+        /* Every third DTC reported often enough to be confirmed */
+        for (repeat = 0; repeat < (((i % 3U) == 0U) ? 3U : 1U); repeat++)
+        {
+            DiagnosticService_SetDTC(BENCH_DTC_BASE + i, TRUE, (WheelPosition_t)(i % WHEEL_MAX));
+        }
+    }
+}
+
+static void Bench_Usage(const char* program)
+{
+    printf("Usage: %s [-n iterations] [-s seed] [-d dtcs] [-t trace] [-S]\n", program);
+    printf("  -n  requests per pass (default %lu, max %lu)\n", BENCH_DEFAULT_ITERATIONS, BENCH_MAX_SAMPLES);
+    printf("  -s  random seed (default 0x%X)\n", BENCH_DEFAULT_SEED);
+    printf("  -d  DTCs stored before the run (default and max %u)\n", (unsigned)DIAG_MAX_DTC_COUNT);
+    printf("  -t  recorded tester trace to replay (hex bytes per line, SID first)\n");
+    printf("  -S  use the streaming path (DiagnosticService_ProcessUDSStream)\n");
+}
+
+int main(int argc, char** argv)
+{
+    unsigned long iterations = BENCH_DEFAULT_ITERATIONS;
+    unsigned long dtcCount = DIAG_MAX_DTC_COUNT;
+    const char* tracePath = NULL;
+    uint32 samples;
+    double throughput;
+    uint32 heapCalls;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:s:d:t:Sh")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n': iterations = strtoul(optarg, NULL, 0); break;
+            case 's': g_PrngState = (uint32)strtoul(optarg, NULL, 0); break;
+            case 'd': dtcCount = strtoul(optarg, NULL, 0); break;
+            case 't': tracePath = optarg; break;
+            case 'S': g_StreamMode = TRUE; break;
+            default: Bench_Usage(argv[0]); return (opt == 'h') ? 0 : 2;
+        }
+    }
+
+    if ((iterations == 0UL) || (g_PrngState == 0U) || (dtcCount > DIAG_MAX_DTC_COUNT))
+    {
+        Bench_Usage(argv[0]);
+        return 2;
+    }
+    if (iterations > BENCH_MAX_SAMPLES)
+    {
+        iterations = BENCH_MAX_SAMPLES;
+    }
+
+    if ((tracePath != NULL) && (Bench_LoadTrace(tracePath) != 0))
+    {
+        return 2;
+    }
+
+    Bench_InitEcu((uint16)dtcCount);
+    Bench_BuildRequestPool();
+
+    printf("UDS diagnostic service benchmark (%s path)\n", (g_StreamMode == TRUE) ? "streaming" : "request");
+    printf("  %lu requests per pass, %lu DTCs stored, pool of %u random requests\n",
+           iterations, dtcCount, (unsigned)BENCH_POOL_SIZE);
+
+    g_HeapTrapArmed = TRUE;
+
+    if (g_TraceRequestCount > 0U)
+    {
+        throughput = Bench_RunThroughputPass(g_TraceRequests, g_TraceRequestCount, (uint32)iterations);
+        samples = Bench_RunLatencyPass(g_TraceRequests, g_TraceRequestCount, (uint32)iterations);
+        Bench_Report("Recorded tester traffic", samples, throughput);
+    }
+
+    throughput = Bench_RunThroughputPass(g_RequestPool, BENCH_POOL_SIZE, (uint32)iterations);
+    samples = Bench_RunLatencyPass(g_RequestPool, BENCH_POOL_SIZE, (uint32)iterations);
+
+    g_HeapTrapArmed = FALSE;
+    heapCalls = g_HeapCalls;
+
+    Bench_Report("Randomized requests (valid, malformed, unsupported SIDs)", samples, throughput);
+
+    printf("\nHeap calls inside ECU code: %lu\n", (unsigned long)heapCalls);
+    printf("Malformed responses:        %lu\n", (unsigned long)g_MalformedResponses);
+
+    return ((heapCalls == 0U) && (g_MalformedResponses == 0U)) ? 0 : 1;
+}
@@ -0,0 +1,416 @@
+/**
+ * @file isotp_check.c
+ * @brief Host protocol check of the ISO-TP transport
+ * @author Generated for ABS Malfunction Detection System
+ *
+ * Drives IsoTp.c as the tester would: frames are injected through
+ * IsoTp_RxIndication, every IsoTp_MainFunction call is one millisecond, and
+ * the frames handed to IsoTp_CanTransmit are recorded and checked. The
+ * diagnostic service is replaced by an echo service (positive response SID
+ * followed by the request data), so each case controls the response length.
+ * Built with a small receive buffer and a receive block size of 2
+ * (see the isotp-check target). Exits with status 1 on any violation.
+ */
+
+#include "Std_Types.h"
+#include "IsoTp.h"
+#include "DiagnosticService.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define CHECK_MAX_FRAMES        128U
+#define CHECK_RESPONSE_SID      0x40U
+
+/* Frames sent by the transport, with the cycle they were sent in */
+static uint8 g_Sent[CHECK_MAX_FRAMES][ISOTP_FRAME_LENGTH];
+static uint32 g_SentCycle[CHECK_MAX_FRAMES];
+static uint32 g_SentCount;
+static uint32 g_Cycle;
+
+static uint8 g_Response[ISOTP_MAX_MESSAGE_LENGTH];
+static uint32 g_Failures;
+
+/* CAN driver: record every frame */
+Std_ReturnType IsoTp_CanTransmit(const uint8 data[ISOTP_FRAME_LENGTH])
+{
+    if (g_SentCount < CHECK_MAX_FRAMES)
+    {
+        memcpy(g_Sent[g_SentCount], data, ISOTP_FRAME_LENGTH);
+        g_SentCycle[g_SentCount] = g_Cycle;
+    }
+    g_SentCount++;
+
+    return E_OK;
+}
+
+/* Echo service: response SID, then the request data */
+Std_ReturnType DiagnosticService_ProcessUDSStream(const UDSMessage_t* request, IsoTp_TxStream_t* stream)
+{
+    g_Response[0] = (uint8)(request->serviceId + CHECK_RESPONSE_SID);
+    memcpy(&g_Response[1], request->requestData, request->requestDataLength);
+
+    stream->fill = IsoTp_FlatStreamFill;
+    stream->totalLength = (uint16)(request->requestDataLength + 1U);
+    stream->position = 0;
+    stream->flatData = g_Response;
+
+    return E_OK;
+}
+
+static void Check(boolean condition, const char* what)
+{
+    if (condition == FALSE)
+    {
+        printf("    FAILED: %s\n", what);
+        g_Failures++;
+    }
+}
+
+static void Check_Reset(void)
+{
+    (void)IsoTp_Init();
+    g_SentCount = 0;
+    g_Cycle = 0;
+}
+
+static void Check_Run(uint32 cycles)
+{
+    uint32 i;
+
+    for (i = 0; i < cycles; i++)
+    {
+        g_Cycle++;
+        IsoTp_MainFunction();
+    }
+}
+
+static void Check_Receive(const uint8* data, uint8 length)
+{
+    IsoTp_RxIndication(data, length);
+}
+
+static void Check_FlowControl(uint8 flowStatus, uint8 blockSize, uint8 stMin)
+{
+    const uint8 frame[ISOTP_FRAME_LENGTH] = { (uint8)(ISOTP_PCI_FLOW_CONTROL | flowStatus), blockSize, stMin,
+                                              ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE,
+                                              ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE };
+
+    Check_Receive(frame, ISOTP_FRAME_LENGTH);
+}
+
+/* Request pattern: SID 0x22, then byte i = i */
+static void Check_BuildRequest(uint8* request, uint16 length)
+{
+    uint16 i;
+
+    request[0] = 0x22U;
+    for (i = 1; i < length; i++)
+    {
+        request[i] = (uint8)i;
+    }
+}
+
+/* Send a request of more than 7 bytes as FF plus CFs, without waiting for flow control */
+static void Check_SendFirstFrame(const uint8* request, uint16 length)
+{
+    uint8 frame[ISOTP_FRAME_LENGTH];
+
+    frame[0] = (uint8)(ISOTP_PCI_FIRST_FRAME | (uint8)(length >> 8));
+    frame[1] = (uint8)(length & 0xFFU);
+    memcpy(&frame[2], request, ISOTP_FF_PAYLOAD);
+    Check_Receive(frame, ISOTP_FRAME_LENGTH);
+}
+
+static void Check_SendConsecutiveFrame(const uint8* request, uint16 length, uint8 index)
+{
+    uint8 frame[ISOTP_FRAME_LENGTH];
+    uint16 offset = (uint16)(ISOTP_FF_PAYLOAD + ((uint16)(index - 1U) * ISOTP_CF_PAYLOAD));
+    uint16 chunk = (uint16)(length - offset);
+
+    if (chunk > ISOTP_CF_PAYLOAD)
+    {
+        chunk = ISOTP_CF_PAYLOAD;
+    }
+    memset(frame, ISOTP_PADDING_BYTE, sizeof(frame));
+    frame[0] = (uint8)(ISOTP_PCI_CONSECUTIVE_FRAME | (index & 0x0FU));
+    memcpy(&frame[1], &request[offset], chunk);
+    Check_Receive(frame, ISOTP_FRAME_LENGTH);
+}
+
+static boolean Check_IsFlowControl(uint32 frameIdx, uint8 flowStatus)
+{
+    return ((frameIdx < g_SentCount) &&
+            (g_Sent[frameIdx][0] == (uint8)(ISOTP_PCI_FLOW_CONTROL | flowStatus)) &&
+            (g_Sent[frameIdx][1] == ISOTP_RX_BLOCK_SIZE) &&
+            (g_Sent[frameIdx][2] == ISOTP_RX_ST_MIN)) ? TRUE : FALSE;
+}
+
+/* Reassemble a multi-frame response starting at frameIdx and compare it with the echo */
+static boolean Check_Response(uint32 frameIdx, const uint8* request, uint16 length)
+{
+    uint8 response[ISOTP_MAX_MESSAGE_LENGTH];
+    uint16 received;
+    uint16 chunk;
+    uint8 sequence = 1U;
+    boolean ok;
+
+    ok = ((frameIdx < g_SentCount) && ((g_Sent[frameIdx][0] & 0xF0U) == ISOTP_PCI_FIRST_FRAME) &&
+          ((uint16)(((uint16)(g_Sent[frameIdx][0] & 0x0FU) << 8) | g_Sent[frameIdx][1]) == length)) ? TRUE : FALSE;
+    if (ok == TRUE)
+    {
+        memcpy(response, &g_Sent[frameIdx][2], ISOTP_FF_PAYLOAD);
+        received = ISOTP_FF_PAYLOAD;
+        frameIdx++;
+        while ((ok == TRUE) && (received < length))
+        {
+            chunk = (uint16)(length - received);
+            if (chunk > ISOTP_CF_PAYLOAD)
+            {
+                chunk = ISOTP_CF_PAYLOAD;
+            }
+            ok = ((frameIdx < g_SentCount) &&
+                  (g_Sent[frameIdx][0] == (uint8)(ISOTP_PCI_CONSECUTIVE_FRAME | sequence))) ? TRUE : FALSE;
+            if (ok == TRUE)
+            {
+                memcpy(&response[received], &g_Sent[frameIdx][1], chunk);
+                received = (uint16)(received + chunk);
+                sequence = (uint8)((sequence + 1U) & 0x0FU);
+                frameIdx++;
+            }
+        }
+    }
+
+    if (ok == TRUE)
+    {
+        ok = ((response[0] == (uint8)(request[0] + CHECK_RESPONSE_SID)) &&
+              (memcmp(&response[1], &request[1], (size_t)(length - 1U)) == 0)) ? TRUE : FALSE;
+    }
+
+    return ok;
+}
+
+static void Check_SingleFrame(void)
+{
+    const uint8 frame[ISOTP_FRAME_LENGTH] = { 0x03U, 0x22U, 0xF1U, 0x90U, 0xAAU, 0xAAU, 0xAAU, 0xAAU };
+    const uint8 expected[ISOTP_FRAME_LENGTH] = { 0x03U, 0x62U, 0xF1U, 0x90U, ISOTP_PADDING_BYTE,
+                                                 ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE, ISOTP_PADDING_BYTE };
+    IsoTp_Statistics_t stats;
+
+    printf("  single frame request and response\n");
+    Check_Reset();
+    Check_Receive(frame, ISOTP_FRAME_LENGTH);
+    Check_Run(1);
+    (void)IsoTp_GetStatistics(&stats);
+
+    Check((g_SentCount == 1U) && (memcmp(g_Sent[0], expected, ISOTP_FRAME_LENGTH) == 0),
+          "SF response with padding");
+    Check((IsoTp_IsBusy() == FALSE) && (stats.responsesSent == 1U), "transport idle after the response");
+}
+
+static void Check_MultiFrame(void)
+{
+    uint8 request[27];             /* FF + 3 CF */
+    IsoTp_Statistics_t stats;
+
+    printf("  FF + FC + CF request (BS %u) and response\n", (unsigned)ISOTP_RX_BLOCK_SIZE);
+    Check_Reset();
+    Check_BuildRequest(request, sizeof(request));
+
+    Check_SendFirstFrame(request, sizeof(request));
+    Check_Run(1);
+    Check((g_SentCount == 1U) && (Check_IsFlowControl(0, ISOTP_FC_CONTINUE_TO_SEND) == TRUE),
+          "FC continue after the FF");
+
+    /* Two CFs complete a block of the receive block size: another FC follows */
+    Check_SendConsecutiveFrame(request, sizeof(request), 1U);
+    Check_SendConsecutiveFrame(request, sizeof(request), 2U);
+    Check_Run(1);
+    Check((g_SentCount == 2U) && (Check_IsFlowControl(1, ISOTP_FC_CONTINUE_TO_SEND) == TRUE),
+          "FC continue after a full block");
+
+    /* The last CF completes the request; FF of the response goes out, CF wait for the FC */
+    Check_SendConsecutiveFrame(request, sizeof(request), 3U);
+    Check_Run(5);
+    Check((g_SentCount == 3U) && ((g_Sent[2][0] & 0xF0U) == ISOTP_PCI_FIRST_FRAME),
+          "response FF, no CF before the tester's FC");
+
+    Check_FlowControl(ISOTP_FC_CONTINUE_TO_SEND, 0U, 0U);
+    Check_Run(1);
+    Check(Check_Response(2, request, sizeof(request)), "response CFs carry the echoed request");
+    (void)IsoTp_GetStatistics(&stats);
+    Check((IsoTp_IsBusy() == FALSE) && (stats.responsesSent == 1U), "transport idle after the response");
+}
+
+static void Check_BlockSizeStMin(void)
+{
+    uint8 request[50];             /* 50-byte response: FF + 7 CF */
+    uint32 idx;
+    uint32 framesBefore;
+    boolean spaced = TRUE;
+
+    printf("  response with tester BS 3 and STmin 5 ms\n");
+    Check_Reset();
+    Check_BuildRequest(request, sizeof(request));
+    Check_SendFirstFrame(request, sizeof(request));
+    for (idx = 1; idx <= 7U; idx++)
+    {
+        Check_SendConsecutiveFrame(request, sizeof(request), (uint8)idx);
+        if ((idx % ISOTP_RX_BLOCK_SIZE) == 0U)
+        {
+            Check_Run(1);   /* Let the transport take the block before the next one */
+        }
+    }
+    g_SentCount = 0;        /* Only the response from here on */
+    Check_Run(1);
+
+    Check_FlowControl(ISOTP_FC_CONTINUE_TO_SEND, 3U, 5U);
+    Check_Run(30);
+    Check(g_SentCount == 4U, "FF and one block of 3 CF, then wait for the FC");
+    for (idx = 2; idx < g_SentCount; idx++)
+    {
+        if ((g_SentCycle[idx] - g_SentCycle[idx - 1U]) < 5U)
+        {
+            spaced = FALSE;
+        }
+    }
+    Check(spaced, "consecutive frames at least STmin apart");
+
+    framesBefore = g_SentCount;
+    Check_FlowControl(ISOTP_FC_CONTINUE_TO_SEND, 0U, 0U);
+    Check_Run(1);
+    Check(g_SentCount == framesBefore + 4U, "rest of the response after the next FC (BS 0, STmin 0)");
+    Check(Check_Response(0, request, sizeof(request)), "response carries the echoed request");
+    Check(IsoTp_IsBusy() == FALSE, "transport idle after the response");
+}
+
+/* Start a multi-frame response of the given length; returns with its FF as frame 0, sent in cycle 1 */
+static void Check_StartLongResponse(uint8* request, uint16 length)
+{
+    uint8 idx;
+
+    Check_Reset();
+    Check_BuildRequest(request, length);
+    Check_SendFirstFrame(request, length);
+    Check_Run(1);
+    for (idx = 1; ((uint16)ISOTP_FF_PAYLOAD + ((uint16)idx * ISOTP_CF_PAYLOAD)) < length; idx++)
+    {
+        Check_SendConsecutiveFrame(request, length, idx);
+        Check_Run(1);
+    }
+    Check_SendConsecutiveFrame(request, length, idx);
+    g_SentCount = 0;
+    g_Cycle = 0;
+    Check_Run(1);
+}
+
+static void Check_Timeouts(void)
+{
+    uint8 request[20];
+    IsoTp_Statistics_t stats;
+
+    printf("  N_Bs timeout (no FC from the tester)\n");
+    Check_StartLongResponse(request, sizeof(request));
+    Check_Run(ISOTP_N_BS_TIMEOUT_MS - 2U);
+    Check(IsoTp_IsBusy() == TRUE, "still waiting just before N_Bs");
+    Check_Run(2);
+    (void)IsoTp_GetStatistics(&stats);
+    Check((IsoTp_IsBusy() == FALSE) && (stats.txAborted == 1U), "response aborted at N_Bs");
+    Check_FlowControl(ISOTP_FC_CONTINUE_TO_SEND, 0U, 0U);
+    Check_Run(1);
+    Check(g_SentCount == 1U, "late FC is ignored");
+
+    printf("  N_Cr timeout (missing CF)\n");
+    Check_Reset();
+    Check_BuildRequest(request, sizeof(request));
+    Check_SendFirstFrame(request, sizeof(request));
+    Check_SendConsecutiveFrame(request, sizeof(request), 1U);
+    Check_Run(ISOTP_N_CR_TIMEOUT_MS - 1U);
+    Check(IsoTp_IsBusy() == TRUE, "still receiving just before N_Cr");
+    Check_Run(2);
+    (void)IsoTp_GetStatistics(&stats);
+    Check((IsoTp_IsBusy() == FALSE) && (stats.rxAborted == 1U), "reception aborted at N_Cr");
+    g_SentCount = 0;
+    Check_SendConsecutiveFrame(request, sizeof(request), 2U);
+    Check_Run(1);
+    Check(g_SentCount == 0U, "late CF is ignored");
+}
+
+static void Check_WaitFlowControl(void)
+{
+    uint8 request[20];
+    IsoTp_Statistics_t stats;
+
+    printf("  WAIT flow control restarts N_Bs\n");
+    Check_StartLongResponse(request, sizeof(request));
+    Check_Run(ISOTP_N_BS_TIMEOUT_MS - 100U);
+    Check_FlowControl(ISOTP_FC_WAIT, 0U, 0U);
+    Check_Run(ISOTP_N_BS_TIMEOUT_MS - 100U);
+    (void)IsoTp_GetStatistics(&stats);
+    Check((IsoTp_IsBusy() == TRUE) && (stats.txAborted == 0U) && (g_SentCount == 1U),
+          "no abort and no CF while the tester sends WAIT");
+
+    Check_FlowControl(ISOTP_FC_CONTINUE_TO_SEND, 0U, 0U);
+    Check_Run(1);
+    Check(Check_Response(0, request, sizeof(request)), "response completes after CTS");
+
+    printf("  OVERFLOW flow control aborts the response\n");
+    Check_StartLongResponse(request, sizeof(request));
+    Check_FlowControl(ISOTP_FC_OVERFLOW, 0U, 0U);
+    Check_Run(1);
+    (void)IsoTp_GetStatistics(&stats);
+    Check((IsoTp_IsBusy() == FALSE) && (stats.txAborted == 1U) && (g_SentCount == 1U),
+          "response aborted, no CF sent");
+}
+
+static void Check_Overflow(void)
+{
+    uint8 request[ISOTP_RX_BUFFER_LENGTH + 1U];
+    const uint8 frame[ISOTP_FRAME_LENGTH] = { 0x02U, 0x3EU, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U };
+    IsoTp_Statistics_t stats;
+    uint32 idx;
+
+    printf("  request longer than the receive buffer (%u bytes)\n", (unsigned)ISOTP_RX_BUFFER_LENGTH);
+    Check_Reset();
+    Check_BuildRequest(request, sizeof(request));
+    Check_SendFirstFrame(request, sizeof(request));
+    Check_SendConsecutiveFrame(request, sizeof(request), 1U);
+    Check_Run(1);
+    Check((g_SentCount == 1U) && (Check_IsFlowControl(0, ISOTP_FC_OVERFLOW) == TRUE), "FC overflow sent");
+    Check(IsoTp_IsBusy() == FALSE, "no reception started, CF ignored");
+
+    printf("  receive ring overflow (%u frames)\n", (unsigned)ISOTP_RX_RING_FRAMES);
+    Check_Reset();
+    for (idx = 0; idx <= ISOTP_RX_RING_FRAMES; idx++)
+    {
+        Check_Receive(frame, ISOTP_FRAME_LENGTH);
+    }
+    (void)IsoTp_GetStatistics(&stats);
+    Check(stats.rxFramesDropped == 1U, "frame beyond the ring dropped and counted");
+
+    /* Requests arriving while a response is pending are not answered; the ring is drained */
+    Check_Run(1);
+    Check(g_SentCount == 1U, "first queued request answered");
+    for (idx = 0; idx < ISOTP_RX_RING_FRAMES; idx++)
+    {
+        Check_Receive(frame, ISOTP_FRAME_LENGTH);
+    }
+    (void)IsoTp_GetStatistics(&stats);
+    Check(stats.rxFramesDropped == 1U, "ring accepts a full ring of frames again");
+}
+
+int main(void)
+{
+    printf("ISO-TP transport check\n");
+
+    Check_SingleFrame();
+    Check_MultiFrame();
+    Check_BlockSizeStMin();
+    Check_Timeouts();
+    Check_WaitFlowControl();
+    Check_Overflow();
+
+    printf("%s (%lu failed checks)\n", (g_Failures == 0U) ? "PASSED" : "FAILED", (unsigned long)g_Failures);
+
+    return (g_Failures == 0U) ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file abs_replay.c
+ * @brief Replay one recorded wheel-speed trace through the ECU software
+ * @author Generated for ABS Malfunction Detection System
+ *
+ * Writes the event log of replay_engine.c (JSON lines) to stdout or a file and
+ * reports the throughput on stderr.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "replay_engine.h"
+#include "RunnableTiming.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define REPLAY_OUTPUT_BUFFER_SIZE     (1UL << 20)
+
+static double Replay_NowSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+#if defined(RUNNABLE_TIMING)
+/**
+ * @brief Execution time of the replayed runnables
+ *
+ * The replay runs faster than real time, so activation jitter is not meaningful here.
+ */
+static void Replay_PrintRunnableTiming(void)
+{
+    static const char* const names[RUNNABLE_MAX] = {
+        "RE_SpeedSensor_MainCyclic", "RE_ABS_MalfunctionDetection_MainCyclic",
+        "RE_CalibrationManager_MainCyclic", "RE_DiagnosticService_UDSProcessing"
+    };
+    RunnableTiming_Summary_t summary;
+    uint8 runnable;
+
+    for (runnable = 0; runnable < (uint8)RUNNABLE_MAX; runnable++)
+    {
+        if ((RunnableTiming_GetSummary((RunnableId_t)runnable, &summary) == E_OK) && (summary.activations > 0U))
+        {
+            fprintf(stderr, "  %-40s %9lu runs  min %7.2f  avg %7.2f  max %8.2f us  over budget %lu\n",
+                    names[runnable], (unsigned long)summary.activations,
+                    (double)summary.execMinTicks / RUNNABLE_TIMING_TICKS_PER_US,
+                    (double)summary.execAvgTicks / RUNNABLE_TIMING_TICKS_PER_US,
+                    (double)summary.execMaxTicks / RUNNABLE_TIMING_TICKS_PER_US,
+                    (unsigned long)summary.execHistogram[RUNNABLE_TIMING_HISTOGRAM_BINS - 1U]);
+        }
+    }
+}
+#endif
+
+static void Replay_Usage(const char* program)
+{
+    printf("Usage: %s [-i frame-id] [-r resolution] [-o event-log] trace.ctr|trace.asc|trace.blf\n", program);
+    printf("  -i  CAN ID of the wheel-speed frame (default 0x%lX)\n", REPLAY_DEFAULT_FRAME_ID);
+    printf("  -r  km/h per bit of the wheel-speed signals (default %.2f)\n", (double)REPLAY_DEFAULT_RESOLUTION);
+    printf("  -o  event log file, JSON lines (default stdout)\n");
+}
+
+int main(int argc, char** argv)
+{
+    ReplayOptions_t options;
+    ReplayResult_t result;
+    FILE* eventLog;
+    const char* outputPath = NULL;
+    double startTime;
+    double elapsed;
+    int opt;
+
+    Replay_DefaultOptions(&options);
+
+    while ((opt = getopt(argc, argv, "i:r:o:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'i': options.frameId = (uint32)strtoul(optarg, NULL, 0); break;
+            case 'r': options.resolution = (float32)strtod(optarg, NULL); break;
+            case 'o': outputPath = optarg; break;
+            default: Replay_Usage(argv[0]); return (opt == 'h') ? 0 : 2;
+        }
+    }
+
+    if ((optind != (argc - 1)) || (options.resolution <= 0.0f))
+    {
+        Replay_Usage(argv[0]);
+        return 2;
+    }
+
+    eventLog = (outputPath != NULL) ? fopen(outputPath, "w") : stdout;
+    if (eventLog == NULL)
+    {
+        fprintf(stderr, "Cannot create %s\n", outputPath);
+        return 2;
+    }
+    setvbuf(eventLog, NULL, _IOFBF, REPLAY_OUTPUT_BUFFER_SIZE);
+
+    startTime = Replay_NowSeconds();
+    (void)Replay_RunTrace(argv[optind], &options, eventLog, &result);
+    elapsed = Replay_NowSeconds() - startTime;
+
+    if (eventLog != stdout)
+    {
+        fclose(eventLog);
+    }
+    else
+    {
+        fflush(eventLog);
+    }
+
+    if (result.status == REPLAY_STATUS_OK)
+    {
+        fprintf(stderr, "Replayed %llu frames, %.1f s of trace in %.3f s (%.0f frames/s, %.0fx real time)\n",
+                (unsigned long long)result.frames, (double)result.simMs / 1000.0, elapsed,
+                (elapsed > 0.0) ? ((double)result.frames / elapsed) : 0.0,
+                (elapsed > 0.0) ? ((double)result.simMs / 1000.0 / elapsed) : 0.0);
+#if defined(RUNNABLE_TIMING)
+        Replay_PrintRunnableTiming();
+#endif
+    }
+
+    return (int)result.status;
+}
@@ -0,0 +1,518 @@
+/**
+ * @file fleet_replay.c
+ * @brief Parallel replay of a directory of wheel-speed traces with work stealing
+ * @author Generated for ABS Malfunction Detection System
+ *
+ * The ECU modules keep their state in file-scope variables, so every worker is a
+ * forked process with its own SpeedSensor / ABS / Calibration / Diagnostic
+ * instance. The traces are dealt out largest first to per-worker queues of
+ * balanced total size; a worker takes from the front of its own queue and, once
+ * it is empty, steals from the back of the other queues. Queues and per-trace
+ * results live in shared memory; the parent merges the results in trace order,
+ * so the report does not depend on the number of workers or the scheduling.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE         /* MAP_ANONYMOUS */
+
+#include "replay_engine.h"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define FLEET_MAX_WORKERS             256U
+#define FLEET_MAX_PATH_LENGTH         4096U
+#define FLEET_QUEUE_EMPTY             0xFFFFFFFFUL
+
+/* Trace found in the input directory */
+typedef struct {
+    char* path;
+    const char* name;
+    uint64 size;
+} FleetTrace_t;
+
+/* Work queue of one worker: trace slots [head, tail) of g_Order, packed for CAS */
+typedef struct {
+    volatile uint64 range;      /* Head in bits 0-31, tail in bits 32-63 */
+    uint64 load;                /* Bytes dealt to this worker */
+    uint32 completed;
+    uint32 stolen;
+    uint8 padding[40];          /* One cache line per queue */
+} FleetQueue_t;
+
+/* Shared between parent and workers */
+typedef struct {
+    FleetQueue_t queue[FLEET_MAX_WORKERS];
+    ReplayResult_t result[];    /* Indexed like g_Traces */
+} FleetShared_t;
+
+static FleetTrace_t* g_Traces;
+static uint32 g_TraceCount;
+static uint32* g_Order;         /* Trace indices, grouped by worker queue */
+static FleetShared_t* g_Shared;
+static uint32 g_WorkerCount;
+static ReplayOptions_t g_Options;
+static const char* g_EventDir;
+
+static int Fleet_IsTrace(const char* name)
+{
+    const char* extension = strrchr(name, '.');
+
+    return (extension != NULL) &&
+           ((strcmp(extension, ".ctr") == 0) || (strcmp(extension, ".asc") == 0) || (strcmp(extension, ".blf") == 0));
+}
+
+static int Fleet_CompareName(const void* a, const void* b)
+{
+    return strcmp(((const FleetTrace_t*)a)->name, ((const FleetTrace_t*)b)->name);
+}
+
+static int Fleet_CompareSize(const void* a, const void* b)
+{
+    const FleetTrace_t* traceA = &g_Traces[*(const uint32*)a];
+    const FleetTrace_t* traceB = &g_Traces[*(const uint32*)b];
+    int retVal = 0;
+
+    if (traceA->size != traceB->size)
+    {
+        retVal = (traceA->size > traceB->size) ? -1 : 1;
+    }
+    else
+    {
+        retVal = strcmp(traceA->name, traceB->name);
+    }
+
+    return retVal;
+}
+
+/**
+ * @brief Collect the traces of a directory, sorted by name; returns 0 on success
+ */
+static int Fleet_ScanDirectory(const char* directory)
+{
+    DIR* dir = opendir(directory);
+    struct dirent* entry;
+    struct stat st;
+    FleetTrace_t* grown;
+    uint32 capacity = 0;
+    size_t length;
+
+    if (dir == NULL)
+    {
+        fprintf(stderr, "Cannot open directory %s\n", directory);
+        return -1;
+    }
+
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if (Fleet_IsTrace(entry->d_name) == 0)
+        {
+            continue;
+        }
+        if (g_TraceCount == capacity)
+        {
+            capacity = (capacity == 0U) ? 256U : (capacity * 2U);
+            grown = (FleetTrace_t*)realloc(g_Traces, capacity * sizeof(FleetTrace_t));
+            if (grown == NULL)
+            {
+                closedir(dir);
+                return -1;
+            }
+            g_Traces = grown;
+        }
+
+        length = strlen(directory) + strlen(entry->d_name) + 2U;
+        g_Traces[g_TraceCount].path = (char*)malloc(length);
+        if (g_Traces[g_TraceCount].path == NULL)
+        {
+            closedir(dir);
+            return -1;
+        }
+        snprintf(g_Traces[g_TraceCount].path, length, "%s/%s", directory, entry->d_name);
+        g_Traces[g_TraceCount].name = g_Traces[g_TraceCount].path + strlen(directory) + 1U;
+        g_Traces[g_TraceCount].size = (stat(g_Traces[g_TraceCount].path, &st) == 0) ? (uint64)st.st_size : 0U;
+        if (S_ISREG(st.st_mode))
+        {
+            g_TraceCount++;
+        }
+        else
+        {
+            free(g_Traces[g_TraceCount].path);
+        }
+    }
+
+    closedir(dir);
+    qsort(g_Traces, g_TraceCount, sizeof(FleetTrace_t), Fleet_CompareName);
+    return 0;
+}
+
+/**
+ * @brief Deal the traces, largest first, to the worker with the least bytes so far
+ *
+ * Each worker's traces end up contiguous in g_Order, largest first, so a worker
+ * starts on its big traces and thieves take the small ones from the back.
+ */
+static int Fleet_BuildQueues(void)
+{
+    uint32* sorted = (uint32*)malloc(((size_t)g_TraceCount + 1U) * sizeof(uint32));
+    uint32* owner = (uint32*)malloc(((size_t)g_TraceCount + 1U) * sizeof(uint32));
+    uint32 count[FLEET_MAX_WORKERS];
+    uint32 next[FLEET_MAX_WORKERS];
+    uint32 i;
+    uint32 w;
+    uint32 best;
+    uint32 start = 0;
+
+    g_Order = (uint32*)malloc(((size_t)g_TraceCount + 1U) * sizeof(uint32));
+    if ((sorted == NULL) || (owner == NULL) || (g_Order == NULL))
+    {
+        free(sorted);
+        free(owner);
+        return -1;
+    }
+
+    for (i = 0; i < g_TraceCount; i++)
+    {
+        sorted[i] = i;
+    }
+    qsort(sorted, g_TraceCount, sizeof(uint32), Fleet_CompareSize);
+
+    memset(count, 0, sizeof(count));
+    for (i = 0; i < g_TraceCount; i++)
+    {
+        best = 0;
+        for (w = 1; w < g_WorkerCount; w++)
+        {
+            if (g_Shared->queue[w].load < g_Shared->queue[best].load)
+            {
+                best = w;
+            }
+        }
+        owner[i] = best;
+        g_Shared->queue[best].load += g_Traces[sorted[i]].size + 1U;
+        count[best]++;
+    }
+
+    for (w = 0; w < g_WorkerCount; w++)
+    {
+        next[w] = start;
+        g_Shared->queue[w].range = (uint64)start | ((uint64)(start + count[w]) << 32);
+        start += count[w];
+    }
+    for (i = 0; i < g_TraceCount; i++)
+    {
+        g_Order[next[owner[i]]] = sorted[i];
+        next[owner[i]]++;
+    }
+
+    free(sorted);
+    free(owner);
+    return 0;
+}
+
+/**
+ * @brief Take a slot from the front (own queue) or the back (stealing); FLEET_QUEUE_EMPTY if none
+ */
+static uint32 Fleet_Take(FleetQueue_t* queue, int fromBack)
+{
+    uint64 range = __atomic_load_n(&queue->range, __ATOMIC_ACQUIRE);
+    uint64 updated;
+    uint32 head;
+    uint32 tail;
+    uint32 slot = FLEET_QUEUE_EMPTY;
+
+    for (;;)
+    {
+        head = (uint32)(range & 0xFFFFFFFFULL);
+        tail = (uint32)(range >> 32);   /* uint32 is a long, so mask explicitly */
+        if (head >= tail)
+        {
+            break;
+        }
+        if (fromBack != 0)
+        {
+            updated = (uint64)head | ((uint64)(tail - 1U) << 32);
+        }
+        else
+        {
+            updated = (uint64)(head + 1U) | ((uint64)tail << 32);
+        }
+        if (__atomic_compare_exchange_n(&queue->range, &range, updated, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            slot = (fromBack != 0) ? (tail - 1U) : head;
+            break;
+        }
+    }
+
+    return slot;
+}
+
+/**
+ * @brief Replay one trace into its result slot (and event log file, if requested)
+ */
+static void Fleet_ReplayTrace(uint32 traceIdx)
+{
+    char logPath[FLEET_MAX_PATH_LENGTH];
+    FILE* eventLog = NULL;
+
+    if (g_EventDir != NULL)
+    {
+        snprintf(logPath, sizeof(logPath), "%s/%s.events.jsonl", g_EventDir, g_Traces[traceIdx].name);
+        eventLog = fopen(logPath, "w");
+        if (eventLog == NULL)
+        {
+            fprintf(stderr, "Cannot create %s\n", logPath);
+        }
+    }
+
+    (void)Replay_RunTrace(g_Traces[traceIdx].path, &g_Options, eventLog, &g_Shared->result[traceIdx]);
+
+    if (eventLog != NULL)
+    {
+        fclose(eventLog);
+    }
+}
+
+static void Fleet_Worker(uint32 worker)
+{
+    FleetQueue_t* own = &g_Shared->queue[worker];
+    uint32 slot;
+    uint32 victim;
+    uint32 offset;
+
+    for (;;)
+    {
+        slot = Fleet_Take(own, 0);
+        for (offset = 1; (slot == FLEET_QUEUE_EMPTY) && (offset < g_WorkerCount); offset++)
+        {
+            victim = (worker + offset) % g_WorkerCount;
+            slot = Fleet_Take(&g_Shared->queue[victim], 1);
+            if (slot != FLEET_QUEUE_EMPTY)
+            {
+                own->stolen++;
+            }
+        }
+        if (slot == FLEET_QUEUE_EMPTY)
+        {
+            break;
+        }
+
+        Fleet_ReplayTrace(g_Order[slot]);
+        own->completed++;
+    }
+}
+
+/**
+ * @brief Write one line per trace and the fleet summary; returns the number of failed traces
+ */
+static uint32 Fleet_Report(FILE* report)
+{
+    static const char* const statusNames[] = { "ok", "read_error", "open_error" };
+    uint32 dtcCodes[DIAG_MAX_DTC_COUNT * 4U];
+    uint32 dtcTraces[DIAG_MAX_DTC_COUNT * 4U];
+    uint32 dtcDistinct = 0;
+    uint64 totalFrames = 0;
+    uint64 totalSimMs = 0;
+    uint64 totalMalfunctionEvents = 0;
+    uint32 tracesWithDtc = 0;
+    uint32 failed = 0;
+    const ReplayResult_t* result;
+    uint32 i;
+    uint8 d;
+    uint32 k;
+
+    for (i = 0; i < g_TraceCount; i++)
+    {
+        result = &g_Shared->result[i];
+        fprintf(report, "{\"trace\":\"%s\",\"status\":\"%s\",\"frames\":%llu,\"sim_ms\":%llu,"
+                        "\"malfunction_events\":%llu,\"dtc_events\":%llu,\"confirmed_wheels\":%u,"
+                        "\"final_state\":\"%s\",\"active_dtcs\":[",
+                g_Traces[i].name, statusNames[result->status], (unsigned long long)result->frames,
+                (unsigned long long)result->simMs, (unsigned long long)result->malfunctionEvents,
+                (unsigned long long)result->dtcEvents, (unsigned)result->confirmedMask,
+                Replay_SystemStateName(result->finalState));
+        for (d = 0; d < result->activeDtcCount; d++)
+        {
+            fprintf(report, "%s\"0x%06lX\"", (d > 0U) ? "," : "", (unsigned long)result->activeDtcs[d]);
+
+            for (k = 0; (k < dtcDistinct) && (dtcCodes[k] != result->activeDtcs[d]); k++)
+            {
+            }
+            if (k == dtcDistinct)
+            {
+                if (dtcDistinct == (sizeof(dtcCodes) / sizeof(dtcCodes[0])))
+                {
+                    continue;
+                }
+                dtcCodes[k] = result->activeDtcs[d];
+                dtcTraces[k] = 0;
+                dtcDistinct++;
+            }
+            dtcTraces[k]++;
+        }
+        fprintf(report, "]}\n");
+
+        failed += (result->status != REPLAY_STATUS_OK) ? 1U : 0U;
+        tracesWithDtc += (result->activeDtcCount > 0U) ? 1U : 0U;
+        totalFrames += result->frames;
+        totalSimMs += result->simMs;
+        totalMalfunctionEvents += result->malfunctionEvents;
+    }
+
+    fprintf(report, "{\"event\":\"fleet_summary\",\"traces\":%lu,\"failed\":%lu,\"frames\":%llu,\"sim_hours\":%.3f,"
+                    "\"malfunction_events\":%llu,\"traces_with_dtc\":%lu,\"dtc_traces\":{",
+            (unsigned long)g_TraceCount, (unsigned long)failed, (unsigned long long)totalFrames,
+            (double)totalSimMs / 3600000.0, (unsigned long long)totalMalfunctionEvents,
+            (unsigned long)tracesWithDtc);
+    for (k = 0; k < dtcDistinct; k++)
+    {
+        fprintf(report, "%s\"0x%06lX\":%lu", (k > 0U) ? "," : "", (unsigned long)dtcCodes[k],
+                (unsigned long)dtcTraces[k]);
+    }
+    fprintf(report, "}}\n");
+
+    return failed;
+}
+
+static double Fleet_NowSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+static void Fleet_Usage(const char* program)
+{
+    printf("Usage: %s [-j workers] [-i frame-id] [-r resolution] [-e event-dir] [-o report] trace-dir\n", program);
+    printf("  -j  worker processes (default: online CPUs, max %u)\n", (unsigned)FLEET_MAX_WORKERS);
+    printf("  -i  CAN ID of the wheel-speed frame (default 0x%lX)\n", REPLAY_DEFAULT_FRAME_ID);
+    printf("  -r  km/h per bit of the wheel-speed signals (default %.2f)\n", (double)REPLAY_DEFAULT_RESOLUTION);
+    printf("  -e  write <trace>.events.jsonl per trace into this directory\n");
+    printf("  -o  summary report file, JSON lines (default stdout)\n");
+}
+
+int main(int argc, char** argv)
+{
+    const char* reportPath = NULL;
+    FILE* report;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned long workers = (cpus > 0) ? (unsigned long)cpus : 1UL;
+    size_t sharedSize;
+    double startTime;
+    double elapsed;
+    uint64 totalSimMs = 0;
+    uint32 failed;
+    uint32 w;
+    uint32 i;
+    pid_t pid;
+    int status;
+    int opt;
+
+    Replay_DefaultOptions(&g_Options);
+
+    while ((opt = getopt(argc, argv, "j:i:r:e:o:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'j': workers = strtoul(optarg, NULL, 0); break;
+            case 'i': g_Options.frameId = (uint32)strtoul(optarg, NULL, 0); break;
+            case 'r': g_Options.resolution = (float32)strtod(optarg, NULL); break;
+            case 'e': g_EventDir = optarg; break;
+            case 'o': reportPath = optarg; break;
+            default: Fleet_Usage(argv[0]); return (opt == 'h') ? 0 : 2;
+        }
+    }
+
+    if ((optind != (argc - 1)) || (workers == 0UL) || (g_Options.resolution <= 0.0f))
+    {
+        Fleet_Usage(argv[0]);
+        return 2;
+    }
+    if (workers > FLEET_MAX_WORKERS)
+    {
+        workers = FLEET_MAX_WORKERS;
+    }
+
+    if (Fleet_ScanDirectory(argv[optind]) != 0)
+    {
+        return 2;
+    }
+    g_WorkerCount = ((uint32)workers < g_TraceCount) ? (uint32)workers : ((g_TraceCount > 0U) ? g_TraceCount : 1U);
+
+    sharedSize = sizeof(FleetShared_t) + ((size_t)g_TraceCount * sizeof(ReplayResult_t));
+    g_Shared = (FleetShared_t*)mmap(NULL, sharedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if ((g_Shared == (FleetShared_t*)MAP_FAILED) || (Fleet_BuildQueues() != 0))
+    {
+        fprintf(stderr, "Out of memory\n");
+        return 2;
+    }
+    for (i = 0; i < g_TraceCount; i++)
+    {
+        g_Shared->result[i].status = REPLAY_STATUS_OPEN_ERROR;  /* Until a worker reports */
+    }
+
+    report = (reportPath != NULL) ? fopen(reportPath, "w") : stdout;
+    if (report == NULL)
+    {
+        fprintf(stderr, "Cannot create %s\n", reportPath);
+        return 2;
+    }
+    fflush(stdout);
+
+    startTime = Fleet_NowSeconds();
+    for (w = 0; w < g_WorkerCount; w++)
+    {
+        pid = fork();
+        if (pid == 0)
+        {
+            Fleet_Worker(w);
+            _exit(0);
+        }
+        else if (pid < 0)
+        {
+            /* Remaining queues are stolen by the workers already running */
+            fprintf(stderr, "fork failed, continuing with %lu workers\n", (unsigned long)w);
+            break;
+        }
+    }
+    if (w == 0U)
+    {
+        Fleet_Worker(0);
+    }
+    while (wait(&status) > 0)
+    {
+    }
+    elapsed = Fleet_NowSeconds() - startTime;
+
+    failed = Fleet_Report(report);
+    if (report != stdout)
+    {
+        fclose(report);
+    }
+    else
+    {
+        fflush(report);
+    }
+
+    for (i = 0; i < g_TraceCount; i++)
+    {
+        totalSimMs += g_Shared->result[i].simMs;
+    }
+    fprintf(stderr, "Replayed %lu traces (%.1f h of trace) with %lu workers in %.3f s (%.0fx real time)\n",
+            (unsigned long)g_TraceCount, (double)totalSimMs / 3600000.0, (unsigned long)g_WorkerCount, elapsed,
+            (elapsed > 0.0) ? ((double)totalSimMs / 1000.0 / elapsed) : 0.0);
+    for (w = 0; w < g_WorkerCount; w++)
+    {
+        fprintf(stderr, "  worker %lu: %lu traces, %lu stolen\n", (unsigned long)w,
+                (unsigned long)g_Shared->queue[w].completed, (unsigned long)g_Shared->queue[w].stolen);
+    }
+
+    return (failed > 0U) ? 1 : 0;
+}
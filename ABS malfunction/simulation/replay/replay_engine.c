@@ -0,0 +1,524 @@
+/**
+ * @file replay_engine.c
+ * @brief Headless replay of recorded wheel-speed traces through the ECU software
+ * @author Generated for ABS Malfunction Detection System
+ *
+ * Reads CAN frames from a .ctr trace (day1can/cantrace, memory-mapped), a Vector
+ * ASCII log (.asc) or the simplified BLF log written by
+ * day1can/vector_integration.py, decodes the wheel-speed frame and
+ * runs SpeedSensor -> ABS_MalfunctionDetection -> DiagnosticService on the
+ * trace time base, as fast as the host allows (no sleeps, no per-cycle output).
+ *
+ * Every confirmed malfunction change, DTC change and ABS system state change is
+ * written as one JSON object per line, followed by a summary line. The log only
+ * depends on the trace and the options, so two runs can be compared with diff.
+ *
+ * The ECU modules keep their state in file-scope variables, as on the target, so
+ * one process replays one trace at a time; every trace starts from a fresh ECU.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "replay_engine.h"
+#include "SpeedSensor_Interface.h"
+#include "CalibrationManager.h"
+#include "RunnableTiming.h"
+#include "rte_host_stubs.h"
+#include "cantrace.h"
+
+#include <stdarg.h>
+#include <string.h>
+
+#define REPLAY_SIGNAL_NOT_AVAILABLE   0xFFFFU  /* Wheel-speed signal value "not available" */
+#define REPLAY_SIGNAL_TIMEOUT_MS      100U     /* Older wheel speeds are reported invalid */
+#define REPLAY_PULSE_WINDOW_MS        16384U   /* Measurement window of the emulated pulse counter */
+#define REPLAY_ABS_CYCLE_TICKS        (ABS_DETECTION_CYCLE_MS / SPEED_SENSOR_SAMPLE_RATE_MS)
+#define REPLAY_MAX_LINE_LENGTH        512U
+
+#define REPLAY_BLF_SIGNATURE          "LOGG"
+#define REPLAY_BLF_HEADER_SIZE        20U      /* Signature + 4 x uint32 */
+#define REPLAY_BLF_RECORD_SIZE        21U      /* uint64 ns, uint32 ID, uint8 DLC, 8 data bytes */
+
+/* Trace file formats */
+typedef enum {
+    REPLAY_FORMAT_ASC = 0,
+    REPLAY_FORMAT_BLF = 1,
+    REPLAY_FORMAT_CTR = 2
+} ReplayFormat_t;
+
+/* Trace reader; frames returned by Replay_NextFrame point into it (or into the mapped .ctr file) */
+typedef struct {
+    ReplayFormat_t format;
+    FILE* file;
+    int decimalIds;             /* ASC "base dec" */
+    uint32 lineNumber;
+    uint8 record[REPLAY_BLF_RECORD_SIZE];
+    uint8 payload[CANTRACE_MAX_DLC];
+    CanTrace_File_t trace;
+    CanTrace_Cursor_t cursor;
+} ReplayReader_t;
+
+/* Latest decoded wheel speed */
+typedef struct {
+    float32 speed;              /* km/h */
+    uint64 updateTimeMs;
+    boolean available;
+} ReplayWheelSignal_t;
+
+static const char* const g_WheelNames[WHEEL_MAX] = { "FL", "FR", "RL", "RR" };
+
+static const char* const g_MalfunctionNames[] = {
+    "NONE", "SPEED_SENSOR_MISCALIBRATION", "SPEED_SENSOR_FAILURE", "WHEEL_SLIP_EXCESSIVE",
+    "SPEED_DIFFERENCE_EXCESSIVE", "ACCELERATION_IMPLAUSIBLE", "CALIBRATION_DRIFT", "SYSTEM_ERROR"
+};
+
+static const char* const g_SystemStateNames[] = {
+    "INACTIVE", "MONITORING", "INTERVENTION", "MALFUNCTION", "DEGRADED"
+};
+
+static ReplayWheelSignal_t g_WheelSignal[WHEEL_MAX];
+static float32 g_PulseScale[WHEEL_MAX];         /* km/h per (pulse/ms) of the emulated sensor */
+static uint8 g_SeenStatusChange[WHEEL_MAX];
+static ReplayOptions_t g_Options;
+static ReplayResult_t* g_Result;
+static FILE* g_EventLog;                        /* NULL: count events only */
+
+/**
+ * @brief Write one line to the event log, if there is one
+ */
+static void Replay_LogEvent(const char* format, ...)
+{
+    va_list args;
+
+    if (g_EventLog != NULL)
+    {
+        va_start(args, format);
+        (void)vfprintf(g_EventLog, format, args);
+        va_end(args);
+    }
+}
+
+/**
+ * @brief Open a trace and check its header
+ */
+static int Replay_Open(ReplayReader_t* reader, const char* path, ReplayFormat_t format)
+{
+    uint8 header[REPLAY_BLF_HEADER_SIZE];
+    int retVal = 0;
+
+    memset(reader, 0, sizeof(*reader));
+    reader->format = format;
+    if (format == REPLAY_FORMAT_CTR)
+    {
+        if (CanTrace_Open(&reader->trace, path) != 0)
+        {
+            fprintf(stderr, "%s: not a readable .ctr trace\n", path);
+            retVal = -1;
+        }
+        else
+        {
+            CanTrace_Rewind(&reader->cursor, &reader->trace);
+        }
+        return retVal;
+    }
+
+    reader->file = fopen(path, (format == REPLAY_FORMAT_BLF) ? "rb" : "r");
+    if (reader->file == NULL)
+    {
+        fprintf(stderr, "Cannot open trace %s\n", path);
+        retVal = -1;
+    }
+    else if ((format == REPLAY_FORMAT_BLF) &&
+             ((fread(header, 1, sizeof(header), reader->file) != sizeof(header)) ||
+              (memcmp(header, REPLAY_BLF_SIGNATURE, 4) != 0)))
+    {
+        fprintf(stderr, "%s: not a BLF log\n", path);
+        fclose(reader->file);
+        retVal = -1;
+    }
+
+    return retVal;
+}
+
+/**
+ * @brief Close a trace
+ */
+static void Replay_Close(ReplayReader_t* reader)
+{
+    if (reader->format == REPLAY_FORMAT_CTR)
+    {
+        CanTrace_Close(&reader->trace);
+    }
+    else
+    {
+        fclose(reader->file);
+    }
+}
+
+/**
+ * @brief Read the next CAN frame; returns 1 for a frame, 0 at the end of the trace, -1 on error
+ */
+static int Replay_NextFrame(ReplayReader_t* reader, CanTrace_Frame_t* frame)
+{
+    char line[REPLAY_MAX_LINE_LENGTH];
+    uint8* record = reader->record;
+    size_t length;
+    uint32 i;
+    int retVal = 0;
+
+    if (reader->format == REPLAY_FORMAT_CTR)
+    {
+        retVal = CanTrace_Next(&reader->cursor, frame);
+    }
+    else if (reader->format == REPLAY_FORMAT_BLF)
+    {
+        length = fread(record, 1, REPLAY_BLF_RECORD_SIZE, reader->file);
+        if (length == REPLAY_BLF_RECORD_SIZE)
+        {
+            frame->timestampUs = 0;
+            for (i = 0; i < 8U; i++)
+            {
+                frame->timestampUs |= (uint64)record[i] << (8U * i);
+            }
+            frame->timestampUs /= 1000U;
+            frame->canId = (uint32)record[8] | ((uint32)record[9] << 8) |
+                           ((uint32)record[10] << 16) | ((uint32)record[11] << 24);
+            frame->dlc = (record[12] <= CANTRACE_MAX_DLC) ? record[12] : CANTRACE_MAX_DLC;
+            frame->data = &record[13];
+            retVal = 1;
+        }
+        else if (length != 0U)
+        {
+            fprintf(stderr, "Truncated BLF record\n");
+            retVal = -1;
+        }
+    }
+    else
+    {
+        while ((retVal == 0) && (fgets(line, sizeof(line), reader->file) != NULL))
+        {
+            reader->lineNumber++;
+            retVal = CanTrace_ParseAscLine(line, &reader->decimalIds, frame, reader->payload);
+        }
+    }
+
+    return retVal;
+}
+
+/**
+ * @brief Decode the wheel-speed frame: FL, FR, RL, RR as 16-bit little-endian signals
+ *
+ * Wheels beyond the frame length and signals set to "not available" are not updated,
+ * so they time out.
+ */
+static void Replay_DecodeWheelFrame(const CanTrace_Frame_t* frame)
+{
+    uint64 timeMs = frame->timestampUs / 1000U;
+    uint16 raw;
+    uint8 wheelIdx;
+
+    for (wheelIdx = 0; (wheelIdx < WHEEL_MAX) && ((2U * wheelIdx) + 1U < frame->dlc); wheelIdx++)
+    {
+        raw = (uint16)(frame->data[2U * wheelIdx] | ((uint16)frame->data[(2U * wheelIdx) + 1U] << 8));
+        if (raw != REPLAY_SIGNAL_NOT_AVAILABLE)
+        {
+            g_WheelSignal[wheelIdx].speed = (float32)raw * g_Options.resolution;
+            g_WheelSignal[wheelIdx].updateTimeMs = timeMs;
+            g_WheelSignal[wheelIdx].available = TRUE;
+        }
+    }
+}
+
+/**
+ * @brief Present the current wheel speeds to the speed sensor SWC as pulse counts
+ *
+ * The emulated sensor front end counts pulses over REPLAY_PULSE_WINDOW_MS, which
+ * resolves the speed to about 0.01 km/h with the default wheel calibration.
+ */
+static void Replay_FeedSensors(uint64 nowMs)
+{
+    SpeedSensorRawData_t rawData;
+    float32 pulses;
+    uint8 wheelIdx;
+
+    for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+    {
+        if ((g_WheelSignal[wheelIdx].available == TRUE) &&
+            ((nowMs - g_WheelSignal[wheelIdx].updateTimeMs) <= REPLAY_SIGNAL_TIMEOUT_MS))
+        {
+            pulses = (g_WheelSignal[wheelIdx].speed * (float32)REPLAY_PULSE_WINDOW_MS / g_PulseScale[wheelIdx]) + 0.5f;
+            rawData.pulseCount = (pulses < 65535.0f) ? (uint16)pulses : 65535U;
+            rawData.timeInterval = REPLAY_PULSE_WINDOW_MS;
+            rawData.status = SENSOR_STATUS_OK;
+            rawData.dataValid = TRUE;
+        }
+        else
+        {
+            /* No measurement: the speed sensor SWC restarts its acceleration filter */
+            rawData.pulseCount = 0;
+            rawData.timeInterval = 0;
+            rawData.status = SENSOR_STATUS_INVALID;
+            rawData.dataValid = FALSE;
+        }
+        HostStub_SetRawData((WheelPosition_t)wheelIdx, &rawData);
+    }
+}
+
+/**
+ * @brief Run one ABS detection cycle and the DTC manager on the current speed data
+ */
+static void Replay_RunDetectionCycle(void)
+{
+    ABS_VehicleData_t vehicleData;
+    uint8 wheelIdx;
+
+    memset(&vehicleData, 0, sizeof(vehicleData));
+    for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+    {
+        (void)SpeedSensor_GetSpeedData((WheelPosition_t)wheelIdx, &vehicleData.wheelSpeeds[wheelIdx]);
+    }
+
+    (void)ABS_UpdateVehicleData(&vehicleData);
+    RE_ABS_MalfunctionDetection_MainCyclic();
+    RE_DiagnosticService_DTCManager();
+}
+
+/**
+ * @brief Write DTCs that became active or left the active list since the last check
+ */
+static void Replay_LogDtcChanges(uint64 nowMs)
+{
+    uint32 dtcList[DIAG_MAX_DTC_COUNT];
+    uint8 dtcCount = 0;
+    uint8 i;
+    uint8 j;
+    boolean found;
+
+    if (DiagnosticService_GetActiveDTCs(dtcList, &dtcCount, (uint8)DIAG_MAX_DTC_COUNT) == E_OK)
+    {
+        for (i = 0; i < dtcCount; i++)
+        {
+            found = FALSE;
+            for (j = 0; j < g_Result->activeDtcCount; j++)
+            {
+                found = (g_Result->activeDtcs[j] == dtcList[i]) ? TRUE : found;
+            }
+            if (found == FALSE)
+            {
+                Replay_LogEvent("{\"t_ms\":%llu,\"event\":\"dtc\",\"dtc\":\"0x%06lX\",\"active\":true}\n",
+                                (unsigned long long)nowMs, (unsigned long)dtcList[i]);
+                g_Result->dtcEvents++;
+            }
+        }
+        for (j = 0; j < g_Result->activeDtcCount; j++)
+        {
+            found = FALSE;
+            for (i = 0; i < dtcCount; i++)
+            {
+                found = (g_Result->activeDtcs[j] == dtcList[i]) ? TRUE : found;
+            }
+            if (found == FALSE)
+            {
+                Replay_LogEvent("{\"t_ms\":%llu,\"event\":\"dtc\",\"dtc\":\"0x%06lX\",\"active\":false}\n",
+                                (unsigned long long)nowMs, (unsigned long)g_Result->activeDtcs[j]);
+                g_Result->dtcEvents++;
+            }
+        }
+        memcpy(g_Result->activeDtcs, dtcList, dtcCount * sizeof(uint32));
+        g_Result->activeDtcCount = dtcCount;
+    }
+}
+
+/**
+ * @brief Write the malfunction, DTC and system state changes of the last detection cycle
+ */
+static void Replay_LogChanges(uint64 nowMs)
+{
+    ABS_MalfunctionStatus_t status;
+    ABS_SystemState_t systemState;
+    boolean systemHealthy;
+    uint8 changedMask = 0U;
+    uint8 wheelIdx;
+
+    if ((ABS_GetMalfunctionStatusChanges(g_SeenStatusChange, &changedMask) == E_OK) && (changedMask != 0U))
+    {
+        for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+        {
+            if (((changedMask & (1U << wheelIdx)) != 0U) &&
+                (ABS_GetMalfunctionStatus((WheelPosition_t)wheelIdx, &status) == E_OK))
+            {
+                Replay_LogEvent("{\"t_ms\":%llu,\"event\":\"malfunction\",\"wheel\":\"%s\",\"type\":\"%s\","
+                                "\"severity\":%u,\"confirmed\":%s,\"deviation\":%.2f}\n",
+                                (unsigned long long)nowMs, g_WheelNames[wheelIdx],
+                                g_MalfunctionNames[status.malfunctionType], (unsigned)status.severity,
+                                (status.confirmedMalfunction == TRUE) ? "true" : "false",
+                                (double)status.deviationValue);
+                g_Result->malfunctionEvents++;
+            }
+        }
+
+        Replay_LogDtcChanges(nowMs);
+    }
+
+    if ((ABS_CheckSystemHealth(&systemHealthy, &systemState) == E_OK) && (systemState != g_Result->finalState))
+    {
+        Replay_LogEvent("{\"t_ms\":%llu,\"event\":\"system_state\",\"state\":\"%s\"}\n",
+                        (unsigned long long)nowMs, g_SystemStateNames[systemState]);
+        g_Result->finalState = systemState;
+    }
+}
+
+/**
+ * @brief Bring up a fresh ECU software instance and derive the emulated sensor pulse scale
+ */
+static void Replay_InitEcu(void)
+{
+    SpeedSensorCalibration_t calibration;
+    boolean systemHealthy;
+    uint8 wheelIdx;
+
+    /* Start every trace from power-up state */
+    (void)DiagnosticService_DeInit();
+    (void)ABS_MalfunctionDetection_DeInit();
+    (void)CalibrationManager_DeInit();
+    (void)SpeedSensor_DeInit();
+
+    SpeedSensor_Init();
+    CalibrationManager_Init();
+    ABS_MalfunctionDetection_Init();
+    DiagnosticService_Init();
+#if defined(RUNNABLE_TIMING)
+    RunnableTiming_Init();
+#endif
+
+    for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+    {
+        (void)SpeedSensor_GetCalibration((WheelPosition_t)wheelIdx, &calibration);
+        g_PulseScale[wheelIdx] = calibration.wheelCircumference * 3600.0f / (float32)calibration.pulsesPerRevolution;
+    }
+
+    memset(g_WheelSignal, 0, sizeof(g_WheelSignal));
+    memset(g_SeenStatusChange, 0, sizeof(g_SeenStatusChange));
+    (void)ABS_CheckSystemHealth(&systemHealthy, &g_Result->finalState);
+}
+
+/**
+ * @brief Replay the whole trace; returns 0 on success
+ */
+static int Replay_Run(ReplayReader_t* reader)
+{
+    ABS_MalfunctionStatus_t status;
+    CanTrace_Frame_t frame;
+    boolean framePending;
+    uint64 nowMs = 0;
+    uint64 tick = 0;
+    uint8 wheelIdx;
+    int readResult;
+
+    readResult = Replay_NextFrame(reader, &frame);
+    framePending = (readResult == 1) ? TRUE : FALSE;
+    if (framePending == TRUE)
+    {
+        nowMs = (frame.timestampUs / 1000U) - ((frame.timestampUs / 1000U) % SPEED_SENSOR_SAMPLE_RATE_MS);
+    }
+
+    while (framePending == TRUE)
+    {
+        /* Apply every frame received up to the current sample instant */
+        while ((framePending == TRUE) && ((frame.timestampUs / 1000U) <= nowMs))
+        {
+            g_Result->frames++;
+            if (((frame.canId & CANTRACE_ID_MASK) == g_Options.frameId) && (frame.dlc >= 2U))
+            {
+                Replay_DecodeWheelFrame(&frame);
+                g_Result->wheelFrames++;
+            }
+
+            readResult = Replay_NextFrame(reader, &frame);
+            framePending = (readResult == 1) ? TRUE : FALSE;
+        }
+
+        Replay_FeedSensors(nowMs);
+        RE_SpeedSensor_MainCyclic();
+
+        tick++;
+        if ((tick % REPLAY_ABS_CYCLE_TICKS) == 0U)
+        {
+            Replay_RunDetectionCycle();
+            Replay_LogChanges(nowMs);
+            g_Result->cycles++;
+        }
+
+        nowMs += SPEED_SENSOR_SAMPLE_RATE_MS;
+    }
+
+    g_Result->simMs = tick * SPEED_SENSOR_SAMPLE_RATE_MS;
+    for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+    {
+        if ((ABS_GetMalfunctionStatus((WheelPosition_t)wheelIdx, &status) == E_OK) &&
+            (status.confirmedMalfunction == TRUE))
+        {
+            g_Result->confirmedMask |= (uint8)(1U << wheelIdx);
+        }
+    }
+
+    Replay_LogEvent("{\"event\":\"summary\",\"frames\":%llu,\"wheel_frames\":%llu,\"detection_cycles\":%llu,"
+                    "\"sim_ms\":%llu,\"malfunction_events\":%llu,\"dtc_events\":%llu,\"active_dtcs\":%u}\n",
+                    (unsigned long long)g_Result->frames, (unsigned long long)g_Result->wheelFrames,
+                    (unsigned long long)g_Result->cycles, (unsigned long long)g_Result->simMs,
+                    (unsigned long long)g_Result->malfunctionEvents, (unsigned long long)g_Result->dtcEvents,
+                    (unsigned)g_Result->activeDtcCount);
+
+    if (readResult < 0)
+    {
+        fprintf(stderr, "Trace read error after line %lu\n", (unsigned long)reader->lineNumber);
+    }
+
+    return (readResult < 0) ? REPLAY_STATUS_READ_ERROR : REPLAY_STATUS_OK;
+}
+
+void Replay_DefaultOptions(ReplayOptions_t* options)
+{
+    options->frameId = REPLAY_DEFAULT_FRAME_ID;
+    options->resolution = REPLAY_DEFAULT_RESOLUTION;
+}
+
+sint32 Replay_RunTrace(const char* path, const ReplayOptions_t* options, FILE* eventLog, ReplayResult_t* result)
+{
+    ReplayReader_t reader;
+    ReplayFormat_t format = REPLAY_FORMAT_ASC;
+    const char* extension = strrchr(path, '.');
+
+    memset(result, 0, sizeof(*result));
+    result->status = REPLAY_STATUS_OPEN_ERROR;
+
+    if ((extension != NULL) && (strcmp(extension, ".blf") == 0))
+    {
+        format = REPLAY_FORMAT_BLF;
+    }
+    else if ((extension != NULL) && (strcmp(extension, ".ctr") == 0))
+    {
+        format = REPLAY_FORMAT_CTR;
+    }
+
+    if (Replay_Open(&reader, path, format) == 0)
+    {
+        g_Options = *options;
+        g_Result = result;
+        g_EventLog = eventLog;
+
+        Replay_InitEcu();
+        result->status = Replay_Run(&reader);
+        Replay_Close(&reader);
+
+        g_Result = NULL;
+        g_EventLog = NULL;
+    }
+
+    return result->status;
+}
+
+const char* Replay_SystemStateName(ABS_SystemState_t state)
+{
+    return g_SystemStateNames[state];
+}
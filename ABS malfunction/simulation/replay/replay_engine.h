@@ -0,0 +1,62 @@
+/**
+ * @file replay_engine.h
+ * @brief Headless trace replay through the speed sensor, ABS and diagnostic software
+ * @author Generated for ABS Malfunction Detection System
+ */
+
+#ifndef REPLAY_ENGINE_H
+#define REPLAY_ENGINE_H
+
+#include "Std_Types.h"
+#include "ABS_MalfunctionDetection.h"
+#include "DiagnosticService.h"
+#include <stdio.h>
+
+#define REPLAY_DEFAULT_FRAME_ID       0x789UL  /* ABS_Data in day1can/demo_database.dbc */
+#define REPLAY_DEFAULT_RESOLUTION     0.01f    /* km/h per bit of a wheel-speed signal */
+
+/* Result of Replay_RunTrace */
+#define REPLAY_STATUS_OK              0
+#define REPLAY_STATUS_READ_ERROR      1
+#define REPLAY_STATUS_OPEN_ERROR      2
+
+/* Wheel-speed frame decoding */
+typedef struct {
+    uint32 frameId;             /* CAN ID, without the extended-ID flag */
+    float32 resolution;         /* km/h per bit */
+} ReplayOptions_t;
+
+/* Per-trace results (plain data, so it can be shared between processes) */
+typedef struct {
+    uint64 frames;
+    uint64 wheelFrames;
+    uint64 cycles;              /* ABS detection cycles */
+    uint64 simMs;               /* Trace time replayed */
+    uint64 malfunctionEvents;
+    uint64 dtcEvents;
+    uint32 activeDtcs[DIAG_MAX_DTC_COUNT];  /* At the end of the trace */
+    uint8 activeDtcCount;
+    uint8 confirmedMask;        /* Wheels with a confirmed malfunction at the end (bit n = wheel n) */
+    ABS_SystemState_t finalState;
+    sint32 status;              /* REPLAY_STATUS_* */
+} ReplayResult_t;
+
+/**
+ * @brief Default wheel-speed frame decoding
+ */
+void Replay_DefaultOptions(ReplayOptions_t* options);
+
+/**
+ * @brief Replay one trace (.ctr, .asc or .blf by extension) from a fresh ECU state
+ *
+ * The event log (JSON lines) is written to eventLog unless it is NULL; the
+ * counters in result are filled either way. Returns result->status.
+ */
+sint32 Replay_RunTrace(const char* path, const ReplayOptions_t* options, FILE* eventLog, ReplayResult_t* result);
+
+/**
+ * @brief Name of an ABS system state as used in the event log
+ */
+const char* Replay_SystemStateName(ABS_SystemState_t state);
+
+#endif /* REPLAY_ENGINE_H */
@@ -6,67 +6,71 @@
 
 #include "ABS_MalfunctionDetection.h"
 #include "SpeedSensor_Interface.h"
+#include "RunnableTiming.h"
 #include <string.h>
 #include <math.h>
 
+#if !defined(ABS_KERNEL_SCALAR) && defined(__SSE2__)
+#define ABS_KERNEL_SSE2
+#include <emmintrin.h>
+#elif !defined(ABS_KERNEL_SCALAR) && defined(__ARM_NEON) && defined(__aarch64__)
+#define ABS_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
 /* Local data structures */
-static ABS_MalfunctionStatus_t g_MalfunctionStatus[WHEEL_MAX];
-static ABS_DetectionParameters_t g_DetectionParams;
-static ABS_VehicleData_t g_VehicleData;
-static ABS_SystemState_t g_SystemState;
-static boolean g_ABS_Initialized = FALSE;
+/* Single-vehicle ECU instance: a batch context holding one vehicle */
+static ABS_BatchContext_t g_ABS_Context;
+
+#define ABS_SINGLE_VEHICLE_IDX          0U
 
-/* Debounce counters for malfunction detection */
-static uint16 g_DebounceCounters[WHEEL_MAX];
-static uint8 g_ConsecutiveErrorCount[WHEEL_MAX];
+/* Four-wheel check results of one vehicle (bit n of each mask = wheel n) */
+typedef struct {
+    float32 deviation[WHEEL_MAX];
+    uint8 severity[WHEEL_MAX];
+    uint8 driftMask;        /* Calibration drift detected */
+    uint8 speedMask;        /* Speed implausible (and no drift) */
+    uint8 accelMask;        /* Acceleration implausible (and no earlier hit) */
+} ABS_WheelCheckResult_t;
 
 /* Internal function prototypes */
-static void ABS_InitDefaultParameters(void);
-static Std_ReturnType ABS_ProcessWheelMalfunctionDetection(WheelPosition_t wheelPos);
-static boolean ABS_CheckCalibrationDrift(WheelPosition_t wheelPos, float32* driftPercentage);
-static boolean ABS_CheckSpeedPlausibility(WheelPosition_t wheelPos, float32* deviation);
-static boolean ABS_CheckAccelerationPlausibility(WheelPosition_t wheelPos, float32* acceleration);
-static void ABS_UpdateMalfunctionStatus(WheelPosition_t wheelPos, ABS_MalfunctionType_t type, 
-                                       ABS_MalfunctionSeverity_t severity, float32 deviation);
-static void ABS_ProcessDebouncing(WheelPosition_t wheelPos);
+static void ABS_InitDefaultParameters(ABS_DetectionParameters_t* params);
+static void ABS_ResetWheelStatus(ABS_BatchContext_t* ctx, uint16 vehicleIdx, uint8 wheelIdx);
+static void ABS_ProcessVehicleMalfunctionDetection(ABS_BatchContext_t* ctx, uint16 vehicleIdx);
+static void ABS_CheckWheels(const ABS_BatchContext_t* ctx, uint16 vehicleIdx, ABS_WheelCheckResult_t* result);
+static boolean ABS_CheckCalibrationDrift(float32 correctionFactor, float32 threshold, float32* driftPercentage);
+static boolean ABS_CheckSpeedPlausibility(float32 wheelSpeed, boolean speedValid, float32 referenceSpeed,
+                                          float32 threshold, float32* deviation);
+/* Scalar helpers (vector kernels inline these checks) */
+#if !defined(ABS_KERNEL_SSE2) && !defined(ABS_KERNEL_NEON)
+static boolean ABS_CheckAccelerationPlausibility(float32 accelerationX, boolean speedValid, boolean brakePedalPressed,
+                                                 float32 threshold, float32* acceleration);
 static ABS_MalfunctionSeverity_t ABS_DetermineSeverity(ABS_MalfunctionType_t type, float32 deviation);
-static void ABS_UpdateSystemState(void);
-static float32 ABS_CalculateMedianSpeed(void);
+#endif
+static void ABS_UpdateMalfunctionStatus(ABS_MalfunctionStatus_t* status, ABS_MalfunctionType_t type, 
+                                       ABS_MalfunctionSeverity_t severity, float32 deviation);
+static void ABS_ProcessDebouncing(ABS_BatchContext_t* ctx, uint16 vehicleIdx, uint8 wheelIdx);
+static void ABS_ApplyClearRequest(ABS_BatchContext_t* ctx, uint16 vehicleIdx, uint8 wheelIdx);
+static void ABS_PublishStatusChange(ABS_BatchContext_t* ctx, uint16 vehicleIdx, uint8 wheelIdx,
+                                    boolean wasConfirmed, ABS_MalfunctionType_t previousType);
+static void ABS_UpdateSystemState(ABS_BatchContext_t* ctx, uint16 vehicleIdx);
+static float32 ABS_GetReferenceSpeed(ABS_BatchContext_t* ctx, uint16 vehicleIdx);
+static float32 ABS_CalculateMedianSpeed(const float32 wheelSpeed[WHEEL_MAX], const boolean speedValid[WHEEL_MAX]);
+static float32 ABS_CalculateWindowMedian(const float32 history[ABS_REFERENCE_WINDOW_MAX], uint8 count);
 
 /**
  * @brief Initialize ABS malfunction detection system
  */
 Std_ReturnType ABS_MalfunctionDetection_Init(void)
 {
-    uint8 wheelIdx;
+    Std_ReturnType retVal = E_OK;
     
-    if (g_ABS_Initialized == FALSE)
+    if (g_ABS_Context.initialized == FALSE)
     {
-        /* Initialize malfunction status for all wheels */
-        for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
-        {
-            memset(&g_MalfunctionStatus[wheelIdx], 0, sizeof(ABS_MalfunctionStatus_t));
-            g_MalfunctionStatus[wheelIdx].malfunctionType = ABS_MALFUNCTION_NONE;
-            g_MalfunctionStatus[wheelIdx].severity = ABS_SEVERITY_NONE;
-            g_MalfunctionStatus[wheelIdx].affectedWheel = (WheelPosition_t)wheelIdx;
-            g_MalfunctionStatus[wheelIdx].isActive = FALSE;
-            g_MalfunctionStatus[wheelIdx].confirmedMalfunction = FALSE;
-            
-            g_DebounceCounters[wheelIdx] = 0;
-            g_ConsecutiveErrorCount[wheelIdx] = 0;
-        }
-        
-        /* Initialize default detection parameters */
-        ABS_InitDefaultParameters();
-        
-        /* Initialize vehicle data */
-        memset(&g_VehicleData, 0, sizeof(ABS_VehicleData_t));
-        g_SystemState = ABS_STATE_MONITORING;
-        
-        g_ABS_Initialized = TRUE;
+        retVal = ABS_Batch_Init(&g_ABS_Context, 1U);
     }
     
-    return E_OK;
+    return retVal;
 }
 
 /**
@@ -74,8 +78,8 @@ Std_ReturnType ABS_MalfunctionDetection_Init(void)
  */
 Std_ReturnType ABS_MalfunctionDetection_DeInit(void)
 {
-    g_ABS_Initialized = FALSE;
-    g_SystemState = ABS_STATE_INACTIVE;
+    g_ABS_Context.initialized = FALSE;
+    g_ABS_Context.systemState[ABS_SINGLE_VEHICLE_IDX] = ABS_STATE_INACTIVE;
     return E_OK;
 }
 
@@ -84,24 +88,30 @@ Std_ReturnType ABS_MalfunctionDetection_DeInit(void)
  */
 Std_ReturnType ABS_MalfunctionDetection_MainFunction(void)
 {
-    Std_ReturnType retVal = E_OK;
+    Std_ReturnType retVal = E_NOT_OK;
+    SpeedSensorCalibration_t calibration;
     uint8 wheelIdx;
     
-    if (g_ABS_Initialized == TRUE)
+    if (g_ABS_Context.initialized == TRUE)
     {
-        /* Process malfunction detection for all wheels */
-        for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+        /* Load current sensor calibration into the batch of one */
+        if (g_ABS_Context.params.enableMiscalibrationDetection == TRUE)
         {
-            ABS_ProcessWheelMalfunctionDetection((WheelPosition_t)wheelIdx);
-            ABS_ProcessDebouncing((WheelPosition_t)wheelIdx);
+            for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+            {
+                if (SpeedSensor_GetCalibration((WheelPosition_t)wheelIdx, &calibration) == E_OK)
+                {
+                    g_ABS_Context.correctionFactor[ABS_SINGLE_VEHICLE_IDX][wheelIdx] = calibration.correctionFactor;
+                }
+                else
+                {
+                    /* Calibration unavailable - treat as not drifted */
+                    g_ABS_Context.correctionFactor[ABS_SINGLE_VEHICLE_IDX][wheelIdx] = 1.0f;
+                }
+            }
         }
         
-        /* Update overall system state */
-        ABS_UpdateSystemState();
-    }
-    else
-    {
-        retVal = E_NOT_OK;
+        retVal = ABS_Batch_MainFunction(&g_ABS_Context);
     }
     
     return retVal;
@@ -112,15 +122,7 @@ Std_ReturnType ABS_MalfunctionDetection_MainFunction(void)
  */
 Std_ReturnType ABS_UpdateVehicleData(const ABS_VehicleData_t* vehicleData)
 {
-    Std_ReturnType retVal = E_NOT_OK;
-    
-    if ((vehicleData != NULL_PTR) && (g_ABS_Initialized == TRUE))
-    {
-        g_VehicleData = *vehicleData;
-        retVal = E_OK;
-    }
-    
-    return retVal;
+    return ABS_Batch_UpdateVehicleData(&g_ABS_Context, ABS_SINGLE_VEHICLE_IDX, vehicleData);
 }
 
 /**
@@ -129,11 +131,19 @@ Std_ReturnType ABS_UpdateVehicleData(const ABS_VehicleData_t* vehicleData)
 Std_ReturnType ABS_CheckSpeedSensorCalibration(WheelPosition_t wheelPos, boolean* isMiscalibrated)
 {
     Std_ReturnType retVal = E_NOT_OK;
+    SpeedSensorCalibration_t calibration;
     float32 driftPercentage;
     
-    if ((wheelPos < WHEEL_MAX) && (isMiscalibrated != NULL_PTR) && (g_ABS_Initialized == TRUE))
+    if ((wheelPos < WHEEL_MAX) && (isMiscalibrated != NULL_PTR) && (g_ABS_Context.initialized == TRUE))
     {
-        *isMiscalibrated = ABS_CheckCalibrationDrift(wheelPos, &driftPercentage);
+        *isMiscalibrated = FALSE;
+        
+        if (SpeedSensor_GetCalibration(wheelPos, &calibration) == E_OK)
+        {
+            *isMiscalibrated = ABS_CheckCalibrationDrift(calibration.correctionFactor,
+                                                         g_ABS_Context.params.calibrationDriftThreshold,
+                                                         &driftPercentage);
+        }
         retVal = E_OK;
     }
     
@@ -146,23 +156,25 @@ Std_ReturnType ABS_CheckSpeedSensorCalibration(WheelPosition_t wheelPos, boolean
 Std_ReturnType ABS_DetectSpeedDifferences(boolean* excessiveDifference, WheelPosition_t* affectedWheel)
 {
     Std_ReturnType retVal = E_NOT_OK;
+    const float32* wheelSpeed = g_ABS_Context.wheelSpeed[ABS_SINGLE_VEHICLE_IDX];
+    const boolean* speedValid = g_ABS_Context.speedValid[ABS_SINGLE_VEHICLE_IDX];
     float32 referenceSpeed;
     float32 speedDifference;
     uint8 wheelIdx;
     
-    if ((excessiveDifference != NULL_PTR) && (affectedWheel != NULL_PTR) && (g_ABS_Initialized == TRUE))
+    if ((excessiveDifference != NULL_PTR) && (affectedWheel != NULL_PTR) && (g_ABS_Context.initialized == TRUE))
     {
         *excessiveDifference = FALSE;
-        referenceSpeed = ABS_CalculateMedianSpeed();
+        referenceSpeed = ABS_GetReferenceSpeed(&g_ABS_Context, ABS_SINGLE_VEHICLE_IDX);
         
         /* Check each wheel speed against reference */
         for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
         {
-            if (g_VehicleData.wheelSpeeds[wheelIdx].speedValid == TRUE)
+            if (speedValid[wheelIdx] == TRUE)
             {
-                speedDifference = fabsf(g_VehicleData.wheelSpeeds[wheelIdx].wheelSpeed - referenceSpeed);
+                speedDifference = fabsf(wheelSpeed[wheelIdx] - referenceSpeed);
                 
-                if (speedDifference > g_DetectionParams.speedDifferenceThreshold)
+                if (speedDifference > g_ABS_Context.params.speedDifferenceThreshold)
                 {
                     *excessiveDifference = TRUE;
                     *affectedWheel = (WheelPosition_t)wheelIdx;
@@ -183,11 +195,16 @@ Std_ReturnType ABS_DetectSpeedDifferences(boolean* excessiveDifference, WheelPos
 Std_ReturnType ABS_ValidateSpeedPlausibility(WheelPosition_t wheelPos, boolean* isPlausible)
 {
     Std_ReturnType retVal = E_NOT_OK;
+    const float32* wheelSpeed = g_ABS_Context.wheelSpeed[ABS_SINGLE_VEHICLE_IDX];
+    const boolean* speedValid = g_ABS_Context.speedValid[ABS_SINGLE_VEHICLE_IDX];
     float32 deviation;
     
-    if ((wheelPos < WHEEL_MAX) && (isPlausible != NULL_PTR) && (g_ABS_Initialized == TRUE))
+    if ((wheelPos < WHEEL_MAX) && (isPlausible != NULL_PTR) && (g_ABS_Context.initialized == TRUE))
     {
-        *isPlausible = ABS_CheckSpeedPlausibility(wheelPos, &deviation);
+        *isPlausible = ABS_CheckSpeedPlausibility(wheelSpeed[wheelPos], speedValid[wheelPos],
+                                                  ABS_GetReferenceSpeed(&g_ABS_Context, ABS_SINGLE_VEHICLE_IDX),
+                                                  g_ABS_Context.params.speedDifferenceThreshold,
+                                                  &deviation);
         retVal = E_OK;
     }
     
@@ -198,12 +215,44 @@ Std_ReturnType ABS_ValidateSpeedPlausibility(WheelPosition_t wheelPos, boolean*
  * @brief Get current malfunction status
  */
 Std_ReturnType ABS_GetMalfunctionStatus(WheelPosition_t wheelPos, ABS_MalfunctionStatus_t* status)
+{
+    return ABS_Batch_GetMalfunctionStatus(&g_ABS_Context, ABS_SINGLE_VEHICLE_IDX, wheelPos, status);
+}
+
+/**
+ * @brief Request a clear of the malfunction status, applied by the next detection cycle
+ */
+Std_ReturnType ABS_ClearMalfunctionStatus(WheelPosition_t wheelPos)
+{
+    return ABS_Batch_ClearMalfunctionStatus(&g_ABS_Context, ABS_SINGLE_VEHICLE_IDX, wheelPos);
+}
+
+/**
+ * @brief Get wheels whose confirmed malfunction status changed since lastSeen
+ */
+Std_ReturnType ABS_GetMalfunctionStatusChanges(uint8 lastSeen[WHEEL_MAX], uint8* changedMask)
+{
+    return ABS_Batch_GetMalfunctionStatusChanges(&g_ABS_Context, ABS_SINGLE_VEHICLE_IDX, lastSeen, changedMask);
+}
+
+/**
+ * @brief Set detection parameters
+ */
+Std_ReturnType ABS_SetDetectionParameters(const ABS_DetectionParameters_t* params)
+{
+    return ABS_Batch_SetDetectionParameters(&g_ABS_Context, params);
+}
+
+/**
+ * @brief Get detection parameters
+ */
+Std_ReturnType ABS_GetDetectionParameters(ABS_DetectionParameters_t* params)
 {
     Std_ReturnType retVal = E_NOT_OK;
     
-    if ((wheelPos < WHEEL_MAX) && (status != NULL_PTR) && (g_ABS_Initialized == TRUE))
+    if ((params != NULL_PTR) && (g_ABS_Context.initialized == TRUE))
     {
-        *status = g_MalfunctionStatus[wheelPos];
+        *params = g_ABS_Context.params;
         retVal = E_OK;
     }
     
@@ -211,36 +260,68 @@ Std_ReturnType ABS_GetMalfunctionStatus(WheelPosition_t wheelPos, ABS_Malfunctio
 }
 
 /**
- * @brief Clear malfunction status
+ * @brief Check overall ABS system health
  */
-Std_ReturnType ABS_ClearMalfunctionStatus(WheelPosition_t wheelPos)
+Std_ReturnType ABS_CheckSystemHealth(boolean* systemHealthy, ABS_SystemState_t* systemState)
 {
     Std_ReturnType retVal = E_NOT_OK;
+    const ABS_MalfunctionStatus_t* status = g_ABS_Context.malfunctionStatus[ABS_SINGLE_VEHICLE_IDX];
+    uint8 wheelIdx;
+    uint8 malfunctionCount = 0;
     
-    if ((wheelPos < WHEEL_MAX) && (g_ABS_Initialized == TRUE))
+    if ((systemHealthy != NULL_PTR) && (systemState != NULL_PTR) && (g_ABS_Context.initialized == TRUE))
     {
-        g_MalfunctionStatus[wheelPos].isActive = FALSE;
-        g_MalfunctionStatus[wheelPos].confirmedMalfunction = FALSE;
-        g_MalfunctionStatus[wheelPos].malfunctionType = ABS_MALFUNCTION_NONE;
-        g_MalfunctionStatus[wheelPos].severity = ABS_SEVERITY_NONE;
-        g_DebounceCounters[wheelPos] = 0;
-        g_ConsecutiveErrorCount[wheelPos] = 0;
+        /* Count active malfunctions */
+        for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+        {
+            if (status[wheelIdx].isActive == TRUE)
+            {
+                malfunctionCount++;
+            }
+        }
+        
+        /* Determine system health */
+        *systemHealthy = (malfunctionCount == 0);
+        *systemState = g_ABS_Context.systemState[ABS_SINGLE_VEHICLE_IDX];
+        
         retVal = E_OK;
     }
     
     return retVal;
 }
 
+/* Batch Detection Functions */
+
 /**
- * @brief Set detection parameters
+ * @brief Initialize a batch context for vehicleCount vehicles
  */
-Std_ReturnType ABS_SetDetectionParameters(const ABS_DetectionParameters_t* params)
+Std_ReturnType ABS_Batch_Init(ABS_BatchContext_t* ctx, uint16 vehicleCount)
 {
     Std_ReturnType retVal = E_NOT_OK;
+    uint16 vehicleIdx;
+    uint8 wheelIdx;
     
-    if ((params != NULL_PTR) && (g_ABS_Initialized == TRUE))
+    if ((ctx != NULL_PTR) && (vehicleCount > 0U) && (vehicleCount <= ABS_BATCH_MAX_VEHICLES))
     {
-        g_DetectionParams = *params;
+        memset(ctx, 0, sizeof(ABS_BatchContext_t));
+        
+        for (vehicleIdx = 0; vehicleIdx < vehicleCount; vehicleIdx++)
+        {
+            for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+            {
+                ctx->correctionFactor[vehicleIdx][wheelIdx] = 1.0f;
+                ABS_ResetWheelStatus(ctx, vehicleIdx, wheelIdx);
+            }
+            
+            ctx->systemState[vehicleIdx] = ABS_STATE_MONITORING;
+        }
+        
+        /* Initialize default detection parameters */
+        ABS_InitDefaultParameters(&ctx->params);
+        
+        ctx->referenceWindowSize = 1U;
+        ctx->vehicleCount = vehicleCount;
+        ctx->initialized = TRUE;
         retVal = E_OK;
     }
     
@@ -248,15 +329,33 @@ Std_ReturnType ABS_SetDetectionParameters(const ABS_DetectionParameters_t* param
 }
 
 /**
- * @brief Get detection parameters
+ * @brief Run one detection cycle for all vehicles in the batch
  */
-Std_ReturnType ABS_GetDetectionParameters(ABS_DetectionParameters_t* params)
+Std_ReturnType ABS_Batch_MainFunction(ABS_BatchContext_t* ctx)
 {
     Std_ReturnType retVal = E_NOT_OK;
+    uint16 vehicleIdx;
     
-    if ((params != NULL_PTR) && (g_ABS_Initialized == TRUE))
+    if ((ctx != NULL_PTR) && (ctx->initialized == TRUE))
     {
-        *params = g_DetectionParams;
+        /* Reference speed once per vehicle and data update */
+        for (vehicleIdx = 0; vehicleIdx < ctx->vehicleCount; vehicleIdx++)
+        {
+            (void)ABS_GetReferenceSpeed(ctx, vehicleIdx);
+        }
+        
+        /* Process malfunction detection for all wheels of all vehicles */
+        for (vehicleIdx = 0; vehicleIdx < ctx->vehicleCount; vehicleIdx++)
+        {
+            ABS_ProcessVehicleMalfunctionDetection(ctx, vehicleIdx);
+        }
+        
+        /* Update overall system state */
+        for (vehicleIdx = 0; vehicleIdx < ctx->vehicleCount; vehicleIdx++)
+        {
+            ABS_UpdateSystemState(ctx, vehicleIdx);
+        }
+        
         retVal = E_OK;
     }
     
@@ -264,136 +363,521 @@ Std_ReturnType ABS_GetDetectionParameters(ABS_DetectionParameters_t* params)
 }
 
 /**
- * @brief Check overall ABS system health
+ * @brief Load vehicle data for one vehicle of the batch
  */
-Std_ReturnType ABS_CheckSystemHealth(boolean* systemHealthy, ABS_SystemState_t* systemState)
+Std_ReturnType ABS_Batch_UpdateVehicleData(ABS_BatchContext_t* ctx, uint16 vehicleIdx,
+                                           const ABS_VehicleData_t* vehicleData)
 {
     Std_ReturnType retVal = E_NOT_OK;
     uint8 wheelIdx;
-    uint8 malfunctionCount = 0;
     
-    if ((systemHealthy != NULL_PTR) && (systemState != NULL_PTR) && (g_ABS_Initialized == TRUE))
+    if ((ctx != NULL_PTR) && (vehicleData != NULL_PTR) && (ctx->initialized == TRUE) &&
+        (vehicleIdx < ctx->vehicleCount))
     {
-        /* Count active malfunctions */
         for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
         {
-            if (g_MalfunctionStatus[wheelIdx].isActive == TRUE)
-            {
-                malfunctionCount++;
-            }
+            ctx->wheelSpeed[vehicleIdx][wheelIdx] = vehicleData->wheelSpeeds[wheelIdx].wheelSpeed;
+            ctx->accelerationX[vehicleIdx][wheelIdx] = vehicleData->wheelSpeeds[wheelIdx].accelerationX;
+            ctx->speedValid[vehicleIdx][wheelIdx] = vehicleData->wheelSpeeds[wheelIdx].speedValid;
         }
+        ctx->brakePedalPressed[vehicleIdx] = vehicleData->brakePedalPressed;
         
-        /* Determine system health */
-        *systemHealthy = (malfunctionCount == 0);
-        *systemState = g_SystemState;
-        
+        /* New wheel speeds invalidate the cached reference speed */
+        ctx->referenceValid[vehicleIdx] = FALSE;
         retVal = E_OK;
     }
     
     return retVal;
 }
 
-/* Internal Functions */
+/**
+ * @brief Load the active speed sensor calibration for one wheel of one vehicle
+ */
+Std_ReturnType ABS_Batch_UpdateCalibration(ABS_BatchContext_t* ctx, uint16 vehicleIdx,
+                                           WheelPosition_t wheelPos,
+                                           const SpeedSensorCalibration_t* calibration)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    
+    if ((ctx != NULL_PTR) && (calibration != NULL_PTR) && (ctx->initialized == TRUE) &&
+        (vehicleIdx < ctx->vehicleCount) && (wheelPos < WHEEL_MAX))
+    {
+        ctx->correctionFactor[vehicleIdx][wheelPos] = calibration->correctionFactor;
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
 
 /**
- * @brief Initialize default detection parameters
+ * @brief Get malfunction status for one wheel of one vehicle
  */
-static void ABS_InitDefaultParameters(void)
+Std_ReturnType ABS_Batch_GetMalfunctionStatus(const ABS_BatchContext_t* ctx, uint16 vehicleIdx,
+                                              WheelPosition_t wheelPos, ABS_MalfunctionStatus_t* status)
 {
-    g_DetectionParams.speedDifferenceThreshold = ABS_MAX_SPEED_DIFFERENCE;
-    g_DetectionParams.accelerationThreshold = ABS_MAX_ACCELERATION;
-    g_DetectionParams.calibrationDriftThreshold = ABS_CALIBRATION_DRIFT_LIMIT;
-    g_DetectionParams.debounceTimeMs = ABS_DEBOUNCE_TIME_MS;
-    g_DetectionParams.consecutiveErrorsThreshold = ABS_CONSECUTIVE_ERRORS_MAX;
-    g_DetectionParams.enableMiscalibrationDetection = TRUE;
-    g_DetectionParams.enableSpeedPlausibilityCheck = TRUE;
-    g_DetectionParams.enableAccelerationCheck = TRUE;
+    Std_ReturnType retVal = E_NOT_OK;
+    
+    if ((ctx != NULL_PTR) && (status != NULL_PTR) && (ctx->initialized == TRUE) &&
+        (vehicleIdx < ctx->vehicleCount) && (wheelPos < WHEEL_MAX))
+    {
+        *status = ctx->malfunctionStatus[vehicleIdx][wheelPos];
+        retVal = E_OK;
+    }
+    
+    return retVal;
 }
 
 /**
- * @brief Process malfunction detection for a specific wheel
+ * @brief Request a clear of the malfunction status of one wheel of one vehicle
+ *
+ * Called from the diagnostic task: only the request sequence is written here, the
+ * status itself and its change sequence are written by the ABS task alone.
  */
-static Std_ReturnType ABS_ProcessWheelMalfunctionDetection(WheelPosition_t wheelPos)
+Std_ReturnType ABS_Batch_ClearMalfunctionStatus(ABS_BatchContext_t* ctx, uint16 vehicleIdx,
+                                                WheelPosition_t wheelPos)
 {
-    float32 deviation;
-    boolean malfunctionDetected = FALSE;
-    ABS_MalfunctionType_t malfunctionType = ABS_MALFUNCTION_NONE;
-    ABS_MalfunctionSeverity_t severity = ABS_SEVERITY_NONE;
+    Std_ReturnType retVal = E_NOT_OK;
+    
+    if ((ctx != NULL_PTR) && (ctx->initialized == TRUE) &&
+        (vehicleIdx < ctx->vehicleCount) && (wheelPos < WHEEL_MAX))
+    {
+        ctx->clearRequest[vehicleIdx][wheelPos]++;
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief Get wheels of one vehicle whose confirmed malfunction status changed since lastSeen
+ */
+Std_ReturnType ABS_Batch_GetMalfunctionStatusChanges(const ABS_BatchContext_t* ctx, uint16 vehicleIdx,
+                                                     uint8 lastSeen[WHEEL_MAX], uint8* changedMask)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    uint8 counter;
+    uint8 wheelIdx;
     
-    /* Check calibration drift */
-    if (g_DetectionParams.enableMiscalibrationDetection == TRUE)
+    if ((ctx != NULL_PTR) && (lastSeen != NULL_PTR) && (changedMask != NULL_PTR) &&
+        (ctx->initialized == TRUE) && (vehicleIdx < ctx->vehicleCount))
     {
-        if (ABS_CheckCalibrationDrift(wheelPos, &deviation) == TRUE)
+        *changedMask = 0U;
+        
+        /* Single writer per counter: no lock needed, each byte is read once */
+        for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
         {
-            malfunctionDetected = TRUE;
-            malfunctionType = ABS_MALFUNCTION_SPEED_SENSOR_MISCALIBRATION;
-            severity = ABS_DetermineSeverity(malfunctionType, deviation);
+            counter = ctx->statusChangeCounter[vehicleIdx][wheelIdx];
+            if (counter != lastSeen[wheelIdx])
+            {
+                lastSeen[wheelIdx] = counter;
+                *changedMask |= (uint8)(1U << wheelIdx);
+            }
         }
+        retVal = E_OK;
     }
     
-    /* Check speed plausibility */
-    if ((g_DetectionParams.enableSpeedPlausibilityCheck == TRUE) && (malfunctionDetected == FALSE))
+    return retVal;
+}
+
+/**
+ * @brief Get system state of one vehicle
+ */
+Std_ReturnType ABS_Batch_GetSystemState(const ABS_BatchContext_t* ctx, uint16 vehicleIdx,
+                                        ABS_SystemState_t* systemState)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    
+    if ((ctx != NULL_PTR) && (systemState != NULL_PTR) && (ctx->initialized == TRUE) &&
+        (vehicleIdx < ctx->vehicleCount))
     {
-        if (ABS_CheckSpeedPlausibility(wheelPos, &deviation) == FALSE)
+        *systemState = ctx->systemState[vehicleIdx];
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief Set detection parameters shared by all vehicles of the batch
+ */
+Std_ReturnType ABS_Batch_SetDetectionParameters(ABS_BatchContext_t* ctx, const ABS_DetectionParameters_t* params)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    
+    if ((ctx != NULL_PTR) && (params != NULL_PTR) && (ctx->initialized == TRUE))
+    {
+        ctx->params = *params;
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief Set the reference speed median window (1..ABS_REFERENCE_WINDOW_MAX cycles)
+ */
+Std_ReturnType ABS_Batch_SetReferenceWindow(ABS_BatchContext_t* ctx, uint8 windowSize)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    uint16 vehicleIdx;
+    
+    if ((ctx != NULL_PTR) && (ctx->initialized == TRUE) &&
+        (windowSize > 0U) && (windowSize <= ABS_REFERENCE_WINDOW_MAX))
+    {
+        ctx->referenceWindowSize = windowSize;
+        
+        /* Restart the window history */
+        for (vehicleIdx = 0; vehicleIdx < ctx->vehicleCount; vehicleIdx++)
         {
-            malfunctionDetected = TRUE;
-            malfunctionType = ABS_MALFUNCTION_SPEED_DIFFERENCE_EXCESSIVE;
-            severity = ABS_DetermineSeverity(malfunctionType, deviation);
+            ctx->referenceHistoryIdx[vehicleIdx] = 0U;
+            ctx->referenceHistoryCount[vehicleIdx] = 0U;
+            ctx->referenceValid[vehicleIdx] = FALSE;
         }
+        retVal = E_OK;
     }
     
-    /* Check acceleration plausibility */
-    if ((g_DetectionParams.enableAccelerationCheck == TRUE) && (malfunctionDetected == FALSE))
+    return retVal;
+}
+
+/* Internal Functions */
+
+/**
+ * @brief Initialize default detection parameters
+ */
+static void ABS_InitDefaultParameters(ABS_DetectionParameters_t* params)
+{
+    params->speedDifferenceThreshold = ABS_MAX_SPEED_DIFFERENCE;
+    params->accelerationThreshold = ABS_MAX_ACCELERATION;
+    params->calibrationDriftThreshold = ABS_CALIBRATION_DRIFT_LIMIT;
+    params->debounceTimeMs = ABS_DEBOUNCE_TIME_MS;
+    params->consecutiveErrorsThreshold = ABS_CONSECUTIVE_ERRORS_MAX;
+    params->enableMiscalibrationDetection = TRUE;
+    params->enableSpeedPlausibilityCheck = TRUE;
+    params->enableAccelerationCheck = TRUE;
+}
+
+/**
+ * @brief Reset malfunction status and debounce state of one wheel
+ */
+static void ABS_ResetWheelStatus(ABS_BatchContext_t* ctx, uint16 vehicleIdx, uint8 wheelIdx)
+{
+    ABS_MalfunctionStatus_t* status = &ctx->malfunctionStatus[vehicleIdx][wheelIdx];
+    
+    memset(status, 0, sizeof(ABS_MalfunctionStatus_t));
+    status->malfunctionType = ABS_MALFUNCTION_NONE;
+    status->severity = ABS_SEVERITY_NONE;
+    status->affectedWheel = (WheelPosition_t)wheelIdx;
+    status->isActive = FALSE;
+    status->confirmedMalfunction = FALSE;
+    
+    ctx->debounceCounter[vehicleIdx][wheelIdx] = 0;
+    ctx->consecutiveErrorCount[vehicleIdx][wheelIdx] = 0;
+}
+
+/**
+ * @brief Process malfunction detection for all wheels of one vehicle
+ */
+static void ABS_ProcessVehicleMalfunctionDetection(ABS_BatchContext_t* ctx, uint16 vehicleIdx)
+{
+    ABS_WheelCheckResult_t result;
+    ABS_MalfunctionType_t malfunctionType;
+    uint8 wheelIdx;
+    uint8 wheelBit;
+    
+    /* Run all checks for the four wheels at once */
+    ABS_CheckWheels(ctx, vehicleIdx, &result);
+    
+    for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
     {
-        if (ABS_CheckAccelerationPlausibility(wheelPos, &deviation) == FALSE)
+        const boolean wasConfirmed = ctx->malfunctionStatus[vehicleIdx][wheelIdx].confirmedMalfunction;
+        const ABS_MalfunctionType_t previousType = ctx->malfunctionStatus[vehicleIdx][wheelIdx].malfunctionType;
+        
+        wheelBit = (uint8)(1U << wheelIdx);
+        
+        ABS_ApplyClearRequest(ctx, vehicleIdx, wheelIdx);
+        
+        if ((result.driftMask & wheelBit) != 0U)
+        {
+            malfunctionType = ABS_MALFUNCTION_SPEED_SENSOR_MISCALIBRATION;
+        }
+        else if ((result.speedMask & wheelBit) != 0U)
+        {
+            malfunctionType = ABS_MALFUNCTION_SPEED_DIFFERENCE_EXCESSIVE;
+        }
+        else if ((result.accelMask & wheelBit) != 0U)
         {
-            malfunctionDetected = TRUE;
             malfunctionType = ABS_MALFUNCTION_ACCELERATION_IMPLAUSIBLE;
-            severity = ABS_DetermineSeverity(malfunctionType, deviation);
         }
+        else
+        {
+            malfunctionType = ABS_MALFUNCTION_NONE;
+        }
+        
+        /* Update malfunction status */
+        if (malfunctionType != ABS_MALFUNCTION_NONE)
+        {
+            ABS_UpdateMalfunctionStatus(&ctx->malfunctionStatus[vehicleIdx][wheelIdx], malfunctionType,
+                                        (ABS_MalfunctionSeverity_t)result.severity[wheelIdx],
+                                        result.deviation[wheelIdx]);
+            ctx->consecutiveErrorCount[vehicleIdx][wheelIdx]++;
+        }
+        else
+        {
+            /* Reset consecutive error count if no malfunction */
+            ctx->consecutiveErrorCount[vehicleIdx][wheelIdx] = 0;
+            
+            /* Clear malfunction if it was temporary */
+            if (ctx->malfunctionStatus[vehicleIdx][wheelIdx].isActive == TRUE)
+            {
+                ctx->debounceCounter[vehicleIdx][wheelIdx] = 0;
+            }
+        }
+        
+        ABS_ProcessDebouncing(ctx, vehicleIdx, wheelIdx);
+        ABS_PublishStatusChange(ctx, vehicleIdx, wheelIdx, wasConfirmed, previousType);
     }
+}
+
+#if defined(ABS_KERNEL_SSE2)
+
+/**
+ * @brief Run drift, plausibility and severity checks for four wheels (SSE2)
+ */
+static void ABS_CheckWheels(const ABS_BatchContext_t* ctx, uint16 vehicleIdx, ABS_WheelCheckResult_t* result)
+{
+    const ABS_DetectionParameters_t* params = &ctx->params;
+    const boolean* speedValid = ctx->speedValid[vehicleIdx];
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 allOnes = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    __m128 valid;
+    __m128 notBraking;
+    __m128 enableDrift, enableSpeed, enableAccel;
+    __m128 drift, speedDev, accelAbs;
+    __m128 driftHit, speedHit, accelHit;
+    __m128 deviation;
+    __m128i sevDrift, sevSpeed, sevAccel, severity;
+    uint32 sevPacked;
+    uint8 wheelIdx;
+    
+    valid = _mm_castsi128_ps(_mm_set_epi32(-(sint32)(speedValid[3] == TRUE), -(sint32)(speedValid[2] == TRUE),
+                                           -(sint32)(speedValid[1] == TRUE), -(sint32)(speedValid[0] == TRUE)));
+    notBraking = (ctx->brakePedalPressed[vehicleIdx] == FALSE) ? allOnes : _mm_setzero_ps();
+    enableDrift = (params->enableMiscalibrationDetection == TRUE) ? allOnes : _mm_setzero_ps();
+    enableSpeed = (params->enableSpeedPlausibilityCheck == TRUE) ? allOnes : _mm_setzero_ps();
+    enableAccel = (params->enableAccelerationCheck == TRUE) ? allOnes : _mm_setzero_ps();
     
-    /* Update malfunction status */
-    if (malfunctionDetected == TRUE)
+    /* Deviation magnitudes */
+    drift = _mm_mul_ps(_mm_and_ps(absMask, _mm_sub_ps(_mm_loadu_ps(ctx->correctionFactor[vehicleIdx]),
+                                                      _mm_set1_ps(1.0f))),
+                       _mm_set1_ps(100.0f));
+    speedDev = _mm_and_ps(valid, _mm_and_ps(absMask, _mm_sub_ps(_mm_loadu_ps(ctx->wheelSpeed[vehicleIdx]),
+                                                                _mm_set1_ps(ctx->referenceSpeed[vehicleIdx]))));
+    accelAbs = _mm_and_ps(valid, _mm_and_ps(absMask, _mm_loadu_ps(ctx->accelerationX[vehicleIdx])));
+    
+    /* Check hits in priority order: drift, speed plausibility, acceleration */
+    driftHit = _mm_and_ps(enableDrift, _mm_cmpgt_ps(drift, _mm_set1_ps(params->calibrationDriftThreshold)));
+    speedHit = _mm_or_ps(_mm_andnot_ps(valid, allOnes),
+                         _mm_cmpgt_ps(speedDev, _mm_set1_ps(params->speedDifferenceThreshold)));
+    speedHit = _mm_andnot_ps(driftHit, _mm_and_ps(enableSpeed, speedHit));
+    accelHit = _mm_or_ps(_mm_andnot_ps(valid, allOnes),
+                         _mm_and_ps(notBraking, _mm_cmpgt_ps(accelAbs, _mm_set1_ps(params->accelerationThreshold))));
+    accelHit = _mm_andnot_ps(_mm_or_ps(driftHit, speedHit), _mm_and_ps(enableAccel, accelHit));
+    
+    deviation = _mm_or_ps(_mm_or_ps(_mm_and_ps(driftHit, drift), _mm_and_ps(speedHit, speedDev)),
+                          _mm_and_ps(accelHit, accelAbs));
+    
+    /* Severity: base level plus one per exceeded limit (compare masks are -1) */
+    sevDrift = _mm_sub_epi32(_mm_set1_epi32(ABS_SEVERITY_LOW),
+                             _mm_add_epi32(_mm_castps_si128(_mm_cmpgt_ps(drift, _mm_set1_ps(5.0f))),
+                                           _mm_add_epi32(_mm_castps_si128(_mm_cmpgt_ps(drift, _mm_set1_ps(10.0f))),
+                                                         _mm_castps_si128(_mm_cmpgt_ps(drift, _mm_set1_ps(15.0f))))));
+    sevSpeed = _mm_sub_epi32(_mm_set1_epi32(ABS_SEVERITY_LOW),
+                             _mm_add_epi32(_mm_castps_si128(_mm_cmpgt_ps(speedDev, _mm_set1_ps(20.0f))),
+                                           _mm_add_epi32(_mm_castps_si128(_mm_cmpgt_ps(speedDev, _mm_set1_ps(30.0f))),
+                                                         _mm_castps_si128(_mm_cmpgt_ps(speedDev, _mm_set1_ps(50.0f))))));
+    sevAccel = _mm_sub_epi32(_mm_set1_epi32(ABS_SEVERITY_MEDIUM),
+                             _mm_add_epi32(_mm_castps_si128(_mm_cmpgt_ps(accelAbs, _mm_set1_ps(15.0f))),
+                                           _mm_castps_si128(_mm_cmpgt_ps(accelAbs, _mm_set1_ps(20.0f)))));
+    severity = _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_castps_si128(driftHit), sevDrift),
+                                         _mm_and_si128(_mm_castps_si128(speedHit), sevSpeed)),
+                            _mm_and_si128(_mm_castps_si128(accelHit), sevAccel));
+    
+    _mm_storeu_ps(result->deviation, deviation);
+    
+    /* Narrow the four severity lanes to bytes (lane n in bits 8n..8n+7) */
+    severity = _mm_packus_epi16(_mm_packs_epi32(severity, severity), severity);
+    sevPacked = (uint32)_mm_cvtsi128_si32(severity);
+    for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
     {
-        ABS_UpdateMalfunctionStatus(wheelPos, malfunctionType, severity, deviation);
-        g_ConsecutiveErrorCount[wheelPos]++;
+        result->severity[wheelIdx] = (uint8)(sevPacked >> (8U * wheelIdx));
     }
-    else
+    
+    result->driftMask = (uint8)_mm_movemask_ps(driftHit);
+    result->speedMask = (uint8)_mm_movemask_ps(speedHit);
+    result->accelMask = (uint8)_mm_movemask_ps(accelHit);
+}
+
+#elif defined(ABS_KERNEL_NEON)
+
+/**
+ * @brief Collapse a NEON lane mask into one bit per wheel
+ */
+static uint8 ABS_LaneMaskToBits(uint32x4_t laneMask)
+{
+    const uint32_t laneBits[WHEEL_MAX] = {1U, 2U, 4U, 8U};
+    
+    return (uint8)vaddvq_u32(vandq_u32(laneMask, vld1q_u32(laneBits)));
+}
+
+/**
+ * @brief Run drift, plausibility and severity checks for four wheels (NEON)
+ */
+static void ABS_CheckWheels(const ABS_BatchContext_t* ctx, uint16 vehicleIdx, ABS_WheelCheckResult_t* result)
+{
+    const ABS_DetectionParameters_t* params = &ctx->params;
+    const boolean* speedValid = ctx->speedValid[vehicleIdx];
+    const uint32_t validInit[WHEEL_MAX] = {
+        (speedValid[0] == TRUE) ? 0xFFFFFFFFU : 0U, (speedValid[1] == TRUE) ? 0xFFFFFFFFU : 0U,
+        (speedValid[2] == TRUE) ? 0xFFFFFFFFU : 0U, (speedValid[3] == TRUE) ? 0xFFFFFFFFU : 0U
+    };
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    uint32x4_t valid = vld1q_u32(validInit);
+    uint32x4_t notBraking = vdupq_n_u32((ctx->brakePedalPressed[vehicleIdx] == FALSE) ? 0xFFFFFFFFU : 0U);
+    uint32x4_t enableDrift = vdupq_n_u32((params->enableMiscalibrationDetection == TRUE) ? 0xFFFFFFFFU : 0U);
+    uint32x4_t enableSpeed = vdupq_n_u32((params->enableSpeedPlausibilityCheck == TRUE) ? 0xFFFFFFFFU : 0U);
+    uint32x4_t enableAccel = vdupq_n_u32((params->enableAccelerationCheck == TRUE) ? 0xFFFFFFFFU : 0U);
+    float32x4_t drift, speedDev, accelAbs, deviation;
+    uint32x4_t driftHit, speedHit, accelHit;
+    int32x4_t sevDrift, sevSpeed, sevAccel;
+    uint32x4_t severity;
+    uint32_t sevOut[WHEEL_MAX];
+    uint8 wheelIdx;
+    
+    /* Deviation magnitudes */
+    drift = vmulq_n_f32(vabsq_f32(vsubq_f32(vld1q_f32(ctx->correctionFactor[vehicleIdx]), vdupq_n_f32(1.0f))),
+                        100.0f);
+    speedDev = vbslq_f32(valid, vabsq_f32(vsubq_f32(vld1q_f32(ctx->wheelSpeed[vehicleIdx]),
+                                                    vdupq_n_f32(ctx->referenceSpeed[vehicleIdx]))), zero);
+    accelAbs = vbslq_f32(valid, vabsq_f32(vld1q_f32(ctx->accelerationX[vehicleIdx])), zero);
+    
+    /* Check hits in priority order: drift, speed plausibility, acceleration */
+    driftHit = vandq_u32(enableDrift, vcgtq_f32(drift, vdupq_n_f32(params->calibrationDriftThreshold)));
+    speedHit = vornq_u32(vcgtq_f32(speedDev, vdupq_n_f32(params->speedDifferenceThreshold)), valid);
+    speedHit = vbicq_u32(vandq_u32(enableSpeed, speedHit), driftHit);
+    accelHit = vornq_u32(vandq_u32(notBraking, vcgtq_f32(accelAbs, vdupq_n_f32(params->accelerationThreshold))),
+                         valid);
+    accelHit = vbicq_u32(vandq_u32(enableAccel, accelHit), vorrq_u32(driftHit, speedHit));
+    
+    deviation = vbslq_f32(driftHit, drift, vbslq_f32(speedHit, speedDev, vbslq_f32(accelHit, accelAbs, zero)));
+    
+    /* Severity: base level plus one per exceeded limit (compare masks are -1) */
+    sevDrift = vsubq_s32(vdupq_n_s32(ABS_SEVERITY_LOW),
+                         vaddq_s32(vreinterpretq_s32_u32(vcgtq_f32(drift, vdupq_n_f32(5.0f))),
+                                   vaddq_s32(vreinterpretq_s32_u32(vcgtq_f32(drift, vdupq_n_f32(10.0f))),
+                                             vreinterpretq_s32_u32(vcgtq_f32(drift, vdupq_n_f32(15.0f))))));
+    sevSpeed = vsubq_s32(vdupq_n_s32(ABS_SEVERITY_LOW),
+                         vaddq_s32(vreinterpretq_s32_u32(vcgtq_f32(speedDev, vdupq_n_f32(20.0f))),
+                                   vaddq_s32(vreinterpretq_s32_u32(vcgtq_f32(speedDev, vdupq_n_f32(30.0f))),
+                                             vreinterpretq_s32_u32(vcgtq_f32(speedDev, vdupq_n_f32(50.0f))))));
+    sevAccel = vsubq_s32(vdupq_n_s32(ABS_SEVERITY_MEDIUM),
+                         vaddq_s32(vreinterpretq_s32_u32(vcgtq_f32(accelAbs, vdupq_n_f32(15.0f))),
+                                   vreinterpretq_s32_u32(vcgtq_f32(accelAbs, vdupq_n_f32(20.0f)))));
+    severity = vbslq_u32(driftHit, vreinterpretq_u32_s32(sevDrift),
+                         vbslq_u32(speedHit, vreinterpretq_u32_s32(sevSpeed),
+                                   vandq_u32(accelHit, vreinterpretq_u32_s32(sevAccel))));
+    
+    vst1q_f32(result->deviation, deviation);
+    vst1q_u32(sevOut, severity);
+    for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+    {
+        result->severity[wheelIdx] = (uint8)sevOut[wheelIdx];
+    }
+    
+    result->driftMask = ABS_LaneMaskToBits(driftHit);
+    result->speedMask = ABS_LaneMaskToBits(speedHit);
+    result->accelMask = ABS_LaneMaskToBits(accelHit);
+}
+
+#else
+
+/**
+ * @brief Run drift, plausibility and severity checks for four wheels (scalar)
+ */
+static void ABS_CheckWheels(const ABS_BatchContext_t* ctx, uint16 vehicleIdx, ABS_WheelCheckResult_t* result)
+{
+    const ABS_DetectionParameters_t* params = &ctx->params;
+    float32 deviation;
+    uint8 wheelIdx;
+    uint8 wheelBit;
+    
+    result->driftMask = 0U;
+    result->speedMask = 0U;
+    result->accelMask = 0U;
+    
+    for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
     {
-        /* Reset consecutive error count if no malfunction */
-        g_ConsecutiveErrorCount[wheelPos] = 0;
+        const boolean speedValid = ctx->speedValid[vehicleIdx][wheelIdx];
         
-        /* Clear malfunction if it was temporary */
-        if (g_MalfunctionStatus[wheelPos].isActive == TRUE)
+        wheelBit = (uint8)(1U << wheelIdx);
+        deviation = 0.0f;
+        result->severity[wheelIdx] = (uint8)ABS_SEVERITY_NONE;
+        
+        /* Check calibration drift */
+        if ((params->enableMiscalibrationDetection == TRUE) &&
+            (ABS_CheckCalibrationDrift(ctx->correctionFactor[vehicleIdx][wheelIdx],
+                                       params->calibrationDriftThreshold, &deviation) == TRUE))
+        {
+            result->driftMask |= wheelBit;
+            result->severity[wheelIdx] = (uint8)ABS_DetermineSeverity(ABS_MALFUNCTION_SPEED_SENSOR_MISCALIBRATION,
+                                                                      deviation);
+        }
+        /* Check speed plausibility */
+        else if ((params->enableSpeedPlausibilityCheck == TRUE) &&
+                 (ABS_CheckSpeedPlausibility(ctx->wheelSpeed[vehicleIdx][wheelIdx], speedValid,
+                                             ctx->referenceSpeed[vehicleIdx],
+                                             params->speedDifferenceThreshold, &deviation) == FALSE))
+        {
+            result->speedMask |= wheelBit;
+            result->severity[wheelIdx] = (uint8)ABS_DetermineSeverity(ABS_MALFUNCTION_SPEED_DIFFERENCE_EXCESSIVE,
+                                                                      deviation);
+        }
+        /* Check acceleration plausibility */
+        else if ((params->enableAccelerationCheck == TRUE) &&
+                 (ABS_CheckAccelerationPlausibility(ctx->accelerationX[vehicleIdx][wheelIdx], speedValid,
+                                                    ctx->brakePedalPressed[vehicleIdx],
+                                                    params->accelerationThreshold, &deviation) == FALSE))
+        {
+            result->accelMask |= wheelBit;
+            result->severity[wheelIdx] = (uint8)ABS_DetermineSeverity(ABS_MALFUNCTION_ACCELERATION_IMPLAUSIBLE,
+                                                                      deviation);
+        }
+        else
         {
-            g_DebounceCounters[wheelPos] = 0;
+            /* No malfunction on this wheel */
         }
+        
+        result->deviation[wheelIdx] = deviation;
     }
-    
-    return E_OK;
 }
 
+#endif
+
 /**
  * @brief Check for calibration drift
  */
-static boolean ABS_CheckCalibrationDrift(WheelPosition_t wheelPos, float32* driftPercentage)
+static boolean ABS_CheckCalibrationDrift(float32 correctionFactor, float32 threshold, float32* driftPercentage)
 {
-    SpeedSensorCalibration_t calibration;
     boolean isDrifted = FALSE;
     float32 expectedCorrectionFactor = 1.0f; /* Ideal correction factor */
     
-    if (SpeedSensor_GetCalibration(wheelPos, &calibration) == E_OK)
+    /* Calculate drift percentage */
+    *driftPercentage = fabsf((correctionFactor - expectedCorrectionFactor) / 
+                            expectedCorrectionFactor) * 100.0f;
+    
+    /* Check if drift exceeds threshold */
+    if (*driftPercentage > threshold)
     {
-        /* Calculate drift percentage */
-        *driftPercentage = fabsf((calibration.correctionFactor - expectedCorrectionFactor) / 
-                                expectedCorrectionFactor) * 100.0f;
-        
-        /* Check if drift exceeds threshold */
-        if (*driftPercentage > g_DetectionParams.calibrationDriftThreshold)
-        {
-            isDrifted = TRUE;
-        }
+        isDrifted = TRUE;
     }
     
     return isDrifted;
@@ -402,21 +886,17 @@ static boolean ABS_CheckCalibrationDrift(WheelPosition_t wheelPos, float32* drif
 /**
  * @brief Check speed plausibility
  */
-static boolean ABS_CheckSpeedPlausibility(WheelPosition_t wheelPos, float32* deviation)
+static boolean ABS_CheckSpeedPlausibility(float32 wheelSpeed, boolean speedValid, float32 referenceSpeed,
+                                          float32 threshold, float32* deviation)
 {
     boolean isPlausible = TRUE;
-    float32 referenceSpeed;
-    float32 wheelSpeed;
     
-    if (g_VehicleData.wheelSpeeds[wheelPos].speedValid == TRUE)
+    if (speedValid == TRUE)
     {
-        wheelSpeed = g_VehicleData.wheelSpeeds[wheelPos].wheelSpeed;
-        referenceSpeed = ABS_CalculateMedianSpeed();
-        
         *deviation = fabsf(wheelSpeed - referenceSpeed);
         
         /* Check if speed deviation exceeds threshold */
-        if (*deviation > g_DetectionParams.speedDifferenceThreshold)
+        if (*deviation > threshold)
         {
             isPlausible = FALSE;
         }
@@ -430,20 +910,22 @@ static boolean ABS_CheckSpeedPlausibility(WheelPosition_t wheelPos, float32* dev
     return isPlausible;
 }
 
+#if !defined(ABS_KERNEL_SSE2) && !defined(ABS_KERNEL_NEON)
+
 /**
  * @brief Check acceleration plausibility
  */
-static boolean ABS_CheckAccelerationPlausibility(WheelPosition_t wheelPos, float32* acceleration)
+static boolean ABS_CheckAccelerationPlausibility(float32 accelerationX, boolean speedValid, boolean brakePedalPressed,
+                                                 float32 threshold, float32* acceleration)
 {
     boolean isPlausible = TRUE;
     
-    if (g_VehicleData.wheelSpeeds[wheelPos].speedValid == TRUE)
+    if (speedValid == TRUE)
     {
-        *acceleration = fabsf(g_VehicleData.wheelSpeeds[wheelPos].accelerationX);
+        *acceleration = fabsf(accelerationX);
         
         /* Check if acceleration exceeds threshold (unless braking) */
-        if ((*acceleration > g_DetectionParams.accelerationThreshold) && 
-            (g_VehicleData.brakePedalPressed == FALSE))
+        if ((*acceleration > threshold) && (brakePedalPressed == FALSE))
         {
             isPlausible = FALSE;
         }
@@ -457,43 +939,85 @@ static boolean ABS_CheckAccelerationPlausibility(WheelPosition_t wheelPos, float
     return isPlausible;
 }
 
+#endif
+
 /**
  * @brief Update malfunction status
  */
-static void ABS_UpdateMalfunctionStatus(WheelPosition_t wheelPos, ABS_MalfunctionType_t type, 
+static void ABS_UpdateMalfunctionStatus(ABS_MalfunctionStatus_t* status, ABS_MalfunctionType_t type, 
                                        ABS_MalfunctionSeverity_t severity, float32 deviation)
 {
-    g_MalfunctionStatus[wheelPos].malfunctionType = type;
-    g_MalfunctionStatus[wheelPos].severity = severity;
-    g_MalfunctionStatus[wheelPos].isActive = TRUE;
-    g_MalfunctionStatus[wheelPos].deviationValue = deviation;
-    g_MalfunctionStatus[wheelPos].detectionTimestamp = 0; /* Should be actual timestamp */
-    g_MalfunctionStatus[wheelPos].occurrenceCount++;
+    status->malfunctionType = type;
+    status->severity = severity;
+    status->isActive = TRUE;
+    status->deviationValue = deviation;
+    status->detectionTimestamp = 0; /* Should be actual timestamp */
+    status->occurrenceCount++;
 }
 
 /**
  * @brief Process debouncing logic
  */
-static void ABS_ProcessDebouncing(WheelPosition_t wheelPos)
+static void ABS_ProcessDebouncing(ABS_BatchContext_t* ctx, uint16 vehicleIdx, uint8 wheelIdx)
 {
-    if (g_MalfunctionStatus[wheelPos].isActive == TRUE)
+    ABS_MalfunctionStatus_t* status = &ctx->malfunctionStatus[vehicleIdx][wheelIdx];
+    uint16* debounceCounter = &ctx->debounceCounter[vehicleIdx][wheelIdx];
+    
+    if (status->isActive == TRUE)
     {
-        g_DebounceCounters[wheelPos] += ABS_DETECTION_CYCLE_MS;
+        *debounceCounter += ABS_DETECTION_CYCLE_MS;
         
         /* Confirm malfunction after debounce time */
-        if (g_DebounceCounters[wheelPos] >= g_DetectionParams.debounceTimeMs)
+        if (*debounceCounter >= ctx->params.debounceTimeMs)
         {
-            g_MalfunctionStatus[wheelPos].confirmedMalfunction = TRUE;
+            status->confirmedMalfunction = TRUE;
         }
     }
     else
     {
         /* Reset debounce counter */
-        g_DebounceCounters[wheelPos] = 0;
-        g_MalfunctionStatus[wheelPos].confirmedMalfunction = FALSE;
+        *debounceCounter = 0;
+        status->confirmedMalfunction = FALSE;
+    }
+}
+
+/**
+ * @brief Clear the malfunction status of one wheel if a clear was requested since the last cycle
+ */
+static void ABS_ApplyClearRequest(ABS_BatchContext_t* ctx, uint16 vehicleIdx, uint8 wheelIdx)
+{
+    ABS_MalfunctionStatus_t* status = &ctx->malfunctionStatus[vehicleIdx][wheelIdx];
+    const uint8 request = ctx->clearRequest[vehicleIdx][wheelIdx];
+    
+    if (request != ctx->clearApplied[vehicleIdx][wheelIdx])
+    {
+        ctx->clearApplied[vehicleIdx][wheelIdx] = request;
+        status->isActive = FALSE;
+        status->confirmedMalfunction = FALSE;
+        status->malfunctionType = ABS_MALFUNCTION_NONE;
+        status->severity = ABS_SEVERITY_NONE;
+        ctx->debounceCounter[vehicleIdx][wheelIdx] = 0;
+        ctx->consecutiveErrorCount[vehicleIdx][wheelIdx] = 0;
     }
 }
 
+/**
+ * @brief Publish a status change event if the confirmed state or confirmed type changed
+ */
+static void ABS_PublishStatusChange(ABS_BatchContext_t* ctx, uint16 vehicleIdx, uint8 wheelIdx,
+                                    boolean wasConfirmed, ABS_MalfunctionType_t previousType)
+{
+    const ABS_MalfunctionStatus_t* status = &ctx->malfunctionStatus[vehicleIdx][wheelIdx];
+    
+    if ((status->confirmedMalfunction != wasConfirmed) ||
+        ((status->confirmedMalfunction == TRUE) && (status->malfunctionType != previousType)))
+    {
+        ctx->statusChangeCounter[vehicleIdx][wheelIdx]++;
+    }
+}
+
+#if !defined(ABS_KERNEL_SSE2) && !defined(ABS_KERNEL_NEON)
+
 /**
  * @brief Determine malfunction severity
  */
@@ -531,11 +1055,14 @@ static ABS_MalfunctionSeverity_t ABS_DetermineSeverity(ABS_MalfunctionType_t typ
     return severity;
 }
 
+#endif
+
 /**
  * @brief Update overall system state
  */
-static void ABS_UpdateSystemState(void)
+static void ABS_UpdateSystemState(ABS_BatchContext_t* ctx, uint16 vehicleIdx)
 {
+    const ABS_MalfunctionStatus_t* status = ctx->malfunctionStatus[vehicleIdx];
     uint8 wheelIdx;
     uint8 criticalMalfunctions = 0;
     uint8 activeMalfunctions = 0;
@@ -543,11 +1070,11 @@ static void ABS_UpdateSystemState(void)
     /* Count malfunctions by severity */
     for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
     {
-        if (g_MalfunctionStatus[wheelIdx].confirmedMalfunction == TRUE)
+        if (status[wheelIdx].confirmedMalfunction == TRUE)
         {
             activeMalfunctions++;
             
-            if (g_MalfunctionStatus[wheelIdx].severity >= ABS_SEVERITY_HIGH)
+            if (status[wheelIdx].severity >= ABS_SEVERITY_HIGH)
             {
                 criticalMalfunctions++;
             }
@@ -557,69 +1084,122 @@ static void ABS_UpdateSystemState(void)
     /* Determine system state */
     if (criticalMalfunctions > 0)
     {
-        g_SystemState = ABS_STATE_MALFUNCTION;
+        ctx->systemState[vehicleIdx] = ABS_STATE_MALFUNCTION;
     }
     else if (activeMalfunctions > 0)
     {
-        g_SystemState = ABS_STATE_DEGRADED;
+        ctx->systemState[vehicleIdx] = ABS_STATE_DEGRADED;
     }
     else
     {
-        g_SystemState = ABS_STATE_MONITORING;
+        ctx->systemState[vehicleIdx] = ABS_STATE_MONITORING;
     }
 }
 
 /**
- * @brief Calculate median speed from all valid wheel speeds
+ * @brief Get the reference speed of one vehicle, computing it once per data update
  */
-static float32 ABS_CalculateMedianSpeed(void)
+static float32 ABS_GetReferenceSpeed(ABS_BatchContext_t* ctx, uint16 vehicleIdx)
 {
-    float32 validSpeeds[WHEEL_MAX];
-    uint8 validCount = 0;
-    uint8 wheelIdx;
-    float32 medianSpeed = 0.0f;
-    
-    /* Collect valid speeds */
-    for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
-    {
-        if (g_VehicleData.wheelSpeeds[wheelIdx].speedValid == TRUE)
-        {
-            validSpeeds[validCount] = g_VehicleData.wheelSpeeds[wheelIdx].wheelSpeed;
-            validCount++;
-        }
-    }
+    float32 cycleMedian;
+    uint8 historyIdx;
     
-    /* Calculate median (simplified for 4 wheels) */
-    if (validCount >= 2)
+    if (ctx->referenceValid[vehicleIdx] == FALSE)
     {
-        /* Simple sorting for small array */
-        for (uint8 i = 0; i < validCount - 1; i++)
+        cycleMedian = ABS_CalculateMedianSpeed(ctx->wheelSpeed[vehicleIdx], ctx->speedValid[vehicleIdx]);
+        
+        if (ctx->referenceWindowSize > 1U)
         {
-            for (uint8 j = 0; j < validCount - i - 1; j++)
+            /* Push into the sliding window and take the median across cycles */
+            historyIdx = ctx->referenceHistoryIdx[vehicleIdx];
+            ctx->referenceHistory[vehicleIdx][historyIdx] = cycleMedian;
+            ctx->referenceHistoryIdx[vehicleIdx] = (uint8)((historyIdx + 1U) % ctx->referenceWindowSize);
+            if (ctx->referenceHistoryCount[vehicleIdx] < ctx->referenceWindowSize)
             {
-                if (validSpeeds[j] > validSpeeds[j + 1])
-                {
-                    float32 temp = validSpeeds[j];
-                    validSpeeds[j] = validSpeeds[j + 1];
-                    validSpeeds[j + 1] = temp;
-                }
+                ctx->referenceHistoryCount[vehicleIdx]++;
             }
-        }
-        
-        /* Get median value */
-        if (validCount % 2 == 0)
-        {
-            medianSpeed = (validSpeeds[validCount/2 - 1] + validSpeeds[validCount/2]) / 2.0f;
+            
+            ctx->referenceSpeed[vehicleIdx] = ABS_CalculateWindowMedian(ctx->referenceHistory[vehicleIdx],
+                                                                         ctx->referenceHistoryCount[vehicleIdx]);
         }
         else
         {
-            medianSpeed = validSpeeds[validCount/2];
+            ctx->referenceSpeed[vehicleIdx] = cycleMedian;
         }
+        
+        ctx->referenceValid[vehicleIdx] = TRUE;
+    }
+    
+    return ctx->referenceSpeed[vehicleIdx];
+}
+
+/**
+ * @brief Calculate median speed from all valid wheel speeds
+ *
+ * Invalid wheels are replaced by +infinity so they sort to the top, then the
+ * four values are ordered by a fixed 5-comparator sorting network. The median
+ * of the n valid speeds is the mean of sorted[(n-1)/2] and sorted[n/2].
+ */
+static float32 ABS_CalculateMedianSpeed(const float32 wheelSpeed[WHEEL_MAX], const boolean speedValid[WHEEL_MAX])
+{
+    float32 s0 = (speedValid[WHEEL_FRONT_LEFT] == TRUE) ? wheelSpeed[WHEEL_FRONT_LEFT] : HUGE_VALF;
+    float32 s1 = (speedValid[WHEEL_FRONT_RIGHT] == TRUE) ? wheelSpeed[WHEEL_FRONT_RIGHT] : HUGE_VALF;
+    float32 s2 = (speedValid[WHEEL_REAR_LEFT] == TRUE) ? wheelSpeed[WHEEL_REAR_LEFT] : HUGE_VALF;
+    float32 s3 = (speedValid[WHEEL_REAR_RIGHT] == TRUE) ? wheelSpeed[WHEEL_REAR_RIGHT] : HUGE_VALF;
+    float32 sorted[WHEEL_MAX];
+    float32 lo;
+    uint8 validCount;
+    float32 medianSpeed = 0.0f;
+    
+    validCount = (uint8)((speedValid[WHEEL_FRONT_LEFT] == TRUE) + (speedValid[WHEEL_FRONT_RIGHT] == TRUE) +
+                         (speedValid[WHEEL_REAR_LEFT] == TRUE) + (speedValid[WHEEL_REAR_RIGHT] == TRUE));
+    
+    /* Sorting network for 4 elements: (0,1)(2,3)(0,2)(1,3)(1,2) */
+    lo = fminf(s0, s1); s1 = fmaxf(s0, s1); s0 = lo;
+    lo = fminf(s2, s3); s3 = fmaxf(s2, s3); s2 = lo;
+    lo = fminf(s0, s2); s2 = fmaxf(s0, s2); s0 = lo;
+    lo = fminf(s1, s3); s3 = fmaxf(s1, s3); s1 = lo;
+    lo = fminf(s1, s2); s2 = fmaxf(s1, s2); s1 = lo;
+    
+    sorted[0] = s0;
+    sorted[1] = s1;
+    sorted[2] = s2;
+    sorted[3] = s3;
+    
+    if (validCount >= 2U)
+    {
+        medianSpeed = (sorted[(validCount - 1U) / 2U] + sorted[validCount / 2U]) / 2.0f;
     }
     
     return medianSpeed;
 }
 
+/**
+ * @brief Calculate median of the reference speed window history
+ */
+static float32 ABS_CalculateWindowMedian(const float32 history[ABS_REFERENCE_WINDOW_MAX], uint8 count)
+{
+    float32 sorted[ABS_REFERENCE_WINDOW_MAX];
+    float32 value;
+    uint8 i;
+    uint8 j;
+    
+    /* Insertion sort, window is at most ABS_REFERENCE_WINDOW_MAX entries */
+    for (i = 0; i < count; i++)
+    {
+        value = history[i];
+        j = i;
+        while ((j > 0U) && (sorted[j - 1U] > value))
+        {
+            sorted[j] = sorted[j - 1U];
+            j--;
+        }
+        sorted[j] = value;
+    }
+    
+    return (sorted[(count - 1U) / 2U] + sorted[count / 2U]) / 2.0f;
+}
+
 /* RTE Runnable Functions */
 
 /**
@@ -627,11 +1207,13 @@ static float32 ABS_CalculateMedianSpeed(void)
  */
 void RE_ABS_MalfunctionDetection_MainCyclic(void)
 {
+    ABS_MalfunctionStatus_t status;
+    
+    RUNNABLE_TIMING_START(RUNNABLE_ABS_DETECTION_MAIN);
+    
     ABS_MalfunctionDetection_MainFunction();
     
     /* Send malfunction status via RTE */
-    ABS_MalfunctionStatus_t status;
-    
     if (ABS_GetMalfunctionStatus(WHEEL_FRONT_LEFT, &status) == E_OK)
     {
         Rte_Write_MalfunctionStatus_FL_status(&status);
@@ -653,7 +1235,9 @@ void RE_ABS_MalfunctionDetection_MainCyclic(void)
     }
     
     /* Send system state */
-    Rte_Write_SystemState_state(&g_SystemState);
+    Rte_Write_SystemState_state(&g_ABS_Context.systemState[ABS_SINGLE_VEHICLE_IDX]);
+    
+    RUNNABLE_TIMING_STOP(RUNNABLE_ABS_DETECTION_MAIN);
 }
 
 /**
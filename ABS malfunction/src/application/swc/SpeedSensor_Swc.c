@@ -5,18 +5,37 @@
  */
 
 #include "SpeedSensor_Interface.h"
+#include "RunnableTiming.h"
 #include "Std_Types.h"
 #include <string.h>
 
-/* Local data storage for speed sensors */
-static SpeedSensorData_t g_SpeedSensorData[WHEEL_MAX];
+/* The cyclic processing touches one line per wheel (not checked on LP64 hosts, where uint32 is 8 bytes) */
+typedef char SpeedSensor_HotDataSizeCheck_t[((sizeof(SpeedSensorHotData_t) <= SPEED_SENSOR_CACHE_LINE_SIZE) ||
+                                             (sizeof(uint32) > 4U)) ? 1 : -1];
+
+/* Local data storage for speed sensors: per-sample state, counters updated every
+ * cycle (one line for all wheels) and calibration, which only the services use */
+static SpeedSensorHotData_t g_SpeedSensorHot[WHEEL_MAX] SPEED_SENSOR_CACHE_ALIGNED;
+static SpeedSensorDiagnostics_t g_SpeedSensorDiagnostics[WHEEL_MAX];
+static SpeedSensorCalibration_t g_SpeedSensorCalibration[WHEEL_MAX];
 static boolean g_SpeedSensor_Initialized = FALSE;
 
+/* 1/timeInterval for intervals 1..SPEED_SENSOR_RECIPROCAL_TABLE_SIZE-1 ms (index 0 unused) */
+#if defined(SPEED_SENSOR_FIXED_POINT)
+/* Q12 scale x Q24 reciprocal gives Q36; shift down to Q8 speed */
+#define SPEED_SENSOR_FIXED_SHIFT        (SPEED_SENSOR_SCALE_Q_BITS + SPEED_SENSOR_RECIPROCAL_Q_BITS - SPEED_SENSOR_SPEED_Q_BITS)
+static uint32 g_IntervalReciprocal[SPEED_SENSOR_RECIPROCAL_TABLE_SIZE];
+#else
+static float32 g_IntervalReciprocal[SPEED_SENSOR_RECIPROCAL_TABLE_SIZE];
+#endif
+
 /* Internal function prototypes */
 static Std_ReturnType SpeedSensor_ProcessRawData(WheelPosition_t wheelPos);
 static Std_ReturnType SpeedSensor_CalculateSpeed(WheelPosition_t wheelPos);
 static Std_ReturnType SpeedSensor_ValidateSpeedData(WheelPosition_t wheelPos);
 static void SpeedSensor_UpdateDiagnostics(WheelPosition_t wheelPos);
+static void SpeedSensor_UpdateScale(WheelPosition_t wheelPos);
+static float32 SpeedSensor_FilterAcceleration(SpeedAccelFilterState_t* filter, float32 speed);
 
 /**
  * @brief Initialize speed sensor interface
@@ -25,26 +44,44 @@ Std_ReturnType SpeedSensor_Init(void)
 {
     Std_ReturnType retVal = E_OK;
     uint8 wheelIdx;
+    uint16 interval;
     
     if (g_SpeedSensor_Initialized == FALSE)
     {
+        /* Build reciprocal table for the speed computation */
+        g_IntervalReciprocal[0] = 0;
+        for (interval = 1; interval < SPEED_SENSOR_RECIPROCAL_TABLE_SIZE; interval++)
+        {
+#if defined(SPEED_SENSOR_FIXED_POINT)
+            g_IntervalReciprocal[interval] = (uint32)((((uint32)1U << SPEED_SENSOR_RECIPROCAL_Q_BITS) +
+                                                       (interval / 2U)) / interval);
+#else
+            g_IntervalReciprocal[interval] = 1.0f / (float32)interval;
+#endif
+        }
+        
         /* Initialize all wheel sensor data */
+        memset(g_SpeedSensorHot, 0, sizeof(g_SpeedSensorHot));
+        memset(g_SpeedSensorDiagnostics, 0, sizeof(g_SpeedSensorDiagnostics));
+        memset(g_SpeedSensorCalibration, 0, sizeof(g_SpeedSensorCalibration));
+        
         for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
         {
-            memset(&g_SpeedSensorData[wheelIdx], 0, sizeof(SpeedSensorData_t));
-            
             /* Set default values */
-            g_SpeedSensorData[wheelIdx].wheelPosition = (WheelPosition_t)wheelIdx;
-            g_SpeedSensorData[wheelIdx].rawData.status = SENSOR_STATUS_INVALID;
-            g_SpeedSensorData[wheelIdx].rawData.dataValid = FALSE;
-            g_SpeedSensorData[wheelIdx].speedData.speedValid = FALSE;
+            g_SpeedSensorHot[wheelIdx].status = (uint8)SENSOR_STATUS_INVALID;
+            g_SpeedSensorHot[wheelIdx].dataValid = FALSE;
+            g_SpeedSensorHot[wheelIdx].speedData.speedValid = FALSE;
             
             /* Default calibration parameters */
-            g_SpeedSensorData[wheelIdx].calibration.correctionFactor = 1.0f;
-            g_SpeedSensorData[wheelIdx].calibration.offsetValue = 0.0f;
-            g_SpeedSensorData[wheelIdx].calibration.pulsesPerRevolution = 60; /* Typical ABS sensor */
-            g_SpeedSensorData[wheelIdx].calibration.wheelCircumference = 2.1f; /* Meters */
-            g_SpeedSensorData[wheelIdx].calibration.calibrationValid = TRUE;
+            g_SpeedSensorCalibration[wheelIdx].correctionFactor = 1.0f;
+            g_SpeedSensorCalibration[wheelIdx].offsetValue = 0.0f;
+            g_SpeedSensorCalibration[wheelIdx].pulsesPerRevolution = 60; /* Typical ABS sensor */
+            g_SpeedSensorCalibration[wheelIdx].wheelCircumference = 2.1f; /* Meters */
+            g_SpeedSensorCalibration[wheelIdx].calibrationValid = TRUE;
+            SpeedSensor_UpdateScale((WheelPosition_t)wheelIdx);
+            
+            /* Acceleration filter primes itself with the first speed sample */
+            g_SpeedSensorHot[wheelIdx].accelFilter.type = (uint8)SPEED_ACCEL_FILTER_DEFAULT;
         }
         
         g_SpeedSensor_Initialized = TRUE;
@@ -100,7 +137,10 @@ Std_ReturnType SpeedSensor_ReadRawData(WheelPosition_t wheelPos, SpeedSensorRawD
     
     if ((wheelPos < WHEEL_MAX) && (rawData != NULL_PTR) && (g_SpeedSensor_Initialized == TRUE))
     {
-        *rawData = g_SpeedSensorData[wheelPos].rawData;
+        rawData->pulseCount = g_SpeedSensorHot[wheelPos].pulseCount;
+        rawData->timeInterval = g_SpeedSensorHot[wheelPos].timeInterval;
+        rawData->status = (SensorStatus_t)g_SpeedSensorHot[wheelPos].status;
+        rawData->dataValid = g_SpeedSensorHot[wheelPos].dataValid;
         retVal = E_OK;
     }
     
@@ -116,7 +156,7 @@ Std_ReturnType SpeedSensor_GetSpeedData(WheelPosition_t wheelPos, SpeedData_t* s
     
     if ((wheelPos < WHEEL_MAX) && (speedData != NULL_PTR) && (g_SpeedSensor_Initialized == TRUE))
     {
-        *speedData = g_SpeedSensorData[wheelPos].speedData;
+        *speedData = g_SpeedSensorHot[wheelPos].speedData;
         retVal = E_OK;
     }
     
@@ -136,11 +176,12 @@ Std_ReturnType SpeedSensor_SetCalibration(WheelPosition_t wheelPos, const SpeedS
         if ((calibration->correctionFactor > 0.5f) && (calibration->correctionFactor < 2.0f) &&
             (calibration->pulsesPerRevolution > 0) && (calibration->wheelCircumference > 0.0f))
         {
-            g_SpeedSensorData[wheelPos].calibration = *calibration;
-            g_SpeedSensorData[wheelPos].calibration.calibrationValid = TRUE;
+            g_SpeedSensorCalibration[wheelPos] = *calibration;
+            g_SpeedSensorCalibration[wheelPos].calibrationValid = TRUE;
+            SpeedSensor_UpdateScale(wheelPos);
             
             /* Increment calibration cycle counter */
-            g_SpeedSensorData[wheelPos].diagnostics.calibrationCycles++;
+            g_SpeedSensorDiagnostics[wheelPos].calibrationCycles++;
             
             retVal = E_OK;
         }
@@ -158,7 +199,7 @@ Std_ReturnType SpeedSensor_GetCalibration(WheelPosition_t wheelPos, SpeedSensorC
     
     if ((wheelPos < WHEEL_MAX) && (calibration != NULL_PTR) && (g_SpeedSensor_Initialized == TRUE))
     {
-        *calibration = g_SpeedSensorData[wheelPos].calibration;
+        *calibration = g_SpeedSensorCalibration[wheelPos];
         retVal = E_OK;
     }
     
@@ -171,11 +212,11 @@ Std_ReturnType SpeedSensor_GetCalibration(WheelPosition_t wheelPos, SpeedSensorC
 Std_ReturnType SpeedSensor_ValidateCalibration(WheelPosition_t wheelPos, boolean* isValid)
 {
     Std_ReturnType retVal = E_NOT_OK;
-    SpeedSensorCalibration_t* cal;
+    const SpeedSensorCalibration_t* cal;
     
     if ((wheelPos < WHEEL_MAX) && (isValid != NULL_PTR) && (g_SpeedSensor_Initialized == TRUE))
     {
-        cal = &g_SpeedSensorData[wheelPos].calibration;
+        cal = &g_SpeedSensorCalibration[wheelPos];
         
         /* Check calibration parameter ranges */
         *isValid = (cal->correctionFactor >= 0.8f) && (cal->correctionFactor <= 1.2f) &&
@@ -189,6 +230,24 @@ Std_ReturnType SpeedSensor_ValidateCalibration(WheelPosition_t wheelPos, boolean
     return retVal;
 }
 
+/**
+ * @brief Select the acceleration derivative filter for a wheel
+ */
+Std_ReturnType SpeedSensor_SetAccelerationFilter(WheelPosition_t wheelPos, SpeedAccelFilter_t filter)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    
+    if ((wheelPos < WHEEL_MAX) && (filter <= SPEED_ACCEL_FILTER_SAVITZKY_GOLAY) &&
+        (g_SpeedSensor_Initialized == TRUE))
+    {
+        g_SpeedSensorHot[wheelPos].accelFilter.type = (uint8)filter;
+        g_SpeedSensorHot[wheelPos].accelFilter.sampleCount = 0;
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
+
 /**
  * @brief Get sensor diagnostic information
  */
@@ -198,7 +257,7 @@ Std_ReturnType SpeedSensor_GetDiagnostics(WheelPosition_t wheelPos, SpeedSensorD
     
     if ((wheelPos < WHEEL_MAX) && (diagnostics != NULL_PTR) && (g_SpeedSensor_Initialized == TRUE))
     {
-        *diagnostics = g_SpeedSensorData[wheelPos].diagnostics;
+        *diagnostics = g_SpeedSensorDiagnostics[wheelPos];
         retVal = E_OK;
     }
     
@@ -214,8 +273,8 @@ Std_ReturnType SpeedSensor_ClearErrors(WheelPosition_t wheelPos)
     
     if ((wheelPos < WHEEL_MAX) && (g_SpeedSensor_Initialized == TRUE))
     {
-        g_SpeedSensorData[wheelPos].diagnostics.errorCount = 0;
-        g_SpeedSensorData[wheelPos].diagnostics.lastErrorTimestamp = 0;
+        g_SpeedSensorDiagnostics[wheelPos].errorCount = 0;
+        g_SpeedSensorDiagnostics[wheelPos].lastErrorTimestamp = 0;
         retVal = E_OK;
     }
     
@@ -237,8 +296,8 @@ Std_ReturnType SpeedSensor_CheckAllSensors(boolean* allSensorsOk)
         /* Check all wheel sensors */
         for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
         {
-            if ((g_SpeedSensorData[wheelIdx].rawData.status != SENSOR_STATUS_OK) ||
-                (g_SpeedSensorData[wheelIdx].speedData.speedValid != TRUE))
+            if ((g_SpeedSensorHot[wheelIdx].status != (uint8)SENSOR_STATUS_OK) ||
+                (g_SpeedSensorHot[wheelIdx].speedData.speedValid != TRUE))
             {
                 *allSensorsOk = FALSE;
                 break;
@@ -283,7 +342,10 @@ static Std_ReturnType SpeedSensor_ProcessRawData(WheelPosition_t wheelPos)
     
     if (retVal == E_OK)
     {
-        g_SpeedSensorData[wheelPos].rawData = rawData;
+        g_SpeedSensorHot[wheelPos].pulseCount = rawData.pulseCount;
+        g_SpeedSensorHot[wheelPos].timeInterval = rawData.timeInterval;
+        g_SpeedSensorHot[wheelPos].status = (uint8)rawData.status;
+        g_SpeedSensorHot[wheelPos].dataValid = rawData.dataValid;
     }
     
     return retVal;
@@ -295,42 +357,73 @@ static Std_ReturnType SpeedSensor_ProcessRawData(WheelPosition_t wheelPos)
 static Std_ReturnType SpeedSensor_CalculateSpeed(WheelPosition_t wheelPos)
 {
     Std_ReturnType retVal = E_OK;
-    SpeedSensorData_t* sensorData = &g_SpeedSensorData[wheelPos];
+    SpeedSensorHotData_t* sensorData = &g_SpeedSensorHot[wheelPos];
+    const SpeedSensorScale_t* scale = &sensorData->scale;
+    uint16 interval = sensorData->timeInterval;
+#if defined(SPEED_SENSOR_FIXED_POINT)
+    uint32 rawSpeedQ;
+    sint32 wheelSpeedQ;
+#else
     float32 rawSpeed;
-    float32 timeInSeconds;
+#endif
     
-    /* Calculate raw speed from pulse count and time interval */
-    if ((sensorData->rawData.timeInterval > 0) && 
-        (sensorData->calibration.pulsesPerRevolution > 0))
+    /* Calculate raw speed from pulse count and time interval (pulsesPerRevolution > 0 is
+     * guaranteed by SpeedSensor_SetCalibration) */
+    if (interval > 0)
     {
-        timeInSeconds = (float32)sensorData->rawData.timeInterval / 1000.0f;
+        /* speed [km/h] = pulses / interval [ms] * circumference * 3600 / pulsesPerRevolution */
+#if defined(SPEED_SENSOR_FIXED_POINT)
+        if (interval < SPEED_SENSOR_RECIPROCAL_TABLE_SIZE)
+        {
+            rawSpeedQ = (uint32)((((uint64)sensorData->pulseCount * scale->pulseScaleQ *
+                                   g_IntervalReciprocal[interval]) +
+                                  ((uint64)1U << (SPEED_SENSOR_FIXED_SHIFT - 1U))) >>
+                                 SPEED_SENSOR_FIXED_SHIFT);
+        }
+        else
+        {
+            rawSpeedQ = (uint32)((((uint64)sensorData->pulseCount * scale->pulseScaleQ) +
+                                  ((uint64)interval << (SPEED_SENSOR_SCALE_Q_BITS - SPEED_SENSOR_SPEED_Q_BITS - 1U))) /
+                                 ((uint64)interval << (SPEED_SENSOR_SCALE_Q_BITS - SPEED_SENSOR_SPEED_Q_BITS)));
+        }
         
-        /* Calculate RPM first */
-        float32 rpm = ((float32)sensorData->rawData.pulseCount / 
-                      (float32)sensorData->calibration.pulsesPerRevolution) / timeInSeconds * 60.0f;
+        /* Apply calibration correction */
+        wheelSpeedQ = (sint32)((((uint64)rawSpeedQ * scale->correctionFactorQ) +
+                                ((uint64)1U << (SPEED_SENSOR_FACTOR_Q_BITS - 1U))) >>
+                               SPEED_SENSOR_FACTOR_Q_BITS) + scale->offsetQ;
         
-        /* Convert to linear speed in km/h */
-        rawSpeed = rpm * sensorData->calibration.wheelCircumference * 60.0f / 1000.0f;
+        sensorData->speedData.wheelSpeedRaw = (float32)rawSpeedQ * (1.0f / (float32)(1U << SPEED_SENSOR_SPEED_Q_BITS));
+        sensorData->speedData.wheelSpeed = (float32)wheelSpeedQ * (1.0f / (float32)(1U << SPEED_SENSOR_SPEED_Q_BITS));
+#else
+        if (interval < SPEED_SENSOR_RECIPROCAL_TABLE_SIZE)
+        {
+            rawSpeed = (float32)sensorData->pulseCount * g_IntervalReciprocal[interval] * scale->pulseScale;
+        }
+        else
+        {
+            rawSpeed = (float32)sensorData->pulseCount / (float32)interval * scale->pulseScale;
+        }
         
         /* Apply calibration correction */
         sensorData->speedData.wheelSpeedRaw = rawSpeed;
-        sensorData->speedData.wheelSpeed = rawSpeed * sensorData->calibration.correctionFactor + 
-                                          sensorData->calibration.offsetValue;
+        sensorData->speedData.wheelSpeed = rawSpeed * scale->correctionFactor + scale->offsetValue;
+#endif
         
-        /* Calculate acceleration (simple difference) */
-        static float32 lastSpeed[WHEEL_MAX] = {0.0f};
-        sensorData->speedData.accelerationX = (sensorData->speedData.wheelSpeed - lastSpeed[wheelPos]) / 
-                                             (SPEED_SENSOR_SAMPLE_RATE_MS / 1000.0f);
-        lastSpeed[wheelPos] = sensorData->speedData.wheelSpeed;
+        /* Calculate acceleration */
+        sensorData->speedData.accelerationX = SpeedSensor_FilterAcceleration(&sensorData->accelFilter,
+                                                                             sensorData->speedData.wheelSpeed);
         
         /* Update diagnostics */
-        sensorData->diagnostics.totalPulseCount += sensorData->rawData.pulseCount;
+        g_SpeedSensorDiagnostics[wheelPos].totalPulseCount += sensorData->pulseCount;
     }
     else
     {
         sensorData->speedData.wheelSpeed = 0.0f;
         sensorData->speedData.wheelSpeedRaw = 0.0f;
         sensorData->speedData.accelerationX = 0.0f;
+        
+        /* Restart the acceleration filter when pulse data returns */
+        sensorData->accelFilter.sampleCount = 0;
     }
     
     return retVal;
@@ -342,7 +435,7 @@ static Std_ReturnType SpeedSensor_CalculateSpeed(WheelPosition_t wheelPos)
 static Std_ReturnType SpeedSensor_ValidateSpeedData(WheelPosition_t wheelPos)
 {
     Std_ReturnType retVal = E_OK;
-    SpeedSensorData_t* sensorData = &g_SpeedSensorData[wheelPos];
+    SpeedSensorHotData_t* sensorData = &g_SpeedSensorHot[wheelPos];
     boolean speedValid = TRUE;
     uint8 qualityFactor = 100;
     
@@ -355,14 +448,14 @@ static Std_ReturnType SpeedSensor_ValidateSpeedData(WheelPosition_t wheelPos)
     }
     
     /* Check sensor status */
-    if (sensorData->rawData.status != SENSOR_STATUS_OK)
+    if (sensorData->status != (uint8)SENSOR_STATUS_OK)
     {
         speedValid = FALSE;
         qualityFactor = 0;
     }
     
     /* Check calibration validity */
-    if (sensorData->calibration.calibrationValid != TRUE)
+    if (sensorData->calibrationValid != TRUE)
     {
         speedValid = FALSE;
         qualityFactor = (qualityFactor > 50) ? 50 : qualityFactor;
@@ -386,17 +479,107 @@ static Std_ReturnType SpeedSensor_ValidateSpeedData(WheelPosition_t wheelPos)
  */
 static void SpeedSensor_UpdateDiagnostics(WheelPosition_t wheelPos)
 {
-    SpeedSensorData_t* sensorData = &g_SpeedSensorData[wheelPos];
+    const SpeedSensorHotData_t* sensorData = &g_SpeedSensorHot[wheelPos];
+    SpeedSensorDiagnostics_t* diagnostics = &g_SpeedSensorDiagnostics[wheelPos];
     
     /* Update error count if sensor has issues */
-    if ((sensorData->rawData.status != SENSOR_STATUS_OK) || 
+    if ((sensorData->status != (uint8)SENSOR_STATUS_OK) || 
         (sensorData->speedData.speedValid != TRUE))
     {
-        sensorData->diagnostics.errorCount++;
-        sensorData->diagnostics.lastErrorTimestamp = 0; /* Should be actual timestamp */
+        diagnostics->errorCount++;
+        diagnostics->lastErrorTimestamp = 0; /* Should be actual timestamp */
+    }
+    
+    diagnostics->lastStatus = (SensorStatus_t)sensorData->status;
+}
+
+/**
+ * @brief Precompute speed conversion from the current calibration
+ */
+static void SpeedSensor_UpdateScale(WheelPosition_t wheelPos)
+{
+    const SpeedSensorCalibration_t* cal = &g_SpeedSensorCalibration[wheelPos];
+    SpeedSensorScale_t* scale = &g_SpeedSensorHot[wheelPos].scale;
+    float32 pulseScale = 0.0f;
+#if defined(SPEED_SENSOR_FIXED_POINT)
+    float32 offsetQ;
+#endif
+    
+    if (cal->pulsesPerRevolution > 0)
+    {
+        /* km/h per (pulse/ms): revolutions per ms * circumference [m] * 3600 */
+        pulseScale = cal->wheelCircumference * 3600.0f / (float32)cal->pulsesPerRevolution;
+    }
+    
+#if defined(SPEED_SENSOR_FIXED_POINT)
+    scale->pulseScaleQ = (uint32)((pulseScale * (float32)(1U << SPEED_SENSOR_SCALE_Q_BITS)) + 0.5f);
+    scale->correctionFactorQ = (uint32)((cal->correctionFactor * (float32)(1U << SPEED_SENSOR_FACTOR_Q_BITS)) + 0.5f);
+    offsetQ = cal->offsetValue * (float32)(1U << SPEED_SENSOR_SPEED_Q_BITS);
+    scale->offsetQ = (sint32)(offsetQ + ((offsetQ >= 0.0f) ? 0.5f : -0.5f));
+#else
+    scale->pulseScale = pulseScale;
+    scale->correctionFactor = cal->correctionFactor;
+    scale->offsetValue = cal->offsetValue;
+#endif
+    g_SpeedSensorHot[wheelPos].calibrationValid = cal->calibrationValid;
+}
+
+/**
+ * @brief Wheel acceleration from the speed history (fixed-coefficient kernels)
+ */
+static float32 SpeedSensor_FilterAcceleration(SpeedAccelFilterState_t* filter, float32 speed)
+{
+    float32 acceleration;
+    uint8 tap;
+    
+    if (filter->sampleCount == 0U)
+    {
+        /* No history yet: start with zero acceleration */
+        for (tap = 0; tap < SPEED_ACCEL_FILTER_TAPS; tap++)
+        {
+            filter->speedHistory[tap] = speed;
+        }
+        filter->filteredAcceleration = 0.0f;
+        filter->sampleCount = 1;
+    }
+    else
+    {
+        for (tap = SPEED_ACCEL_FILTER_TAPS - 1U; tap > 0U; tap--)
+        {
+            filter->speedHistory[tap] = filter->speedHistory[tap - 1U];
+        }
+        filter->speedHistory[0] = speed;
+        
+        if (filter->sampleCount < SPEED_ACCEL_FILTER_TAPS)
+        {
+            filter->sampleCount++;
+        }
+    }
+    
+    switch (filter->type)
+    {
+        case SPEED_ACCEL_FILTER_IIR:
+            acceleration = (filter->speedHistory[0] - filter->speedHistory[1]) / 
+                           (SPEED_SENSOR_SAMPLE_RATE_MS / 1000.0f);
+            filter->filteredAcceleration += SPEED_ACCEL_IIR_ALPHA * (acceleration - filter->filteredAcceleration);
+            acceleration = filter->filteredAcceleration;
+            break;
+            
+        case SPEED_ACCEL_FILTER_SAVITZKY_GOLAY:
+            /* Quadratic fit over 5 samples, derivative at the centre: (2, 1, 0, -1, -2) / 10 */
+            acceleration = ((2.0f * (filter->speedHistory[0] - filter->speedHistory[4])) +
+                            (filter->speedHistory[1] - filter->speedHistory[3])) /
+                           (10.0f * (SPEED_SENSOR_SAMPLE_RATE_MS / 1000.0f));
+            break;
+            
+        case SPEED_ACCEL_FILTER_DIFFERENCE:
+        default:
+            acceleration = (filter->speedHistory[0] - filter->speedHistory[1]) / 
+                           (SPEED_SENSOR_SAMPLE_RATE_MS / 1000.0f);
+            break;
     }
     
-    sensorData->diagnostics.lastStatus = sensorData->rawData.status;
+    return acceleration;
 }
 
 /* RTE Runnable Functions */
@@ -406,11 +589,13 @@ static void SpeedSensor_UpdateDiagnostics(WheelPosition_t wheelPos)
  */
 void RE_SpeedSensor_MainCyclic(void)
 {
+    SpeedData_t speedData;
+    
+    RUNNABLE_TIMING_START(RUNNABLE_SPEED_SENSOR_MAIN);
+    
     SpeedSensor_MainFunction();
     
     /* Send speed data to other SWCs via RTE */
-    SpeedData_t speedData;
-    
     if (SpeedSensor_GetSpeedData(WHEEL_FRONT_LEFT, &speedData) == E_OK)
     {
         Rte_Write_SpeedData_FL_speedData(&speedData);
@@ -430,6 +615,8 @@ void RE_SpeedSensor_MainCyclic(void)
     {
         Rte_Write_SpeedData_RR_speedData(&speedData);
     }
+    
+    RUNNABLE_TIMING_STOP(RUNNABLE_SPEED_SENSOR_MAIN);
 }
 
 /**
@@ -6,35 +6,95 @@
 
 #include "CalibrationManager.h"
 #include "SpeedSensor_Interface.h"
+#include "RunnableTiming.h"
 #include <string.h>
 #include <math.h>
 
 /* Local data structures */
 static CalibrationSession_t g_CalibrationSessions[WHEEL_MAX];
 static CalibrationConfig_t g_CalibrationConfig;
-static CalibrationHistoryEntry_t g_CalibrationHistory[WHEEL_MAX][CALIBRATION_HISTORY_SIZE];
-static uint8 g_HistoryCount[WHEEL_MAX];
 static boolean g_CalibrationManager_Initialized = FALSE;
 
-/* Calibration sample data for ongoing calibrations */
+/* Packed calibration history record (8 bytes, same layout as the NVM image) */
 typedef struct {
-    float32 speedSamples[CALIBRATION_MAX_SAMPLES];
-    float32 referenceSamples[CALIBRATION_MAX_SAMPLES];
-    uint16 sampleCount;
+    uint16 timestampDelta;      /* History ticks since the previous record, saturating */
+    uint16 oldFactorQ14;        /* Correction factors, unsigned Q2.14 */
+    uint16 newFactorQ14;
+    uint8 methodResult;         /* Method in high nibble, result in low nibble */
+    uint8 accuracyHalfPercent;  /* Accuracy 0..100 % in 0.5 % steps */
+} CalibrationHistoryRecord_t;
+
+/* Calibration history ring per wheel, also the RAM mirror of its history NVM block */
+typedef struct {
+    CalibrationHistoryRecord_t records[CALIBRATION_HISTORY_SIZE];
+    uint32 oldestTicks;         /* Timestamp of the oldest record */
+    uint32 newestTicks;         /* Timestamp of the newest record */
+    uint8 head;                 /* Slot of the oldest record */
+    uint8 count;
+    uint8 reserved[sizeof(uint32) - 2U];
+} CalibrationHistoryRing_t;
+
+/* The ring is written to NVM as is: its size is the configured block size */
+typedef char CalibrationHistoryBlockSizeCheck_t[(sizeof(CalibrationHistoryRing_t) ==
+                                                 CALIBRATION_HISTORY_NVM_BLOCK_SIZE) ? 1 : -1];
+
+static CalibrationHistoryRing_t g_CalibrationHistory[WHEEL_MAX];
+static boolean g_HistoryNvmPending[WHEEL_MAX];  /* Written once no calibration block is queued */
+
+/* Running calibration statistics for ongoing calibrations (updated per sample, no sample storage) */
+typedef struct {
+    uint16 sampleCount;         /* Samples taken, including rejected ones */
+    uint16 validSamples;        /* Samples with positive speed and reference */
+    float32 sumSpeed;           /* Plain sums, accumulated in sample order */
+    float32 sumReference;
+    float32 meanSpeed;          /* Welford running means */
+    float32 meanReference;
+    float32 m2Speed;            /* Sum of squared deviations from the mean */
+    float32 m2Reference;
+    float32 coMoment;           /* Sum of speed x reference deviation products */
     uint32 lastSampleTime;
 } CalibrationSampleData_t;
 
 static CalibrationSampleData_t g_SampleData[WHEEL_MAX];
 
+/* Calibrate-all group: wheels sampled against one shared reference and finalised per axle */
+static uint8 g_GroupWheelMask;          /* Wheels still in the group */
+static uint8 g_GroupReadyMask;          /* Group wheels that finished sampling */
+static float32 g_SharedReferenceSpeed;
+
+#define CALIBRATION_WHEEL_BIT(wheel)    ((uint8)(1U << (uint8)(wheel)))
+
+/* NVM write-behind job: one slot per calibration block, later writes replace the data */
+typedef struct {
+    SpeedSensorCalibration_t data;  /* Latest calibration requested for the block */
+    boolean pending;
+} CalibrationNvmJob_t;
+
+static CalibrationNvmJob_t g_NvmJobs[WHEEL_MAX];
+static uint8 g_NvmQueue[WHEEL_MAX];     /* Wheels in order of first request */
+static uint8 g_NvmQueueHead;
+static uint8 g_NvmQueueCount;
+static uint16 g_NvmWriteCredit;         /* Bytes that may still be written */
+static CalibrationManager_NvmWriteCallback_t g_NvmWriteCallback = NULL_PTR;
+
 /* Internal function prototypes */
 static void CalibrationManager_InitDefaultConfig(void);
-static Std_ReturnType CalibrationManager_ProcessCalibrationSession(WheelPosition_t wheelPos);
-static Std_ReturnType CalibrationManager_CollectSample(WheelPosition_t wheelPos);
+static Std_ReturnType CalibrationManager_ProcessCalibrationSession(WheelPosition_t wheelPos, float32 groupReference);
+static Std_ReturnType CalibrationManager_CollectSample(WheelPosition_t wheelPos, float32 reference);
+static void CalibrationManager_FinalizeAxles(void);
+static void CalibrationManager_FinishSession(WheelPosition_t wheelPos, CalibrationResult_t result);
 static Std_ReturnType CalibrationManager_CalculateCalibration(WheelPosition_t wheelPos);
 static Std_ReturnType CalibrationManager_ValidateCalculatedCalibration(WheelPosition_t wheelPos, boolean* isValid);
 static void CalibrationManager_AddHistoryEntry(WheelPosition_t wheelPos, const CalibrationHistoryEntry_t* entry);
+static uint16 CalibrationManager_EncodeFactor(float32 factor);
 static uint16 CalibrationManager_GetNvmBlockId(WheelPosition_t wheelPos);
+static uint16 CalibrationManager_GetHistoryNvmBlockId(WheelPosition_t wheelPos);
+static void CalibrationManager_LoadHistoryFromNvm(WheelPosition_t wheelPos);
 static void CalibrationManager_SetSessionResult(WheelPosition_t wheelPos, CalibrationResult_t result);
+static void CalibrationManager_QueueNvmWrite(WheelPosition_t wheelPos, const SpeedSensorCalibration_t* calibration);
+static Std_ReturnType CalibrationManager_WriteNextNvmJob(void);
+static Std_ReturnType CalibrationManager_WriteNextHistoryBlock(void);
+static uint16 CalibrationManager_GetNextNvmJobSize(void);
 
 /**
  * @brief Initialize calibration manager
@@ -57,21 +117,40 @@ Std_ReturnType CalibrationManager_Init(void)
             memset(&g_SampleData[wheelIdx], 0, sizeof(CalibrationSampleData_t));
             
             /* Initialize history */
-            memset(g_CalibrationHistory[wheelIdx], 0, 
-                   sizeof(CalibrationHistoryEntry_t) * CALIBRATION_HISTORY_SIZE);
-            g_HistoryCount[wheelIdx] = 0;
+            memset(&g_CalibrationHistory[wheelIdx], 0, sizeof(CalibrationHistoryRing_t));
+            g_HistoryNvmPending[wheelIdx] = FALSE;
+            
+            /* Initialize NVM write job */
+            memset(&g_NvmJobs[wheelIdx], 0, sizeof(CalibrationNvmJob_t));
         }
         
+        /* No calibrate-all group active */
+        g_GroupWheelMask = 0;
+        g_GroupReadyMask = 0;
+        g_SharedReferenceSpeed = 0.0f;
+        
+        /* Initialize NVM write queue */
+        g_NvmQueueHead = 0;
+        g_NvmQueueCount = 0;
+        g_NvmWriteCredit = 0;
+        
         /* Initialize default configuration */
         CalibrationManager_InitDefaultConfig();
         
-        /* Load calibration data from NVM */
+        /* Load history first: a factory reset while loading the calibration adds to it */
         for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
         {
-            CalibrationManager_LoadFromNvm((WheelPosition_t)wheelIdx);
+            CalibrationManager_LoadHistoryFromNvm((WheelPosition_t)wheelIdx);
         }
         
+        /* Loading and factory reset need the manager initialized */
         g_CalibrationManager_Initialized = TRUE;
+        
+        /* Load calibration data from NVM */
+        for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+        {
+            (void)CalibrationManager_LoadFromNvm((WheelPosition_t)wheelIdx);
+        }
     }
     
     return E_OK;
@@ -82,6 +161,7 @@ Std_ReturnType CalibrationManager_Init(void)
  */
 Std_ReturnType CalibrationManager_DeInit(void)
 {
+    Std_ReturnType retVal = E_OK;
     uint8 wheelIdx;
     
     if (g_CalibrationManager_Initialized == TRUE)
@@ -95,10 +175,13 @@ Std_ReturnType CalibrationManager_DeInit(void)
             }
         }
         
+        /* Write queued calibration and history blocks before shutdown */
+        retVal = CalibrationManager_FlushNvm();
+        
         g_CalibrationManager_Initialized = FALSE;
     }
     
-    return E_OK;
+    return retVal;
 }
 
 /**
@@ -108,18 +191,28 @@ Std_ReturnType CalibrationManager_MainFunction(void)
 {
     Std_ReturnType retVal = E_OK;
     uint8 wheelIdx;
+    float32 groupReference;
     
     if (g_CalibrationManager_Initialized == TRUE)
     {
+        /* One reference sample per cycle, shared by all calibrate-all wheels */
+        groupReference = g_SharedReferenceSpeed;
+        
         /* Process active calibration sessions */
         for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
         {
             if (g_CalibrationSessions[wheelIdx].sessionActive == TRUE)
             {
-                CalibrationManager_ProcessCalibrationSession((WheelPosition_t)wheelIdx);
+                CalibrationManager_ProcessCalibrationSession((WheelPosition_t)wheelIdx, groupReference);
             }
         }
         
+        /* Finalise calibrate-all wheels axle by axle */
+        if (g_GroupWheelMask != 0U)
+        {
+            CalibrationManager_FinalizeAxles();
+        }
+        
         /* Check for automatic calibration if enabled */
         if (g_CalibrationConfig.enableAutoCalibration == TRUE)
         {
@@ -181,6 +274,62 @@ Std_ReturnType CalibrationManager_StartCalibration(const CalibrationRequest_t* r
     return retVal;
 }
 
+/**
+ * @brief Start calibration of all wheels against one shared reference
+ */
+Std_ReturnType CalibrationManager_StartCalibrationAll(const CalibrationRequest_t* request)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    CalibrationRequest_t wheelRequest;
+    uint8 wheelIdx;
+    
+    if ((request != NULL_PTR) && (g_CalibrationManager_Initialized == TRUE))
+    {
+        retVal = E_OK;
+        
+        /* All wheels must be free before any session is started */
+        for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+        {
+            if (g_CalibrationSessions[wheelIdx].sessionActive == TRUE)
+            {
+                retVal = CALIBRATION_RESULT_IN_PROGRESS;
+            }
+        }
+        
+        if (retVal == E_OK)
+        {
+            wheelRequest = *request;
+            for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+            {
+                wheelRequest.wheelPosition = (WheelPosition_t)wheelIdx;
+                (void)CalibrationManager_StartCalibration(&wheelRequest);
+            }
+            
+            g_SharedReferenceSpeed = request->referenceSpeed;
+            g_GroupWheelMask = (uint8)((1U << WHEEL_MAX) - 1U);
+            g_GroupReadyMask = 0;
+        }
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief Update the shared reference speed used by calibrate-all sessions
+ */
+Std_ReturnType CalibrationManager_SetReferenceSpeed(float32 referenceSpeed)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    
+    if ((referenceSpeed >= 0.0f) && (g_CalibrationManager_Initialized == TRUE))
+    {
+        g_SharedReferenceSpeed = referenceSpeed;
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
+
 /**
  * @brief Cancel ongoing calibration
  */
@@ -195,6 +344,10 @@ Std_ReturnType CalibrationManager_CancelCalibration(WheelPosition_t wheelPos)
         
         if (session->sessionActive == TRUE)
         {
+            /* Leaving the calibrate-all group also fails the axle partner */
+            g_GroupWheelMask &= (uint8)~CALIBRATION_WHEEL_BIT(wheelPos);
+            g_GroupReadyMask &= (uint8)~CALIBRATION_WHEEL_BIT(wheelPos);
+            
             session->state = CALIBRATION_STATE_CANCELLED;
             session->result = CALIBRATION_RESULT_NOT_OK;
             session->sessionActive = FALSE;
@@ -231,6 +384,7 @@ Std_ReturnType CalibrationManager_ApplyCalibration(WheelPosition_t wheelPos, boo
     Std_ReturnType retVal = E_NOT_OK;
     CalibrationSession_t* session;
     SpeedSensorCalibration_t calibration;
+    float32 oldCorrectionFactor;
     
     if ((wheelPos < WHEEL_MAX) && (g_CalibrationManager_Initialized == TRUE))
     {
@@ -242,6 +396,8 @@ Std_ReturnType CalibrationManager_ApplyCalibration(WheelPosition_t wheelPos, boo
             /* Get current calibration */
             if (SpeedSensor_GetCalibration(wheelPos, &calibration) == E_OK)
             {
+                oldCorrectionFactor = calibration.correctionFactor;
+                
                 /* Apply calculated values */
                 calibration.correctionFactor = session->calculatedCorrectionFactor;
                 calibration.offsetValue = session->calculatedOffset;
@@ -266,7 +422,7 @@ Std_ReturnType CalibrationManager_ApplyCalibration(WheelPosition_t wheelPos, boo
                     historyEntry.timestamp = session->endTimestamp;
                     historyEntry.method = session->request.method;
                     historyEntry.result = session->result;
-                    historyEntry.oldCorrectionFactor = 1.0f; /* Should store old value */
+                    historyEntry.oldCorrectionFactor = oldCorrectionFactor;
                     historyEntry.newCorrectionFactor = session->calculatedCorrectionFactor;
                     historyEntry.accuracy = session->measuredAccuracy;
                     
@@ -392,30 +548,53 @@ Std_ReturnType CalibrationManager_LoadFromNvm(WheelPosition_t wheelPos)
 }
 
 /**
- * @brief Save calibration to NVM
+ * @brief Queue current calibration for writing to NVM
  */
 Std_ReturnType CalibrationManager_SaveToNvm(WheelPosition_t wheelPos)
 {
     Std_ReturnType retVal = E_NOT_OK;
-    uint16 nvmBlockId;
     SpeedSensorCalibration_t calibration;
     
     if ((wheelPos < WHEEL_MAX) && (g_CalibrationManager_Initialized == TRUE))
     {
-        nvmBlockId = CalibrationManager_GetNvmBlockId(wheelPos);
-        
         /* Get current calibration */
         if (SpeedSensor_GetCalibration(wheelPos, &calibration) == E_OK)
         {
-            /* Save calibration data to NVM */
-            if (Rte_Call_NvmService_WriteBlock(nvmBlockId, &calibration) == NVM_REQ_OK)
+            /* Written later by RE_CalibrationManager_NvmManager */
+            CalibrationManager_QueueNvmWrite(wheelPos, &calibration);
+            retVal = E_OK;
+        }
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief Write all queued calibration and history blocks to NVM immediately
+ */
+Std_ReturnType CalibrationManager_FlushNvm(void)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    Std_ReturnType writeResult;
+    boolean nvmBusy = FALSE;
+    
+    if (g_CalibrationManager_Initialized == TRUE)
+    {
+        retVal = E_OK;
+        
+        /* Ignore the cycle budget; stop only if NVM cannot accept a request */
+        while ((CalibrationManager_GetNextNvmJobSize() > 0U) && (nvmBusy == FALSE))
+        {
+            writeResult = (g_NvmQueueCount > 0U) ? CalibrationManager_WriteNextNvmJob() :
+                                                   CalibrationManager_WriteNextHistoryBlock();
+            
+            if (writeResult == NVM_REQ_PENDING)
             {
-                retVal = E_OK;
+                nvmBusy = TRUE;
+                retVal = E_NOT_OK;
             }
-            else
+            else if (writeResult != NVM_REQ_OK)
             {
-                /* NVM write failed - set DTC */
-                Rte_Call_DiagnosticService_SetDTC(DTC_CALIBRATION_NVM_ERROR, TRUE);
                 retVal = E_NOT_OK;
             }
         }
@@ -425,23 +604,49 @@ Std_ReturnType CalibrationManager_SaveToNvm(WheelPosition_t wheelPos)
 }
 
 /**
- * @brief Get calibration history
+ * @brief Check whether a calibration block write is still queued
  */
-Std_ReturnType CalibrationManager_GetHistory(WheelPosition_t wheelPos, CalibrationHistoryEntry_t* history, uint8* count)
+boolean CalibrationManager_IsNvmWritePending(WheelPosition_t wheelPos)
+{
+    boolean pending = FALSE;
+    
+    if (wheelPos < WHEEL_MAX)
+    {
+        pending = g_NvmJobs[wheelPos].pending;
+    }
+    
+    return pending;
+}
+
+/**
+ * @brief Set callback invoked when a queued NVM write completes
+ */
+Std_ReturnType CalibrationManager_SetNvmWriteCallback(CalibrationManager_NvmWriteCallback_t callback)
+{
+    g_NvmWriteCallback = callback;
+    
+    return E_OK;
+}
+
+/**
+ * @brief Get calibration history, oldest first
+ */
+Std_ReturnType CalibrationManager_GetHistory(WheelPosition_t wheelPos, CalibrationHistoryEntry_t* history,
+                                             uint8 maxEntries, uint8* count)
 {
     Std_ReturnType retVal = E_NOT_OK;
-    uint8 i;
+    CalibrationHistoryCursor_t cursor;
+    uint8 i = 0;
     
-    if ((wheelPos < WHEEL_MAX) && (history != NULL_PTR) && (count != NULL_PTR) && 
-        (g_CalibrationManager_Initialized == TRUE))
+    if ((history != NULL_PTR) && (count != NULL_PTR) && 
+        (CalibrationManager_HistoryBegin(wheelPos, &cursor) == E_OK))
     {
-        *count = g_HistoryCount[wheelPos];
-        
-        /* Copy history entries */
-        for (i = 0; i < g_HistoryCount[wheelPos]; i++)
+        /* Copy history entries, oldest first, up to the caller's capacity */
+        while ((i < maxEntries) && (CalibrationManager_HistoryNext(&cursor, &history[i]) == E_OK))
         {
-            history[i] = g_CalibrationHistory[wheelPos][i];
+            i++;
         }
+        *count = i;
         
         retVal = E_OK;
     }
@@ -449,6 +654,63 @@ Std_ReturnType CalibrationManager_GetHistory(WheelPosition_t wheelPos, Calibrati
     return retVal;
 }
 
+/**
+ * @brief Start iterating calibration history of a wheel
+ */
+Std_ReturnType CalibrationManager_HistoryBegin(WheelPosition_t wheelPos, CalibrationHistoryCursor_t* cursor)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    
+    if ((wheelPos < WHEEL_MAX) && (cursor != NULL_PTR) && (g_CalibrationManager_Initialized == TRUE))
+    {
+        cursor->wheelPosition = wheelPos;
+        cursor->position = 0;
+        cursor->timestampTicks = g_CalibrationHistory[wheelPos].oldestTicks;
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief Get next calibration history entry
+ */
+Std_ReturnType CalibrationManager_HistoryNext(CalibrationHistoryCursor_t* cursor, CalibrationHistoryEntry_t* entry)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    const CalibrationHistoryRing_t* ring;
+    const CalibrationHistoryRecord_t* record;
+    
+    if ((cursor != NULL_PTR) && (entry != NULL_PTR) && (cursor->wheelPosition < WHEEL_MAX))
+    {
+        ring = &g_CalibrationHistory[cursor->wheelPosition];
+        
+        if (cursor->position < ring->count)
+        {
+            record = &ring->records[(ring->head + cursor->position) % CALIBRATION_HISTORY_SIZE];
+            
+            /* The oldest record's delta refers to an overwritten record */
+            if (cursor->position > 0U)
+            {
+                cursor->timestampTicks += record->timestampDelta;
+            }
+            cursor->position++;
+            
+            /* Decode packed record */
+            entry->timestamp = cursor->timestampTicks * CALIBRATION_HISTORY_TICK_MS;
+            entry->method = (CalibrationMethod_t)(record->methodResult >> 4);
+            entry->result = (CalibrationResult_t)(record->methodResult & 0x0FU);
+            entry->oldCorrectionFactor = (float32)record->oldFactorQ14 / 16384.0f;
+            entry->newCorrectionFactor = (float32)record->newFactorQ14 / 16384.0f;
+            entry->accuracy = (float32)record->accuracyHalfPercent * 0.5f;
+            
+            retVal = E_OK;
+        }
+    }
+    
+    return retVal;
+}
+
 /**
  * @brief Clear calibration history
  */
@@ -458,9 +720,8 @@ Std_ReturnType CalibrationManager_ClearHistory(WheelPosition_t wheelPos)
     
     if ((wheelPos < WHEEL_MAX) && (g_CalibrationManager_Initialized == TRUE))
     {
-        memset(g_CalibrationHistory[wheelPos], 0, 
-               sizeof(CalibrationHistoryEntry_t) * CALIBRATION_HISTORY_SIZE);
-        g_HistoryCount[wheelPos] = 0;
+        memset(&g_CalibrationHistory[wheelPos], 0, sizeof(CalibrationHistoryRing_t));
+        g_HistoryNvmPending[wheelPos] = TRUE;
         retVal = E_OK;
     }
     
@@ -556,16 +817,20 @@ static void CalibrationManager_InitDefaultConfig(void)
     g_CalibrationConfig.calibrationTimeoutMs = CALIBRATION_TIMEOUT_MS;
     g_CalibrationConfig.enableAutoCalibration = TRUE;
     g_CalibrationConfig.autoCalibrationIntervalHours = 24; /* Daily check */
+    g_CalibrationConfig.nvmWriteBudgetBytes = CALIBRATION_NVM_WRITE_BUDGET;
 }
 
 /**
  * @brief Process calibration session
  */
-static Std_ReturnType CalibrationManager_ProcessCalibrationSession(WheelPosition_t wheelPos)
+static Std_ReturnType CalibrationManager_ProcessCalibrationSession(WheelPosition_t wheelPos, float32 groupReference)
 {
     Std_ReturnType retVal = E_OK;
     CalibrationSession_t* session = &g_CalibrationSessions[wheelPos];
     uint32 currentTime = 0; /* Should be actual timestamp */
+    uint8 wheelBit = CALIBRATION_WHEEL_BIT(wheelPos);
+    boolean groupWheel = ((g_GroupWheelMask & wheelBit) != 0U) ? TRUE : FALSE;
+    float32 reference = (groupWheel == TRUE) ? groupReference : session->request.referenceSpeed;
     
     switch (session->state)
     {
@@ -574,8 +839,9 @@ static Std_ReturnType CalibrationManager_ProcessCalibrationSession(WheelPosition
             break;
             
         case CALIBRATION_STATE_IN_PROGRESS:
-            /* Collect calibration samples */
-            if (CalibrationManager_CollectSample(wheelPos) == E_OK)
+            /* Collect calibration samples (group wheels that are done wait for their axle) */
+            if (((g_GroupReadyMask & wheelBit) == 0U) &&
+                (CalibrationManager_CollectSample(wheelPos, reference) == E_OK))
             {
                 session->samplesCollected = g_SampleData[wheelPos].sampleCount;
                 
@@ -585,16 +851,18 @@ static Std_ReturnType CalibrationManager_ProcessCalibrationSession(WheelPosition
                     /* Check timeout */
                     if ((currentTime - session->startTimestamp) >= session->request.calibrationTimeMs)
                     {
-                        /* Calculate calibration */
-                        if (CalibrationManager_CalculateCalibration(wheelPos) == E_OK)
+                        if (groupWheel == TRUE)
                         {
-                            session->state = CALIBRATION_STATE_COMPLETED;
-                            CalibrationManager_SetSessionResult(wheelPos, CALIBRATION_RESULT_OK);
+                            /* Calculated together with the other wheel of the axle */
+                            g_GroupReadyMask |= wheelBit;
+                        }
+                        else if (CalibrationManager_CalculateCalibration(wheelPos) == E_OK)
+                        {
+                            CalibrationManager_FinishSession(wheelPos, CALIBRATION_RESULT_OK);
                         }
                         else
                         {
-                            session->state = CALIBRATION_STATE_FAILED;
-                            CalibrationManager_SetSessionResult(wheelPos, CALIBRATION_RESULT_VALIDATION_FAILED);
+                            CalibrationManager_FinishSession(wheelPos, CALIBRATION_RESULT_VALIDATION_FAILED);
                         }
                     }
                 }
@@ -626,12 +894,14 @@ static Std_ReturnType CalibrationManager_ProcessCalibrationSession(WheelPosition
 /**
  * @brief Collect calibration sample
  */
-static Std_ReturnType CalibrationManager_CollectSample(WheelPosition_t wheelPos)
+static Std_ReturnType CalibrationManager_CollectSample(WheelPosition_t wheelPos, float32 reference)
 {
     Std_ReturnType retVal = E_NOT_OK;
     SpeedData_t speedData;
     CalibrationSampleData_t* sampleData = &g_SampleData[wheelPos];
-    CalibrationSession_t* session = &g_CalibrationSessions[wheelPos];
+    float32 speed;
+    float32 deltaSpeed;
+    float32 deltaReference;
     
     /* Get current speed data */
     if (SpeedSensor_GetSpeedData(wheelPos, &speedData) == E_OK)
@@ -639,11 +909,25 @@ static Std_ReturnType CalibrationManager_CollectSample(WheelPosition_t wheelPos)
         if ((speedData.speedValid == TRUE) && 
             (sampleData->sampleCount < g_CalibrationConfig.maxCalibrationSamples))
         {
-            /* Store speed sample */
-            sampleData->speedSamples[sampleData->sampleCount] = speedData.wheelSpeed;
-            sampleData->referenceSamples[sampleData->sampleCount] = session->request.referenceSpeed;
+            speed = speedData.wheelSpeed;
             sampleData->sampleCount++;
             
+            /* Fold the sample into the running statistics */
+            if ((speed > 0.0f) && (reference > 0.0f))
+            {
+                sampleData->validSamples++;
+                sampleData->sumSpeed += speed;
+                sampleData->sumReference += reference;
+                
+                deltaSpeed = speed - sampleData->meanSpeed;
+                deltaReference = reference - sampleData->meanReference;
+                sampleData->meanSpeed += deltaSpeed / sampleData->validSamples;
+                sampleData->meanReference += deltaReference / sampleData->validSamples;
+                sampleData->m2Speed += deltaSpeed * (speed - sampleData->meanSpeed);
+                sampleData->m2Reference += deltaReference * (reference - sampleData->meanReference);
+                sampleData->coMoment += deltaSpeed * (reference - sampleData->meanReference);
+            }
+            
             retVal = E_OK;
         }
     }
@@ -659,32 +943,29 @@ static Std_ReturnType CalibrationManager_CalculateCalibration(WheelPosition_t wh
     Std_ReturnType retVal = E_NOT_OK;
     CalibrationSampleData_t* sampleData = &g_SampleData[wheelPos];
     CalibrationSession_t* session = &g_CalibrationSessions[wheelPos];
-    float32 sumSpeed = 0.0f;
-    float32 sumReference = 0.0f;
-    uint16 validSamples = 0;
-    uint16 i;
+    uint16 validSamples = sampleData->validSamples;
     boolean isValid;
     
-    /* Calculate average speeds */
-    for (i = 0; i < sampleData->sampleCount; i++)
-    {
-        if ((sampleData->speedSamples[i] > 0.0f) && 
-            (sampleData->referenceSamples[i] > 0.0f))
-        {
-            sumSpeed += sampleData->speedSamples[i];
-            sumReference += sampleData->referenceSamples[i];
-            validSamples++;
-        }
-    }
-    
     if (validSamples >= g_CalibrationConfig.minCalibrationSamples)
     {
-        float32 avgSpeed = sumSpeed / validSamples;
-        float32 avgReference = sumReference / validSamples;
+        float32 avgSpeed = sampleData->sumSpeed / validSamples;
+        float32 avgReference = sampleData->sumReference / validSamples;
+        float32 speedSpread = sqrtf(sampleData->m2Speed / validSamples);
+        float32 referenceSpread = sqrtf(sampleData->m2Reference / validSamples);
         
-        /* Calculate correction factor */
-        session->calculatedCorrectionFactor = avgReference / avgSpeed;
-        session->calculatedOffset = 0.0f; /* Simple calibration - no offset */
+        if ((speedSpread >= CALIBRATION_FIT_MIN_SPREAD_KMH) && (referenceSpread >= CALIBRATION_FIT_MIN_SPREAD_KMH))
+        {
+            /* Samples span a speed range: least-squares fit reference = factor * speed + offset */
+            session->calculatedCorrectionFactor = sampleData->coMoment / sampleData->m2Speed;
+            session->calculatedOffset = sampleData->meanReference -
+                                        (session->calculatedCorrectionFactor * sampleData->meanSpeed);
+        }
+        else
+        {
+            /* Constant-speed run: ratio of means, no offset */
+            session->calculatedCorrectionFactor = avgReference / avgSpeed;
+            session->calculatedOffset = 0.0f;
+        }
         
         /* Calculate accuracy */
         float32 error = fabsf(avgSpeed - avgReference) / avgReference * 100.0f;
@@ -703,6 +984,75 @@ static Std_ReturnType CalibrationManager_CalculateCalibration(WheelPosition_t wh
     return retVal;
 }
 
+/**
+ * @brief Finalise calibrate-all wheels once both wheels of an axle are done
+ */
+static void CalibrationManager_FinalizeAxles(void)
+{
+    uint8 axleIdx;
+    uint8 axleMask;
+    WheelPosition_t leftWheel;
+    WheelPosition_t rightWheel;
+    Std_ReturnType leftResult;
+    Std_ReturnType rightResult;
+    CalibrationResult_t axleResult;
+    
+    for (axleIdx = 0; axleIdx < (WHEEL_MAX / 2U); axleIdx++)
+    {
+        /* Wheel enumeration is FL, FR, RL, RR: axles are consecutive pairs */
+        leftWheel = (WheelPosition_t)(2U * axleIdx);
+        rightWheel = (WheelPosition_t)((2U * axleIdx) + 1U);
+        axleMask = CALIBRATION_WHEEL_BIT(leftWheel) | CALIBRATION_WHEEL_BIT(rightWheel);
+        
+        if ((g_GroupWheelMask & axleMask) != 0U)
+        {
+            if ((g_GroupReadyMask & axleMask) == axleMask)
+            {
+                /* Left and right must both pass so the axle stays symmetric */
+                leftResult = CalibrationManager_CalculateCalibration(leftWheel);
+                rightResult = CalibrationManager_CalculateCalibration(rightWheel);
+                axleResult = ((leftResult == E_OK) && (rightResult == E_OK)) ?
+                             CALIBRATION_RESULT_OK : CALIBRATION_RESULT_VALIDATION_FAILED;
+                
+                CalibrationManager_FinishSession(leftWheel, axleResult);
+                CalibrationManager_FinishSession(rightWheel, axleResult);
+                g_GroupWheelMask &= (uint8)~axleMask;
+                g_GroupReadyMask &= (uint8)~axleMask;
+            }
+            else if (((g_GroupWheelMask & axleMask) != axleMask) ||
+                     (g_CalibrationSessions[leftWheel].state == CALIBRATION_STATE_FAILED) ||
+                     (g_CalibrationSessions[rightWheel].state == CALIBRATION_STATE_FAILED))
+            {
+                /* One wheel dropped out (timeout or cancel): the other cannot finish the axle */
+                if (g_CalibrationSessions[leftWheel].state == CALIBRATION_STATE_IN_PROGRESS)
+                {
+                    CalibrationManager_FinishSession(leftWheel, CALIBRATION_RESULT_NOT_OK);
+                }
+                if (g_CalibrationSessions[rightWheel].state == CALIBRATION_STATE_IN_PROGRESS)
+                {
+                    CalibrationManager_FinishSession(rightWheel, CALIBRATION_RESULT_NOT_OK);
+                }
+                g_GroupWheelMask &= (uint8)~axleMask;
+                g_GroupReadyMask &= (uint8)~axleMask;
+            }
+            else
+            {
+                /* Axle still sampling */
+            }
+        }
+    }
+}
+
+/**
+ * @brief Set final state and result of a calibration session
+ */
+static void CalibrationManager_FinishSession(WheelPosition_t wheelPos, CalibrationResult_t result)
+{
+    g_CalibrationSessions[wheelPos].state = (result == CALIBRATION_RESULT_OK) ?
+                                            CALIBRATION_STATE_COMPLETED : CALIBRATION_STATE_FAILED;
+    CalibrationManager_SetSessionResult(wheelPos, result);
+}
+
 /**
  * @brief Validate calculated calibration
  */
@@ -732,25 +1082,99 @@ static Std_ReturnType CalibrationManager_ValidateCalculatedCalibration(WheelPosi
  */
 static void CalibrationManager_AddHistoryEntry(WheelPosition_t wheelPos, const CalibrationHistoryEntry_t* entry)
 {
+    CalibrationHistoryRing_t* ring = &g_CalibrationHistory[wheelPos];
+    CalibrationHistoryRecord_t* record;
+    uint32 ticks = entry->timestamp / CALIBRATION_HISTORY_TICK_MS;
+    uint32 delta = 0;
+    float32 accuracy = entry->accuracy;
     uint8 insertIndex;
     
-    if (g_HistoryCount[wheelPos] < CALIBRATION_HISTORY_SIZE)
+    if (ring->count == 0U)
     {
-        /* Add to end of array */
-        insertIndex = g_HistoryCount[wheelPos];
-        g_HistoryCount[wheelPos]++;
+        ring->oldestTicks = ticks;
+        ring->newestTicks = ticks;
     }
-    else
+    else if (ticks > ring->newestTicks)
     {
-        /* Shift entries and add to end */
-        for (uint8 i = 0; i < (CALIBRATION_HISTORY_SIZE - 1); i++)
+        delta = ticks - ring->newestTicks;
+        if (delta > 0xFFFFU)
         {
-            g_CalibrationHistory[wheelPos][i] = g_CalibrationHistory[wheelPos][i + 1];
+            delta = 0xFFFFU;
         }
-        insertIndex = CALIBRATION_HISTORY_SIZE - 1;
+        ring->newestTicks += delta;
     }
     
-    g_CalibrationHistory[wheelPos][insertIndex] = *entry;
+    if (ring->count < CALIBRATION_HISTORY_SIZE)
+    {
+        /* Add behind the newest record */
+        insertIndex = (uint8)((ring->head + ring->count) % CALIBRATION_HISTORY_SIZE);
+        ring->count++;
+    }
+    else
+    {
+        /* Overwrite the oldest record; the next one becomes the oldest */
+        insertIndex = ring->head;
+        ring->head = (uint8)((ring->head + 1U) % CALIBRATION_HISTORY_SIZE);
+        ring->oldestTicks += ring->records[ring->head].timestampDelta;
+    }
+    
+    if (accuracy < 0.0f)
+    {
+        accuracy = 0.0f;
+    }
+    else if (accuracy > 100.0f)
+    {
+        accuracy = 100.0f;
+    }
+    
+    /* Pack entry */
+    record = &ring->records[insertIndex];
+    record->timestampDelta = (uint16)delta;
+    record->oldFactorQ14 = CalibrationManager_EncodeFactor(entry->oldCorrectionFactor);
+    record->newFactorQ14 = CalibrationManager_EncodeFactor(entry->newCorrectionFactor);
+    record->methodResult = (uint8)((((uint8)entry->method & 0x0FU) << 4) | ((uint8)entry->result & 0x0FU));
+    record->accuracyHalfPercent = (uint8)((accuracy * 2.0f) + 0.5f);
+    
+    g_HistoryNvmPending[wheelPos] = TRUE;
+}
+
+/**
+ * @brief Load the calibration history of a wheel from its NVM block
+ */
+static void CalibrationManager_LoadHistoryFromNvm(WheelPosition_t wheelPos)
+{
+    CalibrationHistoryRing_t* ring = &g_CalibrationHistory[wheelPos];
+    
+    /* A missing block (first start) or an inconsistent ring header leaves the history empty */
+    if ((Rte_Call_NvmService_ReadBlock(CalibrationManager_GetHistoryNvmBlockId(wheelPos), ring) != NVM_REQ_OK) ||
+        (ring->head >= CALIBRATION_HISTORY_SIZE) || (ring->count > CALIBRATION_HISTORY_SIZE) ||
+        (ring->newestTicks < ring->oldestTicks))
+    {
+        memset(ring, 0, sizeof(CalibrationHistoryRing_t));
+    }
+}
+
+/**
+ * @brief Encode correction factor as unsigned Q2.14
+ */
+static uint16 CalibrationManager_EncodeFactor(float32 factor)
+{
+    uint16 encoded;
+    
+    if (factor <= 0.0f)
+    {
+        encoded = 0;
+    }
+    else if (factor >= (65535.0f / 16384.0f))
+    {
+        encoded = 0xFFFFU;
+    }
+    else
+    {
+        encoded = (uint16)((factor * 16384.0f) + 0.5f);
+    }
+    
+    return encoded;
 }
 
 /**
@@ -782,6 +1206,35 @@ static uint16 CalibrationManager_GetNvmBlockId(WheelPosition_t wheelPos)
     return blockId;
 }
 
+/**
+ * @brief Get history NVM block ID for wheel position
+ */
+static uint16 CalibrationManager_GetHistoryNvmBlockId(WheelPosition_t wheelPos)
+{
+    uint16 blockId = 0;
+    
+    switch (wheelPos)
+    {
+        case WHEEL_FRONT_LEFT:
+            blockId = NVM_BLOCK_CALIBRATION_HISTORY_FL;
+            break;
+        case WHEEL_FRONT_RIGHT:
+            blockId = NVM_BLOCK_CALIBRATION_HISTORY_FR;
+            break;
+        case WHEEL_REAR_LEFT:
+            blockId = NVM_BLOCK_CALIBRATION_HISTORY_RL;
+            break;
+        case WHEEL_REAR_RIGHT:
+            blockId = NVM_BLOCK_CALIBRATION_HISTORY_RR;
+            break;
+        default:
+            blockId = 0;
+            break;
+    }
+    
+    return blockId;
+}
+
 /**
  * @brief Set calibration session result
  */
@@ -803,6 +1256,118 @@ static void CalibrationManager_SetSessionResult(WheelPosition_t wheelPos, Calibr
     }
 }
 
+/**
+ * @brief Add calibration block to the NVM write queue
+ */
+static void CalibrationManager_QueueNvmWrite(WheelPosition_t wheelPos, const SpeedSensorCalibration_t* calibration)
+{
+    CalibrationNvmJob_t* job = &g_NvmJobs[wheelPos];
+    
+    /* A queued block keeps its place and only takes the latest data */
+    job->data = *calibration;
+    
+    if (job->pending == FALSE)
+    {
+        job->pending = TRUE;
+        g_NvmQueue[(g_NvmQueueHead + g_NvmQueueCount) % WHEEL_MAX] = (uint8)wheelPos;
+        g_NvmQueueCount++;
+    }
+}
+
+/**
+ * @brief Write the oldest queued calibration block to NVM
+ */
+static Std_ReturnType CalibrationManager_WriteNextNvmJob(void)
+{
+    Std_ReturnType writeResult;
+    uint8 wheelIdx = g_NvmQueue[g_NvmQueueHead];
+    CalibrationNvmJob_t* job = &g_NvmJobs[wheelIdx];
+    
+    writeResult = Rte_Call_NvmService_WriteBlock(CalibrationManager_GetNvmBlockId((WheelPosition_t)wheelIdx), &job->data);
+    
+    /* Pending means NVM is busy: keep the job at the head and retry later */
+    if (writeResult != NVM_REQ_PENDING)
+    {
+        job->pending = FALSE;
+        g_NvmQueueHead = (uint8)((g_NvmQueueHead + 1U) % WHEEL_MAX);
+        g_NvmQueueCount--;
+        
+        if (writeResult != NVM_REQ_OK)
+        {
+            /* NVM write failed - set DTC */
+            Rte_Call_DiagnosticService_SetDTC(DTC_CALIBRATION_NVM_ERROR, TRUE);
+        }
+        
+        if (g_NvmWriteCallback != NULL_PTR)
+        {
+            g_NvmWriteCallback((WheelPosition_t)wheelIdx, (writeResult == NVM_REQ_OK) ? E_OK : E_NOT_OK);
+        }
+    }
+    
+    return writeResult;
+}
+
+/**
+ * @brief Write the history block of the first wheel with unsaved history to NVM
+ */
+static Std_ReturnType CalibrationManager_WriteNextHistoryBlock(void)
+{
+    Std_ReturnType writeResult = NVM_REQ_OK;
+    uint8 wheelIdx = 0;
+    
+    while ((wheelIdx < WHEEL_MAX) && (g_HistoryNvmPending[wheelIdx] == FALSE))
+    {
+        wheelIdx++;
+    }
+    
+    if (wheelIdx < WHEEL_MAX)
+    {
+        writeResult = Rte_Call_NvmService_WriteBlock(CalibrationManager_GetHistoryNvmBlockId((WheelPosition_t)wheelIdx),
+                                                     &g_CalibrationHistory[wheelIdx]);
+        
+        /* Pending means NVM is busy: keep the block marked and retry later */
+        if (writeResult != NVM_REQ_PENDING)
+        {
+            g_HistoryNvmPending[wheelIdx] = FALSE;
+            
+            if (writeResult != NVM_REQ_OK)
+            {
+                /* NVM write failed - set DTC */
+                Rte_Call_DiagnosticService_SetDTC(DTC_CALIBRATION_NVM_ERROR, TRUE);
+            }
+        }
+    }
+    
+    return writeResult;
+}
+
+/**
+ * @brief Size of the next NVM write: queued calibration blocks first, then history blocks
+ * @return Block size in bytes, 0 if nothing is waiting
+ */
+static uint16 CalibrationManager_GetNextNvmJobSize(void)
+{
+    uint16 size = 0;
+    uint8 wheelIdx;
+    
+    if (g_NvmQueueCount > 0U)
+    {
+        size = CALIBRATION_NVM_BLOCK_SIZE;
+    }
+    else
+    {
+        for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+        {
+            if (g_HistoryNvmPending[wheelIdx] == TRUE)
+            {
+                size = CALIBRATION_HISTORY_NVM_BLOCK_SIZE;
+            }
+        }
+    }
+    
+    return size;
+}
+
 /* RTE Runnable Functions */
 
 /**
@@ -810,7 +1375,9 @@ static void CalibrationManager_SetSessionResult(WheelPosition_t wheelPos, Calibr
  */
 void RE_CalibrationManager_MainCyclic(void)
 {
+    RUNNABLE_TIMING_START(RUNNABLE_CALIBRATION_MAIN);
     CalibrationManager_MainFunction();
+    RUNNABLE_TIMING_STOP(RUNNABLE_CALIBRATION_MAIN);
 }
 
 /**
@@ -826,5 +1393,53 @@ void RE_CalibrationManager_CalibrationProcess(void)
  */
 void RE_CalibrationManager_NvmManager(void)
 {
-    /* This can be triggered for NVM save/load operations */
+    uint16 creditLimit;
+    uint16 jobSize;
+    Std_ReturnType writeResult;
+    boolean nvmBusy = FALSE;
+    
+    if (g_CalibrationManager_Initialized == TRUE)
+    {
+        jobSize = CalibrationManager_GetNextNvmJobSize();
+        
+        /* Budgets below the next block accumulate over cycles; larger budgets are not carried over */
+        creditLimit = g_CalibrationConfig.nvmWriteBudgetBytes;
+        if (creditLimit < jobSize)
+        {
+            creditLimit = jobSize;
+        }
+        
+        if (jobSize > 0U)
+        {
+            if ((uint32)g_NvmWriteCredit + g_CalibrationConfig.nvmWriteBudgetBytes > creditLimit)
+            {
+                g_NvmWriteCredit = creditLimit;
+            }
+            else
+            {
+                g_NvmWriteCredit += g_CalibrationConfig.nvmWriteBudgetBytes;
+            }
+        }
+        
+        /* Drain queued blocks within the byte budget */
+        while ((jobSize > 0U) && (g_NvmWriteCredit >= jobSize) && (nvmBusy == FALSE))
+        {
+            writeResult = (g_NvmQueueCount > 0U) ? CalibrationManager_WriteNextNvmJob() :
+                                                   CalibrationManager_WriteNextHistoryBlock();
+            if (writeResult == NVM_REQ_PENDING)
+            {
+                nvmBusy = TRUE;
+            }
+            else
+            {
+                g_NvmWriteCredit -= jobSize;
+                jobSize = CalibrationManager_GetNextNvmJobSize();
+            }
+        }
+        
+        if (jobSize == 0U)
+        {
+            g_NvmWriteCredit = 0;
+        }
+    }
 }
\ No newline at end of file
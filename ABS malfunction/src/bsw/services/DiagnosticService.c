@@ -8,12 +8,47 @@
 #include "SpeedSensor_Interface.h"
 #include "ABS_MalfunctionDetection.h"
 #include "CalibrationManager.h"
+#include "RunnableTiming.h"
 #include <string.h>
 
+#if DIAG_DTC_HASH_SIZE < (2U * DIAG_MAX_DTC_COUNT)
+#error "DIAG_DTC_HASH_BITS too small for DIAG_MAX_DTC_COUNT"
+#endif
+
+/* DTC status bit index: one bit per DTC table slot for each status bit */
+#define DIAG_DTC_STATUS_BITS            8U
+#define DIAG_DTC_INDEX_WORD_BITS        32U
+#define DIAG_DTC_INDEX_WORDS            ((DIAG_MAX_DTC_COUNT + DIAG_DTC_INDEX_WORD_BITS - 1U) / DIAG_DTC_INDEX_WORD_BITS)
+#define DIAG_DTC_HASH_EMPTY             0U
+
+/* Largest routine status record returned by the RID_* functions */
+#define DIAG_ROUTINE_STATUS_MAX_LENGTH  8U
+
 /* Local data structures */
-static DTCInfo_t g_DTCTable[DIAG_MAX_DTC_COUNT];
-static uint8 g_ActiveDTCCount = 0;
+static DTCInfo_t g_DTCTable[DIAG_MAX_DTC_COUNT];          /* Dense, in insertion order */
+static uint16 g_StoredDTCCount = 0;
+static uint16 g_DTCHashTable[DIAG_DTC_HASH_SIZE];         /* Table slot + 1, 0 = empty */
+static uint32 g_DTCStatusIndex[DIAG_DTC_STATUS_BITS][DIAG_DTC_INDEX_WORDS];
+
+/* Paged DTC report state (one streaming response in flight at a time) */
+typedef struct {
+    uint32 selection[DIAG_DTC_INDEX_WORDS];  /* Slots selected when the response started */
+    uint16 nextSlot;
+    uint16 recordsRemaining;
+    uint8 header[3];
+    uint8 headerLength;
+    uint8 headerPos;
+    uint8 record[4];
+    uint8 recordSize;                         /* 4 with status byte (0x02), 3 without (0x0A) */
+    uint8 recordPos;
+} DiagDTCPager_t;
+
+static DiagDTCPager_t g_DTCPager;
+static uint8 g_StreamResponseBuffer[DIAG_STREAM_FLAT_LENGTH];
 static DiagSession_t g_CurrentSession = DIAG_SESSION_DEFAULT;
+static uint8 g_SecurityUnlockedMask = DIAG_SECURITY_NONE;   /* Relocked on every session change */
+static uint8 g_SeenStatusChange[WHEEL_MAX];              /* Last consumed ABS change sequence */
+static uint32 g_WheelActiveDTC[WHEEL_MAX];               /* DTC currently reported per wheel, 0 = none */
 static boolean g_DiagnosticService_Initialized = FALSE;
 
 /* UDS Service Handler Function Pointer Type */
@@ -21,50 +56,98 @@ typedef Std_ReturnType (*UDSServiceHandler_t)(const UDSMessage_t* request, UDSMe
 
 /* UDS Service Handler Table */
 typedef struct {
-    uint8 serviceId;
-    UDSServiceHandler_t handler;
+    UDSServiceHandler_t handler;      /* NULL_PTR if the service is not supported */
+    uint8 sessionMask;                /* DIAG_SESSION_MASK() of the sessions allowing the service */
+    uint8 securityMask;               /* DIAG_SECURITY_* levels, one must be unlocked */
 } UDSServiceEntry_t;
 
-/* Service handler table */
-static const UDSServiceEntry_t g_UDSServiceTable[] = {
-    {UDS_SID_DIAGNOSTIC_SESSION_CONTROL, UDS_DiagnosticSessionControl},
-    {UDS_SID_ECU_RESET, UDS_ECUReset},
-    {UDS_SID_CLEAR_DIAGNOSTIC_INFORMATION, UDS_ClearDiagnosticInformation},
-    {UDS_SID_READ_DTC_INFORMATION, UDS_ReadDTCInformation},
-    {UDS_SID_READ_DATA_BY_IDENTIFIER, UDS_ReadDataByIdentifier},
-    {UDS_SID_WRITE_DATA_BY_IDENTIFIER, UDS_WriteDataByIdentifier},
-    {UDS_SID_IO_CONTROL_BY_IDENTIFIER, UDS_InputOutputControlByIdentifier},
-    {UDS_SID_ROUTINE_CONTROL, UDS_RoutineControl}
+#define UDS_SERVICE_TABLE_SIZE 256U
+
+/* Service handler table, indexed directly by service ID */
+static const UDSServiceEntry_t g_UDSServiceTable[UDS_SERVICE_TABLE_SIZE] = {
+    [UDS_SID_DIAGNOSTIC_SESSION_CONTROL]   = {UDS_DiagnosticSessionControl, DIAG_SESSION_MASK_ALL, DIAG_SECURITY_NONE},
+    [UDS_SID_ECU_RESET]                    = {UDS_ECUReset, DIAG_SESSION_MASK_ALL, DIAG_SECURITY_NONE},
+    [UDS_SID_CLEAR_DIAGNOSTIC_INFORMATION] = {UDS_ClearDiagnosticInformation, DIAG_SESSION_MASK_ALL, DIAG_SECURITY_NONE},
+    [UDS_SID_READ_DTC_INFORMATION]         = {UDS_ReadDTCInformation, DIAG_SESSION_MASK_ALL, DIAG_SECURITY_NONE},
+    [UDS_SID_READ_DATA_BY_IDENTIFIER]      = {UDS_ReadDataByIdentifier, DIAG_SESSION_MASK_ALL, DIAG_SECURITY_NONE},
+    [UDS_SID_WRITE_DATA_BY_IDENTIFIER]     = {UDS_WriteDataByIdentifier, DIAG_SESSION_MASK(DIAG_SESSION_EXTENDED), DIAG_SECURITY_NONE},
+    [UDS_SID_IO_CONTROL_BY_IDENTIFIER]     = {UDS_InputOutputControlByIdentifier, DIAG_SESSION_MASK(DIAG_SESSION_EXTENDED), DIAG_SECURITY_NONE},
+    [UDS_SID_ROUTINE_CONTROL]              = {UDS_RoutineControl, DIAG_SESSION_MASK(DIAG_SESSION_EXTENDED), DIAG_SECURITY_NONE},
+    [UDS_SID_TESTER_PRESENT]               = {UDS_TesterPresent, DIAG_SESSION_MASK_ALL, DIAG_SECURITY_NONE}
+};
+
+/* DID Read/Write Function Pointer Types */
+typedef Std_ReturnType (*DIDReadHandler_t)(uint16 did, uint8* data, uint16* length);
+typedef Std_ReturnType (*DIDWriteHandler_t)(uint16 did, const uint8* data, uint16 length);
+
+/* DID Table: each entry covers a contiguous identifier range with a fixed payload size */
+typedef struct {
+    uint16 firstDid;
+    uint16 lastDid;
+    uint16 payloadLength;
+    DIDReadHandler_t readHandler;
+    DIDWriteHandler_t writeHandler;   /* NULL_PTR for read-only identifiers */
+} DIDEntry_t;
+
+/* DID table, sorted by identifier */
+static const DIDEntry_t g_DIDTable[] = {
+    {DID_SPEED_SENSOR_FL_DATA, DID_SPEED_SENSOR_RR_DATA, DID_SPEED_SENSOR_DATA_LENGTH, DID_ReadSpeedSensorData, NULL_PTR},
+    {DID_CALIBRATION_FL_PARAMS, DID_CALIBRATION_RR_PARAMS, DID_CALIBRATION_PARAMS_LENGTH, DID_ReadCalibrationParams, DID_WriteCalibrationParams},
+    {DID_ABS_SYSTEM_STATUS, DID_ABS_SYSTEM_STATUS, DID_ABS_SYSTEM_STATUS_LENGTH, DID_ReadABSSystemStatus, NULL_PTR},
+    {DID_MALFUNCTION_COUNTER, DID_MALFUNCTION_COUNTER, DID_MALFUNCTION_COUNTER_LENGTH, DID_ReadMalfunctionCounter, NULL_PTR},
+#if defined(RUNNABLE_TIMING)
+    {DID_RUNNABLE_TIMING_FIRST, DID_RUNNABLE_TIMING_LAST, DID_RUNNABLE_TIMING_LENGTH, DID_ReadRunnableTiming, NULL_PTR},
+#endif
+    {DID_DIAGNOSTIC_SESSION_INFO, DID_DIAGNOSTIC_SESSION_INFO, DID_DIAGNOSTIC_SESSION_INFO_LENGTH, DID_ReadDiagnosticSessionInfo, NULL_PTR}
 };
 
-#define UDS_SERVICE_TABLE_SIZE (sizeof(g_UDSServiceTable) / sizeof(UDSServiceEntry_t))
+#define DID_TABLE_SIZE (sizeof(g_DIDTable) / sizeof(DIDEntry_t))
 
 /* Internal function prototypes */
-static Std_ReturnType DiagnosticService_FindDTC(uint32 dtcNumber, uint8* index);
+static uint16 DiagnosticService_HashDTC(uint32 dtcNumber);
+static Std_ReturnType DiagnosticService_FindDTC(uint32 dtcNumber, uint16* index);
+static uint8 DiagnosticService_GetStatusByte(uint16 index);
+static void DiagnosticService_UpdateStatusIndex(uint16 index);
 static Std_ReturnType DiagnosticService_AddDTC(uint32 dtcNumber, WheelPosition_t wheelPos, ABS_MalfunctionType_t type);
 static Std_ReturnType DiagnosticService_UpdateDTCStatus(uint32 dtcNumber, boolean active);
-static UDSServiceHandler_t DiagnosticService_GetServiceHandler(uint8 serviceId);
+static uint8 DiagnosticService_CheckServiceAccess(uint8 serviceId);
+static const DIDEntry_t* DiagnosticService_GetDIDEntry(uint16 dataId);
+static void DiagnosticService_PutUint16(uint8* data, uint16 value);
+static uint16 DiagnosticService_GetUint16(const uint8* data);
+static uint16 DiagnosticService_ScaleToUint16(float32 value, float32 scale);
+static sint16 DiagnosticService_ScaleToSint16(float32 value, float32 scale);
+#if defined(RUNNABLE_TIMING)
+static uint16 DiagnosticService_TicksToUs(uint32 ticks);
+#endif
 static void DiagnosticService_PrepareErrorResponse(UDSMessage_t* response, uint8 serviceId, uint8 nrc);
 static uint32 DiagnosticService_GetDTCForMalfunction(ABS_MalfunctionType_t type, WheelPosition_t wheelPos);
 static void DiagnosticService_MonitorMalfunctions(void);
+static Std_ReturnType DiagnosticService_StartDTCPager(const UDSMessage_t* request, IsoTp_TxStream_t* stream);
+static uint16 DiagnosticService_DTCPagerFill(IsoTp_TxStream_t* stream, uint8* dest, uint16 maxLength);
 
 /**
  * @brief Initialize diagnostic service
  */
 Std_ReturnType DiagnosticService_Init(void)
 {
-    uint8 i;
+    uint16 i;
     
     if (g_DiagnosticService_Initialized == FALSE)
     {
-        /* Initialize DTC table */
+        /* Initialize DTC table and indices */
         for (i = 0; i < DIAG_MAX_DTC_COUNT; i++)
         {
             memset(&g_DTCTable[i], 0, sizeof(DTCInfo_t));
         }
+        memset(g_DTCHashTable, 0, sizeof(g_DTCHashTable));
+        memset(g_DTCStatusIndex, 0, sizeof(g_DTCStatusIndex));
         
-        g_ActiveDTCCount = 0;
+        memset(g_SeenStatusChange, 0, sizeof(g_SeenStatusChange));
+        memset(g_WheelActiveDTC, 0, sizeof(g_WheelActiveDTC));
+        
+        g_StoredDTCCount = 0;
         g_CurrentSession = DIAG_SESSION_DEFAULT;
+        g_SecurityUnlockedMask = DIAG_SECURITY_NONE;
         g_DiagnosticService_Initialized = TRUE;
     }
     
@@ -100,22 +183,21 @@ Std_ReturnType DiagnosticService_MainFunction(void)
 Std_ReturnType DiagnosticService_ProcessUDSRequest(const UDSMessage_t* request, UDSMessage_t* response)
 {
     Std_ReturnType retVal = E_NOT_OK;
-    UDSServiceHandler_t handler;
+    uint8 nrc;
     
     if ((request != NULL_PTR) && (response != NULL_PTR) && (g_DiagnosticService_Initialized == TRUE))
     {
-        /* Find service handler */
-        handler = DiagnosticService_GetServiceHandler(request->serviceId);
+        /* Support, session and security checks come from the service table entry */
+        nrc = DiagnosticService_CheckServiceAccess(request->serviceId);
         
-        if (handler != NULL_PTR)
+        if (nrc == UDS_NRC_POSITIVE_RESPONSE)
         {
             /* Call service handler */
-            retVal = handler(request, response);
+            retVal = g_UDSServiceTable[request->serviceId].handler(request, response);
         }
         else
         {
-            /* Service not supported */
-            DiagnosticService_PrepareErrorResponse(response, request->serviceId, UDS_NRC_SERVICE_NOT_SUPPORTED);
+            DiagnosticService_PrepareErrorResponse(response, request->serviceId, nrc);
             retVal = E_OK; /* Response prepared, even if error */
         }
     }
@@ -123,13 +205,49 @@ Std_ReturnType DiagnosticService_ProcessUDSRequest(const UDSMessage_t* request,
     return retVal;
 }
 
+/**
+ * @brief Process UDS request received by the transport and prepare a streaming response
+ */
+Std_ReturnType DiagnosticService_ProcessUDSStream(const UDSMessage_t* request, IsoTp_TxStream_t* stream)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    UDSMessage_t response;
+    
+    if ((request != NULL_PTR) && (stream != NULL_PTR) && (g_DiagnosticService_Initialized == TRUE))
+    {
+        if ((DiagnosticService_CheckServiceAccess(request->serviceId) == UDS_NRC_POSITIVE_RESPONSE) &&
+            (DiagnosticService_StartDTCPager(request, stream) == E_OK))
+        {
+            retVal = E_OK;
+        }
+        else
+        {
+            /* Small response: serialize once, transport streams from the buffer */
+            memset(&response, 0, sizeof(response));
+            response.responseData = g_StreamResponseBuffer;
+            response.maxResponseLength = DIAG_STREAM_FLAT_LENGTH;
+            
+            retVal = DiagnosticService_ProcessUDSRequest(request, &response);
+            if (retVal == E_OK)
+            {
+                stream->fill = IsoTp_FlatStreamFill;
+                stream->flatData = g_StreamResponseBuffer;
+                stream->totalLength = response.responseDataLength;
+                stream->position = 0;
+            }
+        }
+    }
+    
+    return retVal;
+}
+
 /**
  * @brief Set DTC status
  */
 Std_ReturnType DiagnosticService_SetDTC(uint32 dtcNumber, boolean active, WheelPosition_t wheelPos)
 {
     Std_ReturnType retVal = E_NOT_OK;
-    uint8 dtcIndex;
+    uint16 dtcIndex;
     
     if (g_DiagnosticService_Initialized == TRUE)
     {
@@ -155,7 +273,7 @@ Std_ReturnType DiagnosticService_SetDTC(uint32 dtcNumber, boolean active, WheelP
 Std_ReturnType DiagnosticService_ClearDTC(uint32 dtcNumber)
 {
     Std_ReturnType retVal = E_NOT_OK;
-    uint8 dtcIndex;
+    uint16 dtcIndex;
     
     if (g_DiagnosticService_Initialized == TRUE)
     {
@@ -164,6 +282,7 @@ Std_ReturnType DiagnosticService_ClearDTC(uint32 dtcNumber)
             /* Clear DTC status */
             memset(&g_DTCTable[dtcIndex].status, 0, sizeof(DTCStatus_t));
             g_DTCTable[dtcIndex].status.testNotCompletedSinceLastClear = 1;
+            DiagnosticService_UpdateStatusIndex(dtcIndex);
             retVal = E_OK;
         }
     }
@@ -177,18 +296,16 @@ Std_ReturnType DiagnosticService_ClearDTC(uint32 dtcNumber)
 Std_ReturnType DiagnosticService_ClearAllDTCs(void)
 {
     Std_ReturnType retVal = E_NOT_OK;
-    uint8 i;
+    uint16 i;
     
     if (g_DiagnosticService_Initialized == TRUE)
     {
         /* Clear all DTCs */
-        for (i = 0; i < DIAG_MAX_DTC_COUNT; i++)
+        for (i = 0; i < g_StoredDTCCount; i++)
         {
-            if (g_DTCTable[i].dtcNumber != 0)
-            {
-                memset(&g_DTCTable[i].status, 0, sizeof(DTCStatus_t));
-                g_DTCTable[i].status.testNotCompletedSinceLastClear = 1;
-            }
+            memset(&g_DTCTable[i].status, 0, sizeof(DTCStatus_t));
+            g_DTCTable[i].status.testNotCompletedSinceLastClear = 1;
+            DiagnosticService_UpdateStatusIndex(i);
         }
         retVal = E_OK;
     }
@@ -202,7 +319,7 @@ Std_ReturnType DiagnosticService_ClearAllDTCs(void)
 Std_ReturnType DiagnosticService_GetDTCInfo(uint32 dtcNumber, DTCInfo_t* dtcInfo)
 {
     Std_ReturnType retVal = E_NOT_OK;
-    uint8 dtcIndex;
+    uint16 dtcIndex;
     
     if ((dtcInfo != NULL_PTR) && (g_DiagnosticService_Initialized == TRUE))
     {
@@ -222,15 +339,15 @@ Std_ReturnType DiagnosticService_GetDTCInfo(uint32 dtcNumber, DTCInfo_t* dtcInfo
 Std_ReturnType DiagnosticService_GetActiveDTCs(uint32* dtcList, uint8* dtcCount, uint8 maxDtcs)
 {
     Std_ReturnType retVal = E_NOT_OK;
-    uint8 i, count = 0;
+    uint16 i;
+    uint8 count = 0;
     
     if ((dtcList != NULL_PTR) && (dtcCount != NULL_PTR) && (g_DiagnosticService_Initialized == TRUE))
     {
         /* Collect active DTCs */
-        for (i = 0; (i < DIAG_MAX_DTC_COUNT) && (count < maxDtcs); i++)
+        for (i = 0; (i < g_StoredDTCCount) && (count < maxDtcs); i++)
         {
-            if ((g_DTCTable[i].dtcNumber != 0) && 
-                ((g_DTCTable[i].status.testFailed) || (g_DTCTable[i].status.confirmedDTC)))
+            if ((g_DTCTable[i].status.testFailed) || (g_DTCTable[i].status.confirmedDTC))
             {
                 dtcList[count] = g_DTCTable[i].dtcNumber;
                 count++;
@@ -260,6 +377,10 @@ Std_ReturnType UDS_DiagnosticSessionControl(const UDSMessage_t* request, UDSMess
         /* Validate session type */
         if ((requestedSession >= DIAG_SESSION_DEFAULT) && (requestedSession <= DIAG_SESSION_SAFETY_SYSTEM))
         {
+            if (requestedSession != g_CurrentSession)
+            {
+                g_SecurityUnlockedMask = DIAG_SECURITY_NONE;
+            }
             g_CurrentSession = requestedSession;
             
             /* Prepare positive response */
@@ -343,7 +464,7 @@ Std_ReturnType UDS_ClearDiagnosticInformation(const UDSMessage_t* request, UDSMe
         {
             if (DiagnosticService_ClearAllDTCs() == E_OK)
             {
-                /* Clear malfunction status in ABS system */
+                /* Request the ABS task to clear its malfunction status (next detection cycle) */
                 ABS_ClearMalfunctionStatus(WHEEL_FRONT_LEFT);
                 ABS_ClearMalfunctionStatus(WHEEL_FRONT_RIGHT);
                 ABS_ClearMalfunctionStatus(WHEEL_REAR_LEFT);
@@ -402,33 +523,50 @@ Std_ReturnType UDS_ReadDTCInformation(const UDSMessage_t* request, UDSMessage_t*
                 if (request->requestDataLength >= 2)
                 {
                     uint8 statusMask = request->requestData[1];
-                    uint8 dtcCount = 0;
                     uint16 responseIndex = 3;
+                    uint16 wordIdx;
+                    uint16 slot;
+                    uint32 matchWord;
+                    uint8 bit;
                     
                     response->responseData[2] = statusMask; /* Status availability mask */
                     
-                    /* Add DTCs matching status mask */
-                    for (uint8 i = 0; (i < DIAG_MAX_DTC_COUNT) && (responseIndex < (response->maxResponseLength - 4)); i++)
+                    /* Walk only the slots whose status shares a bit with the mask */
+                    for (wordIdx = 0; (wordIdx < DIAG_DTC_INDEX_WORDS) && (responseIndex < (response->maxResponseLength - 4)); wordIdx++)
                     {
-                        if (g_DTCTable[i].dtcNumber != 0)
+                        matchWord = 0;
+                        for (bit = 0; bit < DIAG_DTC_STATUS_BITS; bit++)
+                        {
+                            if ((statusMask & (1U << bit)) != 0U)
+                            {
+                                matchWord |= g_DTCStatusIndex[bit][wordIdx];
+                            }
+                        }
+                        
+                        slot = (uint16)(wordIdx * DIAG_DTC_INDEX_WORD_BITS);
+                        while ((matchWord != 0U) && (responseIndex < (response->maxResponseLength - 4)))
                         {
-                            uint8 dtcStatus = *(uint8*)&g_DTCTable[i].status;
-                            
-                            if (dtcStatus & statusMask)
+                            if ((matchWord & 1U) != 0U)
                             {
                                 /* Add DTC to response */
-                                response->responseData[responseIndex++] = (uint8)(g_DTCTable[i].dtcNumber >> 16);
-                                response->responseData[responseIndex++] = (uint8)(g_DTCTable[i].dtcNumber >> 8);
-                                response->responseData[responseIndex++] = (uint8)(g_DTCTable[i].dtcNumber);
-                                response->responseData[responseIndex++] = dtcStatus;
-                                dtcCount++;
+                                response->responseData[responseIndex++] = (uint8)(g_DTCTable[slot].dtcNumber >> 16);
+                                response->responseData[responseIndex++] = (uint8)(g_DTCTable[slot].dtcNumber >> 8);
+                                response->responseData[responseIndex++] = (uint8)(g_DTCTable[slot].dtcNumber);
+                                response->responseData[responseIndex++] = DiagnosticService_GetStatusByte(slot);
                             }
+                            matchWord >>= 1;
+                            slot++;
                         }
                     }
                     
                     response->responseDataLength = responseIndex;
                     retVal = E_OK;
                 }
+                else
+                {
+                    DiagnosticService_PrepareErrorResponse(response, UDS_SID_READ_DTC_INFORMATION, UDS_NRC_INCORRECT_MESSAGE_LENGTH);
+                    retVal = E_OK;
+                }
                 break;
                 
             case 0x0A: /* reportSupportedDTC */
@@ -436,14 +574,11 @@ Std_ReturnType UDS_ReadDTCInformation(const UDSMessage_t* request, UDSMessage_t*
                     uint16 responseIndex = 2;
                     
                     /* Add all supported DTCs */
-                    for (uint8 i = 0; (i < DIAG_MAX_DTC_COUNT) && (responseIndex < (response->maxResponseLength - 3)); i++)
+                    for (uint16 i = 0; (i < g_StoredDTCCount) && (responseIndex < (response->maxResponseLength - 3)); i++)
                     {
-                        if (g_DTCTable[i].dtcNumber != 0)
-                        {
-                            response->responseData[responseIndex++] = (uint8)(g_DTCTable[i].dtcNumber >> 16);
-                            response->responseData[responseIndex++] = (uint8)(g_DTCTable[i].dtcNumber >> 8);
-                            response->responseData[responseIndex++] = (uint8)(g_DTCTable[i].dtcNumber);
-                        }
+                        response->responseData[responseIndex++] = (uint8)(g_DTCTable[i].dtcNumber >> 16);
+                        response->responseData[responseIndex++] = (uint8)(g_DTCTable[i].dtcNumber >> 8);
+                        response->responseData[responseIndex++] = (uint8)(g_DTCTable[i].dtcNumber);
                     }
                     
                     response->responseDataLength = responseIndex;
@@ -468,47 +603,79 @@ Std_ReturnType UDS_ReadDTCInformation(const UDSMessage_t* request, UDSMessage_t*
 
 /**
  * @brief UDS Read Data By Identifier (0x22)
+ *
+ * A request may carry up to DIAG_MAX_DIDS_PER_REQUEST identifiers. All of them
+ * are resolved and the response length is checked before any data is read;
+ * unsupported identifiers are skipped as long as at least one is supported.
  */
 Std_ReturnType UDS_ReadDataByIdentifier(const UDSMessage_t* request, UDSMessage_t* response)
 {
     Std_ReturnType retVal = E_NOT_OK;
+    const DIDEntry_t* didEntries[DIAG_MAX_DIDS_PER_REQUEST];
+    uint16 didCount = request->requestDataLength / 2U;
+    uint16 supportedCount = 0;
+    uint32 requiredLength = 1;
+    uint16 responseIndex;
+    uint16 dataId;
+    uint16 dataLength;
+    uint16 i;
     
-    if ((request->requestDataLength >= 2) && (response->maxResponseLength >= 3))
+    if ((request->requestDataLength >= 2) && ((request->requestDataLength % 2U) == 0U) &&
+        (didCount <= DIAG_MAX_DIDS_PER_REQUEST) && (response->maxResponseLength >= 3))
     {
-        uint16 dataId = ((uint16)request->requestData[0] << 8) | request->requestData[1];
-        uint16 dataLength = 0;
-        
-        response->responseData[0] = UDS_SID_READ_DATA_BY_IDENTIFIER + 0x40;
-        response->responseData[1] = request->requestData[0]; /* DID high byte */
-        response->responseData[2] = request->requestData[1]; /* DID low byte */
-        
-        /* Handle different DIDs */
-        if ((dataId >= DID_SPEED_SENSOR_FL_DATA) && (dataId <= DID_SPEED_SENSOR_RR_DATA))
-        {
-            retVal = DID_ReadSpeedSensorData(dataId, &response->responseData[3], &dataLength);
-        }
-        else if ((dataId >= DID_CALIBRATION_FL_PARAMS) && (dataId <= DID_CALIBRATION_RR_PARAMS))
+        /* Resolve identifiers and size the response up front */
+        for (i = 0; i < didCount; i++)
         {
-            retVal = DID_ReadCalibrationParams(dataId, &response->responseData[3], &dataLength);
+            dataId = DiagnosticService_GetUint16(&request->requestData[2U * i]);
+            didEntries[i] = DiagnosticService_GetDIDEntry(dataId);
+            
+            if (didEntries[i] != NULL_PTR)
+            {
+                requiredLength += 2U + didEntries[i]->payloadLength;
+                supportedCount++;
+            }
         }
-        else if (dataId == DID_ABS_SYSTEM_STATUS)
+        
+        if (supportedCount == 0U)
         {
-            retVal = DID_ReadABSSystemStatus(&response->responseData[3], &dataLength);
+            DiagnosticService_PrepareErrorResponse(response, UDS_SID_READ_DATA_BY_IDENTIFIER, UDS_NRC_REQUEST_OUT_OF_RANGE);
         }
-        else if (dataId == DID_MALFUNCTION_COUNTER)
+        else if (requiredLength > response->maxResponseLength)
         {
-            retVal = DID_ReadMalfunctionCounter(&response->responseData[3], &dataLength);
+            DiagnosticService_PrepareErrorResponse(response, UDS_SID_READ_DATA_BY_IDENTIFIER, UDS_NRC_RESPONSE_TOO_LONG);
         }
         else
         {
-            DiagnosticService_PrepareErrorResponse(response, UDS_SID_READ_DATA_BY_IDENTIFIER, UDS_NRC_REQUEST_OUT_OF_RANGE);
-            retVal = E_OK;
-        }
-        
-        if (retVal == E_OK)
-        {
-            response->responseDataLength = 3 + dataLength;
+            response->responseData[0] = UDS_SID_READ_DATA_BY_IDENTIFIER + 0x40;
+            responseIndex = 1;
+            
+            for (i = 0; i < didCount; i++)
+            {
+                if (didEntries[i] != NULL_PTR)
+                {
+                    dataId = DiagnosticService_GetUint16(&request->requestData[2U * i]);
+                    dataLength = 0;
+                    
+                    DiagnosticService_PutUint16(&response->responseData[responseIndex], dataId);
+                    if ((didEntries[i]->readHandler(dataId, &response->responseData[responseIndex + 2U], &dataLength) != E_OK) ||
+                        (dataLength != didEntries[i]->payloadLength))
+                    {
+                        break;
+                    }
+                    responseIndex += 2U + dataLength;
+                }
+            }
+            
+            if (i == didCount)
+            {
+                response->responseDataLength = responseIndex;
+            }
+            else
+            {
+                DiagnosticService_PrepareErrorResponse(response, UDS_SID_READ_DATA_BY_IDENTIFIER, UDS_NRC_CONDITIONS_NOT_CORRECT);
+            }
         }
+        retVal = E_OK;
     }
     else
     {
@@ -528,34 +695,38 @@ Std_ReturnType UDS_WriteDataByIdentifier(const UDSMessage_t* request, UDSMessage
     
     if ((request->requestDataLength >= 3) && (response->maxResponseLength >= 3))
     {
-        uint16 dataId = ((uint16)request->requestData[0] << 8) | request->requestData[1];
+        uint16 dataId = DiagnosticService_GetUint16(&request->requestData[0]);
+        const DIDEntry_t* didEntry = DiagnosticService_GetDIDEntry(dataId);
         
-        /* Only allow write in extended diagnostic session */
-        if (g_CurrentSession == DIAG_SESSION_EXTENDED)
+        /* Session access (extended only) is checked through the service table */
+        if ((didEntry == NULL_PTR) || (didEntry->writeHandler == NULL_PTR))
+        {
+            DiagnosticService_PrepareErrorResponse(response, UDS_SID_WRITE_DATA_BY_IDENTIFIER, UDS_NRC_REQUEST_OUT_OF_RANGE);
+            retVal = E_OK;
+        }
+        else if ((request->requestDataLength - 2U) != didEntry->payloadLength)
+        {
+            DiagnosticService_PrepareErrorResponse(response, UDS_SID_WRITE_DATA_BY_IDENTIFIER, UDS_NRC_INCORRECT_MESSAGE_LENGTH);
+            retVal = E_OK;
+        }
+        else
         {
-            if ((dataId >= DID_CALIBRATION_FL_PARAMS) && (dataId <= DID_CALIBRATION_RR_PARAMS))
+            retVal = didEntry->writeHandler(dataId, &request->requestData[2], didEntry->payloadLength);
+            
+            if (retVal == E_OK)
             {
-                retVal = DID_WriteCalibrationParams(dataId, &request->requestData[2], request->requestDataLength - 2);
-                
-                if (retVal == E_OK)
-                {
-                    response->responseData[0] = UDS_SID_WRITE_DATA_BY_IDENTIFIER + 0x40;
-                    response->responseData[1] = request->requestData[0];
-                    response->responseData[2] = request->requestData[1];
-                    response->responseDataLength = 3;
-                }
+                response->responseData[0] = UDS_SID_WRITE_DATA_BY_IDENTIFIER + 0x40;
+                response->responseData[1] = request->requestData[0];
+                response->responseData[2] = request->requestData[1];
+                response->responseDataLength = 3;
             }
             else
             {
+                /* Rejected by the parameter range check */
                 DiagnosticService_PrepareErrorResponse(response, UDS_SID_WRITE_DATA_BY_IDENTIFIER, UDS_NRC_REQUEST_OUT_OF_RANGE);
                 retVal = E_OK;
             }
         }
-        else
-        {
-            DiagnosticService_PrepareErrorResponse(response, UDS_SID_WRITE_DATA_BY_IDENTIFIER, UDS_NRC_CONDITIONS_NOT_CORRECT);
-            retVal = E_OK;
-        }
     }
     else
     {
@@ -572,6 +743,7 @@ Std_ReturnType UDS_WriteDataByIdentifier(const UDSMessage_t* request, UDSMessage
 Std_ReturnType UDS_InputOutputControlByIdentifier(const UDSMessage_t* request, UDSMessage_t* response)
 {
     /* Not implemented for this application */
+    (void)request;
     DiagnosticService_PrepareErrorResponse(response, UDS_SID_IO_CONTROL_BY_IDENTIFIER, UDS_NRC_SERVICE_NOT_SUPPORTED);
     return E_OK;
 }
@@ -583,63 +755,63 @@ Std_ReturnType UDS_RoutineControl(const UDSMessage_t* request, UDSMessage_t* res
 {
     Std_ReturnType retVal = E_NOT_OK;
     
-    if ((request->requestDataLength >= 4) && (response->maxResponseLength >= 4))
+    if ((request->requestDataLength >= 4) && (response->maxResponseLength >= (4U + DIAG_ROUTINE_STATUS_MAX_LENGTH)))
     {
         uint8 subFunction = request->requestData[0];
         uint16 routineId = ((uint16)request->requestData[1] << 8) | request->requestData[2];
         
-        if (g_CurrentSession == DIAG_SESSION_EXTENDED)
+        /* Session access (extended only) is checked through the service table */
+        response->responseData[0] = UDS_SID_ROUTINE_CONTROL + 0x40;
+        response->responseData[1] = subFunction;
+        response->responseData[2] = request->requestData[1];
+        response->responseData[3] = request->requestData[2];
+        response->responseDataLength = 4;
+        
+        if (subFunction == 0x01) /* Start routine */
         {
-            response->responseData[0] = UDS_SID_ROUTINE_CONTROL + 0x40;
-            response->responseData[1] = subFunction;
-            response->responseData[2] = request->requestData[1];
-            response->responseData[3] = request->requestData[2];
-            response->responseDataLength = 4;
-            
-            if (subFunction == 0x01) /* Start routine */
+            if ((routineId >= RID_START_CALIBRATION_FL) && (routineId <= RID_START_CALIBRATION_ALL))
             {
-                if ((routineId >= RID_START_CALIBRATION_FL) && (routineId <= RID_START_CALIBRATION_RR))
-                {
-                    uint16 responseLength = 0;
-                    retVal = RID_StartCalibration(routineId, &request->requestData[3], 
-                                                request->requestDataLength - 3, 
-                                                &response->responseData[4], &responseLength);
-                    response->responseDataLength += responseLength;
-                }
-                else if (routineId == RID_VALIDATE_CALIBRATION)
-                {
-                    uint16 responseLength = 0;
-                    retVal = RID_ValidateCalibration(&request->requestData[3], request->requestDataLength - 3,
-                                                   &response->responseData[4], &responseLength);
-                    response->responseDataLength += responseLength;
-                }
-                else if (routineId == RID_RESET_CALIBRATION_ALL)
-                {
-                    uint16 responseLength = 0;
-                    retVal = RID_ResetCalibrationAll(&response->responseData[4], &responseLength);
-                    response->responseDataLength += responseLength;
-                }
-                else if (routineId == RID_ABS_SELF_TEST)
-                {
-                    uint16 responseLength = 0;
-                    retVal = RID_ABSSelfTest(&response->responseData[4], &responseLength);
-                    response->responseDataLength += responseLength;
-                }
-                else
-                {
-                    DiagnosticService_PrepareErrorResponse(response, UDS_SID_ROUTINE_CONTROL, UDS_NRC_REQUEST_OUT_OF_RANGE);
-                    retVal = E_OK;
-                }
+                uint16 responseLength = 0;
+                retVal = RID_StartCalibration(routineId, &request->requestData[3], 
+                                            request->requestDataLength - 3, 
+                                            &response->responseData[4], &responseLength);
+                response->responseDataLength += responseLength;
+            }
+            else if (routineId == RID_VALIDATE_CALIBRATION)
+            {
+                uint16 responseLength = 0;
+                retVal = RID_ValidateCalibration(&request->requestData[3], request->requestDataLength - 3,
+                                               &response->responseData[4], &responseLength);
+                response->responseDataLength += responseLength;
+            }
+            else if (routineId == RID_RESET_CALIBRATION_ALL)
+            {
+                uint16 responseLength = 0;
+                retVal = RID_ResetCalibrationAll(&response->responseData[4], &responseLength);
+                response->responseDataLength += responseLength;
+            }
+            else if (routineId == RID_ABS_SELF_TEST)
+            {
+                uint16 responseLength = 0;
+                retVal = RID_ABSSelfTest(&response->responseData[4], &responseLength);
+                response->responseDataLength += responseLength;
             }
             else
             {
-                DiagnosticService_PrepareErrorResponse(response, UDS_SID_ROUTINE_CONTROL, UDS_NRC_SUBFUNCTION_NOT_SUPPORTED);
+                DiagnosticService_PrepareErrorResponse(response, UDS_SID_ROUTINE_CONTROL, UDS_NRC_REQUEST_OUT_OF_RANGE);
+                retVal = E_OK;
+            }
+            
+            if (retVal != E_OK)
+            {
+                /* Routine option record rejected */
+                DiagnosticService_PrepareErrorResponse(response, UDS_SID_ROUTINE_CONTROL, UDS_NRC_REQUEST_OUT_OF_RANGE);
                 retVal = E_OK;
             }
         }
         else
         {
-            DiagnosticService_PrepareErrorResponse(response, UDS_SID_ROUTINE_CONTROL, UDS_NRC_CONDITIONS_NOT_CORRECT);
+            DiagnosticService_PrepareErrorResponse(response, UDS_SID_ROUTINE_CONTROL, UDS_NRC_SUBFUNCTION_NOT_SUPPORTED);
             retVal = E_OK;
         }
     }
@@ -652,59 +824,61 @@ Std_ReturnType UDS_RoutineControl(const UDSMessage_t* request, UDSMessage_t* res
     return retVal;
 }
 
-/* Internal Functions */
-
 /**
- * @brief Find DTC in table
+ * @brief UDS Tester Present (0x3E)
+ *
+ * With the suppressPosRspMsgIndicationBit set the response length is 0 and
+ * nothing is sent.
  */
-static Std_ReturnType DiagnosticService_FindDTC(uint32 dtcNumber, uint8* index)
+Std_ReturnType UDS_TesterPresent(const UDSMessage_t* request, UDSMessage_t* response)
 {
-    Std_ReturnType retVal = E_NOT_OK;
-    uint8 i;
-    
-    for (i = 0; i < DIAG_MAX_DTC_COUNT; i++)
+    if ((request->requestDataLength == 1) && (response->maxResponseLength >= 3))
     {
-        if (g_DTCTable[i].dtcNumber == dtcNumber)
+        if (request->requestData[0] == 0x80)
         {
-            *index = i;
-            retVal = E_OK;
-            break;
+            response->responseDataLength = 0;
+        }
+        else if (request->requestData[0] == 0x00)
+        {
+            response->responseData[0] = UDS_SID_TESTER_PRESENT + 0x40;
+            response->responseData[1] = 0x00;
+            response->responseDataLength = 2;
         }
+        else
+        {
+            DiagnosticService_PrepareErrorResponse(response, UDS_SID_TESTER_PRESENT, UDS_NRC_SUBFUNCTION_NOT_SUPPORTED);
+        }
+    }
+    else
+    {
+        DiagnosticService_PrepareErrorResponse(response, UDS_SID_TESTER_PRESENT, UDS_NRC_INCORRECT_MESSAGE_LENGTH);
     }
     
-    return retVal;
+    return E_OK;
 }
 
+/* DID Read/Write Functions */
+
 /**
- * @brief Add DTC to table
+ * @brief Read speed sensor data DID (0xF100-0xF103)
  */
-static Std_ReturnType DiagnosticService_AddDTC(uint32 dtcNumber, WheelPosition_t wheelPos, ABS_MalfunctionType_t type)
+Std_ReturnType DID_ReadSpeedSensorData(uint16 did, uint8* data, uint16* length)
 {
     Std_ReturnType retVal = E_NOT_OK;
-    uint8 i;
-    
-    /* Find empty slot */
-    for (i = 0; i < DIAG_MAX_DTC_COUNT; i++)
-    {
-        if (g_DTCTable[i].dtcNumber == 0)
-        {
-            g_DTCTable[i].dtcNumber = dtcNumber;
-            g_DTCTable[i].affectedWheel = wheelPos;
-            g_DTCTable[i].malfunctionType = type;
-            g_DTCTable[i].status.testFailed = 1;
-            g_DTCTable[i].status.testFailedThisOperationCycle = 1;
-            g_DTCTable[i].status.pendingDTC = 1;
-            g_DTCTable[i].occurrenceCount = 1;
-            g_DTCTable[i].firstFailureTimestamp = 0; /* Should be actual timestamp */
-            g_DTCTable[i].lastFailureTimestamp = 0;
-            
-            if (g_ActiveDTCCount < DIAG_MAX_DTC_COUNT)
-            {
-                g_ActiveDTCCount++;
-            }
-            
+    SpeedData_t speedData;
+    
+    if ((did >= DID_SPEED_SENSOR_FL_DATA) && (did <= DID_SPEED_SENSOR_RR_DATA) &&
+        (data != NULL_PTR) && (length != NULL_PTR))
+    {
+        if (SpeedSensor_GetSpeedData((WheelPosition_t)(did - DID_SPEED_SENSOR_FL_DATA), &speedData) == E_OK)
+        {
+            DiagnosticService_PutUint16(&data[0], DiagnosticService_ScaleToUint16(speedData.wheelSpeed, 100.0f));
+            DiagnosticService_PutUint16(&data[2], DiagnosticService_ScaleToUint16(speedData.wheelSpeedRaw, 100.0f));
+            DiagnosticService_PutUint16(&data[4], (uint16)DiagnosticService_ScaleToSint16(speedData.accelerationX, 100.0f));
+            data[6] = speedData.speedValid;
+            data[7] = speedData.qualityFactor;
+            *length = DID_SPEED_SENSOR_DATA_LENGTH;
             retVal = E_OK;
-            break;
         }
     }
     
@@ -712,148 +886,911 @@ static Std_ReturnType DiagnosticService_AddDTC(uint32 dtcNumber, WheelPosition_t
 }
 
 /**
- * @brief Update DTC status
+ * @brief Read calibration parameters DID (0xF110-0xF113)
  */
-static Std_ReturnType DiagnosticService_UpdateDTCStatus(uint32 dtcNumber, boolean active)
+Std_ReturnType DID_ReadCalibrationParams(uint16 did, uint8* data, uint16* length)
 {
     Std_ReturnType retVal = E_NOT_OK;
-    uint8 dtcIndex;
+    SpeedSensorCalibration_t calibration;
     
-    if (DiagnosticService_FindDTC(dtcNumber, &dtcIndex) == E_OK)
+    if ((did >= DID_CALIBRATION_FL_PARAMS) && (did <= DID_CALIBRATION_RR_PARAMS) &&
+        (data != NULL_PTR) && (length != NULL_PTR))
     {
-        if (active == TRUE)
-        {
-            g_DTCTable[dtcIndex].status.testFailed = 1;
-            g_DTCTable[dtcIndex].status.testFailedThisOperationCycle = 1;
-            g_DTCTable[dtcIndex].occurrenceCount++;
-            g_DTCTable[dtcIndex].lastFailureTimestamp = 0; /* Should be actual timestamp */
-            
-            /* Confirm DTC after multiple occurrences */
-            if (g_DTCTable[dtcIndex].occurrenceCount >= 3)
-            {
-                g_DTCTable[dtcIndex].status.confirmedDTC = 1;
-            }
-        }
-        else
+        if (SpeedSensor_GetCalibration((WheelPosition_t)(did - DID_CALIBRATION_FL_PARAMS), &calibration) == E_OK)
         {
-            g_DTCTable[dtcIndex].status.testFailed = 0;
+            DiagnosticService_PutUint16(&data[0], DiagnosticService_ScaleToUint16(calibration.correctionFactor, 10000.0f));
+            DiagnosticService_PutUint16(&data[2], (uint16)DiagnosticService_ScaleToSint16(calibration.offsetValue, 100.0f));
+            DiagnosticService_PutUint16(&data[4], calibration.pulsesPerRevolution);
+            DiagnosticService_PutUint16(&data[6], DiagnosticService_ScaleToUint16(calibration.wheelCircumference, 1000.0f));
+            data[8] = calibration.calibrationValid;
+            *length = DID_CALIBRATION_PARAMS_LENGTH;
+            retVal = E_OK;
         }
-        
-        retVal = E_OK;
     }
     
     return retVal;
 }
 
 /**
- * @brief Get service handler for service ID
+ * @brief Write calibration parameters DID (0xF110-0xF113)
+ *
+ * Uses the read layout; the validity byte is ignored because the speed sensor
+ * marks accepted parameters valid itself.
  */
-static UDSServiceHandler_t DiagnosticService_GetServiceHandler(uint8 serviceId)
+Std_ReturnType DID_WriteCalibrationParams(uint16 did, const uint8* data, uint16 length)
 {
-    UDSServiceHandler_t handler = NULL_PTR;
-    uint8 i;
+    Std_ReturnType retVal = E_NOT_OK;
+    SpeedSensorCalibration_t calibration;
+    WheelPosition_t wheelPos;
     
-    for (i = 0; i < UDS_SERVICE_TABLE_SIZE; i++)
+    if ((did >= DID_CALIBRATION_FL_PARAMS) && (did <= DID_CALIBRATION_RR_PARAMS) &&
+        (data != NULL_PTR) && (length == DID_CALIBRATION_PARAMS_LENGTH))
     {
-        if (g_UDSServiceTable[i].serviceId == serviceId)
+        wheelPos = (WheelPosition_t)(did - DID_CALIBRATION_FL_PARAMS);
+        
+        if (SpeedSensor_GetCalibration(wheelPos, &calibration) == E_OK)
         {
-            handler = g_UDSServiceTable[i].handler;
-            break;
+            calibration.correctionFactor = (float32)DiagnosticService_GetUint16(&data[0]) / 10000.0f;
+            calibration.offsetValue = (float32)(sint16)DiagnosticService_GetUint16(&data[2]) / 100.0f;
+            calibration.pulsesPerRevolution = DiagnosticService_GetUint16(&data[4]);
+            calibration.wheelCircumference = (float32)DiagnosticService_GetUint16(&data[6]) / 1000.0f;
+            
+            retVal = SpeedSensor_SetCalibration(wheelPos, &calibration);
         }
     }
     
-    return handler;
-}
-
-/**
- * @brief Prepare error response
- */
-static void DiagnosticService_PrepareErrorResponse(UDSMessage_t* response, uint8 serviceId, uint8 nrc)
-{
-    response->responseData[0] = 0x7F; /* Negative response */
-    response->responseData[1] = serviceId;
-    response->responseData[2] = nrc;
-    response->responseDataLength = 3;
+    return retVal;
 }
 
 /**
- * @brief Get DTC for malfunction type and wheel position
+ * @brief Read ABS system status DID (0xF120)
  */
-static uint32 DiagnosticService_GetDTCForMalfunction(ABS_MalfunctionType_t type, WheelPosition_t wheelPos)
+Std_ReturnType DID_ReadABSSystemStatus(uint16 did, uint8* data, uint16* length)
 {
-    uint32 dtcNumber = 0;
+    Std_ReturnType retVal = E_NOT_OK;
+    ABS_MalfunctionStatus_t malfunctionStatus;
+    ABS_SystemState_t systemState;
+    boolean systemHealthy;
+    uint8 activeMask = 0U;
+    uint8 confirmedMask = 0U;
+    uint8 wheelIdx;
     
-    switch (type)
+    if ((did == DID_ABS_SYSTEM_STATUS) && (data != NULL_PTR) && (length != NULL_PTR))
     {
-        case ABS_MALFUNCTION_SPEED_SENSOR_MISCALIBRATION:
-            switch (wheelPos)
-            {
-                case WHEEL_FRONT_LEFT: dtcNumber = DTC_SPEED_SENSOR_FL_MISCALIBRATED; break;
-                case WHEEL_FRONT_RIGHT: dtcNumber = DTC_SPEED_SENSOR_FR_MISCALIBRATED; break;
-                case WHEEL_REAR_LEFT: dtcNumber = DTC_SPEED_SENSOR_RL_MISCALIBRATED; break;
-                case WHEEL_REAR_RIGHT: dtcNumber = DTC_SPEED_SENSOR_RR_MISCALIBRATED; break;
-                default: break;
-            }
-            break;
-            
-        case ABS_MALFUNCTION_SPEED_SENSOR_FAILURE:
-            switch (wheelPos)
+        if (ABS_CheckSystemHealth(&systemHealthy, &systemState) == E_OK)
+        {
+            for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
             {
-                case WHEEL_FRONT_LEFT: dtcNumber = DTC_SPEED_SENSOR_FL_FAILURE; break;
-                case WHEEL_FRONT_RIGHT: dtcNumber = DTC_SPEED_SENSOR_FR_FAILURE; break;
-                case WHEEL_REAR_LEFT: dtcNumber = DTC_SPEED_SENSOR_RL_FAILURE; break;
-                case WHEEL_REAR_RIGHT: dtcNumber = DTC_SPEED_SENSOR_RR_FAILURE; break;
-                default: break;
+                if (ABS_GetMalfunctionStatus((WheelPosition_t)wheelIdx, &malfunctionStatus) == E_OK)
+                {
+                    if (malfunctionStatus.isActive == TRUE)
+                    {
+                        activeMask |= (uint8)(1U << wheelIdx);
+                    }
+                    if (malfunctionStatus.confirmedMalfunction == TRUE)
+                    {
+                        confirmedMask |= (uint8)(1U << wheelIdx);
+                    }
+                }
             }
-            break;
-            
-        case ABS_MALFUNCTION_SPEED_DIFFERENCE_EXCESSIVE:
-            dtcNumber = DTC_SPEED_PLAUSIBILITY_ERROR;
-            break;
             
-        default:
-            dtcNumber = DTC_ABS_SYSTEM_MALFUNCTION;
-            break;
+            data[0] = (uint8)systemState;
+            data[1] = systemHealthy;
+            data[2] = activeMask;
+            data[3] = confirmedMask;
+            *length = DID_ABS_SYSTEM_STATUS_LENGTH;
+            retVal = E_OK;
+        }
     }
     
-    return dtcNumber;
+    return retVal;
 }
 
 /**
- * @brief Monitor ABS malfunctions and update DTCs
+ * @brief Read malfunction counter DID (0xF121)
  */
-static void DiagnosticService_MonitorMalfunctions(void)
+Std_ReturnType DID_ReadMalfunctionCounter(uint16 did, uint8* data, uint16* length)
 {
+    Std_ReturnType retVal = E_NOT_OK;
     ABS_MalfunctionStatus_t malfunctionStatus;
     uint8 wheelIdx;
     
-    /* Check malfunction status for all wheels */
-    for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+    if ((did == DID_MALFUNCTION_COUNTER) && (data != NULL_PTR) && (length != NULL_PTR))
     {
-        if (ABS_GetMalfunctionStatus((WheelPosition_t)wheelIdx, &malfunctionStatus) == E_OK)
+        retVal = E_OK;
+        for (wheelIdx = 0; (wheelIdx < WHEEL_MAX) && (retVal == E_OK); wheelIdx++)
         {
-            if (malfunctionStatus.confirmedMalfunction == TRUE)
+            retVal = ABS_GetMalfunctionStatus((WheelPosition_t)wheelIdx, &malfunctionStatus);
+            if (retVal == E_OK)
             {
-                uint32 dtcNumber = DiagnosticService_GetDTCForMalfunction(malfunctionStatus.malfunctionType, 
-                                                                        malfunctionStatus.affectedWheel);
-                
-                if (dtcNumber != 0)
-                {
-                    DiagnosticService_SetDTC(dtcNumber, TRUE, malfunctionStatus.affectedWheel);
-                }
+                DiagnosticService_PutUint16(&data[2U * wheelIdx], malfunctionStatus.occurrenceCount);
             }
         }
+        
+        if (retVal == E_OK)
+        {
+            *length = DID_MALFUNCTION_COUNTER_LENGTH;
+        }
     }
+    
+    return retVal;
 }
 
-/* RTE Runnable Functions */
-
+#if defined(RUNNABLE_TIMING)
 /**
- * @brief RTE Runnable for main diagnostic processing
+ * @brief Read runnable timing DIDs (0xF130-0xF133)
+ *
+ * Activations (uint32), execution time and activation jitter min/avg/max in us,
+ * then the execution time and jitter histograms (8 bins each, see
+ * RUNNABLE_TIMING_BIN_EDGES_PERMILLE). All 16-bit values saturate.
  */
-void RE_DiagnosticService_MainCyclic(void)
+Std_ReturnType DID_ReadRunnableTiming(uint16 did, uint8* data, uint16* length)
 {
-    DiagnosticService_MainFunction();
+    Std_ReturnType retVal = E_NOT_OK;
+    RunnableTiming_Summary_t summary;
+    uint8 bin;
+    
+    if ((did >= DID_RUNNABLE_TIMING_FIRST) && (did <= DID_RUNNABLE_TIMING_LAST) &&
+        (data != NULL_PTR) && (length != NULL_PTR) &&
+        (RunnableTiming_GetSummary((RunnableId_t)(did - DID_RUNNABLE_TIMING_FIRST), &summary) == E_OK))
+    {
+        DiagnosticService_PutUint16(&data[0], (uint16)(summary.activations >> 16));
+        DiagnosticService_PutUint16(&data[2], (uint16)summary.activations);
+        DiagnosticService_PutUint16(&data[4], DiagnosticService_TicksToUs(summary.execMinTicks));
+        DiagnosticService_PutUint16(&data[6], DiagnosticService_TicksToUs(summary.execAvgTicks));
+        DiagnosticService_PutUint16(&data[8], DiagnosticService_TicksToUs(summary.execMaxTicks));
+        DiagnosticService_PutUint16(&data[10], DiagnosticService_TicksToUs(summary.jitterMinTicks));
+        DiagnosticService_PutUint16(&data[12], DiagnosticService_TicksToUs(summary.jitterAvgTicks));
+        DiagnosticService_PutUint16(&data[14], DiagnosticService_TicksToUs(summary.jitterMaxTicks));
+        for (bin = 0; bin < RUNNABLE_TIMING_HISTOGRAM_BINS; bin++)
+        {
+            DiagnosticService_PutUint16(&data[16U + (2U * bin)],
+                (summary.execHistogram[bin] > 0xFFFFU) ? 0xFFFFU : (uint16)summary.execHistogram[bin]);
+            DiagnosticService_PutUint16(&data[32U + (2U * bin)],
+                (summary.jitterHistogram[bin] > 0xFFFFU) ? 0xFFFFU : (uint16)summary.jitterHistogram[bin]);
+        }
+        
+        *length = DID_RUNNABLE_TIMING_LENGTH;
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
+#endif
+
+/**
+ * @brief Read diagnostic session info DID (0xF1F0)
+ */
+Std_ReturnType DID_ReadDiagnosticSessionInfo(uint16 did, uint8* data, uint16* length)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    
+    if ((did == DID_DIAGNOSTIC_SESSION_INFO) && (data != NULL_PTR) && (length != NULL_PTR))
+    {
+        data[0] = (uint8)g_CurrentSession;
+        *length = DID_DIAGNOSTIC_SESSION_INFO_LENGTH;
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
+
+/* Routine Control Functions */
+
+/**
+ * @brief Start calibration routine (0x0201-0x0204 per wheel, 0x0205 all wheels)
+ *
+ * Option record: calibration method (1 byte), reference speed [0.01 km/h] (2 bytes).
+ * Status record: calibration result code (1 byte).
+ */
+Std_ReturnType RID_StartCalibration(uint16 rid, const uint8* data, uint16 length, uint8* response, uint16* responseLength)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    CalibrationRequest_t calRequest;
+    Std_ReturnType calResult;
+    
+    if ((rid >= RID_START_CALIBRATION_FL) && (rid <= RID_START_CALIBRATION_ALL) &&
+        (data != NULL_PTR) && (length >= 3) && (data[0] <= (uint8)CALIBRATION_METHOD_GPS_BASED) &&
+        (response != NULL_PTR) && (responseLength != NULL_PTR))
+    {
+        calRequest.wheelPosition = (WheelPosition_t)(rid - RID_START_CALIBRATION_FL);
+        calRequest.method = (CalibrationMethod_t)data[0];
+        calRequest.referenceSpeed = (float32)DiagnosticService_GetUint16(&data[1]) / 100.0f;
+        calRequest.tolerancePercentage = CALIBRATION_TOLERANCE;
+        calRequest.calibrationTimeMs = (uint16)CALIBRATION_TIMEOUT_MS;
+        calRequest.forceCalibration = FALSE;
+        
+        if (rid == RID_START_CALIBRATION_ALL)
+        {
+            /* Shared reference for all wheels, finalised per axle */
+            calResult = CalibrationManager_StartCalibrationAll(&calRequest);
+        }
+        else
+        {
+            calResult = CalibrationManager_StartCalibration(&calRequest);
+        }
+        
+        /* Routine status: the manager reports a busy or rejected wheel, any other failure is NOT_OK */
+        switch (calResult)
+        {
+            case E_OK:
+                response[0] = (uint8)CALIBRATION_RESULT_OK;
+                break;
+            case CALIBRATION_RESULT_IN_PROGRESS:
+                response[0] = (uint8)CALIBRATION_RESULT_IN_PROGRESS;
+                break;
+            case CALIBRATION_RESULT_INVALID_PARAM:
+                response[0] = (uint8)CALIBRATION_RESULT_INVALID_PARAM;
+                break;
+            default:
+                response[0] = (uint8)CALIBRATION_RESULT_NOT_OK;
+                break;
+        }
+        *responseLength = 1;
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief Validate calibration routine (0x0210)
+ *
+ * Status record: validity flag and accuracy [%] for each wheel (FL, FR, RL, RR).
+ */
+Std_ReturnType RID_ValidateCalibration(const uint8* data, uint16 length, uint8* response, uint16* responseLength)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    boolean isValid;
+    float32 accuracy;
+    uint8 wheelIdx;
+    
+    (void)data;
+    (void)length;
+    
+    if ((response != NULL_PTR) && (responseLength != NULL_PTR))
+    {
+        retVal = E_OK;
+        for (wheelIdx = 0; (wheelIdx < WHEEL_MAX) && (retVal == E_OK); wheelIdx++)
+        {
+            retVal = CalibrationManager_ValidateCalibration((WheelPosition_t)wheelIdx, &isValid, &accuracy);
+            if (retVal == E_OK)
+            {
+                response[2U * wheelIdx] = isValid;
+                response[(2U * wheelIdx) + 1U] = (uint8)DiagnosticService_ScaleToUint16(accuracy, 1.0f);
+            }
+        }
+        
+        if (retVal == E_OK)
+        {
+            *responseLength = 2U * WHEEL_MAX;
+        }
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief Reset all calibrations to factory defaults (0x0220)
+ *
+ * Status record: mask of the wheels that were reset (bit 0 = FL).
+ */
+Std_ReturnType RID_ResetCalibrationAll(uint8* response, uint16* responseLength)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    uint8 resetMask = 0U;
+    uint8 wheelIdx;
+    
+    if ((response != NULL_PTR) && (responseLength != NULL_PTR))
+    {
+        for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+        {
+            if (CalibrationManager_ResetToFactory((WheelPosition_t)wheelIdx) == E_OK)
+            {
+                resetMask |= (uint8)(1U << wheelIdx);
+            }
+        }
+        
+        response[0] = resetMask;
+        *responseLength = 1;
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief ABS self-test routine (0x0230)
+ *
+ * Status record: system healthy, system state, all sensors OK.
+ */
+Std_ReturnType RID_ABSSelfTest(uint8* response, uint16* responseLength)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    ABS_SystemState_t systemState;
+    boolean systemHealthy;
+    boolean allSensorsOk;
+    
+    if ((response != NULL_PTR) && (responseLength != NULL_PTR))
+    {
+        if ((ABS_CheckSystemHealth(&systemHealthy, &systemState) == E_OK) &&
+            (SpeedSensor_CheckAllSensors(&allSensorsOk) == E_OK))
+        {
+            response[0] = systemHealthy;
+            response[1] = (uint8)systemState;
+            response[2] = allSensorsOk;
+            *responseLength = 3;
+            retVal = E_OK;
+        }
+    }
+    
+    return retVal;
+}
+
+/* Internal Functions */
+
+/**
+ * @brief Hash a 24-bit DTC number to its home bucket (Fibonacci hashing)
+ */
+static uint16 DiagnosticService_HashDTC(uint32 dtcNumber)
+{
+    uint32 product = (uint32)((dtcNumber * 2654435761UL) & 0xFFFFFFFFUL);
+    
+    return (uint16)(product >> (32U - DIAG_DTC_HASH_BITS));
+}
+
+/**
+ * @brief Find DTC in table
+ */
+static Std_ReturnType DiagnosticService_FindDTC(uint32 dtcNumber, uint16* index)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    uint16 bucket = DiagnosticService_HashDTC(dtcNumber);
+    uint16 probe;
+    uint16 entry;
+    
+    /* Linear probing; entries are never removed, so an empty bucket ends the chain */
+    for (probe = 0; probe < DIAG_DTC_HASH_SIZE; probe++)
+    {
+        entry = g_DTCHashTable[bucket];
+        
+        if (entry == DIAG_DTC_HASH_EMPTY)
+        {
+            break;
+        }
+        
+        if (g_DTCTable[entry - 1U].dtcNumber == dtcNumber)
+        {
+            *index = (uint16)(entry - 1U);
+            retVal = E_OK;
+            break;
+        }
+        
+        bucket = (uint16)((bucket + 1U) & (DIAG_DTC_HASH_SIZE - 1U));
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief Add DTC to table
+ */
+static Std_ReturnType DiagnosticService_AddDTC(uint32 dtcNumber, WheelPosition_t wheelPos, ABS_MalfunctionType_t type)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    uint16 bucket = DiagnosticService_HashDTC(dtcNumber);
+    uint16 i;
+    
+    if (g_StoredDTCCount < DIAG_MAX_DTC_COUNT)
+    {
+        /* Append at the next free slot */
+        i = g_StoredDTCCount;
+        g_DTCTable[i].dtcNumber = dtcNumber;
+        g_DTCTable[i].affectedWheel = wheelPos;
+        g_DTCTable[i].malfunctionType = type;
+        g_DTCTable[i].status.testFailed = 1;
+        g_DTCTable[i].status.testFailedThisOperationCycle = 1;
+        g_DTCTable[i].status.pendingDTC = 1;
+        g_DTCTable[i].occurrenceCount = 1;
+        g_DTCTable[i].firstFailureTimestamp = 0; /* Should be actual timestamp */
+        g_DTCTable[i].lastFailureTimestamp = 0;
+        g_StoredDTCCount++;
+        
+        /* Insert into hash index (load factor <= 0.5, a free bucket always exists) */
+        while (g_DTCHashTable[bucket] != DIAG_DTC_HASH_EMPTY)
+        {
+            bucket = (uint16)((bucket + 1U) & (DIAG_DTC_HASH_SIZE - 1U));
+        }
+        g_DTCHashTable[bucket] = (uint16)(i + 1U);
+        
+        DiagnosticService_UpdateStatusIndex(i);
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief Get the UDS status byte of a DTC table slot
+ */
+static uint8 DiagnosticService_GetStatusByte(uint16 index)
+{
+    return *(uint8*)&g_DTCTable[index].status;
+}
+
+/**
+ * @brief Refresh the status bit index for one DTC table slot
+ */
+static void DiagnosticService_UpdateStatusIndex(uint16 index)
+{
+    uint8 dtcStatus = DiagnosticService_GetStatusByte(index);
+    uint16 wordIdx = (uint16)(index / DIAG_DTC_INDEX_WORD_BITS);
+    uint32 slotBit = (uint32)1U << (index % DIAG_DTC_INDEX_WORD_BITS);
+    uint8 bit;
+    
+    for (bit = 0; bit < DIAG_DTC_STATUS_BITS; bit++)
+    {
+        if ((dtcStatus & (1U << bit)) != 0U)
+        {
+            g_DTCStatusIndex[bit][wordIdx] |= slotBit;
+        }
+        else
+        {
+            g_DTCStatusIndex[bit][wordIdx] &= ~slotBit;
+        }
+    }
+}
+
+/**
+ * @brief Update DTC status
+ */
+static Std_ReturnType DiagnosticService_UpdateDTCStatus(uint32 dtcNumber, boolean active)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    uint16 dtcIndex;
+    
+    if (DiagnosticService_FindDTC(dtcNumber, &dtcIndex) == E_OK)
+    {
+        if (active == TRUE)
+        {
+            g_DTCTable[dtcIndex].status.testFailed = 1;
+            g_DTCTable[dtcIndex].status.testFailedThisOperationCycle = 1;
+            g_DTCTable[dtcIndex].occurrenceCount++;
+            g_DTCTable[dtcIndex].lastFailureTimestamp = 0; /* Should be actual timestamp */
+            
+            /* Confirm DTC after multiple occurrences */
+            if (g_DTCTable[dtcIndex].occurrenceCount >= 3)
+            {
+                g_DTCTable[dtcIndex].status.confirmedDTC = 1;
+            }
+        }
+        else
+        {
+            g_DTCTable[dtcIndex].status.testFailed = 0;
+        }
+        
+        DiagnosticService_UpdateStatusIndex(dtcIndex);
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief Check that a service may run in the active session and security level
+ * @return UDS_NRC_POSITIVE_RESPONSE if the handler may be called, the NRC otherwise
+ */
+static uint8 DiagnosticService_CheckServiceAccess(uint8 serviceId)
+{
+    const UDSServiceEntry_t* entry = &g_UDSServiceTable[serviceId];
+    uint8 nrc = UDS_NRC_POSITIVE_RESPONSE;
+    
+    if (entry->handler == NULL_PTR)
+    {
+        nrc = UDS_NRC_SERVICE_NOT_SUPPORTED;
+    }
+    else if ((entry->sessionMask & DIAG_SESSION_MASK(g_CurrentSession)) == 0U)
+    {
+        nrc = UDS_NRC_SERVICE_NOT_SUPPORTED_IN_SESSION;
+    }
+    else if ((entry->securityMask != DIAG_SECURITY_NONE) && ((entry->securityMask & g_SecurityUnlockedMask) == 0U))
+    {
+        nrc = UDS_NRC_SECURITY_ACCESS_DENIED;
+    }
+    else
+    {
+        /* Access granted */
+    }
+    
+    return nrc;
+}
+
+/**
+ * @brief Get DID table entry for data identifier (binary search over the sorted ranges)
+ */
+static const DIDEntry_t* DiagnosticService_GetDIDEntry(uint16 dataId)
+{
+    const DIDEntry_t* entry = NULL_PTR;
+    uint16 low = 0;
+    uint16 high = (uint16)DID_TABLE_SIZE;
+    uint16 mid;
+    
+    while (low < high)
+    {
+        mid = (uint16)((low + high) / 2U);
+        
+        if (dataId < g_DIDTable[mid].firstDid)
+        {
+            high = mid;
+        }
+        else if (dataId > g_DIDTable[mid].lastDid)
+        {
+            low = (uint16)(mid + 1U);
+        }
+        else
+        {
+            entry = &g_DIDTable[mid];
+            break;
+        }
+    }
+    
+    return entry;
+}
+
+/**
+ * @brief Store a 16-bit value big-endian
+ */
+static void DiagnosticService_PutUint16(uint8* data, uint16 value)
+{
+    data[0] = (uint8)(value >> 8);
+    data[1] = (uint8)value;
+}
+
+/**
+ * @brief Load a big-endian 16-bit value
+ */
+static uint16 DiagnosticService_GetUint16(const uint8* data)
+{
+    return (uint16)(((uint16)data[0] << 8) | data[1]);
+}
+
+/**
+ * @brief Scale a physical value to an unsigned 16-bit raw value (saturating)
+ */
+static uint16 DiagnosticService_ScaleToUint16(float32 value, float32 scale)
+{
+    float32 raw = (value * scale) + 0.5f;
+    uint16 result;
+    
+    if (!(raw > 0.0f))
+    {
+        result = 0U;
+    }
+    else if (raw >= 65535.0f)
+    {
+        result = 0xFFFFU;
+    }
+    else
+    {
+        result = (uint16)raw;
+    }
+    
+    return result;
+}
+
+/**
+ * @brief Scale a physical value to a signed 16-bit raw value (saturating)
+ */
+static sint16 DiagnosticService_ScaleToSint16(float32 value, float32 scale)
+{
+    float32 raw = value * scale;
+    sint16 result;
+    
+    if (raw >= 32767.0f)
+    {
+        result = 32767;
+    }
+    else if (raw <= -32768.0f)
+    {
+        result = -32768;
+    }
+    else if (raw >= 0.0f)
+    {
+        result = (sint16)(raw + 0.5f);
+    }
+    else if (raw < 0.0f)
+    {
+        result = (sint16)(raw - 0.5f);
+    }
+    else
+    {
+        result = 0; /* NaN */
+    }
+    
+    return result;
+}
+
+#if defined(RUNNABLE_TIMING)
+/**
+ * @brief Saturating tick to microsecond conversion for the timing DIDs
+ */
+static uint16 DiagnosticService_TicksToUs(uint32 ticks)
+{
+    uint32 us = ticks / RUNNABLE_TIMING_TICKS_PER_US;
+    
+    return (us > 0xFFFFU) ? 0xFFFFU : (uint16)us;
+}
+#endif
+
+/**
+ * @brief Prepare error response
+ */
+static void DiagnosticService_PrepareErrorResponse(UDSMessage_t* response, uint8 serviceId, uint8 nrc)
+{
+    response->responseData[0] = 0x7F; /* Negative response */
+    response->responseData[1] = serviceId;
+    response->responseData[2] = nrc;
+    response->responseDataLength = 3;
+}
+
+/**
+ * @brief Get DTC for malfunction type and wheel position
+ */
+static uint32 DiagnosticService_GetDTCForMalfunction(ABS_MalfunctionType_t type, WheelPosition_t wheelPos)
+{
+    uint32 dtcNumber = 0;
+    
+    switch (type)
+    {
+        case ABS_MALFUNCTION_SPEED_SENSOR_MISCALIBRATION:
+            switch (wheelPos)
+            {
+                case WHEEL_FRONT_LEFT: dtcNumber = DTC_SPEED_SENSOR_FL_MISCALIBRATED; break;
+                case WHEEL_FRONT_RIGHT: dtcNumber = DTC_SPEED_SENSOR_FR_MISCALIBRATED; break;
+                case WHEEL_REAR_LEFT: dtcNumber = DTC_SPEED_SENSOR_RL_MISCALIBRATED; break;
+                case WHEEL_REAR_RIGHT: dtcNumber = DTC_SPEED_SENSOR_RR_MISCALIBRATED; break;
+                default: break;
+            }
+            break;
+            
+        case ABS_MALFUNCTION_SPEED_SENSOR_FAILURE:
+            switch (wheelPos)
+            {
+                case WHEEL_FRONT_LEFT: dtcNumber = DTC_SPEED_SENSOR_FL_FAILURE; break;
+                case WHEEL_FRONT_RIGHT: dtcNumber = DTC_SPEED_SENSOR_FR_FAILURE; break;
+                case WHEEL_REAR_LEFT: dtcNumber = DTC_SPEED_SENSOR_RL_FAILURE; break;
+                case WHEEL_REAR_RIGHT: dtcNumber = DTC_SPEED_SENSOR_RR_FAILURE; break;
+                default: break;
+            }
+            break;
+            
+        case ABS_MALFUNCTION_SPEED_DIFFERENCE_EXCESSIVE:
+            dtcNumber = DTC_SPEED_PLAUSIBILITY_ERROR;
+            break;
+            
+        default:
+            dtcNumber = DTC_ABS_SYSTEM_MALFUNCTION;
+            break;
+    }
+    
+    return dtcNumber;
+}
+
+/**
+ * @brief Start a paged 0x19 report (0x02 reportDTCByStatusMask / 0x0A reportSupportedDTC)
+ *
+ * The set of reported slots is captured up front so the length announced in
+ * the first frame stays valid; records are serialized as frames are sent.
+ */
+static Std_ReturnType DiagnosticService_StartDTCPager(const UDSMessage_t* request, IsoTp_TxStream_t* stream)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    DiagDTCPager_t* pager = &g_DTCPager;
+    uint16 recordCount = 0;
+    uint16 maxRecords;
+    uint16 wordIdx;
+    uint32 word;
+    uint8 bit;
+    
+    if ((request->serviceId == UDS_SID_READ_DTC_INFORMATION) && (request->requestDataLength >= 1))
+    {
+        memset(pager, 0, sizeof(DiagDTCPager_t));
+        pager->header[0] = UDS_SID_READ_DTC_INFORMATION + 0x40;
+        pager->header[1] = request->requestData[0];
+        
+        if ((request->requestData[0] == 0x02) && (request->requestDataLength >= 2))
+        {
+            pager->header[2] = request->requestData[1]; /* Status availability mask */
+            pager->headerLength = 3;
+            pager->recordSize = 4;
+            
+            for (wordIdx = 0; wordIdx < DIAG_DTC_INDEX_WORDS; wordIdx++)
+            {
+                for (bit = 0; bit < DIAG_DTC_STATUS_BITS; bit++)
+                {
+                    if ((request->requestData[1] & (1U << bit)) != 0U)
+                    {
+                        pager->selection[wordIdx] |= g_DTCStatusIndex[bit][wordIdx];
+                    }
+                }
+            }
+            retVal = E_OK;
+        }
+        else if (request->requestData[0] == 0x0A)
+        {
+            pager->headerLength = 2;
+            pager->recordSize = 3;
+            
+            for (wordIdx = 0; wordIdx < g_StoredDTCCount; wordIdx++)
+            {
+                pager->selection[wordIdx / DIAG_DTC_INDEX_WORD_BITS] |= (uint32)1U << (wordIdx % DIAG_DTC_INDEX_WORD_BITS);
+            }
+            retVal = E_OK;
+        }
+        else
+        {
+            /* Other subfunctions and errors use the regular handler */
+        }
+    }
+    
+    if (retVal == E_OK)
+    {
+        for (wordIdx = 0; wordIdx < DIAG_DTC_INDEX_WORDS; wordIdx++)
+        {
+            for (word = pager->selection[wordIdx]; word != 0U; word &= (word - 1U))
+            {
+                recordCount++;
+            }
+        }
+        
+        maxRecords = (uint16)((ISOTP_MAX_MESSAGE_LENGTH - pager->headerLength) / pager->recordSize);
+        pager->recordsRemaining = (recordCount < maxRecords) ? recordCount : maxRecords;
+        pager->recordPos = pager->recordSize; /* No record loaded yet */
+        
+        stream->fill = DiagnosticService_DTCPagerFill;
+        stream->totalLength = (uint16)(pager->headerLength + (pager->recordsRemaining * pager->recordSize));
+        stream->position = 0;
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief Serialize the next bytes of the paged DTC report into a transport frame
+ */
+static uint16 DiagnosticService_DTCPagerFill(IsoTp_TxStream_t* stream, uint8* dest, uint16 maxLength)
+{
+    DiagDTCPager_t* pager = &g_DTCPager;
+    uint16 written = 0;
+    uint16 slot;
+    uint32 word;
+    
+    (void)stream;
+    
+    while (written < maxLength)
+    {
+        if (pager->headerPos < pager->headerLength)
+        {
+            dest[written++] = pager->header[pager->headerPos++];
+        }
+        else if (pager->recordPos < pager->recordSize)
+        {
+            dest[written++] = pager->record[pager->recordPos++];
+        }
+        else if (pager->recordsRemaining > 0U)
+        {
+            /* Find the next selected slot, skipping empty index words */
+            slot = pager->nextSlot;
+            while (slot < DIAG_MAX_DTC_COUNT)
+            {
+                word = pager->selection[slot / DIAG_DTC_INDEX_WORD_BITS] >> (slot % DIAG_DTC_INDEX_WORD_BITS);
+                if (word == 0U)
+                {
+                    slot = (uint16)((slot / DIAG_DTC_INDEX_WORD_BITS + 1U) * DIAG_DTC_INDEX_WORD_BITS);
+                }
+                else if ((word & 1U) != 0U)
+                {
+                    break;
+                }
+                else
+                {
+                    slot++;
+                }
+            }
+            
+            if (slot >= DIAG_MAX_DTC_COUNT)
+            {
+                break; /* Selection exhausted */
+            }
+            
+            pager->record[0] = (uint8)(g_DTCTable[slot].dtcNumber >> 16);
+            pager->record[1] = (uint8)(g_DTCTable[slot].dtcNumber >> 8);
+            pager->record[2] = (uint8)(g_DTCTable[slot].dtcNumber);
+            pager->record[3] = DiagnosticService_GetStatusByte(slot);
+            pager->recordPos = 0;
+            pager->recordsRemaining--;
+            pager->nextSlot = (uint16)(slot + 1U);
+        }
+        else
+        {
+            break;
+        }
+    }
+    
+    return written;
+}
+
+/**
+ * @brief Monitor ABS malfunctions and update DTCs
+ *
+ * Consumes only the wheels whose confirmed malfunction status changed since the
+ * last call; cycles without changes cost one read of the ABS change sequences.
+ */
+static void DiagnosticService_MonitorMalfunctions(void)
+{
+    ABS_MalfunctionStatus_t malfunctionStatus;
+    uint8 changedMask = 0U;
+    uint8 wheelIdx;
+    uint8 otherIdx;
+    uint32 previousDtc;
+    uint32 dtcNumber;
+    boolean sharedDtc;
+    
+    if ((ABS_GetMalfunctionStatusChanges(g_SeenStatusChange, &changedMask) == E_OK) && (changedMask != 0U))
+    {
+        for (wheelIdx = 0; wheelIdx < WHEEL_MAX; wheelIdx++)
+        {
+            if (((changedMask & (1U << wheelIdx)) != 0U) &&
+                (ABS_GetMalfunctionStatus((WheelPosition_t)wheelIdx, &malfunctionStatus) == E_OK))
+            {
+                dtcNumber = 0;
+                if (malfunctionStatus.confirmedMalfunction == TRUE)
+                {
+                    dtcNumber = DiagnosticService_GetDTCForMalfunction(malfunctionStatus.malfunctionType,
+                                                                       malfunctionStatus.affectedWheel);
+                }
+                
+                previousDtc = g_WheelActiveDTC[wheelIdx];
+                g_WheelActiveDTC[wheelIdx] = dtcNumber;
+                
+                if (previousDtc != dtcNumber)
+                {
+                    /* Passivate the previous DTC unless another wheel still reports it */
+                    if (previousDtc != 0)
+                    {
+                        sharedDtc = FALSE;
+                        for (otherIdx = 0; otherIdx < WHEEL_MAX; otherIdx++)
+                        {
+                            if (g_WheelActiveDTC[otherIdx] == previousDtc)
+                            {
+                                sharedDtc = TRUE;
+                            }
+                        }
+                        
+                        if (sharedDtc == FALSE)
+                        {
+                            DiagnosticService_SetDTC(previousDtc, FALSE, malfunctionStatus.affectedWheel);
+                        }
+                    }
+                    
+                    if (dtcNumber != 0)
+                    {
+                        DiagnosticService_SetDTC(dtcNumber, TRUE, malfunctionStatus.affectedWheel);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* RTE Runnable Functions */
+
+/**
+ * @brief RTE Runnable for main diagnostic processing
+ */
+void RE_DiagnosticService_MainCyclic(void)
+{
+    DiagnosticService_MainFunction();
 }
 
 /**
@@ -863,16 +1800,21 @@ void RE_DiagnosticService_UDSProcessing(void)
 {
     UDSMessage_t request, response;
     
+    RUNNABLE_TIMING_START(RUNNABLE_DIAG_UDS_PROCESSING);
+    
     /* Read UDS request from RTE */
     if (Rte_Read_UDSRequest_message(&request) == E_OK)
     {
         /* Process UDS request */
-        if (DiagnosticService_ProcessUDSRequest(&request, &response) == E_OK)
+        if ((DiagnosticService_ProcessUDSRequest(&request, &response) == E_OK) &&
+            (response.responseDataLength > 0U))
         {
-            /* Send UDS response via RTE */
+            /* Send UDS response via RTE (nothing to send if suppressed) */
             Rte_Write_UDSResponse_message(&response);
         }
     }
+    
+    RUNNABLE_TIMING_STOP(RUNNABLE_DIAG_UDS_PROCESSING);
 }
 
 /**
@@ -880,5 +1822,9 @@ void RE_DiagnosticService_UDSProcessing(void)
  */
 void RE_DiagnosticService_DTCManager(void)
 {
-    /* DTC management handled in main function */
+    /* Consume ABS malfunction status changes (no-op when nothing changed) */
+    if (g_DiagnosticService_Initialized == TRUE)
+    {
+        DiagnosticService_MonitorMalfunctions();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,531 @@
+/**
+ * @file IsoTp.c
+ * @brief ISO-TP (ISO 15765-2) Transport Layer Implementation
+ * @author Generated for ABS Malfunction Detection System
+ *
+ * Single physical channel, server side. Received CAN frames are queued in a
+ * ring by the CAN driver and processed in IsoTp_MainFunction. Single-frame
+ * requests are dispatched in place from their ring slot; multi-frame requests
+ * are reassembled once from the ring into the request buffer. Responses are
+ * pulled from an IsoTp_TxStream_t source frame by frame, so each SF/FF/CF
+ * payload is written by the service directly into the outgoing frame.
+ */
+
+#include "IsoTp.h"
+#include "DiagnosticService.h"
+#include <string.h>
+
+#if (ISOTP_RX_RING_FRAMES & (ISOTP_RX_RING_FRAMES - 1U)) != 0U
+#error "ISOTP_RX_RING_FRAMES must be a power of two"
+#endif
+
+/* Reception / transmission states */
+typedef enum {
+    ISOTP_RX_IDLE = 0,
+    ISOTP_RX_RECEIVING = 1
+} IsoTp_RxState_t;
+
+typedef enum {
+    ISOTP_TX_IDLE = 0,
+    ISOTP_TX_WAIT_FC = 1,
+    ISOTP_TX_SENDING = 2
+} IsoTp_TxState_t;
+
+/* Received CAN frame */
+typedef struct {
+    uint8 data[ISOTP_FRAME_LENGTH];
+    uint8 length;
+} IsoTp_RxFrame_t;
+
+/* Local data structures */
+static IsoTp_RxFrame_t g_RxRing[ISOTP_RX_RING_FRAMES];
+static volatile uint16 g_RxHead = 0;   /* Written by RxIndication only */
+static volatile uint16 g_RxTail = 0;   /* Written by MainFunction only */
+
+static uint8 g_RxBuffer[ISOTP_RX_BUFFER_LENGTH];
+static IsoTp_RxState_t g_RxState = ISOTP_RX_IDLE;
+static uint16 g_RxExpectedLength = 0;
+static uint16 g_RxReceivedLength = 0;
+static uint8 g_RxSequenceNumber = 0;
+static uint8 g_RxBlockCounter = 0;
+static uint16 g_RxTimer = 0;
+
+static IsoTp_TxStream_t g_TxStream;
+static IsoTp_TxState_t g_TxState = ISOTP_TX_IDLE;
+static uint8 g_TxFrame[ISOTP_FRAME_LENGTH];
+static boolean g_TxFramePending = FALSE;
+static uint8 g_TxSequenceNumber = 0;
+static uint8 g_TxBlockSize = 0;
+static uint8 g_TxBlockCounter = 0;
+static uint16 g_TxStMinMs = 0;
+static uint16 g_TxStMinTimer = 0;
+static uint16 g_TxTimer = 0;
+
+static uint8 g_FcFrame[ISOTP_FRAME_LENGTH];
+static boolean g_FcPending = FALSE;
+
+static IsoTp_Statistics_t g_Statistics;
+static boolean g_IsoTp_Initialized = FALSE;
+
+/* Internal function prototypes */
+static void IsoTp_UpdateTimers(void);
+static void IsoTp_ProcessRxFrame(const IsoTp_RxFrame_t* frame);
+static void IsoTp_ProcessFlowControl(const IsoTp_RxFrame_t* frame);
+static void IsoTp_QueueFlowControl(uint8 flowStatus);
+static void IsoTp_Dispatch(const uint8* payload, uint16 length);
+static void IsoTp_StartTransmission(void);
+static void IsoTp_ProcessTransmission(void);
+static boolean IsoTp_FillFrame(uint8* dest, uint16 length);
+static uint16 IsoTp_DecodeStMin(uint8 stMin);
+
+/**
+ * @brief Initialize ISO-TP transport
+ */
+Std_ReturnType IsoTp_Init(void)
+{
+    memset(g_RxRing, 0, sizeof(g_RxRing));
+    g_RxHead = 0;
+    g_RxTail = 0;
+    g_RxState = ISOTP_RX_IDLE;
+    g_RxExpectedLength = 0;
+    g_RxReceivedLength = 0;
+    
+    memset(&g_TxStream, 0, sizeof(g_TxStream));
+    g_TxState = ISOTP_TX_IDLE;
+    g_TxFramePending = FALSE;
+    g_FcPending = FALSE;
+    
+    memset(&g_Statistics, 0, sizeof(g_Statistics));
+    g_IsoTp_Initialized = TRUE;
+    
+    return E_OK;
+}
+
+/**
+ * @brief CAN receive indication (called from CAN driver, may run in ISR context)
+ */
+void IsoTp_RxIndication(const uint8* data, uint8 length)
+{
+    IsoTp_RxFrame_t* slot;
+    
+    if ((g_IsoTp_Initialized == TRUE) && (data != NULL_PTR) && (length > 0U) && (length <= ISOTP_FRAME_LENGTH))
+    {
+        if ((uint16)(g_RxHead - g_RxTail) >= ISOTP_RX_RING_FRAMES)
+        {
+            g_Statistics.rxFramesDropped++;
+        }
+        else
+        {
+            slot = &g_RxRing[g_RxHead & (ISOTP_RX_RING_FRAMES - 1U)];
+            memcpy(slot->data, data, length);
+            slot->length = length;
+            
+            /* Publish the frame after its contents are written */
+            g_RxHead = (uint16)(g_RxHead + 1U);
+        }
+    }
+}
+
+/**
+ * @brief Cyclic processing: reassemble requests, dispatch them and stream responses
+ */
+void IsoTp_MainFunction(void)
+{
+    if (g_IsoTp_Initialized == TRUE)
+    {
+        IsoTp_UpdateTimers();
+        
+        /* Retry a flow control frame the driver could not take last cycle */
+        if ((g_FcPending == TRUE) && (IsoTp_CanTransmit(g_FcFrame) == E_OK))
+        {
+            g_FcPending = FALSE;
+        }
+        
+        /* Consume received frames; the slot is released only after processing */
+        while (g_RxTail != g_RxHead)
+        {
+            IsoTp_ProcessRxFrame(&g_RxRing[g_RxTail & (ISOTP_RX_RING_FRAMES - 1U)]);
+            g_RxTail = (uint16)(g_RxTail + 1U);
+        }
+        
+        IsoTp_ProcessTransmission();
+    }
+}
+
+/**
+ * @brief Check whether a reception or transmission is in progress
+ */
+boolean IsoTp_IsBusy(void)
+{
+    return ((g_RxState != ISOTP_RX_IDLE) || (g_TxState != ISOTP_TX_IDLE)) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Get transport statistics
+ */
+Std_ReturnType IsoTp_GetStatistics(IsoTp_Statistics_t* statistics)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    
+    if (statistics != NULL_PTR)
+    {
+        *statistics = g_Statistics;
+        retVal = E_OK;
+    }
+    
+    return retVal;
+}
+
+/**
+ * @brief Stream source for a pre-serialized response held in stream->flatData
+ */
+uint16 IsoTp_FlatStreamFill(IsoTp_TxStream_t* stream, uint8* dest, uint16 maxLength)
+{
+    uint16 length = (uint16)(stream->totalLength - stream->position);
+    
+    if (length > maxLength)
+    {
+        length = maxLength;
+    }
+    
+    memcpy(dest, &stream->flatData[stream->position], length);
+    
+    return length;
+}
+
+/* Internal Functions */
+
+/**
+ * @brief Advance STmin and N_Bs / N_Cr timers
+ */
+static void IsoTp_UpdateTimers(void)
+{
+    g_TxStMinTimer = (g_TxStMinTimer > ISOTP_MAIN_CYCLE_MS) ? (uint16)(g_TxStMinTimer - ISOTP_MAIN_CYCLE_MS) : 0U;
+    
+    if (g_RxState == ISOTP_RX_RECEIVING)
+    {
+        g_RxTimer += ISOTP_MAIN_CYCLE_MS;
+        if (g_RxTimer >= ISOTP_N_CR_TIMEOUT_MS)
+        {
+            g_RxState = ISOTP_RX_IDLE;
+            g_Statistics.rxAborted++;
+        }
+    }
+    
+    if ((g_TxState == ISOTP_TX_WAIT_FC) && (g_TxFramePending == FALSE))
+    {
+        g_TxTimer += ISOTP_MAIN_CYCLE_MS;
+        if (g_TxTimer >= ISOTP_N_BS_TIMEOUT_MS)
+        {
+            g_TxState = ISOTP_TX_IDLE;
+            g_Statistics.txAborted++;
+        }
+    }
+}
+
+/**
+ * @brief Process one received CAN frame
+ */
+static void IsoTp_ProcessRxFrame(const IsoTp_RxFrame_t* frame)
+{
+    const uint8 pci = (uint8)(frame->data[0] & 0xF0U);
+    uint16 length;
+    
+    switch (pci)
+    {
+        case ISOTP_PCI_SINGLE_FRAME:
+            length = (uint16)(frame->data[0] & 0x0FU);
+            if ((length > 0U) && (length < frame->length) && (g_TxState == ISOTP_TX_IDLE))
+            {
+                /* A new request terminates any reception in progress */
+                g_RxState = ISOTP_RX_IDLE;
+                IsoTp_Dispatch(&frame->data[1], length);
+            }
+            break;
+        
+        case ISOTP_PCI_FIRST_FRAME:
+            length = (uint16)(((uint16)(frame->data[0] & 0x0FU) << 8) | frame->data[1]);
+            if ((frame->length == ISOTP_FRAME_LENGTH) && (length > ISOTP_SF_MAX_PAYLOAD) &&
+                (g_TxState == ISOTP_TX_IDLE))
+            {
+                if (length > ISOTP_RX_BUFFER_LENGTH)
+                {
+                    g_RxState = ISOTP_RX_IDLE;
+                    IsoTp_QueueFlowControl(ISOTP_FC_OVERFLOW);
+                }
+                else
+                {
+                    memcpy(g_RxBuffer, &frame->data[2], ISOTP_FF_PAYLOAD);
+                    g_RxExpectedLength = length;
+                    g_RxReceivedLength = ISOTP_FF_PAYLOAD;
+                    g_RxSequenceNumber = 1U;
+                    g_RxBlockCounter = 0U;
+                    g_RxTimer = 0U;
+                    g_RxState = ISOTP_RX_RECEIVING;
+                    IsoTp_QueueFlowControl(ISOTP_FC_CONTINUE_TO_SEND);
+                }
+            }
+            break;
+        
+        case ISOTP_PCI_CONSECUTIVE_FRAME:
+            if (g_RxState == ISOTP_RX_RECEIVING)
+            {
+                if ((frame->data[0] & 0x0FU) != g_RxSequenceNumber)
+                {
+                    /* Wrong sequence number: abort reception */
+                    g_RxState = ISOTP_RX_IDLE;
+                    g_Statistics.rxAborted++;
+                }
+                else
+                {
+                    length = (uint16)(g_RxExpectedLength - g_RxReceivedLength);
+                    if (length > ISOTP_CF_PAYLOAD)
+                    {
+                        length = ISOTP_CF_PAYLOAD;
+                    }
+                    if (length > (uint16)(frame->length - 1U))
+                    {
+                        length = (uint16)(frame->length - 1U);
+                    }
+                    
+                    memcpy(&g_RxBuffer[g_RxReceivedLength], &frame->data[1], length);
+                    g_RxReceivedLength = (uint16)(g_RxReceivedLength + length);
+                    g_RxSequenceNumber = (uint8)((g_RxSequenceNumber + 1U) & 0x0FU);
+                    g_RxTimer = 0U;
+                    
+                    if (g_RxReceivedLength >= g_RxExpectedLength)
+                    {
+                        g_RxState = ISOTP_RX_IDLE;
+                        IsoTp_Dispatch(g_RxBuffer, g_RxExpectedLength);
+                    }
+#if ISOTP_RX_BLOCK_SIZE > 0U
+                    else
+                    {
+                        /* Block complete: let the tester continue */
+                        g_RxBlockCounter++;
+                        if (g_RxBlockCounter == ISOTP_RX_BLOCK_SIZE)
+                        {
+                            g_RxBlockCounter = 0U;
+                            IsoTp_QueueFlowControl(ISOTP_FC_CONTINUE_TO_SEND);
+                        }
+                    }
+#endif
+                }
+            }
+            break;
+        
+        case ISOTP_PCI_FLOW_CONTROL:
+            IsoTp_ProcessFlowControl(frame);
+            break;
+        
+        default:
+            /* Unknown PCI: ignore frame */
+            break;
+    }
+}
+
+/**
+ * @brief Process flow control frame from the tester
+ */
+static void IsoTp_ProcessFlowControl(const IsoTp_RxFrame_t* frame)
+{
+    if ((g_TxState == ISOTP_TX_WAIT_FC) && (frame->length >= 3U))
+    {
+        switch (frame->data[0] & 0x0FU)
+        {
+            case ISOTP_FC_CONTINUE_TO_SEND:
+                g_TxBlockSize = frame->data[1];
+                g_TxBlockCounter = 0U;
+                g_TxStMinMs = IsoTp_DecodeStMin(frame->data[2]);
+                g_TxStMinTimer = 0U;
+                g_TxState = ISOTP_TX_SENDING;
+                break;
+            
+            case ISOTP_FC_WAIT:
+                g_TxTimer = 0U;
+                break;
+            
+            default:
+                /* Overflow or invalid flow status: abort transmission */
+                g_TxState = ISOTP_TX_IDLE;
+                g_TxFramePending = FALSE;
+                g_Statistics.txAborted++;
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Send (or queue for retry) a flow control frame
+ */
+static void IsoTp_QueueFlowControl(uint8 flowStatus)
+{
+    memset(g_FcFrame, ISOTP_PADDING_BYTE, ISOTP_FRAME_LENGTH);
+    g_FcFrame[0] = (uint8)(ISOTP_PCI_FLOW_CONTROL | flowStatus);
+    g_FcFrame[1] = ISOTP_RX_BLOCK_SIZE;
+    g_FcFrame[2] = ISOTP_RX_ST_MIN;
+    
+    g_FcPending = (IsoTp_CanTransmit(g_FcFrame) == E_OK) ? FALSE : TRUE;
+}
+
+/**
+ * @brief Hand a complete request to the diagnostic service and start the response
+ */
+static void IsoTp_Dispatch(const uint8* payload, uint16 length)
+{
+    UDSMessage_t request;
+    
+    memset(&request, 0, sizeof(request));
+    request.serviceId = payload[0];
+    request.requestData = (uint8*)&payload[1];   /* Read-only view into ring slot / buffer */
+    request.requestDataLength = (uint16)(length - 1U);
+    
+    memset(&g_TxStream, 0, sizeof(g_TxStream));
+    
+    if ((DiagnosticService_ProcessUDSStream(&request, &g_TxStream) == E_OK) &&
+        (g_TxStream.fill != NULL_PTR) && (g_TxStream.totalLength > 0U) &&
+        (g_TxStream.totalLength <= ISOTP_MAX_MESSAGE_LENGTH))
+    {
+        IsoTp_StartTransmission();
+    }
+}
+
+/**
+ * @brief Build the single frame or first frame of the response
+ */
+static void IsoTp_StartTransmission(void)
+{
+    const uint16 totalLength = g_TxStream.totalLength;
+    boolean filled;
+    
+    if (totalLength <= ISOTP_SF_MAX_PAYLOAD)
+    {
+        g_TxFrame[0] = (uint8)(ISOTP_PCI_SINGLE_FRAME | totalLength);
+        filled = IsoTp_FillFrame(&g_TxFrame[1], totalLength);
+        g_TxState = ISOTP_TX_SENDING;
+    }
+    else
+    {
+        g_TxFrame[0] = (uint8)(ISOTP_PCI_FIRST_FRAME | (uint8)(totalLength >> 8));
+        g_TxFrame[1] = (uint8)(totalLength & 0xFFU);
+        filled = IsoTp_FillFrame(&g_TxFrame[2], ISOTP_FF_PAYLOAD);
+        g_TxSequenceNumber = 1U;
+        g_TxTimer = 0U;
+        g_TxState = ISOTP_TX_WAIT_FC;
+    }
+    
+    g_TxFramePending = filled;
+    if (filled == FALSE)
+    {
+        g_TxState = ISOTP_TX_IDLE;
+        g_Statistics.txAborted++;
+    }
+}
+
+/**
+ * @brief Transmit pending frames and produce consecutive frames as flow control allows
+ */
+static void IsoTp_ProcessTransmission(void)
+{
+    uint8 framesSent = 0U;
+    uint16 length;
+    
+    while (framesSent < ISOTP_MAX_FRAMES_PER_CYCLE)
+    {
+        if (g_TxFramePending == TRUE)
+        {
+            if (IsoTp_CanTransmit(g_TxFrame) != E_OK)
+            {
+                break; /* Driver busy, retry next cycle */
+            }
+            
+            g_TxFramePending = FALSE;
+            framesSent++;
+            
+            if (g_TxStream.position >= g_TxStream.totalLength)
+            {
+                g_TxState = ISOTP_TX_IDLE;
+                g_Statistics.responsesSent++;
+                break;
+            }
+        }
+        
+        if ((g_TxState != ISOTP_TX_SENDING) || (g_TxStMinTimer > 0U))
+        {
+            break;
+        }
+        
+        /* Produce the next consecutive frame directly from the response source */
+        length = (uint16)(g_TxStream.totalLength - g_TxStream.position);
+        if (length > ISOTP_CF_PAYLOAD)
+        {
+            length = ISOTP_CF_PAYLOAD;
+        }
+        
+        g_TxFrame[0] = (uint8)(ISOTP_PCI_CONSECUTIVE_FRAME | g_TxSequenceNumber);
+        if (IsoTp_FillFrame(&g_TxFrame[1], length) == FALSE)
+        {
+            g_TxState = ISOTP_TX_IDLE;
+            g_Statistics.txAborted++;
+            break;
+        }
+        
+        g_TxFramePending = TRUE;
+        g_TxSequenceNumber = (uint8)((g_TxSequenceNumber + 1U) & 0x0FU);
+        g_TxStMinTimer = g_TxStMinMs;
+        
+        if (g_TxBlockSize > 0U)
+        {
+            g_TxBlockCounter++;
+            if ((g_TxBlockCounter >= g_TxBlockSize) && (g_TxStream.position < g_TxStream.totalLength))
+            {
+                /* Block complete: wait for the next flow control after this frame */
+                g_TxTimer = 0U;
+                g_TxState = ISOTP_TX_WAIT_FC;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Pull length bytes from the response source into a frame and pad the rest
+ */
+static boolean IsoTp_FillFrame(uint8* dest, uint16 length)
+{
+    uint16 written = g_TxStream.fill(&g_TxStream, dest, length);
+    uint8* frameEnd = &g_TxFrame[ISOTP_FRAME_LENGTH];
+    
+    g_TxStream.position = (uint16)(g_TxStream.position + written);
+    
+    /* Pad unused bytes of the frame */
+    if (&dest[written] < frameEnd)
+    {
+        memset(&dest[written], ISOTP_PADDING_BYTE, (size_t)(frameEnd - &dest[written]));
+    }
+    
+    return (written == length) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Convert STmin byte to milliseconds (sub-millisecond values round down to 0)
+ */
+static uint16 IsoTp_DecodeStMin(uint8 stMin)
+{
+    uint16 stMinMs;
+    
+    if (stMin <= 0x7FU)
+    {
+        stMinMs = stMin;
+    }
+    else if ((stMin >= 0xF1U) && (stMin <= 0xF9U))
+    {
+        stMinMs = 0U;
+    }
+    else
+    {
+        /* Reserved values are interpreted as the maximum STmin */
+        stMinMs = 0x7FU;
+    }
+    
+    return stMinMs;
+}
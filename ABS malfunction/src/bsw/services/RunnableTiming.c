@@ -0,0 +1,218 @@
+/**
+ * @file RunnableTiming.c
+ * @brief Execution time and activation jitter measurement for the RTE runnables
+ * @author Generated for ABS Malfunction Detection System
+ *
+ * Each hook reads the time base once and updates a few counters of the
+ * runnable; averages and the conversion to microseconds are left to the reader.
+ * Tick differences are taken modulo 2^32, so single activations and periods
+ * must stay below 2^32 ticks (4.29 s on the host).
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L     /* clock_gettime on the host */
+#endif
+
+#include "RunnableTiming.h"
+#include <string.h>
+
+#if RUNNABLE_TIMING_CYCLE_COUNTER
+/* Cortex-M debug registers */
+#define RUNNABLE_TIMING_DEMCR           (*(volatile uint32*)0xE000EDFCUL)
+#define RUNNABLE_TIMING_DEMCR_TRCENA    0x01000000UL
+#define RUNNABLE_TIMING_DWT_CTRL        (*(volatile uint32*)0xE0001000UL)
+#define RUNNABLE_TIMING_DWT_CYCCNTENA   0x00000001UL
+#define RUNNABLE_TIMING_DWT_CYCCNT      (*(volatile uint32*)0xE0001004UL)
+#else
+#include <time.h>
+#endif
+
+#define RUNNABLE_TIMING_BIN_EDGES       (RUNNABLE_TIMING_HISTOGRAM_BINS - 1U)
+
+/* Running statistics of one runnable */
+typedef struct {
+    uint32 startTicks;          /* Start of the current or last activation */
+    uint32 activations;
+    uint32 execMinTicks;
+    uint32 execMaxTicks;
+    uint64 execSumTicks;
+    uint32 jitterSamples;
+    uint32 jitterMinTicks;
+    uint32 jitterMaxTicks;
+    uint64 jitterSumTicks;
+    uint32 execHistogram[RUNNABLE_TIMING_HISTOGRAM_BINS];
+    uint32 jitterHistogram[RUNNABLE_TIMING_HISTOGRAM_BINS];
+} RunnableTiming_Record_t;
+
+static const uint16 g_RunnablePeriodMs[RUNNABLE_MAX] = {
+    RUNNABLE_SPEED_SENSOR_MAIN_PERIOD_MS,
+    RUNNABLE_ABS_DETECTION_MAIN_PERIOD_MS,
+    RUNNABLE_CALIBRATION_MAIN_PERIOD_MS,
+    RUNNABLE_DIAG_UDS_PROCESSING_PERIOD_MS
+};
+
+static RunnableTiming_Record_t g_RunnableRecord[RUNNABLE_MAX];
+static uint32 g_RunnablePeriodTicks[RUNNABLE_MAX];
+static uint32 g_RunnableBinEdgeTicks[RUNNABLE_MAX][RUNNABLE_TIMING_BIN_EDGES];
+
+/**
+ * @brief Read the time base
+ */
+static uint32 RunnableTiming_Now(void)
+{
+#if RUNNABLE_TIMING_CYCLE_COUNTER
+    return RUNNABLE_TIMING_DWT_CYCCNT;
+#else
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32)(((uint64)ts.tv_sec * 1000000000ULL) + (uint64)ts.tv_nsec);
+#endif
+}
+
+/**
+ * @brief Histogram bin of a duration
+ */
+static uint8 RunnableTiming_GetBin(RunnableId_t runnable, uint32 ticks)
+{
+    uint8 bin = 0;
+
+    while ((bin < RUNNABLE_TIMING_BIN_EDGES) && (ticks >= g_RunnableBinEdgeTicks[runnable][bin]))
+    {
+        bin++;
+    }
+
+    return bin;
+}
+
+/**
+ * @brief Start the time base and clear all statistics
+ */
+void RunnableTiming_Init(void)
+{
+    static const uint16 binEdgesPermille[RUNNABLE_TIMING_BIN_EDGES] = RUNNABLE_TIMING_BIN_EDGES_PERMILLE;
+    uint8 runnable;
+    uint8 bin;
+
+#if RUNNABLE_TIMING_CYCLE_COUNTER
+    RUNNABLE_TIMING_DEMCR |= RUNNABLE_TIMING_DEMCR_TRCENA;
+    RUNNABLE_TIMING_DWT_CYCCNT = 0U;
+    RUNNABLE_TIMING_DWT_CTRL |= RUNNABLE_TIMING_DWT_CYCCNTENA;
+#endif
+
+    memset(g_RunnableRecord, 0, sizeof(g_RunnableRecord));
+
+    for (runnable = 0; runnable < (uint8)RUNNABLE_MAX; runnable++)
+    {
+        /* Period in ticks is a multiple of 1000, so the bin edges are exact */
+        g_RunnablePeriodTicks[runnable] = (uint32)g_RunnablePeriodMs[runnable] * 1000U * RUNNABLE_TIMING_TICKS_PER_US;
+        for (bin = 0; bin < RUNNABLE_TIMING_BIN_EDGES; bin++)
+        {
+            g_RunnableBinEdgeTicks[runnable][bin] =
+                (uint32)g_RunnablePeriodMs[runnable] * RUNNABLE_TIMING_TICKS_PER_US * binEdgesPermille[bin];
+        }
+        g_RunnableRecord[runnable].execMinTicks = 0xFFFFFFFFUL;
+        g_RunnableRecord[runnable].jitterMinTicks = 0xFFFFFFFFUL;
+    }
+}
+
+/**
+ * @brief Mark the start of a runnable activation
+ */
+void RunnableTiming_Start(RunnableId_t runnable)
+{
+    RunnableTiming_Record_t* record;
+    uint32 now = RunnableTiming_Now();
+    uint32 period;
+    uint32 jitter;
+
+    if (runnable < RUNNABLE_MAX)
+    {
+        record = &g_RunnableRecord[runnable];
+
+        if (record->activations > 0U)
+        {
+            period = now - record->startTicks;
+            jitter = (period >= g_RunnablePeriodTicks[runnable]) ? (period - g_RunnablePeriodTicks[runnable])
+                                                                  : (g_RunnablePeriodTicks[runnable] - period);
+
+            record->jitterSamples++;
+            record->jitterSumTicks += jitter;
+            if (jitter < record->jitterMinTicks)
+            {
+                record->jitterMinTicks = jitter;
+            }
+            if (jitter > record->jitterMaxTicks)
+            {
+                record->jitterMaxTicks = jitter;
+            }
+            record->jitterHistogram[RunnableTiming_GetBin(runnable, jitter)]++;
+        }
+
+        record->startTicks = now;
+    }
+}
+
+/**
+ * @brief Mark the end of the activation started last for this runnable
+ */
+void RunnableTiming_Stop(RunnableId_t runnable)
+{
+    RunnableTiming_Record_t* record;
+    uint32 now = RunnableTiming_Now();
+    uint32 exec;
+
+    if (runnable < RUNNABLE_MAX)
+    {
+        record = &g_RunnableRecord[runnable];
+        exec = now - record->startTicks;
+
+        record->activations++;
+        record->execSumTicks += exec;
+        if (exec < record->execMinTicks)
+        {
+            record->execMinTicks = exec;
+        }
+        if (exec > record->execMaxTicks)
+        {
+            record->execMaxTicks = exec;
+        }
+        record->execHistogram[RunnableTiming_GetBin(runnable, exec)]++;
+    }
+}
+
+/**
+ * @brief Copy the statistics of a runnable
+ */
+Std_ReturnType RunnableTiming_GetSummary(RunnableId_t runnable, RunnableTiming_Summary_t* summary)
+{
+    Std_ReturnType retVal = E_NOT_OK;
+    const RunnableTiming_Record_t* record;
+
+    if ((runnable < RUNNABLE_MAX) && (summary != NULL_PTR))
+    {
+        record = &g_RunnableRecord[runnable];
+        memset(summary, 0, sizeof(*summary));
+
+        summary->activations = record->activations;
+        if (record->activations > 0U)
+        {
+            summary->execMinTicks = record->execMinTicks;
+            summary->execAvgTicks = (uint32)(record->execSumTicks / record->activations);
+            summary->execMaxTicks = record->execMaxTicks;
+        }
+
+        summary->jitterSamples = record->jitterSamples;
+        if (record->jitterSamples > 0U)
+        {
+            summary->jitterMinTicks = record->jitterMinTicks;
+            summary->jitterAvgTicks = (uint32)(record->jitterSumTicks / record->jitterSamples);
+            summary->jitterMaxTicks = record->jitterMaxTicks;
+        }
+
+        memcpy(summary->execHistogram, record->execHistogram, sizeof(summary->execHistogram));
+        memcpy(summary->jitterHistogram, record->jitterHistogram, sizeof(summary->jitterHistogram));
+        retVal = E_OK;
+    }
+
+    return retVal;
+}
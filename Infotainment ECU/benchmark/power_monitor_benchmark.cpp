@@ -0,0 +1,181 @@
+/**
+ * @file power_monitor_benchmark.cpp
+ * @brief Insert and report cost of the power monitoring path on a PC host
+ * @details Three measurements, all on fixed input:
+ *          - insert: MeasurementStore::insert() plus AnomalyDetector::process()
+ *            (the per-sample work of PowerMonitor::takeMeasurement()) on a
+ *            synthetic overnight log generated from a fixed seed
+ *          - takeMeasurement: the full PowerMonitor path including sampling
+ *            the power manager and subsystems
+ *          - report: PowerMonitor::generateReport() with the store filled
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+#include "../src/PowerManager/PowerManager.h"
+#include "../src/InfotainmentSystem/InfotainmentSystem.h"
+#include "../src/Diagnostics/PowerMonitor.h"
+
+static const uint32_t DEFAULT_MEASUREMENTS = 2000000;
+static const uint32_t DEFAULT_REPORTS = 1000000;
+static const uint32_t DEFAULT_SEED = 0x5EED;
+
+static uint32_t g_prngState = DEFAULT_SEED;
+
+// xorshift32, same generator as the ABS benchmarks
+static uint32_t nextRandom() {
+    uint32_t x = g_prngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    g_prngState = x;
+    return x;
+}
+
+static uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Next sample of the synthetic log (1 Hz)
+ * @details Drive cycles alternate with long sleep periods; sleep has a few
+ *          blocked periods with a subsystem left on, and every state gets
+ *          occasional current spikes and voltage dips
+ */
+static PowerMeasurement_t nextMeasurement(uint32_t index) {
+    PowerMeasurement_t m;
+    uint32_t phase = index % 7200;             // 2 h period: 30 min drive, 90 min parked
+    uint32_t noise = nextRandom();
+
+    m.timestamp_ms = index * 1000;
+    m.subsystemMask = 0;
+    if (phase < 1800) {
+        m.powerState = POWER_STATE_RUN;
+        m.consumption_uA = 1500000 + noise % 200000;
+        m.subsystemMask = SUBSYSTEM_AUDIO | SUBSYSTEM_DISPLAY | SUBSYSTEM_GPS;
+    } else if (phase < 1900) {
+        m.powerState = POWER_STATE_SLEEP_PREPARE;
+        m.consumption_uA = 150000 + noise % 20000;
+    } else {
+        m.powerState = POWER_STATE_SLEEP;
+        m.consumption_uA = 5000 + noise % 1000;
+        if ((index / 7200) % 5 == 4 && phase < 3000) {
+            m.subsystemMask = SUBSYSTEM_WIFI;  // sleep blocker
+            m.consumption_uA += 80000;
+        }
+    }
+    if (noise % 997 == 0) {
+        m.consumption_uA *= 4;                // spike
+    }
+    m.batteryVoltage_mV = (noise % 1499 == 0) ? 11200 : 12600 + (noise >> 20) % 100;
+    return m;
+}
+
+static void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [-n measurements] [-r reports] [-s seed]" << std::endl;
+    std::cout << "  -n  measurements per pass (default " << DEFAULT_MEASUREMENTS << ")" << std::endl;
+    std::cout << "  -r  generateReport() calls (default " << DEFAULT_REPORTS << ")" << std::endl;
+    std::cout << "  -s  random seed of the synthetic log (default 0x" << std::hex << DEFAULT_SEED
+              << std::dec << ")" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t measurements = DEFAULT_MEASUREMENTS;
+    uint32_t reports = DEFAULT_REPORTS;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "-n" && hasValue) {
+            measurements = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        } else if (arg == "-r" && hasValue) {
+            reports = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        } else if (arg == "-s" && hasValue) {
+            g_prngState = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        } else {
+            printUsage(argv[0]);
+            return (arg == "-h" || arg == "--help") ? 0 : 2;
+        }
+    }
+    if (measurements == 0 || reports == 0 || g_prngState == 0) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    // The monitor logs to std::cout; keep its output out of the report
+    std::ostringstream discard;
+    std::streambuf* console = std::cout.rdbuf(discard.rdbuf());
+
+    // Store and detector on the synthetic log
+    MeasurementStore* store = new MeasurementStore();
+    AnomalyDetector* detector = new AnomalyDetector();
+    detector->setThresholds(THRESHOLD_SLEEP, THRESHOLD_CRITICAL);
+
+    uint64_t t0 = nowNs();
+    for (uint32_t i = 0; i < measurements; i++) {
+        PowerMeasurement_t m = nextMeasurement(i);
+        store->insert(m);
+        detector->process(m, m.powerState == POWER_STATE_RUN);
+    }
+    uint64_t insertNs = nowNs() - t0;
+    uint32_t anomalies = detector->getTotalEvents();
+    delete detector;
+    delete store;
+
+    // Full PowerMonitor path
+    PowerManager powerManager;
+    InfotainmentSystem infotainmentSystem;
+    PowerMonitor* monitor = new PowerMonitor();
+    PowerConfig_t config = {
+        .sleepTimeout_ms = 300000,
+        .deepSleepTimeout_ms = 1800000,
+        .wakeupSources = WAKEUP_IGNITION | WAKEUP_CAN_NETWORK | WAKEUP_USER_INPUT,
+        .enablePeriodicWakeup = false,
+        .periodicWakeupInterval_ms = 3600000,
+        .enableNetworkWakeup = true,
+        .enableRemoteWakeup = false
+    };
+    if (!powerManager.initialize(config) || !infotainmentSystem.initialize(&powerManager) ||
+        !monitor->initialize(&powerManager, &infotainmentSystem)) {
+        std::cout.rdbuf(console);
+        std::cerr << "Failed to initialize the power monitor" << std::endl;
+        return 1;
+    }
+
+    t0 = nowNs();
+    for (uint32_t i = 0; i < measurements; i++) {
+        monitor->takeMeasurement();
+    }
+    uint64_t takeNs = nowNs() - t0;
+
+    uint64_t checksum = 0;
+    t0 = nowNs();
+    for (uint32_t i = 0; i < reports; i++) {
+        PowerAnalysisReport_t report = monitor->generateReport();
+        checksum += report.measurementCount;
+    }
+    uint64_t reportNs = nowNs() - t0;
+    delete monitor;
+
+    std::cout.rdbuf(console);
+
+    std::cout << "PowerMonitor benchmark" << std::endl;
+    std::cout << "  " << measurements << " measurements per pass, " << reports << " reports" << std::endl;
+    std::cout << "\nStore + anomaly detector (synthetic log)" << std::endl;
+    std::cout << "  insert: " << static_cast<double>(insertNs) / measurements << " ns/measurement" << std::endl;
+    std::cout << "  anomalies: " << anomalies << std::endl;
+    std::cout << "\nPowerMonitor::takeMeasurement()" << std::endl;
+    std::cout << "  take: " << static_cast<double>(takeNs) / measurements << " ns/measurement" << std::endl;
+    std::cout << "\nPowerMonitor::generateReport()" << std::endl;
+    std::cout << "  report: " << static_cast<double>(reportNs) / reports << " ns/report" << std::endl;
+
+    // Every report must cover the whole log
+    return (checksum == static_cast<uint64_t>(reports) * measurements) ? 0 : 1;
+}
@@ -6,6 +6,43 @@ echo "=== Building AUTOSAR Infotainment ECU Case Study ==="
 # Create build directory if it doesn't exist
 mkdir -p build
 
+# Regenerate configuration tables from ARXML
+CODEGEN="../ Engine ECU/tools/arxml_codegen.py"
+if command -v python3 >/dev/null 2>&1 && [ -f "$CODEGEN" ]; then
+    echo "Generating configuration tables..."
+    if ! python3 "$CODEGEN" --lang cpp config/EcuConfig.xml -o config/GeneratedConfig.h; then
+        echo "Error: configuration generation failed!"
+        exit 1
+    fi
+else
+    echo "Python 3 or arxml_codegen.py not found, using committed config/GeneratedConfig.h"
+fi
+
+# ./build.sh test: build and run the host tests instead of the application
+if [ "$1" = "test" ]; then
+    POWER_SOURCES="src/PowerManager/PowerManager.cpp src/PowerManager/PowerTransition.cpp \
+src/InfotainmentSystem/InfotainmentSystem.cpp src/Diagnostics/MeasurementStore.cpp \
+src/Diagnostics/MeasurementExporter.cpp src/Diagnostics/AnomalyDetector.cpp src/Diagnostics/PowerMonitor.cpp"
+    # test name:sources besides tests/<name>.cpp
+    TESTS=(
+        "anomaly_detector_test:src/Diagnostics/AnomalyDetector.cpp"
+        "measurement_store_test:$POWER_SOURCES"
+        "measurement_exporter_test:src/Diagnostics/MeasurementExporter.cpp src/Diagnostics/MeasurementStore.cpp"
+    )
+    failed=0
+    for entry in "${TESTS[@]}"; do
+        name="${entry%%:*}"
+        test_cmd="g++ -std=c++11 -Wall -Wextra -O2 -pthread -I. -o build/$name tests/$name.cpp ${entry#*:}"
+        echo "Build command: $test_cmd"
+        if ! $test_cmd; then
+            echo "❌ Test build failed!"
+            exit 1
+        fi
+        ./build/$name || failed=1
+    done
+    exit $failed
+fi
+
 # Compile the application
 echo "Compiling source files..."
 
@@ -18,8 +55,14 @@ OUTPUT="build/battery_drain_case_study"
 SOURCES=(
     "main.cpp"
     "src/PowerManager/PowerManager.cpp"
+    "src/PowerManager/PowerTransition.cpp"
     "src/InfotainmentSystem/InfotainmentSystem.cpp" 
+    "src/Diagnostics/MeasurementStore.cpp"
+    "src/Diagnostics/MeasurementExporter.cpp"
+    "src/Diagnostics/AnomalyDetector.cpp"
     "src/Diagnostics/PowerMonitor.cpp"
+    "src/ComStack/TimerWheel.cpp"
+    "src/ComStack/CanRouter.cpp"
 )
 
 # Check if all source files exist
@@ -11,6 +11,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "GeneratedConfig.h"
 
 //=============================================================================
 // Operating System Configuration
@@ -18,52 +19,16 @@
 
 /**
  * @brief OS Task Configuration
+ * @details Task IDs (CFG_OS_TASK_*) and the CFG_OS_TASKS table are generated
+ *          from the Os package of EcuConfig.xml into GeneratedConfig.h
  */
-#define OS_TASK_COUNT                    8
+#define OS_TASK_COUNT                    CFG_OS_TASK_COUNT
 #define OS_ISR_COUNT                     16
 #define OS_ALARM_COUNT                   10
 #define OS_COUNTER_COUNT                 4
 
-/**
- * @brief Task IDs and Priorities
- */
-typedef enum {
-    TASK_POWER_MANAGER = 0,      // Highest priority
-    TASK_INFOTAINMENT_MAIN = 1,
-    TASK_COM_STACK = 2,
-    TASK_DIAGNOSTICS = 3,
-    TASK_AUDIO_PROCESSING = 4,
-    TASK_DISPLAY_UPDATE = 5,
-    TASK_CONNECTIVITY = 6,
-    TASK_BACKGROUND = 7          // Lowest priority
-} OsTaskId_t;
-
-/**
- * @brief Task Configuration Structure
- */
-typedef struct {
-    OsTaskId_t taskId;
-    uint8_t priority;            // 0 = highest, 7 = lowest
-    uint32_t stackSize;          // Stack size in bytes
-    uint32_t period_ms;          // Task period in milliseconds
-    bool autostart;              // Auto-start task
-    bool preemptive;             // Preemptive scheduling
-    bool suspendable;            // Can be suspended for power saving
-} OsTaskConfig_t;
-
-/**
- * @brief Default task configurations
- */
-#define OS_TASK_CONFIGS { \
-    {TASK_POWER_MANAGER,    0, 2048, 100,  true,  true,  false}, \
-    {TASK_INFOTAINMENT_MAIN,1, 4096, 50,   true,  true,  true},  \
-    {TASK_COM_STACK,        2, 2048, 10,   true,  true,  true},  \
-    {TASK_DIAGNOSTICS,      3, 2048, 1000, false, false, true},  \
-    {TASK_AUDIO_PROCESSING, 4, 8192, 20,   false, false, true},  \
-    {TASK_DISPLAY_UPDATE,   5, 4096, 50,   false, false, true},  \
-    {TASK_CONNECTIVITY,     6, 3072, 200,  false, false, true},  \
-    {TASK_BACKGROUND,       7, 1024, 5000, false, false, true}   \
-}
+typedef CfgOsTaskId_t OsTaskId_t;
+typedef CfgOsTask_t OsTaskConfig_t;
 
 //=============================================================================
 // Memory Configuration
@@ -11,6 +11,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "GeneratedConfig.h"
 
 //=============================================================================
 // CAN Configuration for Power Management
@@ -18,12 +19,14 @@
 
 /**
  * @brief CAN Message IDs for Power Management
+ * @details Generated from the CanIf package of EcuConfig.xml; Cfg_PduByCanId()
+ *          maps a received ID to its CFG_PDUS entry in O(1)
  */
-#define CAN_MSG_POWER_STATE         0x100
-#define CAN_MSG_WAKEUP_REQUEST      0x101
-#define CAN_MSG_SLEEP_REQUEST       0x102
-#define CAN_MSG_DIAGNOSTIC_DATA     0x103
-#define CAN_MSG_BATTERY_STATUS      0x104
+#define CAN_MSG_POWER_STATE         CFG_CANID_POWER_STATE
+#define CAN_MSG_WAKEUP_REQUEST      CFG_CANID_WAKEUP_REQUEST
+#define CAN_MSG_SLEEP_REQUEST       CFG_CANID_SLEEP_REQUEST
+#define CAN_MSG_DIAGNOSTIC_DATA     CFG_CANID_DIAGNOSTIC_DATA
+#define CAN_MSG_BATTERY_STATUS      CFG_CANID_BATTERY_STATUS
 
 /**
  * @brief Network Management (NM) Configuration
@@ -73,12 +76,14 @@ typedef struct {
 
 /**
  * @brief Power Management DIDs (Data Identifiers)
+ * @details Generated from the Dcm package of EcuConfig.xml; Cfg_DidIndex()
+ *          maps a requested DID to its CFG_DIDS entry (and handler slot) in O(1)
  */
-#define DID_POWER_STATE                       0xF010
-#define DID_BATTERY_VOLTAGE                   0xF011
-#define DID_POWER_CONSUMPTION                 0xF012
-#define DID_WAKE_UP_SOURCES                   0xF013
-#define DID_SLEEP_MODE_CONFIG                 0xF014
+#define DID_POWER_STATE                       CFG_DID_POWER_STATE
+#define DID_BATTERY_VOLTAGE                   CFG_DID_BATTERY_VOLTAGE
+#define DID_POWER_CONSUMPTION                 CFG_DID_POWER_CONSUMPTION
+#define DID_WAKE_UP_SOURCES                   CFG_DID_WAKE_UP_SOURCES
+#define DID_SLEEP_MODE_CONFIG                 CFG_DID_SLEEP_MODE_CONFIG
 
 /**
  * @brief Routine Control IDs for Power Management
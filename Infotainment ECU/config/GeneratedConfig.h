@@ -0,0 +1,282 @@
+/**
+ * @file GeneratedConfig.h
+ * @brief Configuration tables generated from ARXML
+ * @details Generated by arxml_codegen.py from EcuConfig.xml.
+ *          Do not edit; change the ARXML and regenerate.
+ */
+
+#ifndef GENERATED_CONFIG_H
+#define GENERATED_CONFIG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CFG_INVALID_INDEX                0xFFu
+
+//=============================================================================
+// Operating System Tasks
+//=============================================================================
+
+/**
+ * @brief Task IDs in configuration order
+ */
+typedef enum {
+    CFG_OS_TASK_POWER_MANAGER = 0,
+    CFG_OS_TASK_INFOTAINMENT_MAIN = 1,
+    CFG_OS_TASK_COM_STACK = 2,
+    CFG_OS_TASK_DIAGNOSTICS = 3,
+    CFG_OS_TASK_AUDIO_PROCESSING = 4,
+    CFG_OS_TASK_DISPLAY_UPDATE = 5,
+    CFG_OS_TASK_CONNECTIVITY = 6,
+    CFG_OS_TASK_BACKGROUND = 7,
+    CFG_OS_TASK_COUNT
+} CfgOsTaskId_t;
+
+/**
+ * @brief OS task configuration (priority: higher value = higher priority)
+ */
+typedef struct {
+    const char* name;
+    uint8_t priority;
+    uint8_t activation;          // Maximum queued activations
+    uint32_t stackSize;          // Stack size in bytes
+    uint32_t period_ms;          // Cyclic alarm period, 0 = not alarm-driven
+    bool autostart;
+    bool preemptive;
+    bool suspendable;            // Can be suspended for power saving
+} CfgOsTask_t;
+
+static constexpr CfgOsTask_t CFG_OS_TASKS[] = {
+    {"PowerManager", 7, 1, 2048, 100, true, true, false},
+    {"InfotainmentMain", 6, 1, 4096, 50, true, true, true},
+    {"ComStack", 5, 1, 2048, 10, true, true, true},
+    {"Diagnostics", 4, 1, 2048, 1000, false, false, true},
+    {"AudioProcessing", 3, 1, 8192, 20, false, false, true},
+    {"DisplayUpdate", 2, 1, 4096, 50, false, false, true},
+    {"Connectivity", 1, 1, 3072, 200, false, false, true},
+    {"Background", 0, 1, 1024, 5000, false, false, true}
+};
+
+//=============================================================================
+// CAN PDUs (sorted by CAN ID)
+//=============================================================================
+
+#define CFG_CANID_POWER_STATE                  0x100u
+#define CFG_CANID_WAKEUP_REQUEST               0x101u
+#define CFG_CANID_SLEEP_REQUEST                0x102u
+#define CFG_CANID_DIAGNOSTIC_DATA              0x103u
+#define CFG_CANID_BATTERY_STATUS               0x104u
+
+typedef enum {
+    CFG_PDU_POWER_STATE = 0,
+    CFG_PDU_WAKEUP_REQUEST = 1,
+    CFG_PDU_SLEEP_REQUEST = 2,
+    CFG_PDU_DIAGNOSTIC_DATA = 3,
+    CFG_PDU_BATTERY_STATUS = 4,
+    CFG_PDU_COUNT
+} CfgPduIndex_t;
+
+/**
+ * @brief CAN PDU: CanIf routing joined with the Com I-PDU timing
+ */
+typedef struct {
+    uint32_t canId;
+    uint8_t dlc;
+    bool extendedId;
+    bool tx;                     // true = transmitted by this ECU
+    uint8_t comPduId;            // Com I-PDU ID, CFG_INVALID_INDEX if CanIf only
+    uint32_t cycle_ms;           // Tx period, 0 = event-driven
+    uint32_t timeout_ms;         // Rx deadline, 0 = not supervised
+    uint8_t firstSignal;         // Signals of this PDU are contiguous in CFG_SIGNALS
+    uint8_t signalCount;
+    const char* name;
+} CfgPdu_t;
+
+static constexpr CfgPdu_t CFG_PDUS[] = {
+    {0x100u, 8, false, true, 0, 100, 0, 0, 4, "PowerState"},
+    {0x101u, 8, false, false, 1, 0, 0, 4, 2, "WakeupRequest"},
+    {0x102u, 8, false, false, 2, 0, 0, 6, 2, "SleepRequest"},
+    {0x103u, 8, false, true, 3, 5000, 0, 8, 1, "DiagnosticData"},
+    {0x104u, 8, false, true, 4, 1000, 0, 9, 2, "BatteryStatus"}
+};
+
+static constexpr uint8_t CFG_CAN_ID_SLOTS[8] = {3, 0, 0, 2, 0, 4, 1, 0};
+
+static constexpr uint32_t Cfg_CanIdSlot(uint32_t key) {
+    return (key * 0x9E3779B1u) >> 29;
+}
+
+/**
+ * @brief Index into CFG_PDUS for a canId, CFG_INVALID_INDEX if unknown (O(1))
+ */
+static constexpr uint8_t Cfg_PduByCanId(uint32_t canId) {
+    return (CFG_PDUS[CFG_CAN_ID_SLOTS[Cfg_CanIdSlot(canId)]].canId == canId) ?
+        CFG_CAN_ID_SLOTS[Cfg_CanIdSlot(canId)] : CFG_INVALID_INDEX;
+}
+
+static_assert(Cfg_PduByCanId(CFG_PDUS[0].canId) == 0, "Cfg_PduByCanId: hash collision");
+static_assert(Cfg_PduByCanId(CFG_PDUS[1].canId) == 1, "Cfg_PduByCanId: hash collision");
+static_assert(Cfg_PduByCanId(CFG_PDUS[2].canId) == 2, "Cfg_PduByCanId: hash collision");
+static_assert(Cfg_PduByCanId(CFG_PDUS[3].canId) == 3, "Cfg_PduByCanId: hash collision");
+static_assert(Cfg_PduByCanId(CFG_PDUS[4].canId) == 4, "Cfg_PduByCanId: hash collision");
+static_assert(CFG_PDU_COUNT == sizeof(CFG_PDUS) / sizeof(CFG_PDUS[0]), "CFG_PDUS size");
+
+//=============================================================================
+// Com Signals (grouped by PDU)
+//=============================================================================
+
+typedef enum {
+    CFG_SIGNAL_POWER_STATE = 0,
+    CFG_SIGNAL_BATTERY_VOLTAGE = 1,
+    CFG_SIGNAL_POWER_CONSUMPTION = 2,
+    CFG_SIGNAL_SYSTEM_HEALTH = 3,
+    CFG_SIGNAL_WAKEUP_REQUEST = 4,
+    CFG_SIGNAL_WAKEUP_SOURCE_ECU = 5,
+    CFG_SIGNAL_SLEEP_REQUEST = 6,
+    CFG_SIGNAL_SLEEP_SOURCE_ECU = 7,
+    CFG_SIGNAL_DIAGNOSTIC_DATA = 8,
+    CFG_SIGNAL_BATTERY_STATUS_VOLTAGE = 9,
+    CFG_SIGNAL_BATTERY_STATE_OF_CHARGE = 10,
+    CFG_SIGNAL_COUNT
+} CfgSignalIndex_t;
+
+/**
+ * @brief Signal placement within its PDU
+ */
+typedef struct {
+    uint8_t pdu;                 // Index into CFG_PDUS
+    uint8_t startBit;
+    uint8_t length;              // Bits
+    bool littleEndian;
+    uint32_t initValue;
+    const char* name;
+} CfgSignal_t;
+
+static constexpr CfgSignal_t CFG_SIGNALS[] = {
+    {0, 0, 8, false, 0, "PowerState"},
+    {0, 8, 16, false, 0, "BatteryVoltage"},
+    {0, 24, 32, false, 0, "PowerConsumption"},
+    {0, 56, 8, false, 0, "SystemHealth"},
+    {1, 0, 8, false, 0, "WakeupRequest"},
+    {1, 8, 8, false, 0, "WakeupSourceEcu"},
+    {2, 0, 8, false, 0, "SleepRequest"},
+    {2, 8, 8, false, 0, "SleepSourceEcu"},
+    {3, 0, 16, false, 0, "DiagnosticData"},
+    {4, 0, 16, false, 0, "BatteryStatusVoltage"},
+    {4, 16, 8, false, 0, "BatteryStateOfCharge"}
+};
+
+//=============================================================================
+// Diagnostic Data Identifiers (sorted by DID)
+//=============================================================================
+
+#define CFG_DID_POWER_STATE                    0xF010u
+#define CFG_DID_BATTERY_VOLTAGE                0xF011u
+#define CFG_DID_POWER_CONSUMPTION              0xF012u
+#define CFG_DID_WAKE_UP_SOURCES                0xF013u
+#define CFG_DID_SLEEP_MODE_CONFIG              0xF014u
+
+/**
+ * @brief DID table indices; handlers are dispatched through an array of this size
+ */
+typedef enum {
+    CFG_DID_IDX_POWER_STATE = 0,
+    CFG_DID_IDX_BATTERY_VOLTAGE = 1,
+    CFG_DID_IDX_POWER_CONSUMPTION = 2,
+    CFG_DID_IDX_WAKE_UP_SOURCES = 3,
+    CFG_DID_IDX_SLEEP_MODE_CONFIG = 4,
+    CFG_DID_IDX_COUNT
+} CfgDidIndex_t;
+
+typedef struct {
+    uint16_t did;
+    uint16_t size;               // Data length in bytes
+    bool readable;
+    bool writable;
+    const char* name;
+} CfgDid_t;
+
+static constexpr CfgDid_t CFG_DIDS[] = {
+    {0xF010u, 1, true, false, "PowerState"},
+    {0xF011u, 2, true, false, "BatteryVoltage"},
+    {0xF012u, 4, true, false, "PowerConsumption"},
+    {0xF013u, 1, true, false, "WakeUpSources"},
+    {0xF014u, 4, true, true, "SleepModeConfig"}
+};
+
+static constexpr uint8_t CFG_DID_SLOTS[8] = {0, 2, 4, 0, 1, 0, 3, 0};
+
+static constexpr uint32_t Cfg_DidSlot(uint32_t key) {
+    return (key * 0x9E3779B1u) >> 29;
+}
+
+/**
+ * @brief Index into CFG_DIDS for a did, CFG_INVALID_INDEX if unknown (O(1))
+ */
+static constexpr uint8_t Cfg_DidIndex(uint32_t did) {
+    return (CFG_DIDS[CFG_DID_SLOTS[Cfg_DidSlot(did)]].did == did) ?
+        CFG_DID_SLOTS[Cfg_DidSlot(did)] : CFG_INVALID_INDEX;
+}
+
+static_assert(Cfg_DidIndex(CFG_DIDS[0].did) == 0, "Cfg_DidIndex: hash collision");
+static_assert(Cfg_DidIndex(CFG_DIDS[1].did) == 1, "Cfg_DidIndex: hash collision");
+static_assert(Cfg_DidIndex(CFG_DIDS[2].did) == 2, "Cfg_DidIndex: hash collision");
+static_assert(Cfg_DidIndex(CFG_DIDS[3].did) == 3, "Cfg_DidIndex: hash collision");
+static_assert(Cfg_DidIndex(CFG_DIDS[4].did) == 4, "Cfg_DidIndex: hash collision");
+static_assert(CFG_DID_IDX_COUNT == sizeof(CFG_DIDS) / sizeof(CFG_DIDS[0]), "CFG_DIDS size");
+
+//=============================================================================
+// Diagnostic Trouble Codes (sorted by DTC)
+//=============================================================================
+
+#define CFG_DTC_EXCESSIVE_SLEEP_CURRENT        0x9A0101u
+#define CFG_DTC_FAILED_SLEEP_ENTRY             0x9A0102u
+#define CFG_DTC_FREQUENT_WAKEUPS               0x9A0103u
+#define CFG_DTC_STUCK_SUBSYSTEM                0x9A0104u
+#define CFG_DTC_BATTERY_VOLTAGE_DROP           0x9A0105u
+
+typedef enum {
+    CFG_DTC_IDX_EXCESSIVE_SLEEP_CURRENT = 0,
+    CFG_DTC_IDX_FAILED_SLEEP_ENTRY = 1,
+    CFG_DTC_IDX_FREQUENT_WAKEUPS = 2,
+    CFG_DTC_IDX_STUCK_SUBSYSTEM = 3,
+    CFG_DTC_IDX_BATTERY_VOLTAGE_DROP = 4,
+    CFG_DTC_IDX_COUNT
+} CfgDtcIndex_t;
+
+typedef struct {
+    uint32_t dtc;                // 3-byte UDS DTC
+    uint8_t priority;            // 1 = most important
+    const char* name;
+} CfgDtc_t;
+
+static constexpr CfgDtc_t CFG_DTCS[] = {
+    {0x9A0101u, 1, "ExcessiveSleepCurrent"},
+    {0x9A0102u, 1, "FailedSleepEntry"},
+    {0x9A0103u, 2, "FrequentWakeups"},
+    {0x9A0104u, 2, "StuckSubsystem"},
+    {0x9A0105u, 1, "BatteryVoltageDrop"}
+};
+
+static constexpr uint8_t CFG_DTC_SLOTS[8] = {0, 0, 2, 0, 4, 1, 0, 3};
+
+static constexpr uint32_t Cfg_DtcSlot(uint32_t key) {
+    return (key * 0x9E3779B1u) >> 29;
+}
+
+/**
+ * @brief Index into CFG_DTCS for a dtc, CFG_INVALID_INDEX if unknown (O(1))
+ */
+static constexpr uint8_t Cfg_DtcIndex(uint32_t dtc) {
+    return (CFG_DTCS[CFG_DTC_SLOTS[Cfg_DtcSlot(dtc)]].dtc == dtc) ?
+        CFG_DTC_SLOTS[Cfg_DtcSlot(dtc)] : CFG_INVALID_INDEX;
+}
+
+static_assert(Cfg_DtcIndex(CFG_DTCS[0].dtc) == 0, "Cfg_DtcIndex: hash collision");
+static_assert(Cfg_DtcIndex(CFG_DTCS[1].dtc) == 1, "Cfg_DtcIndex: hash collision");
+static_assert(Cfg_DtcIndex(CFG_DTCS[2].dtc) == 2, "Cfg_DtcIndex: hash collision");
+static_assert(Cfg_DtcIndex(CFG_DTCS[3].dtc) == 3, "Cfg_DtcIndex: hash collision");
+static_assert(Cfg_DtcIndex(CFG_DTCS[4].dtc) == 4, "Cfg_DtcIndex: hash collision");
+static_assert(CFG_DTC_IDX_COUNT == sizeof(CFG_DTCS) / sizeof(CFG_DTCS[0]), "CFG_DTCS size");
+
+#endif // GENERATED_CONFIG_H
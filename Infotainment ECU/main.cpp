@@ -16,6 +16,7 @@
 #include "src/PowerManager/PowerManager.h"
 #include "src/InfotainmentSystem/InfotainmentSystem.h"
 #include "src/Diagnostics/PowerMonitor.h"
+#include "src/ComStack/CanRouter.h"
 
 // Global flag for graceful shutdown
 volatile bool g_running = true;
@@ -34,6 +35,13 @@ void signalHandler(int signal) {
     }
 }
 
+/**
+ * @brief Model the subsystems' hardware settle times on resume
+ */
+static void sleepForHardwareSettle(uint32_t settle_ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(settle_ms));
+}
+
 // Forward declarations
 void runInteractiveMode(PowerManager& pm, InfotainmentSystem& is, PowerMonitor& monitor);
 void runScenarios(PowerManager& pm, InfotainmentSystem& is, PowerMonitor& monitor);
@@ -49,6 +57,9 @@ int main(int argc, char* argv[]) {
     signal(SIGINT, signalHandler);
     signal(SIGTERM, signalHandler);
     
+    // No real hardware behind the subsystems: resume takes the simulated settle times
+    InfotainmentSystem::setSettleHook(sleepForHardwareSettle);
+    
     try {
         // Initialize core components
         PowerManager powerManager;
@@ -140,10 +151,11 @@ void runInteractiveMode(PowerManager& pm, InfotainmentSystem& is, PowerMonitor&
     std::cout << "3. Run vehicle simulation" << std::endl;
     std::cout << "4. Run power consumption test" << std::endl;
     std::cout << "5. Export power data to CSV" << std::endl;
+    std::cout << "6. Start/stop background export (binary, 1 MB files)" << std::endl;
     std::cout << "0. Exit" << std::endl;
     
     while (g_running) {
-        std::cout << "\nEnter choice (0-5): ";
+        std::cout << "\nEnter choice (0-6): ";
         std::string input;
         std::getline(std::cin, input);
         
@@ -153,7 +165,7 @@ void runInteractiveMode(PowerManager& pm, InfotainmentSystem& is, PowerMonitor&
         try {
             choice = std::stoi(input);
         } catch (...) {
-            std::cout << "Invalid input! Please enter a number 0-5." << std::endl;
+            std::cout << "Invalid input! Please enter a number 0-6." << std::endl;
             continue;
         }
         
@@ -201,6 +213,15 @@ void runInteractiveMode(PowerManager& pm, InfotainmentSystem& is, PowerMonitor&
                 break;
             }
             
+            case 6: {
+                if (monitor.isExporting()) {
+                    monitor.stopExport();
+                } else if (!monitor.startExport("power_log.pmb", EXPORT_FORMAT_BINARY, 1024 * 1024)) {
+                    std::cout << "Export failed!" << std::endl;
+                }
+                break;
+            }
+            
             default:
                 std::cout << "Invalid choice!" << std::endl;
                 break;
@@ -277,21 +298,26 @@ void runDashboard(PowerManager& pm, InfotainmentSystem& is, PowerMonitor& monito
     pm.setIgnitionState(true);
     std::this_thread::sleep_for(std::chrono::seconds(2));
     
+    uint32_t lastDashboard_ms = InfotainmentSystem::getTime_ms();
+    
     while (g_running) {
         pm.mainTask();
         is.mainTask();
         monitor.monitoringTask();
         
-        static int counter = 0;
-        if (++counter >= 20) { // Update every 2 seconds
+        uint32_t now = InfotainmentSystem::getTime_ms();
+        if (now - lastDashboard_ms >= 2000) { // Update every 2 seconds
             monitor.printPowerDashboard();
-            counter = 0;
+            lastDashboard_ms = now;
         }
         
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        // Sleep until a subsystem needs service, at most one logging interval
+        is.waitForNextDeadline(1000);
     }
     
     monitor.stopLogging();
+    std::cout << "Infotainment task wakeups: " << is.getWakeupCount()
+              << ", subsystem updates: " << is.getUpdateCount() << std::endl;
 }
 
 void runSimulation(PowerManager& pm, InfotainmentSystem& is, PowerMonitor& monitor) {
@@ -299,6 +325,9 @@ void runSimulation(PowerManager& pm, InfotainmentSystem& is, PowerMonitor& monit
     
     monitor.startLogging(1000);
     
+    CanRouter canRouter;
+    canRouter.initialize(&pm, InfotainmentSystem::getTime_ms());
+    
     std::cout << "Simulating ignition on..." << std::endl;
     pm.setIgnitionState(true);
     pm.registerUserActivity();
@@ -307,6 +336,8 @@ void runSimulation(PowerManager& pm, InfotainmentSystem& is, PowerMonitor& monit
         pm.mainTask();
         is.mainTask();
         monitor.monitoringTask();
+        canRouter.setSignal(CFG_SIGNAL_POWER_STATE, pm.getCurrentState());
+        canRouter.mainFunction(InfotainmentSystem::getTime_ms());
         std::this_thread::sleep_for(std::chrono::seconds(1));
     }
     
@@ -317,6 +348,8 @@ void runSimulation(PowerManager& pm, InfotainmentSystem& is, PowerMonitor& monit
         pm.mainTask();
         is.mainTask();
         monitor.monitoringTask();
+        canRouter.setSignal(CFG_SIGNAL_POWER_STATE, pm.getCurrentState());
+        canRouter.mainFunction(InfotainmentSystem::getTime_ms());
         
         if (pm.getCurrentState() == POWER_STATE_SLEEP) {
             std::cout << "Sleep mode entered after " << i << " seconds" << std::endl;
@@ -328,6 +361,8 @@ void runSimulation(PowerManager& pm, InfotainmentSystem& is, PowerMonitor& monit
     
     monitor.stopLogging();
     monitor.printAnalysisReport();
+    std::cout << "Infotainment task wakeups: " << is.getWakeupCount()
+              << ", subsystem updates: " << is.getUpdateCount() << std::endl;
     
     // Estimate overnight battery drain
     uint32_t currentConsumption_mA = monitor.getCurrentConsumption() / 1000;
@@ -346,6 +381,61 @@ void runSimulation(PowerManager& pm, InfotainmentSystem& is, PowerMonitor& monit
     } else {
         std::cout << "✅ GOOD: Low overnight battery drain" << std::endl;
     }
+    
+    // Sleep/ignition-on cycle: subsystems suspend and resume through the
+    // parallel transition engine, the analyzer reports per-subsystem timings
+    std::cout << "\nSimulating sleep entry and ignition-on wake-up..." << std::endl;
+    WakeupAnalyzer wakeupAnalyzer;
+    wakeupAnalyzer.initialize(&pm);
+    
+    pm.forceSleep();
+    pm.mainTask();
+    if (pm.getCurrentState() == POWER_STATE_SLEEP) {
+        uint32_t sleepStart_ms = InfotainmentSystem::getTime_ms();
+        pm.setIgnitionState(true);
+        wakeupAnalyzer.recordWakeupEvent(WAKEUP_IGNITION, InfotainmentSystem::getTime_ms() - sleepStart_ms);
+        wakeupAnalyzer.analyzeWakeupPattern();
+    }
+    pm.setIgnitionState(false);
+    
+    // Network wake-up: a burst of foreign bus traffic must not wake the
+    // ECU, only a WakeupRequest frame addressed to it. With the ignition
+    // off only the system tasks resume, the rest stays in low power
+    std::cout << "\nSimulating CAN bus burst during sleep..." << std::endl;
+    pm.forceSleep();
+    pm.mainTask();
+    canRouter.mainFunction(InfotainmentSystem::getTime_ms());
+    if (pm.getCurrentState() == POWER_STATE_SLEEP) {
+        uint32_t sleepStart_ms = InfotainmentSystem::getTime_ms();
+        const uint32_t burstFrames = 2000;
+        uint32_t seed = 0x12345678;
+        uint32_t queued = 0;
+        
+        auto burstStart = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < burstFrames; i++) {
+            seed = seed * 1664525u + 1013904223u;
+            CanFrame_t frame = { 0x200 + (seed >> 16) % 0x600, 8, { 0 } };
+            if (canRouter.onFrameReceived(frame)) queued++;
+        }
+        canRouter.mainFunction(InfotainmentSystem::getTime_ms());
+        auto burstTime_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - burstStart).count();
+        
+        std::cout << burstFrames << " foreign frames: " << queued << " queued, "
+                  << burstTime_ns / burstFrames << " ns/frame, PowerManager "
+                  << (pm.getCurrentState() == POWER_STATE_SLEEP ? "still asleep" : "woken") << std::endl;
+        
+        CanFrame_t wakeupFrame = { CAN_MSG_WAKEUP_REQUEST, 8, { 1, 0x20 } };
+        canRouter.onFrameReceived(wakeupFrame);
+        canRouter.mainFunction(InfotainmentSystem::getTime_ms());
+        if (pm.getCurrentState() != POWER_STATE_SLEEP) {
+            wakeupAnalyzer.recordWakeupEvent(WAKEUP_CAN_NETWORK, InfotainmentSystem::getTime_ms() - sleepStart_ms);
+            std::cout << "WakeupRequest 0x" << std::hex << CAN_MSG_WAKEUP_REQUEST << std::dec
+                      << " woke the PowerManager" << std::endl;
+        }
+    }
+    canRouter.printStatistics();
+    wakeupAnalyzer.printWakeupAnalysis();
 }
 
 void printUsage(const char* programName) {
@@ -0,0 +1,315 @@
+/**
+ * @file CanRouter.cpp
+ * @brief Fixed-size CAN frame routing implementation
+ * @details The PDU table and CAN ID lookup come from GeneratedConfig.h;
+ *          signal packing follows CFG_SIGNALS
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#include "CanRouter.h"
+#include <iostream>
+#include <cstring>
+
+static uint32_t readSignal(const uint8_t* data, const CfgSignal_t& signal) {
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < signal.length; i++) {
+        uint32_t bit = signal.startBit + i;
+        if (signal.littleEndian) {
+            value |= static_cast<uint32_t>((data[bit / 8] >> (bit % 8)) & 1u) << i;    // LSB first
+        } else {
+            value = (value << 1) | ((data[bit / 8] >> (7 - bit % 8)) & 1u);             // MSB first
+        }
+    }
+    return value;
+}
+
+static void writeSignal(uint8_t* data, const CfgSignal_t& signal, uint32_t value) {
+    for (uint32_t i = 0; i < signal.length; i++) {
+        uint32_t bit = signal.startBit + i;
+        uint32_t valueBit = signal.littleEndian ? i : signal.length - 1 - i;
+        uint8_t mask = signal.littleEndian ? static_cast<uint8_t>(1u << (bit % 8))
+                                           : static_cast<uint8_t>(0x80u >> (bit % 8));
+        if ((value >> valueBit) & 1u) {
+            data[bit / 8] |= mask;
+        } else {
+            data[bit / 8] &= static_cast<uint8_t>(~mask);
+        }
+    }
+}
+
+CanRouter::CanRouter() :
+    powerManager(nullptr),
+    communicationActive(false),
+    networkRequested(false),
+    rxHead(0),
+    rxTail(0),
+    txBatchCount(0),
+    timeoutHandler(nullptr),
+    timeoutContext(nullptr),
+    txHandler(nullptr),
+    txContext(nullptr)
+{
+    memset(routes, 0, sizeof(routes));
+    memset(timerPdu, 0, sizeof(timerPdu));
+    memset(txBatch, 0, sizeof(txBatch));
+    resetStats();
+
+    // One wheel timer per cyclic Tx PDU and per supervised Rx PDU
+    for (uint8_t pdu = 0; pdu < CFG_PDU_COUNT; pdu++) {
+        const CfgPdu_t& config = CFG_PDUS[pdu];
+        routes[pdu].timer = -1;
+        if ((config.tx && config.cycle_ms > 0) || (!config.tx && config.timeout_ms > 0)) {
+            routes[pdu].timer = wheel.create(onPduTimer, this);
+            if (routes[pdu].timer >= 0) timerPdu[routes[pdu].timer] = pdu;
+        }
+    }
+    nmTimer = wheel.create(onNmTimer, this);
+    busSleepTimer = wheel.create(onNmTimer, this);
+}
+
+bool CanRouter::initialize(PowerManager* pm, uint32_t now_ms) {
+    if (!pm || nmTimer < 0 || busSleepTimer < 0) {
+        return false;
+    }
+    powerManager = pm;
+
+    wheel.reset(now_ms);
+    communicationActive = false;
+    networkRequested = false;
+    rxHead.store(0, std::memory_order_relaxed);
+    rxTail.store(0, std::memory_order_relaxed);
+    txBatchCount = 0;
+
+    for (uint8_t pdu = 0; pdu < CFG_PDU_COUNT; pdu++) {
+        routes[pdu].pending = false;
+        memset(routes[pdu].data, 0, sizeof(routes[pdu].data));
+    }
+    for (uint8_t signal = 0; signal < CFG_SIGNAL_COUNT; signal++) {
+        writeSignal(routes[CFG_SIGNALS[signal].pdu].data, CFG_SIGNALS[signal], CFG_SIGNALS[signal].initValue);
+    }
+
+    setRxHandler(CFG_PDU_WAKEUP_REQUEST, onWakeupRequest, this);
+    setRxHandler(CFG_PDU_SLEEP_REQUEST, onSleepRequest, this);
+
+    if (powerManager->getCurrentState() != POWER_STATE_SLEEP) {
+        startCommunication();
+    }
+    return true;
+}
+
+bool CanRouter::setRxHandler(uint8_t pdu, RxHandler handler, void* context) {
+    if (pdu >= CFG_PDU_COUNT || CFG_PDUS[pdu].tx) {
+        return false;
+    }
+    routes[pdu].handler = handler;
+    routes[pdu].context = context;
+    return true;
+}
+
+void CanRouter::setRxTimeoutHandler(RxTimeoutHandler handler, void* context) {
+    timeoutHandler = handler;
+    timeoutContext = context;
+}
+
+void CanRouter::setTxHandler(TxHandler handler, void* context) {
+    txHandler = handler;
+    txContext = context;
+}
+
+void CanRouter::resetStats() {
+    memset(&stats, 0, sizeof(stats));
+}
+
+bool CanRouter::onFrameReceived(const CanFrame_t& frame) {
+    stats.framesSeen++;
+
+    uint8_t pdu = Cfg_PduByCanId(frame.id);
+    if (pdu == CFG_INVALID_INDEX || CFG_PDUS[pdu].tx) {
+        stats.framesFiltered++;
+        return false;
+    }
+    if (frame.dlc < CFG_PDUS[pdu].dlc || frame.dlc > 8) {
+        stats.dlcErrors++;
+        return false;
+    }
+
+    uint32_t head = rxHead.load(std::memory_order_relaxed);
+    uint32_t next = (head + 1) % RX_QUEUE_CAPACITY;
+    uint32_t tail = rxTail.load(std::memory_order_acquire);    // Slot freed by mainFunction
+    if (next == tail) {
+        stats.rxQueueOverflows++;
+        return false;
+    }
+    rxQueue[head] = frame;
+    rxHead.store(next, std::memory_order_release);             // Publish the frame
+
+    uint32_t depth = (next + RX_QUEUE_CAPACITY - tail) % RX_QUEUE_CAPACITY;
+    if (depth > stats.maxRxQueueDepth) stats.maxRxQueueDepth = depth;
+    return true;
+}
+
+void CanRouter::mainFunction(uint32_t now_ms) {
+    if (!powerManager) return;
+
+    // Dispatch before advancing so queued frames restart their deadlines first
+    uint32_t tail = rxTail.load(std::memory_order_relaxed);
+    while (tail != rxHead.load(std::memory_order_acquire)) {
+        const CanFrame_t& frame = rxQueue[tail];
+        uint8_t pdu = Cfg_PduByCanId(frame.id);
+        PduRoute& route = routes[pdu];
+
+        if (communicationActive && route.timer >= 0) {
+            wheel.start(route.timer, CFG_PDUS[pdu].timeout_ms);
+        }
+        if (route.handler) {
+            route.handler(route.context, pdu, frame);
+        }
+        stats.framesDispatched++;
+        tail = (tail + 1) % RX_QUEUE_CAPACITY;
+        rxTail.store(tail, std::memory_order_release);           // Hand the slot back
+    }
+
+    wheel.advance(now_ms);
+
+    bool shouldCommunicate = powerManager->getCurrentState() != POWER_STATE_SLEEP;
+    if (shouldCommunicate && !communicationActive) {
+        startCommunication();
+    } else if (!shouldCommunicate && communicationActive) {
+        stopCommunication();
+    }
+
+    flushTransmit();
+}
+
+bool CanRouter::setSignal(uint8_t signal, uint32_t value) {
+    if (signal >= CFG_SIGNAL_COUNT) {
+        return false;
+    }
+    const CfgSignal_t& config = CFG_SIGNALS[signal];
+    writeSignal(routes[config.pdu].data, config, value);
+    return true;
+}
+
+bool CanRouter::triggerTransmit(uint8_t pdu) {
+    if (pdu >= CFG_PDU_COUNT || !CFG_PDUS[pdu].tx || !communicationActive) {
+        return false;
+    }
+    queueTransmit(pdu);
+    return true;
+}
+
+void CanRouter::startCommunication() {
+    for (uint8_t pdu = 0; pdu < CFG_PDU_COUNT; pdu++) {
+        if (routes[pdu].timer < 0) continue;
+        const CfgPdu_t& config = CFG_PDUS[pdu];
+        wheel.start(routes[pdu].timer, config.tx ? config.cycle_ms : config.timeout_ms);
+    }
+    communicationActive = true;
+}
+
+void CanRouter::stopCommunication() {
+    for (uint8_t pdu = 0; pdu < CFG_PDU_COUNT; pdu++) {
+        if (routes[pdu].timer >= 0) wheel.stop(routes[pdu].timer);
+        routes[pdu].pending = false;
+    }
+    txBatchCount = 0;
+    communicationActive = false;
+}
+
+void CanRouter::queueTransmit(uint8_t pdu) {
+    if (routes[pdu].pending) return;
+    routes[pdu].pending = true;
+    txBatch[txBatchCount++] = pdu;
+}
+
+void CanRouter::flushTransmit() {
+    if (txBatchCount == 0) return;
+
+    CanFrame_t frames[CFG_PDU_COUNT];
+    for (uint32_t i = 0; i < txBatchCount; i++) {
+        uint8_t pdu = txBatch[i];
+        frames[i].id = CFG_PDUS[pdu].canId;
+        frames[i].dlc = CFG_PDUS[pdu].dlc;
+        memcpy(frames[i].data, routes[pdu].data, sizeof(frames[i].data));
+        routes[pdu].pending = false;
+    }
+    if (txHandler) {
+        txHandler(txContext, frames, txBatchCount);
+    }
+    stats.txFrames += txBatchCount;
+    stats.txBatches++;
+    txBatchCount = 0;
+}
+
+void CanRouter::releaseNetwork() {
+    networkRequested = false;
+    wheel.stop(nmTimer);
+    wheel.stop(busSleepTimer);
+    powerManager->setNetworkActivity(false);
+}
+
+void CanRouter::onPduTimer(void* context, uint32_t timerId) {
+    CanRouter* router = static_cast<CanRouter*>(context);
+    uint8_t pdu = router->timerPdu[timerId];
+    const CfgPdu_t& config = CFG_PDUS[pdu];
+
+    if (config.tx) {
+        router->wheel.start(timerId, config.cycle_ms);
+        router->queueTransmit(pdu);
+    } else {
+        // Reported once; the next reception re-arms the deadline
+        router->stats.rxTimeouts++;
+        if (router->timeoutHandler) {
+            router->timeoutHandler(router->timeoutContext, pdu);
+        }
+    }
+}
+
+void CanRouter::onNmTimer(void* context, uint32_t timerId) {
+    (void)timerId;
+    static_cast<CanRouter*>(context)->releaseNetwork();
+}
+
+void CanRouter::onWakeupRequest(void* context, uint8_t pdu, const CanFrame_t& frame) {
+    (void)pdu;
+    CanRouter* router = static_cast<CanRouter*>(context);
+    if (readSignal(frame.data, CFG_SIGNALS[CFG_SIGNAL_WAKEUP_REQUEST]) == 0) {
+        return;
+    }
+
+    router->networkRequested = true;
+    router->wheel.start(router->nmTimer, NM_NETWORK_TIMEOUT_TIME);
+    router->wheel.stop(router->busSleepTimer);
+
+    // setNetworkActivity() only wakes on a change of network state
+    if (router->powerManager->getCurrentState() == POWER_STATE_SLEEP) {
+        router->powerManager->wakeup(WAKEUP_CAN_NETWORK);
+    }
+    router->powerManager->setNetworkActivity(true);
+}
+
+void CanRouter::onSleepRequest(void* context, uint8_t pdu, const CanFrame_t& frame) {
+    (void)pdu;
+    CanRouter* router = static_cast<CanRouter*>(context);
+    if (!router->networkRequested ||
+        readSignal(frame.data, CFG_SIGNALS[CFG_SIGNAL_SLEEP_REQUEST]) == 0) {
+        return;
+    }
+
+    router->wheel.stop(router->nmTimer);
+    router->wheel.start(router->busSleepTimer, NM_WAIT_BUS_SLEEP_TIME);
+}
+
+void CanRouter::printStatistics() const {
+    std::cout << "\n=== CAN ROUTER STATISTICS ===" << std::endl;
+    std::cout << "Frames Seen: " << stats.framesSeen << std::endl;
+    std::cout << "Filtered (not for this ECU): " << stats.framesFiltered << std::endl;
+    std::cout << "Dispatched: " << stats.framesDispatched << std::endl;
+    std::cout << "DLC Errors: " << stats.dlcErrors << std::endl;
+    std::cout << "Rx Queue Overflows: " << stats.rxQueueOverflows
+              << " (max depth " << stats.maxRxQueueDepth << "/" << RX_QUEUE_CAPACITY - 1 << ")" << std::endl;
+    std::cout << "Rx Deadline Misses: " << stats.rxTimeouts << std::endl;
+    std::cout << "Tx Frames: " << stats.txFrames << " in " << stats.txBatches << " batches" << std::endl;
+    std::cout << "Network Requested: " << (networkRequested ? "YES" : "NO") << std::endl;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file CanRouter.h
+ * @brief Fixed-size CAN frame routing for power management messages
+ * @details Rx filtering and dispatch through the generated PDU table, Rx
+ *          deadline supervision and cyclic Tx on a single timer wheel,
+ *          and batched transmission; no allocation after construction
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#ifndef CAN_ROUTER_H
+#define CAN_ROUTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <atomic>
+#include "../PowerManager/PowerManager.h"
+#include "../../config/ComStackConfig.h"
+#include "TimerWheel.h"
+
+/**
+ * @brief Classic CAN frame
+ */
+typedef struct {
+    uint32_t id;
+    uint8_t dlc;
+    uint8_t data[8];
+} CanFrame_t;
+
+/**
+ * @brief Router counters
+ */
+typedef struct {
+    uint32_t framesSeen;           /**< Frames offered by the driver */
+    uint32_t framesFiltered;       /**< Unknown or own Tx IDs, dropped in the Rx filter */
+    uint32_t framesDispatched;     /**< Frames delivered to their handler */
+    uint32_t rxQueueOverflows;
+    uint32_t dlcErrors;            /**< Known ID shorter than its configured DLC */
+    uint32_t rxTimeouts;           /**< Rx deadline misses */
+    uint32_t txFrames;
+    uint32_t txBatches;
+    uint32_t maxRxQueueDepth;
+} CanRouterStats_t;
+
+/**
+ * @brief Routes CAN frames between the driver, power management and the bus
+ * @details
+ *   - onFrameReceived() is the driver (ISR) entry: an O(1) lookup through
+ *     Cfg_PduByCanId() drops IDs this ECU does not receive, so bursts of
+ *     foreign traffic never reach the application. Accepted frames are
+ *     copied into a fixed ring of RX_QUEUE_CAPACITY.
+ *   - mainFunction() drains the ring, restarts the PDU's Rx deadline,
+ *     calls its handler, advances the timer wheel and hands every Tx PDU
+ *     that fell due to the transmit hook as one batch.
+ *   - WakeupRequest keeps the network requested for NM_NETWORK_TIMEOUT_TIME
+ *     and wakes the PowerManager; SleepRequest releases it after
+ *     NM_WAIT_BUS_SLEEP_TIME. Cyclic Tx and Rx supervision stop while the
+ *     PowerManager sleeps, so only Rx filtering remains active.
+ *   Handlers are function pointers with a context, indexed by PDU.
+ */
+class CanRouter {
+public:
+    static const uint32_t RX_QUEUE_CAPACITY = 64;
+
+    typedef void (*RxHandler)(void* context, uint8_t pdu, const CanFrame_t& frame);
+    typedef void (*RxTimeoutHandler)(void* context, uint8_t pdu);
+    typedef void (*TxHandler)(void* context, const CanFrame_t* frames, uint32_t count);
+
+    CanRouter();
+
+    /**
+     * @brief Bind the NM handlers to the power manager and reset all timers
+     */
+    bool initialize(PowerManager* powerManager, uint32_t now_ms);
+
+    /**
+     * @brief Install or replace the receive handler of a PDU
+     */
+    bool setRxHandler(uint8_t pdu, RxHandler handler, void* context);
+
+    /**
+     * @brief Handler called when a supervised Rx PDU misses its deadline
+     */
+    void setRxTimeoutHandler(RxTimeoutHandler handler, void* context);
+
+    /**
+     * @brief Driver hook receiving each Tx batch; without one frames are only counted
+     */
+    void setTxHandler(TxHandler handler, void* context);
+
+    /**
+     * @brief Rx filter, callable from the CAN interrupt
+     * @return true if the frame was queued for the application
+     */
+    bool onFrameReceived(const CanFrame_t& frame);
+
+    /**
+     * @brief Dispatch queued frames, run timers and send due Tx PDUs
+     */
+    void mainFunction(uint32_t now_ms);
+
+    /**
+     * @brief Write a Tx signal into its PDU buffer (big-endian bit layout)
+     */
+    bool setSignal(uint8_t signal, uint32_t value);
+
+    /**
+     * @brief Queue an event-driven transmission with the next batch
+     */
+    bool triggerTransmit(uint8_t pdu);
+
+    /**
+     * @brief Milliseconds until mainFunction() has timer work, TIMER_WHEEL_IDLE if none
+     */
+    uint32_t getNextDeadline_ms() const { return wheel.getNextExpiry_ms(); }
+
+    bool isNetworkRequested() const { return networkRequested; }
+    const CanRouterStats_t& getStats() const { return stats; }
+    void resetStats();
+    void printStatistics() const;
+
+private:
+    struct PduRoute {
+        RxHandler handler;
+        void* context;
+        int timer;                 /**< Rx deadline or Tx cycle timer, -1 if none */
+        bool pending;              /**< Tx: already in the current batch */
+        uint8_t data[8];           /**< Tx: current signal values */
+    };
+
+    PowerManager* powerManager;
+    PduRoute routes[CFG_PDU_COUNT];
+    TimerWheel wheel;
+    uint8_t timerPdu[TimerWheel::MAX_TIMERS];    /**< Owning PDU of each wheel timer */
+    int nmTimer;                   /**< Network kept awake after WakeupRequest */
+    int busSleepTimer;             /**< Delay between SleepRequest and release */
+    bool communicationActive;      /**< Cyclic Tx and Rx supervision running */
+    bool networkRequested;
+
+    // Single-producer (ISR) / single-consumer (mainFunction) ring; each side
+    // publishes its index with release and reads the other's with acquire
+    CanFrame_t rxQueue[RX_QUEUE_CAPACITY];
+    std::atomic<uint32_t> rxHead;      /**< Producer */
+    std::atomic<uint32_t> rxTail;      /**< Consumer */
+
+    uint8_t txBatch[CFG_PDU_COUNT];
+    uint32_t txBatchCount;
+
+    RxTimeoutHandler timeoutHandler;
+    void* timeoutContext;
+    TxHandler txHandler;
+    void* txContext;
+
+    CanRouterStats_t stats;
+
+    void startCommunication();
+    void stopCommunication();
+    void queueTransmit(uint8_t pdu);
+    void flushTransmit();
+    void releaseNetwork();
+
+    static void onPduTimer(void* context, uint32_t timerId);
+    static void onNmTimer(void* context, uint32_t timerId);
+    static void onWakeupRequest(void* context, uint8_t pdu, const CanFrame_t& frame);
+    static void onSleepRequest(void* context, uint8_t pdu, const CanFrame_t& frame);
+};
+
+#endif // CAN_ROUTER_H
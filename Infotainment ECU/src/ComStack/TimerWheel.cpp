@@ -0,0 +1,127 @@
+/**
+ * @file TimerWheel.cpp
+ * @brief Hashed timer wheel implementation
+ * @details Slot lists are intrusive doubly-linked lists of timer indices
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#include "TimerWheel.h"
+#include <cstring>
+
+TimerWheel::TimerWheel(uint32_t tick_ms_) :
+    timerCount(0),
+    runningCount(0),
+    tick_ms(tick_ms_ ? tick_ms_ : 1),
+    origin_ms(0),
+    currentTick(0)
+{
+    memset(timers, 0, sizeof(timers));
+    reset(0);
+}
+
+void TimerWheel::reset(uint32_t now_ms) {
+    for (uint32_t i = 0; i < SLOT_COUNT; i++) {
+        slotHead[i] = NO_TIMER;
+    }
+    for (uint32_t i = 0; i < timerCount; i++) {
+        timers[i].running = false;
+    }
+    runningCount = 0;
+    origin_ms = now_ms;
+    currentTick = 0;
+}
+
+int TimerWheel::create(Callback callback, void* context) {
+    if (timerCount >= MAX_TIMERS) return -1;
+
+    Timer& timer = timers[timerCount];
+    timer.callback = callback;
+    timer.context = context;
+    timer.running = false;
+    timer.next = NO_TIMER;
+    timer.prev = NO_TIMER;
+    return static_cast<int>(timerCount++);
+}
+
+void TimerWheel::link(uint32_t timerId) {
+    Timer& timer = timers[timerId];
+    uint32_t slot = timer.expiryTick % SLOT_COUNT;
+    timer.prev = NO_TIMER;
+    timer.next = slotHead[slot];
+    if (timer.next != NO_TIMER) timers[timer.next].prev = static_cast<uint16_t>(timerId);
+    slotHead[slot] = static_cast<uint16_t>(timerId);
+    timer.running = true;
+    runningCount++;
+}
+
+void TimerWheel::unlink(uint32_t timerId) {
+    Timer& timer = timers[timerId];
+    if (timer.prev != NO_TIMER) {
+        timers[timer.prev].next = timer.next;
+    } else {
+        slotHead[timer.expiryTick % SLOT_COUNT] = timer.next;
+    }
+    if (timer.next != NO_TIMER) timers[timer.next].prev = timer.prev;
+    timer.next = NO_TIMER;
+    timer.prev = NO_TIMER;
+    timer.running = false;
+    runningCount--;
+}
+
+void TimerWheel::start(uint32_t timerId, uint32_t delay_ms) {
+    if (timerId >= timerCount) return;
+    if (timers[timerId].running) unlink(timerId);
+
+    uint32_t ticks = (delay_ms + tick_ms - 1) / tick_ms;
+    if (ticks == 0) ticks = 1;
+    timers[timerId].expiryTick = currentTick + ticks;
+    link(timerId);
+}
+
+void TimerWheel::stop(uint32_t timerId) {
+    if (timerId < timerCount && timers[timerId].running) unlink(timerId);
+}
+
+uint32_t TimerWheel::advance(uint32_t now_ms) {
+    uint32_t targetTick = (now_ms - origin_ms) / tick_ms;
+    uint32_t fired = 0;
+
+    while (currentTick != targetTick) {
+        if (runningCount == 0) {
+            currentTick = targetTick;
+            break;
+        }
+        currentTick++;
+
+        // Unlink everything due in this slot first, then run the callbacks
+        uint16_t due[MAX_TIMERS];
+        uint32_t dueCount = 0;
+        uint16_t id = slotHead[currentTick % SLOT_COUNT];
+        while (id != NO_TIMER) {
+            uint16_t next = timers[id].next;
+            if (timers[id].expiryTick == currentTick) {
+                unlink(id);
+                due[dueCount++] = id;
+            }
+            id = next;
+        }
+        for (uint32_t i = 0; i < dueCount; i++) {
+            timers[due[i]].callback(timers[due[i]].context, due[i]);
+        }
+        fired += dueCount;
+    }
+    return fired;
+}
+
+uint32_t TimerWheel::getNextExpiry_ms() const {
+    if (runningCount == 0) return TIMER_WHEEL_IDLE;
+
+    uint32_t nearest = UINT32_MAX;
+    for (uint32_t i = 0; i < timerCount; i++) {
+        if (timers[i].running && timers[i].expiryTick - currentTick < nearest) {
+            nearest = timers[i].expiryTick - currentTick;
+        }
+    }
+    return nearest * tick_ms;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file TimerWheel.h
+ * @brief Hashed timer wheel for communication timeouts and cyclic transmission
+ * @details Fixed pool of timers hashed into SLOT_COUNT slot lists by expiry
+ *          tick; start, stop and restart are O(1) and nothing is allocated
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+static const uint32_t TIMER_WHEEL_IDLE = UINT32_MAX;    /**< No timer running */
+
+/**
+ * @brief Single timer wheel shared by all communication timers
+ * @details Time advances in ticks of tick_ms. A timer expiring more than
+ *          SLOT_COUNT ticks ahead stays in its slot for extra rotations and
+ *          is skipped until its expiry tick. Expired timers of one tick are
+ *          unlinked before their callbacks run, so a callback may restart or
+ *          stop any timer. Callbacks are plain function pointers with a
+ *          context so that firing never allocates.
+ */
+class TimerWheel {
+public:
+    static const uint32_t SLOT_COUNT = 64;
+    static const uint32_t MAX_TIMERS = 32;
+
+    typedef void (*Callback)(void* context, uint32_t timerId);
+
+    /**
+     * @param tick_ms Resolution; delays are rounded up to whole ticks
+     */
+    explicit TimerWheel(uint32_t tick_ms = 10);
+
+    /**
+     * @brief Stop every timer and restart the time base at now_ms
+     */
+    void reset(uint32_t now_ms);
+
+    /**
+     * @brief Reserve a timer (stopped)
+     * @return Timer id, or -1 if the pool is exhausted
+     */
+    int create(Callback callback, void* context);
+
+    /**
+     * @brief (Re)arm a timer delay_ms after the last advance()
+     */
+    void start(uint32_t timerId, uint32_t delay_ms);
+
+    void stop(uint32_t timerId);
+
+    bool isRunning(uint32_t timerId) const { return timerId < timerCount && timers[timerId].running; }
+
+    /**
+     * @brief Move the wheel to now_ms, firing every timer that expired
+     * @return Number of timers fired
+     */
+    uint32_t advance(uint32_t now_ms);
+
+    /**
+     * @brief Milliseconds from the last advance() to the next expiry
+     * @return TIMER_WHEEL_IDLE if no timer is running
+     */
+    uint32_t getNextExpiry_ms() const;
+
+    uint32_t getRunningCount() const { return runningCount; }
+    uint32_t getTick_ms() const { return tick_ms; }
+
+private:
+    static const uint16_t NO_TIMER = 0xFFFF;
+
+    struct Timer {
+        Callback callback;
+        void* context;
+        uint32_t expiryTick;
+        uint16_t next;
+        uint16_t prev;
+        bool running;
+    };
+
+    Timer timers[MAX_TIMERS];
+    uint16_t slotHead[SLOT_COUNT];
+    uint32_t timerCount;
+    uint32_t runningCount;
+
+    uint32_t tick_ms;
+    uint32_t origin_ms;           /**< Time of tick 0 */
+    uint32_t currentTick;
+
+    void link(uint32_t timerId);
+    void unlink(uint32_t timerId);
+};
+
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,186 @@
+/**
+ * @file AnomalyDetector.cpp
+ * @brief Incremental power anomaly detection implementation
+ * @details Constant work per sample: one state's EWMA/CUSUM update, eight
+ *          run-length counters and a scan of the bounded event ring
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#include "AnomalyDetector.h"
+#include <cmath>
+#include <cstring>
+
+static const double EWMA_ALPHA = 1.0 / 32;          // ~32-sample memory
+static const double MIN_SIGMA_UA = 1000.0;          // 1 mA noise floor
+static const double SPIKE_SIGMAS = 6.0;
+static const double CUSUM_SLACK_SIGMAS = 0.5;       // Shifts below this are ignored
+static const double CUSUM_LIMIT_SIGMAS = 8.0;
+
+static const char* const STUCK_DESCRIPTIONS[AnomalyDetector::SUBSYSTEM_BITS] = {
+    "Audio active with ignition off",
+    "Display active with ignition off",
+    "Bluetooth active with ignition off",
+    "WiFi active with ignition off",
+    "GPS active with ignition off",
+    "Maintenance active with ignition off",
+    "Diagnostics active with ignition off",
+    "Update active with ignition off"
+};
+
+AnomalyDetector::AnomalyDetector() :
+    sleepThreshold_uA(10000),
+    criticalThreshold_uA(5000000)
+{
+    clear();
+}
+
+void AnomalyDetector::clear() {
+    memset(stateStats, 0, sizeof(stateStats));
+    memset(runLength, 0, sizeof(runLength));
+    memset(events, 0, sizeof(events));
+    sampleNumber = 0;
+    lastVoltage_mV = 0;
+    hasPrevious = false;
+    eventHead = 0;
+    eventCount = 0;
+    totalEvents = 0;
+}
+
+void AnomalyDetector::setThresholds(uint32_t sleep_uA, uint32_t critical_uA) {
+    sleepThreshold_uA = sleep_uA;
+    criticalThreshold_uA = critical_uA;
+}
+
+const AnomalyEvent_t& AnomalyDetector::getEvent(uint32_t i) const {
+    return events[(eventHead + EVENT_CAPACITY - eventCount + i) % EVENT_CAPACITY];
+}
+
+const AnomalyEvent_t& AnomalyDetector::getRecentEvent(uint32_t age) const {
+    return events[(eventHead + EVENT_CAPACITY - 1 - age) % EVENT_CAPACITY];
+}
+
+PowerAnomaly_t AnomalyDetector::getMostCommonAnomaly() const {
+    uint32_t counts[ANOMALY_THERMAL_ISSUE + 1] = { 0 };
+    for (uint32_t i = 0; i < eventCount; i++) {
+        counts[getEvent(i).type]++;
+    }
+
+    PowerAnomaly_t best = ANOMALY_NONE;
+    for (int t = ANOMALY_EXCESSIVE_CONSUMPTION; t <= ANOMALY_THERMAL_ISSUE; t++) {
+        if (counts[t] > counts[best]) best = static_cast<PowerAnomaly_t>(t);
+    }
+    return best;
+}
+
+bool AnomalyDetector::report(PowerAnomaly_t type, const PowerMeasurement_t& m, uint32_t subsystem,
+                             const char* description) {
+    // Merge into a recent event with the same key
+    for (uint32_t age = 0; age < eventCount; age++) {
+        AnomalyEvent_t& event = events[(eventHead + EVENT_CAPACITY - 1 - age) % EVENT_CAPACITY];
+        if (event.type == type && event.powerState == m.powerState &&
+            event.subsystemMask == subsystem && event.description == description &&
+            sampleNumber - event.lastSample <= DEDUP_WINDOW_SAMPLES) {
+            event.lastSeen_ms = m.timestamp_ms;
+            event.lastSample = sampleNumber;
+            event.occurrences++;
+            return false;
+        }
+    }
+
+    AnomalyEvent_t& event = events[eventHead];
+    event.type = type;
+    event.powerState = m.powerState;
+    event.subsystemMask = subsystem;
+    event.firstSeen_ms = m.timestamp_ms;
+    event.lastSeen_ms = m.timestamp_ms;
+    event.firstSample = sampleNumber;
+    event.lastSample = sampleNumber;
+    event.occurrences = 1;
+    event.value_uA = m.consumption_uA;
+    event.description = description;
+
+    eventHead = (eventHead + 1) % EVENT_CAPACITY;
+    if (eventCount < EVENT_CAPACITY) eventCount++;
+    totalEvents++;
+    return true;
+}
+
+void AnomalyDetector::updateStatistics(StateStatistics_t& stats, double value) {
+    stats.sampleCount++;
+
+    // Plain running mean/variance until the EWMA has enough history
+    double alpha = (stats.sampleCount < 1.0 / EWMA_ALPHA) ? 1.0 / stats.sampleCount : EWMA_ALPHA;
+    double diff = value - stats.mean_uA;
+    double increment = alpha * diff;
+    stats.mean_uA += increment;
+    stats.variance = (1.0 - alpha) * (stats.variance + diff * increment);
+}
+
+uint32_t AnomalyDetector::process(const PowerMeasurement_t& m, bool ignitionOn) {
+    uint32_t newEvents = 0;
+    sampleNumber++;
+
+    // Static limits
+    if (m.powerState == POWER_STATE_SLEEP && m.consumption_uA > sleepThreshold_uA) {
+        if (report(ANOMALY_EXCESSIVE_CONSUMPTION, m, 0, "High consumption in sleep mode")) newEvents++;
+    }
+    uint32_t activeSubsystems = 0;
+    for (uint32_t mask = m.subsystemMask; mask; mask &= mask - 1) activeSubsystems++;
+    if (m.powerState == POWER_STATE_SLEEP && activeSubsystems > 2) {
+        if (report(ANOMALY_FAILED_SLEEP_ENTRY, m, 0, "Multiple subsystems active during sleep")) newEvents++;
+    }
+    if (m.consumption_uA > criticalThreshold_uA) {
+        if (report(ANOMALY_EXCESSIVE_CONSUMPTION, m, 0, "Critical power consumption level")) newEvents++;
+    }
+
+    // Per-state statistics: spikes and sustained shifts
+    StateStatistics_t& stats = stateStats[m.powerState < STATE_COUNT ? m.powerState : POWER_STATE_RUN];
+    double value = static_cast<double>(m.consumption_uA);
+    bool deviating = false;
+
+    if (stats.sampleCount >= WARMUP_SAMPLES) {
+        double sigma = std::sqrt(stats.variance);
+        if (sigma < MIN_SIGMA_UA) sigma = MIN_SIGMA_UA;
+        double z = (value - stats.mean_uA) / sigma;
+
+        if (z > SPIKE_SIGMAS) {
+            deviating = true;
+            if (report(ANOMALY_EXCESSIVE_CONSUMPTION, m, 0, "Consumption spike above state baseline")) newEvents++;
+        }
+
+        // A single spike must not pass the CUSUM limit on its own; two in a row do
+        stats.cusumHigh += (z < SPIKE_SIGMAS ? z : SPIKE_SIGMAS) - CUSUM_SLACK_SIGMAS;
+        if (stats.cusumHigh < 0) stats.cusumHigh = 0;
+        if (stats.cusumHigh > CUSUM_LIMIT_SIGMAS) {
+            if (report(ANOMALY_EXCESSIVE_CONSUMPTION, m, 0, "Sustained consumption increase")) newEvents++;
+            // Change point: relearn the baseline from the new level
+            memset(&stats, 0, sizeof(stats));
+            deviating = false;
+        }
+    }
+    if (!deviating) {
+        updateStatistics(stats, value);
+    }
+
+    // Stuck subsystems: run lengths of active bits while the ignition is off
+    for (uint32_t bit = 0; bit < SUBSYSTEM_BITS; bit++) {
+        if (!ignitionOn && (m.subsystemMask & (1u << bit))) {
+            runLength[bit]++;
+            if (runLength[bit] >= STUCK_RUN_SAMPLES) {
+                if (report(ANOMALY_STUCK_SUBSYSTEM, m, 1u << bit, STUCK_DESCRIPTIONS[bit])) newEvents++;
+            }
+        } else {
+            runLength[bit] = 0;
+        }
+    }
+
+    // Voltage drop between consecutive samples
+    if (hasPrevious && m.batteryVoltage_mV + VOLTAGE_DROP_MV < lastVoltage_mV) {
+        if (report(ANOMALY_BATTERY_VOLTAGE_DROP, m, 0, "Significant battery voltage drop")) newEvents++;
+    }
+    lastVoltage_mV = m.batteryVoltage_mV;
+    hasPrevious = true;
+
+    return newEvents;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file AnomalyDetector.h
+ * @brief Incremental power anomaly detection
+ * @details Per-power-state EWMA and CUSUM statistics, stuck-subsystem run
+ *          lengths and a deduplicating event ring, all updated once per sample
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#ifndef ANOMALY_DETECTOR_H
+#define ANOMALY_DETECTOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "MeasurementStore.h"
+
+/**
+ * @brief Power anomaly types
+ */
+typedef enum {
+    ANOMALY_NONE = 0,
+    ANOMALY_EXCESSIVE_CONSUMPTION,
+    ANOMALY_FAILED_SLEEP_ENTRY,
+    ANOMALY_FREQUENT_WAKEUPS,
+    ANOMALY_STUCK_SUBSYSTEM,
+    ANOMALY_BATTERY_VOLTAGE_DROP,
+    ANOMALY_THERMAL_ISSUE
+} PowerAnomaly_t;
+
+/**
+ * @brief One detected anomaly; repeats within the dedup window are merged
+ */
+typedef struct {
+    PowerAnomaly_t type;
+    PowerState_t powerState;
+    uint32_t subsystemMask;        /**< Subsystem concerned (stuck subsystem), else 0 */
+    uint32_t firstSeen_ms;
+    uint32_t lastSeen_ms;
+    uint32_t firstSample;          /**< Sample number of the first detection */
+    uint32_t lastSample;
+    uint32_t occurrences;          /**< Samples that triggered this event */
+    uint32_t value_uA;             /**< Consumption at the first detection */
+    const char* description;       /**< Static text */
+} AnomalyEvent_t;
+
+/**
+ * @brief Streaming consumption statistics of one power state
+ */
+typedef struct {
+    uint32_t sampleCount;
+    double mean_uA;                /**< EWMA mean */
+    double variance;               /**< EWMA variance (uA^2) */
+    double cusumHigh;              /**< One-sided CUSUM of upward shifts, in sigmas */
+} StateStatistics_t;
+
+/**
+ * @brief Detects anomalies sample by sample without rescanning the history
+ * @details Each sample is checked against:
+ *            - the static sleep and critical thresholds,
+ *            - the EWMA mean/variance of its power state (spikes),
+ *            - a CUSUM on the standardized deviation (sustained shifts,
+ *              e.g. a subsystem that wakes up and stays on),
+ *            - run lengths of every subsystem bit while the ignition is off
+ *              (sleep blockers), and voltage drops between samples.
+ *          Spikes are kept out of the statistics and add at most the spike
+ *          limit to the CUSUM, so one spike alone is not a shift; after a CUSUM change
+ *          point the state relearns its baseline from the new level.
+ *          Events go into a ring of EVENT_CAPACITY; a repeat of the same
+ *          check (type, description, state and subsystem) within
+ *          DEDUP_WINDOW_SAMPLES of its last occurrence updates the existing
+ *          event instead of adding one.
+ */
+class AnomalyDetector {
+public:
+    static const uint32_t EVENT_CAPACITY = 64;
+    static const uint32_t DEDUP_WINDOW_SAMPLES = 300;      /**< 5 minutes at 1 Hz */
+    static const uint32_t WARMUP_SAMPLES = 16;             /**< Per state before EWMA checks */
+    static const uint32_t STUCK_RUN_SAMPLES = 60;          /**< 1 minute at 1 Hz */
+    static const uint32_t VOLTAGE_DROP_MV = 500;
+    static const uint32_t STATE_COUNT = POWER_STATE_SHUTDOWN + 1;
+    static const uint32_t SUBSYSTEM_BITS = 8;
+
+    AnomalyDetector();
+
+    /**
+     * @brief Forget statistics, run lengths and events
+     */
+    void clear();
+
+    /**
+     * @brief Static limits: consumption above sleep_uA in sleep, above critical_uA anywhere
+     */
+    void setThresholds(uint32_t sleep_uA, uint32_t critical_uA);
+
+    /**
+     * @brief Check one new sample and update the statistics
+     * @param measurement New sample
+     * @param ignitionOn Subsystems active with the ignition off count as run lengths
+     * @return Number of new events (not merged into an existing one)
+     */
+    uint32_t process(const PowerMeasurement_t& measurement, bool ignitionOn);
+
+    /**
+     * @brief Number of events retained in the ring
+     */
+    uint32_t getEventCount() const { return eventCount; }
+
+    /**
+     * @brief Event i, 0 = oldest retained
+     */
+    const AnomalyEvent_t& getEvent(uint32_t i) const;
+
+    /**
+     * @brief Event by age, 0 = newest
+     */
+    const AnomalyEvent_t& getRecentEvent(uint32_t age) const;
+
+    /**
+     * @brief Distinct events detected since the last clear, including overwritten ones
+     */
+    uint32_t getTotalEvents() const { return totalEvents; }
+
+    /**
+     * @brief Type with the most retained events, ANOMALY_NONE if there are none
+     */
+    PowerAnomaly_t getMostCommonAnomaly() const;
+
+    const StateStatistics_t& getStateStatistics(PowerState_t state) const { return stateStats[state]; }
+
+private:
+    StateStatistics_t stateStats[STATE_COUNT];
+    uint32_t runLength[SUBSYSTEM_BITS];    /**< Consecutive samples active with ignition off */
+    uint32_t sampleNumber;
+    uint32_t lastVoltage_mV;
+    bool hasPrevious;
+
+    uint32_t sleepThreshold_uA;
+    uint32_t criticalThreshold_uA;
+
+    AnomalyEvent_t events[EVENT_CAPACITY];
+    uint32_t eventHead;
+    uint32_t eventCount;
+    uint32_t totalEvents;
+
+    bool report(PowerAnomaly_t type, const PowerMeasurement_t& m, uint32_t subsystem,
+                const char* description);
+    void updateStatistics(StateStatistics_t& stats, double value);
+};
+
+#endif // ANOMALY_DETECTOR_H
@@ -0,0 +1,271 @@
+/**
+ * @file MeasurementExporter.cpp
+ * @brief Background streaming exporter implementation
+ * @details Lock-free hand-off to a worker thread that encodes CSV or delta
+ *          binary records into 64 KB chunks and rotates files by size
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#include "MeasurementExporter.h"
+#include <iostream>
+#include <chrono>
+#include <cstring>
+
+static const uint32_t MAX_RECORD_BYTES = 192;
+static const uint8_t BIN_TAG_VOLTAGE = 0x10;
+static const uint8_t BIN_TAG_MASK = 0x20;
+
+static uint32_t putVarint(char* out, uint64_t v) {
+    uint32_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = static_cast<char>((v & 0x7F) | 0x80);
+        v >>= 7;
+    }
+    out[n++] = static_cast<char>(v);
+    return n;
+}
+
+static uint32_t putZigzag(char* out, int64_t v) {
+    return putVarint(out, (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+}
+
+MeasurementExporter::MeasurementExporter() :
+    queueHead(0),
+    queueTail(0),
+    dropped(0),
+    stopRequested(false),
+    running(false),
+    format(EXPORT_FORMAT_CSV),
+    maxFileBytes(0),
+    file(nullptr),
+    fileIndex(0),
+    fileBytes(0),
+    fileRecords(0),
+    chunkUsed(0)
+{
+    memset(&previous, 0, sizeof(previous));
+    memset(&stats, 0, sizeof(stats));
+}
+
+MeasurementExporter::~MeasurementExporter() {
+    stop();
+}
+
+bool MeasurementExporter::start(const char* path, ExportFormat_t fmt, uint32_t maxBytes) {
+    if (running || !path) return false;
+
+    basePath = path;
+    format = fmt;
+    maxFileBytes = maxBytes;
+    fileIndex = 0;
+    queueHead.store(0);
+    queueTail.store(0);
+    dropped.store(0);
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        memset(&stats, 0, sizeof(stats));
+    }
+
+    chunk.reset(new char[CHUNK_BYTES]);
+    chunkUsed = 0;
+    if (!openFile()) {
+        chunk.reset();
+        return false;
+    }
+
+    stopRequested.store(false);
+    running = true;
+    worker = std::thread(&MeasurementExporter::run, this);
+    return true;
+}
+
+void MeasurementExporter::stop() {
+    if (!running) return;
+
+    stopRequested.store(true);
+    wakeCondition.notify_one();
+    worker.join();
+
+    closeFile();
+    chunk.reset();
+    running = false;
+}
+
+bool MeasurementExporter::submit(const PowerMeasurement_t& measurement) {
+    uint32_t head = queueHead.load(std::memory_order_relaxed);
+    if (head - queueTail.load(std::memory_order_acquire) == QUEUE_CAPACITY) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    queue[head & (QUEUE_CAPACITY - 1)] = measurement;
+    queueHead.store(head + 1, std::memory_order_release);
+
+    // Wake the worker early once the queue is half full; otherwise it polls every 100 ms
+    if (head - queueTail.load(std::memory_order_relaxed) == QUEUE_CAPACITY / 2) {
+        wakeCondition.notify_one();
+    }
+    return true;
+}
+
+uint32_t MeasurementExporter::exportHistory(const MeasurementStore& store) {
+    uint32_t queued = 0;
+    uint32_t count = store.rawCount();
+    for (uint32_t i = 0; i < count; i++) {
+        if (submit(store.rawAt(i))) queued++;
+    }
+    wakeCondition.notify_one();
+    return queued;
+}
+
+ExportStats_t MeasurementExporter::getStats() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    ExportStats_t result = stats;
+    result.recordsDropped = dropped.load(std::memory_order_relaxed);
+    return result;
+}
+
+void MeasurementExporter::run() {
+    std::chrono::steady_clock::time_point lastFlush = std::chrono::steady_clock::now();
+
+    for (;;) {
+        bool stopping = stopRequested.load();
+        uint32_t tail = queueTail.load(std::memory_order_relaxed);
+        uint32_t head = queueHead.load(std::memory_order_acquire);
+
+        while (tail != head) {
+            writeRecord(queue[tail & (QUEUE_CAPACITY - 1)]);
+            tail++;
+            queueTail.store(tail, std::memory_order_release);
+        }
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (chunkUsed > 0 &&
+            (stopping || now - lastFlush >= std::chrono::milliseconds(FLUSH_INTERVAL_MS))) {
+            flushChunk();
+        }
+        if (chunkUsed == 0) lastFlush = now;
+        if (stopping) break;
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait_for(lock, std::chrono::milliseconds(100));
+    }
+}
+
+bool MeasurementExporter::openFile() {
+    std::string path = basePath;
+    if (fileIndex > 0) path += "." + std::to_string(fileIndex);
+
+    file = fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cout << "Error: Could not open file " << path << std::endl;
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.writeErrors++;
+        return false;
+    }
+    setvbuf(file, nullptr, _IONBF, 0); // chunks are already large
+
+    fileBytes = 0;
+    fileRecords = 0;
+    memset(&previous, 0, sizeof(previous));
+    chunkUsed = encodeHeader(chunk.get());
+    fileBytes += chunkUsed;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.filesWritten++;
+    }
+    return true;
+}
+
+void MeasurementExporter::closeFile() {
+    if (!file) return;
+    flushChunk();
+    fclose(file);
+    file = nullptr;
+}
+
+void MeasurementExporter::flushChunk() {
+    if (chunkUsed == 0) return;
+    bool ok = file && fwrite(chunk.get(), 1, chunkUsed, file) == chunkUsed;
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    if (ok) {
+        stats.bytesWritten += chunkUsed;
+    } else {
+        stats.writeErrors++;
+    }
+    chunkUsed = 0;
+}
+
+void MeasurementExporter::writeRecord(const PowerMeasurement_t& m) {
+    if (!file) {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.writeErrors++; // rotation failed; count and discard
+        return;
+    }
+
+    char record[MAX_RECORD_BYTES];
+    uint32_t len = encodeRecord(m, record);
+
+    if (maxFileBytes > 0 && fileBytes + len > maxFileBytes && fileRecords > 0) {
+        closeFile();
+        fileIndex++;
+        if (!openFile()) return;
+        len = encodeRecord(m, record); // deltas restart in the new file
+    }
+    if (chunkUsed + len > CHUNK_BYTES) {
+        flushChunk();
+    }
+
+    memcpy(chunk.get() + chunkUsed, record, len);
+    chunkUsed += len;
+    fileBytes += len;
+    fileRecords++;
+    previous = m;
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats.recordsWritten++;
+}
+
+uint32_t MeasurementExporter::encodeHeader(char* out) {
+    if (format == EXPORT_FORMAT_BINARY) {
+        memcpy(out, "PMB1", 4);
+        return 4;
+    }
+    static const char header[] =
+        "Timestamp_ms,Consumption_uA,Consumption_mA,Battery_mV,Power_State,"
+        "Audio_Active,Display_Active,BT_Active,WiFi_Active,GPS_Active,"
+        "Maintenance_Active,Diagnostics_Active,Updates_Active\n";
+    memcpy(out, header, sizeof(header) - 1);
+    return sizeof(header) - 1;
+}
+
+uint32_t MeasurementExporter::encodeRecord(const PowerMeasurement_t& m, char* out) {
+    if (format == EXPORT_FORMAT_BINARY) {
+        uint8_t tag = static_cast<uint8_t>(m.powerState) & 0x0F;
+        if (m.batteryVoltage_mV != previous.batteryVoltage_mV) tag |= BIN_TAG_VOLTAGE;
+        if (m.subsystemMask != previous.subsystemMask) tag |= BIN_TAG_MASK;
+
+        uint32_t n = 0;
+        out[n++] = static_cast<char>(tag);
+        n += putZigzag(out + n, static_cast<int64_t>(m.timestamp_ms) - previous.timestamp_ms);
+        n += putZigzag(out + n, static_cast<int64_t>(m.consumption_uA) - previous.consumption_uA);
+        if (tag & BIN_TAG_VOLTAGE) {
+            n += putZigzag(out + n, static_cast<int64_t>(m.batteryVoltage_mV) - previous.batteryVoltage_mV);
+        }
+        if (tag & BIN_TAG_MASK) {
+            n += putVarint(out + n, m.subsystemMask);
+        }
+        return n;
+    }
+
+    uint32_t mask = m.subsystemMask;
+    int n = snprintf(out, MAX_RECORD_BYTES, "%u,%u,%u,%u,%d,%d,%d,%d,%d,%d,%d,%d,%d\n",
+                     m.timestamp_ms, m.consumption_uA, m.consumption_uA / 1000, m.batteryVoltage_mV,
+                     static_cast<int>(m.powerState),
+                     (mask & SUBSYSTEM_AUDIO) ? 1 : 0, (mask & SUBSYSTEM_DISPLAY) ? 1 : 0,
+                     (mask & SUBSYSTEM_BLUETOOTH) ? 1 : 0, (mask & SUBSYSTEM_WIFI) ? 1 : 0,
+                     (mask & SUBSYSTEM_GPS) ? 1 : 0, (mask & SUBSYSTEM_MAINTENANCE) ? 1 : 0,
+                     (mask & SUBSYSTEM_DIAGNOSTICS) ? 1 : 0, (mask & SUBSYSTEM_UPDATES) ? 1 : 0);
+    return n > 0 ? static_cast<uint32_t>(n) : 0;
+}
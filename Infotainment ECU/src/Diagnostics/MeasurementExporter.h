@@ -0,0 +1,141 @@
+/**
+ * @file MeasurementExporter.h
+ * @brief Background streaming exporter for power measurements
+ * @details Buffered CSV or compact binary output with size-based file rotation,
+ *          written by a worker thread so sampling never waits for storage
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#ifndef MEASUREMENT_EXPORTER_H
+#define MEASUREMENT_EXPORTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "MeasurementStore.h"
+
+/**
+ * @brief Export file formats
+ * @details EXPORT_FORMAT_CSV uses the columns of PowerMonitor::exportToCSV.
+ *
+ *          EXPORT_FORMAT_BINARY starts every file with the magic "PMB1" and
+ *          then holds one record per measurement:
+ *            tag        1 byte: bits 0-3 power state, bit 4 voltage follows,
+ *                       bit 5 subsystem mask follows
+ *            timestamp  zigzag varint, delta to the previous record
+ *            current    zigzag varint, delta to the previous record
+ *            voltage    zigzag varint delta, only if it changed
+ *            mask       varint, only if it changed
+ *          Deltas restart from zero in each file, so every rotated file
+ *          decodes on its own. A steady 1 Hz sample takes 4-5 bytes.
+ */
+typedef enum {
+    EXPORT_FORMAT_CSV = 0,
+    EXPORT_FORMAT_BINARY
+} ExportFormat_t;
+
+/**
+ * @brief Exporter counters
+ */
+typedef struct {
+    uint32_t recordsWritten;
+    uint32_t recordsDropped;       /**< Queue full when submitted */
+    uint64_t bytesWritten;
+    uint32_t filesWritten;
+    uint32_t writeErrors;
+} ExportStats_t;
+
+/**
+ * @brief Streams measurements to rotating files from a worker thread
+ * @details submit() is lock-free and never blocks: measurements go through a
+ *          single-producer ring to the worker, which encodes them into a
+ *          chunk buffer and writes whole chunks. With rotation enabled the
+ *          first file is the given path and later ones get ".1", ".2", ...
+ *          appended. Call submit() and exportHistory() from one thread.
+ */
+class MeasurementExporter {
+public:
+    static const uint32_t QUEUE_CAPACITY = 4096;       /**< Power of two */
+    static const uint32_t CHUNK_BYTES = 64 * 1024;
+    static const uint32_t FLUSH_INTERVAL_MS = 5000;    /**< Max age of unwritten data */
+
+    MeasurementExporter();
+    ~MeasurementExporter();
+
+    /**
+     * @brief Open the first file and start the worker
+     * @param path Output file (first file of the rotation)
+     * @param format CSV or binary
+     * @param maxFileBytes Rotate before a file would exceed this size, 0 = never
+     * @return false if already running or the file cannot be opened
+     */
+    bool start(const char* path, ExportFormat_t format, uint32_t maxFileBytes = 0);
+
+    /**
+     * @brief Write everything queued, close the file and stop the worker
+     */
+    void stop();
+
+    bool isRunning() const { return running; }
+
+    /**
+     * @brief Queue one measurement for export
+     * @return false if the queue was full and the measurement was dropped
+     */
+    bool submit(const PowerMeasurement_t& measurement);
+
+    /**
+     * @brief Queue the retained raw history of a store, oldest first
+     * @return Number of measurements queued
+     */
+    uint32_t exportHistory(const MeasurementStore& store);
+
+    /**
+     * @brief Counters; bytes and records are updated as chunks are written
+     */
+    ExportStats_t getStats() const;
+
+private:
+    PowerMeasurement_t queue[QUEUE_CAPACITY];
+    std::atomic<uint32_t> queueHead;         /**< Producer */
+    std::atomic<uint32_t> queueTail;         /**< Worker */
+    std::atomic<uint32_t> dropped;
+
+    std::thread worker;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<bool> stopRequested;
+    bool running;
+
+    // Worker-side state
+    std::string basePath;
+    ExportFormat_t format;
+    uint32_t maxFileBytes;
+    FILE* file;
+    uint32_t fileIndex;
+    uint64_t fileBytes;                      /**< Written plus buffered in the current file */
+    uint32_t fileRecords;
+    std::unique_ptr<char[]> chunk;           /**< Allocated while running */
+    uint32_t chunkUsed;
+    PowerMeasurement_t previous;             /**< Delta base of the binary format */
+
+    mutable std::mutex statsMutex;
+    ExportStats_t stats;
+
+    void run();
+    bool openFile();
+    void closeFile();
+    void flushChunk();
+    void writeRecord(const PowerMeasurement_t& m);
+    uint32_t encodeHeader(char* out);
+    uint32_t encodeRecord(const PowerMeasurement_t& m, char* out);
+};
+
+#endif // MEASUREMENT_EXPORTER_H
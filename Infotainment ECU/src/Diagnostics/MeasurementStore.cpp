@@ -0,0 +1,108 @@
+/**
+ * @file MeasurementStore.cpp
+ * @brief Tiered time-series store implementation
+ * @details Constant-time insert into the raw ring, the 1 s / 1 min / 1 h tiers
+ *          and the running totals used by the analysis report
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#include "MeasurementStore.h"
+#include <cstring>
+
+static const uint32_t TIER_PERIODS_MS[TIER_COUNT] = { 1000, 60000, 3600000 };
+
+MeasurementStore::MeasurementStore() {
+    clear();
+}
+
+void MeasurementStore::clear() {
+    raw.clear();
+    tier1s.clear();
+    tier1min.clear();
+    tier1h.clear();
+    memset(open, 0, sizeof(open));
+    memset(&totals, 0, sizeof(totals));
+    hasOpen = false;
+    lastState = POWER_STATE_OFF;
+}
+
+uint32_t MeasurementStore::tierPeriod_ms(MeasurementTier_t tier) {
+    return TIER_PERIODS_MS[tier];
+}
+
+void MeasurementStore::startBucket(PowerAggregate_t& bucket, uint32_t start_ms) {
+    memset(&bucket, 0, sizeof(bucket));
+    bucket.start_ms = start_ms;
+    bucket.minConsumption_uA = UINT32_MAX;
+    bucket.minVoltage_mV = UINT32_MAX;
+}
+
+void MeasurementStore::closeBucket(MeasurementTier_t tier) {
+    switch (tier) {
+        case TIER_1S: tier1s.push(open[tier]); break;
+        case TIER_1MIN: tier1min.push(open[tier]); break;
+        case TIER_1H: tier1h.push(open[tier]); break;
+        default: break;
+    }
+}
+
+void MeasurementStore::insert(const PowerMeasurement_t& m) {
+    raw.push(m);
+
+    for (int t = 0; t < TIER_COUNT; t++) {
+        MeasurementTier_t tier = static_cast<MeasurementTier_t>(t);
+        uint32_t period = TIER_PERIODS_MS[t];
+        uint32_t start = m.timestamp_ms - (m.timestamp_ms % period);
+        PowerAggregate_t& bucket = open[t];
+
+        if (!hasOpen) {
+            startBucket(bucket, start);
+        } else if (bucket.start_ms != start) {
+            closeBucket(tier);
+            startBucket(bucket, start);
+        }
+
+        bucket.sampleCount++;
+        bucket.sumConsumption_uA += m.consumption_uA;
+        if (m.consumption_uA < bucket.minConsumption_uA) bucket.minConsumption_uA = m.consumption_uA;
+        if (m.consumption_uA > bucket.maxConsumption_uA) bucket.maxConsumption_uA = m.consumption_uA;
+        if (m.batteryVoltage_mV < bucket.minVoltage_mV) bucket.minVoltage_mV = m.batteryVoltage_mV;
+        if (m.powerState == POWER_STATE_SLEEP) bucket.sleepCount++;
+        bucket.subsystemMask |= m.subsystemMask;
+    }
+
+    // Totals
+    if (hasOpen && lastState == POWER_STATE_SLEEP && m.powerState != POWER_STATE_SLEEP) {
+        totals.wakeupCount++;
+    }
+    totals.sampleCount++;
+    totals.sumConsumption_uA += m.consumption_uA;
+    if (m.consumption_uA > totals.peakConsumption_uA) totals.peakConsumption_uA = m.consumption_uA;
+    if (m.powerState == POWER_STATE_SLEEP) totals.sleepCount++;
+
+    lastState = m.powerState;
+    hasOpen = true;
+}
+
+uint32_t MeasurementStore::tierCount(MeasurementTier_t tier) const {
+    switch (tier) {
+        case TIER_1S: return tier1s.size();
+        case TIER_1MIN: return tier1min.size();
+        case TIER_1H: return tier1h.size();
+        default: return 0;
+    }
+}
+
+const PowerAggregate_t& MeasurementStore::tierAt(MeasurementTier_t tier, uint32_t i) const {
+    switch (tier) {
+        case TIER_1MIN: return tier1min.at(i);
+        case TIER_1H: return tier1h.at(i);
+        default: return tier1s.at(i);
+    }
+}
+
+const PowerAggregate_t* MeasurementStore::openBucket(MeasurementTier_t tier) const {
+    if (!hasOpen || tier >= TIER_COUNT) return nullptr;
+    return &open[tier];
+}
@@ -0,0 +1,188 @@
+/**
+ * @file MeasurementStore.h
+ * @brief Tiered time-series store for power measurements
+ * @details Raw ring of recent samples plus min/max/avg tiers (1 s, 1 min, 1 h)
+ *          and running totals, all updated in O(1) per inserted sample
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#ifndef MEASUREMENT_STORE_H
+#define MEASUREMENT_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../PowerManager/PowerManager.h"
+
+/**
+ * @brief Power measurement data point
+ */
+typedef struct {
+    uint32_t timestamp_ms;
+    uint32_t consumption_uA;
+    uint32_t batteryVoltage_mV;
+    PowerState_t powerState;
+    uint32_t subsystemMask;        /**< Bitmask of active subsystems */
+} PowerMeasurement_t;
+
+/**
+ * @brief Subsystem activity flags
+ */
+typedef enum {
+    SUBSYSTEM_AUDIO = 0x01,
+    SUBSYSTEM_DISPLAY = 0x02,
+    SUBSYSTEM_BLUETOOTH = 0x04,
+    SUBSYSTEM_WIFI = 0x08,
+    SUBSYSTEM_GPS = 0x10,
+    SUBSYSTEM_MAINTENANCE = 0x20,
+    SUBSYSTEM_DIAGNOSTICS = 0x40,
+    SUBSYSTEM_UPDATES = 0x80
+} SubsystemFlags_t;
+
+/**
+ * @brief Downsampled bucket of one tier
+ */
+typedef struct {
+    uint32_t start_ms;             /**< Start of the bucket period */
+    uint32_t sampleCount;
+    uint32_t minConsumption_uA;
+    uint32_t maxConsumption_uA;
+    uint64_t sumConsumption_uA;    /**< Average = sum / sampleCount */
+    uint32_t minVoltage_mV;
+    uint32_t sleepCount;           /**< Samples taken in POWER_STATE_SLEEP */
+    uint32_t subsystemMask;        /**< Subsystems active in any sample */
+} PowerAggregate_t;
+
+/**
+ * @brief Running totals over every sample since the last clear
+ */
+typedef struct {
+    uint32_t sampleCount;
+    uint64_t sumConsumption_uA;
+    uint32_t peakConsumption_uA;
+    uint32_t sleepCount;
+    uint32_t wakeupCount;          /**< Transitions out of POWER_STATE_SLEEP */
+} PowerTotals_t;
+
+/**
+ * @brief Downsampled tiers
+ */
+typedef enum {
+    TIER_1S = 0,
+    TIER_1MIN,
+    TIER_1H,
+    TIER_COUNT
+} MeasurementTier_t;
+
+/**
+ * @brief Fixed-capacity ring that overwrites its oldest entry when full
+ */
+template <typename T, uint32_t N>
+class FixedRing {
+private:
+    T items[N];
+    uint32_t head;
+    uint32_t count;
+
+public:
+    FixedRing() : head(0), count(0) {}
+
+    void clear() { head = 0; count = 0; }
+
+    void push(const T& item) {
+        items[head] = item;
+        head = (head + 1) % N;
+        if (count < N) count++;
+    }
+
+    uint32_t size() const { return count; }
+    static uint32_t capacity() { return N; }
+
+    /** @brief Entry i, 0 = oldest retained */
+    const T& at(uint32_t i) const { return items[(head + N - count + i) % N]; }
+
+    /** @brief Entry by age, 0 = newest */
+    const T& newest(uint32_t age) const { return items[(head + N - 1 - age) % N]; }
+};
+
+/**
+ * @brief Time-series store: raw ring, three downsampled tiers and totals
+ * @details Each tier keeps one open bucket that every sample is folded into;
+ *          a sample in a later period closes the bucket into the tier ring.
+ *          With one sample per second the store holds the last 34 minutes
+ *          raw, 15 minutes at 1 s, 24 hours at 1 min and 32 days at 1 h in
+ *          about 165 KB, however long logging runs.
+ */
+class MeasurementStore {
+public:
+    static const uint32_t RAW_CAPACITY = 2048;
+    static const uint32_t TIER_1S_CAPACITY = 900;      /**< 15 minutes */
+    static const uint32_t TIER_1MIN_CAPACITY = 1440;   /**< 24 hours */
+    static const uint32_t TIER_1H_CAPACITY = 768;      /**< 32 days */
+
+    MeasurementStore();
+
+    /**
+     * @brief Drop all samples, buckets and totals
+     */
+    void clear();
+
+    /**
+     * @brief Add one sample to the raw ring, every tier and the totals
+     */
+    void insert(const PowerMeasurement_t& measurement);
+
+    /**
+     * @brief Number of raw samples retained
+     */
+    uint32_t rawCount() const { return raw.size(); }
+
+    /**
+     * @brief Raw sample i, 0 = oldest retained
+     */
+    const PowerMeasurement_t& rawAt(uint32_t i) const { return raw.at(i); }
+
+    /**
+     * @brief Raw sample by age, 0 = newest
+     */
+    const PowerMeasurement_t& recent(uint32_t age) const { return raw.newest(age); }
+
+    /**
+     * @brief Number of closed buckets retained in a tier
+     */
+    uint32_t tierCount(MeasurementTier_t tier) const;
+
+    /**
+     * @brief Closed bucket i of a tier, 0 = oldest retained
+     */
+    const PowerAggregate_t& tierAt(MeasurementTier_t tier, uint32_t i) const;
+
+    /**
+     * @brief Bucket of a tier that is still collecting samples
+     * @return nullptr if no sample has been inserted since the last clear
+     */
+    const PowerAggregate_t* openBucket(MeasurementTier_t tier) const;
+
+    /**
+     * @brief Bucket length of a tier in milliseconds
+     */
+    static uint32_t tierPeriod_ms(MeasurementTier_t tier);
+
+    const PowerTotals_t& getTotals() const { return totals; }
+
+private:
+    FixedRing<PowerMeasurement_t, RAW_CAPACITY> raw;
+    FixedRing<PowerAggregate_t, TIER_1S_CAPACITY> tier1s;
+    FixedRing<PowerAggregate_t, TIER_1MIN_CAPACITY> tier1min;
+    FixedRing<PowerAggregate_t, TIER_1H_CAPACITY> tier1h;
+
+    PowerAggregate_t open[TIER_COUNT];
+    bool hasOpen;
+    PowerState_t lastState;
+    PowerTotals_t totals;
+
+    void closeBucket(MeasurementTier_t tier);
+    static void startBucket(PowerAggregate_t& bucket, uint32_t start_ms);
+};
+
+#endif // MEASUREMENT_STORE_H
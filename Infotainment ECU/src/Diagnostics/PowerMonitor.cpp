@@ -9,10 +9,10 @@
 #include "PowerMonitor.h"
 #include <iostream>
 #include <iomanip>
-#include <fstream>
 #include <cstring>
 #include <ctime>
 #include <cmath>
+#include <memory>
 
 //=============================================================================
 // PowerMonitor Implementation
@@ -21,9 +21,6 @@
 PowerMonitor::PowerMonitor() :
     powerManager(nullptr),
     infotainmentSystem(nullptr),
-    measurementIndex(0),
-    measurementCount(0),
-    anomalyCount(0),
     measurementInterval_ms(1000),
     continuousLogging(false),
     anomalyDetection(true),
@@ -34,12 +31,12 @@ PowerMonitor::PowerMonitor() :
     criticalThreshold_uA(THRESHOLD_CRITICAL)
 {
     memset(&analysisReport, 0, sizeof(analysisReport));
-    memset(measurements, 0, sizeof(measurements));
-    memset(currentAnomalies, 0, sizeof(currentAnomalies));
+    anomalyDetector.setThresholds(sleepThreshold_uA, criticalThreshold_uA);
 }
 
 PowerMonitor::~PowerMonitor() {
     stopLogging();
+    stopExport();
 }
 
 bool PowerMonitor::initialize(PowerManager* pm, InfotainmentSystem* is) {
@@ -67,17 +64,12 @@ void PowerMonitor::monitoringTask() {
     if (!powerManager || !infotainmentSystem) return;
     
     static uint32_t lastMeasurement = 0;
-    uint32_t currentTime = clock();
+    uint32_t currentTime = InfotainmentSystem::getTime_ms();
     
     if (continuousLogging && 
         (currentTime - lastMeasurement) >= measurementInterval_ms) {
         
-        PowerMeasurement_t measurement = takeMeasurement();
-        
-        if (anomalyDetection) {
-            detectAnomalies(measurement);
-        }
-        
+        takeMeasurement();
         lastMeasurement = currentTime;
     }
 }
@@ -93,31 +85,33 @@ void PowerMonitor::startLogging(uint32_t interval_ms) {
 void PowerMonitor::stopLogging() {
     continuousLogging = false;
     
-    if (measurementCount > 0) {
+    if (measurementStore.getTotals().sampleCount > 0) {
         updateAnalysisReport();
         std::cout << "Stopped power logging. Total measurements: " 
-                  << measurementCount << std::endl;
+                  << measurementStore.getTotals().sampleCount << std::endl;
     }
 }
 
 PowerMeasurement_t PowerMonitor::takeMeasurement() {
     PowerMeasurement_t measurement;
     
-    measurement.timestamp_ms = clock();
+    measurement.timestamp_ms = InfotainmentSystem::getTime_ms();     // Monotonic ms, also across sleep
     measurement.consumption_uA = getCurrentConsumption();
     measurement.batteryVoltage_mV = powerManager->getStatistics().batteryVoltage_mV;
     measurement.powerState = powerManager->getCurrentState();
     measurement.subsystemMask = getSubsystemMask();
     
-    // Store measurement
-    if (measurementCount < MAX_MEASUREMENTS) {
-        measurements[measurementIndex] = measurement;
-        measurementIndex = (measurementIndex + 1) % MAX_MEASUREMENTS;
-        measurementCount++;
-    } else {
-        // Circular buffer - overwrite oldest
-        measurements[measurementIndex] = measurement;
-        measurementIndex = (measurementIndex + 1) % MAX_MEASUREMENTS;
+    // Store measurement (raw ring overwrites the oldest; tiers and totals keep the rest)
+    measurementStore.insert(measurement);
+    
+    // Incremental anomaly detection on this sample only
+    if (anomalyDetection) {
+        detectAnomalies(measurement);
+    }
+    
+    // Hand off to the background export, if one is running (never blocks)
+    if (exporter.isRunning()) {
+        exporter.submit(measurement);
     }
     
     return measurement;
@@ -129,18 +123,18 @@ PowerAnalysisReport_t PowerMonitor::generateReport() {
 }
 
 void PowerMonitor::analyzeAnomalies() {
-    anomalyCount = 0;
+    uint32_t retained = anomalyDetector.getEventCount();
     
-    // Check recent measurements for anomalies
-    uint32_t recentCount = std::min(measurementCount, 100u); // Last 100 measurements
+    std::cout << "Anomaly analysis complete. Found " << anomalyDetector.getTotalEvents()
+              << " anomalies (" << retained << " retained)." << std::endl;
     
-    for (uint32_t i = 0; i < recentCount; i++) {
-        uint32_t idx = (measurementIndex - 1 - i + MAX_MEASUREMENTS) % MAX_MEASUREMENTS;
-        detectAnomalies(measurements[idx]);
+    for (uint32_t i = 0; i < retained; i++) {
+        const AnomalyEvent_t& event = anomalyDetector.getEvent(i);
+        std::cout << "  [" << event.firstSeen_ms << " - " << event.lastSeen_ms << " ms] "
+                  << event.description << " (Type: " << static_cast<int>(event.type)
+                  << ", state " << static_cast<int>(event.powerState)
+                  << ", " << event.occurrences << "x, " << event.value_uA / 1000 << " mA)" << std::endl;
     }
-    
-    std::cout << "Anomaly analysis complete. Found " << anomalyCount 
-              << " anomalies in recent measurements." << std::endl;
 }
 
 uint32_t PowerMonitor::getCurrentConsumption() const {
@@ -186,7 +180,7 @@ void PowerMonitor::printPowerDashboard() {
     std::cout << "\033[2J\033[1;1H";
     
     std::cout << "=== REAL-TIME POWER DASHBOARD ===" << std::endl;
-    std::cout << "Timestamp: " << clock() << " ms" << std::endl << std::endl;
+    std::cout << "Timestamp: " << InfotainmentSystem::getTime_ms() << " ms" << std::endl << std::endl;
     
     // Current power state
     PowerState_t state = powerManager->getCurrentState();
@@ -290,7 +284,7 @@ void PowerMonitor::printAnalysisReport() {
     PowerAnalysisReport_t report = generateReport();
     
     std::cout << "\n=== POWER ANALYSIS REPORT ===" << std::endl;
-    std::cout << "Measurement Period: " << measurementCount << " samples" << std::endl;
+    std::cout << "Measurement Period: " << report.measurementCount << " samples" << std::endl;
     std::cout << "Total Energy Consumed: " << report.totalEnergy_mAh << " mAh" << std::endl;
     std::cout << "Average Consumption: " << report.averageConsumption_mA << " mA" << std::endl;
     std::cout << "Peak Consumption: " << report.peakConsumption_mA << " mA" << std::endl;
@@ -298,6 +292,10 @@ void PowerMonitor::printAnalysisReport() {
     std::cout << "Wake-up Events: " << report.wakeupCount << std::endl;
     std::cout << "Detected Anomalies: " << report.anomalyCount << std::endl;
     std::cout << "Estimated Battery Life: " << report.estimatedBatteryLife_hours << " hours" << std::endl;
+    std::cout << "History Retained: " << measurementStore.rawCount() << " raw, "
+              << measurementStore.tierCount(TIER_1S) << " x 1 s, "
+              << measurementStore.tierCount(TIER_1MIN) << " x 1 min, "
+              << measurementStore.tierCount(TIER_1H) << " x 1 h" << std::endl;
     
     // Recommendations
     std::cout << "\nRecommendations:" << std::endl;
@@ -316,47 +314,53 @@ void PowerMonitor::printAnalysisReport() {
 }
 
 bool PowerMonitor::exportToCSV(const char* filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        std::cout << "Error: Could not open file " << filename << std::endl;
+    // One-shot export of the raw history through a private exporter, so a
+    // running background export is not disturbed
+    std::unique_ptr<MeasurementExporter> csv(new MeasurementExporter());
+    if (!csv->start(filename, EXPORT_FORMAT_CSV)) {
         return false;
     }
     
-    // Write CSV header
-    file << "Timestamp_ms,Consumption_uA,Consumption_mA,Battery_mV,Power_State,";
-    file << "Audio_Active,Display_Active,BT_Active,WiFi_Active,GPS_Active,";
-    file << "Maintenance_Active,Diagnostics_Active,Updates_Active" << std::endl;
+    uint32_t count = csv->exportHistory(measurementStore);
+    csv->stop();
+    bool ok = csv->getStats().writeErrors == 0;
     
-    // Write measurement data
-    for (uint32_t i = 0; i < measurementCount; i++) {
-        const PowerMeasurement_t& m = measurements[i];
-        
-        file << m.timestamp_ms << ","
-             << m.consumption_uA << ","
-             << m.consumption_uA/1000 << ","
-             << m.batteryVoltage_mV << ","
-             << static_cast<int>(m.powerState) << ","
-             << ((m.subsystemMask & SUBSYSTEM_AUDIO) ? 1 : 0) << ","
-             << ((m.subsystemMask & SUBSYSTEM_DISPLAY) ? 1 : 0) << ","
-             << ((m.subsystemMask & SUBSYSTEM_BLUETOOTH) ? 1 : 0) << ","
-             << ((m.subsystemMask & SUBSYSTEM_WIFI) ? 1 : 0) << ","
-             << ((m.subsystemMask & SUBSYSTEM_GPS) ? 1 : 0) << ","
-             << ((m.subsystemMask & SUBSYSTEM_MAINTENANCE) ? 1 : 0) << ","
-             << ((m.subsystemMask & SUBSYSTEM_DIAGNOSTICS) ? 1 : 0) << ","
-             << ((m.subsystemMask & SUBSYSTEM_UPDATES) ? 1 : 0) << std::endl;
-    }
-    
-    file.close();
-    std::cout << "Exported " << measurementCount << " measurements to " << filename << std::endl;
+    std::cout << "Exported " << count << " measurements to " << filename << std::endl;
+    return ok;
+}
+
+bool PowerMonitor::startExport(const char* path, ExportFormat_t format, uint32_t maxFileBytes) {
+    if (!exporter.start(path, format, maxFileBytes)) {
+        return false;
+    }
+    
+    uint32_t history = exporter.exportHistory(measurementStore);
+    std::cout << "Started background export to " << path 
+              << " (" << (format == EXPORT_FORMAT_BINARY ? "binary" : "CSV")
+              << ", " << history << " stored measurements queued)" << std::endl;
     return true;
 }
 
+void PowerMonitor::stopExport() {
+    if (!exporter.isRunning()) return;
+    
+    exporter.stop();
+    ExportStats_t stats = exporter.getStats();
+    std::cout << "Background export finished: " << stats.recordsWritten << " measurements, "
+              << stats.bytesWritten << " bytes in " << stats.filesWritten << " file(s)";
+    if (stats.recordsDropped > 0) {
+        std::cout << ", " << stats.recordsDropped << " dropped";
+    }
+    std::cout << std::endl;
+}
+
 void PowerMonitor::configureThresholds(uint32_t sleep_uA, uint32_t standby_uA, 
                                      uint32_t active_uA, uint32_t critical_uA) {
     sleepThreshold_uA = sleep_uA;
     standbyThreshold_uA = standby_uA;
     activeThreshold_uA = active_uA;
     criticalThreshold_uA = critical_uA;
+    anomalyDetector.setThresholds(sleep_uA, critical_uA);
     
     std::cout << "Updated power thresholds:" << std::endl;
     std::cout << "  Sleep: " << sleep_uA/1000 << " mA" << std::endl;
@@ -366,77 +370,37 @@ void PowerMonitor::configureThresholds(uint32_t sleep_uA, uint32_t standby_uA,
 }
 
 void PowerMonitor::clearMeasurements() {
-    measurementIndex = 0;
-    measurementCount = 0;
-    anomalyCount = 0;
+    measurementStore.clear();
+    anomalyDetector.clear();
     memset(&analysisReport, 0, sizeof(analysisReport));
-    memset(measurements, 0, sizeof(measurements));
-    memset(currentAnomalies, 0, sizeof(currentAnomalies));
 }
 
 void PowerMonitor::detectAnomalies(const PowerMeasurement_t& measurement) {
-    if (anomalyCount >= 10) return; // Max 10 anomalies tracked
-    
-    // Anomaly 1: Excessive consumption in sleep mode
-    if (measurement.powerState == POWER_STATE_SLEEP && 
-        measurement.consumption_uA > sleepThreshold_uA) {
-        logAnomaly(ANOMALY_EXCESSIVE_CONSUMPTION, 
-                  "High consumption in sleep mode");
-    }
-    
-    // Anomaly 2: Failed sleep entry (multiple subsystems active)
-    uint32_t activeSubsystems = __builtin_popcount(measurement.subsystemMask);
-    if (measurement.powerState == POWER_STATE_SLEEP && activeSubsystems > 2) {
-        logAnomaly(ANOMALY_FAILED_SLEEP_ENTRY, 
-                  "Multiple subsystems active during sleep");
-    }
-    
-    // Anomaly 3: Critical consumption level
-    if (measurement.consumption_uA > criticalThreshold_uA) {
-        logAnomaly(ANOMALY_EXCESSIVE_CONSUMPTION, 
-                  "Critical power consumption level");
-    }
+    // Static thresholds, per-state EWMA/CUSUM, stuck subsystems, voltage drop;
+    // repeats of an ongoing anomaly are merged, only new ones are logged
+    uint32_t newEvents = anomalyDetector.process(measurement, powerManager->getIgnitionState());
     
-    // Anomaly 4: Battery voltage drop
-    static uint32_t lastVoltage = measurement.batteryVoltage_mV;
-    if (measurement.batteryVoltage_mV < lastVoltage - 500) { // 0.5V drop
-        logAnomaly(ANOMALY_BATTERY_VOLTAGE_DROP, 
-                  "Significant battery voltage drop");
+    if (newEvents > anomalyDetector.getEventCount()) newEvents = anomalyDetector.getEventCount();
+    for (uint32_t age = newEvents; age > 0; age--) {
+        logAnomaly(anomalyDetector.getRecentEvent(age - 1));
     }
-    lastVoltage = measurement.batteryVoltage_mV;
 }
 
 void PowerMonitor::updateAnalysisReport() {
-    if (measurementCount == 0) return;
-    
-    uint64_t totalConsumption = 0;
-    uint32_t peakConsumption = 0;
-    uint32_t sleepModeCount = 0;
-    uint32_t totalEnergy = 0;
+    const PowerTotals_t& totals = measurementStore.getTotals();
+    if (totals.sampleCount == 0) return;
     
-    for (uint32_t i = 0; i < measurementCount; i++) {
-        const PowerMeasurement_t& m = measurements[i];
-        
-        totalConsumption += m.consumption_uA;
-        
-        if (m.consumption_uA > peakConsumption) {
-            peakConsumption = m.consumption_uA;
-        }
-        
-        if (m.powerState == POWER_STATE_SLEEP) {
-            sleepModeCount++;
-        }
-        
-        // Calculate energy (simplified: assume 1 second intervals)
-        totalEnergy += (m.consumption_uA / 1000) / 3600; // Convert to mAh
-    }
+    // Energy: each sample stands for one measurement interval
+    uint64_t charge_uAms = totals.sumConsumption_uA * measurementInterval_ms;
     
-    analysisReport.measurementCount = measurementCount;
-    analysisReport.averageConsumption_mA = (totalConsumption / measurementCount) / 1000;
-    analysisReport.peakConsumption_mA = peakConsumption / 1000;
-    analysisReport.sleepModePercentage = (sleepModeCount * 100) / measurementCount;
-    analysisReport.totalEnergy_mAh = totalEnergy;
-    analysisReport.anomalyCount = anomalyCount;
+    analysisReport.measurementCount = totals.sampleCount;
+    analysisReport.averageConsumption_mA = (totals.sumConsumption_uA / totals.sampleCount) / 1000;
+    analysisReport.peakConsumption_mA = totals.peakConsumption_uA / 1000;
+    analysisReport.sleepModePercentage = static_cast<uint32_t>((static_cast<uint64_t>(totals.sleepCount) * 100) / totals.sampleCount);
+    analysisReport.totalEnergy_mAh = static_cast<uint32_t>(charge_uAms / 3600000000ULL); // uA*ms -> mAh
+    analysisReport.wakeupCount = totals.wakeupCount;
+    analysisReport.anomalyCount = anomalyDetector.getTotalEvents();
+    analysisReport.mostCommonAnomaly = anomalyDetector.getMostCommonAnomaly();
     
     // Estimate battery life with 70Ah battery
     if (analysisReport.averageConsumption_mA > 0) {
@@ -485,13 +449,142 @@ uint32_t PowerMonitor::getSubsystemMask() const {
     return mask;
 }
 
-void PowerMonitor::logAnomaly(PowerAnomaly_t anomaly, const char* description) {
-    if (anomalyCount < 10) {
-        currentAnomalies[anomalyCount++] = anomaly;
+void PowerMonitor::logAnomaly(const AnomalyEvent_t& event) {
+    if (realTimeAlerts) {
+        std::cout << "⚠️  ANOMALY DETECTED: " << event.description 
+                  << " (Type: " << static_cast<int>(event.type) << ")" << std::endl;
+    }
+}
+
+//=============================================================================
+// WakeupAnalyzer Implementation
+//=============================================================================
+
+WakeupAnalyzer::WakeupAnalyzer() :
+    powerManager(nullptr),
+    eventIndex(0),
+    eventCount(0)
+{
+    memset(wakeupEvents, 0, sizeof(wakeupEvents));
+    memset(transitionStats, 0, sizeof(transitionStats));
+    memset(lastTransition, 0, sizeof(lastTransition));
+    memset(transitionCount, 0, sizeof(transitionCount));
+}
+
+bool WakeupAnalyzer::initialize(PowerManager* pm) {
+    powerManager = pm;
+    return powerManager != nullptr;
+}
+
+void WakeupAnalyzer::recordWakeupEvent(WakeupSource_t source, uint32_t sleepDuration_ms) {
+    WakeupEvent& event = wakeupEvents[eventIndex];
+    event.timestamp_ms = InfotainmentSystem::getTime_ms();
+    event.source = source;
+    event.sleepDuration_ms = sleepDuration_ms;
+    event.validWakeup = (source != WAKEUP_NONE);
+    
+    eventIndex = (eventIndex + 1) % MAX_WAKEUP_EVENTS;
+    if (eventCount < MAX_WAKEUP_EVENTS) eventCount++;
+}
+
+void WakeupAnalyzer::recordTransition(const PowerTransitionRecord_t& record) {
+    PowerTransitionKind_t kind = record.kind;
+    if (kind >= TRANSITION_KIND_COUNT) return;
+    
+    for (uint32_t i = 0; i < record.participantCount && i < MAX_TRANSITION_PARTICIPANTS; i++) {
+        if (record.skippedMask & (1u << i)) continue;    // Stayed in low power
+        TransitionStats& stat = transitionStats[kind][i];
+        uint32_t duration = record.timing[i].duration_us;
+        stat.count++;
+        stat.lastDuration_us = duration;
+        if (duration > stat.maxDuration_us) stat.maxDuration_us = duration;
+        stat.totalDuration_us += duration;
+    }
+    lastTransition[kind] = record;
+    transitionCount[kind]++;
+}
+
+void WakeupAnalyzer::analyzeWakeupPattern() {
+    if (!powerManager) return;
+    
+    const PowerTransitionEngine& engine = powerManager->getTransitionEngine();
+    for (int k = 0; k < TRANSITION_KIND_COUNT; k++) {
+        const PowerTransitionRecord_t& record =
+            engine.getLastTransition(static_cast<PowerTransitionKind_t>(k));
+        if (record.sequence != 0 && record.sequence != lastTransition[k].sequence) {
+            recordTransition(record);
+        }
+    }
+}
+
+uint32_t WakeupAnalyzer::getWakeupFrequency() const {
+    // Wake-ups per hour over the span of recorded events
+    if (eventCount < 2) return eventCount;
+    
+    uint32_t newest = (eventIndex + MAX_WAKEUP_EVENTS - 1) % MAX_WAKEUP_EVENTS;
+    uint32_t oldest = (eventIndex + MAX_WAKEUP_EVENTS - eventCount) % MAX_WAKEUP_EVENTS;
+    uint32_t span_ms = wakeupEvents[newest].timestamp_ms - wakeupEvents[oldest].timestamp_ms;
+    if (span_ms == 0) return eventCount;
+    
+    return static_cast<uint32_t>(static_cast<uint64_t>(eventCount - 1) * 3600000 / span_ms);
+}
+
+WakeupSource_t WakeupAnalyzer::getMostCommonWakeupSource() const {
+    static const WakeupSource_t sources[] = {
+        WAKEUP_CAN_NETWORK, WAKEUP_IGNITION, WAKEUP_USER_INPUT, WAKEUP_TIMER,
+        WAKEUP_BLUETOOTH, WAKEUP_WIFI, WAKEUP_USB, WAKEUP_EMERGENCY
+    };
+    
+    WakeupSource_t best = WAKEUP_NONE;
+    uint32_t bestCount = 0;
+    for (uint32_t s = 0; s < sizeof(sources) / sizeof(sources[0]); s++) {
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < eventCount; i++) {
+            if (wakeupEvents[i].source == sources[s]) count++;
+        }
+        if (count > bestCount) {
+            best = sources[s];
+            bestCount = count;
+        }
+    }
+    return best;
+}
+
+void WakeupAnalyzer::printWakeupAnalysis() {
+    analyzeWakeupPattern();
+    
+    std::cout << "\n=== WAKE-UP ANALYSIS ===" << std::endl;
+    std::cout << "Wake-up Events: " << eventCount << std::endl;
+    if (eventCount > 0) {
+        std::cout << "Most Common Source: 0x" << std::hex
+                  << static_cast<int>(getMostCommonWakeupSource()) << std::dec << std::endl;
+    }
+    
+    static const char* kindNames[TRANSITION_KIND_COUNT] = { "Suspend", "Resume" };
+    std::streamsize oldPrecision = std::cout.precision();
+    for (int k = 0; k < TRANSITION_KIND_COUNT; k++) {
+        const PowerTransitionRecord_t& record = lastTransition[k];
+        if (transitionCount[k] == 0) continue;
         
-        if (realTimeAlerts) {
-            std::cout << "⚠️  ANOMALY DETECTED: " << description 
-                      << " (Type: " << static_cast<int>(anomaly) << ")" << std::endl;
+        std::cout << "\n" << kindNames[k] << " (" << transitionCount[k] << " recorded): last "
+                  << record.total_us / 1000 << " ms, one-by-one "
+                  << record.serial_us / 1000 << " ms" << std::endl;
+        std::cout << "  " << std::left << std::setw(14) << "Subsystem" << std::right
+                  << std::setw(10) << "Start ms" << std::setw(10) << "Last ms"
+                  << std::setw(10) << "Avg ms" << std::setw(10) << "Max ms" << std::endl;
+        for (uint32_t i = 0; i < record.participantCount; i++) {
+            const TransitionStats& stat = transitionStats[k][i];
+            const char* name = record.timing[i].name ? record.timing[i].name : "?";
+            uint32_t avg_us = stat.count ? static_cast<uint32_t>(stat.totalDuration_us / stat.count) : 0;
+            std::cout << "  " << std::left << std::setw(14) << name << std::right << std::fixed
+                      << std::setprecision(1)
+                      << std::setw(10) << record.timing[i].start_us / 1000.0
+                      << std::setw(10) << stat.lastDuration_us / 1000.0
+                      << std::setw(10) << avg_us / 1000.0
+                      << std::setw(10) << stat.maxDuration_us / 1000.0
+                      << ((record.skippedMask & (1u << i)) ? "  (kept in low power)" : "") << std::endl;
         }
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout.precision(oldPrecision);
     }
-}
\ No newline at end of file
+}
@@ -13,17 +13,9 @@
 #include <stdbool.h>
 #include "../PowerManager/PowerManager.h"
 #include "../InfotainmentSystem/InfotainmentSystem.h"
-
-/**
- * @brief Power measurement data point
- */
-typedef struct {
-    uint32_t timestamp_ms;
-    uint32_t consumption_uA;
-    uint32_t batteryVoltage_mV;
-    PowerState_t powerState;
-    uint32_t subsystemMask;        /**< Bitmask of active subsystems */
-} PowerMeasurement_t;
+#include "MeasurementStore.h"
+#include "MeasurementExporter.h"
+#include "AnomalyDetector.h"
 
 /**
  * @brief Power consumption thresholds
@@ -35,33 +27,6 @@ typedef enum {
     THRESHOLD_CRITICAL = 5000000   /**< 5A - Critical consumption */
 } PowerThreshold_t;
 
-/**
- * @brief Subsystem activity flags
- */
-typedef enum {
-    SUBSYSTEM_AUDIO = 0x01,
-    SUBSYSTEM_DISPLAY = 0x02,
-    SUBSYSTEM_BLUETOOTH = 0x04,
-    SUBSYSTEM_WIFI = 0x08,
-    SUBSYSTEM_GPS = 0x10,
-    SUBSYSTEM_MAINTENANCE = 0x20,
-    SUBSYSTEM_DIAGNOSTICS = 0x40,
-    SUBSYSTEM_UPDATES = 0x80
-} SubsystemFlags_t;
-
-/**
- * @brief Power anomaly types
- */
-typedef enum {
-    ANOMALY_NONE = 0,
-    ANOMALY_EXCESSIVE_CONSUMPTION,
-    ANOMALY_FAILED_SLEEP_ENTRY,
-    ANOMALY_FREQUENT_WAKEUPS,
-    ANOMALY_STUCK_SUBSYSTEM,
-    ANOMALY_BATTERY_VOLTAGE_DROP,
-    ANOMALY_THERMAL_ISSUE
-} PowerAnomaly_t;
-
 /**
  * @brief Power analysis report
  */
@@ -85,16 +50,15 @@ private:
     PowerManager* powerManager;
     InfotainmentSystem* infotainmentSystem;
     
-    // Measurement storage
-    static const uint32_t MAX_MEASUREMENTS = 10000;
-    PowerMeasurement_t measurements[MAX_MEASUREMENTS];
-    uint32_t measurementIndex;
-    uint32_t measurementCount;
+    // Measurement storage (raw ring, downsampled tiers, running totals)
+    MeasurementStore measurementStore;
+    
+    // Background export of new measurements
+    MeasurementExporter exporter;
     
     // Analysis data
     PowerAnalysisReport_t analysisReport;
-    PowerAnomaly_t currentAnomalies[10];
-    uint32_t anomalyCount;
+    AnomalyDetector anomalyDetector;   /**< Runs once per new measurement */
     
     // Configuration
     uint32_t measurementInterval_ms;
@@ -112,7 +76,7 @@ private:
     void detectAnomalies(const PowerMeasurement_t& measurement);
     void updateAnalysisReport();
     uint32_t getSubsystemMask() const;
-    void logAnomaly(PowerAnomaly_t anomaly, const char* description);
+    void logAnomaly(const AnomalyEvent_t& event);
 
 public:
     /**
@@ -151,18 +115,22 @@ public:
     
     /**
      * @brief Take single power measurement
+     * @details Stores it, runs the anomaly detector on it and hands it to the
+     *          background export
      * @return Measurement data
      */
     PowerMeasurement_t takeMeasurement();
     
     /**
      * @brief Generate comprehensive power analysis report
+     * @details Built from running totals, so the cost does not grow with the log
      * @return Analysis report
      */
     PowerAnalysisReport_t generateReport();
     
     /**
-     * @brief Detect and analyze power anomalies
+     * @brief Print the anomalies detected so far
+     * @details Detection itself runs incrementally in takeMeasurement()
      */
     void analyzeAnomalies();
     
@@ -208,6 +176,33 @@ public:
      */
     bool exportToCSV(const char* filename);
     
+    /**
+     * @brief Start streaming measurements to files in the background
+     * @details The retained raw history is written first, then every new
+     *          measurement; monitoringTask() keeps sampling meanwhile
+     * @param path Output file, rotated files get ".1", ".2", ... appended
+     * @param format Binary (delta-encoded) or CSV
+     * @param maxFileBytes Rotate before a file exceeds this size, 0 = never
+     * @return true if the export started
+     */
+    bool startExport(const char* path, ExportFormat_t format = EXPORT_FORMAT_BINARY,
+                     uint32_t maxFileBytes = 0);
+    
+    /**
+     * @brief Finish the background export and close its file
+     */
+    void stopExport();
+    
+    /**
+     * @brief Check if a background export is running
+     */
+    bool isExporting() const { return exporter.isRunning(); }
+    
+    /**
+     * @brief Background export counters
+     */
+    ExportStats_t getExportStats() const { return exporter.getStats(); }
+    
     /**
      * @brief Configure anomaly detection thresholds
      */
@@ -223,6 +218,16 @@ public:
      * @brief Clear measurement history
      */
     void clearMeasurements();
+    
+    /**
+     * @brief Access the measurement history (raw samples and tiers)
+     */
+    const MeasurementStore& getMeasurementStore() const { return measurementStore; }
+    
+    /**
+     * @brief Access the detected anomalies and per-state statistics
+     */
+    const AnomalyDetector& getAnomalyDetector() const { return anomalyDetector; }
 };
 
 /**
@@ -273,12 +278,35 @@ private:
     WakeupEvent wakeupEvents[MAX_WAKEUP_EVENTS];
     uint32_t eventIndex;
     uint32_t eventCount;
+    
+    /**
+     * @brief Per-subsystem suspend/resume timings over all recorded transitions
+     */
+    struct TransitionStats {
+        uint32_t count;
+        uint32_t lastDuration_us;
+        uint32_t maxDuration_us;
+        uint64_t totalDuration_us;
+    };
+    
+    TransitionStats transitionStats[TRANSITION_KIND_COUNT][MAX_TRANSITION_PARTICIPANTS];
+    PowerTransitionRecord_t lastTransition[TRANSITION_KIND_COUNT];
+    uint32_t transitionCount[TRANSITION_KIND_COUNT];
 
 public:
     WakeupAnalyzer();
     
     bool initialize(PowerManager* pm);
     void recordWakeupEvent(WakeupSource_t source, uint32_t sleepDuration_ms);
+    
+    /**
+     * @brief Add the per-subsystem timings of one suspend or resume
+     */
+    void recordTransition(const PowerTransitionRecord_t& record);
+    
+    /**
+     * @brief Pick up transitions the power manager ran since the last call
+     */
     void analyzeWakeupPattern();
     void printWakeupAnalysis();
     uint32_t getWakeupFrequency() const;
@@ -8,11 +8,36 @@
 
 #include "InfotainmentSystem.h"
 #include <cstring>
-#include <ctime>
+#include <chrono>
+#include <thread>
 
-// Simulate system time
+// Monotonic system time; deadlines need wall time, not CPU time
 static uint32_t getSystemTime_ms() {
-    return static_cast<uint32_t>(clock() * 1000 / CLOCKS_PER_SEC);
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+// Hardware settle times on resume (codec PLL lock, panel power sequencing,
+// radio firmware boot, GNSS hand-over)
+static const uint32_t AUDIO_RESUME_SETTLE_MS = 20;
+static const uint32_t DISPLAY_RESUME_SETTLE_MS = 40;
+static const uint32_t BLUETOOTH_RESUME_SETTLE_MS = 60;
+static const uint32_t WIFI_RESUME_SETTLE_MS = 80;
+static const uint32_t NAVIGATION_RESUME_SETTLE_MS = 30;
+
+// Set by a simulation to model the settle times; resume never blocks otherwise
+static InfotainmentSystem::SettleHook settleHook = nullptr;
+
+static void waitForHardwareSettle(uint32_t settle_ms) {
+    if (settleHook) {
+        settleHook(settle_ms);
+    }
+}
+
+// Deadline of a subsystem whose feature keeps hardware busy
+static uint32_t busyDeadline(uint32_t lastUpdate_ms) {
+    return lastUpdate_ms + SUBSYSTEM_BUSY_PERIOD_MS;
 }
 
 // Simulate hardware register access
@@ -38,7 +63,9 @@ AudioSubsystem::AudioSubsystem() :
     surroundSoundActive(false),
     dspAlwaysOn(false),
     backgroundAudioProc(false),
-    continuousDecoding(false)
+    continuousDecoding(false),
+    updatePending(true),
+    lastUpdate_ms(0)
 {
 }
 
@@ -52,10 +79,14 @@ bool AudioSubsystem::initialize() {
     writeHardwareRegister(0x60000004, volume);      // Set initial volume
     
     currentState = AUDIO_STANDBY;
+    updatePending = true;
     return true;
 }
 
 void AudioSubsystem::update() {
+    lastUpdate_ms = getSystemTime_ms();
+    updatePending = false;
+    
     // BATTERY DRAIN BUG #1: DSP Always On
     if (dspAlwaysOn) {
         // BUG: DSP remains active even when no audio is playing
@@ -95,6 +126,7 @@ void AudioSubsystem::enterLowPowerMode() {
     dspAlwaysOn = false;         // CRITICAL: Turn off DSP
     backgroundAudioProc = false;  // CRITICAL: Stop background processing
     continuousDecoding = false;   // CRITICAL: Stop continuous decoding
+    updatePending = true;
     
     writeHardwareRegister(0x60000000, 0x00000000); // Disable audio controller
 }
@@ -102,6 +134,7 @@ void AudioSubsystem::enterLowPowerMode() {
 void AudioSubsystem::exitLowPowerMode() {
     // Restore audio subsystem from sleep
     initialize();
+    waitForHardwareSettle(AUDIO_RESUME_SETTLE_MS);
     currentState = AUDIO_STANDBY;
 }
 
@@ -131,6 +164,20 @@ uint32_t AudioSubsystem::getCurrentConsumption() const {
     return consumption;
 }
 
+uint32_t AudioSubsystem::getNextDeadline_ms() const {
+    if (updatePending) return 0;
+    
+    // Hardware kept busy by one of the features is refreshed periodically;
+    // otherwise the audio registers only change on an event
+    if (dspAlwaysOn ||
+        (backgroundAudioProc && currentState == AUDIO_OFF) ||
+        (continuousDecoding && currentSource != MEDIA_SOURCE_NONE) ||
+        currentState == AUDIO_PLAYING) {
+        return busyDeadline(lastUpdate_ms);
+    }
+    return SUBSYSTEM_WAKE_NEVER;
+}
+
 void AudioSubsystem::shutdown() {
     // Shutdown audio hardware and DSP
     writeHardwareRegister(0x100, 0x0); // Power down audio controller
@@ -140,6 +187,7 @@ void AudioSubsystem::shutdown() {
     dspAlwaysOn = false;
     backgroundAudioProc = false;
     continuousDecoding = false;
+    updatePending = true;
 }
 
 //=============================================================================
@@ -154,7 +202,9 @@ DisplaySubsystem::DisplaySubsystem() :
     backlightTimeout(30000), // 30 seconds
     alwaysOn(false),
     animationsRunning(false),
-    backgroundRendering(false)
+    backgroundRendering(false),
+    updatePending(true),
+    lastUpdate_ms(0)
 {
 }
 
@@ -169,12 +219,15 @@ bool DisplaySubsystem::initialize() {
     currentState = DISPLAY_ON;
     backlightOn = true;
     lastUserInteraction = getSystemTime_ms();
+    updatePending = true;
     
     return true;
 }
 
 void DisplaySubsystem::update() {
     uint32_t currentTime = getSystemTime_ms();
+    lastUpdate_ms = currentTime;
+    updatePending = false;
     
     // BATTERY DRAIN BUG #4: Always On Display
     if (alwaysOn) {
@@ -220,6 +273,7 @@ void DisplaySubsystem::enterLowPowerMode() {
     alwaysOn = false;            // CRITICAL: Ensure display can turn off
     animationsRunning = false;   // CRITICAL: Stop animations
     backgroundRendering = false; // CRITICAL: Stop background rendering
+    updatePending = true;
     
     writeHardwareRegister(0x70000000, 0x00000000); // Disable display controller
 }
@@ -250,11 +304,27 @@ uint32_t DisplaySubsystem::getCurrentConsumption() const {
     return consumption;
 }
 
+uint32_t DisplaySubsystem::getNextDeadline_ms() const {
+    if (updatePending) return 0;
+    
+    if (alwaysOn || animationsRunning ||
+        (backgroundRendering && currentState == DISPLAY_OFF)) {
+        return busyDeadline(lastUpdate_ms);
+    }
+    // Next event is the backlight timeout (update() checks it with '>')
+    if (currentState != DISPLAY_OFF) {
+        return lastUserInteraction + backlightTimeout + 1;
+    }
+    return SUBSYSTEM_WAKE_NEVER;
+}
+
 void DisplaySubsystem::exitLowPowerMode() {
     if (currentState == DISPLAY_OFF) {
         currentState = DISPLAY_DIMMED;
         writeHardwareRegister(0x200, 0x1); // Power on display
+        waitForHardwareSettle(DISPLAY_RESUME_SETTLE_MS);
     }
+    updatePending = true;
 }
 
 void DisplaySubsystem::shutdown() {
@@ -262,6 +332,7 @@ void DisplaySubsystem::shutdown() {
     alwaysOn = false;
     animationsRunning = false;
     backgroundRendering = false;
+    updatePending = true;
     writeHardwareRegister(0x200, 0x0); // Power down display
     writeHardwareRegister(0x204, 0x0); // Disable GPU
 }
@@ -278,7 +349,9 @@ BluetoothSubsystem::BluetoothSubsystem() :
     scanInterval(30000), // 30 seconds
     continuousScanning(false),
     highPowerMode(false),
-    backgroundSync(false)
+    backgroundSync(false),
+    updatePending(true),
+    lastUpdate_ms(0)
 {
 }
 
@@ -289,11 +362,14 @@ BluetoothSubsystem::~BluetoothSubsystem() {
 bool BluetoothSubsystem::initialize() {
     writeHardwareRegister(0x80000000, 0x00000001); // Enable BT controller
     currentState = CONN_SCANNING;
+    updatePending = true;
     return true;
 }
 
 void BluetoothSubsystem::update() {
     uint32_t currentTime = getSystemTime_ms();
+    lastUpdate_ms = currentTime;
+    updatePending = false;
     
     // BATTERY DRAIN BUG #7: Continuous Scanning
     if (continuousScanning) {
@@ -338,6 +414,7 @@ void BluetoothSubsystem::enterLowPowerMode() {
     continuousScanning = false;  // CRITICAL: Stop continuous scanning
     highPowerMode = false;       // CRITICAL: Use low power mode
     backgroundSync = false;      // CRITICAL: Stop background sync
+    updatePending = true;
     
     writeHardwareRegister(0x80000000, 0x00000000); // Disable BT controller
 }
@@ -368,10 +445,27 @@ uint32_t BluetoothSubsystem::getCurrentConsumption() const {
     return consumption;
 }
 
+uint32_t BluetoothSubsystem::getNextDeadline_ms() const {
+    if (updatePending) return 0;
+    
+    if (continuousScanning || highPowerMode ||
+        (backgroundSync && currentState != CONN_ACTIVE)) {
+        return busyDeadline(lastUpdate_ms);
+    }
+    // Next event is the end of the scan window or the next periodic scan
+    if (scanning) {
+        return lastScanTime + 10000 + 1;
+    }
+    return lastScanTime + scanInterval + 1;
+}
+
 void BluetoothSubsystem::exitLowPowerMode() {
     if (currentState == CONN_DISABLED) {
+        writeHardwareRegister(0x80000000, 0x00000001); // Enable BT controller
+        waitForHardwareSettle(BLUETOOTH_RESUME_SETTLE_MS);
         currentState = CONN_SCANNING;
     }
+    updatePending = true;
 }
 
 void BluetoothSubsystem::shutdown() {
@@ -381,6 +475,7 @@ void BluetoothSubsystem::shutdown() {
     continuousScanning = false;
     highPowerMode = false;
     backgroundSync = false;
+    updatePending = true;
 }
 
 //=============================================================================
@@ -395,11 +490,16 @@ WiFiSubsystem::WiFiSubsystem() :
     scanInterval(60000), // 60 seconds
     continuousScanning(false),
     hotspotAlwaysOn(false),
-    backgroundUpdates(false)
+    backgroundUpdates(false),
+    updatePending(true),
+    lastUpdate_ms(0)
 {
 }
 
 void WiFiSubsystem::update() {
+    lastUpdate_ms = getSystemTime_ms();
+    updatePending = false;
+    
     // BATTERY DRAIN BUG #10: Continuous WiFi Scanning
     if (continuousScanning) {
         // BUG: WiFi never stops scanning for networks
@@ -431,6 +531,7 @@ void WiFiSubsystem::enterLowPowerMode() {
     continuousScanning = false;  // CRITICAL: Stop continuous scanning
     hotspotAlwaysOn = false;     // CRITICAL: Turn off hotspot
     backgroundUpdates = false;   // CRITICAL: Stop background updates
+    updatePending = true;
     
     writeHardwareRegister(0x90000000, 0x00000000); // Disable WiFi
 }
@@ -461,19 +562,32 @@ uint32_t WiFiSubsystem::getCurrentConsumption() const {
     return consumption;
 }
 
+uint32_t WiFiSubsystem::getNextDeadline_ms() const {
+    if (updatePending) return 0;
+    
+    if (continuousScanning || hotspotAlwaysOn || backgroundUpdates) {
+        return busyDeadline(lastUpdate_ms);
+    }
+    return SUBSYSTEM_WAKE_NEVER;
+}
+
 bool WiFiSubsystem::initialize() {
     currentState = CONN_DISABLED;
     scanning = false;
     continuousScanning = false;
     hotspotAlwaysOn = false;
     backgroundUpdates = false;
+    updatePending = true;
     return true;
 }
 
 void WiFiSubsystem::exitLowPowerMode() {
     if (currentState == CONN_DISABLED) {
+        writeHardwareRegister(0x90000000, 0x00000001); // Enable WiFi
+        waitForHardwareSettle(WIFI_RESUME_SETTLE_MS);
         currentState = CONN_SCANNING;
     }
+    updatePending = true;
 }
 
 void WiFiSubsystem::shutdown() {
@@ -482,6 +596,7 @@ void WiFiSubsystem::shutdown() {
     continuousScanning = false;
     hotspotAlwaysOn = false;
     backgroundUpdates = false;
+    updatePending = true;
 }
 
 //=============================================================================
@@ -495,11 +610,16 @@ NavigationSubsystem::NavigationSubsystem() :
     updateInterval(1000), // 1 second
     alwaysTracking(false),
     backgroundLogging(false),
-    highAccuracyMode(false)
+    highAccuracyMode(false),
+    updatePending(true),
+    lastUpdate_ms(0)
 {
 }
 
 void NavigationSubsystem::update() {
+    lastUpdate_ms = getSystemTime_ms();
+    updatePending = false;
+    
     // BATTERY DRAIN BUG #13: GPS Always Tracking
     if (alwaysTracking) {
         // BUG: GPS remains active even when navigation not in use
@@ -529,6 +649,7 @@ void NavigationSubsystem::enterLowPowerMode() {
     alwaysTracking = false;      // CRITICAL: Stop GPS tracking
     backgroundLogging = false;   // CRITICAL: Stop background logging
     highAccuracyMode = false;    // CRITICAL: Use low power GPS mode
+    updatePending = true;
     
     writeHardwareRegister(0xA0000000, 0x00000000); // Disable GPS
 }
@@ -550,6 +671,15 @@ uint32_t NavigationSubsystem::getCurrentConsumption() const {
     return consumption;
 }
 
+uint32_t NavigationSubsystem::getNextDeadline_ms() const {
+    if (updatePending) return 0;
+    
+    if (alwaysTracking || (backgroundLogging && !navigationActive) || highAccuracyMode) {
+        return busyDeadline(lastUpdate_ms);
+    }
+    return SUBSYSTEM_WAKE_NEVER;
+}
+
 bool NavigationSubsystem::initialize() {
     gpsActive = false;
     navigationActive = false;
@@ -558,14 +688,17 @@ bool NavigationSubsystem::initialize() {
     alwaysTracking = false;
     backgroundLogging = false;
     highAccuracyMode = false;
+    updatePending = true;
     return true;
 }
 
 void NavigationSubsystem::exitLowPowerMode() {
     // Wake up GPS if needed
     if (navigationActive) {
+        waitForHardwareSettle(NAVIGATION_RESUME_SETTLE_MS);
         gpsActive = true;
     }
+    updatePending = true;
 }
 
 //=============================================================================
@@ -583,7 +716,11 @@ InfotainmentSystem::InfotainmentSystem() :
     lastMaintenanceTask(0),
     maintenanceTaskActive(false),
     diagnosticsRunning(false),
-    updateInProgress(false)
+    updateInProgress(false),
+    updatePending(true),
+    lastSystemTask_ms(0),
+    wakeupCount(0),
+    updateCount(0)
 {
 }
 
@@ -610,8 +747,11 @@ bool InfotainmentSystem::initialize(PowerManager* pm) {
         return false;
     }
     
+    registerTransitions();
+    
     systemInitialized = true;
     lastMaintenanceTask = getSystemTime_ms();
+    updatePending = true;
     
     return true;
 }
@@ -620,39 +760,51 @@ void InfotainmentSystem::mainTask() {
     if (!systemInitialized) return;
     
     uint32_t currentTime = getSystemTime_ms();
-    
-    // Update all subsystems
-    audioSystem->update();
-    displaySystem->update();
-    bluetoothSystem->update(); 
-    wifiSystem->update();
-    navigationSystem->update();
-    
-    // BATTERY DRAIN BUG #16: Maintenance Task Always Running
-    if (maintenanceTaskActive) {
-        // BUG: Maintenance task runs continuously even during sleep
-        // This consumes ~20mA continuously
-        runMaintenanceTask();
-    } else {
-        // PROPER: Run maintenance periodically
-        if ((currentTime - lastMaintenanceTask) > 300000) { // Every 5 minutes
+    uint32_t updates = 0;
+    
+    // Update only the subsystems whose deadline has passed
+    if (audioSystem->getNextDeadline_ms() <= currentTime) { audioSystem->update(); updates++; }
+    if (displaySystem->getNextDeadline_ms() <= currentTime) { displaySystem->update(); updates++; }
+    if (bluetoothSystem->getNextDeadline_ms() <= currentTime) { bluetoothSystem->update(); updates++; }
+    if (wifiSystem->getNextDeadline_ms() <= currentTime) { wifiSystem->update(); updates++; }
+    if (navigationSystem->getNextDeadline_ms() <= currentTime) { navigationSystem->update(); updates++; }
+    
+    if (getSystemDeadline_ms() <= currentTime) {
+        lastSystemTask_ms = currentTime;
+        updatePending = false;
+        updates++;
+        
+        // BATTERY DRAIN BUG #16: Maintenance Task Always Running
+        if (maintenanceTaskActive) {
+            // BUG: Maintenance task runs continuously even during sleep
+            // This consumes ~20mA continuously
             runMaintenanceTask();
-            lastMaintenanceTask = currentTime;
+        } else {
+            // PROPER: Run maintenance periodically
+            if ((currentTime - lastMaintenanceTask) > 300000) { // Every 5 minutes
+                runMaintenanceTask();
+                lastMaintenanceTask = currentTime;
+            }
+        }
+        
+        // BATTERY DRAIN BUG #17: Diagnostics Always Running
+        if (diagnosticsRunning) {
+            // BUG: Diagnostic routines run continuously
+            // This consumes ~15mA continuously
+            runDiagnostics();
+        }
+        
+        // BATTERY DRAIN BUG #18: Update Process Stuck
+        if (updateInProgress) {
+            // BUG: Update process doesn't complete, system stays active
+            // This prevents sleep mode entry
+            powerManager->setBackgroundTaskActive(true); // Prevents sleep
         }
     }
     
-    // BATTERY DRAIN BUG #17: Diagnostics Always Running
-    if (diagnosticsRunning) {
-        // BUG: Diagnostic routines run continuously
-        // This consumes ~15mA continuously
-        runDiagnostics();
-    }
-    
-    // BATTERY DRAIN BUG #18: Update Process Stuck
-    if (updateInProgress) {
-        // BUG: Update process doesn't complete, system stays active
-        // This prevents sleep mode entry
-        powerManager->setBackgroundTaskActive(true); // Prevents sleep
+    if (updates > 0) {
+        wakeupCount++;
+        updateCount += updates;
     }
     
     // Communicate power consumption to power manager
@@ -671,31 +823,107 @@ void InfotainmentSystem::mainTask() {
     powerManager->setBackgroundTaskActive(maintenanceTaskActive || updateInProgress);
 }
 
-void InfotainmentSystem::enterLowPowerMode() {
-    if (!systemInitialized) return;
-    
-    // Properly shutdown all subsystems for sleep
-    audioSystem->enterLowPowerMode();
-    displaySystem->enterLowPowerMode();
-    bluetoothSystem->enterLowPowerMode();
-    wifiSystem->enterLowPowerMode();
-    navigationSystem->enterLowPowerMode();
-    
+void InfotainmentSystem::registerTransitions() {
+    PowerTransitionEngine& engine = powerManager->getTransitionEngine();
+    engine.clearParticipants();
+    
+    // Dependencies are registered first; ids are bit positions.
+    // Resume conditions keep a CAN/timer/ignition-off wake minimal.
+    PowerManager* pm = powerManager;
+    int wifi = engine.addParticipant("WiFi", 0,
+        [this]() { wifiSystem->enterLowPowerMode(); },
+        [this]() { wifiSystem->exitLowPowerMode(); },
+        [pm]() { return pm->shouldRestoreWifi(); });
+    int bluetooth = engine.addParticipant("Bluetooth", 0,
+        [this]() { bluetoothSystem->enterLowPowerMode(); },
+        [this]() { bluetoothSystem->exitLowPowerMode(); },
+        [pm]() { return pm->shouldRestoreBluetooth(); });
+    engine.addParticipant("Display", 0,
+        [this]() { displaySystem->enterLowPowerMode(); },
+        [this]() { displaySystem->exitLowPowerMode(); },
+        [pm]() { return pm->shouldRestoreUserFunctions(); });
+    engine.addParticipant("Audio", 1u << bluetooth,          // A2DP source
+        [this]() { audioSystem->enterLowPowerMode(); },
+        [this]() { audioSystem->exitLowPowerMode(); },
+        [pm]() { return pm->shouldRestoreUserFunctions(); });
+    engine.addParticipant("Navigation", 1u << wifi,          // Assisted GPS
+        [this]() { navigationSystem->enterLowPowerMode(); },
+        [this]() { navigationSystem->exitLowPowerMode(); },
+        [pm]() { return pm->shouldRestoreUserFunctions(); });
+    engine.addParticipant("System Tasks", 0,
+        [this]() { suspendSystemTasks(); },
+        [this]() { updatePending = true; });
+}
+
+void InfotainmentSystem::suspendSystemTasks() {
     // Stop problematic background tasks
     maintenanceTaskActive = false;  // CRITICAL: Stop maintenance
     diagnosticsRunning = false;     // CRITICAL: Stop diagnostics
     updateInProgress = false;       // CRITICAL: Complete/abort updates
+    updatePending = true;
+}
+
+void InfotainmentSystem::enterLowPowerMode() {
+    if (!systemInitialized) return;
+    
+    // Properly shutdown all subsystems for sleep
+    powerManager->getTransitionEngine().suspendAll();
 }
 
 void InfotainmentSystem::exitLowPowerMode() {
     if (!systemInitialized) return;
     
     // Restore subsystems from sleep
-    audioSystem->exitLowPowerMode();
-    displaySystem->exitLowPowerMode();
-    bluetoothSystem->exitLowPowerMode();
-    wifiSystem->exitLowPowerMode();
-    navigationSystem->exitLowPowerMode();
+    powerManager->getTransitionEngine().resumeAll();
+}
+
+uint32_t InfotainmentSystem::getSystemDeadline_ms() const {
+    if (updatePending) return 0;
+    
+    if (maintenanceTaskActive || diagnosticsRunning || updateInProgress) {
+        return busyDeadline(lastSystemTask_ms);
+    }
+    return lastMaintenanceTask + 300000 + 1;
+}
+
+uint32_t InfotainmentSystem::getNextDeadline_ms() const {
+    if (!systemInitialized) return SUBSYSTEM_WAKE_NEVER;
+    
+    uint32_t next = getSystemDeadline_ms();
+    uint32_t deadline;
+    
+    deadline = audioSystem->getNextDeadline_ms();
+    if (deadline < next) next = deadline;
+    deadline = displaySystem->getNextDeadline_ms();
+    if (deadline < next) next = deadline;
+    deadline = bluetoothSystem->getNextDeadline_ms();
+    if (deadline < next) next = deadline;
+    deadline = wifiSystem->getNextDeadline_ms();
+    if (deadline < next) next = deadline;
+    deadline = navigationSystem->getNextDeadline_ms();
+    if (deadline < next) next = deadline;
+    
+    return next;
+}
+
+uint32_t InfotainmentSystem::waitForNextDeadline(uint32_t maxWait_ms) const {
+    uint32_t now = getSystemTime_ms();
+    uint32_t next = getNextDeadline_ms();
+    uint32_t wait = (next > now) ? next - now : 0;
+    if (wait > maxWait_ms) wait = maxWait_ms;
+    
+    if (wait > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(wait));
+    }
+    return wait;
+}
+
+uint32_t InfotainmentSystem::getTime_ms() {
+    return getSystemTime_ms();
+}
+
+void InfotainmentSystem::setSettleHook(SettleHook hook) {
+    settleHook = hook;
 }
 
 uint32_t InfotainmentSystem::getTotalPowerConsumption() const {
@@ -737,6 +965,7 @@ void InfotainmentSystem::shutdown() {
     if (displaySystem) displaySystem->shutdown();
     if (bluetoothSystem) bluetoothSystem->shutdown();
     if (wifiSystem) wifiSystem->shutdown();
+    if (powerManager) powerManager->getTransitionEngine().clearParticipants();
     
     systemInitialized = false;
 }
\ No newline at end of file
@@ -54,6 +54,16 @@ typedef enum {
     MEDIA_SOURCE_STREAMING = 4
 } MediaSource_t;
 
+/**
+ * @brief Subsystem scheduling
+ * @details Each subsystem reports the absolute time (ms) at which its next
+ *          update() is required. Setters and power-mode changes request an
+ *          update at the next mainTask() (the subsystem's event); beyond that
+ *          an idle subsystem is not woken at all.
+ */
+static const uint32_t SUBSYSTEM_WAKE_NEVER = UINT32_MAX;
+static const uint32_t SUBSYSTEM_BUSY_PERIOD_MS = 100;   /**< Update period while a feature keeps hardware busy */
+
 /**
  * @brief Audio subsystem class
  */
@@ -71,6 +81,10 @@ private:
     bool backgroundAudioProc;   /**< Background audio processing */
     bool continuousDecoding;    /**< Continuous media decoding */
 
+    // Scheduling
+    bool updatePending;         /**< Event received, update at next mainTask */
+    uint32_t lastUpdate_ms;
+
 public:
     AudioSubsystem();
     ~AudioSubsystem();
@@ -90,15 +104,19 @@ public:
     void exitLowPowerMode();
     uint32_t getCurrentConsumption() const;
     
+    // Scheduling
+    uint32_t getNextDeadline_ms() const;
+    void requestUpdate() { updatePending = true; }
+    
     // Getters
     AudioState_t getState() const { return currentState; }
     MediaSource_t getMediaSource() const { return currentSource; }
     uint8_t getVolume() const { return volume; }
     
     // PROBLEMATIC METHODS
-    void enableDspAlwaysOn(bool enable) { dspAlwaysOn = enable; }
-    void enableBackgroundProcessing(bool enable) { backgroundAudioProc = enable; }
-    void enableContinuousDecoding(bool enable) { continuousDecoding = enable; }
+    void enableDspAlwaysOn(bool enable) { dspAlwaysOn = enable; updatePending = true; }
+    void enableBackgroundProcessing(bool enable) { backgroundAudioProc = enable; updatePending = true; }
+    void enableContinuousDecoding(bool enable) { continuousDecoding = enable; updatePending = true; }
 };
 
 /**
@@ -117,6 +135,10 @@ private:
     bool animationsRunning;     /**< Continuous animations */
     bool backgroundRendering;   /**< Background rendering active */
 
+    // Scheduling
+    bool updatePending;         /**< Event received, update at next mainTask */
+    uint32_t lastUpdate_ms;
+
 public:
     DisplaySubsystem();
     ~DisplaySubsystem();
@@ -134,15 +156,19 @@ public:
     void exitLowPowerMode();
     uint32_t getCurrentConsumption() const;
     
+    // Scheduling
+    uint32_t getNextDeadline_ms() const;
+    void requestUpdate() { updatePending = true; }
+    
     // Getters
     DisplayState_t getState() const { return currentState; }
     uint8_t getBrightness() const { return brightness; }
     bool isBacklightOn() const { return backlightOn; }
     
     // PROBLEMATIC METHODS
-    void setAlwaysOn(bool enable) { alwaysOn = enable; }
-    void enableAnimations(bool enable) { animationsRunning = enable; }
-    void enableBackgroundRendering(bool enable) { backgroundRendering = enable; }
+    void setAlwaysOn(bool enable) { alwaysOn = enable; updatePending = true; }
+    void enableAnimations(bool enable) { animationsRunning = enable; updatePending = true; }
+    void enableBackgroundRendering(bool enable) { backgroundRendering = enable; updatePending = true; }
 };
 
 /**
@@ -161,6 +187,10 @@ private:
     bool highPowerMode;         /**< Always use high power */
     bool backgroundSync;        /**< Background synchronization */
 
+    // Scheduling
+    bool updatePending;         /**< Event received, update at next mainTask */
+    uint32_t lastUpdate_ms;
+
 public:
     BluetoothSubsystem();
     ~BluetoothSubsystem();
@@ -180,15 +210,19 @@ public:
     void exitLowPowerMode();
     uint32_t getCurrentConsumption() const;
     
+    // Scheduling
+    uint32_t getNextDeadline_ms() const;
+    void requestUpdate() { updatePending = true; }
+    
     // Getters
     ConnectivityState_t getState() const { return currentState; }
     bool isScanning() const { return scanning; }
     bool isDiscoverable() const { return discoverable; }
     
     // PROBLEMATIC METHODS
-    void enableContinuousScanning(bool enable) { continuousScanning = enable; }
-    void enableHighPowerMode(bool enable) { highPowerMode = enable; }
-    void enableBackgroundSync(bool enable) { backgroundSync = enable; }
+    void enableContinuousScanning(bool enable) { continuousScanning = enable; updatePending = true; }
+    void enableHighPowerMode(bool enable) { highPowerMode = enable; updatePending = true; }
+    void enableBackgroundSync(bool enable) { backgroundSync = enable; updatePending = true; }
 };
 
 /**
@@ -207,6 +241,10 @@ private:
     bool hotspotAlwaysOn;       /**< Hotspot always active */
     bool backgroundUpdates;     /**< Background software updates */
 
+    // Scheduling
+    bool updatePending;         /**< Event received, update at next mainTask */
+    uint32_t lastUpdate_ms;
+
 public:
     WiFiSubsystem();
     ~WiFiSubsystem();
@@ -226,15 +264,19 @@ public:
     void exitLowPowerMode();
     uint32_t getCurrentConsumption() const;
     
+    // Scheduling
+    uint32_t getNextDeadline_ms() const;
+    void requestUpdate() { updatePending = true; }
+    
     // Getters
     ConnectivityState_t getState() const { return currentState; }
     bool isScanning() const { return scanning; }
     bool isHotspotActive() const { return hotspotMode; }
     
     // PROBLEMATIC METHODS
-    void enableContinuousScanning(bool enable) { continuousScanning = enable; }
-    void enableHotspotAlwaysOn(bool enable) { hotspotAlwaysOn = enable; }
-    void enableBackgroundUpdates(bool enable) { backgroundUpdates = enable; }
+    void enableContinuousScanning(bool enable) { continuousScanning = enable; updatePending = true; }
+    void enableHotspotAlwaysOn(bool enable) { hotspotAlwaysOn = enable; updatePending = true; }
+    void enableBackgroundUpdates(bool enable) { backgroundUpdates = enable; updatePending = true; }
 };
 
 /**
@@ -252,6 +294,10 @@ private:
     bool backgroundLogging;     /**< Background location logging */
     bool highAccuracyMode;      /**< Always high accuracy mode */
 
+    // Scheduling
+    bool updatePending;         /**< Event received, update at next mainTask */
+    uint32_t lastUpdate_ms;
+
 public:
     NavigationSubsystem();
     ~NavigationSubsystem();
@@ -270,14 +316,18 @@ public:
     void exitLowPowerMode();
     uint32_t getCurrentConsumption() const;
     
+    // Scheduling
+    uint32_t getNextDeadline_ms() const;
+    void requestUpdate() { updatePending = true; }
+    
     // Getters
     bool isGpsActive() const { return gpsActive; }
     bool isNavigationActive() const { return navigationActive; }
     
     // PROBLEMATIC METHODS
-    void enableAlwaysTracking(bool enable) { alwaysTracking = enable; }
-    void enableBackgroundLogging(bool enable) { backgroundLogging = enable; }
-    void enableHighAccuracyMode(bool enable) { highAccuracyMode = enable; }
+    void enableAlwaysTracking(bool enable) { alwaysTracking = enable; updatePending = true; }
+    void enableBackgroundLogging(bool enable) { backgroundLogging = enable; updatePending = true; }
+    void enableHighAccuracyMode(bool enable) { highAccuracyMode = enable; updatePending = true; }
 };
 
 /**
@@ -299,15 +349,59 @@ private:
     bool maintenanceTaskActive;
     bool diagnosticsRunning;
     bool updateInProgress;
+    
+    // Scheduling of the system-level tasks
+    bool updatePending;
+    uint32_t lastSystemTask_ms;
+    uint32_t wakeupCount;          /**< mainTask() calls that had work */
+    uint32_t updateCount;          /**< Subsystem update() calls */
+    
+    uint32_t getSystemDeadline_ms() const;
+    
+    void registerTransitions();
+    void suspendSystemTasks();
 
 public:
     InfotainmentSystem();
     ~InfotainmentSystem();
     
     bool initialize(PowerManager* pm);
+    
+    /**
+     * @brief Run the subsystems and system tasks whose deadline has passed
+     */
     void mainTask();
     void shutdown();
     
+    /**
+     * @brief Earliest time at which mainTask() has work
+     * @return Absolute time in ms (see getTime_ms), SUBSYSTEM_WAKE_NEVER if idle
+     */
+    uint32_t getNextDeadline_ms() const;
+    
+    /**
+     * @brief Sleep until the next deadline, but at most maxWait_ms
+     * @return Milliseconds slept
+     */
+    uint32_t waitForNextDeadline(uint32_t maxWait_ms) const;
+    
+    /**
+     * @brief Monotonic time base of the deadlines, ms since start
+     */
+    static uint32_t getTime_ms();
+    
+    /**
+     * @brief Called with a subsystem's settle time while it resumes
+     * @details The hardware drivers poll their ready flags, so by default
+     *          resume does not wait. A simulation or bench installs a hook
+     *          that sleeps to model the settle times.
+     */
+    typedef void (*SettleHook)(uint32_t settle_ms);
+    static void setSettleHook(SettleHook hook);
+    
+    uint32_t getWakeupCount() const { return wakeupCount; }
+    uint32_t getUpdateCount() const { return updateCount; }
+    
     // Subsystem access
     AudioSubsystem* getAudioSystem() { return audioSystem; }
     DisplaySubsystem* getDisplaySystem() { return displaySystem; }
@@ -316,7 +410,16 @@ public:
     NavigationSubsystem* getNavigationSystem() { return navigationSystem; }
     
     // Power management
+    /**
+     * @brief Suspend all subsystems through the power manager's transition engine
+     * @details Dependencies: Navigation on WiFi (assisted GPS), Audio on
+     *          Bluetooth (A2DP source); the others run in parallel
+     */
     void enterLowPowerMode();
+    
+    /**
+     * @brief Resume all subsystems, dependencies first, independent ones in parallel
+     */
     void exitLowPowerMode();
     uint32_t getTotalPowerConsumption() const;
     
@@ -326,9 +429,9 @@ public:
     bool isSystemHealthy() const;
     
     // PROBLEMATIC METHODS
-    void enableMaintenanceTask(bool enable) { maintenanceTaskActive = enable; }
-    void enableDiagnostics(bool enable) { diagnosticsRunning = enable; }
-    void setUpdateInProgress(bool inProgress) { updateInProgress = inProgress; }
+    void enableMaintenanceTask(bool enable) { maintenanceTaskActive = enable; updatePending = true; }
+    void enableDiagnostics(bool enable) { diagnosticsRunning = enable; updatePending = true; }
+    void setUpdateInProgress(bool inProgress) { updateInProgress = inProgress; updatePending = true; }
 };
 
 #endif // INFOTAINMENT_SYSTEM_H
\ No newline at end of file
@@ -310,13 +310,21 @@ void PowerManager::shutdownNonEssentialSystems() {
         backgroundTaskActive = false;
         writeHardwareRegister(0x50000014, 0x00000000); // Stop background tasks
     }
+    
+    // 6. Registered subsystems, independent ones in parallel
+    transitionEngine.suspendAll();
 }
 
 void PowerManager::restoreNonEssentialSystems() {
+    // Resume registered subsystems first, independent ones in parallel;
+    // wake-up latency is the longest dependency chain, not the sum.
+    // Each one resumes only if its restore condition below holds.
+    transitionEngine.resumeAll();
+    
     // Restore systems based on context and user preferences
     
     // Only restore if ignition is on or user activity detected
-    if (ignitionState) {
+    if (shouldRestoreUserFunctions()) {
         // Restore display
         displayBacklightOn = true;
         writeHardwareRegister(0x50000004, 0x00000001);
@@ -324,18 +332,18 @@ void PowerManager::restoreNonEssentialSystems() {
         // Restore audio system
         audioProcessingActive = true;
         writeHardwareRegister(0x50000000, 0x00000001);
-        
-        // Enable Bluetooth if configured
-        if (config.enableNetworkWakeup) {
-            bluetoothScanActive = true;
-            writeHardwareRegister(0x50000008, 0x00000001);
-        }
-        
-        // Enable WiFi if configured
-        if (config.enableRemoteWakeup) {
-            wifiScanActive = true;
-            writeHardwareRegister(0x5000000C, 0x00000001);
-        }
+    }
+    
+    // Enable Bluetooth if configured
+    if (shouldRestoreBluetooth()) {
+        bluetoothScanActive = true;
+        writeHardwareRegister(0x50000008, 0x00000001);
+    }
+    
+    // Enable WiFi if configured
+    if (shouldRestoreWifi()) {
+        wifiScanActive = true;
+        writeHardwareRegister(0x5000000C, 0x00000001);
     }
     
     // Always restore critical background tasks
@@ -11,6 +11,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "PowerTransition.h"
 
 /**
  * @brief Power States according to AUTOSAR Power Management
@@ -97,6 +98,8 @@ private:
     bool wifiScanActive;              /**< PROBLEM: Continuous WiFi scan */
     bool gpsActive;                   /**< PROBLEM: GPS stays active */
     
+    PowerTransitionEngine transitionEngine; /**< Suspends/resumes registered subsystems */
+    
     // Internal methods
     void enterSleepMode();
     void exitSleepMode();
@@ -162,6 +165,12 @@ public:
      */
     PowerState_t getCurrentState() const { return currentState; }
     
+    /**
+     * @brief Get ignition state
+     * @return true if ignition is on
+     */
+    bool getIgnitionState() const { return ignitionState; }
+    
     /**
      * @brief Get power statistics
      * @return Power statistics structure
@@ -180,6 +189,23 @@ public:
      */
     bool shouldEnterSleep() const;
     
+    /**
+     * @brief Engine that suspends and resumes subsystems on sleep entry and wake-up
+     * @return Engine to register subsystems with; timings of the last transitions
+     */
+    PowerTransitionEngine& getTransitionEngine() { return transitionEngine; }
+    const PowerTransitionEngine& getTransitionEngine() const { return transitionEngine; }
+    
+    /**
+     * @brief Wake-up restore conditions, also the resume conditions of registered subsystems
+     * @details Display, audio and navigation come back with the ignition only;
+     *          Bluetooth and WiFi additionally need network/remote wake-up enabled.
+     *          A CAN, timer or ignition-off wake keeps them in low power.
+     */
+    bool shouldRestoreUserFunctions() const { return ignitionState; }
+    bool shouldRestoreBluetooth() const { return ignitionState && config.enableNetworkWakeup; }
+    bool shouldRestoreWifi() const { return ignitionState && config.enableRemoteWakeup; }
+    
     // PROBLEMATIC METHODS - These can cause battery drain if misused
     /**
      * @brief Set background task state (POTENTIAL DRAIN SOURCE)
@@ -0,0 +1,213 @@
+/**
+ * @file PowerTransition.cpp
+ * @brief Dependency-aware parallel suspend/resume implementation
+ * @details Ready participants are handed to a worker pool; each completion
+ *          releases the participants that were waiting for it
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#include "PowerTransition.h"
+#include <cstring>
+
+static uint32_t countBits(uint32_t mask) {
+    uint32_t count = 0;
+    while (mask) {
+        mask &= mask - 1;
+        count++;
+    }
+    return count;
+}
+
+static uint32_t lowestBit(uint32_t mask) {
+    uint32_t index = 0;
+    while (!(mask & 1u)) {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+}
+
+PowerTransitionEngine::PowerTransitionEngine(uint32_t workers_) :
+    participantCount(0),
+    workerCount(workers_),
+    workers(nullptr),
+    workersStarted(false),
+    activeKind(TRANSITION_SUSPEND),
+    readyMask(0),
+    doneMask(0),
+    skipMask(0),
+    stopWorkers(false),
+    sequence(0)
+{
+    memset(blockers, 0, sizeof(blockers));
+    memset(lastRecord, 0, sizeof(lastRecord));
+    lastRecord[TRANSITION_RESUME].kind = TRANSITION_RESUME;
+}
+
+PowerTransitionEngine::~PowerTransitionEngine() {
+    if (workersStarted) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopWorkers = true;
+        }
+        workAvailable.notify_all();
+        for (uint32_t i = 0; i < workerCount; i++) {
+            workers[i].join();
+        }
+    }
+    delete[] workers;
+}
+
+int PowerTransitionEngine::addParticipant(const char* name, uint32_t dependencyMask,
+                                          Callback suspend, Callback resume,
+                                          Condition resumeCondition) {
+    if (participantCount >= MAX_TRANSITION_PARTICIPANTS) return -1;
+
+    // Only already registered participants can be dependencies: no cycles
+    uint32_t registered = (1u << participantCount) - 1u;
+    if (dependencyMask & ~registered) return -1;
+
+    uint32_t id = participantCount;
+    Participant& p = participants[id];
+    p.name = name;
+    p.dependencyMask = dependencyMask;
+    p.dependentMask = 0;
+    p.callback[TRANSITION_SUSPEND] = suspend;
+    p.callback[TRANSITION_RESUME] = resume;
+    p.resumeCondition = resumeCondition;
+
+    for (uint32_t i = 0; i < id; i++) {
+        if (dependencyMask & (1u << i)) participants[i].dependentMask |= (1u << id);
+    }
+    participantCount++;
+    return static_cast<int>(id);
+}
+
+void PowerTransitionEngine::clearParticipants() {
+    for (uint32_t i = 0; i < participantCount; i++) {
+        participants[i].callback[TRANSITION_SUSPEND] = Callback();
+        participants[i].callback[TRANSITION_RESUME] = Callback();
+        participants[i].resumeCondition = Condition();
+    }
+    participantCount = 0;
+}
+
+void PowerTransitionEngine::startWorkers() {
+    workers = new std::thread[workerCount];
+    for (uint32_t i = 0; i < workerCount; i++) {
+        workers[i] = std::thread(&PowerTransitionEngine::workerLoop, this);
+    }
+    workersStarted = true;
+}
+
+void PowerTransitionEngine::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopWorkers) {
+        uint32_t id;
+        if (takeReady(id)) {
+            lock.unlock();
+            execute(id);
+            lock.lock();
+        } else {
+            workAvailable.wait(lock);
+        }
+    }
+}
+
+uint32_t PowerTransitionEngine::elapsed_us() const {
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - transitionStart).count());
+}
+
+void PowerTransitionEngine::prepareTransition(PowerTransitionKind_t kind) {
+    activeKind = kind;
+    readyMask = 0;
+    doneMask = 0;
+    skipMask = 0;
+
+    for (uint32_t i = 0; i < participantCount; i++) {
+        // Conditions are sampled once, on the caller, before any callback runs
+        if (kind == TRANSITION_RESUME && participants[i].resumeCondition &&
+            !participants[i].resumeCondition()) {
+            skipMask |= (1u << i);
+        }
+
+        // Resume waits for dependencies, suspend waits for dependents
+        uint32_t waitMask = (kind == TRANSITION_RESUME) ?
+            participants[i].dependencyMask : participants[i].dependentMask;
+        blockers[i] = countBits(waitMask);
+        if (blockers[i] == 0) readyMask |= (1u << i);
+    }
+
+    PowerTransitionRecord_t& record = lastRecord[kind];
+    memset(&record, 0, sizeof(record));
+    record.kind = kind;
+    record.sequence = ++sequence;
+    record.participantCount = participantCount;
+    record.skippedMask = skipMask;
+    transitionStart = std::chrono::steady_clock::now();
+}
+
+bool PowerTransitionEngine::takeReady(uint32_t& id) {
+    if (readyMask == 0) return false;
+    id = lowestBit(readyMask);
+    readyMask &= ~(1u << id);
+    return true;
+}
+
+void PowerTransitionEngine::execute(uint32_t id) {
+    const Participant& p = participants[id];
+    uint32_t start = elapsed_us();
+    bool skipped = (skipMask & (1u << id)) != 0;
+    if (!skipped && p.callback[activeKind]) p.callback[activeKind]();
+    uint32_t duration = elapsed_us() - start;
+
+    bool released = false;
+    bool finished;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        PowerTransitionTiming_t& timing = lastRecord[activeKind].timing[id];
+        timing.name = p.name;
+        timing.start_us = start;
+        timing.duration_us = duration;
+        lastRecord[activeKind].serial_us += duration;
+
+        uint32_t next = (activeKind == TRANSITION_RESUME) ? p.dependentMask : p.dependencyMask;
+        while (next) {
+            uint32_t j = lowestBit(next);
+            next &= ~(1u << j);
+            if (--blockers[j] == 0) {
+                readyMask |= (1u << j);
+                released = true;
+            }
+        }
+        doneMask |= (1u << id);
+        finished = (doneMask == (1u << participantCount) - 1u);
+    }
+
+    if (released) workAvailable.notify_all();
+    if (finished) workDone.notify_all();
+}
+
+void PowerTransitionEngine::runTransition(PowerTransitionKind_t kind) {
+    if (workerCount > 0 && !workersStarted) startWorkers();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    prepareTransition(kind);
+    uint32_t allMask = (1u << participantCount) - 1u;
+    if (workerCount > 0 && readyMask) workAvailable.notify_all();
+
+    // The caller works through ready participants too
+    while (doneMask != allMask) {
+        uint32_t id;
+        if (takeReady(id)) {
+            lock.unlock();
+            execute(id);
+            lock.lock();
+        } else {
+            workDone.wait(lock);
+        }
+    }
+    lastRecord[kind].total_us = elapsed_us();
+}
@@ -0,0 +1,154 @@
+/**
+ * @file PowerTransition.h
+ * @brief Dependency-aware parallel suspend/resume of power participants
+ * @details Participants declare the participants they depend on; independent
+ *          ones suspend or resume concurrently on a small worker pool
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#ifndef POWER_TRANSITION_H
+#define POWER_TRANSITION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Transition directions
+ */
+typedef enum {
+    TRANSITION_SUSPEND = 0,           /**< Enter low power mode */
+    TRANSITION_RESUME,                /**< Exit low power mode */
+    TRANSITION_KIND_COUNT
+} PowerTransitionKind_t;
+
+/**
+ * @brief Timing of one participant within a transition
+ */
+typedef struct {
+    const char* name;
+    uint32_t start_us;                /**< Offset from the start of the transition */
+    uint32_t duration_us;
+} PowerTransitionTiming_t;
+
+static const uint32_t MAX_TRANSITION_PARTICIPANTS = 16;
+
+/**
+ * @brief Result of one complete suspend or resume
+ */
+typedef struct {
+    PowerTransitionKind_t kind;
+    uint32_t sequence;                /**< Increments with every transition, 0 = none yet */
+    uint32_t total_us;                /**< Wall time of the whole transition */
+    uint32_t serial_us;               /**< Sum of participant durations (one-by-one cost) */
+    uint32_t participantCount;
+    uint32_t skippedMask;             /**< Bit i set = participant i stayed in low power */
+    PowerTransitionTiming_t timing[MAX_TRANSITION_PARTICIPANTS];
+} PowerTransitionRecord_t;
+
+/**
+ * @brief Runs suspend/resume callbacks of registered participants in parallel
+ * @details A participant resumes only after every participant it depends on
+ *          has resumed, and suspends only after every participant depending
+ *          on it has suspended. Dependencies must be registered before the
+ *          participants that use them, so the graph is acyclic by
+ *          construction. A participant whose resume condition does not
+ *          hold stays in low power but still releases its dependents.
+ *          Worker threads are started on the first transition
+ *          and block on a condition variable between transitions.
+ *          Transitions must not overlap; call them from one thread.
+ */
+class PowerTransitionEngine {
+public:
+    typedef std::function<void()> Callback;
+    typedef std::function<bool()> Condition;
+
+    static const uint32_t DEFAULT_WORKERS = 3;
+
+    /**
+     * @param workerCount Worker threads, 0 runs every callback on the caller
+     */
+    explicit PowerTransitionEngine(uint32_t workerCount = DEFAULT_WORKERS);
+    ~PowerTransitionEngine();
+
+    /**
+     * @brief Register a participant
+     * @param name Static name used in the timing records
+     * @param dependencyMask Bit i set = depends on participant id i
+     * @param resumeCondition Evaluated at the start of every resume, empty = always resume
+     * @return Participant id, or -1 if full or a dependency is not registered
+     */
+    int addParticipant(const char* name, uint32_t dependencyMask,
+                       Callback suspend, Callback resume,
+                       Condition resumeCondition = Condition());
+
+    /**
+     * @brief Remove all participants (keeps the recorded transitions)
+     */
+    void clearParticipants();
+
+    uint32_t getParticipantCount() const { return participantCount; }
+
+    /**
+     * @brief Suspend every participant, dependents first
+     */
+    void suspendAll() { runTransition(TRANSITION_SUSPEND); }
+
+    /**
+     * @brief Resume every participant, dependencies first
+     */
+    void resumeAll() { runTransition(TRANSITION_RESUME); }
+
+    /**
+     * @brief Most recent transition of a kind
+     */
+    const PowerTransitionRecord_t& getLastTransition(PowerTransitionKind_t kind) const {
+        return lastRecord[kind];
+    }
+
+private:
+    struct Participant {
+        const char* name;
+        uint32_t dependencyMask;      /**< Participants this one depends on */
+        uint32_t dependentMask;       /**< Participants that depend on this one */
+        Callback callback[TRANSITION_KIND_COUNT];
+        Condition resumeCondition;
+    };
+
+    Participant participants[MAX_TRANSITION_PARTICIPANTS];
+    uint32_t participantCount;
+
+    uint32_t workerCount;
+    std::thread* workers;
+    bool workersStarted;
+
+    // Transition state, guarded by mutex
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workDone;
+    PowerTransitionKind_t activeKind;
+    uint32_t readyMask;               /**< Blockers cleared, not yet taken */
+    uint32_t doneMask;
+    uint32_t skipMask;                /**< Callbacks not run in this transition */
+    uint32_t blockers[MAX_TRANSITION_PARTICIPANTS];
+    bool stopWorkers;
+
+    std::chrono::steady_clock::time_point transitionStart;
+    uint32_t sequence;
+    PowerTransitionRecord_t lastRecord[TRANSITION_KIND_COUNT];
+
+    void startWorkers();
+    void workerLoop();
+    void runTransition(PowerTransitionKind_t kind);
+    void prepareTransition(PowerTransitionKind_t kind);
+    bool takeReady(uint32_t& id);
+    void execute(uint32_t id);
+    uint32_t elapsed_us() const;
+};
+
+#endif // POWER_TRANSITION_H
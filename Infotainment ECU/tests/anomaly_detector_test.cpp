@@ -0,0 +1,248 @@
+/**
+ * @file anomaly_detector_test.cpp
+ * @brief Host test of the incremental anomaly detector
+ * @details Feeds AnomalyDetector::process() synthetic 1 Hz sample streams
+ *          from a fixed seed and checks the events it reports:
+ *          - noise around steady RUN and SLEEP levels raises nothing,
+ *          - a sustained step of about two sigmas is found by the CUSUM,
+ *            a single spike by the spike check, and neither repeats,
+ *          - a subsystem on with the ignition off is reported after exactly
+ *            STUCK_RUN_SAMPLES, per subsystem, and not with the ignition on,
+ *          - repeats within DEDUP_WINDOW_SAMPLES merge into one event.
+ *          Exits with status 1 on any failed check.
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#include <iostream>
+#include <cstring>
+
+#include "../src/Diagnostics/AnomalyDetector.h"
+
+static const uint32_t SEED = 0x5EED;
+
+static uint32_t g_prngState = SEED;
+static uint32_t g_failures = 0;
+static uint32_t g_timestamp_ms = 0;
+
+// xorshift32, same generator as the benchmarks
+static uint32_t nextRandom() {
+    uint32_t x = g_prngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    g_prngState = x;
+    return x;
+}
+
+/**
+ * @brief Roughly normal noise of the given standard deviation (sum of four uniforms)
+ */
+static int32_t noise(uint32_t sigma_uA) {
+    int64_t sum = 0;
+    for (int i = 0; i < 4; i++) {
+        sum += static_cast<int64_t>(nextRandom() % 2001) - 1000;
+    }
+    // Each uniform has a standard deviation of 1000 / sqrt(3), the sum twice that
+    return static_cast<int32_t>(sum * static_cast<int64_t>(sigma_uA) * 866 / 1000000);
+}
+
+static PowerMeasurement_t sample(PowerState_t state, uint32_t level_uA, uint32_t sigma_uA,
+                                 uint32_t subsystemMask) {
+    PowerMeasurement_t m;
+    g_timestamp_ms += 1000;
+    m.timestamp_ms = g_timestamp_ms;
+    m.consumption_uA = static_cast<uint32_t>(static_cast<int32_t>(level_uA) + noise(sigma_uA));
+    m.batteryVoltage_mV = 12600 + nextRandom() % 100;
+    m.powerState = state;
+    m.subsystemMask = subsystemMask;
+    return m;
+}
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cout << "    FAILED: " << what << std::endl;
+        g_failures++;
+    }
+}
+
+static void reset(AnomalyDetector& detector) {
+    detector.clear();
+    detector.setThresholds(10000, 5000000);
+    g_prngState = SEED;
+    g_timestamp_ms = 0;
+}
+
+/**
+ * @brief Events with this description among the retained ones
+ */
+static uint32_t countEvents(const AnomalyDetector& detector, const char* description) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < detector.getEventCount(); i++) {
+        if (std::strcmp(detector.getEvent(i).description, description) == 0) count++;
+    }
+    return count;
+}
+
+static void checkNoiseOnly() {
+    AnomalyDetector detector;
+    uint32_t events = 0;
+
+    std::cout << "  Noise around steady levels" << std::endl;
+    reset(detector);
+    for (uint32_t cycle = 0; cycle < 5; cycle++) {
+        // 30 min drive at 1.5 A, 1 h parked at 4 mA
+        for (uint32_t i = 0; i < 1800; i++) {
+            events += detector.process(sample(POWER_STATE_RUN, 1500000, 20000,
+                                              SUBSYSTEM_AUDIO | SUBSYSTEM_DISPLAY), true);
+        }
+        for (uint32_t i = 0; i < 3600; i++) {
+            events += detector.process(sample(POWER_STATE_SLEEP, 4000, 500, 0), false);
+        }
+    }
+    check(events == 0 && detector.getTotalEvents() == 0, "no events on noise");
+    check(detector.getMostCommonAnomaly() == ANOMALY_NONE, "no most common anomaly without events");
+
+    const StateStatistics_t& run = detector.getStateStatistics(POWER_STATE_RUN);
+    check(run.mean_uA > 1490000 && run.mean_uA < 1510000, "RUN baseline learned");
+}
+
+static void checkStep() {
+    AnomalyDetector detector;
+    uint32_t detectedAfter = 0;
+
+    std::cout << "  Sustained step and single spike" << std::endl;
+    reset(detector);
+    for (uint32_t i = 0; i < 600; i++) {
+        detector.process(sample(POWER_STATE_RUN, 1500000, 20000, 0), true);
+    }
+    check(detector.getTotalEvents() == 0, "no events before the step");
+
+    // +40 mA is two sigmas: below the spike check, a clear shift for the CUSUM
+    for (uint32_t i = 1; i <= 600; i++) {
+        detector.process(sample(POWER_STATE_RUN, 1540000, 20000, 0), true);
+        if (detectedAfter == 0 && detector.getTotalEvents() > 0) detectedAfter = i;
+    }
+    check(detectedAfter > 0 && detectedAfter <= 20, "step detected within 20 samples");
+    check(detector.getTotalEvents() == 1 && countEvents(detector, "Sustained consumption increase") == 1,
+          "step reported once as a sustained increase");
+    check(detector.getStateStatistics(POWER_STATE_RUN).mean_uA > 1530000, "baseline relearned at the new level");
+
+    // One sample at three times the level is a spike and stays out of the baseline
+    PowerMeasurement_t spike = sample(POWER_STATE_RUN, 4500000, 0, 0);
+    check(detector.process(spike, true) == 1, "spike reported");
+    check(countEvents(detector, "Consumption spike above state baseline") == 1, "spike described as such");
+    for (uint32_t i = 0; i < 600; i++) {
+        detector.process(sample(POWER_STATE_RUN, 1540000, 20000, 0), true);
+    }
+    check(detector.getTotalEvents() == 2, "no events after the spike");
+
+    // A step far above the spike limit is a spike, then a sustained increase
+    uint32_t before = detector.getTotalEvents();
+    for (uint32_t i = 0; i < 600; i++) {
+        detector.process(sample(POWER_STATE_RUN, 3000000, 20000, 0), true);
+    }
+    check(detector.getTotalEvents() == before + 2 &&
+          countEvents(detector, "Sustained consumption increase") == 2, "large step reported as a sustained increase");
+    check(detector.getStateStatistics(POWER_STATE_RUN).mean_uA > 2990000, "baseline relearned after the large step");
+}
+
+static void checkStuckSubsystem() {
+    AnomalyDetector detector;
+    uint32_t reportedAt = 0;
+
+    std::cout << "  Stuck subsystem" << std::endl;
+    reset(detector);
+
+    // Active with the ignition on is normal use
+    for (uint32_t i = 0; i < 600; i++) {
+        detector.process(sample(POWER_STATE_RUN, 1500000, 20000, SUBSYSTEM_WIFI), true);
+    }
+    check(detector.getTotalEvents() == 0, "no stuck subsystem with the ignition on");
+
+    // Runs one sample short of the limit, interrupted, do not count
+    for (uint32_t run = 0; run < 5; run++) {
+        for (uint32_t i = 0; i < AnomalyDetector::STUCK_RUN_SAMPLES - 1; i++) {
+            detector.process(sample(POWER_STATE_SLEEP, 4000, 500, SUBSYSTEM_WIFI), false);
+        }
+        detector.process(sample(POWER_STATE_SLEEP, 4000, 500, 0), false);
+    }
+    check(detector.getTotalEvents() == 0, "interrupted runs are not reported");
+
+    for (uint32_t i = 1; i <= 2 * AnomalyDetector::STUCK_RUN_SAMPLES; i++) {
+        if (detector.process(sample(POWER_STATE_SLEEP, 4000, 500, SUBSYSTEM_WIFI), false) && reportedAt == 0) {
+            reportedAt = i;
+        }
+    }
+    check(reportedAt == AnomalyDetector::STUCK_RUN_SAMPLES, "reported after STUCK_RUN_SAMPLES");
+    check(detector.getTotalEvents() == 1, "one event for one stuck subsystem");
+
+    const AnomalyEvent_t& event = detector.getRecentEvent(0);
+    check(event.type == ANOMALY_STUCK_SUBSYSTEM && event.subsystemMask == SUBSYSTEM_WIFI &&
+          event.powerState == POWER_STATE_SLEEP, "event names the subsystem and state");
+    check(std::strcmp(event.description, "WiFi active with ignition off") == 0, "WiFi description");
+
+    // A second subsystem joining is its own event
+    for (uint32_t i = 0; i < AnomalyDetector::STUCK_RUN_SAMPLES; i++) {
+        detector.process(sample(POWER_STATE_SLEEP, 4000, 500, SUBSYSTEM_WIFI | SUBSYSTEM_GPS), false);
+    }
+    check(detector.getTotalEvents() == 2 && detector.getRecentEvent(0).subsystemMask == SUBSYSTEM_GPS,
+          "second stuck subsystem reported separately");
+    check(detector.getMostCommonAnomaly() == ANOMALY_STUCK_SUBSYSTEM, "stuck subsystem is the most common");
+}
+
+static void checkDeduplication() {
+    AnomalyDetector detector;
+    const uint32_t stuck = AnomalyDetector::STUCK_RUN_SAMPLES;
+
+    std::cout << "  De-duplication" << std::endl;
+    reset(detector);
+
+    // Stuck for ten minutes: one event counting every triggering sample
+    for (uint32_t i = 0; i < stuck + 599; i++) {
+        detector.process(sample(POWER_STATE_SLEEP, 4000, 500, SUBSYSTEM_AUDIO), false);
+    }
+    check(detector.getTotalEvents() == 1, "continuous stuck subsystem is one event");
+    check(detector.getRecentEvent(0).occurrences == 600, "occurrences count every triggering sample");
+    check(detector.getRecentEvent(0).lastSeen_ms > detector.getRecentEvent(0).firstSeen_ms,
+          "last seen follows the repeats");
+
+    // Stuck again within the dedup window: merged into the same event
+    for (uint32_t i = 0; i < 100; i++) {
+        detector.process(sample(POWER_STATE_SLEEP, 4000, 500, 0), false);
+    }
+    for (uint32_t i = 0; i < stuck; i++) {
+        detector.process(sample(POWER_STATE_SLEEP, 4000, 500, SUBSYSTEM_AUDIO), false);
+    }
+    check(detector.getTotalEvents() == 1 && detector.getRecentEvent(0).occurrences == 601,
+          "repeat within the window merged");
+
+    // Stuck again after the window: a new event
+    for (uint32_t i = 0; i < AnomalyDetector::DEDUP_WINDOW_SAMPLES + 1; i++) {
+        detector.process(sample(POWER_STATE_SLEEP, 4000, 500, 0), false);
+    }
+    for (uint32_t i = 0; i < stuck; i++) {
+        detector.process(sample(POWER_STATE_SLEEP, 4000, 500, SUBSYSTEM_AUDIO), false);
+    }
+    check(detector.getTotalEvents() == 2 && detector.getRecentEvent(0).occurrences == 1,
+          "repeat after the window is a new event");
+
+    // Same check in another power state is a different event
+    for (uint32_t i = 0; i < stuck; i++) {
+        detector.process(sample(POWER_STATE_SLEEP_PREPARE, 150000, 5000, SUBSYSTEM_AUDIO), false);
+    }
+    check(detector.getTotalEvents() == 3 && detector.getRecentEvent(0).powerState == POWER_STATE_SLEEP_PREPARE,
+          "other power state is a new event");
+}
+
+int main() {
+    std::cout << "AnomalyDetector test" << std::endl;
+
+    checkNoiseOnly();
+    checkStep();
+    checkStuckSubsystem();
+    checkDeduplication();
+
+    std::cout << (g_failures == 0 ? "PASSED" : "FAILED") << " (" << g_failures << " failed checks)" << std::endl;
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,271 @@
+/**
+ * @file measurement_exporter_test.cpp
+ * @brief Host round-trip test of the measurement exporter file formats
+ * @details Exports fixed-seed measurement streams and decodes the files again:
+ *          - binary records (tag, zigzag varint deltas, optional voltage and
+ *            mask) decode back to every field of every measurement,
+ *          - with size-based rotation each file starts with the magic, stays
+ *            within the limit and decodes on its own because deltas restart,
+ *          - CSV files hold the header and one line per measurement.
+ *          Exits with status 1 on any failed check.
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include "../src/Diagnostics/MeasurementExporter.h"
+
+static const char* BINARY_PATH = "measurement_exporter_test.bin";
+static const char* CSV_PATH = "measurement_exporter_test.csv";
+
+static uint32_t g_prngState = 0x5EED;
+static uint32_t g_failures = 0;
+
+// xorshift32, same generator as the benchmarks
+static uint32_t nextRandom() {
+    uint32_t x = g_prngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    g_prngState = x;
+    return x;
+}
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cout << "    FAILED: " << what << std::endl;
+        g_failures++;
+    }
+}
+
+/**
+ * @brief 1 Hz samples with jitter, falling and rising current, occasional
+ *        voltage and subsystem changes and a few large jumps
+ */
+static std::vector<PowerMeasurement_t> makeMeasurements(uint32_t count) {
+    std::vector<PowerMeasurement_t> result;
+    PowerMeasurement_t m;
+    m.timestamp_ms = 1000;
+    m.consumption_uA = 1500000;
+    m.batteryVoltage_mV = 12600;
+    m.powerState = POWER_STATE_RUN;
+    m.subsystemMask = SUBSYSTEM_AUDIO | SUBSYSTEM_DISPLAY;
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t r = nextRandom();
+        m.timestamp_ms += 990 + r % 21;
+        m.consumption_uA = m.consumption_uA + (r >> 8) % 2001 - 1000;
+        if (r % 7 == 0) m.batteryVoltage_mV = 12000 + (r >> 4) % 1000;
+        if (r % 50 == 0) m.subsystemMask ^= 1u << ((r >> 12) % 8);
+        if (r % 200 == 0) {
+            // Sleep entry or wake-up: large current step and state change
+            bool sleeping = m.powerState == POWER_STATE_SLEEP;
+            m.powerState = sleeping ? POWER_STATE_RUN : POWER_STATE_SLEEP;
+            m.consumption_uA = sleeping ? 1500000 : 4000;
+            m.timestamp_ms += sleeping ? 3600000 : 0;
+        }
+        result.push_back(m);
+    }
+    return result;
+}
+
+static bool readFile(const std::string& path, std::string& contents) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in) return false;
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+static std::string rotatedPath(const char* base, uint32_t index) {
+    return index == 0 ? std::string(base) : std::string(base) + "." + std::to_string(index);
+}
+
+static bool getVarint(const std::string& data, size_t& pos, uint64_t& value) {
+    value = 0;
+    for (uint32_t shift = 0; shift < 64 && pos < data.size(); shift += 7) {
+        uint8_t byte = static_cast<uint8_t>(data[pos++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+static bool getZigzag(const std::string& data, size_t& pos, int64_t& value) {
+    uint64_t raw;
+    if (!getVarint(data, pos, raw)) return false;
+    value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+    return true;
+}
+
+/**
+ * @brief Decode one binary file, deltas starting from zero
+ * @return false on a bad magic or a truncated record
+ */
+static bool decodeBinary(const std::string& data, std::vector<PowerMeasurement_t>& out) {
+    if (data.compare(0, 4, "PMB1") != 0) return false;
+
+    PowerMeasurement_t previous = {0, 0, 0, POWER_STATE_RUN, 0};
+    size_t pos = 4;
+    while (pos < data.size()) {
+        uint8_t tag = static_cast<uint8_t>(data[pos++]);
+        int64_t delta;
+        PowerMeasurement_t m = previous;
+        m.powerState = static_cast<PowerState_t>(tag & 0x0F);
+
+        if (!getZigzag(data, pos, delta)) return false;
+        m.timestamp_ms = static_cast<uint32_t>(previous.timestamp_ms + delta);
+        if (!getZigzag(data, pos, delta)) return false;
+        m.consumption_uA = static_cast<uint32_t>(previous.consumption_uA + delta);
+        if (tag & 0x10) {
+            if (!getZigzag(data, pos, delta)) return false;
+            m.batteryVoltage_mV = static_cast<uint32_t>(previous.batteryVoltage_mV + delta);
+        }
+        if (tag & 0x20) {
+            uint64_t mask;
+            if (!getVarint(data, pos, mask)) return false;
+            m.subsystemMask = static_cast<uint32_t>(mask);
+        }
+        out.push_back(m);
+        previous = m;
+    }
+    return true;
+}
+
+static bool sameMeasurements(const std::vector<PowerMeasurement_t>& a, const std::vector<PowerMeasurement_t>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].timestamp_ms != b[i].timestamp_ms || a[i].consumption_uA != b[i].consumption_uA ||
+            a[i].batteryVoltage_mV != b[i].batteryVoltage_mV || a[i].powerState != b[i].powerState ||
+            a[i].subsystemMask != b[i].subsystemMask) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Export through a fresh exporter and return its counters
+ */
+static ExportStats_t exportAll(const char* path, ExportFormat_t format, uint32_t maxFileBytes,
+                               const std::vector<PowerMeasurement_t>& measurements) {
+    MeasurementExporter* exporter = new MeasurementExporter();
+    ExportStats_t stats = {0, 0, 0, 0, 0};
+    bool started = exporter->start(path, format, maxFileBytes);
+    check(started, "exporter starts");
+    if (started) {
+        for (size_t i = 0; i < measurements.size(); i++) {
+            exporter->submit(measurements[i]);
+        }
+        exporter->stop();
+        stats = exporter->getStats();
+    }
+    delete exporter;
+    return stats;
+}
+
+static void checkBinaryRoundTrip() {
+    std::vector<PowerMeasurement_t> measurements = makeMeasurements(3000);
+    std::vector<PowerMeasurement_t> decoded;
+    std::string data;
+
+    std::cout << "  Binary round trip" << std::endl;
+    ExportStats_t stats = exportAll(BINARY_PATH, EXPORT_FORMAT_BINARY, 0, measurements);
+    check(stats.recordsWritten == measurements.size() && stats.recordsDropped == 0 && stats.writeErrors == 0,
+          "every measurement written");
+    check(stats.filesWritten == 1, "no rotation without a size limit");
+
+    check(readFile(BINARY_PATH, data), "binary file readable");
+    check(data.size() == stats.bytesWritten, "file size matches the written bytes");
+    check(decodeBinary(data, decoded), "binary file decodes");
+    check(sameMeasurements(decoded, measurements), "decoded records equal the measurements");
+    check(data.size() < 4 + 8 * measurements.size(), "records are delta encoded");
+
+    std::remove(BINARY_PATH);
+}
+
+static void checkRotation() {
+    const uint32_t maxFileBytes = 256;
+    std::vector<PowerMeasurement_t> measurements = makeMeasurements(1000);
+    std::vector<PowerMeasurement_t> decoded;
+    bool allStartWithMagic = true;
+    bool allWithinLimit = true;
+    bool allDecode = true;
+    uint64_t totalBytes = 0;
+
+    std::cout << "  Binary rotation" << std::endl;
+    ExportStats_t stats = exportAll(BINARY_PATH, EXPORT_FORMAT_BINARY, maxFileBytes, measurements);
+    check(stats.recordsWritten == measurements.size() && stats.writeErrors == 0, "every measurement written");
+    check(stats.filesWritten > 10, "small limit rotates many files");
+
+    for (uint32_t i = 0; i < stats.filesWritten; i++) {
+        std::string path = rotatedPath(BINARY_PATH, i);
+        std::string data;
+        std::vector<PowerMeasurement_t> records;
+        check(readFile(path, data), "rotated file readable");
+
+        allStartWithMagic = allStartWithMagic && data.compare(0, 4, "PMB1") == 0;
+        allWithinLimit = allWithinLimit && data.size() <= maxFileBytes;
+        // Each file on its own: its deltas restart from zero
+        allDecode = allDecode && decodeBinary(data, records) && !records.empty();
+        decoded.insert(decoded.end(), records.begin(), records.end());
+        totalBytes += data.size();
+        std::remove(path.c_str());
+    }
+    check(allStartWithMagic, "every file starts with the magic");
+    check(allWithinLimit, "every file within the size limit");
+    check(allDecode, "every file decodes on its own");
+    check(sameMeasurements(decoded, measurements), "files in order hold every measurement");
+    check(totalBytes == stats.bytesWritten, "file sizes add up to the written bytes");
+
+    std::string extra;
+    check(!readFile(rotatedPath(BINARY_PATH, stats.filesWritten), extra), "no file past the last one");
+}
+
+static void checkCsv() {
+    std::vector<PowerMeasurement_t> measurements = makeMeasurements(100);
+    std::string data;
+
+    std::cout << "  CSV export" << std::endl;
+    ExportStats_t stats = exportAll(CSV_PATH, EXPORT_FORMAT_CSV, 0, measurements);
+    check(stats.recordsWritten == measurements.size() && stats.writeErrors == 0, "every measurement written");
+
+    check(readFile(CSV_PATH, data), "CSV file readable");
+    std::istringstream lines(data);
+    std::string line;
+    std::getline(lines, line);
+    check(line.compare(0, 13, "Timestamp_ms,") == 0, "CSV header first");
+
+    uint32_t rows = 0;
+    bool fieldsMatch = true;
+    while (std::getline(lines, line)) {
+        const PowerMeasurement_t& m = measurements[rows < measurements.size() ? rows : 0];
+        std::ostringstream expected;
+        expected << m.timestamp_ms << "," << m.consumption_uA << "," << m.consumption_uA / 1000 << ","
+                 << m.batteryVoltage_mV << "," << static_cast<int>(m.powerState) << ",";
+        fieldsMatch = fieldsMatch && line.compare(0, expected.str().size(), expected.str()) == 0;
+        rows++;
+    }
+    check(rows == measurements.size(), "one CSV line per measurement");
+    check(fieldsMatch, "CSV lines hold the measurement fields");
+
+    std::remove(CSV_PATH);
+}
+
+int main() {
+    std::cout << "MeasurementExporter test" << std::endl;
+
+    checkBinaryRoundTrip();
+    checkRotation();
+    checkCsv();
+
+    std::cout << (g_failures == 0 ? "PASSED" : "FAILED") << " (" << g_failures << " failed checks)" << std::endl;
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file measurement_store_test.cpp
+ * @brief Host test of the tiered measurement store and its time base
+ * @details Checks that:
+ *          - samples are grouped into 1 s, 1 min and 1 h buckets by their
+ *            timestamp, buckets closing when a sample crosses a boundary,
+ *          - PowerMonitor::takeMeasurement() stamps samples with the
+ *            monotonic ms clock, which keeps advancing while the process
+ *            sleeps, so real runs land in the right buckets.
+ *          Exits with status 1 on any failed check.
+ * @author Battery Drain Case Study
+ * @date November 2024
+ */
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+
+#include "../src/PowerManager/PowerManager.h"
+#include "../src/InfotainmentSystem/InfotainmentSystem.h"
+#include "../src/Diagnostics/PowerMonitor.h"
+
+static uint32_t g_failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cout << "    FAILED: " << what << std::endl;
+        g_failures++;
+    }
+}
+
+static PowerMeasurement_t sample(uint32_t timestamp_ms, uint32_t consumption_uA) {
+    PowerMeasurement_t m;
+    m.timestamp_ms = timestamp_ms;
+    m.consumption_uA = consumption_uA;
+    m.batteryVoltage_mV = 12600;
+    m.powerState = POWER_STATE_SLEEP;
+    m.subsystemMask = 0;
+    return m;
+}
+
+static void checkMinuteBoundary() {
+    MeasurementStore* store = new MeasurementStore();
+
+    std::cout << "  Samples across a minute boundary" << std::endl;
+
+    // 1 Hz from 0:55 to 1:04, one minute into the hour
+    for (uint32_t s = 55; s < 65; s++) {
+        store->insert(sample(3600000 + s * 1000, 5000 + s));
+    }
+
+    check(store->tierCount(TIER_1S) == 9, "one closed 1 s bucket per second but the last");
+    check(store->tierAt(TIER_1S, 0).start_ms == 3655000 && store->tierAt(TIER_1S, 0).sampleCount == 1,
+          "first 1 s bucket starts at the first sample");
+
+    check(store->tierCount(TIER_1MIN) == 1, "minute boundary closes one 1 min bucket");
+    const PowerAggregate_t& minute = store->tierAt(TIER_1MIN, 0);
+    check(minute.start_ms == 3600000 && minute.sampleCount == 5, "closed minute holds 0:55 to 0:59");
+    check(minute.minConsumption_uA == 5055 && minute.maxConsumption_uA == 5059, "closed minute min/max");
+    const PowerAggregate_t* openMinute = store->openBucket(TIER_1MIN);
+    check(openMinute != nullptr && openMinute->start_ms == 3660000 && openMinute->sampleCount == 5,
+          "open minute holds 1:00 to 1:04");
+
+    check(store->tierCount(TIER_1H) == 0, "hour bucket still open");
+    const PowerAggregate_t* openHour = store->openBucket(TIER_1H);
+    check(openHour != nullptr && openHour->start_ms == 3600000 && openHour->sampleCount == 10,
+          "open hour holds every sample");
+    check(store->getTotals().sampleCount == 10, "totals count every sample");
+
+    // A sample an hour later closes every tier
+    store->insert(sample(7200000 + 1000, 5000));
+    check(store->tierCount(TIER_1MIN) == 2 && store->tierCount(TIER_1H) == 1, "next hour closes minute and hour");
+    check(store->tierAt(TIER_1H, 0).sampleCount == 10, "closed hour holds every earlier sample");
+
+    delete store;
+}
+
+static void checkMonitorTimeBase() {
+    PowerManager powerManager;
+    InfotainmentSystem infotainmentSystem;
+    PowerMonitor* monitor = new PowerMonitor();
+    PowerConfig_t config = {
+        .sleepTimeout_ms = 300000,
+        .deepSleepTimeout_ms = 1800000,
+        .wakeupSources = WAKEUP_IGNITION | WAKEUP_CAN_NETWORK | WAKEUP_USER_INPUT,
+        .enablePeriodicWakeup = false,
+        .periodicWakeupInterval_ms = 3600000,
+        .enableNetworkWakeup = true,
+        .enableRemoteWakeup = false
+    };
+
+    std::cout << "  PowerMonitor time base" << std::endl;
+
+    // The monitor logs to std::cout; keep its output out of the test log
+    std::ostringstream discard;
+    std::streambuf* console = std::cout.rdbuf(discard.rdbuf());
+    bool initialized = powerManager.initialize(config) && infotainmentSystem.initialize(&powerManager) &&
+                       monitor->initialize(&powerManager, &infotainmentSystem);
+
+    PowerMeasurement_t first = monitor->takeMeasurement();
+    uint32_t before_ms = InfotainmentSystem::getTime_ms();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    PowerMeasurement_t second = monitor->takeMeasurement();
+    std::cout.rdbuf(console);
+
+    check(initialized, "power monitor initializes");
+    check(first.timestamp_ms <= before_ms && before_ms <= second.timestamp_ms, "stamped with the system ms clock");
+    check(second.timestamp_ms - first.timestamp_ms >= 1100 && second.timestamp_ms - first.timestamp_ms < 3000,
+          "timestamps advance in ms while the process sleeps");
+
+    // 1.1 s apart: the first 1 s bucket is closed with one sample
+    const MeasurementStore& store = monitor->getMeasurementStore();
+    check(store.tierCount(TIER_1S) == 1 && store.tierAt(TIER_1S, 0).sampleCount == 1,
+          "samples a second apart fall into different 1 s buckets");
+
+    console = std::cout.rdbuf(discard.rdbuf());
+    delete monitor;
+    std::cout.rdbuf(console);
+}
+
+int main() {
+    std::cout << "MeasurementStore test" << std::endl;
+
+    checkMinuteBoundary();
+    checkMonitorTimeBase();
+
+    std::cout << (g_failures == 0 ? "PASSED" : "FAILED") << " (" << g_failures << " failed checks)" << std::endl;
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+#include "SeatDebounce.h"
+#include "NvM.h"
+
+#define SEAT_TICK_MS 10u
+
+static uint8_t seatCount;
+static bool seatReady;
+
+static SeatMask rawLatch, filtLatch;
+static SeatMask rawOcc, rawUnknown, filtOcc, filtUnknown;
+static SeatMask latchCounting, occCounting;   // seats whose tick counter is running
+static SeatMask warning;
+// Ticks raw has differed from filtered. Counting only while they differ is the same as the
+// previous "raw stable for the delay" timers: a raw change restarts the count either way.
+static uint16_t latchTicks[SEAT_MAX_SEATS];
+static uint16_t occTicks[SEAT_MAX_SEATS];
+
+static void mask_set(SeatMask* m, uint8_t seat, bool v){
+    uint32_t bit = 1u << (seat & 31u);
+    if(v) m->w[seat >> 5] |= bit; else m->w[seat >> 5] &= ~bit;
+}
+
+static bool mask_get(const SeatMask* m, uint8_t seat){
+    return ((m->w[seat >> 5] >> (seat & 31u)) & 1u) != 0u;
+}
+
+static uint32_t ctz32(uint32_t v){
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_ctz(v);
+#else
+    uint32_t n = 0;
+    while((v & 1u) == 0u){ v >>= 1; n++; }
+    return n;
+#endif
+}
+
+static uint16_t ms_to_ticks(uint16_t ms){
+    return (uint16_t)((ms + SEAT_TICK_MS - 1u) / SEAT_TICK_MS);
+}
+
+void SeatDebounce_Init(uint8_t seat_count){
+    seatCount = seat_count > SEAT_MAX_SEATS ? (uint8_t)SEAT_MAX_SEATS : seat_count;
+    for(uint32_t w=0;w<SEAT_MASK_WORDS;w++){
+        rawLatch.w[w] = filtLatch.w[w] = 0xFFFFFFFFu;
+        rawOcc.w[w] = rawUnknown.w[w] = filtOcc.w[w] = filtUnknown.w[w] = 0u;
+        latchCounting.w[w] = occCounting.w[w] = warning.w[w] = 0u;
+    }
+    for(uint32_t i=0;i<SEAT_MAX_SEATS;i++){ latchTicks[i] = 0; occTicks[i] = 0; }
+    seatReady = true;
+}
+
+static void seat_ready(void){ if(!seatReady) SeatDebounce_Init(1); }
+
+uint8_t SeatDebounce_GetSeatCount(void){ seat_ready(); return seatCount; }
+
+void SeatDebounce_SetRawLatch(uint8_t seat, bool latched){
+    seat_ready();
+    if(seat < SEAT_MAX_SEATS) mask_set(&rawLatch, seat, latched);
+}
+
+void SeatDebounce_SetRawOccupancy(uint8_t seat, OccupancyState occ){
+    seat_ready();
+    if(seat >= SEAT_MAX_SEATS) return;
+    mask_set(&rawOcc, seat, occ == OCC_OCCUPIED);
+    mask_set(&rawUnknown, seat, occ == OCC_UNKNOWN);
+}
+
+void SeatDebounce_SetRawMasks(const SeatMask* latched, const SeatMask* occupied, const SeatMask* unknown){
+    seat_ready();
+    for(uint32_t w=0;w<SEAT_MASK_WORDS;w++){
+        rawLatch.w[w] = latched->w[w];
+        rawUnknown.w[w] = unknown->w[w];
+        rawOcc.w[w] = occupied->w[w] & ~unknown->w[w];
+    }
+}
+
+void SeatDebounce_10ms(void){
+    const CalParams* cal = NvM_GetCal();
+    const uint16_t latchOn = ms_to_ticks(cal->latch_on_delay_ms);
+    const uint16_t unlatchOn = ms_to_ticks(cal->unlatch_on_delay_ms);
+    const uint16_t occDebounce = ms_to_ticks(cal->occupancy_debounce_ms);
+    seat_ready();
+
+    for(uint32_t w=0;w<SEAT_MASK_WORDS;w++){
+        const uint32_t raw = rawLatch.w[w];
+        const uint32_t latchPending = raw ^ filtLatch.w[w];
+        const uint32_t occPending = (rawOcc.w[w] ^ filtOcc.w[w]) | (rawUnknown.w[w] ^ filtUnknown.w[w]);
+        // only seats with a pending change or a counter still to clear are visited
+        uint32_t visit = latchPending | occPending | latchCounting.w[w] | occCounting.w[w];
+        uint32_t latchDue = 0, occDue = 0;
+
+        while(visit){
+            const uint32_t j = ctz32(visit);
+            const uint32_t i = w * 32u + j;
+            visit &= visit - 1u;
+
+            uint16_t l = ((latchPending >> j) & 1u) ? (uint16_t)(latchTicks[i] + 1u) : 0u;
+            if(l != 0u && l >= (((raw >> j) & 1u) ? latchOn : unlatchOn)){ latchDue |= 1u << j; l = 0; }
+            latchTicks[i] = l;
+
+            uint16_t o = ((occPending >> j) & 1u) ? (uint16_t)(occTicks[i] + 1u) : 0u;
+            if(o != 0u && o >= occDebounce){ occDue |= 1u << j; o = 0; }
+            occTicks[i] = o;
+        }
+
+        latchCounting.w[w] = latchPending & ~latchDue;
+        occCounting.w[w] = occPending & ~occDue;
+        filtLatch.w[w] ^= latchDue;
+        filtOcc.w[w] = (filtOcc.w[w] & ~occDue) | (rawOcc.w[w] & occDue);
+        filtUnknown.w[w] = (filtUnknown.w[w] & ~occDue) | (rawUnknown.w[w] & occDue);
+    }
+
+    for(uint32_t w=0;w<SEAT_MASK_WORDS;w++){
+        uint32_t first = w * 32u;
+        uint32_t inUse = seatCount <= first ? 0u : (seatCount - first >= 32u ? 0xFFFFFFFFu : ((1u << (seatCount - first)) - 1u));
+        warning.w[w] = filtOcc.w[w] & ~filtLatch.w[w] & inUse;
+    }
+}
+
+bool SeatDebounce_GetLatch(uint8_t seat){
+    seat_ready();
+    return seat < SEAT_MAX_SEATS ? mask_get(&filtLatch, seat) : true;
+}
+
+OccupancyState SeatDebounce_GetOccupancy(uint8_t seat){
+    seat_ready();
+    if(seat >= SEAT_MAX_SEATS) return OCC_UNKNOWN;
+    if(mask_get(&filtUnknown, seat)) return OCC_UNKNOWN;
+    return mask_get(&filtOcc, seat) ? OCC_OCCUPIED : OCC_EMPTY;
+}
+
+const SeatMask* SeatDebounce_GetWarningMask(void){ seat_ready(); return &warning; }
@@ -0,0 +1,36 @@
+#ifndef SEAT_DEBOUNCE_H
+#define SEAT_DEBOUNCE_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "Rte.h"
+
+// Latch and occupancy debounce for all seats of a vehicle in one pass per 10 ms tick.
+// Raw and filtered states are bit planes (one bit per seat, 32 seats per word), the delay
+// counters are per-seat tick arrays. Timing is the CalParams debounce of the driver seat:
+//   latch     filtered follows raw once raw has been stable latch_on_delay_ms (latching)
+//             or unlatch_on_delay_ms (unlatching)
+//   occupancy filtered follows raw once raw has differed from it for occupancy_debounce_ms
+// Every seat starts latched and empty, so a seat without sensors never warns.
+
+#define SEAT_MAX_SEATS   64u            // coach variants have up to 60
+#define SEAT_MASK_WORDS  (SEAT_MAX_SEATS / 32u)
+#define SEAT_DRIVER      0u
+
+typedef struct { uint32_t w[SEAT_MASK_WORDS]; } SeatMask;     // bit (seat % 32) of w[seat / 32]
+
+void SeatDebounce_Init(uint8_t seat_count);                   // default: driver seat only
+uint8_t SeatDebounce_GetSeatCount(void);
+
+void SeatDebounce_SetRawLatch(uint8_t seat, bool latched);
+void SeatDebounce_SetRawOccupancy(uint8_t seat, OccupancyState occ);
+// Packed inputs as received from a seat module frame; `unknown` overrides `occupied`
+void SeatDebounce_SetRawMasks(const SeatMask* latched, const SeatMask* occupied, const SeatMask* unknown);
+
+void SeatDebounce_10ms(void);
+
+bool SeatDebounce_GetLatch(uint8_t seat);
+OccupancyState SeatDebounce_GetOccupancy(uint8_t seat);
+// Seats that are (filtered) occupied and unlatched, updated by SeatDebounce_10ms
+const SeatMask* SeatDebounce_GetWarningMask(void);
+
+#endif // SEAT_DEBOUNCE_H
@@ -11,11 +11,13 @@ void SeatbeltWarning_Logic_Init(void){
 
 void SeatbeltWarning_Logic_10ms(void){
     const CalParams* cal = NvM_GetCal();
-    RteBoolSignal latch = Rte_Read_SeatbeltLatchFiltered();
-    RteOccupancySignal occ = Rte_Read_OccupancyFiltered();
-    RteSpeedSignal spd = Rte_Read_VehicleSpeed();
-    RteIgnitionSignal ign = Rte_Read_IgnitionState();
-    RteBoolSignal door = Rte_Read_DoorClosed();
+    Rte_SBW_Inputs in;
+    Rte_Read_SBW_Inputs(&in); // one coherent snapshot of all inputs
+    RteBoolSignal latch = in.seatbeltLatch;
+    RteOccupancySignal occ = in.occupancy;
+    RteSpeedSignal spd = in.speed;
+    RteIgnitionSignal ign = in.ignition;
+    RteBoolSignal door = in.doorClosed;
 
     if(doorGraceRemaining > 0){
         if(door.value && door.validity == VALIDITY_VALID){
@@ -45,9 +47,16 @@ void SeatbeltWarning_Logic_10ms(void){
     }
 
     Rte_Write_SBW_WarningRequest(output);
+}
 
+void SeatbeltWarning_Logic_100ms(void){
     // Logging demo
-    if(g_time_ms % 100 == 0){
-        printf("[TIME %5u] IGN=%d SPD=%u OCC=%d LATCH=%d DOOR=%d GRACE=%u WARN=%u\n", g_time_ms, ign.value, spd.value, occ.value, latch.value, door.value, doorGraceRemaining, output);
-    }
+    Rte_SBW_Inputs in;
+    Rte_Read_SBW_Inputs(&in); // one coherent snapshot of all inputs
+    RteBoolSignal latch = in.seatbeltLatch;
+    RteOccupancySignal occ = in.occupancy;
+    RteSpeedSignal spd = in.speed;
+    RteIgnitionSignal ign = in.ignition;
+    RteBoolSignal door = in.doorClosed;
+    printf("[TIME %5u] IGN=%d SPD=%u OCC=%d LATCH=%d DOOR=%d GRACE=%u WARN=%u\n", g_time_ms, ign.value, spd.value, occ.value, latch.value, door.value, doorGraceRemaining, Rte_Get_WarningRequest());
 }
@@ -1,26 +1,17 @@
 #include "Rte.h"
 #include "Dem.h"
-#include "NvM.h"
+#include "SeatDebounce.h"
 #include <stdint.h>
 #include <stdbool.h>
 
-// Raw input simulation variable (would come from IoHwAb)
+// Raw input simulation variable (would come from IoHwAb); debounced by SeatDebounce_10ms
 static bool rawLatch = true; // true = latched
-static uint16_t latch_timer_ms = 0;
-static uint16_t unlatch_timer_ms = 0;
-static bool filteredLatch = true;
 
-void Seatbelt_Sensor_IF_SetRaw(bool v){ rawLatch = v; }
+void Seatbelt_Sensor_IF_SetRaw(bool v){ rawLatch = v; SeatDebounce_SetRawLatch(SEAT_DRIVER, v); }
 
+// Driver seat view of the seat debounce engine (runs after SeatDebounce_10ms)
 void Seatbelt_Sensor_IF_10ms(void){
-    const CalParams* cal = NvM_GetCal();
-    if(rawLatch){
-        latch_timer_ms += 10; unlatch_timer_ms = 0;
-        if(latch_timer_ms >= cal->latch_on_delay_ms){ filteredLatch = true; }
-    } else {
-        unlatch_timer_ms += 10; latch_timer_ms = 0;
-        if(unlatch_timer_ms >= cal->unlatch_on_delay_ms){ filteredLatch = false; }
-    }
+    bool filteredLatch = SeatDebounce_GetLatch(SEAT_DRIVER);
 
     // Stuck detection simplistic: if always same state > 5000 ms report prefailed
     static uint32_t same_state_ms = 0;
@@ -1,12 +1,99 @@
 #include "Crc.h"
+#include "Crc_Tables.h"
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+#define CRC16_INIT           0xFFFFu
+#define CRC32_INIT           0xFFFFFFFFu
+#define CRC32_XOR_OUT        0xFFFFFFFFu
+#define CRC8_INIT            0xFFu
+#define CRC8_XOR_OUT         0xFFu
+
+static uint32_t load32_le(const uint8_t* p){
+    return (uint32_t)p[0] | ((uint32_t)p[1]<<8) | ((uint32_t)p[2]<<16) | ((uint32_t)p[3]<<24);
+}
+
+// ---- CRC-16 ----
+
+uint16_t Crc16_Init(void){ return CRC16_INIT; }
+
+uint16_t Crc16_Update(uint16_t crc, const void* data, uint32_t len){
+    const uint8_t* p = (const uint8_t*)data;
+    while(len >= 8u){
+        uint32_t lo = load32_le(p) ^ crc;
+        uint32_t hi = load32_le(p+4);
+        crc = (uint16_t)(crc16_table[7][lo & 0xFFu] ^ crc16_table[6][(lo>>8) & 0xFFu] ^
+                         crc16_table[5][(lo>>16) & 0xFFu] ^ crc16_table[4][lo>>24] ^
+                         crc16_table[3][hi & 0xFFu] ^ crc16_table[2][(hi>>8) & 0xFFu] ^
+                         crc16_table[1][(hi>>16) & 0xFFu] ^ crc16_table[0][hi>>24]);
+        p += 8; len -= 8u;
+    }
+    while(len--){
+        crc = (uint16_t)((crc>>8) ^ crc16_table[0][(crc ^ *p++) & 0xFFu]);
+    }
+    return crc;
+}
+
+uint16_t Crc16_Final(uint16_t crc){ return crc; }
+
 uint16_t Crc16_Calc(const void* data, uint32_t len){
+    return Crc16_Final(Crc16_Update(Crc16_Init(), data, len));
+}
+
+// ---- CRC-32 ----
+
+uint32_t Crc32_Init(void){ return CRC32_INIT; }
+
+uint32_t Crc32_Update(uint32_t crc, const void* data, uint32_t len){
+    const uint8_t* p = (const uint8_t*)data;
+#if defined(__ARM_FEATURE_CRC32)
+    while(len >= 8u){
+        uint64_t v = (uint64_t)load32_le(p) | ((uint64_t)load32_le(p+4) << 32);
+        crc = __crc32d(crc, v);
+        p += 8; len -= 8u;
+    }
+    while(len--){
+        crc = __crc32b(crc, *p++);
+    }
+#else
+    while(len >= 8u){
+        uint32_t lo = load32_le(p) ^ crc;
+        uint32_t hi = load32_le(p+4);
+        crc = crc32_table[7][lo & 0xFFu] ^ crc32_table[6][(lo>>8) & 0xFFu] ^
+              crc32_table[5][(lo>>16) & 0xFFu] ^ crc32_table[4][lo>>24] ^
+              crc32_table[3][hi & 0xFFu] ^ crc32_table[2][(hi>>8) & 0xFFu] ^
+              crc32_table[1][(hi>>16) & 0xFFu] ^ crc32_table[0][hi>>24];
+        p += 8; len -= 8u;
+    }
+    while(len--){
+        crc = (crc>>8) ^ crc32_table[0][(crc ^ *p++) & 0xFFu];
+    }
+#endif
+    return crc;
+}
+
+uint32_t Crc32_Final(uint32_t crc){ return crc ^ CRC32_XOR_OUT; }
+
+uint32_t Crc32_Calc(const void* data, uint32_t len){
+    return Crc32_Final(Crc32_Update(Crc32_Init(), data, len));
+}
+
+// ---- CRC-8 SAE J1850 ----
+
+uint8_t Crc8_Init(void){ return CRC8_INIT; }
+
+uint8_t Crc8_Update(uint8_t crc, const void* data, uint32_t len){
     const uint8_t* p = (const uint8_t*)data;
-    uint16_t crc=0xFFFF;
-    for(uint32_t i=0;i<len;i++){
-        crc ^= p[i];
-        for(int j=0;j<8;j++){
-            if(crc & 1) crc = (crc>>1) ^ 0xA001; else crc >>=1;
-        }
+    while(len--){
+        crc = crc8_table[crc ^ *p++];
     }
     return crc;
 }
+
+uint8_t Crc8_Final(uint8_t crc){ return (uint8_t)(crc ^ CRC8_XOR_OUT); }
+
+uint8_t Crc8_Calc(const void* data, uint32_t len){
+    return Crc8_Final(Crc8_Update(Crc8_Init(), data, len));
+}
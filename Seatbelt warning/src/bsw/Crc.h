@@ -1,5 +1,36 @@
 #ifndef CRC_H
 #define CRC_H
 #include <stdint.h>
+
+// Table-driven CRC routines shared by the BSW (NvM blocks, E2E protection).
+//
+//   CRC-16  reflected 0x8005 (0xA001), init 0xFFFF, no final xor (CRC-16/MODBUS)
+//   CRC-32  reflected 0x04C11DB7, init/xor 0xFFFFFFFF (IEEE 802.3, AUTOSAR Crc_CalculateCRC32)
+//   CRC-8   0x1D, init/xor 0xFF (SAE J1850, AUTOSAR Crc_CalculateCRC8, E2E Profile 1/2)
+//
+// Each variant has a one-shot Calc and a streaming Init/Update/Final triple:
+//   crc = CrcXX_Init(); crc = CrcXX_Update(crc, a, n); ...; result = CrcXX_Final(crc);
+// gives the same result as CrcXX_Calc over the concatenated data.
+//
+// CRC-16 and CRC-32 process 8 bytes per step (slice-by-8), CRC-8 one byte per
+// table lookup. On ARMv8 with the CRC extension (__ARM_FEATURE_CRC32, e.g.
+// -march=armv8-a+crc) CRC-32 uses the CRC32 instructions instead of the tables.
+// The tables are const arrays generated by tools/gen_crc_tables.py (Crc_Tables.h),
+// so they sit in flash and need no initialization.
+
 uint16_t Crc16_Calc(const void* data, uint32_t len);
+uint16_t Crc16_Init(void);
+uint16_t Crc16_Update(uint16_t crc, const void* data, uint32_t len);
+uint16_t Crc16_Final(uint16_t crc);
+
+uint32_t Crc32_Calc(const void* data, uint32_t len);
+uint32_t Crc32_Init(void);
+uint32_t Crc32_Update(uint32_t crc, const void* data, uint32_t len);
+uint32_t Crc32_Final(uint32_t crc);
+
+uint8_t Crc8_Calc(const void* data, uint32_t len);
+uint8_t Crc8_Init(void);
+uint8_t Crc8_Update(uint8_t crc, const void* data, uint32_t len);
+uint8_t Crc8_Final(uint8_t crc);
+
 #endif // CRC_H
@@ -1,7 +1,21 @@
 #include "Dem.h"
+#include "NvM.h"
 #include <stdio.h>
 
+DemNvData Dem_NvData;
+
 void Dem_ReportErrorStatus(uint16_t dtc, uint8_t status){
     const char* s = status==DEM_EVENT_STATUS_PASSED?"PASSED":"PREFAILED";
     printf("[DEM] DTC 0x%04X status %s\n", dtc, s);
+
+    uint16_t idx = (uint16_t)(dtc - DEM_DTC_FIRST);
+    if(status == DEM_EVENT_STATUS_PREFAILED && idx < DEM_NUM_EVENTS && NvM_ValidateBlock(NVM_BLOCK_DEM_EVENTS)){
+        if(Dem_NvData.occurrence[idx] < UINT8_MAX) Dem_NvData.occurrence[idx]++;
+        (void)NvM_WriteBlock(NVM_BLOCK_DEM_EVENTS);
+    }
+}
+
+uint8_t Dem_GetOccurrenceCounter(uint16_t dtc){
+    uint16_t idx = (uint16_t)(dtc - DEM_DTC_FIRST);
+    return idx < DEM_NUM_EVENTS ? Dem_NvData.occurrence[idx] : 0u;
 }
@@ -13,4 +13,15 @@ void Dem_ReportErrorStatus(uint16_t dtc, uint8_t status);
 #define DTC_PLAUSIBILITY_CONFLICT 0x1003
 #define DTC_VEHICLESTATE_STALE 0x1004
 
+// Occurrence counters of the DTCs above, kept in NvM block NVM_BLOCK_DEM_EVENTS
+#define DEM_DTC_FIRST DTC_SEATBELT_STUCK
+#define DEM_NUM_EVENTS 4u
+
+typedef struct {
+    uint8_t occurrence[DEM_NUM_EVENTS];   // PREFAILED reports, saturating
+} DemNvData;
+
+extern DemNvData Dem_NvData;
+uint8_t Dem_GetOccurrenceCounter(uint16_t dtc);
+
 #endif // DEM_H
@@ -0,0 +1,29 @@
+#include "Fee.h"
+#include <stdbool.h>
+#include <string.h>
+
+static uint8_t storage[FEE_SIZE_BYTES];
+static bool formatted = false;
+
+static void fee_format(void){
+    if(!formatted){ memset(storage, 0xFF, sizeof(storage)); formatted = true; }
+}
+
+int Fee_Read(uint16_t offset, void* data, uint16_t len){
+    fee_format();
+    if((uint32_t)offset + len > FEE_SIZE_BYTES) return 0;
+    memcpy(data, &storage[offset], len);
+    return 1;
+}
+
+int Fee_Write(uint16_t offset, const void* data, uint16_t len){
+    fee_format();
+    if((uint32_t)offset + len > FEE_SIZE_BYTES) return 0;
+    memcpy(&storage[offset], data, len);
+    return 1;
+}
+
+uint8_t* Fee_SimStorage(void){
+    fee_format();
+    return storage;
+}
@@ -0,0 +1,16 @@
+#ifndef FEE_H
+#define FEE_H
+#include <stdint.h>
+
+// Flash EEPROM emulation stub: a byte-addressable non-volatile area backed by RAM.
+// Starts erased (0xFF) on every run.
+
+#define FEE_SIZE_BYTES 512u
+
+int Fee_Read(uint16_t offset, void* data, uint16_t len);        // 1 = ok
+int Fee_Write(uint16_t offset, const void* data, uint16_t len); // 1 = ok
+
+// Simulation only: direct access for fault injection
+uint8_t* Fee_SimStorage(void);
+
+#endif // FEE_H
@@ -1,6 +1,19 @@
 #include "NvM.h"
+#include "Crc.h"
+#include "Dem.h"
+#include "Fee.h"
+#include <stdbool.h>
 #include <string.h>
 
+static const CalParams cal_defaults = {
+    .latch_on_delay_ms = 50,
+    .unlatch_on_delay_ms = 500,
+    .occupancy_debounce_ms = 300,
+    .speed_threshold_kph = 10,
+    .door_grace_ms = 2000
+};
+
+// RAM mirror; holds the defaults until the block is loaded
 static CalParams cal = {
     .latch_on_delay_ms = 50,
     .unlatch_on_delay_ms = 500,
@@ -11,11 +24,210 @@ static CalParams cal = {
 
 const CalParams* NvM_GetCal(void){ return &cal; }
 
-// Use external Crc16_Calc defined in Crc.c
+// ---- Block descriptor table ----
 
-int NvM_ValidateCal(void){
-    // Placeholder: always valid
-    uint16_t crc = Crc16_Calc(&cal, sizeof(cal));
-    (void)crc; // could compare with stored reference
+#define NVM_FLAG_STARTUP   0x01u    // loaded synchronously in NvM_Init
+
+// Stored copy: write counter, CRC-32 over counter and data, data
+#define NVM_COPY_HEADER    8u
+#define NVM_COPY_SIZE(len) (NVM_COPY_HEADER + (len))
+#define NVM_MAX_BLOCK_LEN  64u
+
+typedef struct {
+    void* ram;              // RAM mirror
+    const void* rom;        // defaults; NULL = zeros
+    uint16_t len;
+    uint16_t offset;        // Fee offset of copy 0, copy 1 follows
+    uint8_t priority;       // job priority, 0 = highest
+    uint8_t flags;
+} NvM_BlockDescriptor;
+
+#define NVM_CAL_OFFSET 0u
+#define NVM_DEM_OFFSET (NVM_CAL_OFFSET + 2u * NVM_COPY_SIZE(sizeof(CalParams)))
+#define NVM_END_OFFSET (NVM_DEM_OFFSET + 2u * NVM_COPY_SIZE(sizeof(DemNvData)))
+
+_Static_assert(NVM_END_OFFSET <= FEE_SIZE_BYTES, "NvM blocks exceed the Fee area");
+_Static_assert(sizeof(CalParams) <= NVM_MAX_BLOCK_LEN && sizeof(DemNvData) <= NVM_MAX_BLOCK_LEN,
+               "NvM block larger than NVM_MAX_BLOCK_LEN");
+
+static const NvM_BlockDescriptor blocks[NVM_BLOCK_COUNT] = {
+    [NVM_BLOCK_CAL]        = { &cal, &cal_defaults, sizeof(CalParams), NVM_CAL_OFFSET, 0u, NVM_FLAG_STARTUP },
+    [NVM_BLOCK_DEM_EVENTS] = { &Dem_NvData, NULL, sizeof(DemNvData), NVM_DEM_OFFSET, 2u, 0u },
+};
+
+typedef struct {
+    bool loaded;
+    uint8_t primary;        // copy with the newest valid content
+    uint32_t counter;       // write counter of the RAM mirror content
+    NvM_RequestResultType result;
+} NvM_BlockState;
+
+static NvM_BlockState state[NVM_BLOCK_COUNT];
+
+// ---- Job queue ----
+
+typedef enum { NVM_JOB_VERIFY, NVM_JOB_WRITE } NvM_JobType;
+
+typedef struct {
+    NvM_BlockIdType block;
+    NvM_JobType type;
+    uint16_t seq;           // FIFO order within a priority
+} NvM_Job;
+
+#define NVM_QUEUE_SIZE 8u
+
+static NvM_Job queue[NVM_QUEUE_SIZE];
+static uint8_t queue_len = 0;
+static uint16_t queue_seq = 0;
+
+static bool nvm_enqueue(NvM_BlockIdType block, NvM_JobType type){
+    for(uint8_t i=0;i<queue_len;i++){
+        if(queue[i].block == block && queue[i].type == type) return true; // already queued
+    }
+    if(queue_len >= NVM_QUEUE_SIZE) return false;
+    queue[queue_len].block = block;
+    queue[queue_len].type = type;
+    queue[queue_len].seq = queue_seq++;
+    queue_len++;
+    return true;
+}
+
+static bool nvm_dequeue(NvM_Job* job){
+    uint8_t best = 0;
+    if(queue_len == 0) return false;
+    for(uint8_t i=1;i<queue_len;i++){
+        uint8_t pi = blocks[queue[i].block].priority, pb = blocks[queue[best].block].priority;
+        if(pi < pb || (pi == pb && (int16_t)(queue[i].seq - queue[best].seq) < 0)) best = i;
+    }
+    *job = queue[best];
+    queue[best] = queue[--queue_len];
+    return true;
+}
+
+// ---- Block I/O ----
+
+static uint32_t nvm_copy_crc(uint32_t counter, const void* data, uint16_t len){
+    uint8_t c[4] = { (uint8_t)counter, (uint8_t)(counter>>8), (uint8_t)(counter>>16), (uint8_t)(counter>>24) };
+    uint32_t crc = Crc32_Update(Crc32_Init(), c, sizeof(c));
+    return Crc32_Final(Crc32_Update(crc, data, len));
+}
+
+static uint16_t nvm_copy_offset(NvM_BlockIdType block, uint8_t copy){
+    return (uint16_t)(blocks[block].offset + copy * NVM_COPY_SIZE(blocks[block].len));
+}
+
+// Read one copy into data; true if its CRC matches
+static bool nvm_read_copy(NvM_BlockIdType block, uint8_t copy, void* data, uint32_t* counter){
+    const NvM_BlockDescriptor* d = &blocks[block];
+    uint32_t header[2];
+    uint16_t off = nvm_copy_offset(block, copy);
+    if(!Fee_Read(off, header, sizeof(header)) || !Fee_Read((uint16_t)(off + NVM_COPY_HEADER), data, d->len)) return false;
+    *counter = header[0];
+    return nvm_copy_crc(header[0], data, d->len) == header[1];
+}
+
+static bool nvm_write_copy(NvM_BlockIdType block, uint8_t copy, uint32_t counter){
+    const NvM_BlockDescriptor* d = &blocks[block];
+    uint32_t header[2] = { counter, nvm_copy_crc(counter, d->ram, d->len) };
+    uint16_t off = nvm_copy_offset(block, copy);
+    return Fee_Write((uint16_t)(off + NVM_COPY_HEADER), d->ram, d->len) && Fee_Write(off, header, sizeof(header));
+}
+
+// Load the newest valid copy into the RAM mirror, or the defaults if neither is valid
+static void nvm_load(NvM_BlockIdType block){
+    const NvM_BlockDescriptor* d = &blocks[block];
+    NvM_BlockState* s = &state[block];
+    uint8_t data[2][NVM_MAX_BLOCK_LEN];
+    uint32_t counter[2];
+    bool valid[2];
+
+    for(uint8_t c=0;c<2;c++) valid[c] = nvm_read_copy(block, c, data[c], &counter[c]);
+
+    if(valid[0] || valid[1]){
+        uint8_t best = (valid[0] && (!valid[1] || (int32_t)(counter[0] - counter[1]) >= 0)) ? 0u : 1u;
+        memcpy(d->ram, data[best], d->len);
+        s->primary = best;
+        s->counter = counter[best];
+        if(valid[0] && valid[1] && counter[0] == counter[1]){
+            s->result = NVM_REQ_OK;
+        } else {
+            s->result = NVM_REQ_REDUNDANCY_LOST;
+            (void)nvm_enqueue(block, NVM_JOB_WRITE);
+        }
+    } else {
+        if(d->rom) memcpy(d->ram, d->rom, d->len); else memset(d->ram, 0, d->len);
+        s->primary = 1u;
+        s->counter = 0u;
+        s->result = NVM_REQ_RESTORED_DEFAULTS;
+        (void)nvm_enqueue(block, NVM_JOB_WRITE);
+    }
+    s->loaded = true;
+}
+
+// Write both copies, the one not holding the newest content first, so that an
+// interrupted write always leaves one valid copy behind
+static void nvm_store(NvM_BlockIdType block){
+    NvM_BlockState* s = &state[block];
+    uint8_t first = (uint8_t)(s->primary ^ 1u);
+    uint32_t counter = s->counter + 1u;
+
+    if(nvm_write_copy(block, first, counter) && nvm_write_copy(block, s->primary, counter)){
+        s->counter = counter;
+        s->primary = first;
+        s->result = NVM_REQ_OK;
+    } else {
+        s->result = NVM_REQ_NOT_OK;
+    }
+}
+
+// ---- API ----
+
+void NvM_Init(void){
+    queue_len = 0;
+    memset(state, 0, sizeof(state));
+    for(NvM_BlockIdType b=0;b<NVM_BLOCK_COUNT;b++){
+        if(blocks[b].flags & NVM_FLAG_STARTUP){
+            nvm_load(b);
+        } else {
+            state[b].result = NVM_REQ_PENDING;
+            (void)nvm_enqueue(b, NVM_JOB_VERIFY);
+        }
+    }
+}
+
+void NvM_MainFunction(void){
+    NvM_Job job;
+    if(!nvm_dequeue(&job)) return;
+    if(job.type == NVM_JOB_VERIFY){
+        if(!state[job.block].loaded) nvm_load(job.block);
+    } else {
+        nvm_store(job.block);
+    }
+}
+
+int NvM_ValidateBlock(NvM_BlockIdType block){
+    if(block >= NVM_BLOCK_COUNT) return 0;
+    if(!state[block].loaded) nvm_load(block);
+    return state[block].result != NVM_REQ_NOT_OK;
+}
+
+int NvM_WriteBlock(NvM_BlockIdType block){
+    if(block >= NVM_BLOCK_COUNT) return 0;
+    if(!state[block].loaded) nvm_load(block);   // keep counter and copy order consistent
+    if(!nvm_enqueue(block, NVM_JOB_WRITE)){
+        state[block].result = NVM_REQ_NOT_OK;
+        return 0;
+    }
+    state[block].result = NVM_REQ_PENDING;
     return 1;
 }
+
+NvM_RequestResultType NvM_GetErrorStatus(NvM_BlockIdType block){
+    return block < NVM_BLOCK_COUNT ? state[block].result : NVM_REQ_NOT_OK;
+}
+
+uint8_t NvM_GetPendingJobs(void){ return queue_len; }
+
+int NvM_ValidateCal(void){
+    return NvM_ValidateBlock(NVM_BLOCK_CAL);
+}
@@ -10,6 +10,31 @@ typedef struct {
     uint16_t door_grace_ms;        // 2000 ms
 } CalParams;
 
+// Blocks of the NvM descriptor table (NvM.c)
+typedef uint8_t NvM_BlockIdType;
+#define NVM_BLOCK_CAL        0u     // CalParams, needed in the first cycle
+#define NVM_BLOCK_DEM_EVENTS 1u     // Dem occurrence counters, verified in the background
+#define NVM_BLOCK_COUNT      2u
+
+typedef enum {
+    NVM_REQ_OK = 0,
+    NVM_REQ_PENDING,                // verify or write queued
+    NVM_REQ_NOT_OK,                 // write failed or job queue full
+    NVM_REQ_REDUNDANCY_LOST,        // one copy bad; loaded from the other, repair queued
+    NVM_REQ_RESTORED_DEFAULTS       // both copies bad; defaults loaded, write queued
+} NvM_RequestResultType;
+
+// Each block is stored twice, each copy with a write counter and a CRC-32.
+// Startup blocks are loaded into their RAM mirror by NvM_Init; the others are
+// verified by NvM_MainFunction, or on first use through NvM_ValidateBlock.
+void NvM_Init(void);
+void NvM_MainFunction(void);        // one queued job per call, highest priority first
+
+int NvM_ValidateBlock(NvM_BlockIdType block);  // loads the block now if still pending; 1 = RAM mirror usable
+int NvM_WriteBlock(NvM_BlockIdType block);     // queue a write of the RAM mirror; 0 = queue full
+NvM_RequestResultType NvM_GetErrorStatus(NvM_BlockIdType block);
+uint8_t NvM_GetPendingJobs(void);
+
 const CalParams* NvM_GetCal(void);
 uint16_t Crc16_Calc(const void* data, uint32_t len);
 int NvM_ValidateCal(void);
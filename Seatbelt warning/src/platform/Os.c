@@ -0,0 +1,91 @@
+#define _POSIX_C_SOURCE 200112L
+#include "Os.h"
+#include "Rte.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static const Os_TaskConfig* os_tasks;
+static uint8_t os_task_count;
+static Os_TimeMode os_mode;
+static Os_TaskStats os_stats[OS_MAX_TASKS];
+static bool os_disabled[OS_MAX_TASKS];
+
+static uint64_t os_now_us(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+static void os_sleep_until_us(uint64_t t_us){
+    struct timespec ts;
+    ts.tv_sec = (time_t)(t_us / 1000000u);
+    ts.tv_nsec = (long)((t_us % 1000000u) * 1000u);
+    while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0){ /* EINTR: sleep again */ }
+}
+
+void Os_Init(const Os_TaskConfig* tasks, uint8_t count, Os_TimeMode mode){
+    os_tasks = tasks;
+    os_task_count = count < OS_MAX_TASKS ? count : OS_MAX_TASKS;
+    os_mode = mode;
+    memset(os_stats, 0, sizeof(os_stats));
+    memset(os_disabled, 0, sizeof(os_disabled));
+}
+
+bool Os_DisableTask(const char* name){
+    for(uint8_t i=0;i<os_task_count;i++){
+        if(strcmp(os_tasks[i].name, name) == 0){
+            os_disabled[i] = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void os_run_task(uint8_t i, uint64_t release_us){
+    const Os_TaskConfig* t = &os_tasks[i];
+    Os_TaskStats* s = &os_stats[i];
+    uint64_t start = os_now_us();
+
+    if(os_mode == OS_TIME_REALTIME && start > release_us + OS_TICK_MS * 1000u) s->late_starts++;
+    for(const Os_Runnable* r = t->runnables; *r != NULL; r++) (*r)();
+
+    uint32_t exec = (uint32_t)(os_now_us() - start);
+    s->activations++;
+    s->total_exec_us += exec;
+    if(exec > s->max_exec_us) s->max_exec_us = exec;
+    if(exec > t->budget_us) s->overruns++;
+}
+
+void Os_Run(uint32_t duration_ms, Os_TickHook pre, Os_TickHook post){
+    uint64_t epoch_us = os_now_us();
+    for(uint32_t now=0; now<=duration_ms; now+=OS_TICK_MS){
+        uint64_t release_us = epoch_us + (uint64_t)now * 1000u;
+        if(os_mode == OS_TIME_REALTIME) os_sleep_until_us(release_us);
+
+        g_time_ms = now;
+        if(pre) pre(now);
+        // table order is priority order: list the shortest periods first
+        for(uint8_t i=0;i<os_task_count;i++){
+            const Os_TaskConfig* t = &os_tasks[i];
+            if(os_disabled[i]) continue;
+            if(now >= t->offset_ms && (now - t->offset_ms) % t->period_ms == 0) os_run_task(i, release_us);
+        }
+        if(post) post(now);
+    }
+}
+
+const Os_TaskStats* Os_GetTaskStats(uint8_t task){
+    return task < os_task_count ? &os_stats[task] : NULL;
+}
+
+void Os_PrintStats(void){
+    printf("%-12s %6s %10s %8s %8s %9s %5s\n", "Task", "Period", "Activation", "Avg[us]", "Max[us]", "Overruns", "Late");
+    for(uint8_t i=0;i<os_task_count;i++){
+        const Os_TaskStats* s = &os_stats[i];
+        if(os_disabled[i]) continue;
+        printf("%-12s %4ums %10u %8.1f %8u %9u %5u\n", os_tasks[i].name, os_tasks[i].period_ms, s->activations,
+               s->activations ? (double)s->total_exec_us / s->activations : 0.0, s->max_exec_us, s->overruns,
+               s->late_starts);
+    }
+}
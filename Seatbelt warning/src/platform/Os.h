@@ -0,0 +1,46 @@
+#ifndef OS_H
+#define OS_H
+#include <stdint.h>
+#include <stdbool.h>
+
+// Time-triggered scheduler for the simulation: a static table of periodic tasks,
+// each a NULL-terminated list of runnables, driven by a common base tick.
+//
+// OS_TIME_REALTIME sleeps to absolute tick deadlines on CLOCK_MONOTONIC.
+// OS_TIME_VIRTUAL runs the ticks back to back (as fast as possible); execution
+// times and budgets are still measured in wall-clock time.
+
+typedef void (*Os_Runnable)(void);
+
+typedef struct {
+    const char* name;
+    uint16_t period_ms;         // multiple of OS_TICK_MS
+    uint16_t offset_ms;         // first activation
+    uint32_t budget_us;         // execution time deadline per activation
+    const Os_Runnable* runnables;
+} Os_TaskConfig;
+
+typedef struct {
+    uint32_t activations;
+    uint32_t overruns;          // activations exceeding budget_us
+    uint32_t late_starts;       // real-time mode: released more than one tick late
+    uint32_t max_exec_us;
+    uint64_t total_exec_us;
+} Os_TaskStats;
+
+typedef enum { OS_TIME_REALTIME, OS_TIME_VIRTUAL } Os_TimeMode;
+
+#define OS_TICK_MS   5u
+#define OS_MAX_TASKS 8u
+
+typedef void (*Os_TickHook)(uint32_t now_ms);
+
+void Os_Init(const Os_TaskConfig* tasks, uint8_t count, Os_TimeMode mode);
+// Stop activating the named task (after Os_Init; repeat calls are harmless); false if there is no such task
+bool Os_DisableTask(const char* name);
+// Run ticks 0 .. duration_ms; pre runs before the tasks of a tick, post after them (either may be NULL)
+void Os_Run(uint32_t duration_ms, Os_TickHook pre, Os_TickHook post);
+const Os_TaskStats* Os_GetTaskStats(uint8_t task);
+void Os_PrintStats(void);
+
+#endif // OS_H
@@ -0,0 +1,46 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+#include <stdint.h>
+
+// Timed stimulus/expectation list driving the simulated inputs.
+//
+// Text format, one event per line, '#' starts a comment:
+//   <time_ms> <signal> <value>
+//   duration <ms>
+// signals: ignition (0/1), door (1 = closed), occupancy (0 empty, 1 occupied, 2 unknown),
+//          latch (1 = latched), speed (km/h), expect_warn (checked after the tasks of that tick)
+// Events must be listed in time order.
+
+typedef enum {
+    SCN_IGNITION,
+    SCN_DOOR,
+    SCN_OCCUPANCY,
+    SCN_LATCH,
+    SCN_SPEED,
+    SCN_EXPECT_WARN
+} ScenarioSignal;
+
+typedef struct {
+    uint32_t time_ms;
+    ScenarioSignal signal;
+    uint16_t value;
+} ScenarioEvent;
+
+#define SCENARIO_MAX_EVENTS 256u
+
+typedef struct {
+    ScenarioEvent events[SCENARIO_MAX_EVENTS];
+    uint16_t count;
+    uint16_t next_stimulus;
+    uint16_t next_expect;
+    uint32_t duration_ms;
+    uint32_t checks;
+    uint32_t failures;
+} Scenario;
+
+void Scenario_LoadDefault(Scenario* s);       // the built-in demo timeline
+int Scenario_Load(Scenario* s, const char* path);   // 1 = ok, errors printed to stderr
+void Scenario_ApplyStimuli(Scenario* s, uint32_t now_ms);
+void Scenario_CheckExpectations(Scenario* s, uint32_t now_ms);
+
+#endif // SCENARIO_H
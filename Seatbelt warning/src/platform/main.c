@@ -1,8 +1,10 @@
 #include "Rte.h"
 #include "NvM.h"
+#include "Os.h"
+#include "Scenario.h"
 #include <stdio.h>
-#include <unistd.h>
 #include "Dem.h"
+#include "SeatDebounce.h"
 #include <string.h>
 
 // Forward declarations of application runnables
@@ -10,60 +12,80 @@ void Seatbelt_Sensor_IF_10ms(void);
 void Occupancy_Sensor_IF_10ms(void);
 void VehicleState_IF_10ms(void);
 void SeatbeltWarning_Logic_10ms(void);
+void SeatbeltWarning_Logic_100ms(void);
 void SeatbeltWarning_Logic_Init(void);
 
-// Simulation scenario helpers (simulate raw inputs)
-void Seatbelt_Sensor_IF_SetRaw(bool v);
-void Occupancy_Sensor_IF_SetRaw(OccupancyState v);
-void VehicleState_IF_SetSpeed(uint16_t v);
-void VehicleState_IF_SetDoorClosed(bool v);
-void VehicleState_IF_SetIgnition(IgnitionState v);
+// Task table, highest priority (shortest period) first; budgets are 20 % of the period
+static const Os_Runnable task_5ms[] = { NvM_MainFunction, NULL };
+static const Os_Runnable task_10ms[] = {
+    // order: inputs (committed to the RTE as one SBW_Inputs group) then logic
+    Rte_Begin_SBW_Inputs, SeatDebounce_10ms, Seatbelt_Sensor_IF_10ms, Occupancy_Sensor_IF_10ms, VehicleState_IF_10ms,
+    Rte_Commit_SBW_Inputs, SeatbeltWarning_Logic_10ms, NULL
+};
+static const Os_Runnable task_100ms[] = { SeatbeltWarning_Logic_100ms, NULL };
 
-static void scenario_step(uint32_t t){
-    // Realistic scenario timeline for false trigger prevention demonstration
-    // 0 ms: Ignition ON, door closes (grace starts), seat occupied, belt latched
-    if(t==0){ VehicleState_IF_SetIgnition(IGN_ON); VehicleState_IF_SetDoorClosed(true); Occupancy_Sensor_IF_SetRaw(OCC_OCCUPIED); Seatbelt_Sensor_IF_SetRaw(true); VehicleState_IF_SetSpeed(0); }
-    // 500 ms: Vehicle starts moving
-    if(t==500){ VehicleState_IF_SetSpeed(12); }
-    // 1500 ms: Grace ends; conditions gated
-    // 2000 ms: User briefly wiggles belt causing 40 ms unlatch chatter (should NOT trigger)
-    if(t==2000){ Seatbelt_Sensor_IF_SetRaw(false); }
-    if(t==2040){ Seatbelt_Sensor_IF_SetRaw(true); }
-    // 4000 ms: Driver unbuckles (sustained unlatch) -> should trigger warning after debounce (500 ms)
-    if(t==4000){ Seatbelt_Sensor_IF_SetRaw(false); }
-    // 4700 ms: Debounce completes -> warning active
-    // 6000 ms: Driver re-buckles -> latch stable after 50 ms
-    if(t==6000){ Seatbelt_Sensor_IF_SetRaw(true); }
-    // 8000 ms: Seat becomes empty (occupant leaves) -> occupancy debounce 300 ms then warning suppressed
-    if(t==8000){ Occupancy_Sensor_IF_SetRaw(OCC_EMPTY); }
-    // 9000 ms: Speed drops to 0 (stop) -> gating removes warning
-    if(t==9000){ VehicleState_IF_SetSpeed(0); }
+static const Os_TaskConfig tasks[] = {
+    { "Task_5ms",   5,   0, 1000,  task_5ms },
+    { "Task_10ms",  10,  0, 2000,  task_10ms },
+    { "Task_100ms", 100, 0, 20000, task_100ms },   // trace only; disabled with --quiet
+};
+
+static Scenario scenario;
+
+static void pre_tick(uint32_t now_ms){ Scenario_ApplyStimuli(&scenario, now_ms); }
+static void post_tick(uint32_t now_ms){ Scenario_CheckExpectations(&scenario, now_ms); }
+
+static void usage(const char* prog){
+    printf("Usage: %s [--fast] [--quiet] [--scenario file.scn]\n", prog);
+    printf("  --fast      virtual time: run the ticks back to back instead of in real time\n");
+    printf("  --quiet     no 100 ms trace\n");
+    printf("  --scenario  event list to run instead of the built-in timeline\n");
 }
 
 int main(int argc, char** argv){
-    // Easter egg / quick check: print a smile and exit
+    Os_TimeMode mode = OS_TIME_REALTIME;
+    bool quiet = false;
+    const char* scenario_path = NULL;
+
     for(int i=1;i<argc;i++){
+        // Easter egg / quick check: print a smile and exit
         if(strcmp(argv[i], "--smile") == 0 || strcmp(argv[i], "smile") == 0){
             printf("\n  ^_^   Seatbelt Warning System\n");
             printf(" (o_o)  Drive safe and buckle up!\n");
             printf("  \\/   \n\n");
             return 0;
+        } else if(strcmp(argv[i], "--fast") == 0){
+            mode = OS_TIME_VIRTUAL;
+        } else if(strcmp(argv[i], "--quiet") == 0){
+            quiet = true;
+        } else if(strcmp(argv[i], "--scenario") == 0 && i+1 < argc){
+            scenario_path = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 2;
         }
     }
+
+    if(scenario_path){
+        if(!Scenario_Load(&scenario, scenario_path)) return 2;
+    } else {
+        Scenario_LoadDefault(&scenario);
+    }
+
+    NvM_Init();
     if(!NvM_ValidateCal()){ printf("Calibration invalid; exiting\n"); return 1; }
+    SeatDebounce_Init(1); // driver seat; coach variants configure up to SEAT_MAX_SEATS
     SeatbeltWarning_Logic_Init();
 
-    const uint32_t SIM_DURATION_MS = 10000; // 10 s
-    for(g_time_ms=0; g_time_ms<=SIM_DURATION_MS; g_time_ms+=10){
-        scenario_step(g_time_ms);
-        // Call runnables (order: inputs then logic)
-        Seatbelt_Sensor_IF_10ms();
-        Occupancy_Sensor_IF_10ms();
-        VehicleState_IF_10ms();
-        SeatbeltWarning_Logic_10ms();
-        // Sleep 1ms to slow output (optional)
-        usleep(1000);
-    }
+    Os_Init(tasks, (uint8_t)(sizeof(tasks) / sizeof(tasks[0])), mode);
+    if(quiet) Os_DisableTask("Task_100ms");
+    Os_Run(scenario.duration_ms, pre_tick, post_tick);
+
     printf("Simulation complete. Final warning=%u\n", Rte_Get_WarningRequest());
-    return 0;
+    Os_PrintStats();
+    if(scenario.checks){
+        printf("Scenario %s: %u/%u expectations met\n", scenario_path ? scenario_path : "(built-in)",
+               scenario.checks - scenario.failures, scenario.checks);
+    }
+    return scenario.failures ? 1 : 0;
 }
@@ -1,12 +1,10 @@
 #include "Rte.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <string.h>
 
 uint32_t g_time_ms = 0;
 
-static RteBoolSignal seatbeltLatchFiltered;
-static RteOccupancySignal occupancyFiltered;
-static RteSpeedSignal vehicleSpeed;
-static RteIgnitionSignal ignitionState;
-static RteBoolSignal doorClosed;
 static uint8_t warningRequest = 0;
 
 void Rte_Write_SBW_WarningRequest(uint8_t level){
@@ -17,24 +15,53 @@ uint8_t Rte_Get_WarningRequest(void){
     return warningRequest;
 }
 
-RteBoolSignal Rte_Read_SeatbeltLatchFiltered(void){ return seatbeltLatchFiltered; }
-RteOccupancySignal Rte_Read_OccupancyFiltered(void){ return occupancyFiltered; }
-RteSpeedSignal Rte_Read_VehicleSpeed(void){ return vehicleSpeed; }
-RteIgnitionSignal Rte_Read_IgnitionState(void){ return ignitionState; }
-RteBoolSignal Rte_Read_DoorClosed(void){ return doorClosed; }
+// ---- Signal group SBW_Inputs ----
 
-void Rte_Update_SeatbeltLatchFiltered(bool v, RteValidity val, uint32_t ts){
-    seatbeltLatchFiltered.value = v; seatbeltLatchFiltered.validity = val; seatbeltLatchFiltered.timestamp_ms = ts;
-}
-void Rte_Update_OccupancyFiltered(OccupancyState v, RteValidity val, uint32_t ts){
-    occupancyFiltered.value = v; occupancyFiltered.validity = val; occupancyFiltered.timestamp_ms = ts;
-}
-void Rte_Update_VehicleSpeed(uint16_t v, RteValidity val, uint32_t ts){
-    vehicleSpeed.value = v; vehicleSpeed.validity = val; vehicleSpeed.timestamp_ms = ts;
+#define RTE_SBW_INPUTS_WORDS ((sizeof(Rte_SBW_Inputs) + sizeof(uint32_t) - 1) / sizeof(uint32_t))
+
+static Rte_SBW_Inputs sbwInputsStaging;            // writer side
+static bool sbwInputsInCommit = false;
+static _Atomic uint32_t sbwInputsSeq = 0;          // odd while a commit is being published
+static _Atomic uint32_t sbwInputsWords[RTE_SBW_INPUTS_WORDS];
+
+static void Rte_Publish_SBW_Inputs(void){
+    uint32_t words[RTE_SBW_INPUTS_WORDS] = {0};
+    uint32_t seq = atomic_load_explicit(&sbwInputsSeq, memory_order_relaxed);
+    memcpy(words, &sbwInputsStaging, sizeof(sbwInputsStaging));
+
+    atomic_store_explicit(&sbwInputsSeq, seq + 1u, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    for(size_t i=0;i<RTE_SBW_INPUTS_WORDS;i++) atomic_store_explicit(&sbwInputsWords[i], words[i], memory_order_relaxed);
+    atomic_store_explicit(&sbwInputsSeq, seq + 2u, memory_order_release);
 }
-void Rte_Update_IgnitionState(IgnitionState v, RteValidity val, uint32_t ts){
-    ignitionState.value = v; ignitionState.validity = val; ignitionState.timestamp_ms = ts;
+
+void Rte_Read_SBW_Inputs(Rte_SBW_Inputs* snapshot){
+    uint32_t words[RTE_SBW_INPUTS_WORDS];
+    for(;;){
+        uint32_t before = atomic_load_explicit(&sbwInputsSeq, memory_order_acquire);
+        if((before & 1u) == 0u){
+            for(size_t i=0;i<RTE_SBW_INPUTS_WORDS;i++) words[i] = atomic_load_explicit(&sbwInputsWords[i], memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            if(atomic_load_explicit(&sbwInputsSeq, memory_order_relaxed) == before) break;
+        }
+    }
+    memcpy(snapshot, words, sizeof(*snapshot));
 }
-void Rte_Update_DoorClosed(bool v, RteValidity val, uint32_t ts){
-    doorClosed.value = v; doorClosed.validity = val; doorClosed.timestamp_ms = ts;
+
+void Rte_Begin_SBW_Inputs(void){ sbwInputsInCommit = true; }
+
+void Rte_Commit_SBW_Inputs(void){
+    sbwInputsInCommit = false;
+    Rte_Publish_SBW_Inputs();
 }
+
+#define RTE_GROUP_ACCESSORS(type, vtype, member, name) \
+    type Rte_Read_##name(void){ \
+        Rte_SBW_Inputs g; Rte_Read_SBW_Inputs(&g); return g.member; \
+    } \
+    void Rte_Update_##name(vtype v, RteValidity val, uint32_t ts){ \
+        sbwInputsStaging.member.value = v; sbwInputsStaging.member.validity = val; sbwInputsStaging.member.timestamp_ms = ts; \
+        if(!sbwInputsInCommit) Rte_Publish_SBW_Inputs(); \
+    }
+RTE_SBW_INPUTS_SIGNALS(RTE_GROUP_ACCESSORS)
+#undef RTE_GROUP_ACCESSORS
@@ -33,10 +33,34 @@ typedef struct {
     uint32_t timestamp_ms;
 } RteIgnitionSignal;
 
+// Signal group SBW_Inputs: the inputs of SeatbeltWarning_Logic, read as one coherent snapshot.
+// X(signal type, value type, member, signal name) generates the group struct and, in Rte.c,
+// the per-signal Rte_Read_/Rte_Update_ functions below.
+#define RTE_SBW_INPUTS_SIGNALS(X) \
+    X(RteBoolSignal,      bool,           seatbeltLatch, SeatbeltLatchFiltered) \
+    X(RteOccupancySignal, OccupancyState, occupancy,     OccupancyFiltered) \
+    X(RteSpeedSignal,     uint16_t,       speed,         VehicleSpeed) \
+    X(RteIgnitionSignal,  IgnitionState,  ignition,      IgnitionState) \
+    X(RteBoolSignal,      bool,           doorClosed,    DoorClosed)
+
+typedef struct {
+#define RTE_GROUP_MEMBER(type, vtype, member, name) type member;
+    RTE_SBW_INPUTS_SIGNALS(RTE_GROUP_MEMBER)
+#undef RTE_GROUP_MEMBER
+} Rte_SBW_Inputs;
+
+// Reader: copy of the last committed group, never mixed from two commits (sequence counter,
+// the reader retries while a commit is in progress; no lock on either side).
+void Rte_Read_SBW_Inputs(Rte_SBW_Inputs* snapshot);
+// Writer (one task/core per group): Rte_Update_* calls between Begin and Commit are published
+// together by Commit; outside a Begin/Commit bracket each update is published on its own.
+void Rte_Begin_SBW_Inputs(void);
+void Rte_Commit_SBW_Inputs(void);
+
 // Write APIs for logic output
 void Rte_Write_SBW_WarningRequest(uint8_t level); // 0=Off,1=Visual,2=AudioVisual
 uint8_t Rte_Get_WarningRequest(void);
-// Read APIs for input signals (filtered interface components will populate these)
+// Read APIs for single input signals (filtered interface components will populate these)
 RteBoolSignal Rte_Read_SeatbeltLatchFiltered(void);
 RteOccupancySignal Rte_Read_OccupancyFiltered(void);
 RteSpeedSignal Rte_Read_VehicleSpeed(void);
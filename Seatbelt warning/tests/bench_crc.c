@@ -0,0 +1,70 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "Crc.h"
+
+// Host throughput of the CRC routines against the previous bit-at-a-time CRC-16 loop.
+// Usage: bench_crc [block-bytes] [total-MiB]
+
+static uint16_t crc16_bitwise(const uint8_t* p, uint32_t len){
+    uint16_t crc=0xFFFF;
+    for(uint32_t i=0;i<len;i++){
+        crc ^= p[i];
+        for(int j=0;j<8;j++){
+            if(crc & 1) crc = (crc>>1) ^ 0xA001; else crc >>=1;
+        }
+    }
+    return crc;
+}
+
+static uint32_t run_crc16_bitwise(const uint8_t* p, uint32_t len){ return crc16_bitwise(p, len); }
+static uint32_t run_crc16(const uint8_t* p, uint32_t len){ return Crc16_Calc(p, len); }
+static uint32_t run_crc32(const uint8_t* p, uint32_t len){ return Crc32_Calc(p, len); }
+static uint32_t run_crc8(const uint8_t* p, uint32_t len){ return Crc8_Calc(p, len); }
+
+static double now_s(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void bench(const char* name, uint32_t (*fn)(const uint8_t*, uint32_t), const uint8_t* buf,
+                  uint32_t block, uint64_t total, double baseline_mbs, double* out_mbs){
+    uint64_t rounds = total / block;
+    volatile uint32_t sink = 0;
+    if(rounds == 0) rounds = 1;
+    double t0 = now_s();
+    for(uint64_t r=0;r<rounds;r++) sink ^= fn(buf, block);
+    double dt = now_s() - t0;
+    double mbs = (double)(rounds * block) / (1024.0 * 1024.0) / dt;
+    (void)sink;
+    printf("  %-22s %9.1f MiB/s", name, mbs);
+    if(baseline_mbs > 0.0) printf("  x%.1f", mbs / baseline_mbs);
+    printf("\n");
+    if(out_mbs) *out_mbs = mbs;
+}
+
+int main(int argc, char** argv){
+    uint32_t block = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 4096u;
+    uint64_t total = (argc > 2 ? strtoull(argv[2], NULL, 0) : 256u) * 1024u * 1024u;
+    uint8_t* buf = malloc(block ? block : 1u);
+    double baseline = 0.0;
+
+    if(buf == NULL || block == 0u){ fprintf(stderr, "bad block size\n"); return 2; }
+    for(uint32_t i=0;i<block;i++) buf[i] = (uint8_t)(i*131u + 7u);
+
+    printf("CRC throughput, %u-byte blocks, %llu MiB per routine\n", (unsigned)block,
+           (unsigned long long)(total / (1024u * 1024u)));
+    bench("CRC-16 bitwise (old)", run_crc16_bitwise, buf, block, total / 8u, 0.0, &baseline);
+    bench("CRC-16 slice-by-8", run_crc16, buf, block, total, baseline, NULL);
+#if defined(__ARM_FEATURE_CRC32)
+    bench("CRC-32 ARMv8 CRC32", run_crc32, buf, block, total, baseline, NULL);
+#else
+    bench("CRC-32 slice-by-8", run_crc32, buf, block, total, baseline, NULL);
+#endif
+    bench("CRC-8 J1850 byte table", run_crc8, buf, block, total, baseline, NULL);
+
+    free(buf);
+    return 0;
+}
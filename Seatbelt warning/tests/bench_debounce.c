@@ -0,0 +1,90 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "NvM.h"
+#include "SeatDebounce.h"
+
+// One 10 ms debounce pass over a coach (60 seats): the bit-plane engine against running the
+// previous single-seat scalar timers once per seat.
+// Usage: bench_debounce [ticks]
+
+#define SEATS 60u
+
+typedef struct {
+    bool rawLatch, filtLatch; uint16_t latchMs, unlatchMs;
+    OccupancyState rawOcc, filtOcc; uint16_t occMs;
+} ScalarSeat;
+
+static ScalarSeat scalar[SEATS];
+
+static void scalar_10ms(const CalParams* cal){
+    for(uint32_t i=0;i<SEATS;i++){
+        ScalarSeat* s = &scalar[i];
+        if(s->rawLatch){
+            s->latchMs += 10; s->unlatchMs = 0;
+            if(s->latchMs >= cal->latch_on_delay_ms) s->filtLatch = true;
+        } else {
+            s->unlatchMs += 10; s->latchMs = 0;
+            if(s->unlatchMs >= cal->unlatch_on_delay_ms) s->filtLatch = false;
+        }
+        if(s->rawOcc == s->filtOcc){
+            s->occMs = 0;
+        } else {
+            s->occMs += 10;
+            if(s->occMs >= cal->occupancy_debounce_ms){ s->filtOcc = s->rawOcc; s->occMs = 0; }
+        }
+    }
+}
+
+static double now_s(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char** argv){
+    uint32_t ticks = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 0) : 1000000u;
+    const CalParams* cal;
+    volatile uint32_t sink = 0;
+    double t0, scalar_ns, engine_ns;
+
+    if(ticks == 0u){ fprintf(stderr, "bad tick count\n"); return 2; }
+    NvM_Init();
+    cal = NvM_GetCal();
+    SeatDebounce_Init(SEATS);
+    for(uint32_t i=0;i<SEATS;i++){
+        scalar[i] = (ScalarSeat){ true, true, 0, 0, OCC_EMPTY, OCC_EMPTY, 0 };
+    }
+
+    // Inputs change every 64 ticks so the timers keep running and expiring
+    t0 = now_s();
+    for(uint32_t t=0;t<ticks;t++){
+        if((t & 63u) == 0u){
+            for(uint32_t i=0;i<SEATS;i++){ scalar[i].rawLatch = ((t >> 6) + i) & 1u; scalar[i].rawOcc = (OccupancyState)(((t >> 7) + i) & 1u); }
+        }
+        scalar_10ms(cal);
+        sink ^= scalar[t % SEATS].filtLatch;
+    }
+    scalar_ns = (now_s() - t0) * 1e9 / (double)ticks;
+
+    t0 = now_s();
+    for(uint32_t t=0;t<ticks;t++){
+        if((t & 63u) == 0u){
+            for(uint8_t i=0;i<SEATS;i++){
+                SeatDebounce_SetRawLatch(i, ((t >> 6) + i) & 1u);
+                SeatDebounce_SetRawOccupancy(i, (OccupancyState)(((t >> 7) + i) & 1u));
+            }
+        }
+        SeatDebounce_10ms();
+        sink ^= SeatDebounce_GetWarningMask()->w[t & 1u];
+    }
+    engine_ns = (now_s() - t0) * 1e9 / (double)ticks;
+    (void)sink;
+
+    printf("Seat debounce, %u seats, %u ticks\n", (unsigned)SEATS, (unsigned)ticks);
+    printf("  %-24s %8.1f ns/tick\n", "scalar timers per seat", scalar_ns);
+    printf("  %-24s %8.1f ns/tick  x%.1f  (%.3f %% of the 2 ms Task_10ms budget)\n", "SeatDebounce_10ms",
+           engine_ns, scalar_ns / engine_ns, engine_ns / 2e6 * 100.0);
+    return 0;
+}
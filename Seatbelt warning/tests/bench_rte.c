@@ -0,0 +1,60 @@
+#define _POSIX_C_SOURCE 199309L
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "Rte.h"
+
+// Cost of reading the five SeatbeltWarning_Logic inputs coherently: each single-signal read
+// wrapped in an exclusive area (here a mutex, the host stand-in for SuspendAllInterrupts)
+// against one Rte_Read_SBW_Inputs snapshot.
+// Usage: bench_rte [millions of reads]
+
+static pthread_mutex_t exclusive_area = PTHREAD_MUTEX_INITIALIZER;
+
+static double now_s(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint32_t read_exclusive(void){
+    pthread_mutex_lock(&exclusive_area);
+    RteBoolSignal latch = Rte_Read_SeatbeltLatchFiltered();
+    RteOccupancySignal occ = Rte_Read_OccupancyFiltered();
+    RteSpeedSignal spd = Rte_Read_VehicleSpeed();
+    RteIgnitionSignal ign = Rte_Read_IgnitionState();
+    RteBoolSignal door = Rte_Read_DoorClosed();
+    pthread_mutex_unlock(&exclusive_area);
+    return latch.timestamp_ms ^ occ.timestamp_ms ^ spd.value ^ (uint32_t)ign.value ^ (uint32_t)door.value;
+}
+
+static uint32_t read_snapshot(void){
+    Rte_SBW_Inputs in;
+    Rte_Read_SBW_Inputs(&in);
+    return in.seatbeltLatch.timestamp_ms ^ in.occupancy.timestamp_ms ^ in.speed.value ^
+           (uint32_t)in.ignition.value ^ (uint32_t)in.doorClosed.value;
+}
+
+static double bench(const char* name, uint32_t (*fn)(void), uint64_t reads, double baseline_ns){
+    volatile uint32_t sink = 0;
+    double t0 = now_s();
+    for(uint64_t i=0;i<reads;i++) sink ^= fn();
+    double ns = (now_s() - t0) * 1e9 / (double)reads;
+    (void)sink;
+    printf("  %-28s %7.1f ns/read", name, ns);
+    if(baseline_ns > 0.0) printf("  x%.1f", baseline_ns / ns);
+    printf("\n");
+    return ns;
+}
+
+int main(int argc, char** argv){
+    uint64_t reads = (argc > 1 ? strtoull(argv[1], NULL, 0) : 20u) * 1000000u;
+    if(reads == 0u){ fprintf(stderr, "bad read count\n"); return 2; }
+
+    Rte_Update_VehicleSpeed(50, VALIDITY_VALID, 1);
+    printf("SBW_Inputs coherent read, %llu reads per variant\n", (unsigned long long)reads);
+    double baseline = bench("5 reads in exclusive area", read_exclusive, reads, 0.0);
+    bench("Rte_Read_SBW_Inputs", read_snapshot, reads, baseline);
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "Crc.h"
+
+// Previous bit-at-a-time CRC-16, kept as the reference
+static uint16_t crc16_bitwise(const uint8_t* p, uint32_t len){
+    uint16_t crc=0xFFFF;
+    for(uint32_t i=0;i<len;i++){
+        crc ^= p[i];
+        for(int j=0;j<8;j++){
+            if(crc & 1) crc = (crc>>1) ^ 0xA001; else crc >>=1;
+        }
+    }
+    return crc;
+}
+
+int main(){
+    static const char check[] = "123456789";
+    uint8_t buf[1000];
+    for(uint32_t i=0;i<sizeof(buf);i++) buf[i] = (uint8_t)(i*131u + 7u);
+
+    // Test: standard check values of "123456789"
+    assert(Crc16_Calc(check, 9) == 0x4B37);
+    assert(Crc32_Calc(check, 9) == 0xCBF43926u);
+    assert(Crc8_Calc(check, 9) == 0x4B);
+
+    // Test: AUTOSAR SWS_Crc examples for CRC-8 SAE J1850 and CRC-32
+    static const uint8_t zeros[4] = {0,0,0,0};
+    static const uint8_t pattern[4] = {0x0F,0xAA,0x00,0x55};
+    static const uint8_t three[3] = {0xF2,0x01,0x83};
+    assert(Crc8_Calc(zeros, 4) == 0x59);
+    assert(Crc8_Calc(pattern, 4) == 0x79);
+    assert(Crc8_Calc(three, 3) == 0x37);
+    assert(Crc32_Calc(zeros, 4) == 0x2144DF1Cu);
+    assert(Crc32_Calc(pattern, 4) == 0xB6C9B287u);
+    assert(Crc32_Calc(three, 3) == 0x24AB9D77u);
+
+    // Test: table-driven CRC-16 matches the bitwise loop for every length and alignment
+    for(uint32_t off=0;off<8;off++){
+        for(uint32_t len=0;len+off<=64;len++){
+            assert(Crc16_Calc(buf+off, len) == crc16_bitwise(buf+off, len));
+        }
+    }
+    assert(Crc16_Calc(buf, sizeof(buf)) == crc16_bitwise(buf, sizeof(buf)));
+
+    // Test: streaming in arbitrary chunks equals the one-shot result
+    for(uint32_t split=0;split<=sizeof(buf);split+=37){
+        uint16_t c16 = Crc16_Init();
+        uint32_t c32 = Crc32_Init();
+        uint8_t c8 = Crc8_Init();
+        c16 = Crc16_Update(c16, buf, split);
+        c32 = Crc32_Update(c32, buf, split);
+        c8 = Crc8_Update(c8, buf, split);
+        c16 = Crc16_Update(c16, buf+split, sizeof(buf)-split);
+        c32 = Crc32_Update(c32, buf+split, sizeof(buf)-split);
+        c8 = Crc8_Update(c8, buf+split, sizeof(buf)-split);
+        assert(Crc16_Final(c16) == Crc16_Calc(buf, sizeof(buf)));
+        assert(Crc32_Final(c32) == Crc32_Calc(buf, sizeof(buf)));
+        assert(Crc8_Final(c8) == Crc8_Calc(buf, sizeof(buf)));
+    }
+
+    printf("All CRC tests passed\n");
+    return 0;
+}
@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include "Rte.h"
 #include "NvM.h"
+#include "SeatDebounce.h"
 
 void Seatbelt_Sensor_IF_SetRaw(bool v);
 void Seatbelt_Sensor_IF_10ms(void);
@@ -11,12 +12,79 @@ void Occupancy_Sensor_IF_10ms(void);
 static void advance_ms(uint32_t ms){
     for(uint32_t t=0;t<ms;t+=10){
         g_time_ms += 10;
+        SeatDebounce_10ms();
         Seatbelt_Sensor_IF_10ms();
         Occupancy_Sensor_IF_10ms();
     }
 }
 
+// Previous single-seat debounce (scalar timers), the reference for every seat of the engine
+typedef struct {
+    bool rawLatch, filtLatch; uint16_t latchMs, unlatchMs;
+    OccupancyState rawOcc, filtOcc; uint16_t occMs;
+} RefSeat;
+
+static void ref_10ms(RefSeat* s, const CalParams* cal){
+    if(s->rawLatch){
+        s->latchMs += 10; s->unlatchMs = 0;
+        if(s->latchMs >= cal->latch_on_delay_ms) s->filtLatch = true;
+    } else {
+        s->unlatchMs += 10; s->latchMs = 0;
+        if(s->unlatchMs >= cal->unlatch_on_delay_ms) s->filtLatch = false;
+    }
+    if(s->rawOcc == s->filtOcc){
+        s->occMs = 0;
+    } else {
+        s->occMs += 10;
+        if(s->occMs >= cal->occupancy_debounce_ms){ s->filtOcc = s->rawOcc; s->occMs = 0; }
+    }
+}
+
+static void test_multi_seat(void){
+    const CalParams* cal = NvM_GetCal();
+    RefSeat ref[60];
+    uint32_t rng = 12345u;
+
+    SeatDebounce_Init(60);
+    for(int i=0;i<60;i++){ ref[i] = (RefSeat){ true, true, 0, 0, OCC_EMPTY, OCC_EMPTY, 0 }; }
+
+    // Random raw changes on all seats; every seat must match the scalar reference each tick
+    for(int tick=0;tick<20000;tick++){
+        for(uint8_t i=0;i<60;i++){
+            rng = rng * 1103515245u + 12345u;
+            uint32_t r = (rng >> 16) & 0x3FFu;
+            if(r < 8u){ ref[i].rawLatch = !ref[i].rawLatch; SeatDebounce_SetRawLatch(i, ref[i].rawLatch); }
+            else if(r < 14u){ ref[i].rawOcc = (OccupancyState)(r % 3u); SeatDebounce_SetRawOccupancy(i, ref[i].rawOcc); }
+        }
+        SeatDebounce_10ms();
+        const SeatMask* warn = SeatDebounce_GetWarningMask();
+        for(uint8_t i=0;i<60;i++){
+            ref_10ms(&ref[i], cal);
+            assert(SeatDebounce_GetLatch(i) == ref[i].filtLatch);
+            assert(SeatDebounce_GetOccupancy(i) == ref[i].filtOcc);
+            bool w = ((warn->w[i >> 5] >> (i & 31u)) & 1u) != 0u;
+            assert(w == (ref[i].filtOcc == OCC_OCCUPIED && !ref[i].filtLatch));
+        }
+    }
+
+    // Packed inputs: seat 45 occupied and unlatched warns after the debounce; seats past the
+    // configured count never warn
+    SeatMask latched = {{ 0xFFFFFFFFu, 0xFFFFFFFFu }}, occupied = {{ 0, 0 }}, unknown = {{ 0, 0 }};
+    SeatDebounce_Init(50);
+    latched.w[1] &= ~((1u << (45 - 32)) | (1u << (55 - 32)));
+    occupied.w[1] |= (1u << (45 - 32)) | (1u << (55 - 32));
+    SeatDebounce_SetRawMasks(&latched, &occupied, &unknown);
+    for(int t=0;t<50;t++) SeatDebounce_10ms();
+    assert(SeatDebounce_GetWarningMask()->w[0] == 0u);
+    assert(SeatDebounce_GetWarningMask()->w[1] == (1u << (45 - 32)));
+    assert(SeatDebounce_GetOccupancy(55) == OCC_OCCUPIED && !SeatDebounce_GetLatch(55));
+
+    SeatDebounce_Init(1); // back to the driver seat for the tests below
+}
+
 int main(){
+    test_multi_seat();
+
     // Test: 40 ms unlatch chatter should not change filtered latch (requires 500 ms off-delay)
     g_time_ms=0;
     Seatbelt_Sensor_IF_SetRaw(true);
@@ -0,0 +1,64 @@
+#include <assert.h>
+#include <stdio.h>
+#include "NvM.h"
+#include "Dem.h"
+#include "Fee.h"
+
+static void drain(void){
+    while(NvM_GetPendingJobs()) NvM_MainFunction();
+}
+
+int main(){
+    uint8_t* fee = Fee_SimStorage();
+
+    // Test: erased storage -> calibration defaults now, Dem block left for the background
+    NvM_Init();
+    assert(NvM_GetErrorStatus(NVM_BLOCK_CAL) == NVM_REQ_RESTORED_DEFAULTS);
+    assert(NvM_GetCal()->unlatch_on_delay_ms == 500);
+    assert(NvM_GetErrorStatus(NVM_BLOCK_DEM_EVENTS) == NVM_REQ_PENDING);
+    assert(NvM_GetPendingJobs() == 2);
+
+    // Test: calibration write (priority 0) runs before the Dem verify (priority 2)
+    NvM_MainFunction();
+    assert(NvM_GetErrorStatus(NVM_BLOCK_CAL) == NVM_REQ_OK);
+    assert(NvM_GetErrorStatus(NVM_BLOCK_DEM_EVENTS) == NVM_REQ_PENDING);
+    NvM_MainFunction();
+    assert(NvM_GetErrorStatus(NVM_BLOCK_DEM_EVENTS) == NVM_REQ_RESTORED_DEFAULTS);
+    drain();
+    assert(NvM_GetErrorStatus(NVM_BLOCK_DEM_EVENTS) == NVM_REQ_OK);
+
+    // Test: restart with both copies intact needs no writes
+    NvM_Init();
+    assert(NvM_GetErrorStatus(NVM_BLOCK_CAL) == NVM_REQ_OK);
+    assert(NvM_ValidateCal() == 1);
+    assert(NvM_GetPendingJobs() == 1);  // only the Dem verify
+    drain();
+    assert(NvM_GetErrorStatus(NVM_BLOCK_DEM_EVENTS) == NVM_REQ_OK);
+
+    // Test: a corrupted copy is bypassed and repaired in the background
+    fee[8 + 2] ^= 0x5A;     // copy 0 of the calibration block, unlatch_on_delay_ms
+    NvM_Init();
+    assert(NvM_GetErrorStatus(NVM_BLOCK_CAL) == NVM_REQ_REDUNDANCY_LOST);
+    assert(NvM_GetCal()->unlatch_on_delay_ms == 500);
+    drain();
+    assert(NvM_GetErrorStatus(NVM_BLOCK_CAL) == NVM_REQ_OK);
+    NvM_Init();
+    assert(NvM_GetErrorStatus(NVM_BLOCK_CAL) == NVM_REQ_OK);
+
+    // Test: using a block before its background verify loads it synchronously
+    Dem_ReportErrorStatus(DTC_SEATBELT_STUCK, DEM_EVENT_STATUS_PREFAILED);
+    assert(Dem_GetOccurrenceCounter(DTC_SEATBELT_STUCK) == 1);
+    assert(NvM_GetErrorStatus(NVM_BLOCK_DEM_EVENTS) == NVM_REQ_PENDING);
+    drain();
+    assert(NvM_GetErrorStatus(NVM_BLOCK_DEM_EVENTS) == NVM_REQ_OK);
+
+    // Test: the counter survives a restart (RAM mirror cleared to prove it is reloaded)
+    NvM_Init();
+    Dem_NvData.occurrence[0] = 0;
+    assert(NvM_ValidateBlock(NVM_BLOCK_DEM_EVENTS) == 1);
+    assert(Dem_GetOccurrenceCounter(DTC_SEATBELT_STUCK) == 1);
+    drain();
+
+    printf("All NvM tests passed\n");
+    return 0;
+}
@@ -0,0 +1,99 @@
+# CRC Table Generator
+# Writes the slice-by-8 CRC-16/CRC-32 and byte-wise CRC-8 tables of src/bsw/Crc.c
+# as const arrays, so they live in flash and need no initialization at runtime
+
+import argparse
+import sys
+from pathlib import Path
+
+CRC16_POLY_REFLECTED = 0xA001
+CRC32_POLY_REFLECTED = 0xEDB88320
+CRC8_POLY = 0x1D
+SLICES = 8
+
+
+def reflected_table(poly):
+    """Byte-wise table of a reflected CRC"""
+    table = []
+    for b in range(256):
+        c = b
+        for _ in range(8):
+            c = (c >> 1) ^ poly if c & 1 else c >> 1
+        table.append(c)
+    return table
+
+
+def slice_tables(poly):
+    """table[k][b] is the CRC of byte b followed by k zero bytes"""
+    tables = [reflected_table(poly)]
+    for k in range(1, SLICES):
+        tables.append([(p >> 8) ^ tables[0][p & 0xFF] for p in tables[k - 1]])
+    return tables
+
+
+def crc8_table():
+    """Byte-wise table of the non-reflected CRC-8"""
+    table = []
+    for b in range(256):
+        c = b
+        for _ in range(8):
+            c = ((c << 1) ^ CRC8_POLY) & 0xFF if c & 0x80 else (c << 1) & 0xFF
+        table.append(c)
+    return table
+
+
+def format_row(values, digits, per_line, indent):
+    lines = []
+    for i in range(0, len(values), per_line):
+        chunk = values[i:i + per_line]
+        lines.append(indent + ','.join('0x%0*X' % (digits, v) for v in chunk) + ',')
+    lines[-1] = lines[-1][:-1]
+    return lines
+
+
+def emit_slices(name, ctype, digits, per_line, tables):
+    out = ['static const %s %s[%d][256] = {' % (ctype, name, SLICES)]
+    for k, table in enumerate(tables):
+        out.append('    {')
+        out.extend(format_row(table, digits, per_line, '        '))
+        out.append('    }' + (',' if k < len(tables) - 1 else ''))
+    out.append('};')
+    return out
+
+
+def generate():
+    out = [
+        '// Generated by tools/gen_crc_tables.py, do not edit.',
+        '// crcXX_table[0] is the byte-wise table; crcXX_table[k][b] is the CRC of byte b',
+        '// followed by k zero bytes, which lets one step fold 8 input bytes at once.',
+        '#ifndef CRC_TABLES_H',
+        '#define CRC_TABLES_H',
+        '#include <stdint.h>',
+        '',
+    ]
+    out.extend(emit_slices('crc16_table', 'uint16_t', 4, 16, slice_tables(CRC16_POLY_REFLECTED)))
+    out.append('')
+    out.append('#if !defined(__ARM_FEATURE_CRC32)')
+    out.extend(emit_slices('crc32_table', 'uint32_t', 8, 8, slice_tables(CRC32_POLY_REFLECTED)))
+    out.append('#endif')
+    out.append('')
+    out.append('static const uint8_t crc8_table[256] = {')
+    out.extend(format_row(crc8_table(), 2, 16, '    '))
+    out.append('};')
+    out.append('')
+    out.append('#endif // CRC_TABLES_H')
+    return '\n'.join(out) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate the CRC lookup tables')
+    parser.add_argument('-o', '--output', default='src/bsw/Crc_Tables.h', help='Output header')
+    args = parser.parse_args()
+
+    Path(args.output).write_text(generate())
+    print('Wrote %s' % args.output, file=sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,481 @@
+# Cross-ECU Benchmark Runner
+# Builds the benchmarks of every ECU project out of tree, runs them on fixed-seed
+# inputs, writes the results as JSON and compares them against a fixed baseline
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import re
+import resource
+import shutil
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+REPO = Path(__file__).resolve().parent.parent
+ABS_DIR = REPO / 'ABS malfunction' / 'simulation'
+SEATBELT_DIR = REPO / 'Seatbelt warning'
+IC_DIR = REPO / ' IC time blinking' / 'sim'
+INFOTAINMENT_DIR = REPO / 'Infotainment ECU'
+ENGINE_DIR = REPO / ' Engine ECU'
+
+SEED = '0x5EED'                 # Input seed of the ABS, UDS and PowerMonitor benchmarks
+IC_SEED = '42'                  # IC virtual-time scenario seed (README example)
+DEFAULT_TOLERANCE = 0.10        # Allowed relative change before a metric regresses
+SCHEMA_VERSION = 1
+
+INFOTAINMENT_SOURCES = [
+    'benchmark/power_monitor_benchmark.cpp',
+    'src/PowerManager/PowerManager.cpp',
+    'src/PowerManager/PowerTransition.cpp',
+    'src/InfotainmentSystem/InfotainmentSystem.cpp',
+    'src/Diagnostics/MeasurementStore.cpp',
+    'src/Diagnostics/MeasurementExporter.cpp',
+    'src/Diagnostics/AnomalyDetector.cpp',
+    'src/Diagnostics/PowerMonitor.cpp',
+]
+
+SEATBELT_SCENARIO_RUNS = 10     # Simulator runs per scenario and repetition, the fastest counts
+
+
+class BenchmarkError(Exception):
+    pass
+
+
+class Metric:
+    """One result: value plus the direction and tolerance used for the comparison"""
+
+    def __init__(self, name, value, unit, better, tolerance=DEFAULT_TOLERANCE):
+        self.name = name
+        self.value = float(value)
+        self.unit = unit
+        self.better = better            # 'higher' or 'lower'
+        self.tolerance = tolerance
+
+
+def run(command, cwd=None, env=None, check=True):
+    """Run a command and return its stdout; a non-zero status is a benchmark failure"""
+    full_env = dict(os.environ)
+    if env:
+        full_env.update(env)
+    result = subprocess.run([str(c) for c in command], cwd=cwd, env=full_env,
+                            stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    if check and result.returncode != 0:
+        tail = '\n'.join(result.stdout.splitlines()[-20:])
+        raise BenchmarkError(f'{Path(str(command[0])).name} exited with status {result.returncode}\n{tail}')
+    return result.stdout
+
+
+def find(pattern, output, what):
+    match = re.search(pattern, output, re.MULTILINE)
+    if match is None:
+        raise BenchmarkError(f'no {what} in the benchmark output')
+    return match
+
+
+def section(output, title):
+    """Text of a report section, from its title line to the next blank line"""
+    start = output.find(title)
+    if start < 0:
+        raise BenchmarkError(f'no "{title}" section in the benchmark output')
+    end = output.find('\n\n', start)
+    return output[start:] if end < 0 else output[start:end]
+
+
+# ---------------------------------------------------------------------------
+# Builds: every module into its own directory below the build directory, never
+# into the tracked binaries and object files of the projects
+# ---------------------------------------------------------------------------
+
+def build_abs(out):
+    targets = {'uds': out / 'uds_benchmark', 'cycle': out / 'abs_cycle_benchmark'}
+    run(['make', '-s', '-C', ABS_DIR, targets['uds'], targets['cycle'],
+         f'BENCH_TARGET={targets["uds"]}', f'CYCLE_BENCH_TARGET={targets["cycle"]}'])
+    return targets
+
+
+def build_seatbelt(out):
+    cc = os.environ.get('CC') or ('clang' if shutil.which('clang') else 'gcc')
+    names = ('bench_crc', 'bench_rte', 'bench_debounce', 'sim')
+    targets = {name: out / name for name in names}
+    run(['make', '-s', '-C', SEATBELT_DIR, f'CC={cc}', f'BUILD_DIR={out}'] + list(targets.values()))
+    return targets
+
+
+def build_ic(out):
+    # The sim Makefile builds objects next to the sources; compile the single
+    # translation unit directly with the same flags instead
+    binary = out / 'ic_time_blink_sim'
+    run(['g++', '-std=c++17', '-O2', '-Wall', '-Wextra', '-pedantic', '-pthread',
+         '-o', binary, IC_DIR / 'src' / 'main.cpp'])
+    return {'sim': binary}
+
+
+def build_infotainment(out):
+    binary = out / 'power_monitor_benchmark'
+    run(['g++', '-std=c++11', '-O2', '-pthread', '-I.', '-o', binary] + INFOTAINMENT_SOURCES,
+        cwd=INFOTAINMENT_DIR)
+    return {'power_monitor': binary}
+
+
+def build_engine(out):
+    binary = out / 'engine_ecu'
+    run(['make', '-s', '-C', ENGINE_DIR, f'OBJDIR={out}', f'TARGET={binary}'])
+    return {'ecu': binary}
+
+
+# ---------------------------------------------------------------------------
+# Benchmarks: one run each, returning a list of Metric
+# ---------------------------------------------------------------------------
+
+def uds_metrics(output, path):
+    randomized = section(output, 'Randomized requests')
+    throughput = find(r'throughput: (\d+) requests/s', randomized, 'UDS throughput')
+    p99 = [int(m.group(1)) for m in re.finditer(r'^\s+0x[0-9A-F]{2}\s+\d+\s+\d+\s+(\d+)', randomized, re.MULTILINE)]
+    if not p99:
+        raise BenchmarkError('no per-service UDS latency rows in the benchmark output')
+    return [
+        Metric(f'abs.uds.{path}.throughput', throughput.group(1), 'requests/s', 'higher'),
+        Metric(f'abs.uds.{path}.p99_max_ns', max(p99), 'ns', 'lower', 0.30),
+    ]
+
+
+def bench_uds(targets):
+    trace = ABS_DIR / 'benchmark' / 'eol_session.trace'
+    metrics = uds_metrics(run([targets['uds'], '-s', SEED, '-t', trace], cwd=ABS_DIR), 'request')
+    metrics += uds_metrics(run([targets['uds'], '-s', SEED, '-t', trace, '-S'], cwd=ABS_DIR), 'stream')
+    return metrics
+
+
+def bench_abs_cycle(targets):
+    output = run([targets['cycle'], '-s', SEED])
+    return [
+        Metric('abs.cycle.throughput', find(r'throughput: (\d+) cycles/s', output, 'ABS cycle rate').group(1),
+               'cycles/s', 'higher'),
+        Metric('abs.calibration.session_ns', find(r'cost: (\d+) ns/session', output, 'calibration cost').group(1),
+               'ns', 'lower', 0.15),
+        # Deterministic for a given seed: any change is a behaviour change
+        Metric('abs.calibration.cycles_per_session',
+               find(r'cycles: ([\d.]+) per session', output, 'calibration cycles').group(1),
+               'cycles', 'lower', 0.01),
+    ]
+
+
+def bench_crc(targets):
+    output = run([targets['bench_crc']])
+    routines = (('crc16_bitwise', r'CRC-16 bitwise'), ('crc16_slice8', r'CRC-16 slice-by-8'),
+                ('crc32_slice8', r'CRC-32 slice-by-8'), ('crc8_table', r'CRC-8 J1850 byte table'))
+    return [Metric(f'seatbelt.crc.{name}', find(label + r'[^\n]*?([\d.]+) MiB/s', output, label).group(1), 'MiB/s', 'higher')
+            for name, label in routines]
+
+
+def bench_seatbelt_rte(targets):
+    output = run([targets['bench_rte']])
+    debounce = run([targets['bench_debounce']])
+    return [
+        Metric('seatbelt.rte_read_ns', find(r'Rte_Read_SBW_Inputs\s+([\d.]+) ns/read', output, 'RTE read').group(1),
+               'ns', 'lower', 0.20),
+        Metric('seatbelt.debounce_tick_ns', find(r'SeatDebounce_10ms\s+([\d.]+) ns/tick', debounce, 'debounce').group(1),
+               'ns', 'lower', 0.20),
+    ]
+
+
+def bench_seatbelt_scenarios(targets):
+    metrics = []
+    for scenario in sorted((SEATBELT_DIR / 'scenarios').glob('*.scn')):
+        best_ms = None
+        for _ in range(SEATBELT_SCENARIO_RUNS):
+            # CPU time of the simulator process: a ~1 ms run is dominated by
+            # process start, and wall time would add the host's scheduling noise
+            before = resource.getrusage(resource.RUSAGE_CHILDREN)
+            output = run([targets['sim'], '--fast', '--quiet', '--scenario', scenario.relative_to(SEATBELT_DIR)],
+                         cwd=SEATBELT_DIR)
+            after = resource.getrusage(resource.RUSAGE_CHILDREN)
+            run_ms = ((after.ru_utime - before.ru_utime) + (after.ru_stime - before.ru_stime)) * 1000.0
+            best_ms = run_ms if best_ms is None else min(best_ms, run_ms)
+        find(r'^Scenario .*expectations met', output, f'{scenario.name} result')
+        metrics.append(Metric(f'seatbelt.scenario.{scenario.stem}_cpu_ms', best_ms, 'ms', 'lower', 0.25))
+    return metrics
+
+
+def bench_ic_cache(targets):
+    output = run([targets['sim'], '--bench-cache', '200'])
+    metrics = []
+    row = r'^(\S.*?)\s+readers (\d+)\s+writes/s\s+(\d+)\s+reads/s\s+(\d+)\s+torn (\d+)'
+    for match in re.finditer(row, output, re.MULTILINE):
+        design, readers, writes, reads, torn = match.groups()
+        if 'no lock' in design:
+            continue                    # Racy on purpose, its torn reads are expected
+        if int(torn) != 0:
+            raise BenchmarkError(f'{design}: {torn} torn reads')
+        key = re.sub(r'[^a-z0-9]+', '_', design.lower()).strip('_') + f'.r{readers}'
+        # Thread throughput depends on scheduling; only large changes count
+        metrics.append(Metric(f'ic.cache.{key}.writes_per_s', writes, 'writes/s', 'higher', 0.30))
+        metrics.append(Metric(f'ic.cache.{key}.reads_per_s', reads, 'reads/s', 'higher', 0.30))
+    if not metrics:
+        raise BenchmarkError('no cache benchmark rows in the output')
+    return metrics
+
+
+def bench_ic_virtual(targets):
+    start = time.perf_counter()
+    output = run([targets['sim'], '--virtual', '--seed', IC_SEED], env={'SIM_DURATION_MS': '3600000'})
+    elapsed_ms = (time.perf_counter() - start) * 1000.0
+    find(r'=== Robust ===', output, 'robust scenario result')
+    return [Metric('ic.virtual_scenario_1h_ms', elapsed_ms, 'ms', 'lower', 0.25)]
+
+
+def bench_power_monitor(targets):
+    output = run([targets['power_monitor'], '-s', SEED])
+    return [
+        Metric('infotainment.power_monitor.insert_ns',
+               find(r'insert: ([\d.]+) ns/measurement', output, 'insert cost').group(1), 'ns', 'lower', 0.15),
+        Metric('infotainment.power_monitor.take_measurement_ns',
+               find(r'take: ([\d.]+) ns/measurement', output, 'takeMeasurement cost').group(1), 'ns', 'lower', 0.15),
+        Metric('infotainment.power_monitor.report_ns',
+               find(r'report: ([\d.]+) ns/report', output, 'report cost').group(1), 'ns', 'lower', 0.25),
+    ]
+
+
+def bench_engine_boot(targets):
+    workdir = targets['ecu'].parent
+    journal = workdir / 'startup_journal.bin'
+    if journal.exists():
+        journal.unlink()                # Same journal state (first boot) on every run
+    output = run([targets['ecu']], cwd=workdir, env={'ENGINE_ECU_JOURNAL': str(journal)})
+    return [
+        Metric('engine.boot.time_to_running_us', find(r'Time to RUNNING: (\d+) us', output, 'boot time').group(1),
+               'us', 'lower', 0.20),
+        Metric('engine.boot.flash_crc_us',
+               find(r'Flash CRC\s+PASSED\s+\d+\s+(\d+)', output, 'flash CRC check').group(1), 'us', 'lower', 0.20),
+    ]
+
+
+# Module: (build function, [(benchmark name, function)])
+MODULES = {
+    'abs': (build_abs, [('uds', bench_uds), ('abs_cycle', bench_abs_cycle)]),
+    'seatbelt': (build_seatbelt, [('crc', bench_crc), ('rte', bench_seatbelt_rte),
+                                  ('scenarios', bench_seatbelt_scenarios)]),
+    'ic': (build_ic, [('cache', bench_ic_cache), ('virtual', bench_ic_virtual)]),
+    'infotainment': (build_infotainment, [('power_monitor', bench_power_monitor)]),
+    'engine': (build_engine, [('boot', bench_engine_boot)]),
+}
+
+
+# ---------------------------------------------------------------------------
+# Results and comparison
+# ---------------------------------------------------------------------------
+
+def git_revision():
+    try:
+        return run(['git', '-C', REPO, 'rev-parse', '--short', 'HEAD']).strip()
+    except (BenchmarkError, OSError):
+        return None
+
+
+def host_info():
+    return {
+        'system': platform.system(),
+        'machine': platform.machine(),
+        'cpus': os.cpu_count(),
+        'node': platform.node(),
+    }
+
+
+def collect(modules, build_dir, repeat, log, samples, definitions):
+    """Build and run the selected modules, appending every value to samples"""
+    for module in modules:
+        build, benchmarks = MODULES[module]
+        out = build_dir / module
+        out.mkdir(parents=True, exist_ok=True)
+        log(f'[{module}] building')
+        targets = build(out)
+        for name, benchmark in benchmarks:
+            log(f'[{module}] {name} x{repeat}')
+            for _ in range(repeat):
+                for metric in benchmark(targets):
+                    samples.setdefault(metric.name, []).append(metric.value)
+                    definitions[metric.name] = metric
+
+
+def summarize(samples, definitions):
+    """Metrics keep the best of their samples
+
+    Interference from the host only ever makes a run slower, so the best run
+    (highest throughput, lowest time) is the most repeatable value.
+    """
+    metrics = {}
+    for name, values in sorted(samples.items()):
+        metric = definitions[name]
+        metrics[name] = {
+            'value': max(values) if metric.better == 'higher' else min(values),
+            'unit': metric.unit,
+            'better': metric.better,
+            'tolerance': metric.tolerance,
+            'samples': values,
+        }
+    return metrics
+
+
+def compare(current, baseline, tolerance_scale):
+    """Rows (name, old, new, relative change, status); status is ok, improved, REGRESSION, new or missing"""
+    rows = []
+    for name in sorted(set(current) | set(baseline)):
+        if name not in baseline:
+            rows.append((name, None, current[name]['value'], None, 'new'))
+            continue
+        if name not in current:
+            rows.append((name, baseline[name]['value'], None, None, 'missing'))
+            continue
+        old = baseline[name]['value']
+        new = current[name]['value']
+        change = (new - old) / old if old else 0.0
+        worse = -change if current[name]['better'] == 'higher' else change
+        limit = current[name]['tolerance'] * tolerance_scale
+        if worse > limit:
+            status = 'REGRESSION'
+        elif -worse > limit:
+            status = 'improved'
+        else:
+            status = 'ok'
+        rows.append((name, old, new, change, status))
+    return rows
+
+
+def format_value(value):
+    if value is None:
+        return '-'
+    return f'{value:.1f}' if abs(value) < 1000 else f'{value:.0f}'
+
+
+def print_comparison(rows, current):
+    width = max(len(row[0]) for row in rows)
+    print(f'{"metric":<{width}}  {"baseline":>12}  {"current":>12}  {"change":>8}  unit')
+    for name, old, new, change, status in rows:
+        unit = current[name]['unit'] if name in current else ''
+        change_text = f'{change * 100:+.1f}%' if change is not None else '-'
+        marker = '' if status == 'ok' else f'  {status}'
+        print(f'{name:<{width}}  {format_value(old):>12}  {format_value(new):>12}  {change_text:>8}  {unit}{marker}')
+
+
+def merge_baseline(baseline, results):
+    """Baseline with the metrics of the modules in results replaced, the other modules kept"""
+    merged = dict(results)
+    merged['modules'] = sorted(set(baseline.get('modules', [])) | set(results['modules']))
+    merged['metrics'] = {name: value for name, value in baseline.get('metrics', {}).items()
+                         if name.split('.')[0] not in results['modules']}
+    merged['metrics'].update(results['metrics'])
+    return merged
+
+
+def write_results(path, results):
+    path.parent.mkdir(parents=True, exist_ok=True)
+    with open(path, 'w') as f:
+        json.dump(results, f, indent=2)
+        f.write('\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Run the cross-ECU benchmarks and check for performance regressions')
+    parser.add_argument('--only', action='append', choices=sorted(MODULES),
+                        help='Run only this module (repeatable)')
+    parser.add_argument('--repeat', type=int, default=5,
+                        help='Runs per benchmark, the best is kept (default 5)')
+    parser.add_argument('--build-dir', type=Path, default=REPO / 'benchmarks' / 'build',
+                        help='Directory for the benchmark builds (default benchmarks/build)')
+    parser.add_argument('--results', type=Path, default=REPO / 'benchmarks' / 'results' / 'latest.json',
+                        help='Results file to write (default benchmarks/results/latest.json)')
+    parser.add_argument('--baseline', type=Path, default=REPO / 'benchmarks' / 'results' / 'baseline.json',
+                        help='Results to compare against (default benchmarks/results/baseline.json)')
+    parser.add_argument('--update-baseline', action='store_true',
+                        help='Replace the baseline metrics of the modules run with these results')
+    parser.add_argument('--tolerance-scale', type=float, default=1.0,
+                        help='Multiply every metric tolerance, e.g. 2 on a noisy host')
+    parser.add_argument('--no-confirm', dest='confirm', action='store_false',
+                        help='Do not re-run modules with a regression before reporting it')
+    parser.add_argument('--no-fail', action='store_true',
+                        help='Report regressions but exit with status 0')
+    args = parser.parse_args()
+
+    if args.repeat < 1:
+        parser.error('--repeat must be at least 1')
+    modules = args.only or list(MODULES)
+    log = lambda message: print(message, file=sys.stderr)
+
+    # The baseline only moves on request, so slowdowns below the tolerance
+    # add up against it instead of each run becoming the next reference
+    baseline = None
+    if args.baseline.exists():
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+
+    # Metric names start with their module; only compare the modules run this time
+    baseline_metrics = {}
+    if baseline is not None:
+        baseline_metrics = {name: value for name, value in baseline.get('metrics', {}).items()
+                            if name.split('.')[0] in modules}
+
+    samples = {}
+    definitions = {}
+    build_dir = args.build_dir.resolve()
+    try:
+        collect(modules, build_dir, args.repeat, log, samples, definitions)
+        metrics = summarize(samples, definitions)
+        rows = compare(metrics, baseline_metrics, args.tolerance_scale)
+
+        # A regression has to show up again in a second set of runs
+        suspects = sorted({row[0].split('.')[0] for row in rows if row[4] == 'REGRESSION'})
+        if suspects and args.confirm:
+            log(f'Confirming regressions in {", ".join(suspects)}')
+            collect(suspects, build_dir, args.repeat, log, samples, definitions)
+            metrics = summarize(samples, definitions)
+            rows = compare(metrics, baseline_metrics, args.tolerance_scale)
+    except BenchmarkError as error:
+        print(f'Benchmark failed: {error}', file=sys.stderr)
+        return 2
+
+    results = {
+        'schema': SCHEMA_VERSION,
+        'timestamp': datetime.datetime.now(datetime.timezone.utc).isoformat(timespec='seconds'),
+        'revision': git_revision(),
+        'host': host_info(),
+        'repeat': args.repeat,
+        'seed': SEED,
+        'modules': modules,
+        'metrics': metrics,
+    }
+
+    # Keep the run being replaced as previous.json next to the new results
+    args.results.parent.mkdir(parents=True, exist_ok=True)
+    if args.results.exists():
+        shutil.copyfile(args.results, args.results.with_name('previous.json'))
+    write_results(args.results, results)
+    log(f'Results written to {args.results}')
+
+    print_comparison(rows, metrics)
+    if baseline is None:
+        write_results(args.baseline, results)
+        print(f'\nNo baseline yet; these results are the baseline now ({args.baseline})')
+        return 0
+
+    if baseline.get('host') != results['host']:
+        print(f'Warning: baseline was measured on a different host ({baseline.get("host")})', file=sys.stderr)
+
+    regressions = [row[0] for row in rows if row[4] == 'REGRESSION']
+    print(f'\nBaseline: {baseline.get("revision")} {baseline.get("timestamp")}  '
+          f'Current: {results["revision"]} {results["timestamp"]}')
+    if args.update_baseline:
+        write_results(args.baseline, merge_baseline(baseline, results))
+        print(f'Baseline {args.baseline} updated for {", ".join(modules)}')
+    if regressions:
+        print(f'{len(regressions)} regression(s): {", ".join(regressions)}')
+        return 0 if args.no_fail else 1
+    print('No regressions')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,257 @@
+/**
+ * @file asc2ctr.c
+ * @brief One-shot converter from Vector ASCII logs (.asc) to .ctr traces
+ *
+ * Streams the input line by line and writes one block at a time, so the
+ * memory use does not depend on the size of the capture.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "cantrace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define ASC2CTR_MAX_LINE_LENGTH     512U
+
+/* Block being filled */
+typedef struct {
+    uint32_t blockFrames;
+    uint32_t count;
+    uint64_t baseTimestampUs;
+    uint64_t lastTimestampUs;
+    uint32_t* deltaUs;
+    uint32_t* canId;
+    uint8_t* dlc;
+    uint8_t* payload;
+    uint8_t* buffer;                /* Whole block as written */
+} Asc2Ctr_Block_t;
+
+/* Output state */
+typedef struct {
+    FILE* out;
+    CanTrace_FileHeader_t header;
+    CanTrace_IndexEntry_t* index;
+    uint32_t indexCapacity;
+    uint64_t reorderedFrames;
+} Asc2Ctr_Writer_t;
+
+static int Asc2Ctr_AllocBlock(Asc2Ctr_Block_t* block, uint32_t blockFrames)
+{
+    memset(block, 0, sizeof(*block));
+    block->blockFrames = blockFrames;
+    block->buffer = (uint8_t*)calloc(1, (size_t)CanTrace_BlockSize(blockFrames));
+    if (block->buffer == NULL)
+    {
+        return -1;
+    }
+    block->deltaUs = (uint32_t*)(block->buffer + CANTRACE_BLOCK_HEADER_SIZE);
+    block->canId = block->deltaUs + blockFrames;
+    block->dlc = (uint8_t*)(block->canId + blockFrames);
+    block->payload = block->dlc + blockFrames;
+    return 0;
+}
+
+static int Asc2Ctr_FlushBlock(Asc2Ctr_Writer_t* writer, Asc2Ctr_Block_t* block)
+{
+    CanTrace_BlockHeader_t blockHeader;
+    CanTrace_IndexEntry_t* grown;
+    uint64_t blockSize = CanTrace_BlockSize(block->blockFrames);
+
+    if (block->count == 0U)
+    {
+        return 0;
+    }
+
+    if (writer->header.blockCount == writer->indexCapacity)
+    {
+        writer->indexCapacity = (writer->indexCapacity == 0U) ? 256U : (writer->indexCapacity * 2U);
+        grown = (CanTrace_IndexEntry_t*)realloc(writer->index, writer->indexCapacity * sizeof(CanTrace_IndexEntry_t));
+        if (grown == NULL)
+        {
+            return -1;
+        }
+        writer->index = grown;
+    }
+    writer->index[writer->header.blockCount].firstTimestampUs = block->baseTimestampUs + block->deltaUs[0];
+
+    memset(&blockHeader, 0, sizeof(blockHeader));
+    blockHeader.baseTimestampUs = block->baseTimestampUs;
+    blockHeader.frameCount = block->count;
+    memcpy(block->buffer, &blockHeader, sizeof(blockHeader));
+
+    if (fwrite(block->buffer, 1, (size_t)blockSize, writer->out) != (size_t)blockSize)
+    {
+        return -1;
+    }
+
+    writer->header.blockCount++;
+    memset(block->buffer, 0, (size_t)blockSize);
+    block->count = 0;
+    return 0;
+}
+
+static int Asc2Ctr_AddFrame(Asc2Ctr_Writer_t* writer, Asc2Ctr_Block_t* block, const CanTrace_Frame_t* frame)
+{
+    uint64_t timestampUs = frame->timestampUs;
+    uint32_t slot;
+
+    /* Frames must be in time order: late frames get the previous timestamp */
+    if ((writer->header.frameCount > 0U) && (timestampUs < block->lastTimestampUs))
+    {
+        timestampUs = block->lastTimestampUs;
+        writer->reorderedFrames++;
+    }
+
+    /* A full block or a gap the delta column cannot hold starts a new block */
+    if ((block->count == block->blockFrames) ||
+        ((block->count > 0U) && ((timestampUs - block->lastTimestampUs) > UINT32_MAX)))
+    {
+        if (Asc2Ctr_FlushBlock(writer, block) != 0)
+        {
+            return -1;
+        }
+    }
+
+    slot = block->count;
+    if (slot == 0U)
+    {
+        block->baseTimestampUs = timestampUs;
+        block->deltaUs[0] = 0;
+    }
+    else
+    {
+        block->deltaUs[slot] = (uint32_t)(timestampUs - block->lastTimestampUs);
+    }
+    block->canId[slot] = frame->canId;
+    block->dlc[slot] = frame->dlc;
+    memcpy(block->payload + ((size_t)slot * CANTRACE_MAX_DLC), frame->data, frame->dlc);
+    block->count++;
+    block->lastTimestampUs = timestampUs;
+
+    if (writer->header.frameCount == 0U)
+    {
+        writer->header.firstTimestampUs = timestampUs;
+    }
+    writer->header.lastTimestampUs = timestampUs;
+    writer->header.frameCount++;
+    return 0;
+}
+
+static void Asc2Ctr_Usage(const char* program)
+{
+    printf("Usage: %s [-b frames-per-block] input.asc output.ctr\n", program);
+    printf("  -b  frame slots per block, multiple of 8 (default %u)\n", (unsigned)CANTRACE_DEFAULT_BLOCK_FRAMES);
+}
+
+int main(int argc, char** argv)
+{
+    Asc2Ctr_Writer_t writer;
+    Asc2Ctr_Block_t block;
+    CanTrace_Frame_t frame;
+    uint8_t payload[CANTRACE_MAX_DLC];
+    char line[ASC2CTR_MAX_LINE_LENGTH];
+    unsigned long blockFrames = CANTRACE_DEFAULT_BLOCK_FRAMES;
+    FILE* in;
+    int decimalIds = 0;
+    int result = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b': blockFrames = strtoul(optarg, NULL, 0); break;
+            default: Asc2Ctr_Usage(argv[0]); return (opt == 'h') ? 0 : 2;
+        }
+    }
+
+    if ((optind != (argc - 2)) || (blockFrames == 0UL) || ((blockFrames % 8UL) != 0UL) || (blockFrames > 0x1000000UL))
+    {
+        Asc2Ctr_Usage(argv[0]);
+        return 2;
+    }
+
+    in = fopen(argv[optind], "r");
+    if (in == NULL)
+    {
+        fprintf(stderr, "Cannot open %s\n", argv[optind]);
+        return 2;
+    }
+
+    memset(&writer, 0, sizeof(writer));
+    writer.out = fopen(argv[optind + 1], "wb");
+    if ((writer.out == NULL) || (Asc2Ctr_AllocBlock(&block, (uint32_t)blockFrames) != 0))
+    {
+        fprintf(stderr, "Cannot create %s\n", argv[optind + 1]);
+        fclose(in);
+        return 2;
+    }
+
+    writer.header.magic = CANTRACE_MAGIC;
+    writer.header.version = CANTRACE_VERSION;
+    writer.header.headerSize = CANTRACE_HEADER_SIZE;
+    writer.header.blockFrames = (uint32_t)blockFrames;
+    writer.header.blockSize = CanTrace_BlockSize((uint32_t)blockFrames);
+
+    /* Header is rewritten once the counts are known */
+    if (fwrite(&writer.header, 1, sizeof(writer.header), writer.out) != sizeof(writer.header))
+    {
+        result = 1;
+    }
+
+    while ((result == 0) && (fgets(line, sizeof(line), in) != NULL))
+    {
+        if ((CanTrace_ParseAscLine(line, &decimalIds, &frame, payload) == 1) &&
+            (Asc2Ctr_AddFrame(&writer, &block, &frame) != 0))
+        {
+            result = 1;
+        }
+    }
+
+    if ((result == 0) && (Asc2Ctr_FlushBlock(&writer, &block) != 0))
+    {
+        result = 1;
+    }
+
+    if (result == 0)
+    {
+        writer.header.indexOffset = CANTRACE_HEADER_SIZE + ((uint64_t)writer.header.blockCount * writer.header.blockSize);
+        if ((writer.header.blockCount > 0U) &&
+            (fwrite(writer.index, sizeof(CanTrace_IndexEntry_t), writer.header.blockCount, writer.out) !=
+             writer.header.blockCount))
+        {
+            result = 1;
+        }
+        else if ((fseek(writer.out, 0, SEEK_SET) != 0) ||
+                 (fwrite(&writer.header, 1, sizeof(writer.header), writer.out) != sizeof(writer.header)))
+        {
+            result = 1;
+        }
+    }
+
+    if ((fclose(writer.out) != 0) || (result != 0))
+    {
+        fprintf(stderr, "Write error on %s\n", argv[optind + 1]);
+        result = 1;
+    }
+    else
+    {
+        printf("%llu frames in %u blocks, %.3f s to %.3f s",
+               (unsigned long long)writer.header.frameCount, (unsigned)writer.header.blockCount,
+               (double)writer.header.firstTimestampUs / 1e6, (double)writer.header.lastTimestampUs / 1e6);
+        if (writer.reorderedFrames > 0U)
+        {
+            printf(", %llu out-of-order frames clamped", (unsigned long long)writer.reorderedFrames);
+        }
+        printf("\n");
+    }
+
+    fclose(in);
+    free(block.buffer);
+    free(writer.index);
+    return result;
+}
@@ -0,0 +1,277 @@
+/**
+ * @file cantrace.c
+ * @brief Memory-mapped reader for .ctr CAN traces and .asc line parser
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "cantrace.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CANTRACE_ASC_MAX_TOKENS         (6U + CANTRACE_MAX_DLC)
+
+/* The on-disk header is read in place */
+typedef char CanTrace_HeaderSizeCheck_t[(sizeof(CanTrace_FileHeader_t) == CANTRACE_HEADER_SIZE) ? 1 : -1];
+
+uint64_t CanTrace_BlockSize(uint32_t blockFrames)
+{
+    return CANTRACE_BLOCK_HEADER_SIZE + ((uint64_t)blockFrames * (4U + 4U + 1U + CANTRACE_MAX_DLC));
+}
+
+int CanTrace_Open(CanTrace_File_t* file, const char* path)
+{
+    const CanTrace_FileHeader_t* header;
+    struct stat st;
+    void* map;
+    int fd;
+    int retVal = -1;
+
+    memset(file, 0, sizeof(*file));
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    if ((fstat(fd, &st) == 0) && ((uint64_t)st.st_size >= CANTRACE_HEADER_SIZE))
+    {
+        map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED)
+        {
+            header = (const CanTrace_FileHeader_t*)map;
+            if ((header->magic == CANTRACE_MAGIC) && (header->version == CANTRACE_VERSION) &&
+                (header->headerSize == CANTRACE_HEADER_SIZE) && (header->blockFrames > 0U) &&
+                ((header->blockFrames % 8U) == 0U) &&
+                (header->blockSize == CanTrace_BlockSize(header->blockFrames)) &&
+                (header->indexOffset == (CANTRACE_HEADER_SIZE + ((uint64_t)header->blockCount * header->blockSize))) &&
+                ((header->indexOffset + ((uint64_t)header->blockCount * sizeof(CanTrace_IndexEntry_t))) <=
+                 (uint64_t)st.st_size))
+            {
+                file->map = (const uint8_t*)map;
+                file->size = (size_t)st.st_size;
+                file->header = header;
+                file->index = (const CanTrace_IndexEntry_t*)(file->map + header->indexOffset);
+
+                /* Frames are streamed front to back; let the kernel read ahead and drop behind */
+                (void)posix_madvise(map, file->size, POSIX_MADV_SEQUENTIAL);
+                retVal = 0;
+            }
+            else
+            {
+                (void)munmap(map, (size_t)st.st_size);
+            }
+        }
+    }
+
+    (void)close(fd);
+    return retVal;
+}
+
+void CanTrace_Close(CanTrace_File_t* file)
+{
+    if (file->map != NULL)
+    {
+        (void)munmap((void*)file->map, file->size);
+    }
+    memset(file, 0, sizeof(*file));
+}
+
+/**
+ * @brief Point the cursor at the first slot of a block
+ */
+static void CanTrace_LoadBlock(CanTrace_Cursor_t* cursor, uint32_t block)
+{
+    const CanTrace_FileHeader_t* header = cursor->file->header;
+    const uint8_t* base;
+    uint32_t frames = header->blockFrames;
+
+    cursor->block = block;
+    cursor->slot = 0;
+    cursor->blockHeader = NULL;
+
+    if (block < header->blockCount)
+    {
+        base = cursor->file->map + CANTRACE_HEADER_SIZE + ((uint64_t)block * header->blockSize);
+        cursor->blockHeader = (const CanTrace_BlockHeader_t*)base;
+        cursor->deltaUs = (const uint32_t*)(base + CANTRACE_BLOCK_HEADER_SIZE);
+        cursor->canId = cursor->deltaUs + frames;
+        cursor->dlc = (const uint8_t*)(cursor->canId + frames);
+        cursor->payload = cursor->dlc + frames;
+        cursor->timestampUs = cursor->blockHeader->baseTimestampUs;
+    }
+}
+
+void CanTrace_Rewind(CanTrace_Cursor_t* cursor, const CanTrace_File_t* file)
+{
+    cursor->file = file;
+    CanTrace_LoadBlock(cursor, 0);
+}
+
+void CanTrace_Seek(CanTrace_Cursor_t* cursor, const CanTrace_File_t* file, uint64_t timestampUs)
+{
+    uint32_t low = 0;
+    uint32_t high = file->header->blockCount;
+    uint32_t mid;
+    uint64_t frameTime;
+
+    /* Last block starting at or before the target */
+    while ((high - low) > 1U)
+    {
+        mid = low + ((high - low) / 2U);
+        if (file->index[mid].firstTimestampUs <= timestampUs)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    cursor->file = file;
+    CanTrace_LoadBlock(cursor, low);
+
+    /* Skip the earlier frames of that block (only the delta column is read) */
+    while (cursor->blockHeader != NULL)
+    {
+        if (cursor->slot >= cursor->blockHeader->frameCount)
+        {
+            CanTrace_LoadBlock(cursor, cursor->block + 1U);
+        }
+        else
+        {
+            frameTime = cursor->timestampUs + cursor->deltaUs[cursor->slot];
+            if (frameTime >= timestampUs)
+            {
+                break;
+            }
+            cursor->timestampUs = frameTime;
+            cursor->slot++;
+        }
+    }
+}
+
+int CanTrace_Next(CanTrace_Cursor_t* cursor, CanTrace_Frame_t* frame)
+{
+    uint32_t slot;
+
+    while ((cursor->blockHeader != NULL) && (cursor->slot >= cursor->blockHeader->frameCount))
+    {
+        CanTrace_LoadBlock(cursor, cursor->block + 1U);
+    }
+
+    if (cursor->blockHeader == NULL)
+    {
+        return 0;
+    }
+
+    slot = cursor->slot;
+    cursor->timestampUs += cursor->deltaUs[slot];
+    frame->timestampUs = cursor->timestampUs;
+    frame->canId = cursor->canId[slot];
+    frame->dlc = cursor->dlc[slot];
+    frame->data = cursor->payload + ((size_t)slot * CANTRACE_MAX_DLC);
+    cursor->slot++;
+
+    return 1;
+}
+
+/**
+ * @brief Parse "seconds.fraction" to microseconds without floating point
+ */
+static int CanTrace_ParseTimestamp(const char* text, uint64_t* timestampUs)
+{
+    uint64_t seconds = 0;
+    uint64_t fraction = 0;
+    uint32_t digits = 0;
+
+    if ((*text < '0') || (*text > '9'))
+    {
+        return -1;
+    }
+
+    while ((*text >= '0') && (*text <= '9'))
+    {
+        seconds = (seconds * 10U) + (uint64_t)(*text - '0');
+        text++;
+    }
+    if (*text == '.')
+    {
+        text++;
+        while ((*text >= '0') && (*text <= '9'))
+        {
+            if (digits < 6U)
+            {
+                fraction = (fraction * 10U) + (uint64_t)(*text - '0');
+                digits++;
+            }
+            text++;
+        }
+    }
+    for (; digits < 6U; digits++)
+    {
+        fraction *= 10U;
+    }
+
+    *timestampUs = (seconds * 1000000U) + fraction;
+    return (*text == '\0') ? 0 : -1;
+}
+
+int CanTrace_ParseAscLine(char* line, int* decimalIds, CanTrace_Frame_t* frame, uint8_t payload[CANTRACE_MAX_DLC])
+{
+    char* token[CANTRACE_ASC_MAX_TOKENS];
+    char* end;
+    uint32_t count = 0;
+    uint32_t i;
+    unsigned long value;
+
+    if (strncmp(line, "base ", 5) == 0)
+    {
+        *decimalIds = (strncmp(line + 5, "dec", 3) == 0) ? 1 : 0;
+        return 0;
+    }
+
+    token[0] = strtok(line, " \t\r\n");
+    while ((count < CANTRACE_ASC_MAX_TOKENS) && (token[count] != NULL))
+    {
+        count++;
+        if (count < CANTRACE_ASC_MAX_TOKENS)
+        {
+            token[count] = strtok(NULL, " \t\r\n");
+        }
+    }
+
+    if ((count < 6U) || (strcmp(token[4], "d") != 0) || (CanTrace_ParseTimestamp(token[0], &frame->timestampUs) != 0))
+    {
+        return 0;
+    }
+
+    value = strtoul(token[2], &end, (*decimalIds != 0) ? 10 : 16);
+    if ((end == token[2]) || (value > CANTRACE_ID_MASK) || ((*end != '\0') && ((*end != 'x') || (end[1] != '\0'))))
+    {
+        return 0;
+    }
+    frame->canId = (uint32_t)value | ((*end == 'x') ? CANTRACE_ID_EXTENDED : 0U);
+
+    frame->dlc = (uint8_t)strtoul(token[5], NULL, 10);
+    if ((frame->dlc > CANTRACE_MAX_DLC) || (count < (6U + frame->dlc)))
+    {
+        return 0;
+    }
+
+    memset(payload, 0, CANTRACE_MAX_DLC);
+    for (i = 0; i < frame->dlc; i++)
+    {
+        payload[i] = (uint8_t)strtoul(token[6U + i], NULL, 16);
+    }
+    frame->data = payload;
+
+    return 1;
+}
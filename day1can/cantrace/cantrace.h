@@ -0,0 +1,148 @@
+/**
+ * @file cantrace.h
+ * @brief Compact columnar binary CAN trace format (.ctr) and memory-mapped reader
+ *
+ * File layout (all fields little-endian):
+ *
+ *   CanTrace_FileHeader_t                      CANTRACE_HEADER_SIZE bytes
+ *   block 0 .. blockCount-1                    blockSize bytes each
+ *   CanTrace_IndexEntry_t[blockCount]          at indexOffset
+ *
+ * Every block has room for blockFrames frames and is stored column by column,
+ * so a block is addressed by its number alone:
+ *
+ *   CanTrace_BlockHeader_t                     16 bytes
+ *   uint32 deltaUs[blockFrames]                time since the previous frame of the block
+ *                                              (first frame: since baseTimestampUs)
+ *   uint32 canId[blockFrames]                  CANTRACE_ID_EXTENDED set for 29-bit IDs
+ *   uint8  dlc[blockFrames]
+ *   uint8  payload[blockFrames][8]             unused bytes are zero
+ *
+ * Frames are in timestamp order. The index holds the first timestamp of every
+ * block, so a seek touches the index and one block only. The reader maps the file
+ * and hands out pointers into the mapping; nothing is copied or parsed, and pages
+ * are only brought in as the blocks are streamed.
+ *
+ * Usable from C99 and C++. The reader expects a little-endian host.
+ */
+
+#ifndef CANTRACE_H
+#define CANTRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CANTRACE_MAGIC                  0x31525443UL    /* "CTR1" */
+#define CANTRACE_VERSION                1U
+#define CANTRACE_HEADER_SIZE            64U
+#define CANTRACE_BLOCK_HEADER_SIZE      16U
+#define CANTRACE_DEFAULT_BLOCK_FRAMES   4096U           /* ~68 KiB blocks */
+#define CANTRACE_MAX_DLC                8U
+#define CANTRACE_ID_EXTENDED            0x80000000UL
+#define CANTRACE_ID_MASK                0x1FFFFFFFUL
+
+/* File header */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;
+    uint32_t blockFrames;           /* Frame slots per block, multiple of 8 */
+    uint32_t blockCount;
+    uint64_t frameCount;
+    uint64_t blockSize;             /* Bytes per block */
+    uint64_t indexOffset;
+    uint64_t firstTimestampUs;
+    uint64_t lastTimestampUs;
+    uint8_t reserved[8];
+} CanTrace_FileHeader_t;
+
+/* Block header */
+typedef struct {
+    uint64_t baseTimestampUs;
+    uint32_t frameCount;            /* Used slots */
+    uint32_t reserved;
+} CanTrace_BlockHeader_t;
+
+/* Block index entry */
+typedef struct {
+    uint64_t firstTimestampUs;
+} CanTrace_IndexEntry_t;
+
+/* One frame; data points into the mapped file */
+typedef struct {
+    uint64_t timestampUs;
+    uint32_t canId;
+    uint8_t dlc;
+    const uint8_t* data;
+} CanTrace_Frame_t;
+
+/* Opened trace */
+typedef struct {
+    const uint8_t* map;
+    size_t size;
+    const CanTrace_FileHeader_t* header;
+    const CanTrace_IndexEntry_t* index;
+} CanTrace_File_t;
+
+/* Streaming position */
+typedef struct {
+    const CanTrace_File_t* file;
+    uint32_t block;
+    uint32_t slot;
+    uint64_t timestampUs;           /* Timestamp of the previous frame of the block */
+    const CanTrace_BlockHeader_t* blockHeader;
+    const uint32_t* deltaUs;
+    const uint32_t* canId;
+    const uint8_t* dlc;
+    const uint8_t* payload;
+} CanTrace_Cursor_t;
+
+/**
+ * @brief Byte size of a block of blockFrames slots
+ */
+uint64_t CanTrace_BlockSize(uint32_t blockFrames);
+
+/**
+ * @brief Map a trace read-only and check its header and size; returns 0 on success
+ */
+int CanTrace_Open(CanTrace_File_t* file, const char* path);
+
+/**
+ * @brief Unmap a trace
+ */
+void CanTrace_Close(CanTrace_File_t* file);
+
+/**
+ * @brief Position a cursor on the first frame of the trace
+ */
+void CanTrace_Rewind(CanTrace_Cursor_t* cursor, const CanTrace_File_t* file);
+
+/**
+ * @brief Position a cursor on the first frame at or after timestampUs
+ */
+void CanTrace_Seek(CanTrace_Cursor_t* cursor, const CanTrace_File_t* file, uint64_t timestampUs);
+
+/**
+ * @brief Return the frame at the cursor and advance; returns 1 for a frame, 0 at the end
+ */
+int CanTrace_Next(CanTrace_Cursor_t* cursor, CanTrace_Frame_t* frame);
+
+/**
+ * @brief Parse one line of a Vector ASCII log (.asc)
+ *
+ * Frame lines look like "<time> <channel> <id>[x] <Rx|Tx> d <dlc> <data...>".
+ * Returns 1 and fills frame (data points into payload) for a CAN data frame,
+ * 0 for any other line. "base dec" / "base hex" header lines update *decimalIds.
+ * The line is modified.
+ */
+int CanTrace_ParseAscLine(char* line, int* decimalIds, CanTrace_Frame_t* frame, uint8_t payload[CANTRACE_MAX_DLC]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CANTRACE_H */
@@ -0,0 +1,96 @@
+/**
+ * @file ctrdump.c
+ * @brief Print the frames of a .ctr trace in Vector ASCII log format
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "cantrace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static void CtrDump_Usage(const char* program)
+{
+    printf("Usage: %s [-s start-seconds] [-n frames] [-i] trace.ctr\n", program);
+    printf("  -s  seek to the first frame at or after this time\n");
+    printf("  -n  stop after this many frames\n");
+    printf("  -i  print the file header only\n");
+}
+
+int main(int argc, char** argv)
+{
+    CanTrace_File_t file;
+    CanTrace_Cursor_t cursor;
+    CanTrace_Frame_t frame;
+    unsigned long long limit = 0;
+    unsigned long long printed = 0;
+    double startSeconds = -1.0;
+    int headerOnly = 0;
+    uint8_t i;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:n:ih")) != -1)
+    {
+        switch (opt)
+        {
+            case 's': startSeconds = strtod(optarg, NULL); break;
+            case 'n': limit = strtoull(optarg, NULL, 0); break;
+            case 'i': headerOnly = 1; break;
+            default: CtrDump_Usage(argv[0]); return (opt == 'h') ? 0 : 2;
+        }
+    }
+
+    if (optind != (argc - 1))
+    {
+        CtrDump_Usage(argv[0]);
+        return 2;
+    }
+
+    if (CanTrace_Open(&file, argv[optind]) != 0)
+    {
+        fprintf(stderr, "%s: not a readable .ctr trace\n", argv[optind]);
+        return 2;
+    }
+
+    if (headerOnly != 0)
+    {
+        printf("frames %llu, blocks %u of %u slots (%llu bytes), %.6f s to %.6f s\n",
+               (unsigned long long)file.header->frameCount, (unsigned)file.header->blockCount,
+               (unsigned)file.header->blockFrames, (unsigned long long)file.header->blockSize,
+               (double)file.header->firstTimestampUs / 1e6, (double)file.header->lastTimestampUs / 1e6);
+        CanTrace_Close(&file);
+        return 0;
+    }
+
+    if (startSeconds >= 0.0)
+    {
+        CanTrace_Seek(&cursor, &file, (uint64_t)((startSeconds * 1e6) + 0.5));
+    }
+    else
+    {
+        CanTrace_Rewind(&cursor, &file);
+    }
+
+    printf("date Mon Jan 01 12:00:00.000 2024\n");
+    printf("base hex  timestamps absolute\n");
+    printf("Begin Triggerblock Mon Jan 01 12:00:00.000 2024\n");
+    while (((limit == 0U) || (printed < limit)) && (CanTrace_Next(&cursor, &frame) == 1))
+    {
+        printf("%11llu.%06llu   1  %lx%s             Rx   d %u",
+               (unsigned long long)(frame.timestampUs / 1000000U), (unsigned long long)(frame.timestampUs % 1000000U),
+               (unsigned long)(frame.canId & CANTRACE_ID_MASK),
+               ((frame.canId & CANTRACE_ID_EXTENDED) != 0U) ? "x" : "", (unsigned)frame.dlc);
+        for (i = 0; i < frame.dlc; i++)
+        {
+            printf(" %02x", frame.data[i]);
+        }
+        printf("\n");
+        printed++;
+    }
+    printf("End TriggerBlock\n");
+
+    CanTrace_Close(&file);
+    return 0;
+}